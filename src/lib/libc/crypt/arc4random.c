@@ -128,8 +128,12 @@ _rs_rekey(u_char *dat, size_t datlen)
 	memset(rsx->rs_buf, 0, sizeof(rsx->rs_buf));
 #endif
 	/* fill rs_buf with the keystream */
+#ifdef CHACHA_KEYSTREAM_4X
+	chacha_keystream_4x(&rsx->rs_chacha, rsx->rs_buf, sizeof(rsx->rs_buf));
+#else
 	chacha_encrypt_bytes(&rsx->rs_chacha, rsx->rs_buf,
 	    rsx->rs_buf, sizeof(rsx->rs_buf));
+#endif
 	/* mix in optional user provided data */
 	if (dat) {
 		size_t i, m;
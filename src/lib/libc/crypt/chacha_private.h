@@ -220,3 +220,65 @@ chacha_encrypt_bytes(chacha_ctx *x,const u8 *m,u8 *c,u32 bytes)
 #endif
   }
 }
+
+#if defined(KEYSTREAM_ONLY) && defined(__GNUC__) && \
+    (defined(__amd64__) || defined(__aarch64__))
+/*
+ * Keystream for four blocks at a time, using vectors that hold the same
+ * word of each block. SSE2 and NEON are always present on these
+ * architectures, so no run time check is needed. bytes must be a
+ * multiple of 256.
+ */
+#define CHACHA_KEYSTREAM_4X
+
+typedef u32 chacha_v4 __attribute__((vector_size(16)));
+
+#define ROTATE4(v,c) (((v) << (c)) | ((v) >> (32 - (c))))
+
+#define QUARTERROUND4(a,b,c,d) \
+  a += b; d = ROTATE4(d ^ a,16); \
+  c += d; b = ROTATE4(b ^ c,12); \
+  a += b; d = ROTATE4(d ^ a, 8); \
+  c += d; b = ROTATE4(b ^ c, 7);
+
+static void
+chacha_keystream_4x(chacha_ctx *x,u8 *c,u32 bytes)
+{
+  chacha_v4 v[16], j[16];
+  u32 j12 = x->input[12], j13 = x->input[13];
+  u_int i, k;
+
+  for (i = 0;i < 16;++i) {
+    j[i] = (chacha_v4){ x->input[i], x->input[i], x->input[i], x->input[i] };
+  }
+
+  for (;bytes >= 256;bytes -= 256,c += 256) {
+    j[12] = (chacha_v4){ j12, j12 + 1, j12 + 2, j12 + 3 };
+    j[13] = (chacha_v4){ j13, j13, j13, j13 };
+    /* lanes that wrapped compare as all ones, carry into the high word */
+    j[13] -= (chacha_v4)(j[12] < (chacha_v4){ j12, j12, j12, j12 });
+    for (i = 0;i < 16;++i) v[i] = j[i];
+    for (i = 20;i > 0;i -= 2) {
+      QUARTERROUND4( v[0], v[4], v[8],v[12])
+      QUARTERROUND4( v[1], v[5], v[9],v[13])
+      QUARTERROUND4( v[2], v[6],v[10],v[14])
+      QUARTERROUND4( v[3], v[7],v[11],v[15])
+      QUARTERROUND4( v[0], v[5],v[10],v[15])
+      QUARTERROUND4( v[1], v[6],v[11],v[12])
+      QUARTERROUND4( v[2], v[7], v[8],v[13])
+      QUARTERROUND4( v[3], v[4], v[9],v[14])
+    }
+    for (i = 0;i < 16;++i) {
+      v[i] += j[i];
+      for (k = 0;k < 4;++k) U32TO8_LITTLE(c + 64 * k + 4 * i,v[i][k]);
+    }
+
+    j12 = PLUS(j12,4);
+    if (j12 < 4) {
+      j13 = PLUSONE(j13);
+    }
+  }
+  x->input[12] = j12;
+  x->input[13] = j13;
+}
+#endif
@@ -452,6 +452,21 @@ x509_name_ex_print(BIO *out, ASN1_VALUE **pval, int indent, const char *fname,
  * dirName can also be checked with a simple memcmp().
  */
 
+static uint32_t
+x509_name_canon_hash(const unsigned char *canon, int len)
+{
+	uint32_t hash = 2166136261U;
+	int i;
+
+	/* FNV-1a, only used to look up names, not to compare them. */
+	for (i = 0; i < len; i++) {
+		hash ^= canon[i];
+		hash *= 16777619U;
+	}
+
+	return hash;
+}
+
 static int
 x509_name_canon(X509_NAME *a)
 {
@@ -468,6 +483,7 @@ x509_name_canon(X509_NAME *a)
 	/* Special case: empty X509_NAME => null encoding */
 	if (sk_X509_NAME_ENTRY_num(a->entries) == 0) {
 		a->canon_enclen = 0;
+		a->canon_hash = x509_name_canon_hash(NULL, 0);
 		return 1;
 	}
 	intname = sk_STACK_OF_X509_NAME_ENTRY_new_null();
@@ -510,6 +526,7 @@ x509_name_canon(X509_NAME *a)
 	a->canon_enc = p;
 	a->canon_enclen = len;
 	i2d_name_canon(intname, &p);
+	a->canon_hash = x509_name_canon_hash(a->canon_enc, len);
 	ret = 1;
 
  err:
@@ -521,6 +538,23 @@ x509_name_canon(X509_NAME *a)
 	return ret;
 }
 
+/*
+ * Return the hash of the canonical encoding of name, for lookups, encoding
+ * the name first if it is not cached or was modified.
+ */
+int
+x509_name_hash(X509_NAME *name, uint32_t *out_hash)
+{
+	if (name->canon_enc == NULL || name->modified) {
+		if (i2d_X509_NAME(name, NULL) < 0)
+			return 0;
+	}
+
+	*out_hash = name->canon_hash;
+
+	return 1;
+}
+
 /* Bitmap of all the types of string that will be canonicalized. */
 
 #define ASN1_MASK_CANON	\
@@ -0,0 +1,344 @@
+#!/usr/bin/env perl
+# $OpenBSD$
+#
+# Copyright (c) 2026 agent <agent@local>
+#
+# Permission to use, copy, modify, and distribute this software for any
+# purpose with or without fee is hereby granted, provided that the above
+# copyright notice and this permission notice appear in all copies.
+#
+# THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+# WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+# MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+# ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+# WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+# ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+# OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+# Multi-block ChaCha20 for SSSE3 (four blocks) and AVX2 (eight blocks).
+#
+# Each register holds one word of the state of four or eight blocks, so
+# that a quarter round works on all blocks at once. Two quarter rounds are
+# interleaved. The sixteen state words and two temporaries do not fit in
+# sixteen registers, so two of the four words of the third row are kept
+# on the stack at any time; the column and diagonal rounds are ordered so
+# that only two words need to be exchanged per half round. Rotations by
+# 16 and 8 bits are done with pshufb.
+#
+# size_t chacha_4x_ssse3(unsigned char *out, const unsigned char *in,
+#	size_t len, const uint32_t input[16]);
+# size_t chacha_8x_avx2(unsigned char *out, const unsigned char *in,
+#	size_t len, const uint32_t input[16]);
+#
+# input is the ChaCha state as in struct chacha_ctx. Only whole multiples
+# of 256 (SSSE3) or 512 (AVX2) bytes are processed and the number of bytes
+# processed is returned. The counter in input is not updated, and the
+# caller has to make sure that the low counter word does not wrap.
+
+$flavour = shift;
+$output  = shift;
+if ($flavour =~ /\./) { $output = $flavour; undef $flavour; }
+
+$win64=0; $win64=1 if ($flavour =~ /[nm]asm|mingw64/ || $output =~ /\.asm$/);
+
+$0 =~ m/(.*[\/\\])[^\/\\]+$/; $dir=$1;
+( $xlate="${dir}x86_64-xlate.pl" and -f $xlate ) or
+( $xlate="${dir}../../perlasm/x86_64-xlate.pl" and -f $xlate) or
+die "can't locate x86_64-xlate.pl";
+
+open OUT,"| \"$^X\" $xlate $flavour $output";
+*STDOUT=*OUT;
+
+($out,$inp,$len,$state)=("%rdi","%rsi","%rdx","%rcx");
+
+# Stack frame, in units of one vector register: the state words with the
+# block counters in word 12, two spill slots per word of the third row,
+# and the output of the rounds before it is transposed.
+$STATE=0;
+$SPILL=16;
+$XOUT=20;
+$FRAME=36;
+
+$code=".text\n";
+
+# Emit the code for one vector width. $v is the register prefix, $w the
+# register width in bytes and $avx whether VEX encoded instructions are
+# used.
+sub chacha_nx {
+my ($name,$v,$w,$avx,$inc,$step)=@_;
+my $blocks=$w/4;
+my @a=map("%${v}mm$_",(0..3));
+my @b=map("%${v}mm$_",(4..7));
+my ($c,$c_)=("%${v}mm8","%${v}mm9");
+my ($t0,$t1)=("%${v}mm10","%${v}mm11");
+my @d=map("%${v}mm$_",(12..15));
+my ($rot16,$rot8)=(".Lrot16_$name",".Lrot8_$name");
+my $slot=sub { my $i=shift; sprintf("0x%x(%%rsp)",$i*$w); };
+my $movdqa=$avx?"vmovdqa":"movdqa";
+
+# Three operand helpers: op src,dst for SSE, op src,dst,dst for AVX.
+my $op=sub {
+	my ($ins,$src,$dst)=@_;
+	return $avx ? "\tv$ins\t$src,$dst,$dst\n" : "\t$ins\t$src,$dst\n";
+};
+# Rotate $x left by $n bits, using $t.
+my $rotl=sub {
+	my ($x,$n,$t)=@_;
+	return $avx ?
+	    "\tvpslld\t\$$n,$x,$t\n\tvpsrld\t\$".(32-$n).",$x,$x\n\tvpor\t$t,$x,$x\n" :
+	    "\tmovdqa\t$x,$t\n\tpslld\t\$$n,$x\n\tpsrld\t\$".(32-$n).",$t\n\tpor\t$t,$x\n";
+};
+
+# Two interleaved quarter rounds.
+my $qr2=sub {
+	my ($a0,$b0,$c0,$d0,$a1,$b1,$c1,$d1)=@_;
+	my $s="";
+	$s.=&$op("paddd",$b0,$a0).&$op("paddd",$b1,$a1);
+	$s.=&$op("pxor",$a0,$d0).&$op("pxor",$a1,$d1);
+	$s.=&$op("pshufb",$rot16."(%rip)",$d0).&$op("pshufb",$rot16."(%rip)",$d1);
+	$s.=&$op("paddd",$d0,$c0).&$op("paddd",$d1,$c1);
+	$s.=&$op("pxor",$c0,$b0).&$op("pxor",$c1,$b1);
+	$s.=&$rotl($b0,12,$t0).&$rotl($b1,12,$t1);
+	$s.=&$op("paddd",$b0,$a0).&$op("paddd",$b1,$a1);
+	$s.=&$op("pxor",$a0,$d0).&$op("pxor",$a1,$d1);
+	$s.=&$op("pshufb",$rot8."(%rip)",$d0).&$op("pshufb",$rot8."(%rip)",$d1);
+	$s.=&$op("paddd",$d0,$c0).&$op("paddd",$d1,$c1);
+	$s.=&$op("pxor",$c0,$b0).&$op("pxor",$c1,$b1);
+	$s.=&$rotl($b0,7,$t0).&$rotl($b1,7,$t1);
+	return $s;
+};
+
+my $i;
+
+$code.=<<___;
+.globl	$name
+.type	$name,\@abi-omnipotent
+.align	32
+$name:
+___
+$code.=<<___ if ($win64);
+	push		%rdi
+	push		%rsi
+	lea		-0xa8(%rsp),%rsp
+	movaps		%xmm6,0x00(%rsp)
+	movaps		%xmm7,0x10(%rsp)
+	movaps		%xmm8,0x20(%rsp)
+	movaps		%xmm9,0x30(%rsp)
+	movaps		%xmm10,0x40(%rsp)
+	movaps		%xmm11,0x50(%rsp)
+	movaps		%xmm12,0x60(%rsp)
+	movaps		%xmm13,0x70(%rsp)
+	movaps		%xmm14,0x80(%rsp)
+	movaps		%xmm15,0x90(%rsp)
+	mov		%rcx,$out
+	mov		%rdx,$inp
+	mov		%r8,$len
+	mov		%r9,$state
+___
+$code.=<<___;
+	xor		%eax,%eax
+	cmp		\$`64*$blocks`,$len
+	jb		.L${name}_done
+
+	mov		%rsp,%r11
+	sub		\$`$FRAME*$w`,%rsp
+	and		\$-32,%rsp
+___
+$code.="\tvzeroupper\n" if ($avx);
+
+# Broadcast the state words, adding the block numbers to the counter.
+for ($i=0; $i<16; $i++) {
+	if ($avx) {
+		$code.="\tvpbroadcastd\t".(4*$i)."($state),%ymm0\n";
+	} else {
+		$code.="\tmovd\t\t".(4*$i)."($state),%xmm0\n";
+		$code.="\tpshufd\t\t\$0,%xmm0,%xmm0\n";
+	}
+	$code.=&$op("paddd","$inc(%rip)","%${v}mm0") if ($i==12);
+	$code.="\t$movdqa\t\t%${v}mm0,".&$slot($STATE+$i)."\n";
+}
+
+$code.=<<___;
+	jmp		.L${name}_loop
+
+.align	32
+.L${name}_loop:
+___
+for ($i=0; $i<4; $i++) {
+	$code.="\t$movdqa\t\t".&$slot($STATE+$i).",$a[$i]\n";
+	$code.="\t$movdqa\t\t".&$slot($STATE+4+$i).",$b[$i]\n";
+	$code.="\t$movdqa\t\t".&$slot($STATE+12+$i).",$d[$i]\n";
+}
+$code.="\t$movdqa\t\t".&$slot($STATE+10).",$t0\n";
+$code.="\t$movdqa\t\t".&$slot($STATE+11).",$t1\n";
+$code.="\t$movdqa\t\t$t0,".&$slot($SPILL+2)."\n";
+$code.="\t$movdqa\t\t$t1,".&$slot($SPILL+3)."\n";
+$code.="\t$movdqa\t\t".&$slot($STATE+8).",$c\n";
+$code.="\t$movdqa\t\t".&$slot($STATE+9).",$c_\n";
+$code.=<<___;
+	mov		\$10,%r10d
+	jmp		.L${name}_rounds
+
+.align	32
+.L${name}_rounds:
+___
+# Column round, words 8 and 9 of the third row in registers.
+$code.=&$qr2($a[0],$b[0],$c,$d[0],$a[1],$b[1],$c_,$d[1]);
+$code.="\t$movdqa\t\t$c,".&$slot($SPILL+0)."\n";
+$code.="\t$movdqa\t\t$c_,".&$slot($SPILL+1)."\n";
+$code.="\t$movdqa\t\t".&$slot($SPILL+2).",$c\n";
+$code.="\t$movdqa\t\t".&$slot($SPILL+3).",$c_\n";
+$code.=&$qr2($a[2],$b[2],$c,$d[2],$a[3],$b[3],$c_,$d[3]);
+# Diagonal round, starting with words 10 and 11.
+$code.=&$qr2($a[0],$b[1],$c,$d[3],$a[1],$b[2],$c_,$d[0]);
+$code.="\t$movdqa\t\t$c,".&$slot($SPILL+2)."\n";
+$code.="\t$movdqa\t\t$c_,".&$slot($SPILL+3)."\n";
+$code.="\t$movdqa\t\t".&$slot($SPILL+0).",$c\n";
+$code.="\t$movdqa\t\t".&$slot($SPILL+1).",$c_\n";
+$code.=&$qr2($a[2],$b[3],$c,$d[1],$a[3],$b[0],$c_,$d[2]);
+$code.=<<___;
+	dec		%r10d
+	jnz		.L${name}_rounds
+
+___
+
+# Add the input state and store the result.
+my @x=(@a,@b,$c,$c_,undef,undef,@d);
+for ($i=0; $i<16; $i++) {
+	my $r=$x[$i];
+	if (!defined($r)) {
+		$r=$t0;
+		$code.="\t$movdqa\t\t".&$slot($SPILL+$i-8).",$r\n";
+	}
+	$code.=&$op("paddd",&$slot($STATE+$i),$r);
+	$code.="\t$movdqa\t\t$r,".&$slot($XOUT+$i)."\n";
+}
+
+# Transpose four words of four blocks at a time and XOR with the input.
+# With AVX2 the low and high halves of a register hold blocks 0-3 and
+# 4-7.
+for (my $h=0; $h<$w/16; $h++) {
+for (my $g=0; $g<4; $g++) {
+	my @y=map("%xmm$_",(0..3));
+	my @u=map("%xmm$_",(4..7));
+	for ($i=0; $i<4; $i++) {
+		$code.="\t$movdqa\t\t".sprintf("0x%x(%%rsp)",
+		    ($XOUT+4*$g+$i)*$w+16*$h).",$y[$i]\n";
+	}
+	if ($avx) {
+		$code.=<<___;
+	vpunpckldq	$y[1],$y[0],$u[0]
+	vpunpckldq	$y[3],$y[2],$u[1]
+	vpunpckhdq	$y[1],$y[0],$u[2]
+	vpunpckhdq	$y[3],$y[2],$u[3]
+	vpunpcklqdq	$u[1],$u[0],$y[0]
+	vpunpckhqdq	$u[1],$u[0],$y[1]
+	vpunpcklqdq	$u[3],$u[2],$y[2]
+	vpunpckhqdq	$u[3],$u[2],$y[3]
+___
+	} else {
+		$code.=<<___;
+	movdqa		$y[0],$u[0]
+	punpckldq	$y[1],$u[0]
+	movdqa		$y[2],$u[1]
+	punpckldq	$y[3],$u[1]
+	movdqa		$y[0],$u[2]
+	punpckhdq	$y[1],$u[2]
+	movdqa		$y[2],$u[3]
+	punpckhdq	$y[3],$u[3]
+	movdqa		$u[0],$y[0]
+	punpcklqdq	$u[1],$y[0]
+	movdqa		$u[0],$y[1]
+	punpckhqdq	$u[1],$y[1]
+	movdqa		$u[2],$y[2]
+	punpcklqdq	$u[3],$y[2]
+	movdqa		$u[2],$y[3]
+	punpckhqdq	$u[3],$y[3]
+___
+	}
+	for ($i=0; $i<4; $i++) {
+		my $off=64*(4*$h+$i)+16*$g;
+		if ($avx) {
+			$code.="\tvpxor\t\t$off($inp),$y[$i],$y[$i]\n";
+			$code.="\tvmovdqu\t\t$y[$i],$off($out)\n";
+		} else {
+			$code.="\tmovdqu\t\t$off($inp),$u[$i]\n";
+			$code.="\tpxor\t\t$u[$i],$y[$i]\n";
+			$code.="\tmovdqu\t\t$y[$i],$off($out)\n";
+		}
+	}
+}
+}
+
+$code.=&$op("paddd","$step(%rip)","%${v}mm0") =~ s/^/\t$movdqa\t\t${\(&$slot($STATE+12))},%${v}mm0\n/r;
+$code.="\t$movdqa\t\t%${v}mm0,".&$slot($STATE+12)."\n";
+$code.=<<___;
+	lea		`64*$blocks`($inp),$inp
+	lea		`64*$blocks`($out),$out
+	add		\$`64*$blocks`,%rax
+	sub		\$`64*$blocks`,$len
+	cmp		\$`64*$blocks`,$len
+	jae		.L${name}_loop
+
+___
+# Clear the key and keystream from the stack.
+$code.=&$op("pxor","%${v}mm0","%${v}mm0");
+for ($i=0; $i<$FRAME; $i++) {
+	$code.="\t$movdqa\t\t%${v}mm0,".&$slot($i)."\n";
+}
+$code.="\tvzeroupper\n" if ($avx);
+$code.=<<___;
+	mov		%r11,%rsp
+
+.L${name}_done:
+___
+$code.=<<___ if ($win64);
+	movaps		0x00(%rsp),%xmm6
+	movaps		0x10(%rsp),%xmm7
+	movaps		0x20(%rsp),%xmm8
+	movaps		0x30(%rsp),%xmm9
+	movaps		0x40(%rsp),%xmm10
+	movaps		0x50(%rsp),%xmm11
+	movaps		0x60(%rsp),%xmm12
+	movaps		0x70(%rsp),%xmm13
+	movaps		0x80(%rsp),%xmm14
+	movaps		0x90(%rsp),%xmm15
+	lea		0xa8(%rsp),%rsp
+	pop		%rsi
+	pop		%rdi
+___
+$code.=<<___;
+	ret
+.size	$name,.-$name
+___
+}
+
+&chacha_nx("chacha_4x_ssse3","x",16,0,".Linc4",".Lfour");
+&chacha_nx("chacha_8x_avx2","y",32,1,".Linc8",".Leight");
+
+$code.=<<___;
+.section .rodata
+.align	64
+.Lrot16_chacha_8x_avx2:
+.Lrot16_chacha_4x_ssse3:
+	.byte	2,3,0,1,6,7,4,5,10,11,8,9,14,15,12,13
+	.byte	2,3,0,1,6,7,4,5,10,11,8,9,14,15,12,13
+.Lrot8_chacha_8x_avx2:
+.Lrot8_chacha_4x_ssse3:
+	.byte	3,0,1,2,7,4,5,6,11,8,9,10,15,12,13,14
+	.byte	3,0,1,2,7,4,5,6,11,8,9,10,15,12,13,14
+.Linc4:
+.Linc8:
+	.long	0,1,2,3,4,5,6,7
+.Lfour:
+	.long	4,4,4,4
+.Leight:
+	.long	8,8,8,8,8,8,8,8
+.text
+___
+
+$code =~ s/\`([^\`]*)\`/eval($1)/gem;
+
+print $code;
+
+close STDOUT;
@@ -18,9 +18,96 @@
 #include <stdint.h>
 
 #include <openssl/chacha.h>
+#include <openssl/crypto.h>
 
 #include "chacha-merged.c"
 
+#ifdef CHACHA_ASM
+#include "x86_arch.h"
+
+size_t chacha_4x_ssse3(unsigned char *out, const unsigned char *in,
+    size_t len, const uint32_t input[16]);
+size_t chacha_8x_avx2(unsigned char *out, const unsigned char *in,
+    size_t len, const uint32_t input[16]);
+
+/*
+ * Process as many whole blocks as the multi-block implementations can
+ * handle and return the number of bytes processed. These do not carry
+ * into the high word of the counter, so stop where the low word wraps
+ * and leave the rest to chacha_encrypt_bytes(). They also store output
+ * before all input of a group of blocks has been read, so overlapping
+ * buffers are only handled if they are the same.
+ */
+static size_t
+chacha_encrypt_simd(chacha_ctx *ctx, unsigned char *out,
+    const unsigned char *in, size_t len)
+{
+	uint64_t caps, counter, max;
+	size_t done = 0, n;
+
+	if (out != in && out < in + len && in < out + len)
+		return 0;
+
+	caps = OPENSSL_cpu_caps();
+
+	max = ((uint64_t)UINT32_MAX + 1 - ctx->input[12]) * 64;
+	if (len > max)
+		len = max;
+
+	counter = (uint64_t)ctx->input[13] << 32 | ctx->input[12];
+
+	if ((caps & CPUCAP_MASK_AVX2) != 0 && (caps & CPUCAP_MASK_AVX) != 0) {
+		n = chacha_8x_avx2(out, in, len, ctx->input);
+		done += n;
+		counter += n / 64;
+		ctx->input[12] = (uint32_t)counter;
+		ctx->input[13] = (uint32_t)(counter >> 32);
+	}
+	if ((caps & CPUCAP_MASK_SSSE3) != 0) {
+		n = chacha_4x_ssse3(out + done, in + done, len - done,
+		    ctx->input);
+		done += n;
+		counter += n / 64;
+		ctx->input[12] = (uint32_t)counter;
+		ctx->input[13] = (uint32_t)(counter >> 32);
+	}
+
+	return done;
+}
+#endif
+
+/* Encrypt len bytes, starting at a block boundary. */
+static void
+chacha_encrypt(chacha_ctx *ctx, unsigned char *out, const unsigned char *in,
+    size_t len)
+{
+	uint64_t n;
+
+	while (len > 0) {
+#ifdef CHACHA_ASM
+		if ((n = chacha_encrypt_simd(ctx, out, in, len)) > 0) {
+			in += n;
+			out += n;
+			len -= n;
+			continue;
+		}
+#endif
+		if ((n = len) > UINT32_MAX)
+			n = UINT32_MAX;
+#ifdef CHACHA_ASM
+		/* Only the tail or the blocks around a counter wrap. */
+		if ((OPENSSL_cpu_caps() & CPUCAP_MASK_SSSE3) != 0 && n > 512)
+			n = 512;
+#endif
+
+		chacha_encrypt_bytes(ctx, in, out, (uint32_t)n);
+
+		in += n;
+		out += n;
+		len -= n;
+	}
+}
+
 void
 ChaCha_set_key(ChaCha_ctx *ctx, const unsigned char *key, uint32_t keybits)
 {
@@ -40,7 +127,6 @@ void
 ChaCha(ChaCha_ctx *ctx, unsigned char *out, const unsigned char *in, size_t len)
 {
 	unsigned char *k;
-	uint64_t n;
 	int i, l;
 
 	/* Consume remaining keystream, if any exists. */
@@ -53,16 +139,7 @@ ChaCha(ChaCha_ctx *ctx, unsigned char *out, const unsigned char *in, size_t len)
 		len -= l;
 	}
 
-	while (len > 0) {
-		if ((n = len) > UINT32_MAX)
-			n = UINT32_MAX;
-
-		chacha_encrypt_bytes((chacha_ctx *)ctx, in, out, (uint32_t)n);
-
-		in += n;
-		out += n;
-		len -= n;
-	}
+	chacha_encrypt((chacha_ctx *)ctx, out, in, len);
 }
 
 void
@@ -70,7 +147,6 @@ CRYPTO_chacha_20(unsigned char *out, const unsigned char *in, size_t len,
     const unsigned char key[32], const unsigned char iv[8], uint64_t counter)
 {
 	struct chacha_ctx ctx;
-	uint64_t n;
 
 	/*
 	 * chacha_ivsetup expects the counter to be in u8. Rather than
@@ -84,16 +160,7 @@ CRYPTO_chacha_20(unsigned char *out, const unsigned char *in, size_t len,
 		ctx.input[13] = (uint32_t)(counter >> 32);
 	}
 
-	while (len > 0) {
-		if ((n = len) > UINT32_MAX)
-			n = UINT32_MAX;
-
-		chacha_encrypt_bytes(&ctx, in, out, (uint32_t)n);
-
-		in += n;
-		out += n;
-		len -= n;
-	}
+	chacha_encrypt(&ctx, out, in, len);
 }
 
 void
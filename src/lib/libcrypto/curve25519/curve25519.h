@@ -97,6 +97,27 @@ int ED25519_verify(const uint8_t *message, size_t message_len,
     const uint8_t signature[ED25519_SIGNATURE_LENGTH],
     const uint8_t public_key[ED25519_PUBLIC_KEY_LENGTH]);
 
+#if defined(LIBRESSL_INTERNAL)
+/*
+ * ED25519_verify_batch verifies |num| signatures, where |signatures[i]| is
+ * checked against |public_keys[i]| and |message_lens[i]| bytes from
+ * |messages[i]|. It returns one iff all signatures are valid and zero
+ * otherwise. If |out_valid| is not NULL, |out_valid[i]| is set to one or
+ * zero depending on whether the signature at index i is valid.
+ *
+ * The signatures are checked together using a random linear combination,
+ * which is considerably faster than calling ED25519_verify for each of them.
+ * Every signature is checked with the cofactored equation
+ * 8 * (R + h * A - s * B) = 0, also when the batch falls back to checking
+ * them one by one, so the result for a signature does not depend on the
+ * other signatures in the batch. Unlike ED25519_verify, this accepts
+ * signatures whose R or public key have a component of small order.
+ */
+int ED25519_verify_batch(const uint8_t *const *messages,
+    const size_t *message_lens, const uint8_t *const *signatures,
+    const uint8_t *const *public_keys, size_t num, int *out_valid);
+#endif
+
 #if defined(__cplusplus)
 }  /* extern C */
 #endif
@@ -22,11 +22,23 @@
 
 __BEGIN_HIDDEN_DECLS
 
+#if defined(__SIZEOF_INT128__) && defined(_LP64)
+#define CURVE25519_RADIX51
+#endif
+
+#if defined(CURVE25519_RADIX51)
+/* fe means field element. Here the field is \Z/(2^255-19). An element t,
+ * entries t[0]...t[4], represents the integer t[0]+2^51 t[1]+2^102 t[2]+2^153
+ * t[3]+2^204 t[4]. The entries are unsigned and, between operations,
+ * bounded by 1.01*2^51. */
+typedef uint64_t fe[5];
+#else
 /* fe means field element. Here the field is \Z/(2^255-19). An element t,
  * entries t[0]...t[9], represents the integer t[0]+2^26 t[1]+2^51 t[2]+2^77
  * t[3]+2^102 t[4]+...+2^230 t[9]. Bounds on each t[i] vary depending on
  * context.  */
 typedef int32_t fe[10];
+#endif
 
 /* ge means group element.
 
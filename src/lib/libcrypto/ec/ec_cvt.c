@@ -98,7 +98,12 @@ EC_GROUP *
 EC_GROUP_new_curve_GFp(const BIGNUM *p, const BIGNUM *a, const BIGNUM *b,
     BN_CTX *ctx)
 {
-	return ec_group_new_curve(EC_GFp_mont_method(), p, a, b, ctx);
+	const EC_METHOD *method = EC_GFp_mont_method();
+
+	if (ec_GFp_p256_curve_matches(p, a))
+		method = EC_GFp_p256_method();
+
+	return ec_group_new_curve(method, p, a, b, ctx);
 }
 
 #ifndef OPENSSL_NO_EC2M
@@ -106,6 +106,8 @@ EC_GROUP_new(const EC_METHOD *meth)
 	ret->seed = NULL;
 	ret->seed_len = 0;
 
+	ret->comb_table = NULL;
+
 	if (!meth->group_init(ret)) {
 		free(ret);
 		return NULL;
@@ -187,6 +189,7 @@ EC_GROUP_copy(EC_GROUP *dest, const EC_GROUP *src)
 		return 0;
 
 	dest->curve_name = src->curve_name;
+	dest->comb_table = src->comb_table;
 	dest->asn1_flag = src->asn1_flag;
 	dest->asn1_form = src->asn1_form;
 
@@ -373,6 +376,8 @@ EC_GROUP_set_generator(EC_GROUP *group, const EC_POINT *generator,
 		return 0;
 	}
 
+	group->comb_table = ec_GFp_comb_table_lookup(group);
+
 	return 1;
 }
 
@@ -501,6 +506,7 @@ EC_GROUP_set_curve(EC_GROUP *group, const BIGNUM *p, const BIGNUM *a,
 		ECerror(ERR_R_SHOULD_NOT_HAVE_BEEN_CALLED);
 		goto err;
 	}
+	group->comb_table = NULL;
 	ret = group->meth->group_set_curve(group, p, a, b, ctx);
 
  err:
@@ -69,6 +69,7 @@
  *
  */
 
+#include <stdint.h>
 #include <stdlib.h>
 
 #include <openssl/bn.h>
@@ -245,6 +246,9 @@ struct ec_group_st {
 
 	int (*field_mod_func)(BIGNUM *, const BIGNUM *, const BIGNUM *,
 	    BN_CTX *);
+
+	/* Static precomputed multiples of the generator, if known. */
+	const struct ec_comb_table *comb_table;
 } /* EC_GROUP */;
 
 struct ec_key_st {
@@ -357,6 +361,30 @@ int ec_GFp_simple_mul_double_nonct(const EC_GROUP *, EC_POINT *r, const BIGNUM *
 
 int ec_point_blind_coordinates(const EC_GROUP *group, EC_POINT *p, BN_CTX *ctx);
 
+/* Fixed-base comb tables in ecp_comb.c. */
+#define EC_COMB_TEETH		7
+#define EC_COMB_POINTS		((1 << EC_COMB_TEETH) - 1)
+
+struct ec_comb_table {
+	int field_bits;
+	size_t nwords;
+	int spacing;
+	/* p, a, b, order, offset point and negated final offset point. */
+	const uint64_t *params;
+	/* EC_COMB_POINTS affine points, x followed by y. */
+	const uint64_t *points;
+};
+
+const struct ec_comb_table *ec_GFp_comb_table_lookup(const EC_GROUP *group);
+void ec_GFp_comb_select(const struct ec_comb_table *table, unsigned int idx,
+	uint64_t *out);
+int ec_GFp_comb_mul_generator_ct(const EC_GROUP *, EC_POINT *r,
+	const BIGNUM *scalar, BN_CTX *);
+
+/* method functions in ecp_p256.c */
+const EC_METHOD *EC_GFp_p256_method(void);
+int ec_GFp_p256_curve_matches(const BIGNUM *p, const BIGNUM *a);
+
 int ec_GF2m_simple_set_compressed_coordinates(const EC_GROUP *, EC_POINT *,
 	const BIGNUM *x, int y_bit, BN_CTX *);
 size_t ec_GF2m_simple_point2oct(const EC_GROUP *, const EC_POINT *, point_conversion_form_t form,
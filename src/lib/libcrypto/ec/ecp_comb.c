@@ -0,0 +1,1939 @@
+/* $OpenBSD$ */
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * Fixed-base comb multiplication of the P-256 and P-384 generators.
+ *
+ * A scalar k of at most EC_COMB_TEETH * d bits is split into d columns,
+ * column j being made up of the bits j, d + j, ..., (EC_COMB_TEETH - 1) * d + j
+ * of k. Entry v of the table holds the affine point
+ *
+ *	sum of 2^(i * d) G over the bits i set in v,
+ *
+ * so that kG is computed with d - 1 doublings and d additions of table
+ * entries, one for each column. The accumulator starts out at the fixed
+ * point 2^(EC_COMB_TEETH * d) G, which keeps it away from the point at
+ * infinity, and the resulting offset 2^(EC_COMB_TEETH * d + d - 1) G is
+ * subtracted at the end. Columns that are zero add a dummy entry whose
+ * result is discarded, and all entries are read for every column.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include <openssl/err.h>
+
+#include "bn_local.h"
+#include "constant_time.h"
+#include "ec_local.h"
+
+#define EC_COMB_MAX_WORDS	6
+#define EC_COMB_MAX_BYTES	((384 + EC_COMB_TEETH - 1 + 7) / 8)
+
+static const uint64_t ec_comb_p256_params[] = {
+	/* p */
+	0xffffffffffffffffULL, 0x00000000ffffffffULL,
+	0x0000000000000000ULL, 0xffffffff00000001ULL,
+	/* a */
+	0xfffffffffffffffcULL, 0x00000000ffffffffULL,
+	0x0000000000000000ULL, 0xffffffff00000001ULL,
+	/* b */
+	0x3bce3c3e27d2604bULL, 0x651d06b0cc53b0f6ULL,
+	0xb3ebbd55769886bcULL, 0x5ac635d8aa3a93e7ULL,
+	/* order */
+	0xf3b9cac2fc632551ULL, 0xbce6faada7179e84ULL,
+	0xffffffffffffffffULL, 0xffffffff00000000ULL,
+	/* 2^259 G */
+	0x79b2929fff83ab89ULL, 0x9c6c6f9d39d174f8ULL,
+	0xe08530e06875f641ULL, 0x518c254c3df2d2b6ULL,
+	0x9ecafd1a3594ead2ULL, 0x1c7347350eba0eeeULL,
+	0x33f1250fc8e2877fULL, 0xbf8462a0c9594300ULL,
+	/* -2^295 G */
+	0x91e47e81a2702034ULL, 0xe7c2a22f851a85cbULL,
+	0x4df395e96b1586e3ULL, 0x271eba368aa10940ULL,
+	0xd17dbe78df8083ccULL, 0xaf9f8a44fefe4ed5ULL,
+	0xac8bee2fc6aa6cd6ULL, 0x1cc1175055250fc9ULL,
+};
+
+static const uint64_t ec_comb_p256_points[EC_COMB_POINTS * 2 * 4] = {
+	/* 1 */
+	0xf4a13945d898c296ULL, 0x77037d812deb33a0ULL,
+	0xf8bce6e563a440f2ULL, 0x6b17d1f2e12c4247ULL,
+	0xcbb6406837bf51f5ULL, 0x2bce33576b315eceULL,
+	0x8ee7eb4a7c0f9e16ULL, 0x4fe342e2fe1a7f9bULL,
+	/* 2 */
+	0x0375c0c6edee30eeULL, 0x48526336679189f1ULL,
+	0x9ba834fcb1840971ULL, 0x9ba1e12f974ac9f3ULL,
+	0x8a96b83b67b43c5eULL, 0x62067ebb8c7d4f38ULL,
+	0x277c3eea86a877beULL, 0x03d2f132311bea6cULL,
+	/* 3 */
+	0x58bdfa8e66d4e2bcULL, 0x8f77a5699b1f858bULL,
+	0xfeec5805b6fb1070ULL, 0x1cdf701e9d64351fULL,
+	0xba4270422783ba45ULL, 0x54b09ce3f7665b19ULL,
+	0x0bca94aa8c656862ULL, 0xc37d7f62c43c6b76ULL,
+	/* 4 */
+	0xe3065e088a6edbf5ULL, 0x2f3352569662876bULL,
+	0x68991da7fdadd0afULL, 0x870ac12ba3dd7774ULL,
+	0x1906d2dcf02f8ce3ULL, 0xd03c64022e5f297eULL,
+	0x8de7efd769d05a67ULL, 0x7543728b999a7699ULL,
+	/* 5 */
+	0x49f68919717a0611ULL, 0x3976a29628f17701ULL,
+	0x09cdeb9d5df3cb83ULL, 0x183c55cccfb6448fULL,
+	0x1b6d1b3f70efbce8ULL, 0x79ff4484167e6228ULL,
+	0xfa41c36ff6290b34ULL, 0xeaef1249e5b76b65ULL,
+	/* 6 */
+	0xab814d533cbbefedULL, 0xf8be9039954dc9bfULL,
+	0xf4a37670cd8c0283ULL, 0x2f9dbe73e6ba82a1ULL,
+	0xb81599f8d1d6a70bULL, 0x999f89e26f03ea33ULL,
+	0x03c22e406760d69fULL, 0x21fcf329adf757c5ULL,
+	/* 7 */
+	0xb41b1d2da97ab1ecULL, 0xb791778483ceba2bULL,
+	0x45fbec0d8d2850deULL, 0x7a20b5fd3a6376b1ULL,
+	0xb2d21722685f8d97ULL, 0xa073f8d622ee2184ULL,
+	0x97cc89513f46a374ULL, 0x477f1d41175fadadULL,
+	/* 8 */
+	0xc828bbee5ab90065ULL, 0x26ddc475bbfa75b7ULL,
+	0x899db93959f2e876ULL, 0x778468f5252b48e4ULL,
+	0xc8f76aa2f2d79ff1ULL, 0x27bbcaef00acdaafULL,
+	0x6f65136a7f01e2e9ULL, 0x43341ab10eb39ca0ULL,
+	/* 9 */
+	0x16305832fc602827ULL, 0x08e0b37955c1b372ULL,
+	0x7dcb57f72aa3a67bULL, 0x5ff1b63d4fb0f09aULL,
+	0x370a46361c854f7fULL, 0xd837f9a72830f455ULL,
+	0xaa0d33f2a2d58aceULL, 0x562e4757c490b3f0ULL,
+	/* 10 */
+	0xd951455c67133da0ULL, 0x5c33d2d57d522801ULL,
+	0xeb861b7e5522513bULL, 0xdd94e527a9bddb23ULL,
+	0x9aae881aed52f78dULL, 0xb866257d35636a4aULL,
+	0x5096ae5e6d5c0edfULL, 0xabe29c0976d903cbULL,
+	/* 11 */
+	0x8157fd7f79023d63ULL, 0x7f9603bf056de78bULL,
+	0x3790a889214df921ULL, 0xa20ccb8e9a3a5a1aULL,
+	0x9beb594bf75787b1ULL, 0xdd806f4f86119c08ULL,
+	0x6d3a51e8d8071364ULL, 0xfcaa5616157a43aaULL,
+	/* 12 */
+	0x3edeae1f5e65793aULL, 0xf7446d1e750d12e8ULL,
+	0x91347bb232b15d89ULL, 0x59d23a8ac3482a16ULL,
+	0x5f5745f5b992738bULL, 0xafcb7db56d8c4facULL,
+	0x80996007131c4dafULL, 0xc8581e57073e6f3aULL,
+	/* 13 */
+	0x517cac57375c4aebULL, 0x352499bc4ff16bd2ULL,
+	0x2c1b1032b0d265e8ULL, 0x2db3b36bf4174ea4ULL,
+	0x626c820d3315c1a4ULL, 0xc0e3ce26f851dcc4ULL,
+	0x274f1dfc8e9ee4e8ULL, 0x3030e74ee6039e6eULL,
+	/* 14 */
+	0xcf8c5bc9f9b57d43ULL, 0x06aab1b2df7837f5ULL,
+	0x00b2f292de594798ULL, 0x85002aad52fd480dULL,
+	0x59b94e2dc6a29dc5ULL, 0xf8908623cef0cafeULL,
+	0x677cd748f6e8fc35ULL, 0xabe7eee3efe8f5b3ULL,
+	/* 15 */
+	0xd7bb0d963488885fULL, 0xbe034befd505f8f6ULL,
+	0x64cd8f6e32acf6ccULL, 0x915f8e4cab84b50fULL,
+	0x0642ae382dc91bd4ULL, 0x966c989eaa59ac9eULL,
+	0x2d5eadc1fc41c571ULL, 0x43f8da79ef9d42cbULL,
+	/* 16 */
+	0x8ed9c7e787354b7aULL, 0x022eca56c3915c97ULL,
+	0x2397f463e53cde1dULL, 0x85685474d77e0848ULL,
+	0x8954402bd16e04c6ULL, 0x06a891dc1fd6fdbdULL,
+	0xeebc913b2a6f7287ULL, 0x20b50eb50bf587b6ULL,
+	/* 17 */
+	0x276cb26dca5e59adULL, 0xb688aafb13041de1ULL,
+	0x2f7d2235143bcf73ULL, 0xa91c74975977e774ULL,
+	0xf60def812f9d1ac9ULL, 0x0c67d5ea86e16ee7ULL,
+	0x85dd2dd94730f8d1ULL, 0xf59a5dd73b61ef8aULL,
+	/* 18 */
+	0xd3f9d42d8cf36ad9ULL, 0xb9690b4d79829551ULL,
+	0x68f8aa7c69c0cb15ULL, 0x7a14d3174417cc22ULL,
+	0x762f4567769c0debULL, 0x41c83cce466db4a7ULL,
+	0x260964003f81112aULL, 0x8d3f9367afa5346cULL,
+	/* 19 */
+	0xacc489037595efcfULL, 0x4a5b71716a99cfd4ULL,
+	0x85bbf7edfedc0578ULL, 0x1db5d227f5ec256bULL,
+	0x6ed1be54ffe44b30ULL, 0xb04d68207c5e5a75ULL,
+	0xa8fa90ca2aef51daULL, 0x9f26c31d30239a66ULL,
+	/* 20 */
+	0x152f12bc1cd329c4ULL, 0x7ec9c9a6919fb8b3ULL,
+	0xa1633debc3cb6101ULL, 0x5a4400f33f037ef9ULL,
+	0xa5a4f01fa2ac85aaULL, 0x86524ec31c1b7fbfULL,
+	0xeedc62afefa0da04ULL, 0x038920e48c41927dULL,
+	/* 21 */
+	0xfbe8361880a1c3b9ULL, 0x9f95b0ae1401c46dULL,
+	0x6c6a8cd04a76b0f7ULL, 0x5b246b2999159bdbULL,
+	0x6e68971a3aff0d3dULL, 0x2b046407fbb6d2f9ULL,
+	0xed8e3ff473ab7a26ULL, 0xb1cd06239f05a12eULL,
+	/* 22 */
+	0xa38f92c958bcb681ULL, 0x29cbe354b4024243ULL,
+	0x28968c22638128b8ULL, 0x133d93a53fac03a3ULL,
+	0xf6c9ec0997d94915ULL, 0x18c47ab6ce34773aULL,
+	0xc46d03ef0ab90ef5ULL, 0x187459b0e8e5606bULL,
+	/* 23 */
+	0x0f0d0ac34440b2b4ULL, 0x6e5babc4bc2466ebULL,
+	0x75d997e56e87ae5dULL, 0x7b2a3707ca353d97ULL,
+	0x428039e7d2ef2f0dULL, 0x48db0cf6cc91e514ULL,
+	0xe15faae7a685b5f5ULL, 0x71503b9ea42752ccULL,
+	/* 24 */
+	0x28cae647f2a2270aULL, 0xff3a8651e1a786a1ULL,
+	0x9ef040057e36c0c8ULL, 0x2bc9d2bc2970472bULL,
+	0x0ecd4c3a0593b93cULL, 0xbc1125ccf98e059cULL,
+	0xe06b756885722f61ULL, 0xb3ab9ecb71f2cc65ULL,
+	/* 25 */
+	0x2c69afa5fb261aa1ULL, 0xead7ebfed0c7a52cULL,
+	0x3daa5f8cb646aa17ULL, 0xd1f26b5157a729feULL,
+	0x2a8c2a344f4a595fULL, 0x85c3e8ce9369f6b9ULL,
+	0x1f710903d4c3b33dULL, 0x48f6097248fc1423ULL,
+	/* 26 */
+	0xc69055608eb04a4dULL, 0x8e39bc8b76ea53bbULL,
+	0x77a02bc2fbce3120ULL, 0x8238d66722134187ULL,
+	0x5bcea4a728e5919cULL, 0xdd211d2c2003207aULL,
+	0x6c3c9666e91352f7ULL, 0xb9a3b4c76a085074ULL,
+	/* 27 */
+	0x84a6754da28f8357ULL, 0xa888dbcdb1e5c11cULL,
+	0x04f6d9b114bc3317ULL, 0x33f6e36fddf0882eULL,
+	0x51f4afb5ae7f395cULL, 0xc20ecf5252720c58ULL,
+	0xd7311e4fdf7e9952ULL, 0x9e193aa7df4f8977ULL,
+	/* 28 */
+	0x8d45f3205b58ae2eULL, 0xd47253cceed918e9ULL,
+	0xfd48b25d2b80860eULL, 0xd501838d4802d44fULL,
+	0x885b22826b63cdccULL, 0x4d41f8492a147627ULL,
+	0xd65774734fd44948ULL, 0xd3dccc9259e4672bULL,
+	/* 29 */
+	0xcc5c715c7dbcd045ULL, 0xcb2a442f6ac5be08ULL,
+	0x6fc337a41a304fd3ULL, 0xbe2b31dede391401ULL,
+	0x5204390d4d3d27a8ULL, 0xfefc9aab8e70b527ULL,
+	0x3f9b7392c7df79dfULL, 0x90eba9be2c667970ULL,
+	/* 30 */
+	0x78471b6d9bc307e8ULL, 0x769a1bcfbf92140bULL,
+	0x4ff6e35f030738e4ULL, 0x303cf36db8918dcbULL,
+	0x66e0519da1033335ULL, 0x539dcd6481ea8709ULL,
+	0xc20fc3556c346faeULL, 0x85cc0e9ac85f2a05ULL,
+	/* 31 */
+	0x28a277c4e76a12ccULL, 0x53bfed843ec44c95ULL,
+	0x2aed681120359286ULL, 0x041d2ca5752e012eULL,
+	0x881723b2717476e9ULL, 0x60c9ef6ea64a3fe6ULL,
+	0x69f0a26e62dd41e9ULL, 0x19d42e8cb74fbf79ULL,
+	/* 32 */
+	0xae03ad0f9d2157ffULL, 0xe9817b137d07f1eeULL,
+	0x751a418ae4eb8eeeULL, 0xcafb6c8657874a09ULL,
+	0x16cec08173ce8988ULL, 0x9c6ab445913b9e0eULL,
+	0x01a1cbb99ab4e2e0ULL, 0x2adafb1ed5c5c67aULL,
+	/* 33 */
+	0x021d982aa0d850bdULL, 0xad607931684f68ebULL,
+	0x17c84c69ddf6fdcdULL, 0x653daef9eb3f4758ULL,
+	0x3deaa6abef152b37ULL, 0xde7fdabef69b2dabULL,
+	0xdd7206b041754fa5ULL, 0x2dc979f8f9e0180cULL,
+	/* 34 */
+	0x510bfc65da6136caULL, 0x2e845ca0b36fd47cULL,
+	0xc01716b939dd5bb6ULL, 0x7e39fd71074fdb24ULL,
+	0x0f68aa57c369e75bULL, 0xf2868efff4812e28ULL,
+	0x2a243cf048bc3d12ULL, 0xa9e08182f613e54dULL,
+	/* 35 */
+	0xcaa9300db98f8d22ULL, 0x2e1dd47bb24f88ecULL,
+	0x9fdbff50b72a2a93ULL, 0x8970f0d55d9d5271ULL,
+	0x268f3bcc7c42a345ULL, 0xe4cc1179df9f7224ULL,
+	0x099ca8ca56abd051ULL, 0x2fb9e59985b95353ULL,
+	/* 36 */
+	0xc097390cd863f759ULL, 0xea211e6e582bb10dULL,
+	0xf6a7e773a6eeaf2dULL, 0x604cd7a9596e7d3eULL,
+	0x511e5e9f5ac9834eULL, 0x726ab215152e025eULL,
+	0xa8d1aab9c7493ab8ULL, 0xb0d3047ff215eab7ULL,
+	/* 37 */
+	0x7432a56831386b9aULL, 0x5eaa5d286b22f44bULL,
+	0xf12faa49bcec4dbfULL, 0x3d79133093b62c32ULL,
+	0x211cc0547caa6385ULL, 0x7e56d9b4c3144294ULL,
+	0x06792e136ed5ebb8ULL, 0x692fdf6eca8404b5ULL,
+	/* 38 */
+	0x5b6ccf3c0825dbcaULL, 0xa1a44d3e6c34611aULL,
+	0xf850dabaf7c7830fULL, 0x56c1832819ee0adcULL,
+	0x499d129077cd678eULL, 0xa7e84f1611d507faULL,
+	0x5c967c616b637a85ULL, 0x7e8cf775241806ccULL,
+	/* 39 */
+	0x93faa7b8c047ec08ULL, 0x75d93a3c2a564e48ULL,
+	0x775a58508e40783eULL, 0x0ee8d540a5723c39ULL,
+	0xd65ac60ead05f672ULL, 0x171484012f2ada52ULL,
+	0xfd4c754fa1935de7ULL, 0xffac4bd5061a7c82ULL,
+	/* 40 */
+	0x8c76490bd4d77718ULL, 0x42b948121c75ed5bULL,
+	0x32010fcfb29e28e0ULL, 0x5485b44bff4122e4ULL,
+	0xe3f6ea958898c910ULL, 0xe7d089f0911b3fd5ULL,
+	0xde87b50bf4cd9441ULL, 0x97178a0ed8a21e74ULL,
+	/* 41 */
+	0x3e9d81c01a6fb1beULL, 0xd9a803ed8653c8e3ULL,
+	0x18c67e5a8e49efb2ULL, 0x9b3d25f7b9f2ac55ULL,
+	0x313ba23da2a90e50ULL, 0x1c09a37e810690bcULL,
+	0x0fbe034518b63edaULL, 0x36d4e3086496f26cULL,
+	/* 42 */
+	0x6f10d9a45ec596ceULL, 0x42a08c279fd1f674ULL,
+	0x3eea2867c43b83a6ULL, 0xa13ae0fc57b71750ULL,
+	0xe3ca37ef2b9d74b9ULL, 0xa36378b844753857ULL,
+	0x6ae6d13b8ee7fa49ULL, 0x0a179e6c6bdb78b5ULL,
+	/* 43 */
+	0x1245d89049ebc3edULL, 0x3b98c994bfd91a7eULL,
+	0xf35b885e64ff8b35ULL, 0x96660a48f355ffecULL,
+	0x247a9dae51bbf899ULL, 0x16b0668b4f36401bULL,
+	0xb213c88bfc6d187cULL, 0x5501f3e47d325507ULL,
+	/* 44 */
+	0xe1f5f54e2b0d84faULL, 0x33c8ec063c4665b5ULL,
+	0x8d7abe9aa7c49ecdULL, 0xfe4ce5ba288b5c07ULL,
+	0x917a5d2f90e0ac9dULL, 0xf435581f033fa1b6ULL,
+	0xa5ec4c6de7c8651dULL, 0x1d9de93dcc70571dULL,
+	/* 45 */
+	0xddd4eb0f7b7d8dd2ULL, 0x3f78f6be5547dfd0ULL,
+	0x3a6db541604c7c2eULL, 0x10ca9a6f6f2f1d36ULL,
+	0x174de23527afc848ULL, 0x7d7a044f85e89cd7ULL,
+	0x378042b8ed532118ULL, 0x1d119a381f51fa9fULL,
+	/* 46 */
+	0x5a048cba65010581ULL, 0x8ea1cdeba9764f1eULL,
+	0xcb1c7daa75a732a4ULL, 0xb8b3097b4f0a783dULL,
+	0xc091534ed2c386a0ULL, 0x5aef873a1f09d937ULL,
+	0x25a954a4d2ddb723ULL, 0x46345836a491bff6ULL,
+	/* 47 */
+	0x01957c792545c3f6ULL, 0x4dd11bbe59cc90d6ULL,
+	0xae52607761ac362bULL, 0x0d0cd0c5cdc0a72dULL,
+	0x71c841c99e4947d7ULL, 0x5db7ea1ae05a7686ULL,
+	0xf2d5175388bbda1eULL, 0xdd0da9aa110c6d73ULL,
+	/* 48 */
+	0x5cf767d121a14396ULL, 0x8af5fecbc7676311ULL,
+	0xe85586e9adf34b24ULL, 0x592b7771017cbcd5ULL,
+	0x7baf3ef53d7dcaa5ULL, 0x975acaef60252948ULL,
+	0x7484bb4a39161610ULL, 0x2e9d3fd8233d4e21ULL,
+	/* 49 */
+	0x24bd92e11f5d4f2eULL, 0x33eed23ded3a7fe3ULL,
+	0x30ef32769921bcaaULL, 0xfe1e17206a190783ULL,
+	0xa74bbfcad0b38fc1ULL, 0x6ad56fbd26238537ULL,
+	0x1453c53fa24dce0dULL, 0xb8d66f8d572e13f3ULL,
+	/* 50 */
+	0x7b11c7807802b536ULL, 0x57e701f14a8a4483ULL,
+	0x85df91fa76ae31f7ULL, 0x4f3b77e020f85c0cULL,
+	0x992104582d12869fULL, 0x3c27086ae672032eULL,
+	0x122fa51bf2d08016ULL, 0x549cdfef071462d8ULL,
+	/* 51 */
+	0x55135fa96ddba35bULL, 0x3c4793c20c99febaULL,
+	0xa6984ded65cd5361ULL, 0xc1e9df7223f804feULL,
+	0x5161a44d34782a6fULL, 0xc2b442968f580e37ULL,
+	0xbb2456ca677f245dULL, 0xf8d4093f6bcd8a73ULL,
+	/* 52 */
+	0xad422072f5f7557bULL, 0x95e2f63a528d1b1fULL,
+	0x414b2e3123401918ULL, 0x7b1e1e4db978207cULL,
+	0x0d3152ea5f136cc8ULL, 0x4d020b31f099189eULL,
+	0x1e2b24a9bda0aac9ULL, 0x6ec0a87136837bc5ULL,
+	/* 53 */
+	0xa9d5f26280c658c5ULL, 0x71c15750eda7045cULL,
+	0x54f4299bc92a5ff3ULL, 0x607d7c03e7fe3be8ULL,
+	0x1ea184fee3354062ULL, 0x7d676238665a39b1ULL,
+	0x45280843706292b1ULL, 0xf5fb020012dad77fULL,
+	/* 54 */
+	0x0a3ce7d90567b6afULL, 0x35fce2cc1fe9b060ULL,
+	0x978de280d6c366e2ULL, 0x35c82caa63a55c24ULL,
+	0x7e575b4c6f52247fULL, 0x543c725052c0d05aULL,
+	0xc06521072a4c5063ULL, 0x0b30c4e1921b47e9ULL,
+	/* 55 */
+	0xe1101bf775a86757ULL, 0x3f34b01cc58780f2ULL,
+	0x0fd080f88a62312eULL, 0xb0d3cc7e693bcb40ULL,
+	0xe63ba9c1990247bbULL, 0x097dd0036f1a0521ULL,
+	0xba8e4a484ba1cdf9ULL, 0xb8e2eb267e38f247ULL,
+	/* 56 */
+	0xba9a9d9fe395ad3cULL, 0x8c4139082e93a661ULL,
+	0x5512ee0ef91ef0e7ULL, 0xa2339a1e807d27c0ULL,
+	0xd9bd695f0e64b317ULL, 0x5f8d0b8ac836d45dULL,
+	0x3304fd5a5deaf05cULL, 0x21ec4326ec8e61a8ULL,
+	/* 57 */
+	0x9cfcae873e929ca8ULL, 0xf2da271fe8bd2f23ULL,
+	0x04539fe3961d7e30ULL, 0x0a20e7bf67d3492fULL,
+	0xb614ea24ae6657c2ULL, 0x9cce0ecf9a218f37ULL,
+	0xa549588d745fc317ULL, 0xb33443648f34fc73ULL,
+	/* 58 */
+	0xe438131e837a26a6ULL, 0x5e96aec35958f726ULL,
+	0x5386fa4352ffaa7aULL, 0x23dc2ba67218161cULL,
+	0x9d192948d020ead4ULL, 0x33b8bc21f4deede3ULL,
+	0x25f35e39b4d35887ULL, 0xb676e24c1aacafe1ULL,
+	/* 59 */
+	0xca0bb384ae118becULL, 0x7e5efc7a2d6ec371ULL,
+	0x35ca3d70931f7a75ULL, 0x972b1cec11152993ULL,
+	0x4803e014fe636b50ULL, 0xa1519bcbbc38f77dULL,
+	0xdb75a8297bea81edULL, 0x3f2043e5da4b0f60ULL,
+	/* 60 */
+	0xb0a95a2569cf4771ULL, 0x2b7227e1a00f7f88ULL,
+	0x27135ac56bfa88caULL, 0xe23ce9ff64569862ULL,
+	0x1b2ed0ee4a5cf2e1ULL, 0x854c61dbf96e6063ULL,
+	0xa0459b90f7a16380ULL, 0xbe700cee1524fe40ULL,
+	/* 61 */
+	0xc6b3f2ad2c206717ULL, 0xf1692c2675abd071ULL,
+	0xbdd153de7394c19cULL, 0x447bcd3b89285704ULL,
+	0x78da031d34641e7fULL, 0x8e6ae13ba80bc2d0ULL,
+	0x72648472341942bbULL, 0x57c7ce3ed78b4f89ULL,
+	/* 62 */
+	0xa6fa57b5470948e1ULL, 0xb5daf9129c4b3a94ULL,
+	0x5f7c1c2f95ab0453ULL, 0x6fc9b32ff43204f5ULL,
+	0x9a6963de99305932ULL, 0x71c349938bea4defULL,
+	0x4044f679d7d51cd0ULL, 0x5bdfe7691760f324ULL,
+	/* 63 */
+	0xc0ba31a4d9fc1b22ULL, 0x60a1ae4c13b372b4ULL,
+	0x7434dd76cc798845ULL, 0xa7e388bf038a735dULL,
+	0x1124e44e3405bc7dULL, 0x4386fe5f3b79415dULL,
+	0xc43dc6fff54544e3ULL, 0x73ca7b06310f5380ULL,
+	/* 64 */
+	0x8eb8b6730050f080ULL, 0x95f5bbf94bf15388ULL,
+	0x1c42027371d3ac47ULL, 0xe7fe1a77506aebc7ULL,
+	0x48c989da99e9e32bULL, 0xf8edfb37676496a8ULL,
+	0x1de51e7893cb5838ULL, 0x6a87c46d10e65dafULL,
+	/* 65 */
+	0x90a24801f40e5465ULL, 0x2f5a55365d1db99eULL,
+	0x2576a4713bd54e4bULL, 0xe87dcf14d2f78e00ULL,
+	0x31278d3d66dafb79ULL, 0xa942cf129091c8acULL,
+	0x55c2d2b384b5b27bULL, 0x52d5cee6ab579fe1ULL,
+	/* 66 */
+	0x4457378ee1337260ULL, 0x0ee699967c9bbec6ULL,
+	0x1f85f7fe1abe01edULL, 0x06202ab22797ad1fULL,
+	0x3c86d58de3c529a0ULL, 0x4df48a4f22d8eb49ULL,
+	0xfa8f3853d3e2e217ULL, 0xd0a42cab808659e7ULL,
+	/* 67 */
+	0xa1a8ffd46d6585d1ULL, 0xa149e128abafa172ULL,
+	0x8f5b3ade78d9712aULL, 0x9c70167c0c2862cbULL,
+	0x6d636942e2584aecULL, 0xc7aa1f93c5dd4e2cULL,
+	0x5bfa87232d174b65ULL, 0x64ce6d36522a96e4ULL,
+	/* 68 */
+	0x9d5dbba38aa80ecfULL, 0xe5ce325df79bc683ULL,
+	0x1572db6b00c3847dULL, 0x0141de5e84e193f7ULL,
+	0x489ff47137fd6721ULL, 0xeb35fa6a0d3a321cULL,
+	0x3aa151b35de420dcULL, 0x2d1ab83573d2c367ULL,
+	/* 69 */
+	0x6171553cd385a729ULL, 0x7af92da55164c6caULL,
+	0xfbd0e439144a5c5aULL, 0x9744f27a291576c1ULL,
+	0x607c63185d955ed1ULL, 0x5377113ace236be6ULL,
+	0x9b19348d2cf909d9ULL, 0x71520cdd4f5ec18eULL,
+	/* 70 */
+	0x95e9026468f49a02ULL, 0x322ff25c12144ba8ULL,
+	0x7408073b7806e1ffULL, 0xea087b6c74c50b6bULL,
+	0xcf684d3e350ccb95ULL, 0xc98ad7d7e5b85b78ULL,
+	0x5656ae5a77bb028bULL, 0x1c4f33cde40b70e5ULL,
+	/* 71 */
+	0x45261e75d1b3bb5dULL, 0x1a0627fe8ddbdf10ULL,
+	0xc7197ac318a57e32ULL, 0xfce636d82d326ccaULL,
+	0xc54ac12a2ea40061ULL, 0xb1fad88512f318c7ULL,
+	0xea8bafee4f7d05f9ULL, 0xf433b71476cd5ba6ULL,
+	/* 72 */
+	0x5d04be4f376bf946ULL, 0x8cc1466cbcaae24fULL,
+	0x0d40853020773338ULL, 0x2551e5d271445735ULL,
+	0x4fab742861299c54ULL, 0x5e68748e7407b865ULL,
+	0x8c76ab10067948afULL, 0x627eb86462c13fe5ULL,
+	/* 73 */
+	0xec5e5cc77d702e80ULL, 0x310eefc5a8ef02d3ULL,
+	0xfc8455ac64f07b5bULL, 0x49e1d8268c40a254ULL,
+	0x5c576ae2a0879d1eULL, 0xec4e52daa25ec098ULL,
+	0xbbced3dd9adb6e80ULL, 0xbd41dfa223c408d3ULL,
+	/* 74 */
+	0x1478d8f48422ee92ULL, 0xd9cf461dc5c9c065ULL,
+	0x7b277a4baafbcf7aULL, 0x6015f6d054223594ULL,
+	0x95e021819e88e975ULL, 0x678f4c04c2eb27c9ULL,
+	0xde9a5f8d50494ad5ULL, 0xdf082aa721a29006ULL,
+	/* 75 */
+	0x4c8b876b30f0681bULL, 0x1b635ae91b763543ULL,
+	0xb36c8605c125c12cULL, 0x90cd1070bca1ea11ULL,
+	0xbbadcdb832417470ULL, 0x0cdd185a67f527dbULL,
+	0x01f972bfa5b50054ULL, 0x6006e9875bee1982ULL,
+	/* 76 */
+	0xf2c91a329e8123c6ULL, 0xc684be8e82782dfbULL,
+	0x35c5c97a57dfb88cULL, 0x53fbe826db160070ULL,
+	0x774b46ad1afb0c93ULL, 0x7ee4845f72374583ULL,
+	0xcddcaaabe8363459ULL, 0xd007650376650369ULL,
+	/* 77 */
+	0x92c6c46e58b1ff29ULL, 0x5c30d98905b0500bULL,
+	0x268cb82b3a9a0269ULL, 0xcb20f1d40743dd0aULL,
+	0xc244224af18f9a55ULL, 0x036e32bfc72b298aULL,
+	0x35b032e256898e8eULL, 0x6c3c17dfbbaee0b2ULL,
+	/* 78 */
+	0x1116f263d90416eaULL, 0x101b6d5c62b80f23ULL,
+	0xfc02de5e6114d4c1ULL, 0xffeb404181400ad2ULL,
+	0xf702e73a339c3b00ULL, 0x36e9b488e34b4cc7ULL,
+	0x74cecfd5ab4e3285ULL, 0x6ae02fb503f23b11ULL,
+	/* 79 */
+	0x5738fcae12a99d2cULL, 0x4dcbf645f9a6efa2ULL,
+	0xc63dd4ebe452f126ULL, 0x462cb8cf1bd2f110ULL,
+	0xcefdb215df85cbf6ULL, 0x06237fc5f24cd959ULL,
+	0xfe158f415720a5f7ULL, 0xc5c768fa7ba270a0ULL,
+	/* 80 */
+	0xbda88ff1201a61c5ULL, 0x2658a4a11260680eULL,
+	0xdf89a1a698580cb0ULL, 0x6b7e274683c296a6ULL,
+	0xada106c377381a9eULL, 0x1e001a52cd9395d3ULL,
+	0x4ad13205bdcfa117ULL, 0x434aa11b43bf89efULL,
+	/* 81 */
+	0xbe3b93c77f8c6a16ULL, 0xa111691c1e7eeb97ULL,
+	0xc20662a7f831c143ULL, 0xa8d5b1284bad54ebULL,
+	0xf9e1d4c226e900b3ULL, 0x8f58482e0231b6b4ULL,
+	0xff6f737b0b3c2fa3ULL, 0x3592deba1af5207eULL,
+	/* 82 */
+	0xd1b7ca7d565997b7ULL, 0x9abfc1e7a06afdf8ULL,
+	0xc260d954a692ec51ULL, 0xacfa9310fc7313cdULL,
+	0x473cf0206a3842b1ULL, 0x60cb0f1818a1c763ULL,
+	0xc1c96c3c86cc53c0ULL, 0xf7d907dc76caf2d1ULL,
+	/* 83 */
+	0x929a3b1548c60096ULL, 0x3a5e28451ed1f604ULL,
+	0x7c6a713ef6889ea7ULL, 0x44544057e7b579fcULL,
+	0x87130f8c4cdca524ULL, 0x41d1c96caae8c04fULL,
+	0x3c1f415da6033d7eULL, 0xfcd2940b5ae7dbd3ULL,
+	/* 84 */
+	0x18cf336a3803b697ULL, 0x3d161f2743df76c2ULL,
+	0x03028d021466f364ULL, 0x4c488221449a2d05ULL,
+	0xb0bc9ebc4379dd6eULL, 0x0a1afcebe9dcea59ULL,
+	0x55764b4580e45176ULL, 0x4db4d66f7d58e0a8ULL,
+	/* 85 */
+	0xd93f027635b3656aULL, 0x74630cc7e6bc9a10ULL,
+	0xe82325c5b932adabULL, 0xd82f31d9420770afULL,
+	0x30b4df4ba5ece08cULL, 0xa0b3b51e32f2aa4aULL,
+	0x2b3a340817249a2aULL, 0x038f163aa1e6fd40ULL,
+	/* 86 */
+	0x8e68bae3b16ce3d5ULL, 0x2366e80845e6addfULL,
+	0xbddc7f51bd8229ecULL, 0xf8b03dfdf48b9eccULL,
+	0x0d96889d4d9620d2ULL, 0xbb7bd8db10772574ULL,
+	0x09ba186d5e81014cULL, 0xc23d2549ea037947ULL,
+	/* 87 */
+	0x422183685a1949b7ULL, 0xbf74f78effa82c56ULL,
+	0x57d63fae4545dbf6ULL, 0xf1cf58926b0cf9b6ULL,
+	0xc2a0ad3426087c01ULL, 0xf4e4d1fe0c930f68ULL,
+	0x75e60572f763282cULL, 0x939e06baa3667f6fULL,
+	/* 88 */
+	0x2c6fea0d797f1725ULL, 0x5e82f2338329981fULL,
+	0xe09472be417bfc0cULL, 0xf4005031c8400f5cULL,
+	0xadb9eb78f6c122a8ULL, 0xe561a9486d687f74ULL,
+	0x9b6bf3d2e822d48fULL, 0x059c9212ad298fe1ULL,
+	/* 89 */
+	0x95cf1ca078d80ecbULL, 0x27ea1d59d11127ebULL,
+	0x96c89c5a99300fc2ULL, 0xa99e00e002b3d55aULL,
+	0x59e766fe84e7c072ULL, 0xdb5f4f67bf72aba1ULL,
+	0xd629057dfb33097dULL, 0xdff379e724588385ULL,
+	/* 90 */
+	0xbd8bd787668740edULL, 0x07bdd7c4c5e971a0ULL,
+	0xe693858923136d18ULL, 0x54e8ab7d71e7a6a6ULL,
+	0x3ffd8a5aa65f21deULL, 0x452bc48b1d5a3483ULL,
+	0xed92c8a21c625ddbULL, 0x3f5913e4a91648fbULL,
+	/* 91 */
+	0x45226040a8a370efULL, 0xf7104cec7a8b955aULL,
+	0x5ab4cf5f97124479ULL, 0xce0b469c73cfd499ULL,
+	0xb51056c8e433e07bULL, 0xc4a6379ca1d6e672ULL,
+	0x9921fcea45811df9ULL, 0x23997e13e2db10e5ULL,
+	/* 92 */
+	0xbe8a4b2448706874ULL, 0x1a225da2f67a3326ULL,
+	0xdcb8e2559bba06ccULL, 0xa9cb8a724dbe416dULL,
+	0x83acd7267d4ddeefULL, 0x039dec7db73c448cULL,
+	0x64e17a7056fac819ULL, 0xba3fe14ba7c1e330ULL,
+	/* 93 */
+	0x3c6887d457b77133ULL, 0x5fc726c31324f743ULL,
+	0x61e02b60b4416b49ULL, 0xad9ecce8f451d44fULL,
+	0x7d8d52af4d9af768ULL, 0x121b624c33626482ULL,
+	0xbfbace131f05a7a5ULL, 0x4c8cdb1e081513f6ULL,
+	/* 94 */
+	0x8d4ad81de31b373dULL, 0x7fc6989b25482047ULL,
+	0xe220378a01d838dfULL, 0x1f30a383bd0b6f21ULL,
+	0x7601df647a382ca6ULL, 0xdde6f522980b2b8fULL,
+	0xba088463d6a64713ULL, 0xedb44c615be274d4ULL,
+	/* 95 */
+	0x2c185c894b5e7018ULL, 0x41d56ef8036c4cdbULL,
+	0xb278f0bdb9f6a6f7ULL, 0x81394fe4bf1e1d35ULL,
+	0x39eb6488313ca827ULL, 0x8542546d89b397f4ULL,
+	0xa50b02ab0c922ccbULL, 0x46c0e7ca601067c0ULL,
+	/* 96 */
+	0x3b08078192d30134ULL, 0xf1844eaded096010ULL,
+	0x7a2b1e06985dcc49ULL, 0x769ef55f8d22a72aULL,
+	0xc2a508628f140839ULL, 0x8e9fc3a4b3f999f8ULL,
+	0x809a8e1a2d43077dULL, 0xd305544f45c7e1d0ULL,
+	/* 97 */
+	0xb017c38ad5a60665ULL, 0xc9467b0575e88ea6ULL,
+	0xa1f30d0f6f7875f8ULL, 0x6c509286d4d52601ULL,
+	0xd1a5fb7c1f2e45f0ULL, 0x5ff49a6b13401739ULL,
+	0x4a4c26bb87fa69e2ULL, 0x214eaccb6b6acc99ULL,
+	/* 98 */
+	0xc5cd2b6af861fdf3ULL, 0xf6fb9a9d73a6b84aULL,
+	0xf005ab4521b6a042ULL, 0x6155140aef92abaaULL,
+	0x1add366d5e2f09a8ULL, 0xeceb92b6a71df611ULL,
+	0xde92041eb8a41a56ULL, 0x74ae29f7d1e898a0ULL,
+	/* 99 */
+	0x99c02786925f1bcfULL, 0x4c4f91f35be1197fULL,
+	0x4d0a537765647440ULL, 0xf4917bee225a8b2cULL,
+	0xfa755a6b759767c2ULL, 0x74ff7812d46f4804ULL,
+	0x951140c7cdeedfd4ULL, 0x6d00e5989380f1c5ULL,
+	/* 100 */
+	0xd1e6c783d7ae823cULL, 0x5ea141282a1a8b21ULL,
+	0xfb08b8b6378e97ceULL, 0x1cb9107b95971fa7ULL,
+	0x94d21d0a51317866ULL, 0xbaa3941eab2b9c75ULL,
+	0x1a2ba3a8cdfa7b88ULL, 0x6b03964ceb970d1dULL,
+	/* 101 */
+	0x1a20a3700bb76779ULL, 0x111ce0e1306978edULL,
+	0x759480974ac022c4ULL, 0xb645f91b43655cb0ULL,
+	0x5bcf539f12cd92b0ULL, 0x2137a9373a757338ULL,
+	0xead461a2e36ae9a7ULL, 0xe1a101da12cf530eULL,
+	/* 102 */
+	0xdb769d5a6f88e860ULL, 0xa54aa42cd80551b8ULL,
+	0xd7dd30477d393c1aULL, 0xe3205539a7449f61ULL,
+	0x969114e6e0569acfULL, 0x3fc43bf37ce850cbULL,
+	0xb7756fa7e522e4acULL, 0xecab876dd081ce83ULL,
+	/* 103 */
+	0xd5debc9acd528b04ULL, 0x625f31b81b786569ULL,
+	0x2d3179679fa42b4dULL, 0xc7ddc4abaebc9b0dULL,
+	0x315918e7b53cbc38ULL, 0xd5c518ddccd2550eULL,
+	0x2ef47ccbe5aa733cULL, 0xf300d8dec28e171eULL,
+	/* 104 */
+	0xeb7ea8bb53a30f8dULL, 0xb7848b15443201c2ULL,
+	0xf9670bad65b7a055ULL, 0x086f65eb946ef162ULL,
+	0xe775d31b42129e75ULL, 0x2dcd0b77e4811425ULL,
+	0xbf6eba4a6679f9bfULL, 0xb2c13681e3387be3ULL,
+	/* 105 */
+	0xd65c0764d5c95c8dULL, 0xe11f88211721da03ULL,
+	0x4e9ecd19b9760799ULL, 0x06b94ad8465e5431ULL,
+	0xee764ddf1bea72e0ULL, 0x36462bd1b211aee1ULL,
+	0x436d7a522f36fb4eULL, 0xf755f660652e7f00ULL,
+	/* 106 */
+	0xfbd2a03af3369fe4ULL, 0x8af2982cc2285263ULL,
+	0x1414722e352a4c84ULL, 0xb39164c8abe7c579ULL,
+	0x4e99305595484c63ULL, 0xd5b1d40ec12a00cdULL,
+	0x109177325f0fa7e9ULL, 0x8112aaec76f6ad12ULL,
+	/* 107 */
+	0x51ad6c572e769094ULL, 0x4c90638f28b20fbcULL,
+	0xe55fbaf589b9b68dULL, 0x31bb4fc17405f739ULL,
+	0xaa157461686f057eULL, 0x3b10a8b54ae16adfULL,
+	0xc3e983b107605f1bULL, 0xe3b13e088d413930ULL,
+	/* 108 */
+	0x6166a94ea62fced0ULL, 0xeac83d88b3204c3eULL,
+	0x30e0b7dc80bcbc8aULL, 0x2e048d49c5effa98ULL,
+	0x328b4160185449f2ULL, 0xcdd52bef2113533cULL,
+	0x4bd2b34551732fcaULL, 0x1d1f89d858836acdULL,
+	/* 109 */
+	0x85837648a2d942a8ULL, 0x84e0fa3fa22abe50ULL,
+	0x5bb2a97b3f897130ULL, 0x6bfb07c6c763182cULL,
+	0x605895c6b1686c8fULL, 0x6014326c5279f0b4ULL,
+	0x76e751417051c4a1ULL, 0xe69c8a3613f25022ULL,
+	/* 110 */
+	0xec0d6d308a9e97a1ULL, 0x63513760df30d70cULL,
+	0x284c53217368b7a3ULL, 0x8e8823e648094fc7ULL,
+	0xa5cd86bef4c7af80ULL, 0x6794200aa47799bdULL,
+	0xdddffa6680210825ULL, 0x83d1af06c43ba36aULL,
+	/* 111 */
+	0x98bbe4b018053678ULL, 0xcb297c10f426f786ULL,
+	0xb5841fa238ea1ef3ULL, 0xac1b6cb44bb34022ULL,
+	0x6059f09f4618e123ULL, 0x62575192a66bf193ULL,
+	0xc529cf799af6d75dULL, 0xcab819ed1a4b66fbULL,
+	/* 112 */
+	0x741c31eaf0ca8bf0ULL, 0xe1d97dec62ff6ed1ULL,
+	0xa4832d222c7bd60fULL, 0x541a3619552a462fULL,
+	0x4447ac34dbb7484cULL, 0x1b21fd3a662ba479ULL,
+	0x902c53c2cae027d2ULL, 0x4833d498b6c3266aULL,
+	/* 113 */
+	0xcbd88b2e1da1b1d6ULL, 0x7b87d24bc27b1e7cULL,
+	0x3d7743980c3b0b1dULL, 0x6910d00af86a7731ULL,
+	0xab22c0bcdd8a50acULL, 0xa711161186d5b8b2ULL,
+	0x998e16b2ccfb442dULL, 0x45e46a3c1f29a772ULL,
+	/* 114 */
+	0x6856d9fd2ec49b3cULL, 0x93be0eb71119f756ULL,
+	0xd6b2f2a26df9ef32ULL, 0x472aef99ba03f017ULL,
+	0xf9469686992feeacULL, 0xd7e91988dd2dcc54ULL,
+	0xc4d50db95f443f67ULL, 0x2589e78c8bd36311ULL,
+	/* 115 */
+	0x7a58240d2d16bcb7ULL, 0x1e919fc3735406f1ULL,
+	0xa7f9f8fe66f42da8ULL, 0x8bb9df269a32bdd9ULL,
+	0x66ceb32e2ee5701eULL, 0x0b1c63fc3e6d2a65ULL,
+	0x919abf7ba841114aULL, 0x1fc1632045b20c63ULL,
+	/* 116 */
+	0xe1cd4d12292a2401ULL, 0x316f7e6f61797af9ULL,
+	0x526242ab9e20785cULL, 0x36e3d412fd705c50ULL,
+	0xb730992312b479e2ULL, 0x022f7397f24e63e1ULL,
+	0x52e59bdc732f6b79ULL, 0xcdf78298f2d164d0ULL,
+	/* 117 */
+	0xd1d2098070adc81cULL, 0xc8b2dda7960a6585ULL,
+	0xdd183c832e7b4dc2ULL, 0xf656144fa4664c88ULL,
+	0x66dd8d864e99242bULL, 0x9c9dee9d78e0dd46ULL,
+	0x2ca7943666760073ULL, 0xe97e38b820d638ceULL,
+	/* 118 */
+	0x3e65bad47450fd77ULL, 0x558fd989f34ae714ULL,
+	0xe458929f6d86e483ULL, 0x403e195c361ed211ULL,
+	0xbee0f0f9f982cb9dULL, 0x310626b8b9f3b703ULL,
+	0x368c5e8253f1b157ULL, 0x357226eca863892cULL,
+	/* 119 */
+	0x77d30c0ec6fb151aULL, 0x449f5e48971ab9b7ULL,
+	0xcc748405e83d22e3ULL, 0x9162b379b24ca275ULL,
+	0xd22731394b19fd36ULL, 0x070cc4b6bda82a01ULL,
+	0x669feb9ac9747b7eULL, 0x723a6967ab9f91c0ULL,
+	/* 120 */
+	0x9b731621cd0028e3ULL, 0xf7077de1a56348b5ULL,
+	0x53f7541d99621421ULL, 0x100d3167317b67d3ULL,
+	0xe2a4b6b7f79132d2ULL, 0xa4cba24a9ff4cefbULL,
+	0x6f45c4507cdf62c3ULL, 0x2f0c826741beea4dULL,
+	/* 121 */
+	0xae2cf87db33cf553ULL, 0xc50caddaa6b4c27cULL,
+	0xc534b887e95e0decULL, 0xa2074157bd82cec7ULL,
+	0xf3c96d24e247b7faULL, 0x87f4fb64fd7dcb2eULL,
+	0x3fba3a3e7d286ec2ULL, 0x2a278df291a9195bULL,
+	/* 122 */
+	0x4c6f213a436afe4cULL, 0xdc1e4204582aa567ULL,
+	0xb4db2792248cbe15ULL, 0x3d0ee41da2317ca7ULL,
+	0xe97fc1134f8a2278ULL, 0xefc7b9c26255e059ULL,
+	0x028d1768502a1c11ULL, 0x3b7627e1a6f94e61ULL,
+	/* 123 */
+	0x6ac340a89b25d403ULL, 0xe42fcef60472f36eULL,
+	0xa70637cddcfaea04ULL, 0xa307fe977912171aULL,
+	0xb9975a732fcd396fULL, 0x875e1667a9019979ULL,
+	0x7be849940e736a92ULL, 0xd5ac811386c989faULL,
+	/* 124 */
+	0x79c046c6264d7506ULL, 0x8ab146b56e52047aULL,
+	0x4d3901579384bffaULL, 0x9c54821f7251e621ULL,
+	0xcf118fdae3253875ULL, 0x971591780b835969ULL,
+	0xfa2686d3c7f0be4cULL, 0x8678c219d8c57b94ULL,
+	/* 125 */
+	0xe94ae5cca9de6e6fULL, 0xa809c530e02c002bULL,
+	0xf8613a85d0bf0cf6ULL, 0x07bbb3a049b5056aULL,
+	0x2f384bdc1cc0c289ULL, 0xf07e08ad51776494ULL,
+	0x8544b598979c0f51ULL, 0x20404024122d9076ULL,
+	/* 126 */
+	0x529ec13ca5011809ULL, 0x26056b4abf0052cfULL,
+	0x80f1ccaaa068910cULL, 0x8fbcce1b58efbb37ULL,
+	0xbfdf0eb5f1b20c19ULL, 0x7845fd8130dc3810ULL,
+	0x02f4615c54cf5fa1ULL, 0x99b85163359ae114ULL,
+	/* 127 */
+	0xd32ef27df303c9a3ULL, 0x7a11c23dd7524e61ULL,
+	0x5e02cec26c1e9848ULL, 0xd032291f60453fb4ULL,
+	0x1be2de558b6266d9ULL, 0x36fbe4235d2bcf0eULL,
+	0xf6820f29a79976d4ULL, 0x9eda119ef6e30808ULL,
+};
+
+static const uint64_t ec_comb_p384_params[] = {
+	/* p */
+	0x00000000ffffffffULL, 0xffffffff00000000ULL,
+	0xfffffffffffffffeULL, 0xffffffffffffffffULL,
+	0xffffffffffffffffULL, 0xffffffffffffffffULL,
+	/* a */
+	0x00000000fffffffcULL, 0xffffffff00000000ULL,
+	0xfffffffffffffffeULL, 0xffffffffffffffffULL,
+	0xffffffffffffffffULL, 0xffffffffffffffffULL,
+	/* b */
+	0x2a85c8edd3ec2aefULL, 0xc656398d8a2ed19dULL,
+	0x0314088f5013875aULL, 0x181d9c6efe814112ULL,
+	0x988e056be3f82d19ULL, 0xb3312fa7e23ee7e4ULL,
+	/* order */
+	0xecec196accc52973ULL, 0x581a0db248b0a77aULL,
+	0xc7634d81f4372ddfULL, 0xffffffffffffffffULL,
+	0xffffffffffffffffULL, 0xffffffffffffffffULL,
+	/* 2^385 G */
+	0x5c9dae5daefc1a6aULL, 0x3ff04eaf779d4fb3ULL,
+	0xc2b6a771536101aaULL, 0x818db83e1c01a5afULL,
+	0x028801070fa61278ULL, 0x8ba8ab9b731935b8ULL,
+	0x060f89c9b0b5810cULL, 0xc49ac2459dd3e4eeULL,
+	0x45b552f1ae223d25ULL, 0x2a5d3abab9e513afULL,
+	0xb67f8bf12f92c0a1ULL, 0x4a608e6f81381fd4ULL,
+	/* -2^439 G */
+	0xe1294ddea736dda0ULL, 0xcc360ae6ff30ff8eULL,
+	0x39d10fd55196ee59ULL, 0x96a705821d9931ecULL,
+	0xd8cb166c770796c0ULL, 0xbc30750d16ecac19ULL,
+	0xa5d48403c9fd6a33ULL, 0x4ec789a040a4660fULL,
+	0x6c65d4f099e54889ULL, 0x65d6fecb07bce3e0ULL,
+	0x3fd7b7e293de2158ULL, 0xd86fb079c38d0693ULL,
+};
+
+static const uint64_t ec_comb_p384_points[EC_COMB_POINTS * 2 * 6] = {
+	/* 1 */
+	0x3a545e3872760ab7ULL, 0x5502f25dbf55296cULL,
+	0x59f741e082542a38ULL, 0x6e1d3b628ba79b98ULL,
+	0x8eb1c71ef320ad74ULL, 0xaa87ca22be8b0537ULL,
+	0x7a431d7c90ea0e5fULL, 0x0a60b1ce1d7e819dULL,
+	0xe9da3113b5f0b8c0ULL, 0xf8f41dbd289a147cULL,
+	0x5d9e98bf9292dc29ULL, 0x3617de4a96262c6fULL,
+	/* 2 */
+	0x74b2c9a3f521fba5ULL, 0x21349f8764941e56ULL,
+	0x3ef7d2423f9174e8ULL, 0x089308abca72220cULL,
+	0xfec29bad206f718bULL, 0xa6e91f7bc788147dULL,
+	0x51c7be14dcacfd16ULL, 0xe4be4a2de07399c5ULL,
+	0x1a835c46822311e1ULL, 0x738c524dd5ae1ef2ULL,
+	0x986a639d7aa91c42ULL, 0xc1ee3a5cd2b8bf6fULL,
+	/* 3 */
+	0x193dae26d443b051ULL, 0x2226318d6f7d7e19ULL,
+	0xf2d58dc9cf050810ULL, 0x65d12d161b5f5253ULL,
+	0x594aea61a08c5c22ULL, 0x983d72ccda19f876ULL,
+	0x0516ca5cd29e3e0cULL, 0x8ac34e639723bfb0ULL,
+	0xaca2d3b56c8efeeeULL, 0x419fc0ebc626d8cdULL,
+	0x76ff07dae0b9bf5fULL, 0x3a6e7401b9fad372ULL,
+	/* 4 */
+	0x6faf1a2cbb0a893eULL, 0x65a9221ccfbe4d1bULL,
+	0xc9436a6ecd71b7abULL, 0x76997c4f2645d77bULL,
+	0xd139f507ec4cd876ULL, 0x2cc111cd05f11d10ULL,
+	0x11d63da38c099f48ULL, 0xc839b2d15730d226ULL,
+	0x1037a130e1c292a5ULL, 0xf13a818f77273109ULL,
+	0xda0dff1bc48b2686ULL, 0x3a5f27850b004592ULL,
+	/* 5 */
+	0x124d5a90da97219bULL, 0xa3547d24f05c98b5ULL,
+	0xa9a58b7a35211713ULL, 0x03c56ce55373cb8cULL,
+	0x2440d5f00b5e064fULL, 0x4f5e391e36fb8fd8ULL,
+	0xcfba81bd079be62cULL, 0xa15717434be4e2b1ULL,
+	0x3ff73411d667719dULL, 0x45a1d9584e16060aULL,
+	0x01f64e47202df2d0ULL, 0x34cc4ef3f04937b8ULL,
+	/* 6 */
+	0x35f7d267d0e989d6ULL, 0x5acaace59ea61843ULL,
+	0x583aa0a4e5fd9fdcULL, 0x7b6353ee485cc3d1ULL,
+	0x68df64072fe7afefULL, 0x13a872773446c93dULL,
+	0x4bd447b607498254ULL, 0xeecd487f110d0371ULL,
+	0x523f4d6de7c744d9ULL, 0xe59d1bb143451e68ULL,
+	0x40eb332018163dd3ULL, 0xc437d820bbfe058cULL,
+	/* 7 */
+	0xafe293748efb4e79ULL, 0x77632f448a1b5f54ULL,
+	0x0a37f3aaa1ddeff0ULL, 0x548eec196cf083ddULL,
+	0x0308114df07533a9ULL, 0x537dde64228c75d2ULL,
+	0x3485528b96448027ULL, 0x982b8fb976bd41c6ULL,
+	0x3ebf2345cb6b2c1aULL, 0xea98a6b4d1331b85ULL,
+	0x05d589f78d1b16c3ULL, 0x17d59c16bf47a551ULL,
+	/* 8 */
+	0x30f28c58b94a0f6dULL, 0x200f2c69de2b0781ULL,
+	0x85d944a51a59cee5ULL, 0x19d55ab14193edc8ULL,
+	0x360df99eac7902beULL, 0x34bcf4a54976514eULL,
+	0x23ed1ee12816db1cULL, 0xeac6f5aaabe870ebULL,
+	0x58e25e3cb212bc08ULL, 0x08ef486d4e464573ULL,
+	0x59ed7d6d0f1928fdULL, 0xdfb3611a728ad907ULL,
+	/* 9 */
+	0x05f2123dfa83da3dULL, 0xa7f383ce9fc7c312ULL,
+	0x34cd75991388a5d9ULL, 0x0ee9a4f7d090129bULL,
+	0x14dea830d7570322ULL, 0xb718fd9a68a80200ULL,
+	0x583a40f3f64d7b2eULL, 0x219247bdc4d99dbdULL,
+	0xfb72d5e376c75cc0ULL, 0xfd52eb917bd97a48ULL,
+	0xd9ec0e03c6d37e43ULL, 0xbaa0963e53b75a7fULL,
+	/* 10 */
+	0xdb95ef7f1d4f45b0ULL, 0xef0036edaf8e9b47ULL,
+	0xef425529fa1dfea1ULL, 0xd91b998c4ad76d15ULL,
+	0x84489399498e017eULL, 0x263ed88d768fbe6eULL,
+	0x42be33b2ec4fd607ULL, 0x0110fa169782ea70ULL,
+	0x045eb11d8cb1088aULL, 0x99fbe5aa5a486090ULL,
+	0x79b4222bf5f4d9c4ULL, 0xe494c1d729291909ULL,
+	/* 11 */
+	0x8f36c4d9aee0b897ULL, 0xc4d7f204a4f5f1b5ULL,
+	0x6257751f37c7cbddULL, 0x54738665ca362eb8ULL,
+	0xec61839bc3328897ULL, 0xe493cec29707189dULL,
+	0x3d66e2660d93720fULL, 0x6788734c7f80adeaULL,
+	0xbd1ac374521ba87eULL, 0x27e9600fc42e64adULL,
+	0xaee47427bb8eec21ULL, 0x0d1291b71474f7a1ULL,
+	/* 12 */
+	0x85b94e0c9280bb99ULL, 0x130fee2433e24c6fULL,
+	0x21c103cb6d32eaf4ULL, 0x6a11db5d032afc69ULL,
+	0x639f3fbee72867c7ULL, 0x2c2eff5eda4ac69fULL,
+	0xcae9603bff14a1e0ULL, 0x25699f28c609bdb1ULL,
+	0x72b16d1a15acf9e0ULL, 0xb912bd170ee704bfULL,
+	0xc31c235fd065e68fULL, 0x7ae0e51b4b9df3c6ULL,
+	/* 13 */
+	0x18459439da174a6fULL, 0x929827371cbf831fULL,
+	0xb6307bcb06ab38c0ULL, 0xafdb5a4f76542a60ULL,
+	0xcc7957b1123aa804ULL, 0x13b0705a2d121fefULL,
+	0x3d56658d7c1a5a30ULL, 0xe6071981b932b6deULL,
+	0x0adeb8e0ea974f50ULL, 0x550b50ea0b12295aULL,
+	0x75d18b7be2734622ULL, 0xd3e00a6d638a61b4ULL,
+	/* 14 */
+	0x85c902de3b94203fULL, 0x1b255766855d0a49ULL,
+	0x8184e6cac9f00a5dULL, 0x828410bb5967d88dULL,
+	0xc5c17145734b9cf4ULL, 0x5b1609e7788fbbd9ULL,
+	0xaa3dad90549af2f2ULL, 0xe3618288c5284c88ULL,
+	0xf3fe01d860ae4adaULL, 0x23a15afd6b28c240ULL,
+	0xcf86425e621cfec3ULL, 0x8b8ad852611a9c4cULL,
+	/* 15 */
+	0x3b0a1ad8a44c07e4ULL, 0xdee005b47a0b8983ULL,
+	0x9b8b970ff65c98c0ULL, 0x534ab2e1cfbbaf33ULL,
+	0x7c916bb002adfb5bULL, 0x9b6e57a528422c0bULL,
+	0xb52556d2e293e9c6ULL, 0xd6e48a3220a0b664ULL,
+	0x294bfaecf8467e3cULL, 0x244aa3ea7d18e87bULL,
+	0x5224df654b3cdd87ULL, 0x1ee34b5959f3943fULL,
+	/* 16 */
+	0x3f8229a8d81e43b0ULL, 0xf9c58abd558bd431ULL,
+	0x318c2bdfa1ea026aULL, 0x058ea1e6425e7020ULL,
+	0xc6e7b862d4ca4ce0ULL, 0x95b1fa9e16e36b9dULL,
+	0x4b5115e0e2cbfa44ULL, 0x11d4efaa5914f4c2ULL,
+	0x2be2acf494c0cfdeULL, 0xf803233697015da2ULL,
+	0x3d0bcb890abccb66ULL, 0x2a25788975d1fd36ULL,
+	/* 17 */
+	0xda623101932f7749ULL, 0x932c75cc4db1f426ULL,
+	0xfc96aac2dbb26f4dULL, 0x914fd28238b1ab1eULL,
+	0x511db31bd86ecb51ULL, 0x2dc4e992f87fe8daULL,
+	0xa7a1dc82be1c393eULL, 0xbc6ec0179fe3accaULL,
+	0x3992c03cad486bc6ULL, 0xa095d520807eaa51ULL,
+	0x5881958a1fcf971fULL, 0x9ef570528676ec9aULL,
+	/* 18 */
+	0x2166840feb3f04ccULL, 0x3259983c81f233cbULL,
+	0xc592913e3f1dc25cULL, 0xf5c08809aa9fdb65ULL,
+	0x960740a647993d70ULL, 0x328bba4a9cc425faULL,
+	0xa8efa77d7827cdedULL, 0xf9980898fc86a950ULL,
+	0xe9ee227a0831dc96ULL, 0x51ac0f1297251399ULL,
+	0x55535138dacae0feULL, 0x61836414b33f29f6ULL,
+	/* 19 */
+	0xf11ba408d57b80eaULL, 0x416dbc5332e91f14ULL,
+	0x82f469654e434772ULL, 0x9006d8ff48d7d855ULL,
+	0xe488c32ea1cd61f0ULL, 0xbe6f2d813ea94e73ULL,
+	0xfdaccbf908921f5aULL, 0x97d85286e2c23f4eULL,
+	0x0a3350fa037b0a06ULL, 0x38c5991dfc4ff02eULL,
+	0x3acfa8a93b003e24ULL, 0x544b2bf39dc351a1ULL,
+	/* 20 */
+	0x513150360267f79fULL, 0x7af985238eb41447ULL,
+	0x7267b8005a6f3601ULL, 0x05b5ca634c83cd94ULL,
+	0x5d593b8d8a4f93e5ULL, 0xfec9297cce8e1c6bULL,
+	0xc5676ab12dd96057ULL, 0xf18956856664d4e3ULL,
+	0x99b962b1e10bc7dfULL, 0x5e984f45f97aee2bULL,
+	0x04cea9a2a24cb7faULL, 0xdaecc94d1e8d275cULL,
+	/* 21 */
+	0xe7228ee590925aa1ULL, 0x9e3afa7f9bc1daf8ULL,
+	0xc24d77129a75df08ULL, 0x2d0fee0051a6717fULL,
+	0xca3f5b2749711296ULL, 0xf536619e71acfd07ULL,
+	0x26a26b4811260fccULL, 0x6e22754af3332921ULL,
+	0x25e8f061228f0183ULL, 0xc290a092d350ef70ULL,
+	0xab46f70947a600c2ULL, 0xb57b1d1d386e8e16ULL,
+	/* 22 */
+	0xd69edf124500d002ULL, 0xddcf63617eb50d89ULL,
+	0x3f66340b7cc9e1a0ULL, 0x740ced7de13a41c1ULL,
+	0x64953e3d21571f99ULL, 0x9257d772ebf7ce58ULL,
+	0x8a7c04a5e5cbdbacULL, 0xb0e2e4696266248bULL,
+	0xe3327d24072f38bcULL, 0x3d98c2492789ab29ULL,
+	0x7dfd208a7dec329fULL, 0x9d9128ac2f4c1876ULL,
+	/* 23 */
+	0xf60ff4e2c3c4a500ULL, 0xac7b697e49aff290ULL,
+	0xa9a0de8a4c8315e5ULL, 0x84e42218f813bc94ULL,
+	0x4c617ab8cf91992aULL, 0x0af698435af5d521ULL,
+	0xea25f2325c265fb8ULL, 0xc552f4edde0ea5b8ULL,
+	0xec101cbd445b9273ULL, 0x221947e8eae31814ULL,
+	0x5ddaeec316d6e78eULL, 0x970c1c19d1b1c8b8ULL,
+	/* 24 */
+	0x81a6ca4268187a7eULL, 0xecec379a8e8e17efULL,
+	0x9db6f94f0f450c31ULL, 0x3a499f06a7f6a2c6ULL,
+	0x880a5267cd6457cdULL, 0x3c4714af4514c8e1ULL,
+	0x0fdb4e815fe31331ULL, 0xc7927e7143e7b101ULL,
+	0x11afd06ec3368c5cULL, 0x27e41fecb6993bb0ULL,
+	0x0b6b903f1b8ab2c1ULL, 0x6f2a280b6f14840eULL,
+	/* 25 */
+	0xfd9adce99e2a4576ULL, 0xf9e4297a461cb06fULL,
+	0xaa24f777479c39d7ULL, 0x277d5f4c9bed5bb4ULL,
+	0x80540b2cacdd59e6ULL, 0x6847143c47147271ULL,
+	0xa6d38d942274fa0fULL, 0x317661cc120daf84ULL,
+	0x2af2d51632c74be3ULL, 0xc326404865a4516eULL,
+	0xdb23d8e1c8e13113ULL, 0xaf7cb4ce9e9239ccULL,
+	/* 26 */
+	0xdfb885a3409d47e3ULL, 0xf01db1ccc6776e47ULL,
+	0x38504352bfd61f6aULL, 0x0983cca2ccc1e6fdULL,
+	0xee08b6a458be9d5dULL, 0x8ef482feb4caae78ULL,
+	0x6c4c99445730e544ULL, 0x7bdafe24a1015247ULL,
+	0xb3eefc3b1a7f672aULL, 0x99bbc607cfe001c7ULL,
+	0x195c948d69b00e8aULL, 0x303bb3eeb70e3008ULL,
+	/* 27 */
+	0xabc05268a4cf840fULL, 0xe98417e0fcbf77cdULL,
+	0xaf06237fb5dff982ULL, 0xfd47812428a7610aULL,
+	0x949a13fd799e9cecULL, 0x15dd0651923bbd43ULL,
+	0x581fa7cf5a57a002ULL, 0x9d9e3bf26bc7690fULL,
+	0x8027f9cd0c5ad81bULL, 0xbec12237a434e9a4ULL,
+	0xbe3bed0e043600d9ULL, 0xee9b04d523cdc630ULL,
+	/* 28 */
+	0x90678d4b02e57437ULL, 0x54800343b45696deULL,
+	0xb4fdde88ddd67318ULL, 0x745d19aa99c9e071ULL,
+	0xd721fab491589012ULL, 0xe1784e024c75dd41ULL,
+	0x52d0eeecd2f64765ULL, 0x94c532a4f94d90d4ULL,
+	0x660bc9227fbbe1d7ULL, 0x54d6b14c7f24a44aULL,
+	0xfa20b0f115050d18ULL, 0x7331927cdb99c2c8ULL,
+	/* 29 */
+	0x3ef15d3a7b8d7464ULL, 0xa43b05b79498d6bcULL,
+	0xef73019cecdb92baULL, 0x4bfbbfda4d6ff6adULL,
+	0x3148768ef40c9550ULL, 0xc1da916cfc983d63ULL,
+	0xcae4ef49968acd4eULL, 0xe8efa2b498d1a15fULL,
+	0xfe81b2bf038287c1ULL, 0xa21a1beb38ce0e75ULL,
+	0x86d557035df2ddedULL, 0x168417b3b5903aa8ULL,
+	/* 30 */
+	0xb2898c984dd93884ULL, 0xf7c2c5192d26a962ULL,
+	0x39dee99a81a665efULL, 0x6298fe19066f196aULL,
+	0xbc5b91f0c85e2a09ULL, 0x659f8b0bdb7de3f8ULL,
+	0x5352c80e92a0ad2bULL, 0x0a3b2b520e307570ULL,
+	0x9a7b32e7d193f017ULL, 0xaa254277b6c83c0bULL,
+	0x413fcae38c8429d3ULL, 0x2131a1627e259fa1ULL,
+	/* 31 */
+	0xd2a1100768994322ULL, 0x40c7288fe6f94b81ULL,
+	0x94aa6ce303d52032ULL, 0xbdfc08626aa0e869ULL,
+	0xe3751e4575d41c5eULL, 0xfc4b7596278820a8ULL,
+	0x9cc954e6b723bf97ULL, 0xd800efbf2e69e649ULL,
+	0x26062356cc13addbULL, 0x1a4530f2f3de9570ULL,
+	0x6a1d2e3a3a349f89ULL, 0x862ad58323fc2ffbULL,
+	/* 32 */
+	0xe85cb823d32e00edULL, 0xf951416072f7a287ULL,
+	0x3e137208b72cdc57ULL, 0x4d0f9dc73ec07705ULL,
+	0x05958cda7e7dd181ULL, 0x53cd1822b7b74791ULL,
+	0xf398e3a276d07c10ULL, 0x901016b71b6ec659ULL,
+	0x484e919cc33d3cf2ULL, 0x7c49456a7a2f5560ULL,
+	0x13dd3040b2692a27ULL, 0x84d4bafeb1d41b67ULL,
+	/* 33 */
+	0xe903818085d136f6ULL, 0x77d4c992b023a9f9ULL,
+	0xc9bfb749a85ef1e2ULL, 0x7ed247e95c521563ULL,
+	0x47740ee875951963ULL, 0x2300462a93f2dee8ULL,
+	0x572ac97f59100268ULL, 0x909c6a7cab27203fULL,
+	0xd0239b563da1e985ULL, 0x07d51fb20dac7166ULL,
+	0x0f3976a256286685ULL, 0x452e8581c09a07d7ULL,
+	/* 34 */
+	0x1affafc013c7f355ULL, 0xa93a912244ac019eULL,
+	0x6db7a254a8f9d357ULL, 0xc0008098907a8380ULL,
+	0xfa3ccb6bda4f6a18ULL, 0x5f9f59cf5ae83c90ULL,
+	0x61199dacca98e266ULL, 0xa7e20b444844c81dULL,
+	0xc24561c540238d0eULL, 0x4449ae92e96b16f5ULL,
+	0xa5b114acbe69520aULL, 0x28569e6b88653640ULL,
+	/* 35 */
+	0xa8b51d13a6032abaULL, 0xb090d8df17ebe077ULL,
+	0xe385359861ee94a0ULL, 0x4908b1296a3d5919ULL,
+	0x52ab6950680d7944ULL, 0x1d402784889c4c5bULL,
+	0x78bb01cb74d080eaULL, 0xc7279325bc6faff6ULL,
+	0x867f849c0392658cULL, 0x4a474300150fee95ULL,
+	0x5e6b1c1528c1489aULL, 0x3db9f8b5037d836dULL,
+	/* 36 */
+	0x9d587c4423de2324ULL, 0x5c5850398fb3d29fULL,
+	0xa80735ebf62789eeULL, 0x6fd675d061ac0b14ULL,
+	0x57352bd91573acf8ULL, 0xa7761c8bcf8c2f44ULL,
+	0xa2447284adecdb27ULL, 0x846ff3dd8ad647a0ULL,
+	0xde2ad16b4d156a03ULL, 0x9bd90d9da8d198d1ULL,
+	0x39a04021ac89ac99ULL, 0xe039ac5b8fea16dbULL,
+	/* 37 */
+	0xd8cce60f7bdea474ULL, 0x3871f7d6f866a9d2ULL,
+	0x6001cbd426be6b02ULL, 0x38efdf334230e095ULL,
+	0xa42ef015875546eaULL, 0x28ff4c77d61a3b4cULL,
+	0x8b951bcf66b34ebdULL, 0x6a249e8c11c8a422ULL,
+	0xc4da3716161ddfd5ULL, 0x4efd1b4e3351840aULL,
+	0x96b6c381cd08a57eULL, 0xeccf6adf50994f94ULL,
+	/* 38 */
+	0x43e36caa104ba625ULL, 0xf918f9c9904278d4ULL,
+	0x810d7545a95451fdULL, 0xf0469a8d9f738affULL,
+	0xdf48ae51b9dc0328ULL, 0x5e5abea46d51d3b2ULL,
+	0xebb824712d80d1f4ULL, 0x772621b9f31b0519ULL,
+	0xa7c0f8f43b06e0aaULL, 0x55b5752867dd221eULL,
+	0x89857459cde7513fULL, 0x01440680d01840c9ULL,
+	/* 39 */
+	0x4ec2fc37743285baULL, 0x836a1debe1a829f1ULL,
+	0x6b2faf62fcbb1017ULL, 0x0dca4f71095787e4ULL,
+	0x9cf9d392e99222e1ULL, 0x786f9dce6776df85ULL,
+	0xc557b8df4c6e8c78ULL, 0x01e704579dab4e37ULL,
+	0xc46d0e93404eafffULL, 0x587e6ad5ecc5df76ULL,
+	0x59e8ec264525cc85ULL, 0x798cd0e7cd05389cULL,
+	/* 40 */
+	0x29d644eb6be132baULL, 0x34606870eff4d867ULL,
+	0x5f8f2bc23714df31ULL, 0xd656f75c4323a829ULL,
+	0xe0eed9479d7e9ac1ULL, 0x98d52d9eb331c2e7ULL,
+	0x6ac0765144f33a4dULL, 0xa9cbe19f65dc1020ULL,
+	0xd46a4c90a4ebcdc9ULL, 0xcef8f498cd09e09fULL,
+	0xc09c07b45f8030a4ULL, 0x198747dc6cdfe3e1ULL,
+	/* 41 */
+	0xc4af5962e48e8f94ULL, 0x6bd932558e09d91eULL,
+	0x93b9382eb78502dfULL, 0x6fe00ae2f2829539ULL,
+	0x12f522cd1a228a36ULL, 0xa96c87711d6a2f76ULL,
+	0x0b3fef67746a1d6bULL, 0xf076c73c4293f8c3ULL,
+	0xee93899f37f411d9ULL, 0xab49b06d1768ec76ULL,
+	0x8ac9ac8a9a841c34ULL, 0xd84eb48559aae865ULL,
+	/* 42 */
+	0x87c0a14cc0b6c723ULL, 0x6b09e76d711b35a6ULL,
+	0xba160c33e888c043ULL, 0x0b9a6145637db537ULL,
+	0xdba3902a5642aa52ULL, 0xd7371e889332831dULL,
+	0x2706e5b778ce7060ULL, 0xeda744b7d5809263ULL,
+	0xcd9aad7c6b60d5b1ULL, 0x3788e6f52c0836fbULL,
+	0x6b1df61756386cb3ULL, 0xdf889dc79af6c910ULL,
+	/* 43 */
+	0xaf7ed35f3a391cc6ULL, 0x65e00708a6c82a48ULL,
+	0xc187da4af966fbafULL, 0xad3cf85934be5f3fULL,
+	0x717d0a1bc991b23eULL, 0x8779f839e13a225bULL,
+	0x49a50e4adee0edbdULL, 0x74d16452200ea05bULL,
+	0x25b59cb8656a1647ULL, 0x2be302ee701a89e9ULL,
+	0xe6b4947f21b897f5ULL, 0x56e2c715e8e5b323ULL,
+	/* 44 */
+	0x5a04076148b7cc2bULL, 0x4756d935e415f5aeULL,
+	0x1c17d10bb2cec76eULL, 0x8a6b1a6ea4ba445aULL,
+	0xc6c304deb5c110fdULL, 0x373e826fcb10ee68ULL,
+	0xc787307464f8f984ULL, 0x3337cb587be04a84ULL,
+	0x619a85ad9598596cULL, 0xcf2e68046a1a70e7ULL,
+	0x02b0a028a3393a5eULL, 0x9d6eb436808d84b1ULL,
+	/* 45 */
+	0x3809595410845efaULL, 0xdd9074af0f7580a9ULL,
+	0x582453d78e93657fULL, 0xb47c3ec91508f6feULL,
+	0xfd8980af3e78c695ULL, 0xe9ece71e146c0104ULL,
+	0x59f7756261ebc8b8ULL, 0xbc501b8d79292306ULL,
+	0x695e7acc9a039a94ULL, 0x01ad80d715d6508cULL,
+	0xf56d7f35a9eeb282ULL, 0x1cef537d6c9f6691ULL,
+	/* 46 */
+	0xc1fcdafe67f157bdULL, 0xa5c774b44aee703bULL,
+	0x992c265bf4469c10ULL, 0x20346ad4e2127791ULL,
+	0x1c641ef47244c1e5ULL, 0xee70f244f49fb697ULL,
+	0xc41be66b29415b43ULL, 0x3f8f515dc8d239faULL,
+	0x477ea76f9841f7afULL, 0x7c681ef72f74f2feULL,
+	0x47f4304caf195574ULL, 0xe530371901f32c61ULL,
+	/* 47 */
+	0xe35e6857863fd3a0ULL, 0x2c519b933b9aae52ULL,
+	0x11e93555ae066224ULL, 0x7fde547baa4e640dULL,
+	0x8d984be61c4fee1eULL, 0x23b6323a710a483cULL,
+	0xfa95b63b6cd3220eULL, 0x123ab08f69c60b31ULL,
+	0xadf4b18ce2d25953ULL, 0xbcd0dc7f1f74be3bULL,
+	0x9010263809ca7a44ULL, 0xa56a142fe5036d59ULL,
+	/* 48 */
+	0xc35e68549dcf801bULL, 0x7697e7578bc2ed16ULL,
+	0x8c87bdbe55811d10ULL, 0x0abd09f819f6ee8aULL,
+	0x4547e146ee4c2d5fULL, 0x8e96abb998be88faULL,
+	0xdeaebb75b8bb6bf9ULL, 0xee4ac087f6b7e816ULL,
+	0x451866a54a9a3133ULL, 0x66b72af9a5b40029ULL,
+	0xe15f1bb783368e10ULL, 0x57746138f634a97dULL,
+	/* 49 */
+	0x0b907d6a796aca25ULL, 0xa83398c7fa62d1a7ULL,
+	0xa9dfc7e6cb8c5dd1ULL, 0xfcc0bd25e0513567ULL,
+	0x0f1adb5b2e1b677eULL, 0x8fd19cd12fbbd3a7ULL,
+	0x3f8273c52d6eba15ULL, 0x62425ed63346a2d3ULL,
+	0x8ed840cd04d3bc4cULL, 0x6195a4e3bdd4a04eULL,
+	0xde03fc3474630e51ULL, 0x4615202c82855a73ULL,
+	/* 50 */
+	0x5d433aeb5d7ecd57ULL, 0xee911d5ad22d4edbULL,
+	0x3a4baf03d3bdf881ULL, 0xe3fc156369087821ULL,
+	0xf49048d95f9ad00bULL, 0xe5552fb082c0a10bULL,
+	0xa2936795b2f0ecfdULL, 0x894f98d88cff1058ULL,
+	0xe12ce510cde74892ULL, 0xbadac0ccd4f992bbULL,
+	0x115bb0168a586a8dULL, 0x29509c35c52c7409ULL,
+	/* 51 */
+	0x4dc7516783eb4920ULL, 0xd57163609ab28b3aULL,
+	0x02a112520cf1d736ULL, 0x4fcbdf879f87038cULL,
+	0x582cf9a700259843ULL, 0x9d9c96aa563dc240ULL,
+	0xb4baade19d4911a2ULL, 0x82e162e5d3159d1eULL,
+	0xa360eaec4fe5b0b7ULL, 0xdf806b79a2046133ULL,
+	0xb9e2a7c4d185b7cbULL, 0x18a0c005b0e9edc3ULL,
+	/* 52 */
+	0x4edea9326aa3af36ULL, 0x42dd99c68992d8c3ULL,
+	0x38104e915b8fe919ULL, 0x4bbeb105f507b16fULL,
+	0x2bac201de660efb0ULL, 0x23d57b93298dbd77ULL,
+	0xe93a586c07a0cf90ULL, 0xe5ede80d95aeec6aULL,
+	0x97f6904f1d34901fULL, 0x1c86877a2e294ba5ULL,
+	0xc88e8565ecdfc320ULL, 0xa9f993c849053e81ULL,
+	/* 53 */
+	0xcc82b3c647dd3128ULL, 0xf45b192a0c6ccdc4ULL,
+	0x6cde77bc9e276793ULL, 0x21d54353cca0d234ULL,
+	0x2e6dabd6808161faULL, 0x0dfcffea30487ac4ULL,
+	0x89cbc92bc6cc5809ULL, 0x1c979be04f69c82eULL,
+	0x819d9e2eff2312e3ULL, 0x7e1f6256fa2fbac9ULL,
+	0xe23b97b0ebfa6d1eULL, 0x5e9ad3f5c0bc403aULL,
+	/* 54 */
+	0x5b3c6ca3b22a8db9ULL, 0xb7221e64d4d67b73ULL,
+	0xd019f186074b33f5ULL, 0x8291a2e4a2929ff4ULL,
+	0x31ac36dd50b88c22ULL, 0xcdeed0dee7105b11ULL,
+	0xdf6274a0623e5666ULL, 0x35d50aff38926ec1ULL,
+	0x30ac9fa5461b68bdULL, 0x274f4438878a41ddULL,
+	0x7cfb4017b3b1f191ULL, 0xb485d510e0dd76a0ULL,
+	/* 55 */
+	0x6aff22a4dd8fbfb5ULL, 0xbd7e6b68d9fbdbbcULL,
+	0xc85e678490085e2cULL, 0x058a99275477f52fULL,
+	0x959892fdc3d10135ULL, 0xe47ac9e840d14f20ULL,
+	0x2876afb78483540bULL, 0x8a30b84bfd5895b1ULL,
+	0x73d5578a13db4c4fULL, 0x076303b3c1e3b3acULL,
+	0x2cd2722e4540ddd8ULL, 0xa891d3f8b2175aa6ULL,
+	/* 56 */
+	0x97c9286d8c6043a6ULL, 0x21000e1eca4cfa49ULL,
+	0x5e86f02bc1b43faaULL, 0x55596b5671e72af7ULL,
+	0x38a7cbb1c43951c5ULL, 0xf2cd9d067fce666eULL,
+	0x881c89dd21b20b03ULL, 0xced1ac54c34b6932ULL,
+	0xe25087c36b93f32dULL, 0x6593b9e32a17e357ULL,
+	0x07db4af8475b51deULL, 0x5d6990e574b99b1dULL,
+	/* 57 */
+	0x6a74cbea37e19c09ULL, 0xf2c62d14ea83abfdULL,
+	0x9086d22a133a0b92ULL, 0xaea0495dec22eaacULL,
+	0x7f0970e8f49dd420ULL, 0x8bdf8d4b4892651dULL,
+	0x72d511e98bde880dULL, 0xae6601feec90ac0dULL,
+	0x5285e4446597f082ULL, 0x25db59d8098c17cdULL,
+	0x4653ca2949584b25ULL, 0xd3455c0f723ad4a1ULL,
+	/* 58 */
+	0x15483a18a340d786ULL, 0x07265cdd47e5bdd1ULL,
+	0x21d71119c53980eeULL, 0x83cf9d7fc8ffa402ULL,
+	0x8f175f98a484090aULL, 0x304ba3ea46231fedULL,
+	0xa166a8614e783a8fULL, 0x9146325d1bf138a8ULL,
+	0xe03d682f16acd092ULL, 0xe980577e05b375cdULL,
+	0xdc5c3b293787db91ULL, 0x8ecbf747de988f38ULL,
+	/* 59 */
+	0x221dd7e4a25d59b1ULL, 0x1509205f49a214fcULL,
+	0xeaa6c2dbd0c4171eULL, 0x4ac1615f9a58db52ULL,
+	0x931149b9c9b47ca0ULL, 0x619018b3e46cdd50ULL,
+	0x91e5d3babce9228dULL, 0xd57c7dfcec6710e1ULL,
+	0xac50e9d0e81d54feULL, 0xc519e183f58f4ffaULL,
+	0x0c1358026f83c798ULL, 0x2f2e7532b07ed11aULL,
+	/* 60 */
+	0xcae1e8dc2d73bf07ULL, 0x53e660e50f8a1754ULL,
+	0x5825a7d55a8076c9ULL, 0x3ac4038d8b2189d7ULL,
+	0x5817f2beade3b508ULL, 0x62b22b70a42b55c1ULL,
+	0xb07a03b55344ecb5ULL, 0x343ca2e52b5b507aULL,
+	0x9100aa20dd826d56ULL, 0xd776b96f20a3ee88ULL,
+	0xaa24d4e425834abaULL, 0xe3b216a87b170aebULL,
+	/* 61 */
+	0x7468e93f1143ccf1ULL, 0xe4e4539c1362cfd7ULL,
+	0x047a33df88220d9bULL, 0x18af8971a7259accULL,
+	0xf52dab1f20230705ULL, 0x9e368dcbd75c725fULL,
+	0xb9e70fb19e1c11f3ULL, 0x06512f057db082d6ULL,
+	0xc60ff3551b45e531ULL, 0xd56dbc7635dca102ULL,
+	0xc8c28ab9e7c364f5ULL, 0x5014eb0f5325cadbULL,
+	/* 62 */
+	0x86f286b494a129cdULL, 0x35e9b2c5104dbb0eULL,
+	0x65684d157bd912e6ULL, 0xd85465659d6b0a05ULL,
+	0x9925acc5cccd21c5ULL, 0x386fa409c94cf60fULL,
+	0x871c7bf2a31597dfULL, 0xb1eca73d6cfec8d6ULL,
+	0x1078d49943296668ULL, 0x17c0324626588849ULL,
+	0x44ec9b8f4a4305e7ULL, 0x6d32212be7415f5eULL,
+	/* 63 */
+	0x8b99044dc56dda9fULL, 0xc4a3cef5109fbbacULL,
+	0x45e90750b53919b7ULL, 0x892996078a521032ULL,
+	0x859b52f766aef92eULL, 0x3a7c5281c0065b52ULL,
+	0xfbabf1feae600b15ULL, 0x348595051e80ccc8ULL,
+	0x408a4a7a8f4df023ULL, 0x62e101038f7c7bf2ULL,
+	0xccb6fd3ea57e02b4ULL, 0xe4bac4f906b6c383ULL,
+	/* 64 */
+	0x59781202b2d6eaecULL, 0x942a62f965b982d0ULL,
+	0x28dea2ec944ba990ULL, 0x4d8797ac9bdf8753ULL,
+	0xc4f92c529b25e841ULL, 0x05e65813d3b8fe86ULL,
+	0x06a8e98520352cdfULL, 0x55cce42faa20b585ULL,
+	0x841ac509d7718a40ULL, 0x76f4bea22af1a317ULL,
+	0x68056584d5274213ULL, 0xd0345c845e458629ULL,
+	/* 65 */
+	0x26b0b097e4532737ULL, 0x4d3428a9f40184cdULL,
+	0x7a3cb28e88f68f98ULL, 0x924f71086bb6d959ULL,
+	0xd0151c20fd794916ULL, 0xbd30f479d95748fdULL,
+	0xb9b2be1ecea46653ULL, 0x5209f431fa5c2331ULL,
+	0x51efa0f77c5789e9ULL, 0xda56721dee9cdb3aULL,
+	0x3643bc27c49ef895ULL, 0xa3a74188d89ac7b0ULL,
+	/* 66 */
+	0x2affdfe28e3b1743ULL, 0x7626e16ef26e70baULL,
+	0xd61f2970dad640e8ULL, 0x1b9953758f681c39ULL,
+	0x79c56858677938bbULL, 0xfe5f04fdb685d087ULL,
+	0x6dbf0e83725f2755ULL, 0xa8bd80d1d9d3eb54ULL,
+	0x21842e74dde484b0ULL, 0xbbe0e18053c016fdULL,
+	0x5ec4ecbfe618412bULL, 0x5bdb1a5ba87a3220ULL,
+	/* 67 */
+	0xc54c90b99c20745eULL, 0xd3fc4b5717a79538ULL,
+	0x91ead551244f6b5bULL, 0x4510c13ce1e0303aULL,
+	0x9f7e25e504e6c8a9ULL, 0x91f4a1389b92110cULL,
+	0x637eadc6f39e86a5ULL, 0xa6f6d73d89dcb4a9ULL,
+	0x7d6f90136e70a3bdULL, 0x43662cad7e106f96ULL,
+	0x00f612b092458103ULL, 0xb9c51b52af4d73d0ULL,
+	/* 68 */
+	0x0271662c0cc085d4ULL, 0x2ff993fc25deec6eULL,
+	0x11b454efa8424518ULL, 0xa2f44890f8a84cf6ULL,
+	0x9dcdddcc7e141fc5ULL, 0x962aa5417e4675d8ULL,
+	0x65bbd3500111c5cbULL, 0x5a8890beb4f53049ULL,
+	0xb4f5f5722fa98633ULL, 0x353b06125567c6a8ULL,
+	0x6565da39bdf8b832ULL, 0x3a36a8b1f15d4549ULL,
+	/* 69 */
+	0x04a9cb6a4346e5b9ULL, 0x1b020ec9fd94a447ULL,
+	0x9f61745311725b26ULL, 0x172819eb94ccb8a5ULL,
+	0x4b8aa3f45275e66eULL, 0x8fea56d86c650ba7ULL,
+	0x38b39a92e292fe94ULL, 0xd92821f89bc0e393ULL,
+	0xe96a22a508f57d93ULL, 0x1f375dc6d2982ce5ULL,
+	0x39382eaa14adc3ffULL, 0xf1afc75863aa1d2eULL,
+	/* 70 */
+	0x8f276dd0dc4d9499ULL, 0x3a882bbde355beb6ULL,
+	0x672cf0b79beeffc8ULL, 0xc7f0bcc14266394fULL,
+	0x07b9c2c6ab7bfc39ULL, 0xd82300b129391fa3ULL,
+	0xc4c5d22bb4f6617aULL, 0xd3d8e1693a2fe13dULL,
+	0x9173d1819b40e1beULL, 0xd1f780e8452d3ce5ULL,
+	0x1161fe63a52f21a4ULL, 0x9275819f23541d37ULL,
+	/* 71 */
+	0x38a205efdcbd54a3ULL, 0x774c67f69ecef0b9ULL,
+	0xcb21b6d4c38e410eULL, 0x65e455bee1dc9c63ULL,
+	0x159d2839354785f8ULL, 0x060328abd2a012e6ULL,
+	0x8bdf51b25fbedd27ULL, 0x65d9604a358b33b2ULL,
+	0x7064933c314085cbULL, 0x92a41dda4e7dbd16ULL,
+	0x7b49bf6817f82e6aULL, 0x139e24f8eeecf175ULL,
+	/* 72 */
+	0xb759bb3b5a6d16e3ULL, 0xce7b3da553b32105ULL,
+	0xbbe9c22457d7db31ULL, 0xebf4bdd4940a005cULL,
+	0x520120d3d29cad52ULL, 0x074494fd15823c55ULL,
+	0x3567b4716c1cf436ULL, 0x323f158d390c8b39ULL,
+	0x3fbfcd7883158cb0ULL, 0x8bdd9020820756d7ULL,
+	0x7fa08909ceebae48ULL, 0x0c623c4716032076ULL,
+	/* 73 */
+	0x7c4d42176baf7e6aULL, 0x38b300626fa6d09dULL,
+	0x2ace1e17c1f48632ULL, 0xb171b2018b767118ULL,
+	0x43e784ee2065fccaULL, 0x7e604e19c8cbb1fcULL,
+	0xe38bc954f29d2a03ULL, 0xd3bddd72f1edd62bULL,
+	0x3038f87f5cedd147ULL, 0x1ce3b016d22f54a5ULL,
+	0x77701d30eaebcaf2ULL, 0xc34417fa4f2cfb8fULL,
+	/* 74 */
+	0x19ba40797872ef85ULL, 0x9dd74b503cc9bd43ULL,
+	0xc81b630c6c770f28ULL, 0x5cc83a894356402aULL,
+	0xe83328c392781496ULL, 0xb93c99d9f40c5e1aULL,
+	0xb6059d3e61e849b2ULL, 0x3008ef9eb4979d2aULL,
+	0x97c2d61b8f9056adULL, 0x194040baa23b23e7ULL,
+	0x5c5f13e4d8e8d760ULL, 0x1502f47d31be4cb5ULL,
+	/* 75 */
+	0xbf14e2f0a147843bULL, 0x558f10b97c580dc4ULL,
+	0xcd7a60397e9bc50cULL, 0xe3e9c07ac0c9eaa4ULL,
+	0xbfe8add4df5ac5c9ULL, 0x407e2166030a281bULL,
+	0x683411860666b913ULL, 0x8cd4b5682eb969e4ULL,
+	0x62379d5f65325aa7ULL, 0xb3ef750a3379312eULL,
+	0x4507f88532278e44ULL, 0x160b21fc881501f7ULL,
+	/* 76 */
+	0xfbc842f675c6536eULL, 0x5d0bec94d5d88272ULL,
+	0xae0bf1c2038b0b21ULL, 0x8d6cb9ffd35fe967ULL,
+	0x1394ac8d00861a5cULL, 0xba5d2de4658fd55bULL,
+	0x16807ba1bc5e2a5fULL, 0x5b4be9b6f2d6396fULL,
+	0x2078f1752268e476ULL, 0x5d31c6021b03725aULL,
+	0x22b6e7c32a77cb7cULL, 0xa426f10227f285f8ULL,
+	/* 77 */
+	0xe686e94a5e60ece0ULL, 0x2d90a586b0313d36ULL,
+	0xf522a4944050b092ULL, 0x45a6eced2b86e4f3ULL,
+	0x3c4ae1731108ba59ULL, 0x0dffef793d341b50ULL,
+	0x3bce8b2b814d88f3ULL, 0x7730ff60f0db35c7ULL,
+	0x676f508d9d463857ULL, 0xe93adb0a895c64d8ULL,
+	0x91b55effec36668cULL, 0xa36e47ea2f1555faULL,
+	/* 78 */
+	0x86c32ce95897ba0fULL, 0x3b5b46a1298e4a9bULL,
+	0xaccd32271125536fULL, 0x900e57af360bb49cULL,
+	0xd6758f5f91398fa0ULL, 0x039509e4f6b892b6ULL,
+	0x07d36974eb02969aULL, 0x65697126186eae7aULL,
+	0xf1e187cbe05583a6ULL, 0xc394626baee8596fULL,
+	0x55fff6724ee6f7c6ULL, 0x0da508f57d160a38ULL,
+	/* 79 */
+	0xaf24674c5f09b36bULL, 0xe500cb9f8e2f278aULL,
+	0x07f51c6eec358ea7ULL, 0x2b47c2e8f927b31eULL,
+	0xf18716056a7b47eaULL, 0x4099f3371fe1b43eULL,
+	0xb8bb554d8cfba0daULL, 0x629ee1e83d94a7a7ULL,
+	0x98900e5f9ced1b92ULL, 0x75234f78ad4e1870ULL,
+	0xe79d252964e2c6afULL, 0xc88be81eec1445d9ULL,
+	/* 80 */
+	0x2d769ab8dd6b6f03ULL, 0x7fcbfc81039e5ce7ULL,
+	0x9832c71dfec1b809ULL, 0x618cb9ffc5e390ffULL,
+	0x23c923b620148075ULL, 0x902c84a3df4ba293ULL,
+	0xb37b746b2cfa76faULL, 0x374fa35f774c0154ULL,
+	0x4290ab208eb385dfULL, 0x2f3e78876b9ffaa9ULL,
+	0xde0bdd511f374238ULL, 0x19bf63adaa1eeac9ULL,
+	/* 81 */
+	0xdf7c68b16916677bULL, 0x1c7ab6508f369a26ULL,
+	0x48f695dd7793a6a1ULL, 0x723e7a06d8f72a62ULL,
+	0xa51b341b17f662cdULL, 0xf15a58d6544bfb33ULL,
+	0x9fcaec6e1d55244cULL, 0x47d72be51607001aULL,
+	0x0fd4d764d5bf5e98ULL, 0x730b985de32adf46ULL,
+	0xb268ba7392cfb39cULL, 0x7659081a37c471a5ULL,
+	/* 82 */
+	0x027591a7cffb71c6ULL, 0x0cb9b197d0e36446ULL,
+	0x2552c6d6ba406552ULL, 0x7b996b1c26725da1ULL,
+	0x542afc7804b5a9e6ULL, 0x3a164de4111ca882ULL,
+	0x5ac993b6592d7245ULL, 0xe532b4a1ce69fe2fULL,
+	0x8841dfc4a2302907ULL, 0x91fa9b0c1df880f7ULL,
+	0x8fca39f8236fa5ebULL, 0xa3a19962fedb4927ULL,
+	/* 83 */
+	0x11a392996ff1e199ULL, 0x697b981ab32bb553ULL,
+	0x22670ee68059f2b8ULL, 0xf4aa910a1be6ba9eULL,
+	0xd8fde97e6be5c4fbULL, 0x0ac8f027dede53dbULL,
+	0x9380675e70aba930ULL, 0x4c541e50c95fca1bULL,
+	0xa6139621a3aee125ULL, 0xa1720cc5a157e960ULL,
+	0x46c145c301b05550ULL, 0x5abc66a8ddf68dcaULL,
+	/* 84 */
+	0x8035b1b3509c714cULL, 0xc528cab8a6f0901fULL,
+	0xb5d177c8b020171fULL, 0x0e6712c782b1a209ULL,
+	0x9ba73a36525e158bULL, 0xe8a76dd6fa746811ULL,
+	0xcb81a6749773c605ULL, 0x5dabfb13abb50953ULL,
+	0x6e4e9b549d811c4cULL, 0x026e33f50f3c1ac9ULL,
+	0xd27c401e909cb08dULL, 0xe82044cd65dfdb7cULL,
+	/* 85 */
+	0x66c7a26beb202b3aULL, 0x988bb7b66f83b2b8ULL,
+	0xd645f553f0c15fe8ULL, 0x5d824c0f7d6d0446ULL,
+	0x3926aaf5aed93b6cULL, 0x003297cd651628a8ULL,
+	0x850664a6c309840bULL, 0x515cc2ef7d4842d3ULL,
+	0xb9504f34ea3a422bULL, 0xf73893bb3b224ff9ULL,
+	0xa695ffb192cac1b4ULL, 0xe8f2281ca34af925ULL,
+	/* 86 */
+	0x2220699cfc514093ULL, 0x75d5d8ba1b3da7acULL,
+	0xa7d546c6b63f537dULL, 0x7c3618d1b595d495ULL,
+	0x2fad47924a2e3466ULL, 0x34811a91a9bd8463ULL,
+	0x07cf400093f0f7c4ULL, 0xbd8642d57fa2b723ULL,
+	0x2daf3233c4e905dbULL, 0x439a4b1809098014ULL,
+	0x1c1f3f6e78bdbb1cULL, 0x915ea1106d5b9f42ULL,
+	/* 87 */
+	0x2b00449df5610da5ULL, 0x90440fc0d72e513cULL,
+	0x8fffe8bdd15d5372ULL, 0x80df3bad69d46329ULL,
+	0x6a78a5e55e680834ULL, 0x1c0ed533cc721412ULL,
+	0x514389f0bb968befULL, 0x269ed573d5fb807fULL,
+	0xa66d6b0f12cc6295ULL, 0xce26c8d7c6741a94ULL,
+	0xa91a07e62f8c6907ULL, 0xeb9ba6f0cfa56838ULL,
+	/* 88 */
+	0x4a791520d83f43b1ULL, 0x9bc37b8768081da7ULL,
+	0xaa05bc5be4459b49ULL, 0x297c06382df4b834ULL,
+	0x725c0bf3c8a96445ULL, 0x46473d1825039aa3ULL,
+	0xf4d686170e9422d3ULL, 0x3b261ed73cd95346ULL,
+	0x9050d2ace073fa8fULL, 0xa88f49527bc39cd5ULL,
+	0xc59c29c58f2749c3ULL, 0xb3cd55574719791fULL,
+	/* 89 */
+	0x561b9c6760d3af28ULL, 0x356f4e8a029e4012ULL,
+	0xdbf20e49464a9cffULL, 0x120a573cc00dcceaULL,
+	0xffb20c72435a39aaULL, 0xe5ed5ec0894c7c7fULL,
+	0x82a85ff6444b88a8ULL, 0xf0b057df3cedb4e2ULL,
+	0xef0649940f507869ULL, 0xa015981c276eee0bULL,
+	0x272a77ba1eefbdddULL, 0xa18812be35cd73beULL,
+	/* 90 */
+	0x15eb045bd9d58925ULL, 0xc6a39b1ad8c2478dULL,
+	0x08e69e844851cc47ULL, 0xb396159c8dd03757ULL,
+	0x05780840ec474b34ULL, 0x75bcab89f690699fULL,
+	0xcd9c5d66d5d9d521ULL, 0x4ca75f198f13d189ULL,
+	0x81baa9798e56c2d7ULL, 0x3ba4f221960f8bfcULL,
+	0xc2b88beb897d46bdULL, 0x25c8e5c94c320919ULL,
+	/* 91 */
+	0x59c3008bd6b93ab8ULL, 0x3018a880ffeebd6cULL,
+	0xf428f383f2b4fa05ULL, 0x642b576796de27f2ULL,
+	0xaaa8e261f4c8dc2eULL, 0x09d09efea4cf6e0cULL,
+	0x15e8eb8a5d746060ULL, 0x313511c6bea4e4c9ULL,
+	0x786bd2763ef46f4aULL, 0x2c9a209699fd7671ULL,
+	0x3dbc5d964388d716ULL, 0xe8ed043521339593ULL,
+	/* 92 */
+	0xf11df89b7b414731ULL, 0xa20adb5e2725c2caULL,
+	0x9b5f80ac7e2e3881ULL, 0xbcf0969cfb26cd21ULL,
+	0xdd54b1fb22c40779ULL, 0xa965b7f4e5fd0529ULL,
+	0xa825b3c29f26314dULL, 0xb1803b647cf9ab2eULL,
+	0x8ab398419859d1e7ULL, 0x83abc3a83920c085ULL,
+	0x455c65864f9799a8ULL, 0x2482bfdbeed1298eULL,
+	/* 93 */
+	0x7170ce137e45aa33ULL, 0xe103acd5526e7292ULL,
+	0x5a76b17e95223b15ULL, 0xb59caac3f53d5732ULL,
+	0xeafa6f57c8242d16ULL, 0xb792d702861d9c02ULL,
+	0x07e4bc6d9ab78b21ULL, 0xcd37c20e34d65e1cULL,
+	0x286d3111306ec8c1ULL, 0x51f1a7b58725279fULL,
+	0x06c3ae172951f43cULL, 0x69fea40ada045154ULL,
+	/* 94 */
+	0xbb702049f020ea91ULL, 0xe28421e1cc253b1eULL,
+	0x39c8d90ccf5522c9ULL, 0xbc0a0b0a0563bdf0ULL,
+	0x0ec3130c4eb6e91bULL, 0x551206dfc574bab1ULL,
+	0xac62c131f5b823cfULL, 0xc3d77732b02be006ULL,
+	0x65d60f03dd4317a9ULL, 0x6dc96c15d0149ef0ULL,
+	0xc359171657854dd6ULL, 0x15db334e6ab3f57fULL,
+	/* 95 */
+	0xca1848e924094d18ULL, 0xb342e2f9f8ea6510ULL,
+	0x380af0b3cdab20f1ULL, 0xdabb3c0a28fd6a1fULL,
+	0x151b0501b5ca78ebULL, 0x32b3e9ddd62dfb63ULL,
+	0xb3b636039e4b4450ULL, 0x3bd1eba881893220ULL,
+	0x66eefbd25523e9c1ULL, 0x9b94d743e9ebe2fbULL,
+	0xdc96382acd93ba14ULL, 0x30f359cb473c6a03ULL,
+	/* 96 */
+	0x0879dcbdd6f6b551ULL, 0x596b4260be51a6b3ULL,
+	0x0ddc53f6655c25afULL, 0x7cdc7d2193c18e3eULL,
+	0xdd75a18753158888ULL, 0x9e858404d8e43fa2ULL,
+	0x723562af07abc291ULL, 0x7527dc1399e66475ULL,
+	0xa8d3f83a5d96e2d0ULL, 0x3f4940a9c92e673aULL,
+	0x1d4dcb7bee6d6954ULL, 0x7ed0d985be480e1fULL,
+	/* 97 */
+	0xeff5a86e7f015289ULL, 0xb4157c4cc47d5f31ULL,
+	0x315b6bac46075ccbULL, 0x596fb0ac7a9bb405ULL,
+	0xb96c89789cbd35f7ULL, 0xacfad69989fb621bULL,
+	0x1f5eb02b2be81facULL, 0x810e59e451c96a0cULL,
+	0xe5f37992f8d4f746ULL, 0xf301fe0e6df15b4eULL,
+	0x66c0d0a6c568e978ULL, 0xb704f1f23479cca7ULL,
+	/* 98 */
+	0xadb94cc46543e995ULL, 0x2144befb418e7aa5ULL,
+	0xfaa38618c1f5fa59ULL, 0xdf6b83d6ff2373feULL,
+	0xb98b95d64278c21dULL, 0xd73e042e6c365bfbULL,
+	0x4df37066c8cd5b8dULL, 0x777cfcba1c54b2afULL,
+	0xebf4bee4ed493392ULL, 0x7b86145271b8f61bULL,
+	0xdf0e9d758ec10bf0ULL, 0x28af46c57d76e7a3ULL,
+	/* 99 */
+	0x57c4d03a992008c7ULL, 0xa4b9f9969a4d914eULL,
+	0x4817856ba0de6c5fULL, 0x137c538effceec7fULL,
+	0x0289dbd595f29046ULL, 0x9d4ac0da054bd2faULL,
+	0xb59c9f2d7dc7cb28ULL, 0x01e0908474e1746dULL,
+	0x78b21ff1898c2321ULL, 0xbffb8287e538d8e1ULL,
+	0xbc174382981500cbULL, 0x4573b50be7ebd907ULL,
+	/* 100 */
+	0xf172635c021eba80ULL, 0x5e8c189947438a83ULL,
+	0xbf3ec473aaa69704ULL, 0x74a3a957638c4c8fULL,
+	0x824b1da13c831e5aULL, 0xaba49c2ef3a32effULL,
+	0xb35182bb3fa4c4c6ULL, 0xfdcb6e2f0db34004ULL,
+	0x5589c0007a26988cULL, 0x6bf31d694b934ce0ULL,
+	0x4270f6222e303135ULL, 0x99819297aa18b498ULL,
+	/* 101 */
+	0x4a9ac3d11900fc1dULL, 0x96c59cdc97e624deULL,
+	0x424b6449c3c375dbULL, 0x27e25c9ad12676b2ULL,
+	0x0cf82c48a83b4160ULL, 0x4329d527e1317f67ULL,
+	0x97abf7edf3c9a281ULL, 0x2552816f016fb9cdULL,
+	0x5bb861c8f59986d4ULL, 0xb6f320ebce35bc9aULL,
+	0x255cb1b19a8528bdULL, 0xb1476d6f97b7e0c0ULL,
+	/* 102 */
+	0x6bce61726723efd2ULL, 0xd204bfeca9adfe06ULL,
+	0x9eba6f1b340d2885ULL, 0xbec24b4b7c929126ULL,
+	0xd7498921f7966badULL, 0x1adef75a2300e45bULL,
+	0xdd431e80a9c6855aULL, 0xfcc6187db2ffa7d9ULL,
+	0x7e2ae39e5823f2d7ULL, 0x64b47bda7b8c1281ULL,
+	0x156fbf67fa984af3ULL, 0xf0ff639a81ef1c2cULL,
+	/* 103 */
+	0xc771cf32a40db88eULL, 0xd276a651a3cf2968ULL,
+	0x48affb1481ce2137ULL, 0x29fffbb9daa9da14ULL,
+	0x717abbd74638eac1ULL, 0xac9f4b7235f2e8e0ULL,
+	0x212b973252f62891ULL, 0x9a1ba0af80cb97dbULL,
+	0x34bb5697072a32f3ULL, 0x33b0736dfa37f15eULL,
+	0x1e375f81de32467fULL, 0xbbdd36a1a7e3e96eULL,
+	/* 104 */
+	0x8d57d0569c7e4989ULL, 0x79b6ab02d8d07944ULL,
+	0xe7cecacef1a6084cULL, 0xeeed1026626c20e2ULL,
+	0xa649e6e9f83954a8ULL, 0x8db69fea86bab2e2ULL,
+	0x1eac4065e76955eaULL, 0x9385835db7054295ULL,
+	0xd65532eb1ed80dd8ULL, 0x8cd3cfc52aaa1e69ULL,
+	0x44cbfcc0b1b5f3c2ULL, 0x8c96c830e84ab9d8ULL,
+	/* 105 */
+	0x74c3c838717a9c14ULL, 0x7900b2bbbe4bdfa0ULL,
+	0x72f2bf205389642dULL, 0xc0318022f0fd64c8ULL,
+	0xbbb46b0b08df89dfULL, 0x78bc38b21370773dULL,
+	0x11a0531dbdb66732ULL, 0xfc440f9d9d86679dULL,
+	0x359c3e03c0e8ac4bULL, 0x9d474422885077e2ULL,
+	0x40d9b77590067c71ULL, 0x204c5c75a4e45378ULL,
+	/* 106 */
+	0xf09d82189ae67a5eULL, 0x3e5df5c58fce0350ULL,
+	0x2c4ad5562b080c3cULL, 0xce2982d20405cec9ULL,
+	0xdbde49c00295f75cULL, 0xda3303964d12c4adULL,
+	0x3ee65226dd3934c1ULL, 0xa85f59b9213393eeULL,
+	0x6608edf95ef7a83aULL, 0x0e06563bd53423b1ULL,
+	0x7e18f2609940644cULL, 0xa2465255021eba8eULL,
+	/* 107 */
+	0xf7c91c1ad5858fdfULL, 0xf779c2157367d740ULL,
+	0x868865d0d0a9f439ULL, 0xf27a6bfd22344bd8ULL,
+	0x08f48f764429a20dULL, 0xdf1e5ae7d8c08df6ULL,
+	0xef3d4d9e44481f7bULL, 0x4772b444a0f6ebf3ULL,
+	0xa98e18c2282ea90eULL, 0x913fce6b1ceb45c7ULL,
+	0x0cb4d5eb429918b0ULL, 0xa84fb5e1af4af080ULL,
+	/* 108 */
+	0x61a61899c5d6703dULL, 0x6c79ce0dcc1f7bfcULL,
+	0x0440ff527e0c3f65ULL, 0x748a6a2e34215513ULL,
+	0x8ea3496b49191e96ULL, 0xae0564c0eca818b3ULL,
+	0xa31a1a9e656240abULL, 0x5c1c89ce789eb84bULL,
+	0xda39b4c19f391841ULL, 0xde873c9a1059e95eULL,
+	0x9866e498bd4c6eceULL, 0x7e94eb20d5f11ddbULL,
+	/* 109 */
+	0x26d7abc609850d5bULL, 0x9067713119c52d77ULL,
+	0xabc6c99fe721a009ULL, 0x4297c4bffcdbd6edULL,
+	0x273ad494e8ffc9e9ULL, 0x74c2df0c8fc5befcULL,
+	0x643b9f82c0472083ULL, 0xf9edb45c5891e519ULL,
+	0x9275fc6b12132586ULL, 0x9a131f445a71ae1dULL,
+	0xa4379af8c416a489ULL, 0xb8119bc5eadd9854ULL,
+	/* 110 */
+	0xb32d7f884632457fULL, 0x6dc5e4272a7c60e9ULL,
+	0x9f030ddf704d3e51ULL, 0xf292eb459870509fULL,
+	0x6cd5c719a6298f19ULL, 0xc20841cde67ccc09ULL,
+	0xaac9c0cfaf59d03aULL, 0xf5ac980a2ca5b000ULL,
+	0xbe0e5d9defbf4d9fULL, 0x25a09ecec55b6fa2ULL,
+	0xb9c7f0dc853bc49fULL, 0xde47e40447097fe4ULL,
+	/* 111 */
+	0xa01526e2ce6c72a5ULL, 0xa6218cd89273084fULL,
+	0xd21216115cff20b1ULL, 0xa5bb26f71be49e3aULL,
+	0x2f083f937af6918dULL, 0x9f9ca72d2a4dbbe7ULL,
+	0x33398e518d602700ULL, 0xba0dfe2ff791319dULL,
+	0x6914ebb17fbfd2d0ULL, 0x12b70c0c730ce6f9ULL,
+	0x30ecacf97698c8deULL, 0x959f93d9f4d017e3ULL,
+	/* 112 */
+	0x80c1a72b657c4e84ULL, 0x851185b959215261ULL,
+	0x21edfceb681b301fULL, 0x68653fb2cc765dd9ULL,
+	0x6c0436772e0158dbULL, 0xa9db4afe0576e3d2ULL,
+	0x11aafdfbb80aba14ULL, 0xbb1d43abed09512bULL,
+	0xddd35453cfacaf8bULL, 0x0e443f367ff5ddacULL,
+	0x5631f6e9ff1bdbf0ULL, 0xcd0b4ac20c7796adULL,
+	/* 113 */
+	0xd27d462535961646ULL, 0x47fdfd6acb465d6eULL,
+	0x4e7b88a10259ceecULL, 0xccee4b9b8bb97084ULL,
+	0xc2bff2d104bf8123ULL, 0xe2b8eb5602e33b19ULL,
+	0x586e918ee1aa5ad5ULL, 0xed2779ce6eee68caULL,
+	0x792f0a34364e48a8ULL, 0xd7143878a00c03cdULL,
+	0xf2e956ef178d2310ULL, 0x210cbde9eb7b5cf3ULL,
+	/* 114 */
+	0x6d608f0897008e17ULL, 0xca610c4571013fe5ULL,
+	0x173b0e929d8191ccULL, 0x046913a69fa278acULL,
+	0xd408f9f157beb855ULL, 0xad461c4e380d6f59ULL,
+	0x1485a1ef85708994ULL, 0x1d12ca88ebbfe36eULL,
+	0x10a132691a764e61ULL, 0xd2cadba36c033a2dULL,
+	0xf6813898fbbf508eULL, 0x41aadfe3b98f2e55ULL,
+	/* 115 */
+	0x9a6b1db72a423dd3ULL, 0xd40277e65ad9a247ULL,
+	0x6309ff54c80f7f55ULL, 0x8bb2028fb83ee577ULL,
+	0xc3f7f660aae22d1eULL, 0x53deb47e663a1780ULL,
+	0xa87f3a26adce9371ULL, 0x71c68e44540cd7ebULL,
+	0x03b996dd6e829926ULL, 0xf4822f36359a2eeeULL,
+	0x842e2c3380c1002bULL, 0xe69b6f958d9994f3ULL,
+	/* 116 */
+	0xaf008aa50bc1180dULL, 0x19f991d7a3e01f60ULL,
+	0x5a71e5dc6249dcedULL, 0x54c899a949e8f5bdULL,
+	0x81c04d519de74267ULL, 0xc2ade0a59eb5d323ULL,
+	0xe04267d94cf15d71ULL, 0xc46d0aaf01cfe308ULL,
+	0x20b97eb65bd1d62bULL, 0xa3655e6200d6dd4eULL,
+	0x08fa9eb514fd3e74ULL, 0x55ea9c88c67c90c6ULL,
+	/* 117 */
+	0xd71116295c88aa9bULL, 0x960b9f976ef36714ULL,
+	0xf8cd4e0fe004b06cULL, 0x4d1c0e3f15f8367aULL,
+	0xdddf95a5faaa5407ULL, 0x6fb462bdf2c7def8ULL,
+	0x935721aee028dfe0ULL, 0x28a06b3891be0e7bULL,
+	0x5b7c9c171eb2462aULL, 0xdb23cf687467c35eULL,
+	0xd9a4383e2c681ab8ULL, 0x641304b6a5a6ff28ULL,
+	/* 118 */
+	0x14ade1fe7ea57f04ULL, 0xe95ac4daf6b6df17ULL,
+	0xfc7b5a34cc2a155cULL, 0x1d98b7eaa862d922ULL,
+	0xd76927bf7fe84c05ULL, 0x512afe43f43d97ecULL,
+	0xfcfda43f58c629ddULL, 0x8c8bbcfe77636cf8ULL,
+	0xb0447e3005627856ULL, 0x891fa8d7d9a8b4a1ULL,
+	0x8fbec215e14d26b2ULL, 0x8b8b9fc800393886ULL,
+	/* 119 */
+	0x5ff5197c0abd0e8aULL, 0xee55e02f9522623dULL,
+	0xe5d745fe2724751aULL, 0x8aeab17bd5bb6cf9ULL,
+	0xdd16838d9ff7ca68ULL, 0xc3d5a2a4e5e5fa96ULL,
+	0x39879dc61c5ec96eULL, 0xe3eb50054e48575eULL,
+	0x45d8d2ea021386f7ULL, 0x191de2341041c762ULL,
+	0x6c8eec1f5d35167fULL, 0x74b6f9195cb9d529ULL,
+	/* 120 */
+	0xb32dfbd8e2e9a7f5ULL, 0x93287ec023055ad9ULL,
+	0x356c68a806c94693ULL, 0x4bb07017ca2c6f8aULL,
+	0x023b3fd585a4edceULL, 0xa1c0a54d60d6531cULL,
+	0xfa9b04c085ef76f8ULL, 0x04c2d556c202a5b1ULL,
+	0x3f43fefb7c890617ULL, 0xc9aedc03e02f8ba4ULL,
+	0x8ea129a8a3a4205fULL, 0xd84b6e983328a482ULL,
+	/* 121 */
+	0xc3d7a42d635125f9ULL, 0x67c73a1c1a40510eULL,
+	0xa9448f6ae95b613aULL, 0x50db93069bb9e4d0ULL,
+	0x97f8530155a69ac9ULL, 0x56f303da9071b5a9ULL,
+	0x55768421a8332092ULL, 0x73106529ab029df5ULL,
+	0x0117bace96e8d2b0ULL, 0x42d91afc1cace100ULL,
+	0x6a5eccff200dc4e3ULL, 0xb72275eb1e06cc39ULL,
+	/* 122 */
+	0x740f2065f34ed7d5ULL, 0x99fa551f1c7cbc43ULL,
+	0x5606ce84d04af268ULL, 0x8b4817ff4620cffdULL,
+	0xfe258fdb4bdfe8a4ULL, 0xe487e0095f3a25deULL,
+	0xbe5caf40fa5c0ab9ULL, 0x444fea5ea9b97baaULL,
+	0xca1850f7b4c20088ULL, 0x6f46fdc27098d6acULL,
+	0x246f5252306fc58aULL, 0xd1469822111b92e4ULL,
+	/* 123 */
+	0x2d133afae8b191a3ULL, 0x2d445955da96c154ULL,
+	0x4f012349b8bc5ba1ULL, 0xa8fe73f7253c8bd8ULL,
+	0x59b207e9384a1504ULL, 0x6010259ec0a89993ULL,
+	0xe16549a7c08c998cULL, 0x45a2d404b0f5f3a5ULL,
+	0x34cbc44aaf60f8baULL, 0x4e7cabf1257d5639ULL,
+	0x9e318d89fcf31c36ULL, 0xa592df189dadbd40ULL,
+	/* 124 */
+	0xdc9a1d8954a5461eULL, 0xd64217a098142766ULL,
+	0x203c82268cc9c69bULL, 0x53fa41169adb5523ULL,
+	0xaa4a364f21996946ULL, 0x7e8e57bdfabe95bbULL,
+	0xe0bd9ca0f93b4b4cULL, 0xa8a0b93a337fbf5eULL,
+	0xdb88e2d8ce29d7a7ULL, 0x0d48d28b15037df9ULL,
+	0xc610f19aafa94595ULL, 0x3d0c040207c69055ULL,
+	/* 125 */
+	0xf51ad1cc82725403ULL, 0x9db46c539a3cec9eULL,
+	0x066a883da5ec3f15ULL, 0x37d1ef313d024c46ULL,
+	0x735925911fb98f6eULL, 0x30785711bfd8319bULL,
+	0x87d44156a8803c62ULL, 0x69f9cf9a1fdeecbdULL,
+	0x0d341184829f63f4ULL, 0x9edd11fb9a4f95bfULL,
+	0xa6c7b7ad3e4dd31eULL, 0x8c1b460c05043350ULL,
+	/* 126 */
+	0x1eb9775d6a405a43ULL, 0x5d67752a4b73348aULL,
+	0x479445bb75b36310ULL, 0x8348408173f8f5a9ULL,
+	0x46f7af0aa266d3a8ULL, 0x6391b9a25f2248afULL,
+	0x18fa1d181ca76494ULL, 0x275d30ffb553a71eULL,
+	0x83ab6c8904daf154ULL, 0x638f43f9e150c323ULL,
+	0x9b53178f1d2b3575ULL, 0x933e4c7d9821acedULL,
+	/* 127 */
+	0x192007ccb1d72abbULL, 0x9fd9fcf2cb15220dULL,
+	0x4bdb1380f6c465a9ULL, 0xd8ed2bc32efbf65bULL,
+	0x61aa9986754be04eULL, 0x1279be617907b301ULL,
+	0x59d7a950e5742984ULL, 0x6fc27d5b27663fcdULL,
+	0xb28af3e881cba087ULL, 0x893cbfacbc334629ULL,
+	0x8ce22ffdc35136d8ULL, 0x5ed083a8d92d6300ULL,
+};
+
+static const struct ec_comb_table ec_comb_tables[] = {
+	{
+		.field_bits = 256,
+		.nwords = 4,
+		.spacing = (256 + EC_COMB_TEETH - 1) / EC_COMB_TEETH,
+		.params = ec_comb_p256_params,
+		.points = ec_comb_p256_points,
+	},
+	{
+		.field_bits = 384,
+		.nwords = 6,
+		.spacing = (384 + EC_COMB_TEETH - 1) / EC_COMB_TEETH,
+		.params = ec_comb_p384_params,
+		.points = ec_comb_p384_points,
+	},
+};
+
+#define N_COMB_TABLES (sizeof(ec_comb_tables) / sizeof(ec_comb_tables[0]))
+
+static int
+ec_comb_bn_set_words(BIGNUM *bn, const uint64_t *words, size_t nwords)
+{
+	size_t i;
+
+	if (!bn_wexpand(bn, nwords * 64 / BN_BITS2))
+		return 0;
+	for (i = 0; i < nwords; i++) {
+#if BN_BITS2 == 64
+		bn->d[i] = words[i];
+#else
+		bn->d[2 * i] = (BN_ULONG)words[i];
+		bn->d[2 * i + 1] = (BN_ULONG)(words[i] >> 32);
+#endif
+	}
+	bn->top = nwords * 64 / BN_BITS2;
+	bn->neg = 0;
+	bn_correct_top(bn);
+
+	return 1;
+}
+
+static int
+ec_comb_point_set_words(const EC_GROUP *group, EC_POINT *point,
+    const uint64_t *words, size_t nwords, BN_CTX *ctx)
+{
+	BIGNUM *x, *y;
+	int ret = 0;
+
+	BN_CTX_start(ctx);
+
+	if ((x = BN_CTX_get(ctx)) == NULL)
+		goto err;
+	if ((y = BN_CTX_get(ctx)) == NULL)
+		goto err;
+
+	BN_set_flags(x, BN_FLG_CONSTTIME);
+	BN_set_flags(y, BN_FLG_CONSTTIME);
+
+	if (!ec_comb_bn_set_words(x, &words[0], nwords))
+		goto err;
+	if (!ec_comb_bn_set_words(y, &words[nwords], nwords))
+		goto err;
+
+	ret = group->meth->point_set_Jprojective_coordinates(group, point,
+	    x, y, BN_value_one(), ctx);
+
+ err:
+	BN_CTX_end(ctx);
+
+	return ret;
+}
+
+static int
+ec_comb_bn_cmp_words(BIGNUM *tmp, const BIGNUM *bn, const uint64_t *words,
+    size_t nwords)
+{
+	if (!ec_comb_bn_set_words(tmp, words, nwords))
+		return -1;
+
+	return BN_cmp(tmp, bn);
+}
+
+static int
+ec_comb_table_matches(const EC_GROUP *group,
+    const struct ec_comb_table *table, BN_CTX *ctx)
+{
+	const uint64_t *params = table->params;
+	size_t nwords = table->nwords;
+	BIGNUM *p, *a, *b, *x, *y, *tmp;
+	int ret = 0;
+
+	BN_CTX_start(ctx);
+
+	if ((p = BN_CTX_get(ctx)) == NULL)
+		goto err;
+	if ((a = BN_CTX_get(ctx)) == NULL)
+		goto err;
+	if ((b = BN_CTX_get(ctx)) == NULL)
+		goto err;
+	if ((x = BN_CTX_get(ctx)) == NULL)
+		goto err;
+	if ((y = BN_CTX_get(ctx)) == NULL)
+		goto err;
+	if ((tmp = BN_CTX_get(ctx)) == NULL)
+		goto err;
+
+	if (!group->meth->group_get_curve(group, p, a, b, ctx))
+		goto err;
+	if (!group->meth->point_get_affine_coordinates(group, group->generator,
+	    x, y, ctx))
+		goto err;
+
+	if (ec_comb_bn_cmp_words(tmp, p, &params[0 * nwords], nwords) != 0)
+		goto err;
+	if (ec_comb_bn_cmp_words(tmp, a, &params[1 * nwords], nwords) != 0)
+		goto err;
+	if (ec_comb_bn_cmp_words(tmp, b, &params[2 * nwords], nwords) != 0)
+		goto err;
+	if (ec_comb_bn_cmp_words(tmp, &group->order, &params[3 * nwords],
+	    nwords) != 0)
+		goto err;
+	if (!BN_is_one(&group->cofactor))
+		goto err;
+	if (ec_comb_bn_cmp_words(tmp, x, &table->points[0], nwords) != 0)
+		goto err;
+	if (ec_comb_bn_cmp_words(tmp, y, &table->points[nwords], nwords) != 0)
+		goto err;
+
+	ret = 1;
+
+ err:
+	BN_CTX_end(ctx);
+
+	return ret;
+}
+
+/*
+ * Returns the comb table for the curve and generator of group, or NULL
+ * if there is none.
+ */
+const struct ec_comb_table *
+ec_GFp_comb_table_lookup(const EC_GROUP *group)
+{
+	const struct ec_comb_table *table = NULL;
+	BN_CTX *ctx = NULL;
+	size_t i;
+
+	if (group->meth->field_type != NID_X9_62_prime_field)
+		return NULL;
+	if (group->generator == NULL)
+		return NULL;
+
+	/* Failure to match is not an error. */
+	ERR_set_mark();
+
+	for (i = 0; i < N_COMB_TABLES; i++) {
+		if (BN_num_bits(&group->field) != ec_comb_tables[i].field_bits)
+			continue;
+		if (ctx == NULL && (ctx = BN_CTX_new()) == NULL)
+			break;
+		if (ec_comb_table_matches(group, &ec_comb_tables[i], ctx)) {
+			table = &ec_comb_tables[i];
+			break;
+		}
+	}
+
+	BN_CTX_free(ctx);
+
+	ERR_pop_to_mark();
+
+	return table;
+}
+
+/*
+ * Copy entry idx of the table to out, reading every entry of the table.
+ * Entry 1 is selected if idx is 0.
+ */
+void
+ec_GFp_comb_select(const struct ec_comb_table *table, unsigned int idx,
+    uint64_t *out)
+{
+	const uint64_t *point = table->points;
+	size_t nwords = 2 * table->nwords;
+	uint64_t mask;
+	unsigned int i;
+	size_t j;
+
+	idx |= constant_time_is_zero(idx) & 1;
+
+	memset(out, 0, nwords * sizeof(*out));
+
+	for (i = 1; i <= EC_COMB_POINTS; i++) {
+		mask = 0 - (uint64_t)(constant_time_eq(i, idx) & 1);
+		for (j = 0; j < nwords; j++)
+			out[j] |= point[j] & mask;
+		point += nwords;
+	}
+}
+
+#define EC_POINT_CSWAP(c, a, b, w, t) do {				\
+	if (!BN_swap_ct(c, &(a)->X, &(b)->X, w)	||			\
+	    !BN_swap_ct(c, &(a)->Y, &(b)->Y, w)	||			\
+	    !BN_swap_ct(c, &(a)->Z, &(b)->Z, w))			\
+		goto err;						\
+	t = ((a)->Z_is_one ^ (b)->Z_is_one) & (c);			\
+	(a)->Z_is_one ^= (t);						\
+	(b)->Z_is_one ^= (t);						\
+} while(0)
+
+/*
+ * Computes scalar * generator with the comb table of the group. The scalar
+ * should be in the range [0, order), otherwise it is reduced without any
+ * constant time guarantees.
+ */
+int
+ec_GFp_comb_mul_generator_ct(const EC_GROUP *group, EC_POINT *r,
+    const BIGNUM *scalar, BN_CTX *ctx)
+{
+	const struct ec_comb_table *table = group->comb_table;
+	unsigned char k[EC_COMB_MAX_BYTES];
+	uint64_t point[2 * EC_COMB_MAX_WORDS];
+	size_t nwords = table->nwords;
+	int nbytes = (EC_COMB_TEETH * table->spacing + 7) / 8;
+	EC_POINT *s = NULL, *t = NULL;
+	BIGNUM *tmp;
+	unsigned int digit, bit, nonzero;
+	int group_top, i, j, Z_is_one;
+	int ret = 0;
+
+	BN_CTX_start(ctx);
+
+	if ((s = EC_POINT_new(group)) == NULL)
+		goto err;
+	if ((t = EC_POINT_new(group)) == NULL)
+		goto err;
+	if ((tmp = BN_CTX_get(ctx)) == NULL)
+		goto err;
+
+	if (BN_num_bits(scalar) > BN_num_bits(&group->order) ||
+	    BN_is_negative(scalar)) {
+		/* This is an unusual input, we don't guarantee constant time. */
+		if (!BN_nnmod(tmp, scalar, &group->order, ctx))
+			goto err;
+		scalar = tmp;
+	}
+	if (BN_bn2lebinpad(scalar, k, nbytes) != nbytes)
+		goto err;
+
+	group_top = group->field.top;
+	if (!bn_wexpand(&r->X, group_top) ||
+	    !bn_wexpand(&r->Y, group_top) ||
+	    !bn_wexpand(&r->Z, group_top) ||
+	    !bn_wexpand(&s->X, group_top) ||
+	    !bn_wexpand(&s->Y, group_top) ||
+	    !bn_wexpand(&s->Z, group_top))
+		goto err;
+
+	if (!ec_comb_point_set_words(group, r, &table->params[4 * nwords],
+	    nwords, ctx))
+		goto err;
+	if (!ec_point_blind_coordinates(group, r, ctx))
+		goto err;
+
+	for (j = table->spacing - 1; j >= 0; j--) {
+		if (j != table->spacing - 1) {
+			if (!EC_POINT_dbl(group, r, r, ctx))
+				goto err;
+		}
+
+		digit = 0;
+		for (i = 0; i < EC_COMB_TEETH; i++) {
+			bit = i * table->spacing + j;
+			digit |= ((k[bit / 8] >> (bit % 8)) & 1) << i;
+		}
+
+		ec_GFp_comb_select(table, digit, point);
+		if (!ec_comb_point_set_words(group, t, point, nwords, ctx))
+			goto err;
+		if (!EC_POINT_add(group, s, r, t, ctx))
+			goto err;
+
+		/* Keep the sum unless the column was zero. */
+		nonzero = ~constant_time_is_zero(digit) & 1;
+		EC_POINT_CSWAP(nonzero, r, s, group_top, Z_is_one);
+	}
+
+	if (!ec_comb_point_set_words(group, t, &table->params[6 * nwords],
+	    nwords, ctx))
+		goto err;
+	if (!EC_POINT_add(group, r, r, t, ctx))
+		goto err;
+
+	ret = 1;
+
+ err:
+	EC_POINT_free(s);
+	EC_POINT_free(t);
+	BN_CTX_end(ctx);
+	explicit_bzero(k, sizeof(k));
+	explicit_bzero(point, sizeof(point));
+
+	return ret;
+}
+
+#undef EC_POINT_CSWAP
@@ -0,0 +1,860 @@
+/* $OpenBSD$ */
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * EC_METHOD for the X9.62 prime256v1 curve with fixed size field elements.
+ *
+ * Field elements are held in 256 / BN_BITS2 words in Montgomery form with
+ * R = 2^256, which is the same representation that EC_GFp_mont_method()
+ * uses for the coordinates of an EC_POINT. All of the point functions other
+ * than scalar multiplication are shared with the simple method. Since
+ * p = -1 mod 2^BN_BITS2, each Montgomery reduction step only adds a multiple
+ * of p given by the lowest remaining word.
+ *
+ * Scalar multiplication uses Jacobian coordinates with a = -3 and performs
+ * the same sequence of field operations for every scalar. Arbitrary points
+ * are multiplied with a fixed four bit window, the generator with the comb
+ * table from ecp_comb.c. Table entries are selected by reading every entry.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include <openssl/err.h>
+
+#include "bn_internal.h"
+#include "bn_local.h"
+#include "ec_local.h"
+
+#define P256_WORDS	(256 / BN_BITS2)
+
+#if BN_BITS2 == 64
+#define P256_WORD(hi, lo)	(((BN_ULONG)(hi) << 32) | (lo))
+#else
+#define P256_WORD(hi, lo)	(lo), (hi)
+#endif
+
+#define P256_WINDOW_BITS	4
+#define P256_WINDOW_SIZE	(1 << P256_WINDOW_BITS)
+
+/* p = 2^256 - 2^224 + 2^192 + 2^96 - 1 */
+static const BN_ULONG p256_p[P256_WORDS] = {
+	P256_WORD(0xffffffff, 0xffffffff), P256_WORD(0x00000000, 0xffffffff),
+	P256_WORD(0x00000000, 0x00000000), P256_WORD(0xffffffff, 0x00000001),
+};
+
+/* R mod p */
+static const BN_ULONG p256_one[P256_WORDS] = {
+	P256_WORD(0x00000000, 0x00000001), P256_WORD(0xffffffff, 0x00000000),
+	P256_WORD(0xffffffff, 0xffffffff), P256_WORD(0x00000000, 0xfffffffe),
+};
+
+/* R^2 mod p */
+static const BN_ULONG p256_rr[P256_WORDS] = {
+	P256_WORD(0x00000000, 0x00000003), P256_WORD(0xfffffffb, 0xffffffff),
+	P256_WORD(0xffffffff, 0xfffffffe), P256_WORD(0x00000004, 0xfffffffd),
+};
+
+/* 1, for converting out of Montgomery form. */
+static const BN_ULONG p256_unit[P256_WORDS] = {
+	P256_WORD(0x00000000, 0x00000001),
+};
+
+/* Jacobian coordinates in Montgomery form, Z = 0 is the point at infinity. */
+struct p256_point {
+	BN_ULONG X[P256_WORDS];
+	BN_ULONG Y[P256_WORDS];
+	BN_ULONG Z[P256_WORDS];
+};
+
+/* r = a if mask is all ones, b if mask is zero. */
+static void
+p256_fe_select(BN_ULONG *r, BN_ULONG mask, const BN_ULONG *a,
+    const BN_ULONG *b)
+{
+	int i;
+
+	for (i = 0; i < P256_WORDS; i++)
+		r[i] = (a[i] & mask) | (b[i] & ~mask);
+}
+
+static BN_ULONG
+p256_fe_is_zero_mask(const BN_ULONG *a)
+{
+	BN_ULONG w = 0;
+	int i;
+
+	for (i = 0; i < P256_WORDS; i++)
+		w |= a[i];
+
+	return bn_ct_eq_zero_mask(w);
+}
+
+/* r = (carry:a) mod p, where (carry:a) < 2p. */
+static void
+p256_fe_reduce_once(BN_ULONG *r, const BN_ULONG *a, BN_ULONG carry)
+{
+	BN_ULONG t[P256_WORDS], borrow = 0;
+	int i;
+
+	for (i = 0; i < P256_WORDS; i++)
+		bn_subw_subw(a[i], p256_p[i], borrow, &borrow, &t[i]);
+
+	/* Keep a if the subtraction of p borrowed beyond the carry word. */
+	p256_fe_select(r, bn_ct_ne_zero_mask(borrow & ~carry), a, t);
+}
+
+static void
+p256_fe_add(BN_ULONG *r, const BN_ULONG *a, const BN_ULONG *b)
+{
+	BN_ULONG t[P256_WORDS], carry = 0;
+	int i;
+
+	for (i = 0; i < P256_WORDS; i++)
+		bn_addw_addw(a[i], b[i], carry, &carry, &t[i]);
+
+	p256_fe_reduce_once(r, t, carry);
+}
+
+static void
+p256_fe_sub(BN_ULONG *r, const BN_ULONG *a, const BN_ULONG *b)
+{
+	BN_ULONG t[P256_WORDS], borrow = 0, carry = 0, mask;
+	int i;
+
+	for (i = 0; i < P256_WORDS; i++)
+		bn_subw_subw(a[i], b[i], borrow, &borrow, &t[i]);
+
+	/* Add p back if the subtraction borrowed. */
+	mask = bn_ct_ne_zero_mask(borrow);
+	for (i = 0; i < P256_WORDS; i++)
+		bn_addw_addw(t[i], p256_p[i] & mask, carry, &carry, &r[i]);
+}
+
+/*
+ * Montgomery reduction of the double width t < pR, which is clobbered.
+ * Since -p^-1 = 1 mod 2^BN_BITS2, the multiple of p that clears word i
+ * is the word itself.
+ */
+static void
+p256_fe_mont_reduce(BN_ULONG *r, BN_ULONG *t)
+{
+	BN_ULONG m, carry, top = 0;
+	int i, j;
+
+	for (i = 0; i < P256_WORDS; i++) {
+		m = t[i];
+		carry = 0;
+		for (j = 0; j < P256_WORDS; j++)
+			bn_mulw_addw_addw(m, p256_p[j], t[i + j], carry,
+			    &carry, &t[i + j]);
+		bn_addw_addw(t[i + P256_WORDS], carry, top, &top,
+		    &t[i + P256_WORDS]);
+	}
+
+	p256_fe_reduce_once(r, &t[P256_WORDS], top);
+}
+
+static void
+p256_fe_mul(BN_ULONG *r, const BN_ULONG *a, const BN_ULONG *b)
+{
+	BN_ULONG t[2 * P256_WORDS];
+
+#if P256_WORDS == 4
+	bn_mul_comba4(t, (BN_ULONG *)a, (BN_ULONG *)b);
+#else
+	bn_mul_comba8(t, (BN_ULONG *)a, (BN_ULONG *)b);
+#endif
+	p256_fe_mont_reduce(r, t);
+}
+
+static void
+p256_fe_sqr(BN_ULONG *r, const BN_ULONG *a)
+{
+	BN_ULONG t[2 * P256_WORDS];
+
+#if P256_WORDS == 4
+	bn_sqr_comba4(t, a);
+#else
+	bn_sqr_comba8(t, a);
+#endif
+	p256_fe_mont_reduce(r, t);
+}
+
+static void
+p256_fe_from_words(BN_ULONG *r, const uint64_t *words)
+{
+	int i;
+
+#if BN_BITS2 == 64
+	for (i = 0; i < P256_WORDS; i++)
+		r[i] = words[i];
+#else
+	for (i = 0; i < P256_WORDS / 2; i++) {
+		r[2 * i] = (BN_ULONG)words[i];
+		r[2 * i + 1] = (BN_ULONG)(words[i] >> 32);
+	}
+#endif
+}
+
+/* Field elements must be reduced, which EC_POINT coordinates always are. */
+static int
+p256_fe_from_bn(BN_ULONG *r, const BIGNUM *a)
+{
+	int i;
+
+	if (BN_is_negative(a) || a->top > P256_WORDS) {
+		ECerror(EC_R_BIGNUM_OUT_OF_RANGE);
+		return 0;
+	}
+	for (i = 0; i < P256_WORDS; i++)
+		r[i] = i < a->top ? a->d[i] : 0;
+
+	return 1;
+}
+
+static int
+p256_fe_to_bn(BIGNUM *r, const BN_ULONG *a)
+{
+	int i;
+
+	if (!bn_wexpand(r, P256_WORDS))
+		return 0;
+	for (i = 0; i < P256_WORDS; i++)
+		r->d[i] = a[i];
+	r->top = P256_WORDS;
+	r->neg = 0;
+	bn_correct_top(r);
+
+	return 1;
+}
+
+static void
+p256_point_select(struct p256_point *r, BN_ULONG mask,
+    const struct p256_point *a, const struct p256_point *b)
+{
+	p256_fe_select(r->X, mask, a->X, b->X);
+	p256_fe_select(r->Y, mask, a->Y, b->Y);
+	p256_fe_select(r->Z, mask, a->Z, b->Z);
+}
+
+static int
+p256_point_from_ec_point(struct p256_point *r, const EC_POINT *point)
+{
+	return p256_fe_from_bn(r->X, &point->X) &&
+	    p256_fe_from_bn(r->Y, &point->Y) &&
+	    p256_fe_from_bn(r->Z, &point->Z);
+}
+
+static int
+p256_point_to_ec_point(EC_POINT *r, const struct p256_point *point)
+{
+	if (!p256_fe_to_bn(&r->X, point->X))
+		return 0;
+	if (!p256_fe_to_bn(&r->Y, point->Y))
+		return 0;
+	if (!p256_fe_to_bn(&r->Z, point->Z))
+		return 0;
+	r->Z_is_one = 0;
+
+	return 1;
+}
+
+/* dbl-2001-b, r may alias a. */
+static void
+p256_point_double(struct p256_point *r, const struct p256_point *a)
+{
+	BN_ULONG delta[P256_WORDS], gamma[P256_WORDS], beta[P256_WORDS];
+	BN_ULONG alpha[P256_WORDS], t0[P256_WORDS], t1[P256_WORDS];
+
+	p256_fe_sqr(delta, a->Z);
+	p256_fe_sqr(gamma, a->Y);
+	p256_fe_mul(beta, a->X, gamma);
+
+	/* alpha = 3 * (X - delta) * (X + delta) */
+	p256_fe_sub(t0, a->X, delta);
+	p256_fe_add(t1, a->X, delta);
+	p256_fe_mul(alpha, t0, t1);
+	p256_fe_add(t0, alpha, alpha);
+	p256_fe_add(alpha, t0, alpha);
+
+	/* Z3 = (Y + Z)^2 - gamma - delta */
+	p256_fe_add(t0, a->Y, a->Z);
+	p256_fe_sqr(t0, t0);
+	p256_fe_sub(t0, t0, gamma);
+	p256_fe_sub(r->Z, t0, delta);
+
+	/* X3 = alpha^2 - 8 * beta */
+	p256_fe_add(beta, beta, beta);
+	p256_fe_add(beta, beta, beta);
+	p256_fe_sqr(t0, alpha);
+	p256_fe_sub(t0, t0, beta);
+	p256_fe_sub(r->X, t0, beta);
+
+	/* Y3 = alpha * (4 * beta - X3) - 8 * gamma^2 */
+	p256_fe_sub(t0, beta, r->X);
+	p256_fe_mul(t0, alpha, t0);
+	p256_fe_sqr(gamma, gamma);
+	p256_fe_add(gamma, gamma, gamma);
+	p256_fe_add(gamma, gamma, gamma);
+	p256_fe_add(gamma, gamma, gamma);
+	p256_fe_sub(r->Y, t0, gamma);
+}
+
+/*
+ * add-2007-bl, r may alias a or b. The formula fails for a == b, which is
+ * handled by doubling instead. This branch is never taken by the constant
+ * time scalar multiplications since their accumulator can never equal the
+ * point being added to it.
+ */
+static void
+p256_point_add(struct p256_point *r, const struct p256_point *a,
+    const struct p256_point *b)
+{
+	BN_ULONG z1z1[P256_WORDS], z2z2[P256_WORDS], u1[P256_WORDS];
+	BN_ULONG u2[P256_WORDS], s1[P256_WORDS], s2[P256_WORDS];
+	BN_ULONG h[P256_WORDS], i[P256_WORDS], j[P256_WORDS];
+	BN_ULONG rr[P256_WORDS], v[P256_WORDS], t[P256_WORDS];
+	BN_ULONG a_inf, b_inf;
+	struct p256_point sum;
+
+	a_inf = p256_fe_is_zero_mask(a->Z);
+	b_inf = p256_fe_is_zero_mask(b->Z);
+
+	p256_fe_sqr(z1z1, a->Z);
+	p256_fe_sqr(z2z2, b->Z);
+	p256_fe_mul(u1, a->X, z2z2);
+	p256_fe_mul(u2, b->X, z1z1);
+	p256_fe_mul(s1, a->Y, b->Z);
+	p256_fe_mul(s1, s1, z2z2);
+	p256_fe_mul(s2, b->Y, a->Z);
+	p256_fe_mul(s2, s2, z1z1);
+	p256_fe_sub(h, u2, u1);
+	p256_fe_sub(rr, s2, s1);
+
+	if ((p256_fe_is_zero_mask(h) & p256_fe_is_zero_mask(rr) &
+	    ~a_inf & ~b_inf) != 0) {
+		p256_point_double(r, a);
+		return;
+	}
+
+	/* I = (2 * H)^2, J = H * I, r = 2 * (S2 - S1), V = U1 * I */
+	p256_fe_add(i, h, h);
+	p256_fe_sqr(i, i);
+	p256_fe_mul(j, h, i);
+	p256_fe_add(rr, rr, rr);
+	p256_fe_mul(v, u1, i);
+
+	/* X3 = r^2 - J - 2 * V */
+	p256_fe_sqr(t, rr);
+	p256_fe_sub(t, t, j);
+	p256_fe_sub(t, t, v);
+	p256_fe_sub(sum.X, t, v);
+
+	/* Y3 = r * (V - X3) - 2 * S1 * J */
+	p256_fe_sub(t, v, sum.X);
+	p256_fe_mul(t, rr, t);
+	p256_fe_mul(s1, s1, j);
+	p256_fe_add(s1, s1, s1);
+	p256_fe_sub(sum.Y, t, s1);
+
+	/* Z3 = ((Z1 + Z2)^2 - Z1Z1 - Z2Z2) * H */
+	p256_fe_add(t, a->Z, b->Z);
+	p256_fe_sqr(t, t);
+	p256_fe_sub(t, t, z1z1);
+	p256_fe_sub(t, t, z2z2);
+	p256_fe_mul(sum.Z, t, h);
+
+	p256_point_select(&sum, a_inf, b, &sum);
+	p256_point_select(&sum, b_inf, a, &sum);
+	*r = sum;
+}
+
+/*
+ * madd-2007-bl, adds the affine point (x2, y2) to a, r may alias a. As for
+ * p256_point_add(), a == (x2, y2) is handled by doubling.
+ */
+static void
+p256_point_add_affine(struct p256_point *r, const struct p256_point *a,
+    const BN_ULONG *x2, const BN_ULONG *y2)
+{
+	BN_ULONG z1z1[P256_WORDS], u2[P256_WORDS], s2[P256_WORDS];
+	BN_ULONG h[P256_WORDS], hh[P256_WORDS], i[P256_WORDS];
+	BN_ULONG j[P256_WORDS], rr[P256_WORDS], v[P256_WORDS];
+	BN_ULONG t[P256_WORDS];
+	BN_ULONG a_inf;
+	struct p256_point sum;
+
+	a_inf = p256_fe_is_zero_mask(a->Z);
+
+	p256_fe_sqr(z1z1, a->Z);
+	p256_fe_mul(u2, x2, z1z1);
+	p256_fe_mul(s2, y2, a->Z);
+	p256_fe_mul(s2, s2, z1z1);
+	p256_fe_sub(h, u2, a->X);
+	p256_fe_sub(rr, s2, a->Y);
+
+	if ((p256_fe_is_zero_mask(h) & p256_fe_is_zero_mask(rr) &
+	    ~a_inf) != 0) {
+		p256_point_double(r, a);
+		return;
+	}
+
+	/* HH = H^2, I = 4 * HH, J = H * I, r = 2 * (S2 - Y1), V = X1 * I */
+	p256_fe_sqr(hh, h);
+	p256_fe_add(i, hh, hh);
+	p256_fe_add(i, i, i);
+	p256_fe_mul(j, h, i);
+	p256_fe_add(rr, rr, rr);
+	p256_fe_mul(v, a->X, i);
+
+	/* X3 = r^2 - J - 2 * V */
+	p256_fe_sqr(t, rr);
+	p256_fe_sub(t, t, j);
+	p256_fe_sub(t, t, v);
+	p256_fe_sub(sum.X, t, v);
+
+	/* Y3 = r * (V - X3) - 2 * Y1 * J */
+	p256_fe_sub(t, v, sum.X);
+	p256_fe_mul(t, rr, t);
+	p256_fe_mul(j, a->Y, j);
+	p256_fe_add(j, j, j);
+	p256_fe_sub(sum.Y, t, j);
+
+	/* Z3 = (Z1 + H)^2 - Z1Z1 - HH */
+	p256_fe_add(t, a->Z, h);
+	p256_fe_sqr(t, t);
+	p256_fe_sub(t, t, z1z1);
+	p256_fe_sub(sum.Z, t, hh);
+
+	/* If a is the point at infinity the result is (x2, y2, 1). */
+	p256_fe_select(r->X, a_inf, x2, sum.X);
+	p256_fe_select(r->Y, a_inf, y2, sum.Y);
+	p256_fe_select(r->Z, a_inf, p256_one, sum.Z);
+}
+
+/*
+ * Computes k * point with a fixed window, where k is a little endian
+ * 32 byte scalar that is less than the group order.
+ */
+static void
+p256_point_mul_window(struct p256_point *r, const unsigned char *k,
+    const struct p256_point *point)
+{
+	struct p256_point table[P256_WINDOW_SIZE], t;
+	BN_ULONG mask;
+	unsigned int digit;
+	int i, j;
+
+	memset(&table[0], 0, sizeof(table[0]));
+	table[1] = *point;
+	for (i = 2; i < P256_WINDOW_SIZE; i += 2) {
+		p256_point_double(&table[i], &table[i / 2]);
+		p256_point_add(&table[i + 1], &table[i], point);
+	}
+
+	memset(r, 0, sizeof(*r));
+
+	for (i = 256 / P256_WINDOW_BITS - 1; i >= 0; i--) {
+		if (i != 256 / P256_WINDOW_BITS - 1) {
+			for (j = 0; j < P256_WINDOW_BITS; j++)
+				p256_point_double(r, r);
+		}
+
+		digit = (k[i / 2] >> (4 * (i % 2))) & 0xf;
+
+		memset(&t, 0, sizeof(t));
+		for (j = 0; j < P256_WINDOW_SIZE; j++) {
+			mask = bn_ct_eq_zero_mask((BN_ULONG)(j ^ digit));
+			p256_point_select(&t, mask, &table[j], &t);
+		}
+		p256_point_add(r, r, &t);
+	}
+
+	explicit_bzero(table, sizeof(table));
+	explicit_bzero(&t, sizeof(t));
+}
+
+/*
+ * Computes k * generator with the comb table, where k is a little endian
+ * scalar that is less than the group order and padded to cover all teeth.
+ */
+static void
+p256_point_mul_comb(struct p256_point *r, const unsigned char *k,
+    const struct ec_comb_table *table)
+{
+	uint64_t words[2 * P256_WORDS * BN_BITS2 / 64];
+	BN_ULONG x[P256_WORDS], y[P256_WORDS];
+	struct p256_point t;
+	unsigned int digit, bit;
+	int i, j;
+
+	memset(r, 0, sizeof(*r));
+
+	for (j = table->spacing - 1; j >= 0; j--) {
+		if (j != table->spacing - 1)
+			p256_point_double(r, r);
+
+		digit = 0;
+		for (i = 0; i < EC_COMB_TEETH; i++) {
+			bit = i * table->spacing + j;
+			digit |= ((k[bit / 8] >> (bit % 8)) & 1) << i;
+		}
+
+		ec_GFp_comb_select(table, digit, words);
+		p256_fe_from_words(x, &words[0]);
+		p256_fe_from_words(y, &words[table->nwords]);
+		p256_fe_mul(x, x, p256_rr);
+		p256_fe_mul(y, y, p256_rr);
+
+		/* Keep the sum unless the column was zero. */
+		p256_point_add_affine(&t, r, x, y);
+		p256_point_select(r, bn_ct_ne_zero_mask(digit), &t, r);
+	}
+
+	explicit_bzero(words, sizeof(words));
+	explicit_bzero(x, sizeof(x));
+	explicit_bzero(y, sizeof(y));
+	explicit_bzero(&t, sizeof(t));
+}
+
+/*
+ * Converts the scalar to nbytes little endian bytes. Scalars outside of
+ * [0, order) are unusual inputs, these are reduced without any constant
+ * time guarantees.
+ */
+static int
+p256_scalar_to_bytes(const EC_GROUP *group, unsigned char *k, int nbytes,
+    const BIGNUM *scalar, BN_CTX *ctx)
+{
+	BIGNUM *tmp;
+	int ret = 0;
+
+	BN_CTX_start(ctx);
+
+	if ((tmp = BN_CTX_get(ctx)) == NULL)
+		goto err;
+
+	if (BN_is_negative(scalar) || BN_ucmp(scalar, &group->order) >= 0) {
+		if (!BN_nnmod(tmp, scalar, &group->order, ctx))
+			goto err;
+		scalar = tmp;
+	}
+	if (BN_bn2lebinpad(scalar, k, nbytes) != nbytes)
+		goto err;
+
+	ret = 1;
+
+ err:
+	BN_CTX_end(ctx);
+
+	return ret;
+}
+
+static int
+p256_mul_generator(const EC_GROUP *group, struct p256_point *r,
+    const BIGNUM *scalar, BN_CTX *ctx)
+{
+	const struct ec_comb_table *table = group->comb_table;
+	unsigned char k[(EC_COMB_TEETH * 64 + 7) / 8];
+	struct p256_point g;
+	int nbytes;
+	int ret = 0;
+
+	if (group->generator == NULL) {
+		ECerror(EC_R_UNDEFINED_GENERATOR);
+		goto err;
+	}
+
+	if (table != NULL && table->field_bits == 256) {
+		nbytes = (EC_COMB_TEETH * table->spacing + 7) / 8;
+		if ((size_t)nbytes > sizeof(k))
+			goto err;
+		if (!p256_scalar_to_bytes(group, k, nbytes, scalar, ctx))
+			goto err;
+		p256_point_mul_comb(r, k, table);
+	} else {
+		if (!p256_scalar_to_bytes(group, k, 32, scalar, ctx))
+			goto err;
+		if (!p256_point_from_ec_point(&g, group->generator))
+			goto err;
+		p256_point_mul_window(r, k, &g);
+	}
+
+	ret = 1;
+
+ err:
+	explicit_bzero(k, sizeof(k));
+
+	return ret;
+}
+
+static int
+p256_mul_point(const EC_GROUP *group, struct p256_point *r,
+    const BIGNUM *scalar, const EC_POINT *point, BN_CTX *ctx)
+{
+	unsigned char k[32];
+	struct p256_point p;
+	EC_POINT *blinded = NULL;
+	int ret = 0;
+
+	if ((blinded = EC_POINT_new(group)) == NULL)
+		goto err;
+	if (!EC_POINT_copy(blinded, point))
+		goto err;
+	if (!ec_point_blind_coordinates(group, blinded, ctx))
+		goto err;
+	if (!p256_point_from_ec_point(&p, blinded))
+		goto err;
+
+	if (!p256_scalar_to_bytes(group, k, sizeof(k), scalar, ctx))
+		goto err;
+	p256_point_mul_window(r, k, &p);
+
+	ret = 1;
+
+ err:
+	explicit_bzero(k, sizeof(k));
+	EC_POINT_free(blinded);
+
+	return ret;
+}
+
+/*
+ * Checks whether p is the P-256 prime and a = -3, which the point doubling
+ * relies on. The values must be fully reduced.
+ */
+int
+ec_GFp_p256_curve_matches(const BIGNUM *p, const BIGNUM *a)
+{
+	BN_ULONG fp[P256_WORDS], fa[P256_WORDS], a_minus_3[P256_WORDS];
+	BN_ULONG borrow = 0;
+	int i;
+
+	if (BN_is_negative(p) || p->top > P256_WORDS)
+		return 0;
+	if (BN_is_negative(a) || a->top > P256_WORDS)
+		return 0;
+
+	for (i = 0; i < P256_WORDS; i++) {
+		fp[i] = i < p->top ? p->d[i] : 0;
+		fa[i] = i < a->top ? a->d[i] : 0;
+		bn_subw_subw(p256_p[i], i == 0 ? 3 : 0, borrow, &borrow,
+		    &a_minus_3[i]);
+	}
+
+	return memcmp(fp, p256_p, sizeof(fp)) == 0 &&
+	    memcmp(fa, a_minus_3, sizeof(fa)) == 0;
+}
+
+static int
+ec_GFp_p256_group_set_curve(EC_GROUP *group, const BIGNUM *p,
+    const BIGNUM *a, const BIGNUM *b, BN_CTX *ctx)
+{
+	if (!ec_GFp_p256_curve_matches(p, a)) {
+		ECerror(EC_R_INVALID_CURVE);
+		return 0;
+	}
+
+	return ec_GFp_simple_group_set_curve(group, p, a, b, ctx);
+}
+
+static int
+ec_GFp_p256_mul_generator_ct(const EC_GROUP *group, EC_POINT *r,
+    const BIGNUM *scalar, BN_CTX *ctx)
+{
+	struct p256_point acc;
+	int ret = 0;
+
+	if (!p256_mul_generator(group, &acc, scalar, ctx))
+		goto err;
+	if (!p256_point_to_ec_point(r, &acc))
+		goto err;
+
+	ret = 1;
+
+ err:
+	explicit_bzero(&acc, sizeof(acc));
+
+	return ret;
+}
+
+static int
+ec_GFp_p256_mul_single_ct(const EC_GROUP *group, EC_POINT *r,
+    const BIGNUM *scalar, const EC_POINT *point, BN_CTX *ctx)
+{
+	struct p256_point acc;
+	int ret = 0;
+
+	if (!p256_mul_point(group, &acc, scalar, point, ctx))
+		goto err;
+	if (!p256_point_to_ec_point(r, &acc))
+		goto err;
+
+	ret = 1;
+
+ err:
+	explicit_bzero(&acc, sizeof(acc));
+
+	return ret;
+}
+
+static int
+ec_GFp_p256_mul_double_nonct(const EC_GROUP *group, EC_POINT *r,
+    const BIGNUM *g_scalar, const BIGNUM *p_scalar, const EC_POINT *point,
+    BN_CTX *ctx)
+{
+	struct p256_point acc, t;
+
+	if (!p256_mul_generator(group, &acc, g_scalar, ctx))
+		return 0;
+	if (!p256_mul_point(group, &t, p_scalar, point, ctx))
+		return 0;
+	p256_point_add(&acc, &acc, &t);
+
+	return p256_point_to_ec_point(r, &acc);
+}
+
+static int
+ec_GFp_p256_field_mul(const EC_GROUP *group, BIGNUM *r, const BIGNUM *a,
+    const BIGNUM *b, BN_CTX *ctx)
+{
+	BN_ULONG fa[P256_WORDS], fb[P256_WORDS];
+
+	if (!p256_fe_from_bn(fa, a))
+		return 0;
+	if (!p256_fe_from_bn(fb, b))
+		return 0;
+	p256_fe_mul(fa, fa, fb);
+
+	return p256_fe_to_bn(r, fa);
+}
+
+static int
+ec_GFp_p256_field_sqr(const EC_GROUP *group, BIGNUM *r, const BIGNUM *a,
+    BN_CTX *ctx)
+{
+	BN_ULONG fa[P256_WORDS];
+
+	if (!p256_fe_from_bn(fa, a))
+		return 0;
+	p256_fe_sqr(fa, fa);
+
+	return p256_fe_to_bn(r, fa);
+}
+
+static int
+ec_GFp_p256_field_encode(const EC_GROUP *group, BIGNUM *r, const BIGNUM *a,
+    BN_CTX *ctx)
+{
+	BN_ULONG fa[P256_WORDS];
+	BIGNUM *tmp;
+	int ret = 0;
+
+	BN_CTX_start(ctx);
+
+	if ((tmp = BN_CTX_get(ctx)) == NULL)
+		goto err;
+
+	if (BN_is_negative(a) || BN_ucmp(a, &group->field) >= 0) {
+		if (!BN_nnmod(tmp, a, &group->field, ctx))
+			goto err;
+		a = tmp;
+	}
+	if (!p256_fe_from_bn(fa, a))
+		goto err;
+	p256_fe_mul(fa, fa, p256_rr);
+	if (!p256_fe_to_bn(r, fa))
+		goto err;
+
+	ret = 1;
+
+ err:
+	BN_CTX_end(ctx);
+
+	return ret;
+}
+
+static int
+ec_GFp_p256_field_decode(const EC_GROUP *group, BIGNUM *r, const BIGNUM *a,
+    BN_CTX *ctx)
+{
+	BN_ULONG fa[P256_WORDS];
+
+	if (!p256_fe_from_bn(fa, a))
+		return 0;
+	p256_fe_mul(fa, fa, p256_unit);
+
+	return p256_fe_to_bn(r, fa);
+}
+
+static int
+ec_GFp_p256_field_set_to_one(const EC_GROUP *group, BIGNUM *r, BN_CTX *ctx)
+{
+	return p256_fe_to_bn(r, p256_one);
+}
+
+static const EC_METHOD ec_GFp_p256_method = {
+	.field_type = NID_X9_62_prime_field,
+	.group_init = ec_GFp_simple_group_init,
+	.group_finish = ec_GFp_simple_group_finish,
+	.group_copy = ec_GFp_simple_group_copy,
+	.group_set_curve = ec_GFp_p256_group_set_curve,
+	.group_get_curve = ec_GFp_simple_group_get_curve,
+	.group_get_degree = ec_GFp_simple_group_get_degree,
+	.group_order_bits = ec_group_simple_order_bits,
+	.group_check_discriminant = ec_GFp_simple_group_check_discriminant,
+	.point_init = ec_GFp_simple_point_init,
+	.point_finish = ec_GFp_simple_point_finish,
+	.point_copy = ec_GFp_simple_point_copy,
+	.point_set_to_infinity = ec_GFp_simple_point_set_to_infinity,
+	.point_set_Jprojective_coordinates =
+	    ec_GFp_simple_set_Jprojective_coordinates,
+	.point_get_Jprojective_coordinates =
+	    ec_GFp_simple_get_Jprojective_coordinates,
+	.point_set_affine_coordinates =
+	    ec_GFp_simple_point_set_affine_coordinates,
+	.point_get_affine_coordinates =
+	    ec_GFp_simple_point_get_affine_coordinates,
+	.point_set_compressed_coordinates =
+	    ec_GFp_simple_set_compressed_coordinates,
+	.point2oct = ec_GFp_simple_point2oct,
+	.oct2point = ec_GFp_simple_oct2point,
+	.add = ec_GFp_simple_add,
+	.dbl = ec_GFp_simple_dbl,
+	.invert = ec_GFp_simple_invert,
+	.is_at_infinity = ec_GFp_simple_is_at_infinity,
+	.is_on_curve = ec_GFp_simple_is_on_curve,
+	.point_cmp = ec_GFp_simple_cmp,
+	.make_affine = ec_GFp_simple_make_affine,
+	.points_make_affine = ec_GFp_simple_points_make_affine,
+	.mul_generator_ct = ec_GFp_p256_mul_generator_ct,
+	.mul_single_ct = ec_GFp_p256_mul_single_ct,
+	.mul_double_nonct = ec_GFp_p256_mul_double_nonct,
+	.field_mul = ec_GFp_p256_field_mul,
+	.field_sqr = ec_GFp_p256_field_sqr,
+	.field_encode = ec_GFp_p256_field_encode,
+	.field_decode = ec_GFp_p256_field_decode,
+	.field_set_to_one = ec_GFp_p256_field_set_to_one,
+	.blind_coordinates = ec_GFp_simple_blind_coordinates,
+};
+
+const EC_METHOD *
+EC_GFp_p256_method(void)
+{
+	return &ec_GFp_p256_method;
+}
@@ -1539,6 +1539,9 @@ int
 ec_GFp_simple_mul_generator_ct(const EC_GROUP *group, EC_POINT *r,
     const BIGNUM *scalar, BN_CTX *ctx)
 {
+	if (group->comb_table != NULL)
+		return ec_GFp_comb_mul_generator_ct(group, r, scalar, ctx);
+
 	return ec_GFp_simple_mul_ct(group, r, scalar, NULL, ctx);
 }
 
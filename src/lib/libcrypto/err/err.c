@@ -286,6 +286,19 @@ static int int_err_library_number = ERR_LIB_USER;
 
 static pthread_t err_init_thread;
 
+/*
+ * With the default implementation, the error state of each thread is kept
+ * in thread specific storage, so that pushing and popping errors does not
+ * need to take CRYPTO_LOCK_ERR. The state is freed when the thread exits.
+ */
+static pthread_once_t err_state_key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t err_state_key;
+static int err_state_key_valid;
+
+static void err_state_key_init(void);
+static void err_state_key_free(void *state);
+static int err_state_local(void);
+
 /* Internal function that checks whether "err_fns" is set and if not, sets it to
  * the defaults. */
 static void
@@ -1028,13 +1041,28 @@ ERR_reason_error_string(unsigned long e)
 void
 ERR_remove_thread_state(const CRYPTO_THREADID *id)
 {
-	ERR_STATE tmp;
+	ERR_STATE tmp, *es;
 
 	if (id)
 		CRYPTO_THREADID_cpy(&tmp.tid, id);
 	else
 		CRYPTO_THREADID_current(&tmp.tid);
 	err_fns_check();
+	if (err_fns == &err_defaults && err_state_local()) {
+		/*
+		 * The state of another thread is only reachable from that
+		 * thread and is freed when it exits.
+		 */
+		if (id != NULL) {
+			CRYPTO_THREADID_current(&tmp.tid);
+			if (CRYPTO_THREADID_cmp(&tmp.tid, id) != 0)
+				return;
+		}
+		es = pthread_getspecific(err_state_key);
+		(void) pthread_setspecific(err_state_key, NULL);
+		ERR_STATE_free(es);
+		return;
+	}
 	/* thread_del_item automatically destroys the LHASH if the number of
 	 * items reaches zero. */
 	ERRFN(thread_del_item)(&tmp);
@@ -1046,31 +1074,77 @@ ERR_remove_state(unsigned long pid)
 	ERR_remove_thread_state(NULL);
 }
 
+static void
+err_state_key_free(void *state)
+{
+	ERR_STATE_free(state);
+}
+
+static void
+err_state_key_init(void)
+{
+	if (pthread_key_create(&err_state_key, err_state_key_free) == 0)
+		err_state_key_valid = 1;
+}
+
+/* Returns 1 if the error state is kept in thread specific storage. */
+static int
+err_state_local(void)
+{
+	(void) pthread_once(&err_state_key_once, err_state_key_init);
+
+	return err_state_key_valid;
+}
+
+static ERR_STATE *
+ERR_STATE_new(const CRYPTO_THREADID *tid)
+{
+	ERR_STATE *ret;
+	int i;
+
+	if ((ret = malloc(sizeof(ERR_STATE))) == NULL)
+		return NULL;
+	CRYPTO_THREADID_cpy(&ret->tid, tid);
+	ret->top = 0;
+	ret->bottom = 0;
+	for (i = 0; i < ERR_NUM_ERRORS; i++) {
+		ret->err_data[i] = NULL;
+		ret->err_data_flags[i] = 0;
+	}
+
+	return ret;
+}
+
 ERR_STATE *
 ERR_get_state(void)
 {
 	static ERR_STATE fallback;
 	ERR_STATE *ret, tmp, *tmpp = NULL;
-	int i;
 	CRYPTO_THREADID tid;
 
 	err_fns_check();
+
+	if (err_fns == &err_defaults && err_state_local()) {
+		if ((ret = pthread_getspecific(err_state_key)) != NULL)
+			return ret;
+		CRYPTO_THREADID_current(&tid);
+		if ((ret = ERR_STATE_new(&tid)) == NULL)
+			return (&fallback);
+		if (pthread_setspecific(err_state_key, ret) != 0) {
+			ERR_STATE_free(ret);
+			return (&fallback);
+		}
+		return ret;
+	}
+
 	CRYPTO_THREADID_current(&tid);
 	CRYPTO_THREADID_cpy(&tmp.tid, &tid);
 	ret = ERRFN(thread_get_item)(&tmp);
 
 	/* ret == the error state, if NULL, make a new one */
 	if (ret == NULL) {
-		ret = malloc(sizeof(ERR_STATE));
-		if (ret == NULL)
+		if ((ret = ERR_STATE_new(&tid)) == NULL)
 			return (&fallback);
-		CRYPTO_THREADID_cpy(&ret->tid, &tid);
-		ret->top = 0;
-		ret->bottom = 0;
-		for (i = 0; i < ERR_NUM_ERRORS; i++) {
-			ret->err_data[i] = NULL;
-			ret->err_data_flags[i] = 0;
-		}
 		tmpp = ERRFN(thread_set_item)(ret);
 		/* To check if insertion failed, do a get. */
 		if (ERRFN(thread_get_item)(ret) != ret) {
@@ -49,6 +49,8 @@
  *
  */
 
+#include <sys/uio.h>
+
 #include <limits.h>
 #include <stdlib.h>
 #include <string.h>
@@ -2288,14 +2290,16 @@ aead_aes_gcm_cleanup(EVP_AEAD_CTX *ctx)
 }
 
 static int
-aead_aes_gcm_seal(const EVP_AEAD_CTX *ctx, unsigned char *out, size_t *out_len,
-    size_t max_out_len, const unsigned char *nonce, size_t nonce_len,
-    const unsigned char *in, size_t in_len, const unsigned char *ad,
-    size_t ad_len)
+aead_aes_gcm_seal_iov(const EVP_AEAD_CTX *ctx, unsigned char *out,
+    size_t *out_len, size_t max_out_len, const unsigned char *nonce,
+    size_t nonce_len, const struct iovec *iov, int iovcnt, size_t in_len,
+    const unsigned char *ad, size_t ad_len)
 {
 	const struct aead_aes_gcm_ctx *gcm_ctx = ctx->aead_state;
+	const unsigned char *in;
 	GCM128_CONTEXT gcm;
-	size_t bulk = 0;
+	size_t len;
+	int i;
 
 	if (max_out_len < in_len + gcm_ctx->tag_len) {
 		EVPerror(EVP_R_BUFFER_TOO_SMALL);
@@ -2313,33 +2317,56 @@ aead_aes_gcm_seal(const EVP_AEAD_CTX *ctx, unsigned char *out, size_t *out_len,
 	if (ad_len > 0 && CRYPTO_gcm128_aad(&gcm, ad, ad_len))
 		return 0;
 
-	if (gcm_ctx->ctr) {
-		if (CRYPTO_gcm128_encrypt_ctr32(&gcm, in + bulk, out + bulk,
-		    in_len - bulk, gcm_ctx->ctr))
-			return 0;
-	} else {
-		if (CRYPTO_gcm128_encrypt(&gcm, in + bulk, out + bulk,
-		    in_len - bulk))
-			return 0;
+	/* GCM is a stream mode, hence segments may be of any length. */
+	for (i = 0; i < iovcnt; i++) {
+		in = iov[i].iov_base;
+		len = iov[i].iov_len;
+
+		if (gcm_ctx->ctr) {
+			if (CRYPTO_gcm128_encrypt_ctr32(&gcm, in, out, len,
+			    gcm_ctx->ctr))
+				return 0;
+		} else {
+			if (CRYPTO_gcm128_encrypt(&gcm, in, out, len))
+				return 0;
+		}
+		out += len;
 	}
 
-	CRYPTO_gcm128_tag(&gcm, out + in_len, gcm_ctx->tag_len);
+	CRYPTO_gcm128_tag(&gcm, out, gcm_ctx->tag_len);
 	*out_len = in_len + gcm_ctx->tag_len;
 
 	return 1;
 }
 
 static int
-aead_aes_gcm_open(const EVP_AEAD_CTX *ctx, unsigned char *out, size_t *out_len,
+aead_aes_gcm_seal(const EVP_AEAD_CTX *ctx, unsigned char *out, size_t *out_len,
     size_t max_out_len, const unsigned char *nonce, size_t nonce_len,
     const unsigned char *in, size_t in_len, const unsigned char *ad,
     size_t ad_len)
+{
+	struct iovec iov;
+
+	iov.iov_base = (void *)in;
+	iov.iov_len = in_len;
+
+	return aead_aes_gcm_seal_iov(ctx, out, out_len, max_out_len, nonce,
+	    nonce_len, &iov, 1, in_len, ad, ad_len);
+}
+
+static int
+aead_aes_gcm_open_iov(const EVP_AEAD_CTX *ctx, unsigned char *out,
+    size_t *out_len, size_t max_out_len, const unsigned char *nonce,
+    size_t nonce_len, const struct iovec *iov, int iovcnt, size_t in_len,
+    const unsigned char *ad, size_t ad_len)
 {
 	const struct aead_aes_gcm_ctx *gcm_ctx = ctx->aead_state;
+	unsigned char in_tag[EVP_AEAD_AES_GCM_TAG_LEN];
 	unsigned char tag[EVP_AEAD_AES_GCM_TAG_LEN];
+	size_t plaintext_len, remaining, tag_off, len, n;
+	const unsigned char *in;
 	GCM128_CONTEXT gcm;
-	size_t plaintext_len;
-	size_t bulk = 0;
+	int i;
 
 	if (in_len < gcm_ctx->tag_len) {
 		EVPerror(EVP_R_BAD_DECRYPT);
@@ -2364,18 +2391,41 @@ aead_aes_gcm_open(const EVP_AEAD_CTX *ctx, unsigned char *out, size_t *out_len,
 	if (CRYPTO_gcm128_aad(&gcm, ad, ad_len))
 		return 0;
 
-	if (gcm_ctx->ctr) {
-		if (CRYPTO_gcm128_decrypt_ctr32(&gcm, in + bulk, out + bulk,
-		    in_len - bulk - gcm_ctx->tag_len, gcm_ctx->ctr))
-			return 0;
-	} else {
-		if (CRYPTO_gcm128_decrypt(&gcm, in + bulk, out + bulk,
-		    in_len - bulk - gcm_ctx->tag_len))
+	/*
+	 * Decrypt the ciphertext from each segment - the tag follows the
+	 * ciphertext and may itself be split across segments.
+	 */
+	remaining = plaintext_len;
+	tag_off = 0;
+	for (i = 0; i < iovcnt; i++) {
+		in = iov[i].iov_base;
+		len = iov[i].iov_len;
+
+		if ((n = len) > remaining)
+			n = remaining;
+		if (gcm_ctx->ctr) {
+			if (CRYPTO_gcm128_decrypt_ctr32(&gcm, in, out, n,
+			    gcm_ctx->ctr))
+				return 0;
+		} else {
+			if (CRYPTO_gcm128_decrypt(&gcm, in, out, n))
+				return 0;
+		}
+		out += n;
+		remaining -= n;
+
+		if ((len -= n) == 0)
+			continue;
+		if (len > gcm_ctx->tag_len - tag_off)
 			return 0;
+		memcpy(&in_tag[tag_off], in + n, len);
+		tag_off += len;
 	}
+	if (remaining != 0 || tag_off != gcm_ctx->tag_len)
+		return 0;
 
 	CRYPTO_gcm128_tag(&gcm, tag, gcm_ctx->tag_len);
-	if (timingsafe_memcmp(tag, in + plaintext_len, gcm_ctx->tag_len) != 0) {
+	if (timingsafe_memcmp(tag, in_tag, gcm_ctx->tag_len) != 0) {
 		EVPerror(EVP_R_BAD_DECRYPT);
 		return 0;
 	}
@@ -2385,6 +2435,21 @@ aead_aes_gcm_open(const EVP_AEAD_CTX *ctx, unsigned char *out, size_t *out_len,
 	return 1;
 }
 
+static int
+aead_aes_gcm_open(const EVP_AEAD_CTX *ctx, unsigned char *out, size_t *out_len,
+    size_t max_out_len, const unsigned char *nonce, size_t nonce_len,
+    const unsigned char *in, size_t in_len, const unsigned char *ad,
+    size_t ad_len)
+{
+	struct iovec iov;
+
+	iov.iov_base = (void *)in;
+	iov.iov_len = in_len;
+
+	return aead_aes_gcm_open_iov(ctx, out, out_len, max_out_len, nonce,
+	    nonce_len, &iov, 1, in_len, ad, ad_len);
+}
+
 static const EVP_AEAD aead_aes_128_gcm = {
 	.key_len = 16,
 	.nonce_len = 12,
@@ -2395,6 +2460,8 @@ static const EVP_AEAD aead_aes_128_gcm = {
 	.cleanup = aead_aes_gcm_cleanup,
 	.seal = aead_aes_gcm_seal,
 	.open = aead_aes_gcm_open,
+	.seal_iov = aead_aes_gcm_seal_iov,
+	.open_iov = aead_aes_gcm_open_iov,
 };
 
 static const EVP_AEAD aead_aes_256_gcm = {
@@ -2407,6 +2474,8 @@ static const EVP_AEAD aead_aes_256_gcm = {
 	.cleanup = aead_aes_gcm_cleanup,
 	.seal = aead_aes_gcm_seal,
 	.open = aead_aes_gcm_open,
+	.seal_iov = aead_aes_gcm_seal_iov,
+	.open_iov = aead_aes_gcm_open_iov,
 };
 
 const EVP_AEAD *
@@ -18,6 +18,8 @@
  * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  */
 
+#include <sys/uio.h>
+
 #include <stdint.h>
 #include <string.h>
 
@@ -40,6 +42,12 @@
 #define CHACHA20_NONCE_LEN (CHACHA20_CONSTANT_LEN + CHACHA20_IV_LEN)
 #define XCHACHA20_NONCE_LEN 24
 
+/*
+ * Records are encrypted and authenticated in chunks of this size, so that
+ * the data is still in the L1 cache for the second pass.
+ */
+#define CHACHA20_POLY1305_CHUNK_LEN 4096
+
 struct aead_chacha20_poly1305_ctx {
 	unsigned char key[32];
 	unsigned char tag_len;
@@ -121,15 +129,175 @@ poly1305_update_with_pad16(poly1305_state *poly1305,
 	poly1305_pad16(poly1305, data_len);
 }
 
+static void
+chacha20_poly1305_counter(unsigned char counter[8], uint64_t ctr)
+{
+	int i;
+
+	for (i = 0; i < 8; i++) {
+		counter[i] = ctr & 0xff;
+		ctr >>= 8;
+	}
+}
+
+/*
+ * Encrypt and authenticate the input segments, using the given key and IV,
+ * with the Poly1305 key being derived from the ChaCha20 block at ctr and the
+ * payload being encrypted from ctr + 1 onwards.
+ */
+static void
+chacha20_poly1305_seal_iov(const struct aead_chacha20_poly1305_ctx *c20_ctx,
+    const unsigned char *key, const unsigned char *iv, uint64_t ctr,
+    unsigned char *out, size_t *out_len, const struct iovec *iov, int iovcnt,
+    size_t in_len, const unsigned char *ad, size_t ad_len)
+{
+	unsigned char poly1305_key[32];
+	unsigned char counter[8];
+	const unsigned char *in;
+	poly1305_state poly1305;
+	ChaCha_ctx chacha;
+	size_t len, n;
+	int i;
+
+	memset(poly1305_key, 0, sizeof(poly1305_key));
+	CRYPTO_chacha_20(poly1305_key, poly1305_key,
+	    sizeof(poly1305_key), key, iv, ctr);
+
+	CRYPTO_poly1305_init(&poly1305, poly1305_key);
+	poly1305_update_with_pad16(&poly1305, ad, ad_len);
+
+	/* The ChaCha context carries partial blocks across segments. */
+	chacha20_poly1305_counter(counter, ctr + 1);
+	ChaCha_set_key(&chacha, key, 256);
+	ChaCha_set_iv(&chacha, iv, counter);
+
+	for (i = 0; i < iovcnt; i++) {
+		in = iov[i].iov_base;
+		len = iov[i].iov_len;
+		while (len > 0) {
+			if ((n = len) > CHACHA20_POLY1305_CHUNK_LEN)
+				n = CHACHA20_POLY1305_CHUNK_LEN;
+			ChaCha(&chacha, out, in, n);
+			CRYPTO_poly1305_update(&poly1305, out, n);
+			in += n;
+			out += n;
+			len -= n;
+		}
+	}
+	poly1305_pad16(&poly1305, in_len);
+	poly1305_update_with_length(&poly1305, NULL, ad_len);
+	poly1305_update_with_length(&poly1305, NULL, in_len);
+
+	explicit_bzero(&chacha, sizeof(chacha));
+
+	if (c20_ctx->tag_len != POLY1305_TAG_LEN) {
+		unsigned char tag[POLY1305_TAG_LEN];
+		CRYPTO_poly1305_finish(&poly1305, tag);
+		memcpy(out, tag, c20_ctx->tag_len);
+		*out_len = in_len + c20_ctx->tag_len;
+		return;
+	}
+
+	CRYPTO_poly1305_finish(&poly1305, out);
+	*out_len = in_len + POLY1305_TAG_LEN;
+}
+
+/*
+ * Authenticate and decrypt the input segments. The tag follows the
+ * ciphertext and may itself be split across segments. If the tag is not
+ * valid, the output is cleared.
+ */
 static int
-aead_chacha20_poly1305_seal(const EVP_AEAD_CTX *ctx, unsigned char *out,
+chacha20_poly1305_open_iov(const struct aead_chacha20_poly1305_ctx *c20_ctx,
+    const unsigned char *key, const unsigned char *iv, uint64_t ctr,
+    unsigned char *out, size_t *out_len, const struct iovec *iov, int iovcnt,
+    size_t in_len, const unsigned char *ad, size_t ad_len)
+{
+	unsigned char mac[POLY1305_TAG_LEN];
+	unsigned char tag[POLY1305_TAG_LEN];
+	unsigned char poly1305_key[32];
+	size_t plaintext_len, remaining, tag_off, len, n;
+	const unsigned char *in;
+	unsigned char *p = out;
+	unsigned char counter[8];
+	poly1305_state poly1305;
+	ChaCha_ctx chacha;
+	int ret = 0;
+	int i;
+
+	plaintext_len = in_len - c20_ctx->tag_len;
+
+	memset(poly1305_key, 0, sizeof(poly1305_key));
+	CRYPTO_chacha_20(poly1305_key, poly1305_key,
+	    sizeof(poly1305_key), key, iv, ctr);
+
+	CRYPTO_poly1305_init(&poly1305, poly1305_key);
+	poly1305_update_with_pad16(&poly1305, ad, ad_len);
+
+	chacha20_poly1305_counter(counter, ctr + 1);
+	ChaCha_set_key(&chacha, key, 256);
+	ChaCha_set_iv(&chacha, iv, counter);
+
+	remaining = plaintext_len;
+	tag_off = 0;
+	for (i = 0; i < iovcnt; i++) {
+		in = iov[i].iov_base;
+		len = iov[i].iov_len;
+
+		/* Authenticate each chunk before it may be overwritten. */
+		while (len > 0 && remaining > 0) {
+			if ((n = len) > remaining)
+				n = remaining;
+			if (n > CHACHA20_POLY1305_CHUNK_LEN)
+				n = CHACHA20_POLY1305_CHUNK_LEN;
+			CRYPTO_poly1305_update(&poly1305, in, n);
+			ChaCha(&chacha, p, in, n);
+			in += n;
+			p += n;
+			len -= n;
+			remaining -= n;
+		}
+
+		if (len == 0)
+			continue;
+		if (len > c20_ctx->tag_len - tag_off)
+			goto err;
+		memcpy(&tag[tag_off], in, len);
+		tag_off += len;
+	}
+	if (remaining != 0 || tag_off != c20_ctx->tag_len)
+		goto err;
+
+	poly1305_pad16(&poly1305, plaintext_len);
+	poly1305_update_with_length(&poly1305, NULL, ad_len);
+	poly1305_update_with_length(&poly1305, NULL, plaintext_len);
+
+	CRYPTO_poly1305_finish(&poly1305, mac);
+
+	if (timingsafe_memcmp(mac, tag, c20_ctx->tag_len) != 0) {
+		EVPerror(EVP_R_BAD_DECRYPT);
+		goto err;
+	}
+
+	*out_len = plaintext_len;
+
+	ret = 1;
+
+ err:
+	if (!ret)
+		explicit_bzero(out, p - out);
+	explicit_bzero(&chacha, sizeof(chacha));
+
+	return ret;
+}
+
+static int
+aead_chacha20_poly1305_seal_iov(const EVP_AEAD_CTX *ctx, unsigned char *out,
     size_t *out_len, size_t max_out_len, const unsigned char *nonce,
-    size_t nonce_len, const unsigned char *in, size_t in_len,
+    size_t nonce_len, const struct iovec *iov, int iovcnt, size_t in_len,
     const unsigned char *ad, size_t ad_len)
 {
 	const struct aead_chacha20_poly1305_ctx *c20_ctx = ctx->aead_state;
-	unsigned char poly1305_key[32];
-	poly1305_state poly1305;
 	const unsigned char *iv;
 	uint64_t ctr;
 
@@ -147,43 +315,36 @@ aead_chacha20_poly1305_seal(const EVP_AEAD_CTX *ctx, unsigned char *out,
 	    (uint32_t)(nonce[2]) << 16 | (uint32_t)(nonce[3]) << 24) << 32;
 	iv = nonce + CHACHA20_CONSTANT_LEN;
 
-	memset(poly1305_key, 0, sizeof(poly1305_key));
-	CRYPTO_chacha_20(poly1305_key, poly1305_key,
-	    sizeof(poly1305_key), c20_ctx->key, iv, ctr);
-
-	CRYPTO_poly1305_init(&poly1305, poly1305_key);
-	poly1305_update_with_pad16(&poly1305, ad, ad_len);
-	CRYPTO_chacha_20(out, in, in_len, c20_ctx->key, iv, ctr + 1);
-	poly1305_update_with_pad16(&poly1305, out, in_len);
-	poly1305_update_with_length(&poly1305, NULL, ad_len);
-	poly1305_update_with_length(&poly1305, NULL, in_len);
-
-	if (c20_ctx->tag_len != POLY1305_TAG_LEN) {
-		unsigned char tag[POLY1305_TAG_LEN];
-		CRYPTO_poly1305_finish(&poly1305, tag);
-		memcpy(out + in_len, tag, c20_ctx->tag_len);
-		*out_len = in_len + c20_ctx->tag_len;
-		return 1;
-	}
+	chacha20_poly1305_seal_iov(c20_ctx, c20_ctx->key, iv, ctr, out,
+	    out_len, iov, iovcnt, in_len, ad, ad_len);
 
-	CRYPTO_poly1305_finish(&poly1305, out + in_len);
-	*out_len = in_len + POLY1305_TAG_LEN;
 	return 1;
 }
 
 static int
-aead_chacha20_poly1305_open(const EVP_AEAD_CTX *ctx, unsigned char *out,
+aead_chacha20_poly1305_seal(const EVP_AEAD_CTX *ctx, unsigned char *out,
     size_t *out_len, size_t max_out_len, const unsigned char *nonce,
     size_t nonce_len, const unsigned char *in, size_t in_len,
     const unsigned char *ad, size_t ad_len)
+{
+	struct iovec iov;
+
+	iov.iov_base = (void *)in;
+	iov.iov_len = in_len;
+
+	return aead_chacha20_poly1305_seal_iov(ctx, out, out_len, max_out_len,
+	    nonce, nonce_len, &iov, 1, in_len, ad, ad_len);
+}
+
+static int
+aead_chacha20_poly1305_open_iov(const EVP_AEAD_CTX *ctx, unsigned char *out,
+    size_t *out_len, size_t max_out_len, const unsigned char *nonce,
+    size_t nonce_len, const struct iovec *iov, int iovcnt, size_t in_len,
+    const unsigned char *ad, size_t ad_len)
 {
 	const struct aead_chacha20_poly1305_ctx *c20_ctx = ctx->aead_state;
-	unsigned char mac[POLY1305_TAG_LEN];
-	unsigned char poly1305_key[32];
-	const unsigned char *iv = nonce;
-	poly1305_state poly1305;
-	size_t plaintext_len;
-	uint64_t ctr = 0;
+	const unsigned char *iv;
+	uint64_t ctr;
 
 	if (in_len < c20_ctx->tag_len) {
 		EVPerror(EVP_R_BAD_DECRYPT);
@@ -195,9 +356,7 @@ aead_chacha20_poly1305_open(const EVP_AEAD_CTX *ctx, unsigned char *out,
 		return 0;
 	}
 
-	plaintext_len = in_len - c20_ctx->tag_len;
-
-	if (max_out_len < plaintext_len) {
+	if (max_out_len < in_len - c20_ctx->tag_len) {
 		EVPerror(EVP_R_BUFFER_TOO_SMALL);
 		return 0;
 	}
@@ -206,38 +365,33 @@ aead_chacha20_poly1305_open(const EVP_AEAD_CTX *ctx, unsigned char *out,
 	    (uint32_t)(nonce[2]) << 16 | (uint32_t)(nonce[3]) << 24) << 32;
 	iv = nonce + CHACHA20_CONSTANT_LEN;
 
-	memset(poly1305_key, 0, sizeof(poly1305_key));
-	CRYPTO_chacha_20(poly1305_key, poly1305_key,
-	    sizeof(poly1305_key), c20_ctx->key, iv, ctr);
-
-	CRYPTO_poly1305_init(&poly1305, poly1305_key);
-	poly1305_update_with_pad16(&poly1305, ad, ad_len);
-	poly1305_update_with_pad16(&poly1305, in, plaintext_len);
-	poly1305_update_with_length(&poly1305, NULL, ad_len);
-	poly1305_update_with_length(&poly1305, NULL, plaintext_len);
+	return chacha20_poly1305_open_iov(c20_ctx, c20_ctx->key, iv, ctr, out,
+	    out_len, iov, iovcnt, in_len, ad, ad_len);
+}
 
-	CRYPTO_poly1305_finish(&poly1305, mac);
+static int
+aead_chacha20_poly1305_open(const EVP_AEAD_CTX *ctx, unsigned char *out,
+    size_t *out_len, size_t max_out_len, const unsigned char *nonce,
+    size_t nonce_len, const unsigned char *in, size_t in_len,
+    const unsigned char *ad, size_t ad_len)
+{
+	struct iovec iov;
 
-	if (timingsafe_memcmp(mac, in + plaintext_len, c20_ctx->tag_len) != 0) {
-		EVPerror(EVP_R_BAD_DECRYPT);
-		return 0;
-	}
+	iov.iov_base = (void *)in;
+	iov.iov_len = in_len;
 
-	CRYPTO_chacha_20(out, in, plaintext_len, c20_ctx->key, iv, ctr + 1);
-	*out_len = plaintext_len;
-	return 1;
+	return aead_chacha20_poly1305_open_iov(ctx, out, out_len, max_out_len,
+	    nonce, nonce_len, &iov, 1, in_len, ad, ad_len);
 }
 
 static int
-aead_xchacha20_poly1305_seal(const EVP_AEAD_CTX *ctx, unsigned char *out,
+aead_xchacha20_poly1305_seal_iov(const EVP_AEAD_CTX *ctx, unsigned char *out,
     size_t *out_len, size_t max_out_len, const unsigned char *nonce,
-    size_t nonce_len, const unsigned char *in, size_t in_len,
+    size_t nonce_len, const struct iovec *iov, int iovcnt, size_t in_len,
     const unsigned char *ad, size_t ad_len)
 {
 	const struct aead_chacha20_poly1305_ctx *c20_ctx = ctx->aead_state;
-	unsigned char poly1305_key[32];
 	unsigned char subkey[32];
-	poly1305_state poly1305;
 
 	if (max_out_len < in_len + c20_ctx->tag_len) {
 		EVPerror(EVP_R_BUFFER_TOO_SMALL);
@@ -251,43 +405,38 @@ aead_xchacha20_poly1305_seal(const EVP_AEAD_CTX *ctx, unsigned char *out,
 
 	CRYPTO_hchacha_20(subkey, c20_ctx->key, nonce);
 
-	CRYPTO_chacha_20(out, in, in_len, subkey, nonce + 16, 1);
+	chacha20_poly1305_seal_iov(c20_ctx, subkey, nonce + 16, 0, out,
+	    out_len, iov, iovcnt, in_len, ad, ad_len);
 
-	memset(poly1305_key, 0, sizeof(poly1305_key));
-	CRYPTO_chacha_20(poly1305_key, poly1305_key, sizeof(poly1305_key),
-	    subkey, nonce + 16, 0);
+	explicit_bzero(subkey, sizeof(subkey));
 
-	CRYPTO_poly1305_init(&poly1305, poly1305_key);
-	poly1305_update_with_pad16(&poly1305, ad, ad_len);
-	poly1305_update_with_pad16(&poly1305, out, in_len);
-	poly1305_update_with_length(&poly1305, NULL, ad_len);
-	poly1305_update_with_length(&poly1305, NULL, in_len);
-
-	if (c20_ctx->tag_len != POLY1305_TAG_LEN) {
-		unsigned char tag[POLY1305_TAG_LEN];
-		CRYPTO_poly1305_finish(&poly1305, tag);
-		memcpy(out + in_len, tag, c20_ctx->tag_len);
-		*out_len = in_len + c20_ctx->tag_len;
-		return 1;
-	}
-
-	CRYPTO_poly1305_finish(&poly1305, out + in_len);
-	*out_len = in_len + POLY1305_TAG_LEN;
 	return 1;
 }
 
 static int
-aead_xchacha20_poly1305_open(const EVP_AEAD_CTX *ctx, unsigned char *out,
+aead_xchacha20_poly1305_seal(const EVP_AEAD_CTX *ctx, unsigned char *out,
     size_t *out_len, size_t max_out_len, const unsigned char *nonce,
     size_t nonce_len, const unsigned char *in, size_t in_len,
     const unsigned char *ad, size_t ad_len)
+{
+	struct iovec iov;
+
+	iov.iov_base = (void *)in;
+	iov.iov_len = in_len;
+
+	return aead_xchacha20_poly1305_seal_iov(ctx, out, out_len, max_out_len,
+	    nonce, nonce_len, &iov, 1, in_len, ad, ad_len);
+}
+
+static int
+aead_xchacha20_poly1305_open_iov(const EVP_AEAD_CTX *ctx, unsigned char *out,
+    size_t *out_len, size_t max_out_len, const unsigned char *nonce,
+    size_t nonce_len, const struct iovec *iov, int iovcnt, size_t in_len,
+    const unsigned char *ad, size_t ad_len)
 {
 	const struct aead_chacha20_poly1305_ctx *c20_ctx = ctx->aead_state;
-	unsigned char mac[POLY1305_TAG_LEN];
-	unsigned char poly1305_key[32];
 	unsigned char subkey[32];
-	poly1305_state poly1305;
-	size_t plaintext_len;
+	int ret;
 
 	if (in_len < c20_ctx->tag_len) {
 		EVPerror(EVP_R_BAD_DECRYPT);
@@ -299,35 +448,34 @@ aead_xchacha20_poly1305_open(const EVP_AEAD_CTX *ctx, unsigned char *out,
 		return 0;
 	}
 
-	plaintext_len = in_len - c20_ctx->tag_len;
-
-	if (max_out_len < plaintext_len) {
+	if (max_out_len < in_len - c20_ctx->tag_len) {
 		EVPerror(EVP_R_BUFFER_TOO_SMALL);
 		return 0;
 	}
 
 	CRYPTO_hchacha_20(subkey, c20_ctx->key, nonce);
 
-	memset(poly1305_key, 0, sizeof(poly1305_key));
-	CRYPTO_chacha_20(poly1305_key, poly1305_key, sizeof(poly1305_key),
-	    subkey, nonce + 16, 0);
+	ret = chacha20_poly1305_open_iov(c20_ctx, subkey, nonce + 16, 0, out,
+	    out_len, iov, iovcnt, in_len, ad, ad_len);
 
-	CRYPTO_poly1305_init(&poly1305, poly1305_key);
-	poly1305_update_with_pad16(&poly1305, ad, ad_len);
-	poly1305_update_with_pad16(&poly1305, in, plaintext_len);
-	poly1305_update_with_length(&poly1305, NULL, ad_len);
-	poly1305_update_with_length(&poly1305, NULL, plaintext_len);
+	explicit_bzero(subkey, sizeof(subkey));
 
-	CRYPTO_poly1305_finish(&poly1305, mac);
-	if (timingsafe_memcmp(mac, in + plaintext_len, c20_ctx->tag_len) != 0) {
-		EVPerror(EVP_R_BAD_DECRYPT);
-		return 0;
-	}
+	return ret;
+}
 
-	CRYPTO_chacha_20(out, in, plaintext_len, subkey, nonce + 16, 1);
+static int
+aead_xchacha20_poly1305_open(const EVP_AEAD_CTX *ctx, unsigned char *out,
+    size_t *out_len, size_t max_out_len, const unsigned char *nonce,
+    size_t nonce_len, const unsigned char *in, size_t in_len,
+    const unsigned char *ad, size_t ad_len)
+{
+	struct iovec iov;
 
-	*out_len = plaintext_len;
-	return 1;
+	iov.iov_base = (void *)in;
+	iov.iov_len = in_len;
+
+	return aead_xchacha20_poly1305_open_iov(ctx, out, out_len, max_out_len,
+	    nonce, nonce_len, &iov, 1, in_len, ad, ad_len);
 }
 
 /* RFC 7539 */
@@ -341,6 +489,8 @@ static const EVP_AEAD aead_chacha20_poly1305 = {
 	.cleanup = aead_chacha20_poly1305_cleanup,
 	.seal = aead_chacha20_poly1305_seal,
 	.open = aead_chacha20_poly1305_open,
+	.seal_iov = aead_chacha20_poly1305_seal_iov,
+	.open_iov = aead_chacha20_poly1305_open_iov,
 };
 
 const EVP_AEAD *
@@ -359,6 +509,8 @@ static const EVP_AEAD aead_xchacha20_poly1305 = {
 	.cleanup = aead_chacha20_poly1305_cleanup,
 	.seal = aead_xchacha20_poly1305_seal,
 	.open = aead_xchacha20_poly1305_open,
+	.seal_iov = aead_xchacha20_poly1305_seal_iov,
+	.open_iov = aead_xchacha20_poly1305_open_iov,
 };
 
 const EVP_AEAD *
@@ -1318,6 +1318,31 @@ int EVP_AEAD_CTX_open(const EVP_AEAD_CTX *ctx, unsigned char *out,
     size_t nonce_len, const unsigned char *in, size_t in_len,
     const unsigned char *ad, size_t ad_len);
 
+#if defined(LIBRESSL_INTERNAL)
+struct iovec;
+
+/* EVP_AEAD_CTX_seal_iov is the same as EVP_AEAD_CTX_seal, except that the
+ * input is provided as an array of iovcnt iovecs, which are treated as if
+ * they had been concatenated. The output is written contiguously to out.
+ *
+ * Each input segment may be aliased with the output at the same offset,
+ * however the output must not otherwise overlap any of the input segments. */
+int EVP_AEAD_CTX_seal_iov(const EVP_AEAD_CTX *ctx, unsigned char *out,
+    size_t *out_len, size_t max_out_len, const unsigned char *nonce,
+    size_t nonce_len, const struct iovec *iov, int iovcnt,
+    const unsigned char *ad, size_t ad_len);
+
+/* EVP_AEAD_CTX_open_iov is the same as EVP_AEAD_CTX_open, except that the
+ * input (including the authentication tag) is provided as an array of iovcnt
+ * iovecs, which are treated as if they had been concatenated. The output is
+ * written contiguously to out and the same aliasing rules apply as for
+ * EVP_AEAD_CTX_seal_iov. */
+int EVP_AEAD_CTX_open_iov(const EVP_AEAD_CTX *ctx, unsigned char *out,
+    size_t *out_len, size_t max_out_len, const unsigned char *nonce,
+    size_t nonce_len, const struct iovec *iov, int iovcnt,
+    const unsigned char *ad, size_t ad_len);
+#endif
+
 void EVP_add_alg_module(void);
 
 void ERR_load_EVP_strings(void);
@@ -15,7 +15,10 @@
  * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  */
 
+#include <sys/uio.h>
+
 #include <limits.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include <openssl/evp.h>
@@ -158,3 +161,168 @@ error:
 	*out_len = 0;
 	return 0;
 }
+
+/*
+ * Compute the total length of an iovec array, ensuring that it does not
+ * overflow.
+ */
+static int
+evp_aead_iov_len(const struct iovec *iov, int iovcnt, size_t *out_len)
+{
+	size_t len = 0;
+	int i;
+
+	*out_len = 0;
+
+	if (iovcnt < 0 || iovcnt > IOV_MAX)
+		return 0;
+	if (iovcnt > 0 && iov == NULL)
+		return 0;
+
+	for (i = 0; i < iovcnt; i++) {
+		if (SIZE_MAX - len < iov[i].iov_len)
+			return 0;
+		len += iov[i].iov_len;
+	}
+
+	*out_len = len;
+
+	return 1;
+}
+
+/*
+ * check_alias_iov applies check_alias to each input segment, against the
+ * position in the output that the segment will be written to.
+ */
+static int
+check_alias_iov(const struct iovec *iov, int iovcnt, const unsigned char *out)
+{
+	int i;
+
+	for (i = 0; i < iovcnt; i++) {
+		if (!check_alias(iov[i].iov_base, iov[i].iov_len, out))
+			return 0;
+		out += iov[i].iov_len;
+	}
+
+	return 1;
+}
+
+/*
+ * Linearise the input iovecs, for AEADs that lack native scatter/gather
+ * support.
+ */
+static int
+evp_aead_iov_concat(const struct iovec *iov, int iovcnt, size_t in_len,
+    unsigned char **out)
+{
+	unsigned char *data;
+	size_t offset = 0;
+	int i;
+
+	*out = NULL;
+
+	if ((data = malloc(in_len > 0 ? in_len : 1)) == NULL)
+		return 0;
+	for (i = 0; i < iovcnt; i++) {
+		memcpy(data + offset, iov[i].iov_base, iov[i].iov_len);
+		offset += iov[i].iov_len;
+	}
+
+	*out = data;
+
+	return 1;
+}
+
+int
+EVP_AEAD_CTX_seal_iov(const EVP_AEAD_CTX *ctx, unsigned char *out,
+    size_t *out_len, size_t max_out_len, const unsigned char *nonce,
+    size_t nonce_len, const struct iovec *iov, int iovcnt,
+    const unsigned char *ad, size_t ad_len)
+{
+	unsigned char *in = NULL;
+	size_t in_len;
+	int ret = 0;
+
+	if (!evp_aead_iov_len(iov, iovcnt, &in_len)) {
+		EVPerror(EVP_R_TOO_LARGE);
+		goto error;
+	}
+
+	/* Overflow. */
+	if (in_len + ctx->aead->overhead < in_len) {
+		EVPerror(EVP_R_TOO_LARGE);
+		goto error;
+	}
+
+	if (!check_alias_iov(iov, iovcnt, out)) {
+		EVPerror(EVP_R_OUTPUT_ALIASES_INPUT);
+		goto error;
+	}
+
+	if (ctx->aead->seal_iov != NULL) {
+		if (ctx->aead->seal_iov(ctx, out, out_len, max_out_len, nonce,
+		    nonce_len, iov, iovcnt, in_len, ad, ad_len))
+			return 1;
+		goto error;
+	}
+
+	if (!evp_aead_iov_concat(iov, iovcnt, in_len, &in))
+		goto error;
+	ret = EVP_AEAD_CTX_seal(ctx, out, out_len, max_out_len, nonce,
+	    nonce_len, in, in_len, ad, ad_len);
+	freezero(in, in_len);
+
+	return ret;
+
+ error:
+	/* In the event of an error, clear the output buffer so that a caller
+	 * that doesn't check the return value doesn't send raw data. */
+	memset(out, 0, max_out_len);
+	*out_len = 0;
+	return 0;
+}
+
+int
+EVP_AEAD_CTX_open_iov(const EVP_AEAD_CTX *ctx, unsigned char *out,
+    size_t *out_len, size_t max_out_len, const unsigned char *nonce,
+    size_t nonce_len, const struct iovec *iov, int iovcnt,
+    const unsigned char *ad, size_t ad_len)
+{
+	unsigned char *in = NULL;
+	size_t in_len;
+	int ret = 0;
+
+	if (!evp_aead_iov_len(iov, iovcnt, &in_len)) {
+		EVPerror(EVP_R_TOO_LARGE);
+		goto error;
+	}
+
+	if (!check_alias_iov(iov, iovcnt, out)) {
+		EVPerror(EVP_R_OUTPUT_ALIASES_INPUT);
+		goto error;
+	}
+
+	if (ctx->aead->open_iov != NULL) {
+		if (ctx->aead->open_iov(ctx, out, out_len, max_out_len, nonce,
+		    nonce_len, iov, iovcnt, in_len, ad, ad_len))
+			return 1;
+		goto error;
+	}
+
+	if (!evp_aead_iov_concat(iov, iovcnt, in_len, &in))
+		goto error;
+	ret = EVP_AEAD_CTX_open(ctx, out, out_len, max_out_len, nonce,
+	    nonce_len, in, in_len, ad, ad_len);
+	freezero(in, in_len);
+
+	return ret;
+
+ error:
+	/* In the event of an error, clear the output buffer so that a caller
+	 * that doesn't check the return value doesn't try and process bad
+	 * data. */
+	memset(out, 0, max_out_len);
+	*out_len = 0;
+	return 0;
+}
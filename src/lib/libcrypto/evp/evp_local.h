@@ -305,6 +305,20 @@ struct evp_aead_st {
 	    size_t *out_len, size_t max_out_len, const unsigned char *nonce,
 	    size_t nonce_len, const unsigned char *in, size_t in_len,
 	    const unsigned char *ad, size_t ad_len);
+
+	/*
+	 * Optional scatter/gather versions of seal and open - in_len is the
+	 * total length of the input iovecs, as computed by the caller.
+	 */
+	int (*seal_iov)(const struct evp_aead_ctx_st *ctx, unsigned char *out,
+	    size_t *out_len, size_t max_out_len, const unsigned char *nonce,
+	    size_t nonce_len, const struct iovec *iov, int iovcnt,
+	    size_t in_len, const unsigned char *ad, size_t ad_len);
+
+	int (*open_iov)(const struct evp_aead_ctx_st *ctx, unsigned char *out,
+	    size_t *out_len, size_t max_out_len, const unsigned char *nonce,
+	    size_t nonce_len, const struct iovec *iov, int iovcnt,
+	    size_t in_len, const unsigned char *ad, size_t ad_len);
 };
 
 /* An EVP_AEAD_CTX represents an AEAD algorithm configured with a specific key
@@ -50,6 +50,7 @@ LCRYPTO_USED(X509_STORE_set_verify_cb);
 LCRYPTO_USED(X509_STORE_get_check_issued);
 LCRYPTO_USED(X509_STORE_set_check_issued);
 LCRYPTO_USED(X509_STORE_CTX_get_check_issued);
+LCRYPTO_USED(X509_STORE_set_chain_cache_max);
 LCRYPTO_USED(X509_STORE_CTX_new);
 LCRYPTO_USED(X509_STORE_CTX_get1_issuer);
 LCRYPTO_USED(X509_STORE_CTX_free);
@@ -66,6 +67,7 @@ LCRYPTO_USED(X509_STORE_add_lookup);
 LCRYPTO_USED(X509_LOOKUP_hash_dir);
 LCRYPTO_USED(X509_LOOKUP_file);
 LCRYPTO_USED(X509_LOOKUP_mem);
+LCRYPTO_USED(X509_LOOKUP_mmap);
 LCRYPTO_USED(X509_STORE_add_cert);
 LCRYPTO_USED(X509_STORE_add_crl);
 LCRYPTO_USED(X509_STORE_CTX_get_by_subject);
@@ -0,0 +1,334 @@
+#!/usr/bin/env perl
+# $OpenBSD$
+#
+# Copyright (c) 2026 agent <agent@local>
+#
+# Permission to use, copy, modify, and distribute this software for any
+# purpose with or without fee is hereby granted, provided that the above
+# copyright notice and this permission notice appear in all copies.
+#
+# THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+# WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+# MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+# ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+# WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+# ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+# OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+# "Stitched" AES-GCM for processors with AES-NI, PCLMULQDQ and AVX.
+#
+# Eight counter blocks are encrypted per iteration, with the GHASH of
+# eight ciphertext blocks interleaved between the AES rounds, so that
+# the aesenc and pclmulqdq units are busy at the same time. Decryption
+# hashes the ciphertext of the current iteration, encryption that of
+# the previous one. The GHASH part uses the Htable of gcm_init_avx,
+# found 32 bytes past Xi in GCM128_CONTEXT, and reduces once per eight
+# blocks.
+#
+# size_t aesni_gcm_[en|de]crypt(const void *in, void *out, size_t len,
+#	const AES_KEY *key, unsigned char ivec[16], u64 *Xi);
+#
+# Only whole multiples of 128 bytes are processed and the number of
+# bytes processed is returned; the caller does the rest. The 32-bit
+# counter in ivec and Xi are updated.
+
+$flavour = shift;
+$output  = shift;
+if ($flavour =~ /\./) { $output = $flavour; undef $flavour; }
+
+$win64=0; $win64=1 if ($flavour =~ /[nm]asm|mingw64/ || $output =~ /\.asm$/);
+
+$0 =~ m/(.*[\/\\])[^\/\\]+$/; $dir=$1;
+( $xlate="${dir}x86_64-xlate.pl" and -f $xlate ) or
+( $xlate="${dir}../../perlasm/x86_64-xlate.pl" and -f $xlate) or
+die "can't locate x86_64-xlate.pl";
+
+open OUT,"| \"$^X\" $xlate $flavour $output";
+*STDOUT=*OUT;
+
+($inp,$out,$len,$key,$ivp,$Xip)=("%rdi","%rsi","%rdx","%rcx","%r8","%r9");
+($ctr,$Htbl,$ret)=("%r10d","%r11","%rbx");
+
+@blk=map("%xmm$_",(0..7));
+($rk,$Xlo,$Xhi,$Xmi,$T,$T2,$P,$bswap)=map("%xmm$_",(8..15));
+
+# Load the byte swapped block at $off($src) into $T, adding Xi to the
+# first block of eight.
+sub ghash_load {
+my ($src,$off,$first)=@_;
+
+$code.=<<___;
+	vmovdqu		$off($src),$T
+	vpshufb		$bswap,$T,$T
+___
+$code.=<<___ if ($first);
+	vpxor		$Xlo,$T,$T		# Ii+Xi
+___
+}
+
+# Multiply $T by H^(8-$i), accumulating the unreduced Karatsuba
+# products in $Xlo, $Xhi and $Xmi.
+sub ghash_mul {
+my ($i)=@_;
+my $off=0x70-0x10*$i;
+
+$code.=<<___ if ($i==0);
+	vpshufd		\$0b01001110,$T,$T2
+	vpclmulqdq	\$0x00,$off($Htbl),$T,$Xlo
+	vpxor		$T,$T2,$T2		# Ii.lo^Ii.hi
+	vpclmulqdq	\$0x11,$off($Htbl),$T,$Xhi
+	vpclmulqdq	\$0x00,0x80+$off($Htbl),$T2,$Xmi
+___
+$code.=<<___ if ($i!=0);
+	vpshufd		\$0b01001110,$T,$T2
+	vpclmulqdq	\$0x00,$off($Htbl),$T,$P
+	vpxor		$T,$T2,$T2		# Ii.lo^Ii.hi
+	vpxor		$P,$Xlo,$Xlo
+	vpclmulqdq	\$0x11,$off($Htbl),$T,$P
+	vpxor		$P,$Xhi,$Xhi
+	vpclmulqdq	\$0x00,0x80+$off($Htbl),$T2,$P
+	vpxor		$P,$Xmi,$Xmi
+___
+}
+
+# Karatsuba post-processing and reduction modulo the GCM polynomial,
+# see reduction_alg9 in ghash-x86_64.pl. The result is left in $Xlo.
+sub ghash_reduce {
+$code.=<<___;
+	vpxor		$Xlo,$Xmi,$Xmi
+	vpxor		$Xhi,$Xmi,$Xmi
+	vpslldq		\$8,$Xmi,$T2
+	vpsrldq		\$8,$Xmi,$Xmi
+	vpxor		$T2,$Xlo,$Xlo
+	vpxor		$Xmi,$Xhi,$Xhi
+
+	vpsllq		\$1,$Xlo,$T		# 1st phase
+	vpxor		$Xlo,$T,$T
+	vpsllq		\$5,$T,$T
+	vpxor		$Xlo,$T,$T
+	vpsllq		\$57,$T,$T
+	vpsrldq		\$8,$T,$T2
+	vpslldq		\$8,$T,$T
+	vpxor		$T,$Xlo,$Xlo
+	vpxor		$T2,$Xhi,$Xhi
+
+	vpsrlq		\$5,$Xlo,$T		# 2nd phase
+	vpxor		$Xlo,$T,$T
+	vpsrlq		\$1,$T,$T
+	vpxor		$Xlo,$T,$T
+	vpxor		$Xhi,$Xlo,$T2
+	vpsrlq		\$1,$T,$T
+	vpxor		$T2,$T,$Xlo
+___
+}
+
+sub aes_round {
+my ($r)=@_;
+
+$code.="\tvmovdqu\t\t`0x10*$r`($key),$rk\n";
+$code.="\tvaesenc\t\t$rk,$_,$_\n" foreach (@blk);
+}
+
+# Encrypt eight counter blocks and XOR them with the input. If $src is
+# defined, the eight blocks at $off($src) are hashed in between the AES
+# rounds.
+{ my $sn=0;
+sub aes_gcm_8x {
+my ($src,$off)=@_;
+my $i;
+
+++$sn;
+$code.=<<___;
+	vmovdqu		($ivp),$rk
+___
+for ($i=0; $i<8; $i++) {
+$code.=<<___;
+	lea		$i(%r10),%eax
+	bswap		%eax
+	vpinsrd		\$3,%eax,$rk,$blk[$i]
+___
+}
+$code.=<<___;
+	add		\$8,$ctr
+	vmovdqu		($key),$rk
+___
+$code.="\tvpxor\t\t$rk,$_,$_\n" foreach (@blk);
+for ($i=1; $i<=8; $i++) {
+	&aes_round($i);
+	if (defined($src)) {
+		&ghash_load($src,$off+0x10*($i-1),$i==1);
+		&ghash_mul($i-1);
+	}
+}
+	&aes_round(9);
+	&ghash_reduce()		if (defined($src));
+$code.=<<___;
+	cmpl		\$11,240($key)		# 9, 11 or 13 rounds
+	jb		.Llast_$sn
+___
+	&aes_round(10);
+	&aes_round(11);
+$code.=<<___;
+	cmpl		\$11,240($key)
+	je		.Llast_$sn
+___
+	&aes_round(12);
+	&aes_round(13);
+$code.=<<___;
+.Llast_$sn:
+	mov		240($key),%eax
+	shl		\$4,%eax
+	vmovdqu		0x10($key,%rax),$rk
+___
+$code.="\tvaesenclast\t$rk,$_,$_\n" foreach (@blk);
+for ($i=0; $i<8; $i++) {
+$code.=<<___;
+	vpxor		`0x10*$i`($inp),$blk[$i],$blk[$i]
+	vmovdqu		$blk[$i],`0x10*$i`($out)
+___
+}
+}}
+
+sub prologue {
+my ($name)=@_;
+
+$code.=<<___;
+.globl	$name
+.type	$name,\@abi-omnipotent
+.align	32
+$name:
+	push		%rbx
+___
+$code.=<<___ if ($win64);
+	push		%rdi
+	push		%rsi
+	lea		-0xa0(%rsp),%rsp
+	movaps		%xmm6,0x00(%rsp)
+	movaps		%xmm7,0x10(%rsp)
+	movaps		%xmm8,0x20(%rsp)
+	movaps		%xmm9,0x30(%rsp)
+	movaps		%xmm10,0x40(%rsp)
+	movaps		%xmm11,0x50(%rsp)
+	movaps		%xmm12,0x60(%rsp)
+	movaps		%xmm13,0x70(%rsp)
+	movaps		%xmm14,0x80(%rsp)
+	movaps		%xmm15,0x90(%rsp)
+	mov		%rcx,$inp
+	mov		%rdx,$out
+	mov		%r8,$len
+	mov		%r9,$key
+	mov		0xa0+0x18+0x28(%rsp),$ivp
+	mov		0xa0+0x18+0x30(%rsp),$Xip
+___
+$code.=<<___;
+	xor		%ebx,%ebx
+	and		\$-0x80,$len
+	jz		.L${name}_done
+	mov		$len,$ret
+
+	vzeroupper
+	vmovdqa		.Lbswap_mask(%rip),$bswap
+	lea		0x20($Xip),$Htbl	# Htable follows Xi and H
+	vmovdqu		($Xip),$Xlo
+	vpshufb		$bswap,$Xlo,$Xlo
+	mov		12($ivp),$ctr
+	bswap		$ctr
+___
+}
+
+sub epilogue {
+my ($name)=@_;
+
+$code.=<<___;
+	vpshufb		$bswap,$Xlo,$Xlo
+	vmovdqu		$Xlo,($Xip)
+	bswap		$ctr
+	mov		$ctr,12($ivp)
+	vzeroupper
+
+.L${name}_done:
+	mov		$ret,%rax
+___
+$code.=<<___ if ($win64);
+	movaps		0x00(%rsp),%xmm6
+	movaps		0x10(%rsp),%xmm7
+	movaps		0x20(%rsp),%xmm8
+	movaps		0x30(%rsp),%xmm9
+	movaps		0x40(%rsp),%xmm10
+	movaps		0x50(%rsp),%xmm11
+	movaps		0x60(%rsp),%xmm12
+	movaps		0x70(%rsp),%xmm13
+	movaps		0x80(%rsp),%xmm14
+	movaps		0x90(%rsp),%xmm15
+	lea		0xa0(%rsp),%rsp
+	pop		%rsi
+	pop		%rdi
+___
+$code.=<<___;
+	pop		%rbx
+	ret
+.size	$name,.-$name
+___
+}
+
+$code=".text\n";
+
+######################################################################
+# Encryption hashes the ciphertext written by the previous iteration,
+# so the first eight blocks are encrypted on their own and the last
+# eight are hashed after the loop.
+
+&prologue("aesni_gcm_encrypt");
+	&aes_gcm_8x();
+$code.=<<___;
+	lea		0x80($inp),$inp
+	lea		0x80($out),$out
+	sub		\$0x80,$len
+	jz		.Lenc_tail
+
+.align	32
+.Lenc_loop:
+___
+	&aes_gcm_8x($out,-0x80);
+$code.=<<___;
+	lea		0x80($inp),$inp
+	lea		0x80($out),$out
+	sub		\$0x80,$len
+	jnz		.Lenc_loop
+
+.Lenc_tail:
+___
+for ($i=0; $i<8; $i++) {
+	&ghash_load($out,-0x80+0x10*$i,$i==0);
+	&ghash_mul($i);
+}
+	&ghash_reduce();
+&epilogue("aesni_gcm_encrypt");
+
+&prologue("aesni_gcm_decrypt");
+$code.=<<___;
+.align	32
+.Ldec_loop:
+___
+	&aes_gcm_8x($inp,0);
+$code.=<<___;
+	lea		0x80($inp),$inp
+	lea		0x80($out),$out
+	sub		\$0x80,$len
+	jnz		.Ldec_loop
+___
+&epilogue("aesni_gcm_decrypt");
+
+$code.=<<___;
+.section .rodata
+.align	64
+.Lbswap_mask:
+	.byte	15,14,13,12,11,10,9,8,7,6,5,4,3,2,1,0
+.text
+___
+
+$code =~ s/\`([^\`]*)\`/eval($1)/gem;
+
+print $code;
+
+close STDOUT;
@@ -39,6 +39,10 @@
 # providing access to a Westmere-based system on behalf of Intel
 # Open Source Technology Centre.
 
+# Add AVX version, which aggregates eight blocks per reduction using
+# pre-computed H^1..H^8. It is used together with the stitched AES-GCM
+# code in aesni-gcm-x86_64.pl, which shares its Htable layout.
+
 $flavour = shift;
 $output  = shift;
 if ($flavour =~ /\./) { $output = $flavour; undef $flavour; }
@@ -621,6 +625,211 @@ $code.=<<___;
 ___
 }
 
+######################################################################
+# AVX version, aggregating eight blocks per reduction.
+#
+# gcm_init_avx stores H^1..H^8 at offsets 0x00..0x70 of Htable, each
+# "twisted" like the H of gcm_init_clmul, followed by the Karatsuba
+# pre-computed H^i.lo^H^i.hi at offsets 0x80..0xf0. As the first two
+# entries match those of gcm_init_clmul, gcm_gmult_clmul works on the
+# same table. gcm_ghash_avx then computes
+#
+#	Xi+8 = [(Ii+Xi)*H^8 + Ii+1*H^7 + ... + Ii+7*H] mod P
+#
+# with a single reduction per eight blocks.
+
+{ my ($Htbl,$Xip)=@_4args;
+
+$code.=<<___;
+.globl	gcm_init_avx
+.type	gcm_init_avx,\@abi-omnipotent
+.align	16
+gcm_init_avx:
+	movdqu		($Xip),$Hkey
+	pshufd		\$0b01001110,$Hkey,$Hkey	# dword swap
+
+	# <<1 twist
+	pshufd		\$0b11111111,$Hkey,$T2	# broadcast uppermost dword
+	movdqa		$Hkey,$T1
+	psllq		\$1,$Hkey
+	pxor		$T3,$T3			#
+	psrlq		\$63,$T1
+	pcmpgtd		$T2,$T3			# broadcast carry bit
+	pslldq		\$8,$T1
+	por		$T1,$Hkey		# H<<=1
+
+	# magic reduction
+	pand		.L0x1c2_polynomial(%rip),$T3
+	pxor		$T3,$Hkey		# if(carry) H^=0x1c2_polynomial
+
+	movdqa		$Hkey,$Xi
+	mov		\$8,%eax
+	jmp		.Linit_avx_store
+
+.align	16
+.Linit_avx_loop:
+___
+	&clmul64x64_T2	($Xhi,$Xi,$Hkey);	# H^i = H^(i-1)*H
+	&reduction_alg9	($Xhi,$Xi);
+$code.=<<___;
+.Linit_avx_store:
+	movdqu		$Xi,($Htbl)		# save H^i
+	pshufd		\$0b01001110,$Xi,$T1
+	pxor		$Xi,$T1			# H^i.lo^H^i.hi
+	movdqu		$T1,0x80($Htbl)
+	lea		0x10($Htbl),$Htbl
+	dec		%eax
+	jnz		.Linit_avx_loop
+	ret
+.size	gcm_init_avx,.-gcm_init_avx
+___
+}
+
+{ my ($Xip,$Htbl,$inp,$len)=@_4args;
+  my ($Xlo,$Xhi,$Xmi,$T,$T2,$P,$bswap)=map("%xmm$_",(0..6));
+  my $Hp="%rax";
+
+# Multiply the byte swapped block in $T by the power of H at $off($base),
+# accumulating the unreduced Karatsuba products in $Xlo, $Xhi and $Xmi.
+sub ghash_avx_mul {
+my ($off,$base,$first)=@_;
+
+$code.=<<___ if ($first);
+	vpshufd		\$0b01001110,$T,$T2
+	vpclmulqdq	\$0x00,$off($base),$T,$Xlo
+	vpxor		$T,$T2,$T2		# Ii.lo^Ii.hi
+	vpclmulqdq	\$0x11,$off($base),$T,$Xhi
+	vpclmulqdq	\$0x00,0x80+$off($base),$T2,$Xmi
+___
+$code.=<<___ if (!$first);
+	vpshufd		\$0b01001110,$T,$T2
+	vpclmulqdq	\$0x00,$off($base),$T,$P
+	vpxor		$T,$T2,$T2		# Ii.lo^Ii.hi
+	vpxor		$P,$Xlo,$Xlo
+	vpclmulqdq	\$0x11,$off($base),$T,$P
+	vpxor		$P,$Xhi,$Xhi
+	vpclmulqdq	\$0x00,0x80+$off($base),$T2,$P
+	vpxor		$P,$Xmi,$Xmi
+___
+}
+
+# Karatsuba post-processing and reduction_alg9 of $Xhi:$Xlo, leaving
+# the result in $Xlo.
+sub ghash_avx_reduce {
+$code.=<<___;
+	vpxor		$Xlo,$Xmi,$Xmi
+	vpxor		$Xhi,$Xmi,$Xmi
+	vpslldq		\$8,$Xmi,$T2
+	vpsrldq		\$8,$Xmi,$Xmi
+	vpxor		$T2,$Xlo,$Xlo
+	vpxor		$Xmi,$Xhi,$Xhi
+
+	# 1st phase
+	vpsllq		\$1,$Xlo,$T
+	vpxor		$Xlo,$T,$T
+	vpsllq		\$5,$T,$T
+	vpxor		$Xlo,$T,$T
+	vpsllq		\$57,$T,$T
+	vpsrldq		\$8,$T,$T2
+	vpslldq		\$8,$T,$T
+	vpxor		$T,$Xlo,$Xlo
+	vpxor		$T2,$Xhi,$Xhi
+
+	# 2nd phase
+	vpsrlq		\$5,$Xlo,$T
+	vpxor		$Xlo,$T,$T
+	vpsrlq		\$1,$T,$T
+	vpxor		$Xlo,$T,$T
+	vpxor		$Xhi,$Xlo,$T2
+	vpsrlq		\$1,$T,$T
+	vpxor		$T2,$T,$Xlo
+___
+}
+
+$code.=<<___;
+.globl	gcm_ghash_avx
+.type	gcm_ghash_avx,\@abi-omnipotent
+.align	32
+gcm_ghash_avx:
+___
+$code.=<<___ if ($win64);
+	lea		-0x18(%rsp),%rsp
+	movaps		%xmm6,(%rsp)
+___
+$code.=<<___;
+	vzeroupper
+	vmovdqa		.Lbswap_mask(%rip),$bswap
+	vmovdqu		($Xip),$Xlo
+	vpshufb		$bswap,$Xlo,$Xlo
+
+	cmp		\$0x80,$len
+	jb		.Ltail_avx
+
+.align	32
+.Loop8x_avx:
+	vmovdqu		($inp),$T		# Ii
+	vpshufb		$bswap,$T,$T
+	vpxor		$Xlo,$T,$T		# Ii+Xi
+___
+	&ghash_avx_mul	(0x70,$Htbl,1);		# (Ii+Xi)*H^8
+for (my $i=1; $i<8; $i++) {
+$code.=<<___;
+	vmovdqu		`0x10*$i`($inp),$T	# Ii+$i
+	vpshufb		$bswap,$T,$T
+___
+	&ghash_avx_mul	(0x70-0x10*$i,$Htbl,0);	# Ii+$i*H^(8-$i)
+}
+	&ghash_avx_reduce();
+$code.=<<___;
+	lea		0x80($inp),$inp
+	sub		\$0x80,$len
+	cmp		\$0x80,$len
+	jae		.Loop8x_avx
+
+.Ltail_avx:
+	test		$len,$len
+	jz		.Ldone_avx
+
+	lea		-0x10($Htbl,$len),$Hp	# H^n for the n remaining blocks
+	vmovdqu		($inp),$T		# Ii
+	vpshufb		$bswap,$T,$T
+	vpxor		$Xlo,$T,$T		# Ii+Xi
+___
+	&ghash_avx_mul	(0,$Hp,1);
+$code.=<<___;
+	jmp		.Ltail_avx_next
+
+.align	16
+.Ltail_avx_loop:
+	vmovdqu		($inp),$T
+	vpshufb		$bswap,$T,$T
+___
+	&ghash_avx_mul	(0,$Hp,0);
+$code.=<<___;
+.Ltail_avx_next:
+	lea		0x10($inp),$inp
+	lea		-0x10($Hp),$Hp
+	sub		\$0x10,$len
+	jnz		.Ltail_avx_loop
+___
+	&ghash_avx_reduce();
+$code.=<<___;
+
+.Ldone_avx:
+	vpshufb		$bswap,$Xlo,$Xlo
+	vmovdqu		$Xlo,($Xip)
+	vzeroupper
+___
+$code.=<<___ if ($win64);
+	movaps		(%rsp),%xmm6
+	lea		0x18(%rsp),%rsp
+___
+$code.=<<___;
+	ret
+.size	gcm_ghash_avx,.-gcm_ghash_avx
+___
+}
+
 $code.=<<___;
 .section .rodata
 .align	64
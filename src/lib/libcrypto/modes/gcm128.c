@@ -651,6 +651,26 @@ void gcm_init_clmul(u128 Htable[16],const u64 Xi[2]);
 void gcm_gmult_clmul(u64 Xi[2],const u128 Htable[16]);
 void gcm_ghash_clmul(u64 Xi[2],const u128 Htable[16],const u8 *inp,size_t len);
 
+#  if	defined(__x86_64) || defined(__x86_64__) || \
+	defined(_M_AMD64) || defined(_M_X64)
+#   define GHASH_ASM_X86_64
+void gcm_init_avx(u128 Htable[16],const u64 Xi[2]);
+void gcm_ghash_avx(u64 Xi[2],const u128 Htable[16],const u8 *inp,size_t len);
+
+/*
+ * The stitched AES-NI/AVX kernels take over bulk encryption from the
+ * aesni_ctr32_encrypt_blocks stream, when GHASH is gcm_ghash_avx. They
+ * process multiples of 128 bytes and expect Htable to follow Xi and H.
+ */
+#   define AESNI_GCM
+void aesni_ctr32_encrypt_blocks(const unsigned char *in, unsigned char *out,
+    size_t blocks, const void *key, const unsigned char *ivec);
+size_t aesni_gcm_encrypt(const u8 *in, u8 *out, size_t len, const void *key,
+    u8 ivec[16], u64 *Xi);
+size_t aesni_gcm_decrypt(const u8 *in, u8 *out, size_t len, const void *key,
+    u8 ivec[16], u64 *Xi);
+#  endif
+
 #  if	defined(__i386) || defined(__i386__) || defined(_M_IX86)
 #   define GHASH_ASM_X86
 void gcm_gmult_4bit_mmx(u64 Xi[2],const u128 Htable[16]);
@@ -710,6 +730,14 @@ void CRYPTO_gcm128_init(GCM128_CONTEXT *ctx,void *key,block128_f block)
 	/* check FXSR and PCLMULQDQ bits */
 	if ((OPENSSL_cpu_caps() & (CPUCAP_MASK_FXSR | CPUCAP_MASK_PCLMUL)) ==
 	    (CPUCAP_MASK_FXSR | CPUCAP_MASK_PCLMUL)) {
+#   if	defined(GHASH_ASM_X86_64)
+		if (OPENSSL_cpu_caps() & CPUCAP_MASK_AVX) {
+			gcm_init_avx(ctx->Htable,ctx->H.u);
+			ctx->gmult = gcm_gmult_clmul;
+			ctx->ghash = gcm_ghash_avx;
+			return;
+		}
+#   endif
 		gcm_init_clmul(ctx->Htable,ctx->H.u);
 		ctx->gmult = gcm_gmult_clmul;
 		ctx->ghash = gcm_ghash_clmul;
@@ -1305,6 +1333,16 @@ int CRYPTO_gcm128_encrypt_ctr32(GCM128_CONTEXT *ctx,
 			return 0;
 		}
 	}
+#if defined(AESNI_GCM)
+	if (stream == aesni_ctr32_encrypt_blocks &&
+	    ctx->ghash == gcm_ghash_avx) {
+		i = aesni_gcm_encrypt(in,out,len,key,ctx->Yi.c,ctx->Xi.u);
+		ctr += (unsigned int)(i/16);
+		in  += i;
+		out += i;
+		len -= i;
+	}
+#endif
 #if defined(GHASH) && !defined(OPENSSL_SMALL_FOOTPRINT)
 	while (len>=GHASH_CHUNK) {
 		(*stream)(in,out,GHASH_CHUNK/16,key,ctx->Yi.c);
@@ -1425,6 +1463,16 @@ int CRYPTO_gcm128_decrypt_ctr32(GCM128_CONTEXT *ctx,
 			return 0;
 		}
 	}
+#if defined(AESNI_GCM)
+	if (stream == aesni_ctr32_encrypt_blocks &&
+	    ctx->ghash == gcm_ghash_avx) {
+		i = aesni_gcm_decrypt(in,out,len,key,ctx->Yi.c,ctx->Xi.u);
+		ctr += (unsigned int)(i/16);
+		in  += i;
+		out += i;
+		len -= i;
+	}
+#endif
 #if defined(GHASH) && !defined(OPENSSL_SMALL_FOOTPRINT)
 	while (len>=GHASH_CHUNK) {
 		GHASH(ctx,in,GHASH_CHUNK);
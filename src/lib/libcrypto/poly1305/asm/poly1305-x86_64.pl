@@ -0,0 +1,234 @@
+#!/usr/bin/env perl
+# $OpenBSD$
+#
+# Copyright (c) 2026 agent <agent@local>
+#
+# Permission to use, copy, modify, and distribute this software for any
+# purpose with or without fee is hereby granted, provided that the above
+# copyright notice and this permission notice appear in all copies.
+#
+# THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+# WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+# MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+# ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+# WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+# ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+# OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+# Poly1305 for AVX2, four blocks at a time.
+#
+# The accumulator is split into four lanes that each hold five 26 bit
+# limbs in 64 bit words. Every iteration multiplies all lanes by r^4 and
+# adds the next four blocks, after which the lanes are multiplied by r^4,
+# r^3, r^2 and r^1 respectively and summed.
+#
+# void poly1305_blocks_avx2(uint64_t acc[5], const unsigned char *m,
+#	size_t len, const uint64_t table[18][4]);
+#
+# On entry acc holds h in radix 2^26, on return the sums of the five limbs
+# of the four lanes, which are not carried. len is a non-zero multiple of
+# 64. Rows 0-8 of table hold r0-r4 and 5*r1-5*r4 of r^4 in every lane and
+# rows 9-17 the same for r^4, r^3, r^2 and r^1 in lanes 0-3.
+
+$flavour = shift;
+$output  = shift;
+if ($flavour =~ /\./) { $output = $flavour; undef $flavour; }
+
+$win64=0; $win64=1 if ($flavour =~ /[nm]asm|mingw64/ || $output =~ /\.asm$/);
+
+$0 =~ m/(.*[\/\\])[^\/\\]+$/; $dir=$1;
+( $xlate="${dir}x86_64-xlate.pl" and -f $xlate ) or
+( $xlate="${dir}../../perlasm/x86_64-xlate.pl" and -f $xlate) or
+die "can't locate x86_64-xlate.pl";
+
+open OUT,"| \"$^X\" $xlate $flavour $output";
+*STDOUT=*OUT;
+
+($acc,$inp,$len,$tbl)=("%rdi","%rsi","%rdx","%rcx");
+
+@H=map("%ymm$_",(0..4));
+@D=map("%ymm$_",(5..9));
+($T0,$T1,$MASK,$HIBIT)=map("%ymm$_",(10..13));
+
+# Multiply the lanes of H by the powers of r in rows $row to $row+8 of
+# the table, leaving the products in D.
+sub mul {
+my $row=shift;
+my $r=sub { my $i=shift; sprintf("%d(%s)",($row+$i)*32,$tbl); };
+# r0-r4 are rows 0-4, 5*r1-5*r4 rows 5-8.
+my @terms=(
+	[[0,0],[1,8],[2,7],[3,6],[4,5]],
+	[[0,1],[1,0],[2,8],[3,7],[4,6]],
+	[[0,2],[1,1],[2,0],[3,8],[4,7]],
+	[[0,3],[1,2],[2,1],[3,0],[4,8]],
+	[[0,4],[1,3],[2,2],[3,1],[4,0]]);
+my ($i,$s)=(0,"");
+
+for ($i=0; $i<5; $i++) {
+	my ($h,$k)=@{$terms[$i][0]};
+	$s.="\tvpmuludq\t".&$r($k).",$H[$h],$D[$i]\n";
+}
+for (my $j=1; $j<5; $j++) {
+	for ($i=0; $i<5; $i++) {
+		my ($h,$k)=@{$terms[$i][$j]};
+		$s.="\tvpmuludq\t".&$r($k).",$H[$h],$T0\n";
+		$s.="\tvpaddq\t\t$T0,$D[$i],$D[$i]\n";
+	}
+}
+return $s;
+}
+
+$code=".text\n";
+
+$code.=<<___;
+.globl	poly1305_blocks_avx2
+.type	poly1305_blocks_avx2,\@abi-omnipotent
+.align	32
+poly1305_blocks_avx2:
+___
+$code.=<<___ if ($win64);
+	push		%rdi
+	push		%rsi
+	lea		-0x88(%rsp),%rsp
+	movaps		%xmm6,0x00(%rsp)
+	movaps		%xmm7,0x10(%rsp)
+	movaps		%xmm8,0x20(%rsp)
+	movaps		%xmm9,0x30(%rsp)
+	movaps		%xmm10,0x40(%rsp)
+	movaps		%xmm11,0x50(%rsp)
+	movaps		%xmm12,0x60(%rsp)
+	movaps		%xmm13,0x70(%rsp)
+	mov		%rcx,$acc
+	mov		%rdx,$inp
+	mov		%r8,$len
+	mov		%r9,$tbl
+___
+$code.=<<___;
+	vzeroupper
+	vmovq		0($acc),%xmm0
+	vmovq		8($acc),%xmm1
+	vmovq		16($acc),%xmm2
+	vmovq		24($acc),%xmm3
+	vmovq		32($acc),%xmm4
+	vpbroadcastq	.Lmask26(%rip),$MASK
+	vpbroadcastq	.Lhibit(%rip),$HIBIT
+	jmp		.Loop_avx2
+
+.align	32
+.Loop_avx2:
+	# split four blocks into 26 bit limbs and add them to the lanes
+	vmovdqu		0($inp),%xmm5
+	vmovdqu		16($inp),%xmm6
+	vinserti128	\$1,32($inp),%ymm5,%ymm5
+	vinserti128	\$1,48($inp),%ymm6,%ymm6
+	vpunpcklqdq	%ymm6,%ymm5,%ymm7
+	vpunpckhqdq	%ymm6,%ymm5,%ymm8
+
+	vpand		$MASK,%ymm7,$T0
+	vpaddq		$T0,$H[0],$H[0]
+	vpsrlq		\$26,%ymm7,$T0
+	vpand		$MASK,$T0,$T0
+	vpaddq		$T0,$H[1],$H[1]
+	vpsrlq		\$52,%ymm7,$T0
+	vpsllq		\$12,%ymm8,$T1
+	vpor		$T1,$T0,$T0
+	vpand		$MASK,$T0,$T0
+	vpaddq		$T0,$H[2],$H[2]
+	vpsrlq		\$14,%ymm8,$T0
+	vpand		$MASK,$T0,$T0
+	vpaddq		$T0,$H[3],$H[3]
+	vpsrlq		\$40,%ymm8,$T0
+	vpor		$HIBIT,$T0,$T0
+	vpaddq		$T0,$H[4],$H[4]
+
+	lea		64($inp),$inp
+	sub		\$64,$len
+	jz		.Ltail_avx2
+
+	# h *= r^4
+___
+$code.=&mul(0);
+$code.=<<___;
+
+	# partial reduction
+	vpsrlq		\$26,$D[0],$T0
+	vpand		$MASK,$D[0],$H[0]
+	vpaddq		$T0,$D[1],$D[1]
+	vpsrlq		\$26,$D[1],$T0
+	vpand		$MASK,$D[1],$H[1]
+	vpaddq		$T0,$D[2],$D[2]
+	vpsrlq		\$26,$D[2],$T0
+	vpand		$MASK,$D[2],$H[2]
+	vpaddq		$T0,$D[3],$D[3]
+	vpsrlq		\$26,$D[3],$T0
+	vpand		$MASK,$D[3],$H[3]
+	vpaddq		$T0,$D[4],$D[4]
+	vpsrlq		\$26,$D[4],$T0
+	vpand		$MASK,$D[4],$H[4]
+	vpsllq		\$2,$T0,$T1
+	vpaddq		$T1,$T0,$T0
+	vpaddq		$T0,$H[0],$H[0]
+	vpsrlq		\$26,$H[0],$T0
+	vpand		$MASK,$H[0],$H[0]
+	vpaddq		$T0,$H[1],$H[1]
+	jmp		.Loop_avx2
+
+.align	32
+.Ltail_avx2:
+	# h *= (r^4, r^3, r^2, r^1) and sum the lanes
+___
+$code.=&mul(9);
+for ($i=0; $i<5; $i++) {
+	my $x=$D[$i]; $x=~s/ymm/xmm/;
+	my $t=$T0; $t=~s/ymm/xmm/;
+	$code.=<<___;
+	vextracti128	\$1,$D[$i],$t
+	vpaddq		$t,$x,$x
+	vpsrldq		\$8,$x,$t
+	vpaddq		$t,$x,$x
+	vmovq		$x,`8*$i`($acc)
+___
+}
+$code.=<<___;
+	vpxor		%ymm0,%ymm0,%ymm0
+	vpxor		%ymm1,%ymm1,%ymm1
+	vpxor		%ymm2,%ymm2,%ymm2
+	vpxor		%ymm3,%ymm3,%ymm3
+	vpxor		%ymm4,%ymm4,%ymm4
+	vpxor		%ymm5,%ymm5,%ymm5
+	vpxor		%ymm6,%ymm6,%ymm6
+	vpxor		%ymm7,%ymm7,%ymm7
+	vpxor		%ymm8,%ymm8,%ymm8
+	vzeroupper
+___
+$code.=<<___ if ($win64);
+	movaps		0x00(%rsp),%xmm6
+	movaps		0x10(%rsp),%xmm7
+	movaps		0x20(%rsp),%xmm8
+	movaps		0x30(%rsp),%xmm9
+	movaps		0x40(%rsp),%xmm10
+	movaps		0x50(%rsp),%xmm11
+	movaps		0x60(%rsp),%xmm12
+	movaps		0x70(%rsp),%xmm13
+	lea		0x88(%rsp),%rsp
+	pop		%rsi
+	pop		%rdi
+___
+$code.=<<___;
+	ret
+.size	poly1305_blocks_avx2,.-poly1305_blocks_avx2
+
+.section .rodata
+.align	8
+.Lmask26:
+	.quad	0x3ffffff
+.Lhibit:
+	.quad	0x1000000
+.text
+___
+
+$code =~ s/\`([^\`]*)\`/eval($1)/gem;
+
+print $code;
+
+close STDOUT;
@@ -1,11 +1,14 @@
 /* $OpenBSD: poly1305-donna.c,v 1.3 2014/06/12 15:49:30 deraadt Exp $ */
 /*
  * Public Domain poly1305 from Andrew Moon
- * Based on poly1305-donna.c, poly1305-donna-32.h and poly1305-donna.h from:
+ * Based on poly1305-donna.c, poly1305-donna-32.h, poly1305-donna-64.h and
+ * poly1305-donna.h from:
  *   https://github.com/floodyberry/poly1305-donna
  */
 
 #include <stddef.h>
+#include <stdint.h>
+#include <string.h>
 
 static inline void poly1305_init(poly1305_context *ctx,
     const unsigned char key[32]);
@@ -14,13 +17,389 @@ static inline void poly1305_update(poly1305_context *ctx,
 static inline void poly1305_finish(poly1305_context *ctx,
     unsigned char mac[16]);
 
+#define poly1305_block_size 16
+
+#if defined(__SIZEOF_INT128__) && defined(_LP64)
+#define POLY1305_DONNA64
+#endif
+
+#ifdef POLY1305_DONNA64
+
+/*
+ * poly1305 implementation using 64 bit * 64 bit = 128 bit multiplication
+ * and 128 bit addition.
+ */
+
+typedef struct poly1305_state_internal_t {
+	uint64_t r[3];
+	uint64_t h[3];
+	uint64_t pad[2];
+	size_t leftover;
+	unsigned char buffer[poly1305_block_size];
+	unsigned char final;
+} poly1305_state_internal_t;
+
+/* interpret eight 8 bit unsigned integers as a 64 bit unsigned integer in little endian */
+static inline uint64_t
+U8TO64(const unsigned char *p)
+{
+	return (((uint64_t)(p[0] & 0xff)) |
+	    ((uint64_t)(p[1] & 0xff) <<  8) |
+	    ((uint64_t)(p[2] & 0xff) << 16) |
+	    ((uint64_t)(p[3] & 0xff) << 24) |
+	    ((uint64_t)(p[4] & 0xff) << 32) |
+	    ((uint64_t)(p[5] & 0xff) << 40) |
+	    ((uint64_t)(p[6] & 0xff) << 48) |
+	    ((uint64_t)(p[7] & 0xff) << 56));
+}
+
+/* store a 64 bit unsigned integer as eight 8 bit unsigned integers in little endian */
+static inline void
+U64TO8(unsigned char *p, uint64_t v)
+{
+	p[0] = (v) & 0xff;
+	p[1] = (v >>  8) & 0xff;
+	p[2] = (v >> 16) & 0xff;
+	p[3] = (v >> 24) & 0xff;
+	p[4] = (v >> 32) & 0xff;
+	p[5] = (v >> 40) & 0xff;
+	p[6] = (v >> 48) & 0xff;
+	p[7] = (v >> 56) & 0xff;
+}
+
+static inline void
+poly1305_init(poly1305_context *ctx, const unsigned char key[32])
+{
+	poly1305_state_internal_t *st = (poly1305_state_internal_t *)ctx;
+	uint64_t t0, t1;
+
+	/* r &= 0xffffffc0ffffffc0ffffffc0fffffff */
+	t0 = U8TO64(&key[0]);
+	t1 = U8TO64(&key[8]);
+
+	st->r[0] = (t0) & 0xffc0fffffff;
+	st->r[1] = ((t0 >> 44) | (t1 << 20)) & 0xfffffc0ffff;
+	st->r[2] = ((t1 >> 24)) & 0x00ffffffc0f;
+
+	/* h = 0 */
+	st->h[0] = 0;
+	st->h[1] = 0;
+	st->h[2] = 0;
+
+	/* save pad for later */
+	st->pad[0] = U8TO64(&key[16]);
+	st->pad[1] = U8TO64(&key[24]);
+
+	st->leftover = 0;
+	st->final = 0;
+}
+
+/* h *= r, with a partial reduction of h modulo p */
+static inline void
+poly1305_mul(uint64_t h[3], const uint64_t r[3])
+{
+	uint64_t r0, r1, r2, s1, s2, h0, h1, h2, c;
+	unsigned __int128 d0, d1, d2;
+
+	r0 = r[0];
+	r1 = r[1];
+	r2 = r[2];
+
+	s1 = r1 * (5 << 2);
+	s2 = r2 * (5 << 2);
+
+	h0 = h[0];
+	h1 = h[1];
+	h2 = h[2];
+
+	d0 = ((unsigned __int128)h0 * r0) +
+	    ((unsigned __int128)h1 * s2) +
+	    ((unsigned __int128)h2 * s1);
+	d1 = ((unsigned __int128)h0 * r1) +
+	    ((unsigned __int128)h1 * r0) +
+	    ((unsigned __int128)h2 * s2);
+	d2 = ((unsigned __int128)h0 * r2) +
+	    ((unsigned __int128)h1 * r1) +
+	    ((unsigned __int128)h2 * r0);
+
+	/* (partial) h %= p */
+	c = (uint64_t)(d0 >> 44);
+	h0 = (uint64_t)d0 & 0xfffffffffff;
+	d1 += c;
+	c = (uint64_t)(d1 >> 44);
+	h1 = (uint64_t)d1 & 0xfffffffffff;
+	d2 += c;
+	c = (uint64_t)(d2 >> 42);
+	h2 = (uint64_t)d2 & 0x3ffffffffff;
+	h0 += c * 5;
+	c = (h0 >> 44);
+	h0 = h0 & 0xfffffffffff;
+	h1 += c;
+
+	h[0] = h0;
+	h[1] = h1;
+	h[2] = h2;
+}
+
+#ifdef POLY1305_ASM
+#include <openssl/crypto.h>
+
+#include "x86_arch.h"
+
+void poly1305_blocks_avx2(uint64_t acc[5], const unsigned char *m,
+    size_t bytes, const uint64_t table[18][4]);
+
+/*
+ * The AVX2 code works on four blocks at a time, in radix 2^26, and needs
+ * r^1 to r^4. These are computed for every call, so that they do not need
+ * to be kept in the context, which is only worth it for longer inputs.
+ */
+#define POLY1305_AVX2_MIN	(16 * poly1305_block_size)
+
+/* Split a partially reduced h into five 26 bit limbs. */
+static void
+poly1305_to_26(uint64_t a[5], const uint64_t h[3])
+{
+	uint64_t h0, h1, h2, c;
+
+	h0 = h[0];
+	h1 = h[1];
+	h2 = h[2];
+
+	c = h1 >> 44;
+	h1 &= 0xfffffffffff;
+	h2 += c;
+
+	a[0] = h0 & 0x3ffffff;
+	a[1] = ((h0 >> 26) | (h1 << 18)) & 0x3ffffff;
+	a[2] = (h1 >> 8) & 0x3ffffff;
+	a[3] = ((h1 >> 34) | (h2 << 10)) & 0x3ffffff;
+	a[4] = h2 >> 16;
+}
+
+/*
+ * Process all groups of four blocks with AVX2, leaving h partially
+ * reduced, and return the number of bytes processed.
+ */
+static size_t
+poly1305_blocks_simd(poly1305_state_internal_t *st, const unsigned char *m,
+    size_t bytes)
+{
+	uint64_t table[18][4];
+	uint64_t rp[4][3], a[5], c;
+	int i, j;
+
+	if (bytes < POLY1305_AVX2_MIN ||
+	    (OPENSSL_cpu_caps() & CPUCAP_MASK_AVX2) == 0 ||
+	    (OPENSSL_cpu_caps() & CPUCAP_MASK_AVX) == 0)
+		return 0;
+
+	bytes &= ~(size_t)(4 * poly1305_block_size - 1);
+
+	/* r^1, r^2, r^3 and r^4 */
+	for (i = 0; i < 3; i++)
+		rp[0][i] = st->r[i];
+	for (j = 1; j < 4; j++) {
+		for (i = 0; i < 3; i++)
+			rp[j][i] = rp[j - 1][i];
+		poly1305_mul(rp[j], st->r);
+	}
+
+	/*
+	 * Rows 0-8 hold r^4 and 5 * r^4 in every lane, for the loop. Rows
+	 * 9-17 hold r^4, r^3, r^2 and r^1 in lanes 0-3, for the last four
+	 * blocks.
+	 */
+	for (j = 0; j < 4; j++) {
+		poly1305_to_26(a, rp[3]);
+		for (i = 0; i < 5; i++)
+			table[i][j] = a[i];
+		for (i = 1; i < 5; i++)
+			table[4 + i][j] = a[i] * 5;
+		poly1305_to_26(a, rp[3 - j]);
+		for (i = 0; i < 5; i++)
+			table[9 + i][j] = a[i];
+		for (i = 1; i < 5; i++)
+			table[13 + i][j] = a[i] * 5;
+	}
+
+	poly1305_to_26(a, st->h);
+	poly1305_blocks_avx2(a, m, bytes, table);
+
+	/* fully carry the sums of the four lanes */
+	c = a[0] >> 26;
+	a[0] &= 0x3ffffff;
+	a[1] += c;
+	c = a[1] >> 26;
+	a[1] &= 0x3ffffff;
+	a[2] += c;
+	c = a[2] >> 26;
+	a[2] &= 0x3ffffff;
+	a[3] += c;
+	c = a[3] >> 26;
+	a[3] &= 0x3ffffff;
+	a[4] += c;
+	c = a[4] >> 26;
+	a[4] &= 0x3ffffff;
+	a[0] += c * 5;
+	c = a[0] >> 26;
+	a[0] &= 0x3ffffff;
+	a[1] += c;
+
+	/* back to radix 2^44 */
+	st->h[0] = a[0] + (a[1] << 26);
+	st->h[1] = (st->h[0] >> 44) + (a[2] << 8) + (a[3] << 34);
+	st->h[0] &= 0xfffffffffff;
+	st->h[2] = (st->h[1] >> 44) + (a[4] << 16);
+	st->h[1] &= 0xfffffffffff;
+
+	explicit_bzero(table, sizeof(table));
+	explicit_bzero(rp, sizeof(rp));
+
+	return bytes;
+}
+#endif
+
+static void
+poly1305_blocks(poly1305_state_internal_t *st, const unsigned char *m, size_t bytes)
+{
+	const uint64_t hibit = (st->final) ? 0 : ((uint64_t)1 << 40); /* 1 << 128 */
+	uint64_t h[3];
+	uint64_t t0, t1;
+
+#ifdef POLY1305_ASM
+	if (!st->final) {
+		size_t done = poly1305_blocks_simd(st, m, bytes);
+
+		m += done;
+		bytes -= done;
+	}
+#endif
+
+	h[0] = st->h[0];
+	h[1] = st->h[1];
+	h[2] = st->h[2];
+
+	while (bytes >= poly1305_block_size) {
+		/* h += m[i] */
+		t0 = U8TO64(m + 0);
+		t1 = U8TO64(m + 8);
+
+		h[0] += (t0) & 0xfffffffffff;
+		h[1] += ((t0 >> 44) | (t1 << 20)) & 0xfffffffffff;
+		h[2] += (((t1 >> 24)) & 0x3ffffffffff) | hibit;
+
+		/* h *= r */
+		poly1305_mul(h, st->r);
+
+		m += poly1305_block_size;
+		bytes -= poly1305_block_size;
+	}
+
+	st->h[0] = h[0];
+	st->h[1] = h[1];
+	st->h[2] = h[2];
+}
+
+static inline void
+poly1305_finish(poly1305_context *ctx, unsigned char mac[16])
+{
+	poly1305_state_internal_t *st = (poly1305_state_internal_t *)ctx;
+	uint64_t h0, h1, h2, c;
+	uint64_t g0, g1, g2;
+	uint64_t t0, t1;
+
+	/* process the remaining block */
+	if (st->leftover) {
+		size_t i = st->leftover;
+		st->buffer[i++] = 1;
+		for (; i < poly1305_block_size; i++)
+			st->buffer[i] = 0;
+		st->final = 1;
+		poly1305_blocks(st, st->buffer, poly1305_block_size);
+	}
+
+	/* fully carry h */
+	h0 = st->h[0];
+	h1 = st->h[1];
+	h2 = st->h[2];
+
+	c = (h1 >> 44);
+	h1 &= 0xfffffffffff;
+	h2 += c;
+	c = (h2 >> 42);
+	h2 &= 0x3ffffffffff;
+	h0 += c * 5;
+	c = (h0 >> 44);
+	h0 &= 0xfffffffffff;
+	h1 += c;
+	c = (h1 >> 44);
+	h1 &= 0xfffffffffff;
+	h2 += c;
+	c = (h2 >> 42);
+	h2 &= 0x3ffffffffff;
+	h0 += c * 5;
+	c = (h0 >> 44);
+	h0 &= 0xfffffffffff;
+	h1 += c;
+
+	/* compute h + -p */
+	g0 = h0 + 5;
+	c = (g0 >> 44);
+	g0 &= 0xfffffffffff;
+	g1 = h1 + c;
+	c = (g1 >> 44);
+	g1 &= 0xfffffffffff;
+	g2 = h2 + c - ((uint64_t)1 << 42);
+
+	/* select h if h < p, or h + -p if h >= p */
+	c = (g2 >> ((sizeof(uint64_t) * 8) - 1)) - 1;
+	g0 &= c;
+	g1 &= c;
+	g2 &= c;
+	c = ~c;
+	h0 = (h0 & c) | g0;
+	h1 = (h1 & c) | g1;
+	h2 = (h2 & c) | g2;
+
+	/* h = (h + pad) */
+	t0 = st->pad[0];
+	t1 = st->pad[1];
+
+	h0 += ((t0) & 0xfffffffffff);
+	c = (h0 >> 44);
+	h0 &= 0xfffffffffff;
+	h1 += (((t0 >> 44) | (t1 << 20)) & 0xfffffffffff) + c;
+	c = (h1 >> 44);
+	h1 &= 0xfffffffffff;
+	h2 += (((t1 >> 24)) & 0x3ffffffffff) + c;
+	h2 &= 0x3ffffffffff;
+
+	/* mac = h % (2^128) */
+	h0 = ((h0) | (h1 << 44));
+	h1 = ((h1 >> 20) | (h2 << 24));
+
+	U64TO8(mac + 0, h0);
+	U64TO8(mac + 8, h1);
+
+	/* zero out the state */
+	st->h[0] = 0;
+	st->h[1] = 0;
+	st->h[2] = 0;
+	st->r[0] = 0;
+	st->r[1] = 0;
+	st->r[2] = 0;
+	st->pad[0] = 0;
+	st->pad[1] = 0;
+}
+
+#else /* !POLY1305_DONNA64 */
+
 /*
  * poly1305 implementation using 32 bit * 32 bit = 64 bit multiplication
  * and 64 bit addition.
  */
 
-#define poly1305_block_size 16
-
 /* 17 + sizeof(size_t) + 14*sizeof(unsigned long) */
 typedef struct poly1305_state_internal_t {
 	unsigned long r[5];
@@ -173,44 +552,6 @@ poly1305_blocks(poly1305_state_internal_t *st, const unsigned char *m, size_t by
 	st->h[4] = h4;
 }
 
-static inline void
-poly1305_update(poly1305_context *ctx, const unsigned char *m, size_t bytes)
-{
-	poly1305_state_internal_t *st = (poly1305_state_internal_t *)ctx;
-	size_t i;
-
-	/* handle leftover */
-	if (st->leftover) {
-		size_t want = (poly1305_block_size - st->leftover);
-		if (want > bytes)
-			want = bytes;
-		for (i = 0; i < want; i++)
-			st->buffer[st->leftover + i] = m[i];
-		bytes -= want;
-		m += want;
-		st->leftover += want;
-		if (st->leftover < poly1305_block_size)
-			return;
-		poly1305_blocks(st, st->buffer, poly1305_block_size);
-		st->leftover = 0;
-	}
-
-	/* process full blocks */
-	if (bytes >= poly1305_block_size) {
-		size_t want = (bytes & ~(poly1305_block_size - 1));
-		poly1305_blocks(st, m, want);
-		m += want;
-		bytes -= want;
-	}
-
-	/* store leftover */
-	if (bytes) {
-		for (i = 0; i < bytes; i++)
-			st->buffer[st->leftover + i] = m[i];
-		st->leftover += bytes;
-	}
-}
-
 static inline void
 poly1305_finish(poly1305_context *ctx, unsigned char mac[16])
 {
@@ -319,3 +660,43 @@ poly1305_finish(poly1305_context *ctx, unsigned char mac[16])
 	st->pad[2] = 0;
 	st->pad[3] = 0;
 }
+
+#endif /* !POLY1305_DONNA64 */
+
+static inline void
+poly1305_update(poly1305_context *ctx, const unsigned char *m, size_t bytes)
+{
+	poly1305_state_internal_t *st = (poly1305_state_internal_t *)ctx;
+	size_t i;
+
+	/* handle leftover */
+	if (st->leftover) {
+		size_t want = (poly1305_block_size - st->leftover);
+		if (want > bytes)
+			want = bytes;
+		for (i = 0; i < want; i++)
+			st->buffer[st->leftover + i] = m[i];
+		bytes -= want;
+		m += want;
+		st->leftover += want;
+		if (st->leftover < poly1305_block_size)
+			return;
+		poly1305_blocks(st, st->buffer, poly1305_block_size);
+		st->leftover = 0;
+	}
+
+	/* process full blocks */
+	if (bytes >= poly1305_block_size) {
+		size_t want = (bytes & ~(poly1305_block_size - 1));
+		poly1305_blocks(st, m, want);
+		m += want;
+		bytes -= want;
+	}
+
+	/* store leftover */
+	if (bytes) {
+		for (i = 0; i < bytes; i++)
+			st->buffer[st->leftover + i] = m[i];
+		st->leftover += bytes;
+	}
+}
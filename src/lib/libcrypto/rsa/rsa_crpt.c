@@ -125,6 +125,7 @@ RSA_blinding_off(RSA *rsa)
 	BN_BLINDING_free(rsa->blinding);
 	rsa->blinding = NULL;
 	rsa->flags |= RSA_FLAG_NO_BLINDING;
+	rsa_blinding_id_new(rsa);
 }
 
 int
@@ -109,7 +109,11 @@
  *
  */
 
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include <openssl/opensslconf.h>
@@ -254,7 +258,7 @@ err:
 }
 
 static BN_BLINDING *
-rsa_get_blinding(RSA *rsa, int *local, BN_CTX *ctx)
+rsa_get_shared_blinding(RSA *rsa, int *local, BN_CTX *ctx)
 {
 	BN_BLINDING *ret;
 	int got_write_lock = 0;
@@ -310,6 +314,127 @@ err:
 	return ret;
 }
 
+/*
+ * Each thread keeps blinding parameters of its own for the RSA keys it
+ * has recently used, so that private key operations on a key shared by
+ * many threads neither take CRYPTO_LOCK_RSA nor share a BN_BLINDING.
+ * The cache is keyed by a per-key identifier rather than the RSA
+ * pointer, since a freed RSA may be reallocated at the same address.
+ * Entries of keys that were freed fall off the end of the cache, the
+ * rest is freed when the thread exits.
+ */
+
+#define RSA_BLINDING_CACHE_SIZE	8
+
+struct rsa_blinding_cache_entry {
+	uint64_t id;
+	BN_BLINDING *blinding;
+};
+
+struct rsa_blinding_cache {
+	/* Most recently used first. */
+	struct rsa_blinding_cache_entry entries[RSA_BLINDING_CACHE_SIZE];
+	size_t num_entries;
+};
+
+static atomic_uint_fast64_t rsa_blinding_next_id = 1;
+
+static pthread_once_t rsa_blinding_cache_key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t rsa_blinding_cache_key;
+static int rsa_blinding_cache_key_valid;
+
+/*
+ * Give rsa a new identifier, which invalidates the blinding parameters
+ * that threads have cached for it.
+ */
+void
+rsa_blinding_id_new(RSA *rsa)
+{
+	rsa->blinding_id = atomic_fetch_add(&rsa_blinding_next_id, 1);
+}
+
+static void
+rsa_blinding_cache_free(void *arg)
+{
+	struct rsa_blinding_cache *cache = arg;
+	size_t i;
+
+	for (i = 0; i < cache->num_entries; i++)
+		BN_BLINDING_free(cache->entries[i].blinding);
+	free(cache);
+}
+
+static void
+rsa_blinding_cache_key_init(void)
+{
+	if (pthread_key_create(&rsa_blinding_cache_key,
+	    rsa_blinding_cache_free) == 0)
+		rsa_blinding_cache_key_valid = 1;
+}
+
+static struct rsa_blinding_cache *
+rsa_blinding_cache_get(void)
+{
+	struct rsa_blinding_cache *cache;
+
+	(void) pthread_once(&rsa_blinding_cache_key_once,
+	    rsa_blinding_cache_key_init);
+	if (!rsa_blinding_cache_key_valid)
+		return NULL;
+
+	if ((cache = pthread_getspecific(rsa_blinding_cache_key)) != NULL)
+		return cache;
+
+	if ((cache = calloc(1, sizeof(*cache))) == NULL)
+		return NULL;
+	if (pthread_setspecific(rsa_blinding_cache_key, cache) != 0) {
+		free(cache);
+		return NULL;
+	}
+
+	return cache;
+}
+
+/*
+ * Return the blinding parameters of the calling thread for rsa. If the
+ * thread has no cache, fall back to the blinding shared by all threads.
+ */
+static BN_BLINDING *
+rsa_get_blinding(RSA *rsa, int *local, BN_CTX *ctx)
+{
+	struct rsa_blinding_cache *cache;
+	struct rsa_blinding_cache_entry entry;
+	size_t i;
+
+	if ((cache = rsa_blinding_cache_get()) == NULL)
+		return rsa_get_shared_blinding(rsa, local, ctx);
+
+	*local = 1;
+
+	for (i = 0; i < cache->num_entries; i++) {
+		if (cache->entries[i].id == rsa->blinding_id)
+			break;
+	}
+	if (i < cache->num_entries) {
+		entry = cache->entries[i];
+	} else {
+		entry.id = rsa->blinding_id;
+		if ((entry.blinding = RSA_setup_blinding(rsa, ctx)) == NULL)
+			return NULL;
+		if (cache->num_entries == RSA_BLINDING_CACHE_SIZE) {
+			i = RSA_BLINDING_CACHE_SIZE - 1;
+			BN_BLINDING_free(cache->entries[i].blinding);
+		} else
+			i = cache->num_entries++;
+	}
+
+	memmove(&cache->entries[1], &cache->entries[0],
+	    i * sizeof(cache->entries[0]));
+	cache->entries[0] = entry;
+
+	return entry.blinding;
+}
+
 static int
 rsa_blinding_convert(BN_BLINDING *b, BIGNUM *f, BIGNUM *unblind, BN_CTX *ctx)
 {
@@ -160,6 +160,7 @@ RSA_new_method(ENGINE *engine)
 
 	ret->references = 1;
 	ret->flags = ret->meth->flags & ~RSA_FLAG_NON_FIPS_ALLOW;
+	rsa_blinding_id_new(ret);
 
 	if (!CRYPTO_new_ex_data(CRYPTO_EX_INDEX_RSA, ret, &ret->ex_data))
 		goto err;
@@ -277,6 +278,9 @@ RSA_set0_key(RSA *r, BIGNUM *n, BIGNUM *e, BIGNUM *d)
 		r->d = d;
 	}
 
+	if (n != NULL || e != NULL)
+		rsa_blinding_id_new(r);
+
 	return 1;
 }
 
@@ -80,6 +80,9 @@ struct rsa_st {
 	 * NULL */
 	BN_BLINDING *blinding;
 	BN_BLINDING *mt_blinding;
+
+	/* Identifies the key in per-thread blinding caches. */
+	uint64_t blinding_id;
 };
 
 RSA_PSS_PARAMS *rsa_pss_params_create(const EVP_MD *sigmd, const EVP_MD *mgf1md,
@@ -87,6 +90,8 @@ RSA_PSS_PARAMS *rsa_pss_params_create(const EVP_MD *sigmd, const EVP_MD *mgf1md,
 int rsa_pss_get_param(const RSA_PSS_PARAMS *pss, const EVP_MD **pmd,
     const EVP_MD **pmgf1md, int *psaltlen);
 
+void rsa_blinding_id_new(RSA *rsa);
+
 extern int int_rsa_verify(int dtype, const unsigned char *m,
     unsigned int m_len, unsigned char *rm, size_t *prm_len,
     const unsigned char *sigbuf, size_t siglen, RSA *rsa);
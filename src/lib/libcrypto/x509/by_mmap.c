@@ -0,0 +1,414 @@
+/* $OpenBSD$ */
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * Lookup of certificates and CRLs in trust store files, as written by
+ * openssl certstore. The file is mapped read-only, so that its pages are
+ * shared by all processes using it. Its index is validated and copied
+ * when the file is loaded, so that a file modified in place cannot make
+ * lookups read outside of the mapping. An object is parsed and added to
+ * the store the first time an object with the same name hash is looked up.
+ */
+
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <openssl/err.h>
+#include <openssl/x509.h>
+
+#include "bytestring.h"
+#include "x509_local.h"
+
+struct by_mmap_entry {
+	uint32_t type;
+	uint32_t hash;
+	uint32_t offset;
+	uint32_t length;
+};
+
+typedef struct lookup_mmap_file_st {
+	uint8_t *data;
+	size_t data_len;
+	struct by_mmap_entry *entries;	/* Validated copy of the index */
+	size_t count;
+	uint8_t *loaded;	/* Entries already added to the store */
+} BY_MMAP_FILE;
+
+typedef struct lookup_mmap_st {
+	BY_MMAP_FILE *files;
+	size_t num_files;
+} BY_MMAP;
+
+static int mmap_ctrl(X509_LOOKUP *ctx, int cmd, const char *argp, long argl,
+    char **ret);
+static int new_mmap(X509_LOOKUP *lu);
+static void free_mmap(X509_LOOKUP *lu);
+static int get_by_subject(X509_LOOKUP *xl, int type, X509_NAME *name,
+    X509_OBJECT *ret);
+
+static X509_LOOKUP_METHOD x509_mmap_lookup = {
+	.name = "Load certs from a mapped trust store file",
+	.new_item = new_mmap,
+	.free = free_mmap,
+	.init = NULL,
+	.shutdown = NULL,
+	.ctrl = mmap_ctrl,
+	.get_by_subject = get_by_subject,
+	.get_by_issuer_serial = NULL,
+	.get_by_fingerprint = NULL,
+	.get_by_alias = NULL,
+};
+
+X509_LOOKUP_METHOD *
+X509_LOOKUP_mmap(void)
+{
+	return &x509_mmap_lookup;
+}
+LCRYPTO_ALIAS(X509_LOOKUP_mmap);
+
+static int
+new_mmap(X509_LOOKUP *lu)
+{
+	BY_MMAP *a;
+
+	if ((a = calloc(1, sizeof(*a))) == NULL) {
+		X509error(ERR_R_MALLOC_FAILURE);
+		return 0;
+	}
+	lu->method_data = (char *)a;
+
+	return 1;
+}
+
+static void
+by_mmap_file_free(BY_MMAP_FILE *file)
+{
+	if (file->data != NULL)
+		munmap(file->data, file->data_len);
+	free(file->entries);
+	free(file->loaded);
+}
+
+static void
+free_mmap(X509_LOOKUP *lu)
+{
+	BY_MMAP *a;
+	size_t i;
+
+	a = (BY_MMAP *)lu->method_data;
+	for (i = 0; i < a->num_files; i++)
+		by_mmap_file_free(&a->files[i]);
+	free(a->files);
+	free(a);
+}
+
+static int
+by_mmap_entry_get(CBS *cbs, struct by_mmap_entry *entry)
+{
+	if (!CBS_get_u32(cbs, &entry->type))
+		return 0;
+	if (!CBS_get_u32(cbs, &entry->hash))
+		return 0;
+	if (!CBS_get_u32(cbs, &entry->offset))
+		return 0;
+	if (!CBS_get_u32(cbs, &entry->length))
+		return 0;
+
+	return 1;
+}
+
+static int
+by_mmap_key_cmp(uint32_t type1, uint32_t hash1, uint32_t type2,
+    uint32_t hash2)
+{
+	if (type1 != type2)
+		return type1 < type2 ? -1 : 1;
+	if (hash1 != hash2)
+		return hash1 < hash2 ? -1 : 1;
+	return 0;
+}
+
+/*
+ * Check the header and that the index is sorted and only refers to data
+ * after the index, and copy the index, so that lookups can trust it.
+ */
+static int
+by_mmap_file_parse(BY_MMAP_FILE *file)
+{
+	struct by_mmap_entry *entry, last;
+	size_t data_start, i;
+	uint32_t count;
+	CBS cbs, magic, index;
+
+	CBS_init(&cbs, file->data, file->data_len);
+
+	if (!CBS_get_bytes(&cbs, &magic, X509_TRUST_STORE_MAGIC_LEN))
+		goto bad;
+	if (!CBS_mem_equal(&magic, X509_TRUST_STORE_MAGIC,
+	    X509_TRUST_STORE_MAGIC_LEN))
+		goto bad;
+	if (!CBS_get_u32(&cbs, &count))
+		goto bad;
+	if (count > CBS_len(&cbs) / X509_TRUST_STORE_ENTRY_LEN)
+		goto bad;
+	if (!CBS_get_bytes(&cbs, &index, count * X509_TRUST_STORE_ENTRY_LEN))
+		goto bad;
+	data_start = file->data_len - CBS_len(&cbs);
+
+	if (count == 0)
+		return 1;
+
+	if ((file->entries = calloc(count, sizeof(*file->entries))) == NULL) {
+		X509error(ERR_R_MALLOC_FAILURE);
+		return 0;
+	}
+	file->count = count;
+
+	memset(&last, 0, sizeof(last));
+	for (i = 0; i < count; i++) {
+		entry = &file->entries[i];
+		if (!by_mmap_entry_get(&index, entry))
+			goto bad;
+		if (entry->type != X509_LU_X509 && entry->type != X509_LU_CRL)
+			goto bad;
+		if (by_mmap_key_cmp(entry->type, entry->hash, last.type,
+		    last.hash) < 0)
+			goto bad;
+		if (entry->offset < data_start || entry->length == 0)
+			goto bad;
+		if (entry->length > file->data_len - entry->offset)
+			goto bad;
+		last = *entry;
+	}
+
+	return 1;
+
+ bad:
+	X509error(X509_R_BAD_X509_FILETYPE);
+
+	return 0;
+}
+
+static int
+by_mmap_load(BY_MMAP *ctx, const char *path)
+{
+	BY_MMAP_FILE file, *files;
+	struct stat sb;
+	void *data;
+	int fd = -1;
+	int ret = 0;
+
+	memset(&file, 0, sizeof(file));
+
+	if (path == NULL || *path == '\0') {
+		X509error(X509_R_BAD_X509_FILETYPE);
+		goto err;
+	}
+	if ((fd = open(path, O_RDONLY | O_CLOEXEC)) == -1) {
+		X509error(ERR_R_SYS_LIB);
+		goto err;
+	}
+	if (fstat(fd, &sb) == -1) {
+		X509error(ERR_R_SYS_LIB);
+		goto err;
+	}
+	/* Offsets are 32 bits, so a valid file is smaller than 4GB. */
+	if (!S_ISREG(sb.st_mode) || sb.st_size <= 0 ||
+	    (uint64_t)sb.st_size > UINT32_MAX) {
+		X509error(X509_R_BAD_X509_FILETYPE);
+		goto err;
+	}
+	if ((data = mmap(NULL, sb.st_size, PROT_READ, MAP_SHARED, fd,
+	    0)) == MAP_FAILED) {
+		X509error(ERR_R_SYS_LIB);
+		goto err;
+	}
+	file.data = data;
+	file.data_len = sb.st_size;
+
+	if (!by_mmap_file_parse(&file))
+		goto err;
+	if (file.count > 0 &&
+	    (file.loaded = calloc(file.count, sizeof(*file.loaded))) == NULL) {
+		X509error(ERR_R_MALLOC_FAILURE);
+		goto err;
+	}
+
+	if ((files = recallocarray(ctx->files, ctx->num_files,
+	    ctx->num_files + 1, sizeof(*files))) == NULL) {
+		X509error(ERR_R_MALLOC_FAILURE);
+		goto err;
+	}
+	ctx->files = files;
+	ctx->files[ctx->num_files++] = file;
+	memset(&file, 0, sizeof(file));
+
+	ret = 1;
+
+ err:
+	by_mmap_file_free(&file);
+	if (fd != -1)
+		close(fd);
+
+	return ret;
+}
+
+static int
+mmap_ctrl(X509_LOOKUP *ctx, int cmd, const char *argp, long argl,
+    char **retp)
+{
+	BY_MMAP *ld;
+
+	ld = (BY_MMAP *)ctx->method_data;
+
+	switch (cmd) {
+	case X509_L_MMAP_LOAD:
+		return by_mmap_load(ld, argp);
+	}
+
+	return 0;
+}
+
+/*
+ * Parse an entry and add it to the store. Return 1 if the entry was added
+ * or can never be added because it is malformed, and 0 if adding it failed
+ * and may be retried.
+ */
+static int
+by_mmap_add_entry(X509_LOOKUP *xl, BY_MMAP_FILE *file,
+    const struct by_mmap_entry *entry)
+{
+	const unsigned char *p, *end;
+	X509_CRL *crl;
+	X509 *x509;
+	int ret = 1;
+
+	if (entry->offset > file->data_len ||
+	    entry->length > file->data_len - entry->offset)
+		return 1;
+
+	p = file->data + entry->offset;
+	end = p + entry->length;
+
+	switch (entry->type) {
+	case X509_LU_X509:
+		if ((x509 = d2i_X509(NULL, &p, entry->length)) == NULL)
+			break;
+		if (p == end)
+			ret = X509_STORE_add_cert(xl->store_ctx, x509);
+		X509_free(x509);
+		break;
+	case X509_LU_CRL:
+		if ((crl = d2i_X509_CRL(NULL, &p, entry->length)) == NULL)
+			break;
+		if (p == end)
+			ret = X509_STORE_add_crl(xl->store_ctx, crl);
+		X509_CRL_free(crl);
+		break;
+	}
+
+	return ret;
+}
+
+/*
+ * Add all objects of the given type and name hash to the store. Objects
+ * whose name only shares the hash are added too, since a lookup for their
+ * own name will not parse them again.
+ */
+static void
+by_mmap_file_load_hash(X509_LOOKUP *xl, BY_MMAP_FILE *file, int type,
+    uint32_t hash)
+{
+	const struct by_mmap_entry *entry;
+	size_t lo, hi, mid;
+	int loaded;
+
+	lo = 0;
+	hi = file->count;
+	while (lo < hi) {
+		mid = lo + (hi - lo) / 2;
+		entry = &file->entries[mid];
+		if (by_mmap_key_cmp(entry->type, entry->hash, type, hash) < 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	for (; lo < file->count; lo++) {
+		entry = &file->entries[lo];
+		if (by_mmap_key_cmp(entry->type, entry->hash, type, hash) != 0)
+			break;
+
+		CRYPTO_r_lock(CRYPTO_LOCK_X509_STORE);
+		loaded = file->loaded[lo];
+		CRYPTO_r_unlock(CRYPTO_LOCK_X509_STORE);
+		if (loaded)
+			continue;
+
+		/*
+		 * Another thread may be adding the same entry, the store
+		 * ignores objects that it already holds.
+		 */
+		if (!by_mmap_add_entry(xl, file, entry))
+			continue;	/* Retried by the next lookup */
+
+		CRYPTO_w_lock(CRYPTO_LOCK_X509_STORE);
+		file->loaded[lo] = 1;
+		CRYPTO_w_unlock(CRYPTO_LOCK_X509_STORE);
+	}
+}
+
+static int
+get_by_subject(X509_LOOKUP *xl, int type, X509_NAME *name, X509_OBJECT *ret)
+{
+	BY_MMAP *ctx;
+	X509_OBJECT *tmp;
+	uint32_t hash;
+	size_t i;
+
+	if (name == NULL)
+		return 0;
+	if (type != X509_LU_X509 && type != X509_LU_CRL) {
+		X509error(X509_R_WRONG_LOOKUP_TYPE);
+		return 0;
+	}
+
+	ctx = (BY_MMAP *)xl->method_data;
+
+	hash = (uint32_t)X509_NAME_hash(name);
+	for (i = 0; i < ctx->num_files; i++)
+		by_mmap_file_load_hash(xl, &ctx->files[i], type, hash);
+
+	CRYPTO_r_lock(CRYPTO_LOCK_X509_STORE);
+	tmp = x509_store_object_by_subject(xl->store_ctx, type, name);
+	CRYPTO_r_unlock(CRYPTO_LOCK_X509_STORE);
+
+	if (tmp == NULL)
+		return 0;
+
+	ret->type = tmp->type;
+	memcpy(&ret->data, &tmp->data, sizeof(ret->data));
+
+	return 1;
+}
@@ -0,0 +1,351 @@
+/* $OpenBSD$ */
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/* x509_chain_cache */
+
+/*
+ * The chain cache is an optional per X509_STORE cache of the results of
+ * successful calls to X509_verify_cert().
+ *
+ * An entry is keyed on a digest of the presented certificates (the leaf
+ * and the untrusted intermediates, in order) and of the verification
+ * parameters that affect the result: flags, purpose, trust, depth,
+ * security level and the host names, email address and IP address to
+ * match. It holds the verified chain, the host name that matched and
+ * the time window in which every certificate of the chain is valid.
+ *
+ * Finding an entry allows X509_verify_cert() to skip chain building and
+ * all checks. Only results that do not depend on anything besides the
+ * key, the store contents and the time are cached, so the cache is not
+ * used with a verify callback, revocation or policy checks. The cache
+ * is flushed when a certificate or CRL is added to the store and an
+ * entry is discarded once the check time leaves its validity window.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <openssl/x509v3.h>
+
+#include "vpm_int.h"
+#include "x509_chain_cache.h"
+#include "x509_internal.h"
+
+static int
+x509_chain_cache_cmp(struct x509_chain_cache_entry *e1,
+    struct x509_chain_cache_entry *e2)
+{
+	return memcmp(e1->key, e2->key, sizeof(e1->key));
+}
+
+RB_PROTOTYPE_STATIC(x509_chain_cache_tree, x509_chain_cache_entry, entry,
+    x509_chain_cache_cmp);
+RB_GENERATE_STATIC(x509_chain_cache_tree, x509_chain_cache_entry, entry,
+    x509_chain_cache_cmp);
+
+static void
+x509_chain_cache_entry_free(struct x509_chain_cache_entry *entry)
+{
+	if (entry == NULL)
+		return;
+	sk_X509_pop_free(entry->chain, X509_free);
+	free(entry->peername);
+	free(entry);
+}
+
+/* Must be called with the cache mutex held. */
+static void
+x509_chain_cache_remove(struct x509_chain_cache *cache,
+    struct x509_chain_cache_entry *entry)
+{
+	TAILQ_REMOVE(&cache->lru, entry, queue);
+	RB_REMOVE(x509_chain_cache_tree, &cache->tree, entry);
+	x509_chain_cache_entry_free(entry);
+	cache->count--;
+}
+
+/* Must be called with the cache mutex held. */
+static void
+x509_chain_cache_trim(struct x509_chain_cache *cache, size_t max)
+{
+	while (cache->count > max)
+		x509_chain_cache_remove(cache, TAILQ_LAST(&cache->lru,
+		    x509_chain_cache_lru));
+}
+
+struct x509_chain_cache *
+x509_chain_cache_new(void)
+{
+	struct x509_chain_cache *cache;
+
+	if ((cache = calloc(1, sizeof(*cache))) == NULL)
+		return NULL;
+
+	RB_INIT(&cache->tree);
+	TAILQ_INIT(&cache->lru);
+
+	if (pthread_mutex_init(&cache->mutex, NULL) != 0) {
+		free(cache);
+		return NULL;
+	}
+
+	return cache;
+}
+
+void
+x509_chain_cache_free(struct x509_chain_cache *cache)
+{
+	if (cache == NULL)
+		return;
+
+	x509_chain_cache_trim(cache, 0);
+	pthread_mutex_destroy(&cache->mutex);
+	free(cache);
+}
+
+/*
+ * Set the maximum number of cached chains, discarding the least recently
+ * used entries if there are more. A maximum of 0 disables the cache.
+ */
+int
+x509_chain_cache_set_max(struct x509_chain_cache *cache, size_t max)
+{
+	if (pthread_mutex_lock(&cache->mutex) != 0)
+		return 0;
+	cache->max = max;
+	x509_chain_cache_trim(cache, max);
+	(void) pthread_mutex_unlock(&cache->mutex);
+
+	return 1;
+}
+
+/*
+ * Discard all entries, called when the contents of the store change.
+ */
+void
+x509_chain_cache_flush(struct x509_chain_cache *cache)
+{
+	if (cache == NULL)
+		return;
+
+	if (pthread_mutex_lock(&cache->mutex) != 0)
+		return;
+	x509_chain_cache_trim(cache, 0);
+	(void) pthread_mutex_unlock(&cache->mutex);
+}
+
+static void
+x509_chain_cache_key_update(SHA256_CTX *sha, const void *data, size_t len)
+{
+	uint64_t len64 = len;
+
+	/* Length prefix, so that adjacent fields cannot be confused. */
+	SHA256_Update(sha, &len64, sizeof(len64));
+	if (len > 0)
+		SHA256_Update(sha, data, len);
+}
+
+static void
+x509_chain_cache_key_int(SHA256_CTX *sha, long value)
+{
+	int64_t value64 = value;
+
+	SHA256_Update(sha, &value64, sizeof(value64));
+}
+
+/*
+ * Compute the key for verifying ctx->cert with the untrusted certificates
+ * and parameters of ctx. Returns 0 if a certificate cannot be hashed.
+ */
+int
+x509_chain_cache_key(X509_STORE_CTX *ctx,
+    unsigned char key[X509_CHAIN_CACHE_KEY_LEN])
+{
+	X509_VERIFY_PARAM *param = ctx->param;
+	X509_VERIFY_PARAM_ID *id = param->id;
+	SHA256_CTX sha;
+	X509 *cert;
+	char *host;
+	int i;
+
+	SHA256_Init(&sha);
+
+	if (!x509v3_cache_extensions(ctx->cert))
+		return 0;
+	x509_chain_cache_key_update(&sha, ctx->cert->hash,
+	    sizeof(ctx->cert->hash));
+
+	x509_chain_cache_key_int(&sha, sk_X509_num(ctx->untrusted));
+	for (i = 0; i < sk_X509_num(ctx->untrusted); i++) {
+		cert = sk_X509_value(ctx->untrusted, i);
+		if (!x509v3_cache_extensions(cert))
+			return 0;
+		x509_chain_cache_key_update(&sha, cert->hash,
+		    sizeof(cert->hash));
+	}
+
+	x509_chain_cache_key_int(&sha, param->flags);
+	x509_chain_cache_key_int(&sha, param->purpose);
+	x509_chain_cache_key_int(&sha, param->trust);
+	x509_chain_cache_key_int(&sha, param->depth);
+	x509_chain_cache_key_int(&sha, param->security_level);
+
+	x509_chain_cache_key_int(&sha, id->hostflags);
+	x509_chain_cache_key_int(&sha, sk_OPENSSL_STRING_num(id->hosts));
+	for (i = 0; i < sk_OPENSSL_STRING_num(id->hosts); i++) {
+		host = sk_OPENSSL_STRING_value(id->hosts, i);
+		x509_chain_cache_key_update(&sha, host, strlen(host));
+	}
+	x509_chain_cache_key_update(&sha, id->email, id->emaillen);
+	x509_chain_cache_key_update(&sha, id->ip, id->iplen);
+
+	SHA256_Final(key, &sha);
+
+	return 1;
+}
+
+static time_t
+x509_chain_cache_check_time(X509_STORE_CTX *ctx)
+{
+	if (ctx->param->flags & X509_V_FLAG_USE_CHECK_TIME)
+		return ctx->param->check_time;
+
+	return time(NULL);
+}
+
+/*
+ * Look up the chain for key and if there is one that is still valid, put
+ * it on ctx as X509_verify_cert() would have. Returns 1 if a chain was
+ * found, 0 otherwise.
+ */
+int
+x509_chain_cache_find(struct x509_chain_cache *cache, X509_STORE_CTX *ctx,
+    const unsigned char key[X509_CHAIN_CACHE_KEY_LEN])
+{
+	struct x509_chain_cache_entry candidate, *found;
+	STACK_OF(X509) *chain = NULL;
+	char *peername = NULL;
+	int num_untrusted = 0;
+	time_t now;
+	int ret = 0;
+
+	memset(&candidate, 0, sizeof(candidate));
+	memcpy(candidate.key, key, sizeof(candidate.key));
+
+	now = x509_chain_cache_check_time(ctx);
+
+	if (pthread_mutex_lock(&cache->mutex) != 0)
+		return 0;
+	if (cache->max == 0)
+		goto done;
+	if ((found = RB_FIND(x509_chain_cache_tree, &cache->tree,
+	    &candidate)) == NULL)
+		goto done;
+	if (now < found->not_before || now > found->not_after) {
+		x509_chain_cache_remove(cache, found);
+		goto done;
+	}
+	if ((chain = X509_chain_up_ref(found->chain)) == NULL)
+		goto done;
+	if (found->peername != NULL &&
+	    (peername = strdup(found->peername)) == NULL)
+		goto done;
+	num_untrusted = found->num_untrusted;
+
+	TAILQ_REMOVE(&cache->lru, found, queue);
+	TAILQ_INSERT_HEAD(&cache->lru, found, queue);
+
+	ret = 1;
+
+ done:
+	(void) pthread_mutex_unlock(&cache->mutex);
+
+	if (!ret) {
+		sk_X509_pop_free(chain, X509_free);
+		return 0;
+	}
+
+	sk_X509_pop_free(ctx->chain, X509_free);
+	ctx->chain = chain;
+	ctx->num_untrusted = num_untrusted;
+	ctx->error = X509_V_OK;
+	ctx->error_depth = 0;
+	ctx->current_cert = ctx->cert;
+
+	free(ctx->param->id->peername);
+	ctx->param->id->peername = peername;
+
+	return 1;
+}
+
+/*
+ * Add the chain that X509_verify_cert() successfully verified on ctx.
+ * Previously added entries for the same key are *not* replaced.
+ */
+void
+x509_chain_cache_add(struct x509_chain_cache *cache, X509_STORE_CTX *ctx,
+    const unsigned char key[X509_CHAIN_CACHE_KEY_LEN])
+{
+	struct x509_chain_cache_entry *new;
+	X509 *cert;
+	int i;
+
+	if (ctx->chain == NULL || sk_X509_num(ctx->chain) <= 0)
+		return;
+
+	if ((new = calloc(1, sizeof(*new))) == NULL)
+		return;
+	memcpy(new->key, key, sizeof(new->key));
+
+	new->not_before = 0;
+	new->not_after = -1;
+	for (i = 0; i < sk_X509_num(ctx->chain); i++) {
+		cert = sk_X509_value(ctx->chain, i);
+		if (!x509v3_cache_extensions(cert))
+			goto err;
+		if (cert->not_before == -1 || cert->not_after == -1)
+			goto err;
+		if (cert->not_before > new->not_before)
+			new->not_before = cert->not_before;
+		if (new->not_after == -1 || cert->not_after < new->not_after)
+			new->not_after = cert->not_after;
+	}
+
+	if ((new->chain = X509_chain_up_ref(ctx->chain)) == NULL)
+		goto err;
+	new->num_untrusted = ctx->num_untrusted;
+	if (ctx->param->id->peername != NULL &&
+	    (new->peername = strdup(ctx->param->id->peername)) == NULL)
+		goto err;
+
+	if (pthread_mutex_lock(&cache->mutex) != 0)
+		goto err;
+	if (cache->max == 0) {
+		(void) pthread_mutex_unlock(&cache->mutex);
+		goto err;
+	}
+	x509_chain_cache_trim(cache, cache->max - 1);
+	if (RB_INSERT(x509_chain_cache_tree, &cache->tree, new) == NULL) {
+		TAILQ_INSERT_HEAD(&cache->lru, new, queue);
+		cache->count++;
+		new = NULL;
+	}
+	(void) pthread_mutex_unlock(&cache->mutex);
+
+ err:
+	x509_chain_cache_entry_free(new);
+}
@@ -0,0 +1,70 @@
+/* $OpenBSD$ */
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/* x509_chain_cache */
+#ifndef HEADER_X509_CHAIN_CACHE_H
+#define HEADER_X509_CHAIN_CACHE_H
+
+#include <sys/tree.h>
+#include <sys/queue.h>
+
+#include <pthread.h>
+#include <time.h>
+
+#include <openssl/sha.h>
+#include <openssl/x509.h>
+
+__BEGIN_HIDDEN_DECLS
+
+#define X509_CHAIN_CACHE_KEY_LEN	SHA256_DIGEST_LENGTH
+
+struct x509_chain_cache_entry {
+	RB_ENTRY(x509_chain_cache_entry) entry;
+	TAILQ_ENTRY(x509_chain_cache_entry) queue;	/* LRU of entries */
+	unsigned char key[X509_CHAIN_CACHE_KEY_LEN];
+	STACK_OF(X509) *chain;		/* Verified chain, leaf first */
+	int num_untrusted;
+	char *peername;			/* Matched host name or NULL */
+	time_t not_before;		/* Latest notBefore in the chain */
+	time_t not_after;		/* Earliest notAfter in the chain */
+};
+
+RB_HEAD(x509_chain_cache_tree, x509_chain_cache_entry);
+TAILQ_HEAD(x509_chain_cache_lru, x509_chain_cache_entry);
+
+struct x509_chain_cache {
+	struct x509_chain_cache_tree tree;
+	struct x509_chain_cache_lru lru;
+	size_t count;
+	size_t max;
+	pthread_mutex_t mutex;
+};
+
+struct x509_chain_cache *x509_chain_cache_new(void);
+void x509_chain_cache_free(struct x509_chain_cache *cache);
+int x509_chain_cache_set_max(struct x509_chain_cache *cache, size_t max);
+void x509_chain_cache_flush(struct x509_chain_cache *cache);
+int x509_chain_cache_key(X509_STORE_CTX *ctx,
+    unsigned char key[X509_CHAIN_CACHE_KEY_LEN]);
+int x509_chain_cache_find(struct x509_chain_cache *cache, X509_STORE_CTX *ctx,
+    const unsigned char key[X509_CHAIN_CACHE_KEY_LEN]);
+void x509_chain_cache_add(struct x509_chain_cache *cache, X509_STORE_CTX *ctx,
+    const unsigned char key[X509_CHAIN_CACHE_KEY_LEN]);
+
+__END_HIDDEN_DECLS
+
+#endif
@@ -29,6 +29,9 @@
 #define X509_VERIFY_MAX_CHAIN_CERTS	32	/* Max depth of a chain */
 #define X509_VERIFY_MAX_SIGCHECKS	256	/* Max signature checks */
 
+/* Candidate issuers are looked up by name if there are at least this many. */
+#define X509_VERIFY_INDEX_MIN_CERTS	8
+
 /*
  * Limit the number of names and constraints we will check in a chain
  * to avoid a hostile input DOS
@@ -64,6 +67,8 @@ struct x509_verify_chain {
 	struct x509_constraints_names *names;	/* All names from all certs */
 };
 
+struct x509_verify_index;
+
 struct x509_verify_ctx {
 	X509_STORE_CTX *xsc;
 	struct x509_verify_chain **chains;	/* Validated chains */
@@ -73,6 +78,9 @@ struct x509_verify_ctx {
 	size_t chains_count;
 	STACK_OF(X509) *roots;		/* Trusted roots for this validation */
 	STACK_OF(X509) *intermediates;	/* Intermediates provided by peer */
+	struct x509_verify_index *roots_index;	/* Roots by subject name */
+	struct x509_verify_index *intermediates_index;
+	int indexed;			/* Indexes have been built */
 	time_t *check_time;		/* Time for validity checks */
 	int purpose;			/* Cert purpose we are validating */
 	size_t max_chains;		/* Max chains to return */
@@ -29,9 +29,14 @@
  * validity of "child". It allows us to skip doing the public key math
  * when validating a certificate chain. It does not allow us to skip
  * any other steps of validation (times, names, key usage, etc.)
+ *
+ * The cache is split into X509_ISSUER_CACHE_SHARDS shards, each with its
+ * own mutex, tree and LRU, so that concurrent chain verifications only
+ * contend when they look up entries in the same shard.
  */
 
 #include <pthread.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "x509_issuer_cache.h"
@@ -45,17 +50,53 @@ x509_issuer_cmp(struct x509_issuer *x1, struct x509_issuer *x2)
 	return memcmp(x1->child_md, x2->child_md, EVP_MAX_MD_SIZE);
 }
 
-static size_t x509_issuer_cache_count;
+#define X509_ISSUER_SHARD_INITIALIZER(n) {				\
+	.mutex = PTHREAD_MUTEX_INITIALIZER,				\
+	.tree = RB_INITIALIZER(&x509_issuer_shards[n].tree),		\
+	.lru = TAILQ_HEAD_INITIALIZER(x509_issuer_shards[n].lru),	\
+}
+
 static size_t x509_issuer_cache_max = X509_ISSUER_CACHE_MAX;
-static RB_HEAD(x509_issuer_tree, x509_issuer) x509_issuer_cache =
-    RB_INITIALIZER(&x509_issuer_cache);
-static TAILQ_HEAD(lruqueue, x509_issuer) x509_issuer_lru =
-    TAILQ_HEAD_INITIALIZER(x509_issuer_lru);
-static pthread_mutex_t x509_issuer_tree_mutex = PTHREAD_MUTEX_INITIALIZER;
+static struct x509_issuer_shard x509_issuer_shards[] = {
+	X509_ISSUER_SHARD_INITIALIZER(0),
+	X509_ISSUER_SHARD_INITIALIZER(1),
+	X509_ISSUER_SHARD_INITIALIZER(2),
+	X509_ISSUER_SHARD_INITIALIZER(3),
+	X509_ISSUER_SHARD_INITIALIZER(4),
+	X509_ISSUER_SHARD_INITIALIZER(5),
+	X509_ISSUER_SHARD_INITIALIZER(6),
+	X509_ISSUER_SHARD_INITIALIZER(7),
+	X509_ISSUER_SHARD_INITIALIZER(8),
+	X509_ISSUER_SHARD_INITIALIZER(9),
+	X509_ISSUER_SHARD_INITIALIZER(10),
+	X509_ISSUER_SHARD_INITIALIZER(11),
+	X509_ISSUER_SHARD_INITIALIZER(12),
+	X509_ISSUER_SHARD_INITIALIZER(13),
+	X509_ISSUER_SHARD_INITIALIZER(14),
+	X509_ISSUER_SHARD_INITIALIZER(15),
+};
+
+#define CTASSERT(x)	extern char  _ctassert[(x) ? 1 : -1 ] \
+			    __attribute__((__unused__))
+
+CTASSERT((sizeof(x509_issuer_shards) / sizeof(*x509_issuer_shards)) ==
+    X509_ISSUER_CACHE_SHARDS);
 
 RB_PROTOTYPE(x509_issuer_tree, x509_issuer, entry, x509_issuer_cmp);
 RB_GENERATE(x509_issuer_tree, x509_issuer, entry, x509_issuer_cmp);
 
+/*
+ * The digests are cryptographic hashes, so any of their bytes will do
+ * to spread the entries evenly over the shards.
+ */
+static struct x509_issuer_shard *
+x509_issuer_cache_shard(const unsigned char *parent_md,
+    const unsigned char *child_md)
+{
+	return &x509_issuer_shards[(parent_md[0] ^ child_md[0]) &
+	    (X509_ISSUER_CACHE_SHARDS - 1)];
+}
+
 /*
  * Set the maximum number of cached entries. On additions to the cache
  * the least recently used entries will be discarded so that the cache
@@ -65,33 +106,52 @@ RB_GENERATE(x509_issuer_tree, x509_issuer, entry, x509_issuer_cmp);
 int
 x509_issuer_cache_set_max(size_t max)
 {
-	if (pthread_mutex_lock(&x509_issuer_tree_mutex) != 0)
-		return 0;
+	size_t i;
+	int ret = 0;
+
+	/* Hold every shard mutex so that no addition sees a partial update. */
+	for (i = 0; i < X509_ISSUER_CACHE_SHARDS; i++) {
+		if (pthread_mutex_lock(&x509_issuer_shards[i].mutex) != 0)
+			goto err;
+	}
 	x509_issuer_cache_max = max;
-	(void) pthread_mutex_unlock(&x509_issuer_tree_mutex);
 
-	return 1;
+	ret = 1;
+
+ err:
+	while (i-- > 0)
+		(void) pthread_mutex_unlock(&x509_issuer_shards[i].mutex);
+
+	return ret;
 }
 
 /*
- * Free the oldest entry in the issuer cache. Returns 1
- * if an entry was successfully freed, 0 otherwise. Must
- * be called with x509_issuer_tree_mutex held.
+ * Each shard holds at most its share of the maximum number of entries,
+ * rounded up so that a small non zero maximum does not disable a shard.
  */
-void
-x509_issuer_cache_free_oldest()
+static size_t
+x509_issuer_cache_shard_max(void)
+{
+	return (x509_issuer_cache_max + X509_ISSUER_CACHE_SHARDS - 1) /
+	    X509_ISSUER_CACHE_SHARDS;
+}
+
+/*
+ * Free the oldest entry in a shard of the issuer cache. Must
+ * be called with the shard mutex held.
+ */
+static void
+x509_issuer_cache_free_oldest(struct x509_issuer_shard *shard)
 {
 	struct x509_issuer *old;
 
-	if (x509_issuer_cache_count == 0)
+	if (shard->count == 0)
 		return;
-	old = TAILQ_LAST(&x509_issuer_lru, lruqueue);
-	TAILQ_REMOVE(&x509_issuer_lru, old, queue);
-	RB_REMOVE(x509_issuer_tree, &x509_issuer_cache, old);
-	free(old->parent_md);
-	free(old->child_md);
+	old = TAILQ_LAST(&shard->lru, x509_issuer_lru);
+	TAILQ_REMOVE(&shard->lru, old, queue);
+	RB_REMOVE(x509_issuer_tree, &shard->tree, old);
 	free(old);
-	x509_issuer_cache_count--;
+	shard->count--;
 }
 
 /*
@@ -100,11 +160,40 @@ x509_issuer_cache_free_oldest()
 void
 x509_issuer_cache_free()
 {
-	if (pthread_mutex_lock(&x509_issuer_tree_mutex) != 0)
-		return;
-	while (x509_issuer_cache_count > 0)
-		x509_issuer_cache_free_oldest();
-	(void) pthread_mutex_unlock(&x509_issuer_tree_mutex);
+	struct x509_issuer_shard *shard;
+	size_t i;
+
+	for (i = 0; i < X509_ISSUER_CACHE_SHARDS; i++) {
+		shard = &x509_issuer_shards[i];
+		if (pthread_mutex_lock(&shard->mutex) != 0)
+			continue;
+		while (shard->count > 0)
+			x509_issuer_cache_free_oldest(shard);
+		(void) pthread_mutex_unlock(&shard->mutex);
+	}
+}
+
+/*
+ * Return the number of entries and the number of lookups that found,
+ * or did not find, an entry since the library was loaded.
+ */
+void
+x509_issuer_cache_stats(struct x509_issuer_cache_stats *stats)
+{
+	struct x509_issuer_shard *shard;
+	size_t i;
+
+	memset(stats, 0, sizeof(*stats));
+
+	for (i = 0; i < X509_ISSUER_CACHE_SHARDS; i++) {
+		shard = &x509_issuer_shards[i];
+		if (pthread_mutex_lock(&shard->mutex) != 0)
+			continue;
+		stats->entries += shard->count;
+		stats->hits += shard->hits;
+		stats->misses += shard->misses;
+		(void) pthread_mutex_unlock(&shard->mutex);
+	}
 }
 
 /*
@@ -119,24 +208,28 @@ int
 x509_issuer_cache_find(unsigned char *parent_md, unsigned char *child_md)
 {
 	struct x509_issuer candidate, *found;
+	struct x509_issuer_shard *shard;
 	int ret = -1;
 
-	memset(&candidate, 0, sizeof(candidate));
-	candidate.parent_md = parent_md;
-	candidate.child_md = child_md;
-
 	if (x509_issuer_cache_max == 0)
 		return -1;
 
-	if (pthread_mutex_lock(&x509_issuer_tree_mutex) != 0)
+	memcpy(candidate.parent_md, parent_md, EVP_MAX_MD_SIZE);
+	memcpy(candidate.child_md, child_md, EVP_MAX_MD_SIZE);
+
+	shard = x509_issuer_cache_shard(parent_md, child_md);
+
+	if (pthread_mutex_lock(&shard->mutex) != 0)
 		return -1;
-	if ((found = RB_FIND(x509_issuer_tree, &x509_issuer_cache,
+	if ((found = RB_FIND(x509_issuer_tree, &shard->tree,
 	    &candidate)) != NULL) {
-		TAILQ_REMOVE(&x509_issuer_lru, found, queue);
-		TAILQ_INSERT_HEAD(&x509_issuer_lru, found, queue);
+		TAILQ_REMOVE(&shard->lru, found, queue);
+		TAILQ_INSERT_HEAD(&shard->lru, found, queue);
 		ret = found->valid;
-	}
-	(void) pthread_mutex_unlock(&x509_issuer_tree_mutex);
+		shard->hits++;
+	} else
+		shard->misses++;
+	(void) pthread_mutex_unlock(&shard->mutex);
 
 	return ret;
 }
@@ -154,7 +247,9 @@ void
 x509_issuer_cache_add(unsigned char *parent_md, unsigned char *child_md,
     int valid)
 {
+	struct x509_issuer_shard *shard;
 	struct x509_issuer *new;
+	size_t max;
 
 	if (x509_issuer_cache_max == 0)
 		return;
@@ -163,31 +258,27 @@ x509_issuer_cache_add(unsigned char *parent_md, unsigned char *child_md,
 
 	if ((new = calloc(1, sizeof(struct x509_issuer))) == NULL)
 		return;
-	if ((new->parent_md = calloc(1, EVP_MAX_MD_SIZE)) == NULL)
-		goto err;
 	memcpy(new->parent_md, parent_md, EVP_MAX_MD_SIZE);
-	if ((new->child_md = calloc(1, EVP_MAX_MD_SIZE)) == NULL)
-		goto err;
 	memcpy(new->child_md, child_md, EVP_MAX_MD_SIZE);
 
 	new->valid = valid;
 
-	if (pthread_mutex_lock(&x509_issuer_tree_mutex) != 0)
+	shard = x509_issuer_cache_shard(parent_md, child_md);
+
+	if (pthread_mutex_lock(&shard->mutex) != 0)
 		goto err;
-	while (x509_issuer_cache_count >= x509_issuer_cache_max)
-		x509_issuer_cache_free_oldest();
-	if (RB_INSERT(x509_issuer_tree, &x509_issuer_cache, new) == NULL) {
-		TAILQ_INSERT_HEAD(&x509_issuer_lru, new, queue);
-		x509_issuer_cache_count++;
+	max = x509_issuer_cache_shard_max();
+	while (shard->count > 0 && shard->count >= max)
+		x509_issuer_cache_free_oldest(shard);
+	if (max > 0 &&
+	    RB_INSERT(x509_issuer_tree, &shard->tree, new) == NULL) {
+		TAILQ_INSERT_HEAD(&shard->lru, new, queue);
+		shard->count++;
 		new = NULL;
 	}
-	(void) pthread_mutex_unlock(&x509_issuer_tree_mutex);
+	(void) pthread_mutex_unlock(&shard->mutex);
 
  err:
-	if (new != NULL) {
-		free(new->parent_md);
-		free(new->child_md);
-	}
 	free(new);
 	return;
 }
@@ -22,6 +22,9 @@
 #include <sys/tree.h>
 #include <sys/queue.h>
 
+#include <pthread.h>
+#include <stdint.h>
+
 #include <openssl/x509.h>
 
 __BEGIN_HIDDEN_DECLS
@@ -29,15 +32,38 @@ __BEGIN_HIDDEN_DECLS
 struct x509_issuer {
 	RB_ENTRY(x509_issuer) entry;
 	TAILQ_ENTRY(x509_issuer) queue;	/* LRU of entries */
-	/* parent_md and child_md must point to EVP_MAX_MD_SIZE of memory */
-	unsigned char *parent_md;
-	unsigned char *child_md;
+	unsigned char parent_md[EVP_MAX_MD_SIZE];
+	unsigned char child_md[EVP_MAX_MD_SIZE];
 	int valid;			/* Result of signature validation. */
 };
 
+RB_HEAD(x509_issuer_tree, x509_issuer);
+TAILQ_HEAD(x509_issuer_lru, x509_issuer);
+
+/*
+ * The cache is split into shards, selected by the digests, so that
+ * lookups from different threads rarely contend for the same mutex.
+ */
+struct x509_issuer_shard {
+	pthread_mutex_t mutex;
+	struct x509_issuer_tree tree;
+	struct x509_issuer_lru lru;
+	size_t count;
+	uint64_t hits;
+	uint64_t misses;
+};
+
+struct x509_issuer_cache_stats {
+	size_t entries;
+	uint64_t hits;
+	uint64_t misses;
+};
+
 #define X509_ISSUER_CACHE_MAX 40000	/* Approx 7.5 MB, entries 200 bytes */
+#define X509_ISSUER_CACHE_SHARDS 16	/* Must be a power of two */
 
 int x509_issuer_cache_set_max(size_t max);
+void x509_issuer_cache_stats(struct x509_issuer_cache_stats *stats);
 int x509_issuer_cache_find(unsigned char *parent_md, unsigned char *child_md);
 void x509_issuer_cache_add(unsigned char *parent_md, unsigned char *child_md,
     int valid);
@@ -96,9 +96,9 @@ struct X509_name_st {
 #else
 	char *bytes;
 #endif
-/*	unsigned long hash; Keep the hash around for lookups */
 	unsigned char *canon_enc;
 	int canon_enclen;
+	uint32_t canon_hash;	/* Hash of canon_enc for lookups */
 } /* X509_NAME */;
 
 struct X509_extension_st {
@@ -285,6 +285,7 @@ struct X509_VERIFY_PARAM_st {
 struct x509_store_st {
 	/* The following is a cache of trusted certs */
 	STACK_OF(X509_OBJECT) *objs;	/* Cache of all objects */
+	struct x509_object_table *objs_table;	/* objs by subject name */
 
 	/* These are external lookup methods */
 	STACK_OF(X509_LOOKUP) *get_cert_methods;
@@ -304,6 +305,8 @@ struct x509_store_st {
 	STACK_OF(X509_CRL) * (*lookup_crls)(X509_STORE_CTX *ctx, X509_NAME *nm);
 	int (*cleanup)(X509_STORE_CTX *ctx);
 
+	struct x509_chain_cache *chain_cache;	/* Verified chains or NULL */
+
 	CRYPTO_EX_DATA ex_data;
 	int references;
 } /* X509_STORE */;
@@ -373,8 +376,13 @@ struct x509_store_ctx_st {
 
 int x509_check_cert_time(X509_STORE_CTX *ctx, X509 *x, int quiet);
 
+X509_OBJECT *x509_store_object_by_subject(X509_STORE *store,
+    X509_LOOKUP_TYPE type, X509_NAME *name);
+
 int name_cmp(const char *name, const char *cmp);
 
+int x509_name_hash(X509_NAME *name, uint32_t *out_hash);
+
 __END_HIDDEN_DECLS
 
 #endif /* !HEADER_X509_LOCAL_H */
@@ -56,13 +56,16 @@
  * [including the GNU Public Licence.]
  */
 
+#include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include <openssl/err.h>
 #include <openssl/lhash.h>
 #include <openssl/x509.h>
 #include <openssl/x509v3.h>
+#include "x509_chain_cache.h"
 #include "x509_local.h"
 
 X509_LOOKUP *
@@ -171,6 +174,172 @@ X509_LOOKUP_by_alias(X509_LOOKUP *ctx, X509_LOOKUP_TYPE type, const char *str,
 }
 LCRYPTO_ALIAS(X509_LOOKUP_by_alias);
 
+/*
+ * The objects of a store are indexed by type and by the canonical encoding
+ * of their subject name, or of the issuer name for CRLs. An entry holds all
+ * objects with the same type and name, in the order they were added, so
+ * that adding an object and finding objects by name take constant time
+ * regardless of the number of objects in the store.
+ */
+struct x509_object_entry {
+	struct x509_object_entry *next;
+	X509_LOOKUP_TYPE type;
+	uint32_t hash;
+	X509_NAME *name;		/* Name of the first object */
+	STACK_OF(X509_OBJECT) *objs;
+};
+
+struct x509_object_table {
+	struct x509_object_entry **buckets;
+	size_t buckets_len;		/* Power of two */
+	size_t count;
+};
+
+#define X509_OBJECT_TABLE_MIN_BUCKETS	64
+
+static X509_NAME *
+x509_object_name(const X509_OBJECT *obj)
+{
+	switch (obj->type) {
+	case X509_LU_X509:
+		return X509_get_subject_name(obj->data.x509);
+	case X509_LU_CRL:
+		return X509_CRL_get_issuer(obj->data.crl);
+	default:
+		return NULL;
+	}
+}
+
+static struct x509_object_table *
+x509_object_table_new(void)
+{
+	struct x509_object_table *table;
+
+	if ((table = calloc(1, sizeof(*table))) == NULL)
+		return NULL;
+	table->buckets_len = X509_OBJECT_TABLE_MIN_BUCKETS;
+	if ((table->buckets = calloc(table->buckets_len,
+	    sizeof(*table->buckets))) == NULL) {
+		free(table);
+		return NULL;
+	}
+
+	return table;
+}
+
+/* Free the table. The objects are owned by the store's object stack. */
+static void
+x509_object_table_free(struct x509_object_table *table)
+{
+	struct x509_object_entry *entry, *next;
+	size_t i;
+
+	if (table == NULL)
+		return;
+
+	for (i = 0; i < table->buckets_len; i++) {
+		for (entry = table->buckets[i]; entry != NULL; entry = next) {
+			next = entry->next;
+			sk_X509_OBJECT_free(entry->objs);
+			free(entry);
+		}
+	}
+	free(table->buckets);
+	free(table);
+}
+
+static struct x509_object_entry *
+x509_object_table_find(struct x509_object_table *table, X509_LOOKUP_TYPE type,
+    X509_NAME *name)
+{
+	struct x509_object_entry *entry;
+	uint32_t hash;
+
+	if (name == NULL || !x509_name_hash(name, &hash))
+		return NULL;
+
+	entry = table->buckets[hash & (table->buckets_len - 1)];
+	for (; entry != NULL; entry = entry->next) {
+		if (entry->type == type && entry->hash == hash &&
+		    X509_NAME_cmp(entry->name, name) == 0)
+			return entry;
+	}
+
+	return NULL;
+}
+
+static int
+x509_object_table_grow(struct x509_object_table *table)
+{
+	struct x509_object_entry **buckets, *entry, *next;
+	size_t buckets_len, i, slot;
+
+	if (table->buckets_len > SIZE_MAX / 2)
+		return 0;
+	buckets_len = table->buckets_len * 2;
+	if ((buckets = calloc(buckets_len, sizeof(*buckets))) == NULL)
+		return 0;
+
+	for (i = 0; i < table->buckets_len; i++) {
+		for (entry = table->buckets[i]; entry != NULL; entry = next) {
+			next = entry->next;
+			slot = entry->hash & (buckets_len - 1);
+			entry->next = buckets[slot];
+			buckets[slot] = entry;
+		}
+	}
+	free(table->buckets);
+	table->buckets = buckets;
+	table->buckets_len = buckets_len;
+
+	return 1;
+}
+
+/* Add obj after all objects with the same type and name. */
+static int
+x509_object_table_add(struct x509_object_table *table, X509_OBJECT *obj)
+{
+	struct x509_object_entry *entry;
+	X509_NAME *name;
+	size_t slot;
+
+	if ((name = x509_object_name(obj)) == NULL)
+		return 0;
+
+	if ((entry = x509_object_table_find(table, obj->type, name)) != NULL)
+		return sk_X509_OBJECT_push(entry->objs, obj) > 0;
+
+	/* Keep the number of entries at most the number of buckets. */
+	if (table->count >= table->buckets_len) {
+		if (!x509_object_table_grow(table))
+			return 0;
+	}
+
+	if ((entry = calloc(1, sizeof(*entry))) == NULL)
+		return 0;
+	entry->type = obj->type;
+	entry->name = name;
+	if (!x509_name_hash(name, &entry->hash))
+		goto err;
+	if ((entry->objs = sk_X509_OBJECT_new_null()) == NULL)
+		goto err;
+	if (sk_X509_OBJECT_push(entry->objs, obj) <= 0)
+		goto err;
+
+	slot = entry->hash & (table->buckets_len - 1);
+	entry->next = table->buckets[slot];
+	table->buckets[slot] = entry;
+	table->count++;
+
+	return 1;
+
+ err:
+	sk_X509_OBJECT_free(entry->objs);
+	free(entry);
+
+	return 0;
+}
+
 static int
 x509_object_cmp(const X509_OBJECT * const *a, const X509_OBJECT * const *b)
 {
@@ -198,6 +367,8 @@ X509_STORE_new(void)
 
 	if ((store->objs = sk_X509_OBJECT_new(x509_object_cmp)) == NULL)
 		goto err;
+	if ((store->objs_table = x509_object_table_new()) == NULL)
+		goto err;
 	if ((store->get_cert_methods = sk_X509_LOOKUP_new_null()) == NULL)
 		goto err;
 	if ((store->param = X509_VERIFY_PARAM_new()) == NULL)
@@ -274,10 +445,12 @@ X509_STORE_free(X509_STORE *store)
 		X509_LOOKUP_free(lu);
 	}
 	sk_X509_LOOKUP_free(sk);
+	x509_object_table_free(store->objs_table);
 	sk_X509_OBJECT_pop_free(store->objs, X509_OBJECT_free);
 
 	CRYPTO_free_ex_data(CRYPTO_EX_INDEX_X509_STORE, store, &store->ex_data);
 	X509_VERIFY_PARAM_free(store->param);
+	x509_chain_cache_free(store->chain_cache);
 	free(store);
 }
 LCRYPTO_ALIAS(X509_STORE_free);
@@ -335,6 +508,23 @@ X509_STORE_CTX_get_obj_by_subject(X509_STORE_CTX *vs, X509_LOOKUP_TYPE type,
 }
 LCRYPTO_ALIAS(X509_STORE_CTX_get_obj_by_subject);
 
+/*
+ * Return the first object in the store with the given type and name.
+ * Must be called with the store lock held.
+ */
+X509_OBJECT *
+x509_store_object_by_subject(X509_STORE *store, X509_LOOKUP_TYPE type,
+    X509_NAME *name)
+{
+	struct x509_object_entry *entry;
+
+	if ((entry = x509_object_table_find(store->objs_table, type,
+	    name)) == NULL)
+		return NULL;
+
+	return sk_X509_OBJECT_value(entry->objs, 0);
+}
+
 int
 X509_STORE_CTX_get_by_subject(X509_STORE_CTX *vs, X509_LOOKUP_TYPE type,
     X509_NAME *name, X509_OBJECT *ret)
@@ -349,9 +539,9 @@ X509_STORE_CTX_get_by_subject(X509_STORE_CTX *vs, X509_LOOKUP_TYPE type,
 
 	memset(&stmp, 0, sizeof(stmp));
 
-	CRYPTO_w_lock(CRYPTO_LOCK_X509_STORE);
-	tmp = X509_OBJECT_retrieve_by_subject(ctx->objs, type, name);
-	CRYPTO_w_unlock(CRYPTO_LOCK_X509_STORE);
+	CRYPTO_r_lock(CRYPTO_LOCK_X509_STORE);
+	tmp = x509_store_object_by_subject(ctx, type, name);
+	CRYPTO_r_unlock(CRYPTO_LOCK_X509_STORE);
 
 	if (tmp == NULL || type == X509_LU_CRL) {
 		for (i = 0; i < sk_X509_LOOKUP_num(ctx->get_cert_methods); i++) {
@@ -374,28 +564,59 @@ X509_STORE_CTX_get_by_subject(X509_STORE_CTX *vs, X509_LOOKUP_TYPE type,
 }
 LCRYPTO_ALIAS(X509_STORE_CTX_get_by_subject);
 
+/* Compare objects of the same type and name, as X509_OBJECT_retrieve_match. */
+static int
+x509_object_match(const X509_OBJECT *a, const X509_OBJECT *b)
+{
+	switch (a->type) {
+	case X509_LU_X509:
+		return X509_cmp(a->data.x509, b->data.x509) == 0;
+	case X509_LU_CRL:
+		return X509_CRL_match(a->data.crl, b->data.crl) == 0;
+	default:
+		return 1;
+	}
+}
+
 /* Add obj to the store. Takes ownership of obj. */
 static int
 X509_STORE_add_object(X509_STORE *store, X509_OBJECT *obj)
 {
+	struct x509_object_entry *entry;
+	X509_OBJECT *tmp;
+	int i;
 	int ret = 0;
 
 	CRYPTO_w_lock(CRYPTO_LOCK_X509_STORE);
 
-	if (X509_OBJECT_retrieve_match(store->objs, obj) != NULL) {
-		/* Object is already present in the store. That's fine. */
-		ret = 1;
-		goto out;
+	if ((entry = x509_object_table_find(store->objs_table, obj->type,
+	    x509_object_name(obj))) != NULL) {
+		for (i = 0; i < sk_X509_OBJECT_num(entry->objs); i++) {
+			tmp = sk_X509_OBJECT_value(entry->objs, i);
+			if (x509_object_match(tmp, obj)) {
+				/* Already present in the store. That's fine. */
+				ret = 1;
+				goto out;
+			}
+		}
 	}
 
 	if (sk_X509_OBJECT_push(store->objs, obj) <= 0) {
 		X509error(ERR_R_MALLOC_FAILURE);
 		goto out;
 	}
+	if (!x509_object_table_add(store->objs_table, obj)) {
+		(void)sk_X509_OBJECT_pop(store->objs);
+		X509error(ERR_R_MALLOC_FAILURE);
+		goto out;
+	}
 
 	obj = NULL;
 	ret = 1;
 
+	/* Cached chains may not be what we would build now. */
+	x509_chain_cache_flush(store->chain_cache);
+
  out:
 	CRYPTO_w_unlock(CRYPTO_LOCK_X509_STORE);
 	X509_OBJECT_free(obj);
@@ -469,16 +690,15 @@ X509_OBJECT_get_type(const X509_OBJECT *a)
 }
 LCRYPTO_ALIAS(X509_OBJECT_get_type);
 
-static int
-x509_object_idx_cnt(STACK_OF(X509_OBJECT) *h, X509_LOOKUP_TYPE type,
-    X509_NAME *name, int *pnmatch)
+int
+X509_OBJECT_idx_by_subject(STACK_OF(X509_OBJECT) *h, X509_LOOKUP_TYPE type,
+    X509_NAME *name)
 {
 	X509_OBJECT stmp;
 	X509 x509_s;
 	X509_CINF cinf_s;
 	X509_CRL crl_s;
 	X509_CRL_INFO crl_info_s;
-	int idx;
 
 	stmp.type = type;
 	switch (type) {
@@ -496,28 +716,7 @@ x509_object_idx_cnt(STACK_OF(X509_OBJECT) *h, X509_LOOKUP_TYPE type,
 		return -1;
 	}
 
-	idx = sk_X509_OBJECT_find(h, &stmp);
-	if (idx >= 0 && pnmatch) {
-		int tidx;
-		const X509_OBJECT *tobj, *pstmp;
-
-		*pnmatch = 1;
-		pstmp = &stmp;
-		for (tidx = idx + 1; tidx < sk_X509_OBJECT_num(h); tidx++) {
-			tobj = sk_X509_OBJECT_value(h, tidx);
-			if (x509_object_cmp(&tobj, &pstmp))
-				break;
-			(*pnmatch)++;
-		}
-	}
-	return idx;
-}
-
-int
-X509_OBJECT_idx_by_subject(STACK_OF(X509_OBJECT) *h, X509_LOOKUP_TYPE type,
-    X509_NAME *name)
-{
-	return x509_object_idx_cnt(h, type, name, NULL);
+	return sk_X509_OBJECT_find(h, &stmp);
 }
 LCRYPTO_ALIAS(X509_OBJECT_idx_by_subject);
 
@@ -557,20 +756,21 @@ X509_get1_certs_from_cache(X509_STORE *store, X509_NAME *name)
 {
 	STACK_OF(X509) *sk = NULL;
 	X509 *x = NULL;
+	struct x509_object_entry *entry;
 	X509_OBJECT *obj;
-	int i, idx, cnt;
+	int i;
 
-	CRYPTO_w_lock(CRYPTO_LOCK_X509_STORE);
+	CRYPTO_r_lock(CRYPTO_LOCK_X509_STORE);
 
-	idx = x509_object_idx_cnt(store->objs, X509_LU_X509, name, &cnt);
-	if (idx < 0)
+	if ((entry = x509_object_table_find(store->objs_table, X509_LU_X509,
+	    name)) == NULL)
 		goto err;
 
 	if ((sk = sk_X509_new_null()) == NULL)
 		goto err;
 
-	for (i = 0; i < cnt; i++, idx++) {
-		obj = sk_X509_OBJECT_value(store->objs, idx);
+	for (i = 0; i < sk_X509_OBJECT_num(entry->objs); i++) {
+		obj = sk_X509_OBJECT_value(entry->objs, i);
 
 		x = obj->data.x509;
 		if (!X509_up_ref(x)) {
@@ -581,12 +781,12 @@ X509_get1_certs_from_cache(X509_STORE *store, X509_NAME *name)
 			goto err;
 	}
 
-	CRYPTO_w_unlock(CRYPTO_LOCK_X509_STORE);
+	CRYPTO_r_unlock(CRYPTO_LOCK_X509_STORE);
 
 	return sk;
 
  err:
-	CRYPTO_w_unlock(CRYPTO_LOCK_X509_STORE);
+	CRYPTO_r_unlock(CRYPTO_LOCK_X509_STORE);
 	sk_X509_pop_free(sk, X509_free);
 	X509_free(x);
 
@@ -622,8 +822,9 @@ X509_STORE_get1_crls(X509_STORE_CTX *ctx, X509_NAME *name)
 	X509_STORE *store = ctx->store;
 	STACK_OF(X509_CRL) *sk = NULL;
 	X509_CRL *x = NULL;
+	struct x509_object_entry *entry;
 	X509_OBJECT *obj = NULL;
-	int i, idx, cnt;
+	int i;
 
 	if (store == NULL)
 		return NULL;
@@ -636,16 +837,16 @@ X509_STORE_get1_crls(X509_STORE_CTX *ctx, X509_NAME *name)
 	X509_OBJECT_free(obj);
 	obj = NULL;
 
-	CRYPTO_w_lock(CRYPTO_LOCK_X509_STORE);
-	idx = x509_object_idx_cnt(store->objs, X509_LU_CRL, name, &cnt);
-	if (idx < 0)
+	CRYPTO_r_lock(CRYPTO_LOCK_X509_STORE);
+	if ((entry = x509_object_table_find(store->objs_table, X509_LU_CRL,
+	    name)) == NULL)
 		goto err;
 
 	if ((sk = sk_X509_CRL_new_null()) == NULL)
 		goto err;
 
-	for (i = 0; i < cnt; i++, idx++) {
-		obj = sk_X509_OBJECT_value(store->objs, idx);
+	for (i = 0; i < sk_X509_OBJECT_num(entry->objs); i++) {
+		obj = sk_X509_OBJECT_value(entry->objs, i);
 
 		x = obj->data.crl;
 		if (!X509_CRL_up_ref(x)) {
@@ -656,11 +857,11 @@ X509_STORE_get1_crls(X509_STORE_CTX *ctx, X509_NAME *name)
 			goto err;
 	}
 
-	CRYPTO_w_unlock(CRYPTO_LOCK_X509_STORE);
+	CRYPTO_r_unlock(CRYPTO_LOCK_X509_STORE);
 	return sk;
 
  err:
-	CRYPTO_w_unlock(CRYPTO_LOCK_X509_STORE);
+	CRYPTO_r_unlock(CRYPTO_LOCK_X509_STORE);
 	X509_CRL_free(x);
 	sk_X509_CRL_pop_free(sk, X509_CRL_free);
 	return NULL;
@@ -710,10 +911,11 @@ LCRYPTO_ALIAS(X509_OBJECT_retrieve_match);
 int
 X509_STORE_CTX_get1_issuer(X509 **out_issuer, X509_STORE_CTX *ctx, X509 *x)
 {
+	struct x509_object_entry *entry;
 	X509_NAME *xn;
 	X509_OBJECT *obj, *pobj;
 	X509 *issuer = NULL;
-	int i, idx, ret;
+	int i, ret;
 
 	*out_issuer = NULL;
 
@@ -747,30 +949,23 @@ X509_STORE_CTX_get1_issuer(X509 **out_issuer, X509_STORE_CTX *ctx, X509 *x)
 	if (ctx->store == NULL)
 		return 0;
 
-	/* Else find index of first cert accepted by 'check_issued' */
-	CRYPTO_w_lock(CRYPTO_LOCK_X509_STORE);
-	idx = X509_OBJECT_idx_by_subject(ctx->store->objs, X509_LU_X509, xn);
-	if (idx != -1) /* should be true as we've had at least one match */ {
-		/* Look through all matching certs for suitable issuer */
-		for (i = idx; i < sk_X509_OBJECT_num(ctx->store->objs); i++) {
-			pobj = sk_X509_OBJECT_value(ctx->store->objs, i);
-			/* See if we've run past the matches */
-			if (pobj->type != X509_LU_X509)
+	/* Else find the first cert accepted by 'check_issued' */
+	CRYPTO_r_lock(CRYPTO_LOCK_X509_STORE);
+	entry = x509_object_table_find(ctx->store->objs_table, X509_LU_X509,
+	    xn);
+	/* Look through all matching certs for suitable issuer */
+	for (i = 0; entry != NULL && i < sk_X509_OBJECT_num(entry->objs); i++) {
+		pobj = sk_X509_OBJECT_value(entry->objs, i);
+		if (ctx->check_issued(ctx, x, pobj->data.x509)) {
+			issuer = pobj->data.x509;
+			/*
+			 * If times check, exit with match,
+			 * otherwise keep looking. Leave last
+			 * match in issuer so we return nearest
+			 * match if no certificate time is OK.
+			 */
+			if (x509_check_cert_time(ctx, issuer, -1))
 				break;
-			if (X509_NAME_cmp(xn,
-			    X509_get_subject_name(pobj->data.x509)))
-				break;
-			if (ctx->check_issued(ctx, x, pobj->data.x509)) {
-				issuer = pobj->data.x509;
-				/*
-				 * If times check, exit with match,
-				 * otherwise keep looking. Leave last
-				 * match in issuer so we return nearest
-				 * match if no certificate time is OK.
-				 */
-				if (x509_check_cert_time(ctx, issuer, -1))
-					break;
-			}
 		}
 	}
 	ret = 0;
@@ -782,7 +977,7 @@ X509_STORE_CTX_get1_issuer(X509 **out_issuer, X509_STORE_CTX *ctx, X509 *x)
 			ret = 1;
 		}
 	}
-	CRYPTO_w_unlock(CRYPTO_LOCK_X509_STORE);
+	CRYPTO_r_unlock(CRYPTO_LOCK_X509_STORE);
 	return ret;
 }
 LCRYPTO_ALIAS(X509_STORE_CTX_get1_issuer);
@@ -790,6 +985,14 @@ LCRYPTO_ALIAS(X509_STORE_CTX_get1_issuer);
 STACK_OF(X509_OBJECT) *
 X509_STORE_get0_objects(X509_STORE *xs)
 {
+	/*
+	 * The store no longer needs its objects sorted, but callers may
+	 * search the returned stack by subject, so hand it out sorted.
+	 */
+	CRYPTO_w_lock(CRYPTO_LOCK_X509_STORE);
+	sk_X509_OBJECT_sort(xs->objs);
+	CRYPTO_w_unlock(CRYPTO_LOCK_X509_STORE);
+
 	return xs->objs;
 }
 LCRYPTO_ALIAS(X509_STORE_get0_objects);
@@ -212,6 +212,158 @@ x509_verify_chain_leaf(struct x509_verify_chain *chain)
 	return sk_X509_value(chain->certs, 0);
 }
 
+/*
+ * An index of a stack of certificates by subject name, so that the
+ * candidate issuers of a certificate can be found without comparing
+ * its issuer name against every certificate in the stack. The chains
+ * of each bucket are kept in stack order, so the candidates are
+ * considered in the same order as by a linear search.
+ */
+struct x509_verify_index_entry {
+	uint32_t hash;
+	size_t next;			/* Next entry in bucket plus one */
+};
+
+struct x509_verify_index {
+	struct x509_verify_index_entry *entries;
+	size_t *buckets;		/* First entry in bucket plus one */
+	size_t buckets_mask;
+};
+
+struct x509_verify_candidates {
+	STACK_OF(X509) *certs;
+	struct x509_verify_index *index;
+	uint32_t hash;
+	size_t next;			/* Next position plus one, 0 at end */
+};
+
+static void
+x509_verify_index_free(struct x509_verify_index *index)
+{
+	if (index == NULL)
+		return;
+	free(index->entries);
+	free(index->buckets);
+	free(index);
+}
+
+static struct x509_verify_index *
+x509_verify_index_new(STACK_OF(X509) *certs)
+{
+	struct x509_verify_index *index;
+	size_t buckets_len, i, num, slot;
+
+	if (sk_X509_num(certs) < X509_VERIFY_INDEX_MIN_CERTS)
+		return NULL;
+	num = sk_X509_num(certs);
+
+	if ((index = calloc(1, sizeof(*index))) == NULL)
+		goto err;
+
+	for (buckets_len = 16; buckets_len < num; buckets_len <<= 1)
+		;
+	index->buckets_mask = buckets_len - 1;
+
+	if ((index->entries = calloc(num, sizeof(*index->entries))) == NULL)
+		goto err;
+	if ((index->buckets = calloc(buckets_len,
+	    sizeof(*index->buckets))) == NULL)
+		goto err;
+
+	/* Insert in reverse so that each bucket ends up in stack order. */
+	for (i = num; i > 0; i--) {
+		X509 *cert = sk_X509_value(certs, i - 1);
+
+		if (!x509_name_hash(X509_get_subject_name(cert),
+		    &index->entries[i - 1].hash))
+			goto err;
+		slot = index->entries[i - 1].hash & index->buckets_mask;
+		index->entries[i - 1].next = index->buckets[slot];
+		index->buckets[slot] = i;
+	}
+
+	return index;
+
+ err:
+	x509_verify_index_free(index);
+
+	return NULL;
+}
+
+/*
+ * Build the indexes of the roots and intermediates on first use. If an
+ * index cannot be built, its stack is searched linearly.
+ */
+static void
+x509_verify_ctx_build_indexes(struct x509_verify_ctx *ctx)
+{
+	if (ctx->indexed)
+		return;
+	ctx->indexed = 1;
+
+	/* Roots are looked up in the X509_STORE in legacy mode. */
+	if (ctx->xsc == NULL && ctx->roots_index == NULL)
+		ctx->roots_index = x509_verify_index_new(ctx->roots);
+
+	/*
+	 * A custom check_issued callback may accept an issuer whose subject
+	 * does not match, so we can only narrow down by name with ours.
+	 */
+	if (ctx->xsc != NULL && ctx->xsc->store != NULL &&
+	    ctx->xsc->store->check_issued != NULL)
+		return;
+	if (ctx->intermediates != NULL)
+		ctx->intermediates_index =
+		    x509_verify_index_new(ctx->intermediates);
+}
+
+static void
+x509_verify_candidates_init(struct x509_verify_candidates *candidates,
+    STACK_OF(X509) *certs, struct x509_verify_index *index, X509 *cert)
+{
+	memset(candidates, 0, sizeof(*candidates));
+
+	candidates->certs = certs;
+	if (sk_X509_num(certs) <= 0)
+		return;
+
+	if (index != NULL && x509_name_hash(X509_get_issuer_name(cert),
+	    &candidates->hash)) {
+		candidates->index = index;
+		candidates->next =
+		    index->buckets[candidates->hash & index->buckets_mask];
+		return;
+	}
+
+	candidates->next = 1;
+}
+
+/*
+ * Return the next certificate that may have issued the certificate the
+ * candidates were initialized with, or NULL if there are no more.
+ */
+static X509 *
+x509_verify_candidates_next(struct x509_verify_candidates *candidates)
+{
+	struct x509_verify_index *index = candidates->index;
+	size_t i;
+
+	while (candidates->next != 0) {
+		i = candidates->next - 1;
+		if (index == NULL) {
+			candidates->next = 0;
+			if (i + 1 < (size_t)sk_X509_num(candidates->certs))
+				candidates->next = i + 2;
+			return sk_X509_value(candidates->certs, i);
+		}
+		candidates->next = index->entries[i].next;
+		if (index->entries[i].hash == candidates->hash)
+			return sk_X509_value(candidates->certs, i);
+	}
+
+	return NULL;
+}
+
 static void
 x509_verify_ctx_reset(struct x509_verify_ctx *ctx)
 {
@@ -234,6 +386,7 @@ x509_verify_ctx_clear(struct x509_verify_ctx *ctx)
 {
 	x509_verify_ctx_reset(ctx);
 	sk_X509_pop_free(ctx->intermediates, X509_free);
+	x509_verify_index_free(ctx->intermediates_index);
 	free(ctx->chains);
 
 }
@@ -528,7 +681,7 @@ x509_verify_potential_parent(struct x509_verify_ctx *ctx, X509 *parent,
 		return (ctx->xsc->check_issued(ctx->xsc, child, parent));
 
 	/* XXX key usage */
-	return X509_check_issued(child, parent) != X509_V_OK;
+	return X509_check_issued(parent, child) == X509_V_OK;
 }
 
 static int
@@ -647,8 +800,9 @@ static void
 x509_verify_build_chains(struct x509_verify_ctx *ctx, X509 *cert,
     struct x509_verify_chain *current_chain, int full_chain, char *name)
 {
+	struct x509_verify_candidates candidates;
 	X509 *candidate;
-	int i, depth, count, ret, is_root;
+	int depth, count, ret, is_root;
 
 	/*
 	 * If we are finding chains with an xsc, just stop after we have
@@ -669,6 +823,8 @@ x509_verify_build_chains(struct x509_verify_ctx *ctx, X509 *cert,
 
 	count = ctx->chains_count;
 
+	x509_verify_ctx_build_indexes(ctx);
+
 	ctx->error = X509_V_ERR_UNABLE_TO_GET_ISSUER_CERT_LOCALLY;
 	ctx->error_depth = depth;
 
@@ -709,8 +865,10 @@ x509_verify_build_chains(struct x509_verify_ctx *ctx, X509 *cert,
 		}
 	} else {
 		/* Check to see if we have a trusted root issuer. */
-		for (i = 0; i < sk_X509_num(ctx->roots); i++) {
-			candidate = sk_X509_value(ctx->roots, i);
+		x509_verify_candidates_init(&candidates, ctx->roots,
+		    ctx->roots_index, cert);
+		while ((candidate =
+		    x509_verify_candidates_next(&candidates)) != NULL) {
 			if (x509_verify_potential_parent(ctx, candidate, cert)) {
 				is_root = x509_verify_check_chain_end(candidate,
 				    full_chain);
@@ -723,8 +881,10 @@ x509_verify_build_chains(struct x509_verify_ctx *ctx, X509 *cert,
 
 	/* Check intermediates after checking roots */
 	if (ctx->intermediates != NULL) {
-		for (i = 0; i < sk_X509_num(ctx->intermediates); i++) {
-			candidate = sk_X509_value(ctx->intermediates, i);
+		x509_verify_candidates_init(&candidates, ctx->intermediates,
+		    ctx->intermediates_index, cert);
+		while ((candidate =
+		    x509_verify_candidates_next(&candidates)) != NULL) {
 			if (x509_verify_potential_parent(ctx, candidate, cert)) {
 				x509_verify_consider_candidate(ctx, cert,
 				    0, candidate, current_chain,
@@ -1025,6 +1185,7 @@ x509_verify_ctx_free(struct x509_verify_ctx *ctx)
 	if (ctx == NULL)
 		return;
 	sk_X509_pop_free(ctx->roots, X509_free);
+	x509_verify_index_free(ctx->roots_index);
 	x509_verify_ctx_clear(ctx);
 	free(ctx);
 }
@@ -1071,6 +1232,9 @@ x509_verify_ctx_set_intermediates(struct x509_verify_ctx *ctx,
 {
 	if ((ctx->intermediates = X509_chain_up_ref(intermediates)) == NULL)
 		return 0;
+	x509_verify_index_free(ctx->intermediates_index);
+	ctx->intermediates_index = NULL;
+	ctx->indexed = 0;
 	return 1;
 }
 
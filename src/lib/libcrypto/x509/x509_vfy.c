@@ -75,6 +75,7 @@
 #include <openssl/x509v3.h>
 #include "asn1_local.h"
 #include "vpm_int.h"
+#include "x509_chain_cache.h"
 #include "x509_internal.h"
 
 /* CRL score values */
@@ -596,12 +597,39 @@ X509_verify_cert_legacy(X509_STORE_CTX *ctx)
 	return ok;
 }
 
+/*
+ * Only the result of a verification that depends on nothing but the
+ * certificates, the verify parameters and the store may be cached.
+ */
+static int
+x509_vfy_chain_cacheable(X509_STORE_CTX *ctx)
+{
+	unsigned long flags = ctx->param->flags;
+
+	if (ctx->store == NULL || ctx->store->chain_cache == NULL)
+		return 0;
+	if (ctx->verify_cb != null_callback)
+		return 0;
+	if (ctx->get_issuer == get_issuer_sk)
+		return 0;
+	if ((flags & (X509_V_FLAG_CRL_CHECK | X509_V_FLAG_CRL_CHECK_ALL |
+	    X509_V_FLAG_POLICY_CHECK | X509_V_FLAG_EXPLICIT_POLICY |
+	    X509_V_FLAG_INHIBIT_ANY | X509_V_FLAG_INHIBIT_MAP)) != 0)
+		return 0;
+	if (ctx->param->policies != NULL)
+		return 0;
+
+	return 1;
+}
+
 int
 X509_verify_cert(X509_STORE_CTX *ctx)
 {
+	unsigned char key[X509_CHAIN_CACHE_KEY_LEN];
 	STACK_OF(X509) *roots = NULL;
 	struct x509_verify_ctx *vctx = NULL;
 	int chain_count = 0;
+	int cacheable;
 
 	if (ctx->cert == NULL) {
 		X509error(X509_R_NO_CERT_SET_FOR_US_TO_VERIFY);
@@ -655,6 +683,13 @@ X509_verify_cert(X509_STORE_CTX *ctx)
 	    (ctx->param->flags & X509_V_FLAG_NO_ALT_CHAINS))
 		return X509_verify_cert_legacy(ctx);
 
+	/* Reuse a chain we have verified before, if the store caches them. */
+	cacheable = x509_vfy_chain_cacheable(ctx) &&
+	    x509_chain_cache_key(ctx, key);
+	if (cacheable && x509_chain_cache_find(ctx->store->chain_cache, ctx,
+	    key))
+		return 1;
+
 	/* Use the modern multi-chain verifier from x509_verify_cert */
 
 	if ((vctx = x509_verify_ctx_new_from_xsc(ctx)) != NULL) {
@@ -665,6 +700,10 @@ X509_verify_cert(X509_STORE_CTX *ctx)
 
 	sk_X509_pop_free(roots, X509_free);
 
+	if (cacheable && chain_count > 0 && ctx->chain != NULL &&
+	    ctx->error == X509_V_OK)
+		x509_chain_cache_add(ctx->store->chain_cache, ctx, key);
+
 	/* if we succeed we have a chain in ctx->chain */
 	return (chain_count > 0 && ctx->chain != NULL);
 }
@@ -2601,6 +2640,22 @@ X509_STORE_CTX_get_check_issued(X509_STORE_CTX *ctx)
 }
 LCRYPTO_ALIAS(X509_STORE_CTX_get_check_issued);
 
+int
+X509_STORE_set_chain_cache_max(X509_STORE *store, size_t max)
+{
+	if (store->chain_cache == NULL) {
+		if (max == 0)
+			return 1;
+		if ((store->chain_cache = x509_chain_cache_new()) == NULL) {
+			X509error(ERR_R_MALLOC_FAILURE);
+			return 0;
+		}
+	}
+
+	return x509_chain_cache_set_max(store->chain_cache, max);
+}
+LCRYPTO_ALIAS(X509_STORE_set_chain_cache_max);
+
 X509 *
 X509_STORE_CTX_get0_cert(X509_STORE_CTX *ctx)
 {
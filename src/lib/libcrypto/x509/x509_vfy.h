@@ -132,6 +132,35 @@ void X509_STORE_CTX_set_depth(X509_STORE_CTX *ctx, int depth);
 		X509_LOOKUP_ctrl((x),X509_L_MEM,(const char *)(iov),\
 		(long)(type),NULL)
 
+#if defined(LIBRESSL_INTERNAL)
+#define X509_L_MMAP_LOAD	4
+
+#define X509_LOOKUP_load_mmap(x,name) \
+		X509_LOOKUP_ctrl((x),X509_L_MMAP_LOAD,(name),0,NULL)
+
+/*
+ * A trust store file, as used by X509_LOOKUP_mmap(), holds DER encoded
+ * certificates and CRLs indexed by name hash. All integers are big endian.
+ *
+ *	magic	X509_TRUST_STORE_MAGIC
+ *	count	uint32, the number of index entries
+ *	index	count entries of X509_TRUST_STORE_ENTRY_LEN bytes each:
+ *		type	uint32, X509_LU_X509 or X509_LU_CRL
+ *		hash	uint32, X509_NAME_hash() of the certificate subject
+ *			or of the CRL issuer
+ *		offset	uint32, from the start of the file, of the DER
+ *		length	uint32, of the DER
+ *		sorted by type and hash.
+ *	data	The DER encodings, after the index.
+ *
+ * The file is mapped while it is in use, so it may only be replaced by
+ * renaming a new file over it, never rewritten in place.
+ */
+#define X509_TRUST_STORE_MAGIC		"LTSTORE1"
+#define X509_TRUST_STORE_MAGIC_LEN	8
+#define X509_TRUST_STORE_ENTRY_LEN	16
+#endif
+
 #define		X509_V_OK					0
 #define		X509_V_ERR_UNSPECIFIED				1
 #define		X509_V_ERR_UNABLE_TO_GET_ISSUER_CERT		2
@@ -319,6 +348,16 @@ void X509_STORE_set_check_issued(X509_STORE *store,
 X509_STORE_CTX_check_issued_fn
     X509_STORE_CTX_get_check_issued(X509_STORE_CTX *ctx);
 
+#if defined(LIBRESSL_INTERNAL)
+/*
+ * Cache up to max successfully verified chains in the store, so that
+ * verifying the same certificates with the same parameters again does
+ * not rebuild the chain. A maximum of 0 disables the cache. This must be
+ * set before the store is used by more than one thread.
+ */
+int X509_STORE_set_chain_cache_max(X509_STORE *store, size_t max);
+#endif
+
 X509_STORE_CTX *X509_STORE_CTX_new(void);
 
 int X509_STORE_CTX_get1_issuer(X509 **issuer, X509_STORE_CTX *ctx, X509 *x);
@@ -340,6 +379,9 @@ X509_LOOKUP *X509_STORE_add_lookup(X509_STORE *v, X509_LOOKUP_METHOD *m);
 X509_LOOKUP_METHOD *X509_LOOKUP_hash_dir(void);
 X509_LOOKUP_METHOD *X509_LOOKUP_file(void);
 X509_LOOKUP_METHOD *X509_LOOKUP_mem(void);
+#if defined(LIBRESSL_INTERNAL)
+X509_LOOKUP_METHOD *X509_LOOKUP_mmap(void);
+#endif
 
 int X509_STORE_add_cert(X509_STORE *ctx, X509 *x);
 int X509_STORE_add_crl(X509_STORE *ctx, X509_CRL *x);
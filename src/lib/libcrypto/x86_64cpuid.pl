@@ -133,6 +133,16 @@ OPENSSL_ia32_cpuid:
 	or	%ecx,%r9d		# merge AMD XOP flag
 
 	mov	%edx,%r10d		# %r9d:%r10d is copy of %ecx:%edx
+	and	\$(~IA32CAP_MASK0_AVX2),%r10d	# force reserved bit to 0
+	cmp	\$7,%r11d
+	jb	.Lno_avx2
+	mov	\$7,%eax		# structured extended feature flags
+	xor	%ecx,%ecx
+	cpuid
+	bt	\$5,%ebx		# AVX2
+	jnc	.Lno_avx2
+	or	\$IA32CAP_MASK0_AVX2,%r10d	# set reserved bit#10 on AVX2
+.Lno_avx2:
 	bt	\$IA32CAP_BIT1_OSXSAVE,%r9d	# check OSXSAVE bit
 	jnc	.Lclear_avx
 	xor	%ecx,%ecx		# XCR0
@@ -143,6 +153,7 @@ OPENSSL_ia32_cpuid:
 .Lclear_avx:
 	mov	\$(~(IA32CAP_MASK1_AVX | IA32CAP_MASK1_FMA3 | IA32CAP_MASK1_AMD_XOP)),%eax
 	and	%eax,%r9d		# clear AVX, FMA and AMD XOP bits
+	and	\$(~IA32CAP_MASK0_AVX2),%r10d	# clear AVX2 bit
 .Ldone:
 	shl	\$32,%r9
 	mov	%r10d,%eax
@@ -50,6 +50,7 @@
 /* the following bits are not obtained from cpuid */
 #define	IA32CAP_BIT0_INTELP4	20
 #define	IA32CAP_BIT0_INTEL	30
+#define	IA32CAP_BIT0_AVX2	10	/* cpuid leaf 7, %ebx bit 5 */
 
 /* bit numbers for the high word */
 #define	IA32CAP_BIT1_PCLMUL	1
@@ -70,6 +71,7 @@
 
 #define	IA32CAP_MASK0_INTELP4	(1 << IA32CAP_BIT0_INTELP4)
 #define	IA32CAP_MASK0_INTEL	(1 << IA32CAP_BIT0_INTEL)
+#define	IA32CAP_MASK0_AVX2	(1 << IA32CAP_BIT0_AVX2)
 
 /* bit masks for the high word */
 #define	IA32CAP_MASK1_PCLMUL	(1 << IA32CAP_BIT1_PCLMUL)
@@ -85,6 +87,8 @@
 #define	CPUCAP_MASK_FXSR	IA32CAP_MASK0_FXSR
 #define	CPUCAP_MASK_SSE		IA32CAP_MASK0_SSE
 #define	CPUCAP_MASK_INTELP4	IA32CAP_MASK0_INTELP4
+#define	CPUCAP_MASK_AVX2	IA32CAP_MASK0_AVX2
 #define	CPUCAP_MASK_PCLMUL	(1ULL << (32 + IA32CAP_BIT1_PCLMUL))
 #define	CPUCAP_MASK_SSSE3	(1ULL << (32 + IA32CAP_BIT1_SSSE3))
 #define	CPUCAP_MASK_AESNI	(1ULL << (32 + IA32CAP_BIT1_AESNI))
+#define	CPUCAP_MASK_AVX		(1ULL << (32 + IA32CAP_BIT1_AVX))
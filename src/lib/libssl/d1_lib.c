@@ -122,7 +122,7 @@ dtls1_drain_rcontents(pqueue queue)
 }
 
 static void
-dtls1_drain_records(pqueue queue)
+dtls1_drain_records(SSL *s, pqueue queue)
 {
 	pitem *item;
 	DTLS1_RECORD_DATA_INTERNAL *rdata;
@@ -132,7 +132,7 @@ dtls1_drain_records(pqueue queue)
 
 	while ((item = pqueue_pop(queue)) != NULL) {
 		rdata = (DTLS1_RECORD_DATA_INTERNAL *)item->data;
-		ssl3_release_buffer(&rdata->rbuf);
+		ssl3_release_buffer(s, &rdata->rbuf);
 		free(item->data);
 		pitem_free(item);
 	}
@@ -155,7 +155,7 @@ dtls1_drain_fragments(pqueue queue)
 static void
 dtls1_clear_queues(SSL *s)
 {
-	dtls1_drain_records(s->d1->unprocessed_rcds.q);
+	dtls1_drain_records(s, s->d1->unprocessed_rcds.q);
 	dtls1_drain_fragments(s->d1->buffered_messages);
 	dtls1_drain_fragments(s->d1->sent_messages);
 	dtls1_drain_rcontents(s->d1->buffered_app_data.q);
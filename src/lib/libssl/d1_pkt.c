@@ -193,7 +193,7 @@ static int dtls1_process_record(SSL *s);
 static int
 dtls1_copy_record(SSL *s, DTLS1_RECORD_DATA_INTERNAL *rdata)
 {
-	ssl3_release_buffer(&s->s3->rbuf);
+	ssl3_release_buffer(s, &s->s3->rbuf);
 
 	s->packet = rdata->packet;
 	s->packet_length = rdata->packet_length;
@@ -240,7 +240,7 @@ dtls1_buffer_record(SSL *s, record_pqueue *queue, unsigned char *priority)
 	return (1);
 
  err:
-	ssl3_release_buffer(&rdata->rbuf);
+	ssl3_release_buffer(s, &rdata->rbuf);
 
  init_err:
 	SSLerror(s, ERR_R_INTERNAL_ERROR);
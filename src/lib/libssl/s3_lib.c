@@ -1769,6 +1769,7 @@ _SSL_total_renegotiations(SSL *s)
 static int
 _SSL_set_tmp_dh(SSL *s, DH *dh)
 {
+	SSL_CERT *cert;
 	DH *dhe_params;
 
 	if (dh == NULL) {
@@ -1786,8 +1787,12 @@ _SSL_set_tmp_dh(SSL *s, DH *dh)
 		return 0;
 	}
 
-	DH_free(s->cert->dhe_params);
-	s->cert->dhe_params = dhe_params;
+	if ((cert = ssl_get0_cert(NULL, s)) == NULL) {
+		DH_free(dhe_params);
+		return 0;
+	}
+	DH_free(cert->dhe_params);
+	cert->dhe_params = dhe_params;
 
 	return 1;
 }
@@ -1795,7 +1800,11 @@ _SSL_set_tmp_dh(SSL *s, DH *dh)
 static int
 _SSL_set_dh_auto(SSL *s, int state)
 {
-	s->cert->dhe_params_auto = state;
+	SSL_CERT *cert;
+
+	if ((cert = ssl_get0_cert(NULL, s)) == NULL)
+		return 0;
+	cert->dhe_params_auto = state;
 	return 1;
 }
 
@@ -2185,13 +2194,17 @@ ssl3_ctrl(SSL *s, int cmd, long larg, void *parg)
 long
 ssl3_callback_ctrl(SSL *s, int cmd, void (*fp)(void))
 {
+	SSL_CERT *cert;
+
 	switch (cmd) {
 	case SSL_CTRL_SET_TMP_RSA_CB:
 		SSLerror(s, ERR_R_SHOULD_NOT_HAVE_BEEN_CALLED);
 		return 0;
 
 	case SSL_CTRL_SET_TMP_DH_CB:
-		s->cert->dhe_params_cb = (DH *(*)(SSL *, int, int))fp;
+		if ((cert = ssl_get0_cert(NULL, s)) == NULL)
+			return 0;
+		cert->dhe_params_cb = (DH *(*)(SSL *, int, int))fp;
 		return 1;
 
 	case SSL_CTRL_SET_TMP_ECDH_CB:
@@ -2209,6 +2222,7 @@ ssl3_callback_ctrl(SSL *s, int cmd, void (*fp)(void))
 static int
 _SSL_CTX_set_tmp_dh(SSL_CTX *ctx, DH *dh)
 {
+	SSL_CERT *cert;
 	DH *dhe_params;
 
 	if (dh == NULL) {
@@ -2226,8 +2240,12 @@ _SSL_CTX_set_tmp_dh(SSL_CTX *ctx, DH *dh)
 		return 0;
 	}
 
-	DH_free(ctx->cert->dhe_params);
-	ctx->cert->dhe_params = dhe_params;
+	if ((cert = ssl_get0_cert(ctx, NULL)) == NULL) {
+		DH_free(dhe_params);
+		return 0;
+	}
+	DH_free(cert->dhe_params);
+	cert->dhe_params = dhe_params;
 
 	return 1;
 }
@@ -2235,7 +2253,11 @@ _SSL_CTX_set_tmp_dh(SSL_CTX *ctx, DH *dh)
 static int
 _SSL_CTX_set_dh_auto(SSL_CTX *ctx, int state)
 {
-	ctx->cert->dhe_params_auto = state;
+	SSL_CERT *cert;
+
+	if ((cert = ssl_get0_cert(ctx, NULL)) == NULL)
+		return 0;
+	cert->dhe_params_auto = state;
 	return 1;
 }
 
@@ -2399,15 +2421,21 @@ _SSL_CTX_clear_extra_chain_certs(SSL_CTX *ctx)
 int
 SSL_CTX_set1_groups(SSL_CTX *ctx, const int *groups, size_t groups_len)
 {
-	return tls1_set_groups(&ctx->tlsext_supportedgroups,
-	    &ctx->tlsext_supportedgroups_length, groups, groups_len);
+	if (!ssl_ctx_params_own(ctx))
+		return 0;
+
+	return tls1_set_groups(&ctx->params->tlsext_supportedgroups,
+	    &ctx->params->tlsext_supportedgroups_length, groups, groups_len);
 }
 
 int
 SSL_CTX_set1_groups_list(SSL_CTX *ctx, const char *groups)
 {
-	return tls1_set_group_list(&ctx->tlsext_supportedgroups,
-	    &ctx->tlsext_supportedgroups_length, groups);
+	if (!ssl_ctx_params_own(ctx))
+		return 0;
+
+	return tls1_set_group_list(&ctx->params->tlsext_supportedgroups,
+	    &ctx->params->tlsext_supportedgroups_length, groups);
 }
 
 long
@@ -2516,14 +2544,17 @@ ssl3_ctx_ctrl(SSL_CTX *ctx, int cmd, long larg, void *parg)
 long
 ssl3_ctx_callback_ctrl(SSL_CTX *ctx, int cmd, void (*fp)(void))
 {
+	SSL_CERT *cert;
+
 	switch (cmd) {
 	case SSL_CTRL_SET_TMP_RSA_CB:
 		SSLerrorx(ERR_R_SHOULD_NOT_HAVE_BEEN_CALLED);
 		return 0;
 
 	case SSL_CTRL_SET_TMP_DH_CB:
-		ctx->cert->dhe_params_cb =
-		    (DH *(*)(SSL *, int, int))fp;
+		if ((cert = ssl_get0_cert(ctx, NULL)) == NULL)
+			return 0;
+		cert->dhe_params_cb = (DH *(*)(SSL *, int, int))fp;
 		return 1;
 
 	case SSL_CTRL_SET_TMP_ECDH_CB:
@@ -2564,6 +2595,7 @@ ssl3_choose_cipher(SSL *s, STACK_OF(SSL_CIPHER) *clnt,
 
 	/* Let's see which ciphers we can support */
 	cert = s->cert;
+	ssl_get_cert_masks(cert, &mask_k, &mask_a);
 
 	can_use_ecc = tls1_get_supported_group(s, &nid);
 
@@ -2603,10 +2635,6 @@ ssl3_choose_cipher(SSL *s, STACK_OF(SSL_CIPHER) *clnt,
 		if (!ssl_security_shared_cipher(s, c))
 			continue;
 
-		ssl_set_cert_masks(cert, c);
-		mask_k = cert->mask_k;
-		mask_a = cert->mask_a;
-
 		alg_k = c->algorithm_mkey;
 		alg_a = c->algorithm_auth;
 
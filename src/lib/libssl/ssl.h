@@ -588,6 +588,21 @@ struct lhash_st_SSL_SESSION *SSL_CTX_sessions(SSL_CTX *ctx);
 	SSL_CTX_ctrl(ctx,SSL_CTRL_SESS_TIMEOUTS,0,NULL)
 #define SSL_CTX_sess_cache_full(ctx) \
 	SSL_CTX_ctrl(ctx,SSL_CTRL_SESS_CACHE_FULL,0,NULL)
+#define SSL_CTX_sess_expired(ctx) \
+	SSL_CTX_ctrl(ctx,SSL_CTRL_SESS_EXPIRED,0,NULL)
+#define SSL_CTX_sess_expire_rescheduled(ctx) \
+	SSL_CTX_ctrl(ctx,SSL_CTRL_SESS_EXPIRE_RESCHEDULED,0,NULL)
+#define SSL_CTX_sess_expire_deferred(ctx) \
+	SSL_CTX_ctrl(ctx,SSL_CTRL_SESS_EXPIRE_DEFERRED,0,NULL)
+
+#define SSL_CTX_set_buffer_pool_size(ctx, size) \
+	SSL_CTX_ctrl(ctx,SSL_CTRL_SET_BUFFER_POOL_SIZE,size,NULL)
+#define SSL_CTX_get_buffer_pool_size(ctx) \
+	SSL_CTX_ctrl(ctx,SSL_CTRL_GET_BUFFER_POOL_SIZE,0,NULL)
+#define SSL_CTX_buffer_pool_hits(ctx) \
+	SSL_CTX_ctrl(ctx,SSL_CTRL_BUFFER_POOL_HITS,0,NULL)
+#define SSL_CTX_buffer_pool_misses(ctx) \
+	SSL_CTX_ctrl(ctx,SSL_CTRL_BUFFER_POOL_MISSES,0,NULL)
 
 void SSL_CTX_sess_set_new_cb(SSL_CTX *ctx,
     int (*new_session_cb)(struct ssl_st *ssl, SSL_SESSION *sess));
@@ -961,6 +976,14 @@ int PEM_write_SSL_SESSION(FILE *fp, SSL_SESSION *x);
 #define SSL_CTRL_GET_SIGNATURE_NID			132
 #endif
 
+#define SSL_CTRL_SESS_EXPIRED				200
+#define SSL_CTRL_SESS_EXPIRE_RESCHEDULED		201
+#define SSL_CTRL_SESS_EXPIRE_DEFERRED			202
+#define SSL_CTRL_SET_BUFFER_POOL_SIZE			203
+#define SSL_CTRL_GET_BUFFER_POOL_SIZE			204
+#define SSL_CTRL_BUFFER_POOL_HITS			205
+#define SSL_CTRL_BUFFER_POOL_MISSES			206
+
 #define DTLSv1_get_timeout(ssl, arg) \
 	SSL_ctrl(ssl,DTLS_CTRL_GET_TIMEOUT,0, (void *)arg)
 #define DTLSv1_handle_timeout(ssl) \
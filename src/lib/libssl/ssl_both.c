@@ -485,10 +485,41 @@ ssl3_release_init_buffer(SSL *s)
 	s->init_off = 0;
 }
 
+static struct ssl_buffer_pool *
+ssl3_buffer_pool(SSL *s)
+{
+	if (s->initial_ctx == NULL)
+		return NULL;
+
+	return s->initial_ctx->buffer_pool;
+}
+
+/*
+ * Allocate a zeroed record buffer of at least len bytes. Buffers of up to
+ * SSL_BUFFER_POOL_LEN bytes come from the buffer pool of the SSL_CTX.
+ */
+static int
+ssl3_alloc_buffer(SSL *s, SSL3_BUFFER_INTERNAL *b, size_t len)
+{
+	unsigned char *p;
+
+	if (len <= SSL_BUFFER_POOL_LEN) {
+		p = ssl_buffer_pool_get(ssl3_buffer_pool(s));
+		len = SSL_BUFFER_POOL_LEN;
+	} else
+		p = calloc(1, len);
+	if (p == NULL)
+		return 0;
+
+	b->buf = p;
+	b->len = len;
+
+	return 1;
+}
+
 int
 ssl3_setup_read_buffer(SSL *s)
 {
-	unsigned char *p;
 	size_t len, align, headerlen;
 
 	if (SSL_is_dtls(s))
@@ -501,10 +532,8 @@ ssl3_setup_read_buffer(SSL *s)
 	if (s->s3->rbuf.buf == NULL) {
 		len = SSL3_RT_MAX_PLAIN_LENGTH +
 		    SSL3_RT_MAX_ENCRYPTED_OVERHEAD + headerlen + align;
-		if ((p = calloc(1, len)) == NULL)
+		if (!ssl3_alloc_buffer(s, &s->s3->rbuf, len))
 			goto err;
-		s->s3->rbuf.buf = p;
-		s->s3->rbuf.len = len;
 	}
 
 	s->packet = s->s3->rbuf.buf;
@@ -518,7 +547,6 @@ ssl3_setup_read_buffer(SSL *s)
 int
 ssl3_setup_write_buffer(SSL *s)
 {
-	unsigned char *p;
 	size_t len, align, headerlen;
 
 	if (SSL_is_dtls(s))
@@ -535,10 +563,8 @@ ssl3_setup_write_buffer(SSL *s)
 			len += headerlen + align +
 			    SSL3_RT_SEND_MAX_ENCRYPTED_OVERHEAD;
 
-		if ((p = calloc(1, len)) == NULL)
+		if (!ssl3_alloc_buffer(s, &s->s3->wbuf, len))
 			goto err;
-		s->s3->wbuf.buf = p;
-		s->s3->wbuf.len = len;
 	}
 
 	return 1;
@@ -559,9 +585,12 @@ ssl3_setup_buffers(SSL *s)
 }
 
 void
-ssl3_release_buffer(SSL3_BUFFER_INTERNAL *b)
+ssl3_release_buffer(SSL *s, SSL3_BUFFER_INTERNAL *b)
 {
-	freezero(b->buf, b->len);
+	if (b->buf != NULL && b->len == SSL_BUFFER_POOL_LEN)
+		ssl_buffer_pool_put(ssl3_buffer_pool(s), b->buf);
+	else
+		freezero(b->buf, b->len);
 	b->buf = NULL;
 	b->len = 0;
 }
@@ -569,11 +598,11 @@ ssl3_release_buffer(SSL3_BUFFER_INTERNAL *b)
 void
 ssl3_release_read_buffer(SSL *s)
 {
-	ssl3_release_buffer(&s->s3->rbuf);
+	ssl3_release_buffer(s, &s->s3->rbuf);
 }
 
 void
 ssl3_release_write_buffer(SSL *s)
 {
-	ssl3_release_buffer(&s->s3->wbuf);
+	ssl3_release_buffer(s, &s->s3->wbuf);
 }
@@ -0,0 +1,347 @@
+/* $OpenBSD$ */
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ssl_local.h"
+
+/*
+ * Record buffers are recycled through a pool kept by the SSL_CTX that a
+ * connection was created from, rather than being freed and allocated
+ * again every time SSL_MODE_RELEASE_BUFFERS releases them.
+ *
+ * Each thread keeps up to SSL_BUFFER_CACHE_SIZE free buffers per pool in
+ * thread specific storage, which it takes and returns without locking.
+ * Beyond that, free buffers go to a list in the pool that is shared by
+ * all threads and protected by a mutex, up to the size of the pool.
+ *
+ * The pool is reference counted, since the per-thread free lists can
+ * outlive the SSL_CTX. Once the SSL_CTX is freed the pool is marked dead
+ * and a thread drops its free list for it the next time it looks up one
+ * of its free lists, or when it exits.
+ */
+
+#define SSL_BUFFER_CACHE_SIZE	4
+
+/* Free buffers are linked through their first bytes. */
+struct ssl_pool_buffer {
+	struct ssl_pool_buffer *next;
+};
+
+struct ssl_buffer_pool {
+	pthread_mutex_t lock;
+	struct ssl_pool_buffer *free;
+	size_t num_free;
+
+	atomic_long size;
+	atomic_int dead;
+	atomic_int references;
+
+	atomic_long hits;
+	atomic_long misses;
+};
+
+struct ssl_buffer_cache {
+	struct ssl_buffer_pool *pool;
+	struct ssl_pool_buffer *free;
+	size_t num_free;
+	struct ssl_buffer_cache *next;
+};
+
+static pthread_once_t ssl_buffer_cache_key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t ssl_buffer_cache_key;
+static int ssl_buffer_cache_key_valid;
+
+static void
+ssl_buffer_list_free(struct ssl_pool_buffer *b)
+{
+	struct ssl_pool_buffer *next;
+
+	for (; b != NULL; b = next) {
+		next = b->next;
+		free(b);
+	}
+}
+
+static void
+ssl_buffer_pool_release(struct ssl_buffer_pool *pool)
+{
+	if (atomic_fetch_sub(&pool->references, 1) != 1)
+		return;
+
+	ssl_buffer_list_free(pool->free);
+	(void) pthread_mutex_destroy(&pool->lock);
+	free(pool);
+}
+
+struct ssl_buffer_pool *
+ssl_buffer_pool_new(void)
+{
+	struct ssl_buffer_pool *pool;
+
+	if ((pool = calloc(1, sizeof(*pool))) == NULL)
+		return NULL;
+	if (pthread_mutex_init(&pool->lock, NULL) != 0) {
+		free(pool);
+		return NULL;
+	}
+	atomic_init(&pool->size, SSL_BUFFER_POOL_SIZE_DEFAULT);
+	atomic_init(&pool->dead, 0);
+	atomic_init(&pool->references, 1);
+	atomic_init(&pool->hits, 0);
+	atomic_init(&pool->misses, 0);
+
+	return pool;
+}
+
+void
+ssl_buffer_pool_free(struct ssl_buffer_pool *pool)
+{
+	struct ssl_pool_buffer *free_list;
+
+	if (pool == NULL)
+		return;
+
+	(void) pthread_mutex_lock(&pool->lock);
+	atomic_store(&pool->dead, 1);
+	free_list = pool->free;
+	pool->free = NULL;
+	pool->num_free = 0;
+	(void) pthread_mutex_unlock(&pool->lock);
+
+	ssl_buffer_list_free(free_list);
+
+	ssl_buffer_pool_release(pool);
+}
+
+/* Return a buffer to the shared free list, or free it if that is full. */
+static void
+ssl_buffer_pool_put_shared(struct ssl_buffer_pool *pool,
+    struct ssl_pool_buffer *b)
+{
+	(void) pthread_mutex_lock(&pool->lock);
+	if (!atomic_load(&pool->dead) &&
+	    pool->num_free < (size_t)atomic_load(&pool->size)) {
+		b->next = pool->free;
+		pool->free = b;
+		pool->num_free++;
+		b = NULL;
+	}
+	(void) pthread_mutex_unlock(&pool->lock);
+
+	free(b);
+}
+
+static void
+ssl_buffer_cache_free(struct ssl_buffer_cache *cache)
+{
+	struct ssl_pool_buffer *b, *next;
+
+	for (b = cache->free; b != NULL; b = next) {
+		next = b->next;
+		ssl_buffer_pool_put_shared(cache->pool, b);
+	}
+	ssl_buffer_pool_release(cache->pool);
+	free(cache);
+}
+
+static void
+ssl_buffer_cache_key_free(void *arg)
+{
+	struct ssl_buffer_cache *cache, *next;
+
+	for (cache = arg; cache != NULL; cache = next) {
+		next = cache->next;
+		ssl_buffer_cache_free(cache);
+	}
+}
+
+static void
+ssl_buffer_cache_key_init(void)
+{
+	if (pthread_key_create(&ssl_buffer_cache_key,
+	    ssl_buffer_cache_key_free) == 0)
+		ssl_buffer_cache_key_valid = 1;
+}
+
+/*
+ * Find the free list of the calling thread for pool, creating it if need
+ * be. Free lists of dead pools are dropped on the way, except for the
+ * first one, which stays until the thread exits so that the thread
+ * specific value only needs to be set once.
+ */
+static struct ssl_buffer_cache *
+ssl_buffer_cache_get(struct ssl_buffer_pool *pool)
+{
+	struct ssl_buffer_cache *head, *cache, **pcache;
+
+	(void) pthread_once(&ssl_buffer_cache_key_once,
+	    ssl_buffer_cache_key_init);
+	if (!ssl_buffer_cache_key_valid)
+		return NULL;
+
+	if ((head = pthread_getspecific(ssl_buffer_cache_key)) != NULL) {
+		if (head->pool == pool)
+			return head;
+		pcache = &head->next;
+		while ((cache = *pcache) != NULL) {
+			if (cache->pool == pool)
+				return cache;
+			if (atomic_load(&cache->pool->dead)) {
+				*pcache = cache->next;
+				ssl_buffer_cache_free(cache);
+				continue;
+			}
+			pcache = &cache->next;
+		}
+		if (atomic_load(&head->pool->dead)) {
+			ssl_buffer_list_free(head->free);
+			head->free = NULL;
+			head->num_free = 0;
+		}
+	}
+
+	if ((cache = calloc(1, sizeof(*cache))) == NULL)
+		return NULL;
+	atomic_fetch_add(&pool->references, 1);
+	cache->pool = pool;
+
+	if (head == NULL) {
+		if (pthread_setspecific(ssl_buffer_cache_key, cache) != 0) {
+			ssl_buffer_cache_free(cache);
+			return NULL;
+		}
+		return cache;
+	}
+
+	cache->next = head->next;
+	head->next = cache;
+
+	return cache;
+}
+
+/*
+ * Return a zeroed buffer of SSL_BUFFER_POOL_LEN bytes, from the pool if
+ * it has one.
+ */
+uint8_t *
+ssl_buffer_pool_get(struct ssl_buffer_pool *pool)
+{
+	struct ssl_buffer_cache *cache;
+	struct ssl_pool_buffer *b = NULL;
+
+	if (pool == NULL)
+		return calloc(1, SSL_BUFFER_POOL_LEN);
+
+	if ((cache = ssl_buffer_cache_get(pool)) != NULL &&
+	    (b = cache->free) != NULL) {
+		cache->free = b->next;
+		cache->num_free--;
+	}
+	if (b == NULL) {
+		(void) pthread_mutex_lock(&pool->lock);
+		if ((b = pool->free) != NULL) {
+			pool->free = b->next;
+			pool->num_free--;
+		}
+		(void) pthread_mutex_unlock(&pool->lock);
+	}
+
+	if (b == NULL) {
+		atomic_fetch_add_explicit(&pool->misses, 1,
+		    memory_order_relaxed);
+		return calloc(1, SSL_BUFFER_POOL_LEN);
+	}
+	atomic_fetch_add_explicit(&pool->hits, 1, memory_order_relaxed);
+
+	/* Buffers are zeroed when returned, except for the link. */
+	b->next = NULL;
+
+	return (uint8_t *)b;
+}
+
+/*
+ * Return a buffer obtained from ssl_buffer_pool_get() to the pool. The
+ * buffer is cleared, since it may hold key material or plaintext.
+ */
+void
+ssl_buffer_pool_put(struct ssl_buffer_pool *pool, uint8_t *buf)
+{
+	struct ssl_buffer_cache *cache;
+	struct ssl_pool_buffer *b;
+	long size;
+
+	if (buf == NULL)
+		return;
+
+	explicit_bzero(buf, SSL_BUFFER_POOL_LEN);
+
+	if (pool == NULL || (size = atomic_load(&pool->size)) == 0) {
+		free(buf);
+		return;
+	}
+
+	b = (struct ssl_pool_buffer *)buf;
+
+	if ((cache = ssl_buffer_cache_get(pool)) != NULL &&
+	    cache->num_free < SSL_BUFFER_CACHE_SIZE &&
+	    cache->num_free < (size_t)size) {
+		b->next = cache->free;
+		cache->free = b;
+		cache->num_free++;
+		return;
+	}
+
+	ssl_buffer_pool_put_shared(pool, b);
+}
+
+long
+ssl_buffer_pool_ctrl(struct ssl_buffer_pool *pool, int cmd, long larg)
+{
+	struct ssl_pool_buffer *b, *free_list = NULL;
+	long size;
+
+	switch (cmd) {
+	case SSL_CTRL_SET_BUFFER_POOL_SIZE:
+		if (larg < 0)
+			return 0;
+		size = atomic_exchange(&pool->size, larg);
+		(void) pthread_mutex_lock(&pool->lock);
+		while (pool->num_free > (size_t)larg) {
+			b = pool->free;
+			pool->free = b->next;
+			pool->num_free--;
+			b->next = free_list;
+			free_list = b;
+		}
+		(void) pthread_mutex_unlock(&pool->lock);
+		ssl_buffer_list_free(free_list);
+		return size;
+	case SSL_CTRL_GET_BUFFER_POOL_SIZE:
+		return atomic_load(&pool->size);
+	case SSL_CTRL_BUFFER_POOL_HITS:
+		return atomic_load_explicit(&pool->hits, memory_order_relaxed);
+	case SSL_CTRL_BUFFER_POOL_MISSES:
+		return atomic_load_explicit(&pool->misses,
+		    memory_order_relaxed);
+	}
+
+	return 0;
+}
@@ -194,10 +194,6 @@ ssl_cert_dup(SSL_CERT *cert)
 	 */
 	ret->key = &ret->pkeys[cert->key - &cert->pkeys[0]];
 
-	ret->valid = cert->valid;
-	ret->mask_k = cert->mask_k;
-	ret->mask_a = cert->mask_a;
-
 	if (cert->dhe_params != NULL) {
 		ret->dhe_params = DHparams_dup(cert->dhe_params);
 		if (ret->dhe_params == NULL) {
@@ -298,13 +294,42 @@ ssl_cert_free(SSL_CERT *c)
 	free(c);
 }
 
+/*
+ * An SSL shares the SSL_CERT of the SSL_CTX it was created from, so that
+ * SSL_new() does not need to copy it. Whoever modifies a shared SSL_CERT
+ * first replaces its reference with a private copy.
+ */
+int
+ssl_cert_own(SSL_CERT **pcert)
+{
+	SSL_CERT *cert;
+
+	/* A sole reference cannot be shared concurrently. */
+	if ((*pcert)->references == 1)
+		return 1;
+
+	if ((cert = ssl_cert_dup(*pcert)) == NULL)
+		return 0;
+	ssl_cert_free(*pcert);
+	*pcert = cert;
+
+	return 1;
+}
+
+/*
+ * Return the SSL_CERT of the SSL, or of the SSL_CTX if ssl is NULL, for
+ * modification.
+ */
 SSL_CERT *
 ssl_get0_cert(SSL_CTX *ctx, SSL *ssl)
 {
-	if (ssl != NULL)
-		return ssl->cert;
+	SSL_CERT **pcert;
+
+	pcert = ssl != NULL ? &ssl->cert : &ctx->cert;
+	if (!ssl_cert_own(pcert))
+		return NULL;
 
-	return ctx->cert;
+	return *pcert;
 }
 
 int
@@ -428,7 +453,7 @@ ssl_verify_cert_chain(SSL *s, STACK_OF(X509) *certs)
 	 * Anything non-default in "param" should overwrite anything
 	 * in the ctx.
 	 */
-	X509_VERIFY_PARAM_set1(param, s->param);
+	X509_VERIFY_PARAM_set1(param, ssl_get0_param(s));
 
 	if (s->verify_callback)
 		X509_STORE_CTX_set_verify_cb(ctx, s->verify_callback);
@@ -607,7 +607,9 @@ ssl3_connect(SSL *s)
 
 			ssl_update_cache(s, SSL_SESS_CACHE_CLIENT);
 			if (s->hit)
-				s->ctx->stats.sess_hit++;
+				atomic_fetch_add_explicit(
+				    &s->ctx->stats.sess_hit, 1,
+				    memory_order_relaxed);
 
 			ret = 1;
 			/* s->server=0; */
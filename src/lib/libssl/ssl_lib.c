@@ -229,7 +229,7 @@ SSL_CTX_set_ssl_version(SSL_CTX *ctx, const SSL_METHOD *meth)
 
 	ciphers = ssl_create_cipher_list(ctx->method, &ctx->cipher_list,
 	    ctx->cipher_list_tls13, SSL_DEFAULT_CIPHER_LIST,
-	    ctx->cert);
+	    &ctx->cert);
 	if (ciphers == NULL || sk_SSL_CIPHER_num(ciphers) <= 0) {
 		SSLerrorx(SSL_R_SSL_LIBRARY_HAS_NO_CIPHERS);
 		return (0);
@@ -268,8 +268,13 @@ SSL_new(SSL_CTX *ctx)
 	s->max_cert_list = ctx->max_cert_list;
 	s->num_tickets = ctx->num_tickets;
 
-	if ((s->cert = ssl_cert_dup(ctx->cert)) == NULL)
-		goto err;
+	/* Shared until modified, see ssl_cert_own(). */
+	CRYPTO_add(&ctx->cert->references, 1, CRYPTO_LOCK_SSL_CERT);
+	s->cert = ctx->cert;
+
+	/* Shared until the SSL_CTX modifies them, see ssl_ctx_params_own(). */
+	CRYPTO_add(&ctx->params->references, 1, CRYPTO_LOCK_SSL_CTX);
+	s->ctx_params = ctx->params;
 
 	s->read_ahead = ctx->read_ahead;
 	s->msg_callback = ctx->msg_callback;
@@ -281,10 +286,6 @@ SSL_new(SSL_CTX *ctx)
 	s->verify_callback = ctx->default_verify_callback;
 	s->generate_session_id = ctx->generate_session_id;
 
-	s->param = X509_VERIFY_PARAM_new();
-	if (!s->param)
-		goto err;
-	X509_VERIFY_PARAM_inherit(s->param, ctx->param);
 	s->quiet_shutdown = ctx->quiet_shutdown;
 	s->max_send_fragment = ctx->max_send_fragment;
 
@@ -302,32 +303,10 @@ SSL_new(SSL_CTX *ctx)
 	CRYPTO_add(&ctx->references, 1, CRYPTO_LOCK_SSL_CTX);
 	s->initial_ctx = ctx;
 
-	if (ctx->tlsext_ecpointformatlist != NULL) {
-		s->tlsext_ecpointformatlist =
-		    calloc(ctx->tlsext_ecpointformatlist_length,
-			sizeof(ctx->tlsext_ecpointformatlist[0]));
-		if (s->tlsext_ecpointformatlist == NULL)
-			goto err;
-		memcpy(s->tlsext_ecpointformatlist,
-		    ctx->tlsext_ecpointformatlist,
-		    ctx->tlsext_ecpointformatlist_length *
-		    sizeof(ctx->tlsext_ecpointformatlist[0]));
-		s->tlsext_ecpointformatlist_length =
-		    ctx->tlsext_ecpointformatlist_length;
-	}
-	if (ctx->tlsext_supportedgroups != NULL) {
-		s->tlsext_supportedgroups =
-		    calloc(ctx->tlsext_supportedgroups_length,
-			sizeof(ctx->tlsext_supportedgroups[0]));
-		if (s->tlsext_supportedgroups == NULL)
-			goto err;
-		memcpy(s->tlsext_supportedgroups,
-		    ctx->tlsext_supportedgroups,
-		    ctx->tlsext_supportedgroups_length *
-		    sizeof(ctx->tlsext_supportedgroups[0]));
-		s->tlsext_supportedgroups_length =
-		    ctx->tlsext_supportedgroups_length;
-	}
+	/*
+	 * The verify parameters and the ecpointformat and supported groups
+	 * lists are those of the initial SSL_CTX until set on the SSL.
+	 */
 
 	CBS_init(&cbs, ctx->alpn_client_proto_list,
 	    ctx->alpn_client_proto_list_len);
@@ -415,7 +394,7 @@ SSL_has_matching_session_id(const SSL *ssl, const unsigned char *id,
 	 * that would conflict with any new session built out of this
 	 * id/id_len and the ssl_version in use by this SSL.
 	 */
-	SSL_SESSION r, *p;
+	SSL_SESSION r;
 
 	if (id_len > sizeof r.session_id)
 		return (0);
@@ -424,84 +403,254 @@ SSL_has_matching_session_id(const SSL *ssl, const unsigned char *id,
 	r.session_id_length = id_len;
 	memcpy(r.session_id, id, id_len);
 
-	CRYPTO_r_lock(CRYPTO_LOCK_SSL_CTX);
-	p = lh_SSL_SESSION_retrieve(ssl->ctx->sessions, &r);
-	CRYPTO_r_unlock(CRYPTO_LOCK_SSL_CTX);
-	return (p != NULL);
+	return ssl_session_cache_has_session(ssl->ctx, &r);
+}
+
+SSL_CTX_PARAMS *
+ssl_ctx_params_new(void)
+{
+	SSL_CTX_PARAMS *params;
+
+	if ((params = calloc(1, sizeof(*params))) == NULL)
+		return NULL;
+	if ((params->param = X509_VERIFY_PARAM_new()) == NULL) {
+		free(params);
+		return NULL;
+	}
+	params->references = 1;
+
+	return params;
+}
+
+static SSL_CTX_PARAMS *
+ssl_ctx_params_dup(const SSL_CTX_PARAMS *params)
+{
+	SSL_CTX_PARAMS *copy;
+	size_t groups_len;
+
+	if ((copy = ssl_ctx_params_new()) == NULL)
+		return NULL;
+	if (!X509_VERIFY_PARAM_set1(copy->param, params->param))
+		goto err;
+	if (params->tlsext_supportedgroups != NULL) {
+		groups_len = params->tlsext_supportedgroups_length;
+		if ((copy->tlsext_supportedgroups = calloc(groups_len,
+		    sizeof(uint16_t))) == NULL)
+			goto err;
+		memcpy(copy->tlsext_supportedgroups,
+		    params->tlsext_supportedgroups,
+		    groups_len * sizeof(uint16_t));
+		copy->tlsext_supportedgroups_length = groups_len;
+	}
+
+	return copy;
+
+ err:
+	ssl_ctx_params_free(copy);
+
+	return NULL;
+}
+
+void
+ssl_ctx_params_free(SSL_CTX_PARAMS *params)
+{
+	if (params == NULL)
+		return;
+
+	if (CRYPTO_add(&params->references, -1, CRYPTO_LOCK_SSL_CTX) > 0)
+		return;
+
+	X509_VERIFY_PARAM_free(params->param);
+	free(params->tlsext_supportedgroups);
+	free(params);
+}
+
+/*
+ * An SSL shares the verify parameters and groups of the SSL_CTX it was
+ * created from. The SSL_CTX replaces a shared reference with a private copy
+ * before modifying them, so that existing SSLs keep what they started with.
+ */
+int
+ssl_ctx_params_own(SSL_CTX *ctx)
+{
+	SSL_CTX_PARAMS *params;
+
+	/* A sole reference cannot be shared concurrently. */
+	if (ctx->params->references == 1)
+		return 1;
+
+	if ((params = ssl_ctx_params_dup(ctx->params)) == NULL) {
+		SSLerrorx(ERR_R_MALLOC_FAILURE);
+		return 0;
+	}
+	ssl_ctx_params_free(ctx->params);
+	ctx->params = params;
+
+	return 1;
+}
+
+/*
+ * Return the verify parameters of the SSL_CTX for modification.
+ */
+static X509_VERIFY_PARAM *
+ssl_ctx_param_own(SSL_CTX *ctx)
+{
+	if (!ssl_ctx_params_own(ctx))
+		return NULL;
+
+	return ctx->params->param;
+}
+
+/*
+ * Return the verify parameters in effect for the SSL, for reading.
+ */
+X509_VERIFY_PARAM *
+ssl_get0_param(const SSL *s)
+{
+	if (s->param != NULL)
+		return s->param;
+
+	return s->ctx_params->param;
+}
+
+/*
+ * Return the verify parameters of the SSL for modification, giving it its
+ * own copy of those of the initial SSL_CTX if it does not have one yet.
+ */
+static X509_VERIFY_PARAM *
+ssl_param_own(SSL *s)
+{
+	X509_VERIFY_PARAM *param;
+
+	if (s->param != NULL)
+		return s->param;
+
+	if ((param = X509_VERIFY_PARAM_new()) == NULL) {
+		SSLerror(s, ERR_R_MALLOC_FAILURE);
+		return NULL;
+	}
+	if (!X509_VERIFY_PARAM_inherit(param, s->ctx_params->param)) {
+		X509_VERIFY_PARAM_free(param);
+		return NULL;
+	}
+	s->param = param;
+
+	return s->param;
 }
 
 int
 SSL_CTX_set_purpose(SSL_CTX *s, int purpose)
 {
-	return (X509_VERIFY_PARAM_set_purpose(s->param, purpose));
+	X509_VERIFY_PARAM *param;
+
+	if ((param = ssl_ctx_param_own(s)) == NULL)
+		return 0;
+
+	return (X509_VERIFY_PARAM_set_purpose(param, purpose));
 }
 
 int
 SSL_set_purpose(SSL *s, int purpose)
 {
-	return (X509_VERIFY_PARAM_set_purpose(s->param, purpose));
+	X509_VERIFY_PARAM *param;
+
+	if ((param = ssl_param_own(s)) == NULL)
+		return 0;
+
+	return (X509_VERIFY_PARAM_set_purpose(param, purpose));
 }
 
 int
 SSL_CTX_set_trust(SSL_CTX *s, int trust)
 {
-	return (X509_VERIFY_PARAM_set_trust(s->param, trust));
+	X509_VERIFY_PARAM *param;
+
+	if ((param = ssl_ctx_param_own(s)) == NULL)
+		return 0;
+
+	return (X509_VERIFY_PARAM_set_trust(param, trust));
 }
 
 int
 SSL_set_trust(SSL *s, int trust)
 {
-	return (X509_VERIFY_PARAM_set_trust(s->param, trust));
+	X509_VERIFY_PARAM *param;
+
+	if ((param = ssl_param_own(s)) == NULL)
+		return 0;
+
+	return (X509_VERIFY_PARAM_set_trust(param, trust));
 }
 
 int
 SSL_set1_host(SSL *s, const char *hostname)
 {
+	X509_VERIFY_PARAM *param;
 	struct in_addr ina;
 	struct in6_addr in6a;
 
+	if ((param = ssl_param_own(s)) == NULL)
+		return 0;
+
 	if (hostname != NULL && *hostname != '\0' &&
 	    (inet_pton(AF_INET, hostname, &ina) == 1 ||
 	    inet_pton(AF_INET6, hostname, &in6a) == 1))
-		return X509_VERIFY_PARAM_set1_ip_asc(s->param, hostname);
+		return X509_VERIFY_PARAM_set1_ip_asc(param, hostname);
 	else
-		return X509_VERIFY_PARAM_set1_host(s->param, hostname, 0);
+		return X509_VERIFY_PARAM_set1_host(param, hostname, 0);
 }
 
 void
 SSL_set_hostflags(SSL *s, unsigned int flags)
 {
-	X509_VERIFY_PARAM_set_hostflags(s->param, flags);
+	X509_VERIFY_PARAM *param;
+
+	if ((param = ssl_param_own(s)) == NULL)
+		return;
+
+	X509_VERIFY_PARAM_set_hostflags(param, flags);
 }
 
 const char *
 SSL_get0_peername(SSL *s)
 {
-	return X509_VERIFY_PARAM_get0_peername(s->param);
+	return X509_VERIFY_PARAM_get0_peername(ssl_get0_param(s));
 }
 
 X509_VERIFY_PARAM *
 SSL_CTX_get0_param(SSL_CTX *ctx)
 {
-	return (ctx->param);
+	/* The caller may modify the returned parameters. */
+	return ssl_ctx_param_own(ctx);
 }
 
 int
 SSL_CTX_set1_param(SSL_CTX *ctx, X509_VERIFY_PARAM *vpm)
 {
-	return (X509_VERIFY_PARAM_set1(ctx->param, vpm));
+	X509_VERIFY_PARAM *param;
+
+	if ((param = ssl_ctx_param_own(ctx)) == NULL)
+		return 0;
+
+	return (X509_VERIFY_PARAM_set1(param, vpm));
 }
 
 X509_VERIFY_PARAM *
 SSL_get0_param(SSL *ssl)
 {
-	return (ssl->param);
+	/* The caller may modify the returned parameters. */
+	return ssl_param_own(ssl);
 }
 
 int
 SSL_set1_param(SSL *ssl, X509_VERIFY_PARAM *vpm)
 {
-	return (X509_VERIFY_PARAM_set1(ssl->param, vpm));
+	X509_VERIFY_PARAM *param;
+
+	if ((param = ssl_param_own(ssl)) == NULL)
+		return 0;
+
+	return (X509_VERIFY_PARAM_set1(param, vpm));
 }
 
 void
@@ -549,9 +698,9 @@ SSL_free(SSL *s)
 	ssl_clear_cipher_state(s);
 
 	ssl_cert_free(s->cert);
+	ssl_ctx_params_free(s->ctx_params);
 
 	free(s->tlsext_hostname);
-	SSL_CTX_free(s->initial_ctx);
 
 	free(s->tlsext_ecpointformatlist);
 	free(s->tlsext_supportedgroups);
@@ -567,6 +716,8 @@ SSL_free(SSL *s)
 		s->method->ssl_free(s);
 
 	SSL_CTX_free(s->ctx);
+	/* Record buffers go back to the pool of the initial SSL_CTX. */
+	SSL_CTX_free(s->initial_ctx);
 
 	free(s->alpn_client_proto_list);
 
@@ -760,7 +911,7 @@ SSL_get_verify_mode(const SSL *s)
 int
 SSL_get_verify_depth(const SSL *s)
 {
-	return (X509_VERIFY_PARAM_get_depth(s->param));
+	return (X509_VERIFY_PARAM_get_depth(ssl_get0_param(s)));
 }
 
 int
@@ -818,7 +969,7 @@ SSL_CTX_get_verify_mode(const SSL_CTX *ctx)
 int
 SSL_CTX_get_verify_depth(const SSL_CTX *ctx)
 {
-	return (X509_VERIFY_PARAM_get_depth(ctx->param));
+	return (X509_VERIFY_PARAM_get_depth(ctx->params->param));
 }
 
 int
@@ -839,7 +990,12 @@ SSL_set_verify(SSL *s, int mode,
 void
 SSL_set_verify_depth(SSL *s, int depth)
 {
-	X509_VERIFY_PARAM_set_depth(s->param, depth);
+	X509_VERIFY_PARAM *param;
+
+	if ((param = ssl_param_own(s)) == NULL)
+		return;
+
+	X509_VERIFY_PARAM_set_depth(param, depth);
 }
 
 void
@@ -1335,7 +1491,7 @@ SSL_callback_ctrl(SSL *s, int cmd, void (*fp)(void))
 struct lhash_st_SSL_SESSION *
 SSL_CTX_sessions(SSL_CTX *ctx)
 {
-	return (ctx->sessions);
+	return ssl_session_cache_sessions(ctx);
 }
 
 long
@@ -1376,7 +1532,7 @@ SSL_CTX_ctrl(SSL_CTX *ctx, int cmd, long larg, void *parg)
 		return (ctx->session_cache_mode);
 
 	case SSL_CTRL_SESS_NUMBER:
-		return (lh_SSL_SESSION_num_items(ctx->sessions));
+		return (ssl_session_cache_num_items(ctx));
 	case SSL_CTRL_SESS_CONNECT:
 		return (ctx->stats.sess_connect);
 	case SSL_CTRL_SESS_CONNECT_GOOD:
@@ -1390,15 +1546,21 @@ SSL_CTX_ctrl(SSL_CTX *ctx, int cmd, long larg, void *parg)
 	case SSL_CTRL_SESS_ACCEPT_RENEGOTIATE:
 		return (ctx->stats.sess_accept_renegotiate);
 	case SSL_CTRL_SESS_HIT:
-		return (ctx->stats.sess_hit);
+		return (atomic_load(&ctx->stats.sess_hit));
 	case SSL_CTRL_SESS_CB_HIT:
-		return (ctx->stats.sess_cb_hit);
+		return (atomic_load(&ctx->stats.sess_cb_hit));
 	case SSL_CTRL_SESS_MISSES:
-		return (ctx->stats.sess_miss);
+		return (atomic_load(&ctx->stats.sess_miss));
 	case SSL_CTRL_SESS_TIMEOUTS:
-		return (ctx->stats.sess_timeout);
+		return (atomic_load(&ctx->stats.sess_timeout));
 	case SSL_CTRL_SESS_CACHE_FULL:
-		return (ctx->stats.sess_cache_full);
+		return (atomic_load(&ctx->stats.sess_cache_full));
+	case SSL_CTRL_SESS_EXPIRED:
+		return (atomic_load(&ctx->stats.sess_expired));
+	case SSL_CTRL_SESS_EXPIRE_RESCHEDULED:
+		return (atomic_load(&ctx->stats.sess_expire_rescheduled));
+	case SSL_CTRL_SESS_EXPIRE_DEFERRED:
+		return (atomic_load(&ctx->stats.sess_expire_deferred));
 	case SSL_CTRL_OPTIONS:
 		return (ctx->options|=larg);
 	case SSL_CTRL_CLEAR_OPTIONS:
@@ -1412,6 +1574,11 @@ SSL_CTX_ctrl(SSL_CTX *ctx, int cmd, long larg, void *parg)
 			return (0);
 		ctx->max_send_fragment = larg;
 		return (1);
+	case SSL_CTRL_SET_BUFFER_POOL_SIZE:
+	case SSL_CTRL_GET_BUFFER_POOL_SIZE:
+	case SSL_CTRL_BUFFER_POOL_HITS:
+	case SSL_CTRL_BUFFER_POOL_MISSES:
+		return (ssl_buffer_pool_ctrl(ctx->buffer_pool, cmd, larg));
 	default:
 		return (ssl3_ctx_ctrl(ctx, cmd, larg, parg));
 	}
@@ -1560,7 +1727,7 @@ SSL_CTX_set_cipher_list(SSL_CTX *ctx, const char *str)
 	 * ctx->cipher_list has been updated.
 	 */
 	ciphers = ssl_create_cipher_list(ctx->method, &ctx->cipher_list,
-	    ctx->cipher_list_tls13, str, ctx->cert);
+	    ctx->cipher_list_tls13, str, &ctx->cert);
 	if (ciphers == NULL) {
 		return (0);
 	} else if (sk_SSL_CIPHER_num(ciphers) == 0) {
@@ -1595,7 +1762,7 @@ SSL_set_cipher_list(SSL *s, const char *str)
 
 	/* See comment in SSL_CTX_set_cipher_list. */
 	ciphers = ssl_create_cipher_list(s->ctx->method, &s->cipher_list,
-	    ciphers_tls13, str, s->cert);
+	    ciphers_tls13, str, &s->cert);
 	if (ciphers == NULL) {
 		return (0);
 	} else if (sk_SSL_CIPHER_num(ciphers) == 0) {
@@ -1885,61 +2052,6 @@ SSL_export_keying_material(SSL *s, unsigned char *out, size_t out_len,
 	    use_context, out, out_len);
 }
 
-static unsigned long
-ssl_session_hash(const SSL_SESSION *a)
-{
-	unsigned long	l;
-
-	l = (unsigned long)
-	    ((unsigned int) a->session_id[0]     )|
-	    ((unsigned int) a->session_id[1]<< 8L)|
-	    ((unsigned long)a->session_id[2]<<16L)|
-	    ((unsigned long)a->session_id[3]<<24L);
-	return (l);
-}
-
-/*
- * NB: If this function (or indeed the hash function which uses a sort of
- * coarser function than this one) is changed, ensure
- * SSL_CTX_has_matching_session_id() is checked accordingly. It relies on being
- * able to construct an SSL_SESSION that will collide with any existing session
- * with a matching session ID.
- */
-static int
-ssl_session_cmp(const SSL_SESSION *a, const SSL_SESSION *b)
-{
-	if (a->ssl_version != b->ssl_version)
-		return (1);
-	if (a->session_id_length != b->session_id_length)
-		return (1);
-	if (timingsafe_memcmp(a->session_id, b->session_id, a->session_id_length) != 0)
-		return (1);
-	return (0);
-}
-
-/*
- * These wrapper functions should remain rather than redeclaring
- * SSL_SESSION_hash and SSL_SESSION_cmp for void* types and casting each
- * variable. The reason is that the functions aren't static, they're exposed via
- * ssl.h.
- */
-static unsigned long
-ssl_session_LHASH_HASH(const void *arg)
-{
-	const SSL_SESSION *a = arg;
-
-	return ssl_session_hash(a);
-}
-
-static int
-ssl_session_LHASH_COMP(const void *arg1, const void *arg2)
-{
-	const SSL_SESSION *a = arg1;
-	const SSL_SESSION *b = arg2;
-
-	return ssl_session_cmp(a, b);
-}
-
 SSL_CTX *
 SSL_CTX_new(const SSL_METHOD *meth)
 {
@@ -1975,8 +2087,6 @@ SSL_CTX_new(const SSL_METHOD *meth)
 	ret->cert_store = NULL;
 	ret->session_cache_mode = SSL_SESS_CACHE_SERVER;
 	ret->session_cache_size = SSL_SESSION_CACHE_MAX_SIZE_DEFAULT;
-	ret->session_cache_head = NULL;
-	ret->session_cache_tail = NULL;
 
 	/* We take the system default */
 	ret->session_timeout = ssl_get_default_timeout();
@@ -2013,23 +2123,23 @@ SSL_CTX_new(const SSL_METHOD *meth)
 	ret->app_gen_cookie_cb = 0;
 	ret->app_verify_cookie_cb = 0;
 
-	ret->sessions = lh_SSL_SESSION_new();
-	if (ret->sessions == NULL)
+	if (!ssl_session_cache_init(ret))
+		goto err;
+	if ((ret->buffer_pool = ssl_buffer_pool_new()) == NULL)
 		goto err;
 	ret->cert_store = X509_STORE_new();
 	if (ret->cert_store == NULL)
 		goto err;
 
 	ssl_create_cipher_list(ret->method, &ret->cipher_list,
-	    NULL, SSL_DEFAULT_CIPHER_LIST, ret->cert);
+	    NULL, SSL_DEFAULT_CIPHER_LIST, &ret->cert);
 	if (ret->cipher_list == NULL ||
 	    sk_SSL_CIPHER_num(ret->cipher_list) <= 0) {
 		SSLerrorx(SSL_R_LIBRARY_HAS_NO_CIPHERS);
 		goto err2;
 	}
 
-	ret->param = X509_VERIFY_PARAM_new();
-	if (!ret->param)
+	if ((ret->params = ssl_ctx_params_new()) == NULL)
 		goto err;
 
 	if ((ret->client_CA = sk_X509_NAME_new_null()) == NULL)
@@ -2098,7 +2208,7 @@ SSL_CTX_free(SSL_CTX *ctx)
 	if (i > 0)
 		return;
 
-	X509_VERIFY_PARAM_free(ctx->param);
+	ssl_ctx_params_free(ctx->params);
 
 	/*
 	 * Free internal session cache. However: the remove_cb() may reference
@@ -2109,12 +2219,12 @@ SSL_CTX_free(SSL_CTX *ctx)
 	 * free ex_data, then finally free the cache.
 	 * (See ticket [openssl.org #212].)
 	 */
-	if (ctx->sessions != NULL)
-		SSL_CTX_flush_sessions(ctx, 0);
+	SSL_CTX_flush_sessions(ctx, 0);
 
 	CRYPTO_free_ex_data(CRYPTO_EX_INDEX_SSL_CTX, ctx, &ctx->ex_data);
 
-	lh_SSL_SESSION_free(ctx->sessions);
+	ssl_session_cache_free(ctx);
+	ssl_buffer_pool_free(ctx->buffer_pool);
 
 	X509_STORE_free(ctx->cert_store);
 	sk_SSL_CIPHER_free(ctx->cipher_list);
@@ -2133,7 +2243,6 @@ SSL_CTX_free(SSL_CTX *ctx)
 #endif
 
 	free(ctx->tlsext_ecpointformatlist);
-	free(ctx->tlsext_supportedgroups);
 
 	free(ctx->alpn_client_proto_list);
 
@@ -2189,14 +2298,23 @@ SSL_CTX_set_verify(SSL_CTX *ctx, int mode, int (*cb)(int, X509_STORE_CTX *))
 void
 SSL_CTX_set_verify_depth(SSL_CTX *ctx, int depth)
 {
-	X509_VERIFY_PARAM_set_depth(ctx->param, depth);
+	X509_VERIFY_PARAM *param;
+
+	if ((param = ssl_ctx_param_own(ctx)) == NULL)
+		return;
+
+	X509_VERIFY_PARAM_set_depth(param, depth);
 }
 
 void
-ssl_set_cert_masks(SSL_CERT *c, const SSL_CIPHER *cipher)
+ssl_get_cert_masks(const SSL_CERT *c, unsigned long *out_mask_k,
+    unsigned long *out_mask_a)
 {
 	unsigned long mask_a, mask_k;
-	SSL_CERT_PKEY *cpk;
+	const SSL_CERT_PKEY *cpk;
+
+	*out_mask_k = 0;
+	*out_mask_a = 0;
 
 	if (c == NULL)
 		return;
@@ -2227,9 +2345,8 @@ ssl_set_cert_masks(SSL_CERT *c, const SSL_CIPHER *cipher)
 		mask_k |= SSL_kRSA;
 	}
 
-	c->mask_k = mask_k;
-	c->mask_a = mask_a;
-	c->valid = 1;
+	*out_mask_k = mask_k;
+	*out_mask_a = mask_a;
 }
 
 /* See if this handshake is using an ECC cipher suite. */
@@ -2273,7 +2390,6 @@ ssl_get_server_send_pkey(const SSL *s)
 	int i;
 
 	c = s->cert;
-	ssl_set_cert_masks(c, s->s3->hs.cipher);
 
 	alg_a = s->s3->hs.cipher->algorithm_auth;
 
@@ -2453,7 +2569,7 @@ ssl_update_cache(SSL *s, int mode)
 			    SSL_SESSION_free(s->session);
 	}
 
-	/* Auto flush every 255 connections. */
+	/* Auto expire sessions every 255 connections. */
 	if (!(cache_mode & SSL_SESS_CACHE_NO_AUTO_CLEAR) &&
 	    (cache_mode & mode) != 0) {
 		int connections;
@@ -2462,7 +2578,7 @@ ssl_update_cache(SSL *s, int mode)
 		else
 			connections = s->session_ctx->stats.sess_accept_good;
 		if ((connections & 0xff) == 0xff)
-			SSL_CTX_flush_sessions(s->session_ctx, time(NULL));
+			ssl_session_cache_expire(s->session_ctx, time(NULL));
 	}
 }
 
@@ -2790,6 +2906,7 @@ SSL *
 SSL_dup(SSL *s)
 {
 	STACK_OF(X509_NAME) *sk;
+	X509_VERIFY_PARAM *param;
 	X509_NAME *xn;
 	SSL *ret;
 	int i;
@@ -2804,20 +2921,14 @@ SSL_dup(SSL *s)
 		if (!SSL_copy_session_id(ret, s))
 			goto err;
 	} else {
-		/*
-		 * No session has been established yet, so we have to expect
-		 * that s->cert or ret->cert will be changed later --
-		 * they should not both point to the same object,
-		 * and thus we can't use SSL_copy_session_id.
-		 */
-
 		ret->method->ssl_free(ret);
 		ret->method = s->method;
 		ret->method->ssl_new(ret);
 
+		/* Shared until modified, see ssl_cert_own(). */
+		CRYPTO_add(&s->cert->references, 1, CRYPTO_LOCK_SSL_CERT);
 		ssl_cert_free(ret->cert);
-		if ((ret->cert = ssl_cert_dup(s->cert)) == NULL)
-			goto err;
+		ret->cert = s->cert;
 
 		if (!SSL_set_session_id_context(ret, s->sid_ctx,
 		    s->sid_ctx_length))
@@ -2876,7 +2987,12 @@ SSL_dup(SSL *s)
 
 	ret->hit = s->hit;
 
-	X509_VERIFY_PARAM_inherit(ret->param, s->param);
+	if (s->param != NULL) {
+		if ((param = ssl_param_own(ret)) == NULL)
+			goto err;
+		if (!X509_VERIFY_PARAM_inherit(param, s->param))
+			goto err;
+	}
 
 	if (s->cipher_list != NULL) {
 		if ((ret->cipher_list =
@@ -3108,17 +3224,14 @@ SSL_get_SSL_CTX(const SSL *ssl)
 SSL_CTX *
 SSL_set_SSL_CTX(SSL *ssl, SSL_CTX* ctx)
 {
-	SSL_CERT *new_cert;
-
 	if (ctx == NULL)
 		ctx = ssl->initial_ctx;
 	if (ssl->ctx == ctx)
 		return (ssl->ctx);
 
-	if ((new_cert = ssl_cert_dup(ctx->cert)) == NULL)
-		return NULL;
+	CRYPTO_add(&ctx->cert->references, 1, CRYPTO_LOCK_SSL_CERT);
 	ssl_cert_free(ssl->cert);
-	ssl->cert = new_cert;
+	ssl->cert = ctx->cert;
 
 	SSL_CTX_up_ref(ctx);
 	SSL_CTX_free(ssl->ctx); /* decrement reference count */
@@ -3423,7 +3536,11 @@ SSL_CTX_get_security_level(const SSL_CTX *ctx)
 void
 SSL_CTX_set_security_level(SSL_CTX *ctx, int level)
 {
-	ctx->cert->security_level = level;
+	SSL_CERT *cert;
+
+	if ((cert = ssl_get0_cert(ctx, NULL)) == NULL)
+		return;
+	cert->security_level = level;
 }
 
 int
@@ -3435,7 +3552,11 @@ SSL_get_security_level(const SSL *ssl)
 void
 SSL_set_security_level(SSL *ssl, int level)
 {
-	ssl->cert->security_level = level;
+	SSL_CERT *cert;
+
+	if ((cert = ssl_get0_cert(NULL, ssl)) == NULL)
+		return;
+	cert->security_level = level;
 }
 
 int
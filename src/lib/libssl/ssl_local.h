@@ -146,6 +146,8 @@
 #include <sys/types.h>
 
 #include <errno.h>
+#include <pthread.h>
+#include <stdatomic.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
@@ -371,12 +373,6 @@ typedef struct ssl_cert_st {
 
 	SSL_CERT_PKEY pkeys[SSL_PKEY_NUM];
 
-	/* The following masks are for the key and auth
-	 * algorithms that are supported by the certs below */
-	int valid;
-	unsigned long mask_k;
-	unsigned long mask_a;
-
 	DH *dhe_params;
 	DH *(*dhe_params_cb)(SSL *ssl, int is_export, int keysize);
 	int dhe_params_auto;
@@ -386,9 +382,22 @@ typedef struct ssl_cert_st {
 	int security_level;
 	void *security_ex_data; /* Not exposed in API. */
 
-	int references; /* >1 only if SSL_copy_session_id is used */
+	int references; /* >1 if shared, see ssl_cert_own() */
 } SSL_CERT;
 
+/*
+ * Verify parameters and supported groups of an SSL_CTX. An SSL shares those
+ * of its initial SSL_CTX until it sets its own.
+ */
+typedef struct ssl_ctx_params_st {
+	X509_VERIFY_PARAM *param;
+
+	size_t tlsext_supportedgroups_length;
+	uint16_t *tlsext_supportedgroups; /* our list */
+
+	int references; /* >1 if shared, see ssl_ctx_params_own() */
+} SSL_CTX_PARAMS;
+
 struct ssl_comp_st {
 	int id;
 	const char *name;
@@ -516,6 +525,9 @@ struct ssl_session_st {
 	 * efficient and to implement a maximum cache size. */
 	struct ssl_session_st *prev, *next;
 
+	/* Linkage within the session cache timer wheel. */
+	struct ssl_session_st *timer_next, **timer_prev;
+
 	/* Used to indicate that session resumption is not allowed.
 	 * Applications can also set this bit for a new session via
 	 * not_resumable_session_cb to disable session caching and tickets. */
@@ -716,6 +728,59 @@ typedef void (ssl_info_callback_fn)(const SSL *s, int type, int val);
 typedef void (ssl_msg_callback_fn)(int is_write, int version, int content_type,
     const void *buf, size_t len, SSL *ssl, void *arg);
 
+/*
+ * The internal session cache is split into a number of shards, selected by
+ * a hash of the session ID, each with its own lock, hash table and LRU list.
+ * This allows lookups and inserts for different sessions to proceed
+ * concurrently.
+ */
+#define SSL_SESSION_CACHE_SHARDS	16
+
+/* Maximum number of sessions expired by each pass over a shard's timers. */
+#define SSL_SESSION_CACHE_EXPIRE_BATCH	16
+
+/*
+ * Hierarchical timer wheel, keyed on session expiry time in seconds. Level n
+ * has SSL_SESSION_TIMER_SLOTS slots, each spanning SSL_SESSION_TIMER_SLOTS^n
+ * seconds. Sessions that expire beyond the span of the wheel are parked in
+ * the last level and rescheduled when their slot comes due.
+ */
+#define SSL_SESSION_TIMER_LEVELS	3
+#define SSL_SESSION_TIMER_BITS		6
+#define SSL_SESSION_TIMER_SLOTS		(1 << SSL_SESSION_TIMER_BITS)
+#define SSL_SESSION_TIMER_SPAN \
+	((time_t)1 << (SSL_SESSION_TIMER_LEVELS * SSL_SESSION_TIMER_BITS))
+
+struct ssl_session_timer_wheel {
+	time_t tick;		/* Next tick to be processed. */
+	size_t count;
+	struct ssl_session_st *slots[SSL_SESSION_TIMER_LEVELS]
+	    [SSL_SESSION_TIMER_SLOTS];
+};
+
+struct ssl_session_cache_shard {
+	pthread_mutex_t lock;
+	struct lhash_st_SSL_SESSION *sessions;
+	/* ctx->sessions, once this shard's sessions have been added to it. */
+	struct lhash_st_SSL_SESSION *all_sessions;
+	struct ssl_session_st *session_cache_head;
+	struct ssl_session_st *session_cache_tail;
+	struct ssl_session_timer_wheel timers;
+};
+
+/*
+ * Record buffers are allocated SSL_BUFFER_POOL_LEN bytes at a time, which
+ * fits a TLS or DTLS record of maximum size plus alignment, and recycled
+ * through a pool kept by the SSL_CTX. Write buffers for a maximum sized
+ * fragment, including the empty fragment, fit as well.
+ */
+#define SSL_BUFFER_POOL_LEN \
+	(SSL3_RT_MAX_PLAIN_LENGTH + SSL3_RT_MAX_ENCRYPTED_OVERHEAD + \
+	DTLS1_RT_HEADER_LENGTH + SSL3_ALIGN_PAYLOAD)
+#define SSL_BUFFER_POOL_SIZE_DEFAULT	64
+
+struct ssl_buffer_pool;
+
 struct ssl_ctx_st {
 	const SSL_METHOD *method;
 	const SSL_QUIC_METHOD *quic_method;
@@ -739,7 +804,7 @@ struct ssl_ctx_st {
 	size_t sid_ctx_length;
 	unsigned char sid_ctx[SSL_MAX_SID_CTX_LENGTH];
 
-	X509_VERIFY_PARAM *param;
+	SSL_CTX_PARAMS *params;
 
 	/*
 	 * XXX
@@ -817,13 +882,22 @@ struct ssl_ctx_st {
 	int (*tlsext_status_cb)(SSL *ssl, void *arg);
 	void *tlsext_status_arg;
 
+	struct ssl_session_cache_shard session_cache[SSL_SESSION_CACHE_SHARDS];
+
+	/*
+	 * Every cached session, maintained under CRYPTO_LOCK_SSL_CTX once
+	 * SSL_CTX_sessions() has been called.
+	 */
 	struct lhash_st_SSL_SESSION *sessions;
 
+	/* Free record buffers, see ssl_buffer_pool.c. */
+	struct ssl_buffer_pool *buffer_pool;
+
 	/* Most session-ids that will be cached, default is
-	 * SSL_SESSION_CACHE_MAX_SIZE_DEFAULT. 0 is unlimited. */
+	 * SSL_SESSION_CACHE_MAX_SIZE_DEFAULT. 0 is unlimited.
+	 * Enforced per shard, as session_cache_size / SSL_SESSION_CACHE_SHARDS
+	 * (rounded up). */
 	unsigned long session_cache_size;
-	struct ssl_session_st *session_cache_head;
-	struct ssl_session_st *session_cache_tail;
 
 	/* This can have one of 2 values, ored together,
 	 * SSL_SESS_CACHE_CLIENT,
@@ -832,6 +906,10 @@ struct ssl_ctx_st {
 	 * SSL_accept which cache SSL_SESSIONS. */
 	int session_cache_mode;
 
+	/*
+	 * The session cache counters are updated without a lock or under
+	 * the lock of one shard, so they are atomic.
+	 */
 	struct {
 		int sess_connect;	/* SSL new conn - started */
 		int sess_connect_renegotiate;/* SSL reneg - requested */
@@ -839,16 +917,23 @@ struct ssl_ctx_st {
 		int sess_accept;	/* SSL new accept - started */
 		int sess_accept_renegotiate;/* SSL reneg - requested */
 		int sess_accept_good;	/* SSL accept/reneg - finished */
-		int sess_miss;		/* session lookup misses  */
-		int sess_timeout;	/* reuse attempt on timeouted session */
-		int sess_cache_full;	/* session removed due to full cache */
-		int sess_hit;		/* session reuse actually done */
-		int sess_cb_hit;	/* session-id that was not
+		atomic_int sess_miss;	/* session lookup misses  */
+		atomic_int sess_timeout;/* reuse attempt on timeouted session */
+		atomic_int sess_cache_full;/* session removed due to full
+					 * cache */
+		atomic_int sess_hit;	/* session reuse actually done */
+		atomic_int sess_cb_hit;	/* session-id that was not
 					 * in the cache was
 					 * passed back via the callback.  This
 					 * indicates that the application is
 					 * supplying session-id's from other
 					 * processes - spooky :-) */
+		atomic_int sess_expired;/* sessions removed by the timer
+					 * wheel */
+		atomic_int sess_expire_rescheduled;/* timers moved on by a
+					 * changed session time or timeout */
+		atomic_int sess_expire_deferred;/* expiry passes cut short by
+					 * the batch limit */
 	} stats;
 
 	CRYPTO_EX_DATA ex_data;
@@ -913,8 +998,6 @@ struct ssl_ctx_st {
 
 	size_t tlsext_ecpointformatlist_length;
 	uint8_t *tlsext_ecpointformatlist; /* our list */
-	size_t tlsext_supportedgroups_length;
-	uint16_t *tlsext_supportedgroups; /* our list */
 	SSL_CTX_keylog_cb_func keylog_callback; /* Unused. For OpenSSL compatibility. */
 	size_t num_tickets; /* Unused, for OpenSSL compatibility */
 };
@@ -942,6 +1025,7 @@ struct ssl_st {
 	struct dtls1_state_st *d1; /* DTLSv1 variables */
 
 	X509_VERIFY_PARAM *param;
+	SSL_CTX_PARAMS *ctx_params; /* of the initial SSL_CTX, at SSL_new() */
 
 	/* crypto */
 	STACK_OF(SSL_CIPHER) *cipher_list;
@@ -1289,7 +1373,12 @@ void ssl_msg_callback_cbs(SSL *s, int is_write, int content_type, CBS *cbs);
 SSL_CERT *ssl_cert_new(void);
 SSL_CERT *ssl_cert_dup(SSL_CERT *cert);
 void ssl_cert_free(SSL_CERT *c);
+int ssl_cert_own(SSL_CERT **pcert);
 SSL_CERT *ssl_get0_cert(SSL_CTX *ctx, SSL *ssl);
+SSL_CTX_PARAMS *ssl_ctx_params_new(void);
+void ssl_ctx_params_free(SSL_CTX_PARAMS *params);
+int ssl_ctx_params_own(SSL_CTX *ctx);
+X509_VERIFY_PARAM *ssl_get0_param(const SSL *s);
 int ssl_cert_set0_chain(SSL_CTX *ctx, SSL *ssl, STACK_OF(X509) *chain);
 int ssl_cert_set1_chain(SSL_CTX *ctx, SSL *ssl, STACK_OF(X509) *chain);
 int ssl_cert_add0_chain_cert(SSL_CTX *ctx, SSL *ssl, X509 *cert);
@@ -1313,7 +1402,19 @@ int ssl_security_cert_chain(const SSL *ssl, STACK_OF(X509) *sk,
 int ssl_security_shared_group(const SSL *ssl, uint16_t group_id);
 int ssl_security_supported_group(const SSL *ssl, uint16_t group_id);
 
+struct ssl_buffer_pool *ssl_buffer_pool_new(void);
+void ssl_buffer_pool_free(struct ssl_buffer_pool *pool);
+uint8_t *ssl_buffer_pool_get(struct ssl_buffer_pool *pool);
+void ssl_buffer_pool_put(struct ssl_buffer_pool *pool, uint8_t *buf);
+long ssl_buffer_pool_ctrl(struct ssl_buffer_pool *pool, int cmd, long larg);
+
 SSL_SESSION *ssl_session_dup(SSL_SESSION *src, int include_ticket);
+int ssl_session_cache_init(SSL_CTX *ctx);
+void ssl_session_cache_free(SSL_CTX *ctx);
+int ssl_session_cache_has_session(SSL_CTX *ctx, const SSL_SESSION *key);
+unsigned long ssl_session_cache_num_items(SSL_CTX *ctx);
+struct lhash_st_SSL_SESSION *ssl_session_cache_sessions(SSL_CTX *ctx);
+void ssl_session_cache_expire(SSL_CTX *ctx, time_t now);
 int ssl_get_new_session(SSL *s, int session);
 int ssl_get_prev_session(SSL *s, CBS *session_id, CBS *ext_block,
     int *alert);
@@ -1324,7 +1425,7 @@ int ssl_cipher_list_to_bytes(SSL *s, STACK_OF(SSL_CIPHER) *ciphers, CBB *cbb);
 STACK_OF(SSL_CIPHER) *ssl_bytes_to_cipher_list(SSL *s, CBS *cbs);
 STACK_OF(SSL_CIPHER) *ssl_create_cipher_list(const SSL_METHOD *meth,
     STACK_OF(SSL_CIPHER) **pref, STACK_OF(SSL_CIPHER) *tls13,
-    const char *rule_str, SSL_CERT *cert);
+    const char *rule_str, SSL_CERT **pcert);
 int ssl_parse_ciphersuites(STACK_OF(SSL_CIPHER) **out_ciphers, const char *str);
 int ssl_merge_cipherlists(STACK_OF(SSL_CIPHER) *cipherlist,
     STACK_OF(SSL_CIPHER) *cipherlist_tls13,
@@ -1344,7 +1445,8 @@ EVP_PKEY *ssl_get_sign_pkey(SSL *s, const SSL_CIPHER *c, const EVP_MD **pmd,
     const struct ssl_sigalg **sap);
 size_t ssl_dhe_params_auto_key_bits(SSL *s);
 int ssl_cert_type(EVP_PKEY *pkey);
-void ssl_set_cert_masks(SSL_CERT *c, const SSL_CIPHER *cipher);
+void ssl_get_cert_masks(const SSL_CERT *c, unsigned long *out_mask_k,
+    unsigned long *out_mask_a);
 STACK_OF(SSL_CIPHER) *ssl_get_ciphers_by_id(SSL *s);
 int ssl_has_ecc_ciphers(SSL *s);
 int ssl_verify_alarm_type(long type);
@@ -1380,7 +1482,7 @@ int	ssl3_setup_init_buffer(SSL *s);
 void ssl3_release_init_buffer(SSL *s);
 int	ssl3_setup_read_buffer(SSL *s);
 int	ssl3_setup_write_buffer(SSL *s);
-void ssl3_release_buffer(SSL3_BUFFER_INTERNAL *b);
+void ssl3_release_buffer(SSL *s, SSL3_BUFFER_INTERNAL *b);
 void ssl3_release_read_buffer(SSL *s);
 void ssl3_release_write_buffer(SSL *s);
 int	ssl3_new(SSL *s);
@@ -216,7 +216,6 @@ ssl_set_pkey(SSL_CTX *ctx, SSL *ssl, EVP_PKEY *pkey)
 	c->pkeys[i].privatekey = pkey;
 	c->key = &(c->pkeys[i]);
 
-	c->valid = 0;
 	return 1;
 }
 
@@ -430,7 +429,6 @@ ssl_set_cert(SSL_CTX *ctx, SSL *ssl, X509 *x)
 	c->pkeys[i].x509 = x;
 	c->key = &(c->pkeys[i]);
 
-	c->valid = 0;
 	return (1);
 }
 
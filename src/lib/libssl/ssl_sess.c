@@ -144,8 +144,10 @@
 
 #include "ssl_local.h"
 
-static void SSL_SESSION_list_remove(SSL_CTX *ctx, SSL_SESSION *s);
-static void SSL_SESSION_list_add(SSL_CTX *ctx, SSL_SESSION *s);
+static void SSL_SESSION_list_remove(struct ssl_session_cache_shard *shard,
+    SSL_SESSION *s);
+static void SSL_SESSION_list_add(struct ssl_session_cache_shard *shard,
+    SSL_SESSION *s);
 static int remove_session_lock(SSL_CTX *ctx, SSL_SESSION *c, int lck);
 
 /* aka SSL_get0_session; gets 0 objects, just returns a copy of the pointer */
@@ -164,12 +166,13 @@ SSL_get1_session(SSL *ssl)
 	/*
 	 * Need to lock this all up rather than just use CRYPTO_add so that
 	 * somebody doesn't free ssl->session between when we check it's
-	 * non-null and when we up the reference count.
+	 * non-null and when we up the reference count. The count itself is
+	 * atomic and is not protected by the lock.
 	 */
 	CRYPTO_w_lock(CRYPTO_LOCK_SSL_SESSION);
 	sess = ssl->session;
 	if (sess)
-		sess->references++;
+		CRYPTO_add(&sess->references, 1, CRYPTO_LOCK_SSL_SESSION);
 	CRYPTO_w_unlock(CRYPTO_LOCK_SSL_SESSION);
 
 	return (sess);
@@ -529,9 +532,274 @@ ssl_get_new_session(SSL *s, int session)
 	return (1);
 }
 
+static unsigned long
+ssl_session_hash(const SSL_SESSION *a)
+{
+	unsigned long	l;
+
+	l = (unsigned long)
+	    ((unsigned int) a->session_id[0]     )|
+	    ((unsigned int) a->session_id[1]<< 8L)|
+	    ((unsigned long)a->session_id[2]<<16L)|
+	    ((unsigned long)a->session_id[3]<<24L);
+	return (l);
+}
+
+/*
+ * NB: If this function (or indeed the hash function which uses a sort of
+ * coarser function than this one) is changed, ensure
+ * SSL_CTX_has_matching_session_id() is checked accordingly. It relies on being
+ * able to construct an SSL_SESSION that will collide with any existing session
+ * with a matching session ID.
+ */
+static int
+ssl_session_cmp(const SSL_SESSION *a, const SSL_SESSION *b)
+{
+	if (a->ssl_version != b->ssl_version)
+		return (1);
+	if (a->session_id_length != b->session_id_length)
+		return (1);
+	if (timingsafe_memcmp(a->session_id, b->session_id, a->session_id_length) != 0)
+		return (1);
+	return (0);
+}
+
+/*
+ * These wrapper functions should remain rather than redeclaring
+ * SSL_SESSION_hash and SSL_SESSION_cmp for void* types and casting each
+ * variable. The reason is that the functions aren't static, they're exposed via
+ * ssl.h.
+ */
+static unsigned long
+ssl_session_LHASH_HASH(const void *arg)
+{
+	const SSL_SESSION *a = arg;
+
+	return ssl_session_hash(a);
+}
+
+static int
+ssl_session_LHASH_COMP(const void *arg1, const void *arg2)
+{
+	const SSL_SESSION *a = arg1;
+	const SSL_SESSION *b = arg2;
+
+	return ssl_session_cmp(a, b);
+}
+
+static struct ssl_session_cache_shard *
+ssl_session_cache_shard(SSL_CTX *ctx, const SSL_SESSION *s)
+{
+	uint32_t h = 2166136261U;
+	unsigned int i;
+
+	/*
+	 * The hash table within each shard uses the leading bytes of the
+	 * session ID, so hash the entire ID (FNV-1a) to pick the shard.
+	 */
+	for (i = 0; i < s->session_id_length; i++)
+		h = (h ^ s->session_id[i]) * 16777619U;
+
+	return &ctx->session_cache[h % SSL_SESSION_CACHE_SHARDS];
+}
+
+int
+ssl_session_cache_init(SSL_CTX *ctx)
+{
+	struct ssl_session_cache_shard *shard;
+	size_t i;
+
+	/* A shard with a hash table has an initialised lock. */
+	for (i = 0; i < SSL_SESSION_CACHE_SHARDS; i++) {
+		shard = &ctx->session_cache[i];
+		if ((shard->sessions = lh_SSL_SESSION_new()) == NULL)
+			return 0;
+		if (pthread_mutex_init(&shard->lock, NULL) != 0) {
+			lh_SSL_SESSION_free(shard->sessions);
+			shard->sessions = NULL;
+			return 0;
+		}
+		shard->all_sessions = NULL;
+		shard->session_cache_head = NULL;
+		shard->session_cache_tail = NULL;
+		memset(&shard->timers, 0, sizeof(shard->timers));
+	}
+
+	return 1;
+}
+
+void
+ssl_session_cache_free(SSL_CTX *ctx)
+{
+	struct ssl_session_cache_shard *shard;
+	size_t i;
+
+	for (i = 0; i < SSL_SESSION_CACHE_SHARDS; i++) {
+		shard = &ctx->session_cache[i];
+		if (shard->sessions == NULL)
+			continue;
+		lh_SSL_SESSION_free(shard->sessions);
+		shard->sessions = NULL;
+		shard->all_sessions = NULL;
+		(void) pthread_mutex_destroy(&shard->lock);
+	}
+
+	lh_SSL_SESSION_free(ctx->sessions);
+	ctx->sessions = NULL;
+}
+
+int
+ssl_session_cache_has_session(SSL_CTX *ctx, const SSL_SESSION *key)
+{
+	struct ssl_session_cache_shard *shard;
+	SSL_SESSION *sess;
+
+	shard = ssl_session_cache_shard(ctx, key);
+	if (shard->sessions == NULL)
+		return 0;
+
+	(void) pthread_mutex_lock(&shard->lock);
+	sess = lh_SSL_SESSION_retrieve(shard->sessions, key);
+	(void) pthread_mutex_unlock(&shard->lock);
+
+	return sess != NULL;
+}
+
+unsigned long
+ssl_session_cache_num_items(SSL_CTX *ctx)
+{
+	struct ssl_session_cache_shard *shard;
+	unsigned long n = 0;
+	size_t i;
+
+	for (i = 0; i < SSL_SESSION_CACHE_SHARDS; i++) {
+		shard = &ctx->session_cache[i];
+		if (shard->sessions == NULL)
+			continue;
+		(void) pthread_mutex_lock(&shard->lock);
+		n += lh_SSL_SESSION_num_items(shard->sessions);
+		(void) pthread_mutex_unlock(&shard->lock);
+	}
+
+	return n;
+}
+
+/*
+ * Add the sessions of a shard to ctx->sessions. On failure, the sessions
+ * that were added are removed again since they would not be kept up to date.
+ * Called with the shard lock and CRYPTO_LOCK_SSL_CTX held.
+ */
+static int
+ssl_session_cache_all_add_shard(struct ssl_session_cache_shard *shard,
+    struct lhash_st_SSL_SESSION *sessions)
+{
+	SSL_SESSION *end = (SSL_SESSION *)&shard->session_cache_tail;
+	SSL_SESSION *s;
+
+	for (s = shard->session_cache_head; s != NULL && s != end;
+	    s = s->next) {
+		(void)lh_SSL_SESSION_insert(sessions, s);
+		if (lh_SSL_SESSION_error(sessions))
+			goto err;
+	}
+
+	shard->all_sessions = sessions;
+
+	return 1;
+
+ err:
+	for (s = shard->session_cache_head; s != NULL && s != end;
+	    s = s->next)
+		(void)lh_SSL_SESSION_delete(sessions, s);
+
+	return 0;
+}
+
+/*
+ * Return a hash table with every cached session for SSL_CTX_sessions(). It
+ * is only built on first use, after which the shards keep it up to date
+ * under CRYPTO_LOCK_SSL_CTX, so that a context that never calls
+ * SSL_CTX_sessions() does not serialise on that lock.
+ */
+struct lhash_st_SSL_SESSION *
+ssl_session_cache_sessions(SSL_CTX *ctx)
+{
+	struct ssl_session_cache_shard *shard;
+	struct lhash_st_SSL_SESSION *sessions;
+	size_t i;
+	int failed = 0;
+
+	CRYPTO_w_lock(CRYPTO_LOCK_SSL_CTX);
+	if (ctx->sessions == NULL)
+		ctx->sessions = lh_SSL_SESSION_new();
+	sessions = ctx->sessions;
+	CRYPTO_w_unlock(CRYPTO_LOCK_SSL_CTX);
+
+	if (sessions == NULL)
+		return NULL;
+
+	/* A shard that cannot be added is retried by the next call. */
+	for (i = 0; i < SSL_SESSION_CACHE_SHARDS; i++) {
+		shard = &ctx->session_cache[i];
+		if (shard->sessions == NULL)
+			continue;
+		(void) pthread_mutex_lock(&shard->lock);
+		if (shard->all_sessions == NULL) {
+			CRYPTO_w_lock(CRYPTO_LOCK_SSL_CTX);
+			if (!ssl_session_cache_all_add_shard(shard, sessions))
+				failed = 1;
+			CRYPTO_w_unlock(CRYPTO_LOCK_SSL_CTX);
+		}
+		(void) pthread_mutex_unlock(&shard->lock);
+	}
+
+	if (failed)
+		return NULL;
+
+	return sessions;
+}
+
+/*
+ * Add a session to ctx->sessions, if the shard is kept there. Called with
+ * the shard lock held.
+ */
+static int
+ssl_session_cache_all_insert(struct ssl_session_cache_shard *shard,
+    SSL_SESSION *s)
+{
+	int ret = 1;
+
+	if (shard->all_sessions == NULL)
+		return 1;
+
+	CRYPTO_w_lock(CRYPTO_LOCK_SSL_CTX);
+	(void)lh_SSL_SESSION_insert(shard->all_sessions, s);
+	if (lh_SSL_SESSION_error(shard->all_sessions))
+		ret = 0;
+	CRYPTO_w_unlock(CRYPTO_LOCK_SSL_CTX);
+
+	return ret;
+}
+
+/* Remove a session from the hash tables of a shard. */
+static void
+ssl_session_cache_delete(struct ssl_session_cache_shard *shard,
+    SSL_SESSION *s)
+{
+	(void)lh_SSL_SESSION_delete(shard->sessions, s);
+
+	if (shard->all_sessions == NULL)
+		return;
+
+	CRYPTO_w_lock(CRYPTO_LOCK_SSL_CTX);
+	(void)lh_SSL_SESSION_delete(shard->all_sessions, s);
+	CRYPTO_w_unlock(CRYPTO_LOCK_SSL_CTX);
+}
+
 static SSL_SESSION *
 ssl_session_from_cache(SSL *s, CBS *session_id)
 {
+	struct ssl_session_cache_shard *shard;
 	SSL_SESSION *sess;
 	SSL_SESSION data;
 
@@ -547,14 +815,17 @@ ssl_session_from_cache(SSL *s, CBS *session_id)
 	    sizeof(data.session_id), &data.session_id_length))
 		return NULL;
 
-	CRYPTO_r_lock(CRYPTO_LOCK_SSL_CTX);
-	sess = lh_SSL_SESSION_retrieve(s->session_ctx->sessions, &data);
+	shard = ssl_session_cache_shard(s->session_ctx, &data);
+
+	(void) pthread_mutex_lock(&shard->lock);
+	sess = lh_SSL_SESSION_retrieve(shard->sessions, &data);
 	if (sess != NULL)
 		CRYPTO_add(&sess->references, 1, CRYPTO_LOCK_SSL_SESSION);
-	CRYPTO_r_unlock(CRYPTO_LOCK_SSL_CTX);
+	(void) pthread_mutex_unlock(&shard->lock);
 
 	if (sess == NULL)
-		s->session_ctx->stats.sess_miss++;
+		atomic_fetch_add_explicit(&s->session_ctx->stats.sess_miss, 1,
+		    memory_order_relaxed);
 
 	return sess;
 }
@@ -581,7 +852,8 @@ ssl_session_from_callback(SSL *s, CBS *session_id)
 	if (copy)
 		CRYPTO_add(&sess->references, 1, CRYPTO_LOCK_SSL_SESSION);
 
-	s->session_ctx->stats.sess_cb_hit++;
+	atomic_fetch_add_explicit(&s->session_ctx->stats.sess_cb_hit, 1,
+	    memory_order_relaxed);
 
 	/* Add the externally cached session to the internal cache as well. */
 	if (!(s->session_ctx->session_cache_mode &
@@ -710,7 +982,9 @@ ssl_get_prev_session(SSL *s, CBS *session_id, CBS *ext_block, int *alert)
 	}
 
 	if (sess->timeout < (time(NULL) - sess->time)) {
-		s->session_ctx->stats.sess_timeout++;
+		atomic_fetch_add_explicit(
+		    &s->session_ctx->stats.sess_timeout, 1,
+		    memory_order_relaxed);
 		if (!ticket_decrypted) {
 			/* The session was from the cache, so remove it. */
 			SSL_CTX_remove_session(s->session_ctx, sess);
@@ -718,7 +992,8 @@ ssl_get_prev_session(SSL *s, CBS *session_id, CBS *ext_block, int *alert)
 		goto err;
 	}
 
-	s->session_ctx->stats.sess_hit++;
+	atomic_fetch_add_explicit(&s->session_ctx->stats.sess_hit, 1,
+	    memory_order_relaxed);
 
 	SSL_SESSION_free(s->session);
 	s->session = sess;
@@ -742,9 +1017,263 @@ ssl_get_prev_session(SSL *s, CBS *session_id, CBS *ext_block, int *alert)
 	return 0;
 }
 
+static void
+ssl_session_timer_insert(struct ssl_session_timer_wheel *tw, SSL_SESSION *s)
+{
+	time_t expiry, delta, span;
+	int level, slot;
+
+	/* A session expires once the time is past s->time + s->timeout. */
+	expiry = s->time + s->timeout + 1;
+	if (expiry < tw->tick)
+		expiry = tw->tick;
+
+	delta = expiry - tw->tick;
+	for (level = 0; level < SSL_SESSION_TIMER_LEVELS - 1; level++) {
+		span = (time_t)1 << ((level + 1) * SSL_SESSION_TIMER_BITS);
+		if (delta < span)
+			break;
+	}
+
+	/* Park distant expiries in the last slot the wheel can reach. */
+	if (delta >= SSL_SESSION_TIMER_SPAN)
+		expiry = tw->tick + SSL_SESSION_TIMER_SPAN - 1;
+
+	slot = (expiry >> (level * SSL_SESSION_TIMER_BITS)) &
+	    (SSL_SESSION_TIMER_SLOTS - 1);
+
+	if ((s->timer_next = tw->slots[level][slot]) != NULL)
+		s->timer_next->timer_prev = &s->timer_next;
+	s->timer_prev = &tw->slots[level][slot];
+	tw->slots[level][slot] = s;
+	tw->count++;
+}
+
+static void
+ssl_session_timer_remove(struct ssl_session_timer_wheel *tw, SSL_SESSION *s)
+{
+	if (s->timer_prev == NULL)
+		return;
+
+	if (s->timer_next != NULL)
+		s->timer_next->timer_prev = s->timer_prev;
+	*s->timer_prev = s->timer_next;
+	s->timer_next = NULL;
+	s->timer_prev = NULL;
+	tw->count--;
+}
+
+/*
+ * Move the sessions in the current slot of the given level down the wheel,
+ * returning the index of that slot.
+ */
+static int
+ssl_session_timer_cascade(struct ssl_session_timer_wheel *tw, int level)
+{
+	SSL_SESSION *s;
+	int slot;
+
+	slot = (tw->tick >> (level * SSL_SESSION_TIMER_BITS)) &
+	    (SSL_SESSION_TIMER_SLOTS - 1);
+
+	while ((s = tw->slots[level][slot]) != NULL) {
+		ssl_session_timer_remove(tw, s);
+		ssl_session_timer_insert(tw, s);
+	}
+
+	return slot;
+}
+
+/*
+ * Reinsert every session relative to a new current tick. Used when the wheel
+ * falls more than a full span behind, at which point every slot is due.
+ */
+static void
+ssl_session_timer_reset(struct ssl_session_timer_wheel *tw, time_t tick)
+{
+	SSL_SESSION *s, *due = NULL;
+	int level, slot;
+
+	for (level = 0; level < SSL_SESSION_TIMER_LEVELS; level++) {
+		for (slot = 0; slot < SSL_SESSION_TIMER_SLOTS; slot++) {
+			while ((s = tw->slots[level][slot]) != NULL) {
+				ssl_session_timer_remove(tw, s);
+				s->timer_next = due;
+				due = s;
+			}
+		}
+	}
+
+	tw->tick = tick;
+
+	while ((s = due) != NULL) {
+		due = s->timer_next;
+		ssl_session_timer_insert(tw, s);
+	}
+}
+
+/*
+ * Return the next tick, no later than the given time, at which a level zero
+ * slot holds sessions or the level above needs to be cascaded.
+ */
+static time_t
+ssl_session_timer_next(struct ssl_session_timer_wheel *tw, time_t now)
+{
+	time_t tick;
+	int slot;
+
+	slot = tw->tick & (SSL_SESSION_TIMER_SLOTS - 1);
+	for (tick = tw->tick + 1, slot++; slot < SSL_SESSION_TIMER_SLOTS;
+	    tick++, slot++) {
+		if (tick > now || tw->slots[0][slot] != NULL)
+			break;
+	}
+	if (tick > now)
+		tick = now + 1;
+
+	return tick;
+}
+
+/*
+ * Remove a session from the LRU list and timer wheel of a shard. The caller
+ * removes it from the hash table. Called with the shard lock held.
+ */
+static void
+ssl_session_cache_unlink(struct ssl_session_cache_shard *shard, SSL_SESSION *s)
+{
+	SSL_SESSION_list_remove(shard, s);
+	ssl_session_timer_remove(&shard->timers, s);
+}
+
+static void
+ssl_session_cache_release(SSL_CTX *ctx, SSL_SESSION *s)
+{
+	s->not_resumable = 1;
+	if (ctx->remove_session_cb != NULL)
+		ctx->remove_session_cb(ctx, s);
+	SSL_SESSION_free(s);
+}
+
+/*
+ * Advance the timer wheel of a shard up to the given time, expiring at most
+ * SSL_SESSION_CACHE_EXPIRE_BATCH sessions. Anything left over is picked up
+ * by a later pass. Empty slots are skipped, and a wheel that is more than a
+ * full span behind is rebuilt, so that the work does not depend on how much
+ * time has passed. Called with the shard lock held.
+ */
+static void
+ssl_session_timer_advance(SSL_CTX *ctx, struct ssl_session_cache_shard *shard,
+    time_t now)
+{
+	struct ssl_session_timer_wheel *tw = &shard->timers;
+	SSL_SESSION *s;
+	size_t expired = 0;
+	int level, slot;
+
+	/* Nothing is scheduled, so there is no need to walk the wheel. */
+	if (tw->count == 0) {
+		if (tw->tick <= now)
+			tw->tick = now + 1;
+		return;
+	}
+
+	/*
+	 * After a long idle period or a forward clock step, every session
+	 * on the wheel is due. Reinsert them rather than visiting each
+	 * elapsed second.
+	 */
+	if (tw->tick <= now && now - tw->tick >= SSL_SESSION_TIMER_SPAN)
+		ssl_session_timer_reset(tw, now);
+
+	while (tw->tick <= now) {
+		slot = tw->tick & (SSL_SESSION_TIMER_SLOTS - 1);
+
+		/*
+		 * On entering a new slot at level zero, cascade the level
+		 * above - this in turn cascades further when it wraps.
+		 */
+		if (slot == 0) {
+			for (level = 1; level < SSL_SESSION_TIMER_LEVELS;
+			    level++) {
+				if (ssl_session_timer_cascade(tw, level) != 0)
+					break;
+			}
+		}
+
+		while ((s = tw->slots[0][slot]) != NULL) {
+			if (expired >= SSL_SESSION_CACHE_EXPIRE_BATCH) {
+				atomic_fetch_add_explicit(
+				    &ctx->stats.sess_expire_deferred, 1,
+				    memory_order_relaxed);
+				return;
+			}
+
+			/*
+			 * The session time or timeout may have changed, or the
+			 * expiry was beyond the span of the wheel.
+			 */
+			if (s->time + s->timeout >= tw->tick) {
+				ssl_session_timer_remove(tw, s);
+				ssl_session_timer_insert(tw, s);
+				atomic_fetch_add_explicit(
+				    &ctx->stats.sess_expire_rescheduled, 1,
+				    memory_order_relaxed);
+				continue;
+			}
+
+			ssl_session_cache_delete(shard, s);
+			ssl_session_cache_unlink(shard, s);
+			ssl_session_cache_release(ctx, s);
+			atomic_fetch_add_explicit(&ctx->stats.sess_expired, 1,
+			    memory_order_relaxed);
+			expired++;
+		}
+
+		tw->tick = ssl_session_timer_next(tw, now);
+	}
+}
+
+/*
+ * Remove all sessions from a shard that have expired at the given time, or
+ * every session if the time is zero. Called with the shard lock held.
+ */
+static void
+ssl_session_cache_flush(SSL_CTX *ctx, struct ssl_session_cache_shard *shard,
+    time_t now)
+{
+	SSL_SESSION *s, *prev;
+
+	for (s = shard->session_cache_tail; s != NULL; s = prev) {
+		prev = s->prev;
+		if (prev == (SSL_SESSION *)&shard->session_cache_head)
+			prev = NULL;
+
+		if (now != 0 && now <= s->time + s->timeout)
+			continue;
+
+		ssl_session_cache_delete(shard, s);
+		ssl_session_cache_unlink(shard, s);
+		ssl_session_cache_release(ctx, s);
+	}
+}
+
+/* Per shard share of the cache size limit, zero if unlimited. */
+static unsigned long
+ssl_session_cache_shard_size(SSL_CTX *ctx)
+{
+	unsigned long size;
+
+	if ((size = SSL_CTX_sess_get_cache_size(ctx)) == 0)
+		return 0;
+
+	return (size + SSL_SESSION_CACHE_SHARDS - 1) / SSL_SESSION_CACHE_SHARDS;
+}
+
 int
 SSL_CTX_add_session(SSL_CTX *ctx, SSL_SESSION *c)
 {
+	struct ssl_session_cache_shard *shard;
+	unsigned long shard_size;
 	int ret = 0;
 	SSL_SESSION *s;
 
@@ -759,17 +1288,23 @@ SSL_CTX_add_session(SSL_CTX *ctx, SSL_SESSION *c)
 	 * If session c is in already in cache, we take back the increment
 	 * later.
 	 */
-	CRYPTO_w_lock(CRYPTO_LOCK_SSL_CTX);
-	s = lh_SSL_SESSION_insert(ctx->sessions, c);
+	shard = ssl_session_cache_shard(ctx, c);
+
+	(void) pthread_mutex_lock(&shard->lock);
+
+	/* Expire stale sessions before the shard grows any further. */
+	ssl_session_timer_advance(ctx, shard, time(NULL));
+
+	s = lh_SSL_SESSION_insert(shard->sessions, c);
 
 	/*
 	 * s != NULL iff we already had a session with the given PID.
 	 * In this case, s == c should hold (then we did not really modify
-	 * ctx->sessions), or we're in trouble.
+	 * shard->sessions), or we're in trouble.
 	 */
 	if (s != NULL && s != c) {
 		/* We *are* in trouble ... */
-		SSL_SESSION_list_remove(ctx, s);
+		ssl_session_cache_unlink(shard, s);
 		SSL_SESSION_free(s);
 		/*
 		 * ... so pretend the other session did not exist in cache
@@ -781,9 +1316,22 @@ SSL_CTX_add_session(SSL_CTX *ctx, SSL_SESSION *c)
 		s = NULL;
 	}
 
+	/*
+	 * Keep ctx->sessions in step with the shard. This also replaces a
+	 * session that was dropped above.
+	 */
+	if (s == NULL && !ssl_session_cache_all_insert(shard, c)) {
+		(void)lh_SSL_SESSION_delete(shard->sessions, c);
+		(void) pthread_mutex_unlock(&shard->lock);
+		SSL_SESSION_free(c);
+		return 0;
+	}
+
 	/* Put at the head of the queue unless it is already in the cache */
-	if (s == NULL)
-		SSL_SESSION_list_add(ctx, c);
+	if (s == NULL) {
+		SSL_SESSION_list_add(shard, c);
+		ssl_session_timer_insert(&shard->timers, c);
+	}
 
 	if (s != NULL) {
 		/*
@@ -801,18 +1349,20 @@ SSL_CTX_add_session(SSL_CTX *ctx, SSL_SESSION *c)
 
 		ret = 1;
 
-		if (SSL_CTX_sess_get_cache_size(ctx) > 0) {
-			while (SSL_CTX_sess_number(ctx) >
-			    SSL_CTX_sess_get_cache_size(ctx)) {
+		if ((shard_size = ssl_session_cache_shard_size(ctx)) > 0) {
+			while (lh_SSL_SESSION_num_items(shard->sessions) >
+			    shard_size) {
 				if (!remove_session_lock(ctx,
-				    ctx->session_cache_tail, 0))
+				    shard->session_cache_tail, 0))
 					break;
 				else
-					ctx->stats.sess_cache_full++;
+					atomic_fetch_add_explicit(
+					    &ctx->stats.sess_cache_full, 1,
+					    memory_order_relaxed);
 			}
 		}
 	}
-	CRYPTO_w_unlock(CRYPTO_LOCK_SSL_CTX);
+	(void) pthread_mutex_unlock(&shard->lock);
 	return (ret);
 }
 
@@ -825,28 +1375,27 @@ SSL_CTX_remove_session(SSL_CTX *ctx, SSL_SESSION *c)
 static int
 remove_session_lock(SSL_CTX *ctx, SSL_SESSION *c, int lck)
 {
+	struct ssl_session_cache_shard *shard;
 	SSL_SESSION *r;
 	int ret = 0;
 
 	if (c == NULL || c->session_id_length == 0)
 		return 0;
 
+	shard = ssl_session_cache_shard(ctx, c);
+
 	if (lck)
-		CRYPTO_w_lock(CRYPTO_LOCK_SSL_CTX);
-	if ((r = lh_SSL_SESSION_retrieve(ctx->sessions, c)) == c) {
+		(void) pthread_mutex_lock(&shard->lock);
+	if ((r = lh_SSL_SESSION_retrieve(shard->sessions, c)) == c) {
 		ret = 1;
-		r = lh_SSL_SESSION_delete(ctx->sessions, c);
-		SSL_SESSION_list_remove(ctx, c);
+		ssl_session_cache_delete(shard, c);
+		ssl_session_cache_unlink(shard, c);
 	}
 	if (lck)
-		CRYPTO_w_unlock(CRYPTO_LOCK_SSL_CTX);
+		(void) pthread_mutex_unlock(&shard->lock);
 
-	if (ret) {
-		r->not_resumable = 1;
-		if (ctx->remove_session_cb != NULL)
-			ctx->remove_session_cb(ctx, r);
-		SSL_SESSION_free(r);
-	}
+	if (ret)
+		ssl_session_cache_release(ctx, r);
 
 	return ret;
 }
@@ -1094,56 +1643,42 @@ SSL_set_session_ticket_ext(SSL *s, void *ext_data, int ext_len)
 	return 0;
 }
 
-typedef struct timeout_param_st {
-	SSL_CTX *ctx;
-	long time;
-	struct lhash_st_SSL_SESSION *cache;
-} TIMEOUT_PARAM;
-
-static void
-timeout_doall_arg(SSL_SESSION *s, TIMEOUT_PARAM *p)
-{
-	if ((p->time == 0) || (p->time > (s->time + s->timeout))) {
-		/* timeout */
-		/* The reason we don't call SSL_CTX_remove_session() is to
-		 * save on locking overhead */
-		(void)lh_SSL_SESSION_delete(p->cache, s);
-		SSL_SESSION_list_remove(p->ctx, s);
-		s->not_resumable = 1;
-		if (p->ctx->remove_session_cb != NULL)
-			p->ctx->remove_session_cb(p->ctx, s);
-		SSL_SESSION_free(s);
-	}
-}
-
-static void
-timeout_LHASH_DOALL_ARG(void *arg1, void *arg2)
-{
-	SSL_SESSION *a = arg1;
-	TIMEOUT_PARAM *b = arg2;
-
-	timeout_doall_arg(a, b);
-}
-
 /* XXX 2038 */
 void
 SSL_CTX_flush_sessions(SSL_CTX *s, long t)
 {
-	unsigned long i;
-	TIMEOUT_PARAM tp;
+	struct ssl_session_cache_shard *shard;
+	size_t i;
+
+	/* Each shard is flushed under its own lock, one at a time. */
+	for (i = 0; i < SSL_SESSION_CACHE_SHARDS; i++) {
+		shard = &s->session_cache[i];
+		if (shard->sessions == NULL)
+			continue;
+		(void) pthread_mutex_lock(&shard->lock);
+		ssl_session_cache_flush(s, shard, t);
+		(void) pthread_mutex_unlock(&shard->lock);
+	}
+}
 
-	tp.ctx = s;
-	tp.cache = s->sessions;
-	if (tp.cache == NULL)
-		return;
-	tp.time = t;
-	CRYPTO_w_lock(CRYPTO_LOCK_SSL_CTX);
-	i = CHECKED_LHASH_OF(SSL_SESSION, tp.cache)->down_load;
-	CHECKED_LHASH_OF(SSL_SESSION, tp.cache)->down_load = 0;
-	lh_SSL_SESSION_doall_arg(tp.cache, timeout_LHASH_DOALL_ARG,
-	TIMEOUT_PARAM, &tp);
-	CHECKED_LHASH_OF(SSL_SESSION, tp.cache)->down_load = i;
-	CRYPTO_w_unlock(CRYPTO_LOCK_SSL_CTX);
+/*
+ * Expire a bounded batch of sessions from each shard, using the timer
+ * wheels rather than walking the cache.
+ */
+void
+ssl_session_cache_expire(SSL_CTX *ctx, time_t now)
+{
+	struct ssl_session_cache_shard *shard;
+	size_t i;
+
+	for (i = 0; i < SSL_SESSION_CACHE_SHARDS; i++) {
+		shard = &ctx->session_cache[i];
+		if (shard->sessions == NULL)
+			continue;
+		(void) pthread_mutex_lock(&shard->lock);
+		ssl_session_timer_advance(ctx, shard, now);
+		(void) pthread_mutex_unlock(&shard->lock);
+	}
 }
 
 int
@@ -1157,30 +1692,30 @@ ssl_clear_bad_session(SSL *s)
 		return (0);
 }
 
-/* locked by SSL_CTX in the calling function */
+/* locked by the shard in the calling function */
 static void
-SSL_SESSION_list_remove(SSL_CTX *ctx, SSL_SESSION *s)
+SSL_SESSION_list_remove(struct ssl_session_cache_shard *shard, SSL_SESSION *s)
 {
 	if (s->next == NULL || s->prev == NULL)
 		return;
 
-	if (s->next == (SSL_SESSION *)&(ctx->session_cache_tail)) {
+	if (s->next == (SSL_SESSION *)&(shard->session_cache_tail)) {
 		/* last element in list */
-		if (s->prev == (SSL_SESSION *)&(ctx->session_cache_head)) {
+		if (s->prev == (SSL_SESSION *)&(shard->session_cache_head)) {
 			/* only one element in list */
-			ctx->session_cache_head = NULL;
-			ctx->session_cache_tail = NULL;
+			shard->session_cache_head = NULL;
+			shard->session_cache_tail = NULL;
 		} else {
-			ctx->session_cache_tail = s->prev;
+			shard->session_cache_tail = s->prev;
 			s->prev->next =
-			    (SSL_SESSION *)&(ctx->session_cache_tail);
+			    (SSL_SESSION *)&(shard->session_cache_tail);
 		}
 	} else {
-		if (s->prev == (SSL_SESSION *)&(ctx->session_cache_head)) {
+		if (s->prev == (SSL_SESSION *)&(shard->session_cache_head)) {
 			/* first element in list */
-			ctx->session_cache_head = s->next;
+			shard->session_cache_head = s->next;
 			s->next->prev =
-			    (SSL_SESSION *)&(ctx->session_cache_head);
+			    (SSL_SESSION *)&(shard->session_cache_head);
 		} else {
 			/* middle of list */
 			s->next->prev = s->prev;
@@ -1191,21 +1726,21 @@ SSL_SESSION_list_remove(SSL_CTX *ctx, SSL_SESSION *s)
 }
 
 static void
-SSL_SESSION_list_add(SSL_CTX *ctx, SSL_SESSION *s)
+SSL_SESSION_list_add(struct ssl_session_cache_shard *shard, SSL_SESSION *s)
 {
 	if (s->next != NULL && s->prev != NULL)
-		SSL_SESSION_list_remove(ctx, s);
+		SSL_SESSION_list_remove(shard, s);
 
-	if (ctx->session_cache_head == NULL) {
-		ctx->session_cache_head = s;
-		ctx->session_cache_tail = s;
-		s->prev = (SSL_SESSION *)&(ctx->session_cache_head);
-		s->next = (SSL_SESSION *)&(ctx->session_cache_tail);
+	if (shard->session_cache_head == NULL) {
+		shard->session_cache_head = s;
+		shard->session_cache_tail = s;
+		s->prev = (SSL_SESSION *)&(shard->session_cache_head);
+		s->next = (SSL_SESSION *)&(shard->session_cache_tail);
 	} else {
-		s->next = ctx->session_cache_head;
+		s->next = shard->session_cache_head;
 		s->next->prev = s;
-		s->prev = (SSL_SESSION *)&(ctx->session_cache_head);
-		ctx->session_cache_head = s;
+		s->prev = (SSL_SESSION *)&(shard->session_cache_head);
+		shard->session_cache_head = s;
 	}
 }
 
@@ -391,8 +391,9 @@ tls1_ec_nid2group_id(int nid, uint16_t *out_group_id)
 
 /*
  * Return the appropriate format list. If client_formats is non-zero, return
- * the client/session formats. Otherwise return the custom format list if one
- * exists, or the default formats if a custom list has not been specified.
+ * the client/session formats. Otherwise return the custom format list of the
+ * SSL or of its initial SSL_CTX if one exists, or the default formats if a
+ * custom list has not been specified.
  */
 void
 tls1_get_formatlist(const SSL *s, int client_formats, const uint8_t **pformats,
@@ -406,6 +407,10 @@ tls1_get_formatlist(const SSL *s, int client_formats, const uint8_t **pformats,
 
 	*pformats = s->tlsext_ecpointformatlist;
 	*pformatslen = s->tlsext_ecpointformatlist_length;
+	if (*pformats == NULL) {
+		*pformats = s->initial_ctx->tlsext_ecpointformatlist;
+		*pformatslen = s->initial_ctx->tlsext_ecpointformatlist_length;
+	}
 	if (*pformats == NULL) {
 		*pformats = ecformats_default;
 		*pformatslen = sizeof(ecformats_default);
@@ -414,8 +419,9 @@ tls1_get_formatlist(const SSL *s, int client_formats, const uint8_t **pformats,
 
 /*
  * Return the appropriate group list. If client_groups is non-zero, return
- * the client/session groups. Otherwise return the custom group list if one
- * exists, or the default groups if a custom list has not been specified.
+ * the client/session groups. Otherwise return the custom group list of the
+ * SSL or of its initial SSL_CTX if one exists, or the default groups if a
+ * custom list has not been specified.
  */
 void
 tls1_get_group_list(const SSL *s, int client_groups, const uint16_t **pgroups,
@@ -432,6 +438,11 @@ tls1_get_group_list(const SSL *s, int client_groups, const uint16_t **pgroups,
 	if (*pgroups != NULL)
 		return;
 
+	*pgroups = s->ctx_params->tlsext_supportedgroups;
+	*pgroupslen = s->ctx_params->tlsext_supportedgroups_length;
+	if (*pgroups != NULL)
+		return;
+
 	if (!s->server) {
 		*pgroups = ecgroups_client_default;
 		*pgroupslen = sizeof(ecgroups_client_default) / 2;
@@ -773,6 +784,7 @@ ssl_check_clienthello_tlsext_late(SSL *s)
 	    s->ctx && s->ctx->tlsext_status_cb) {
 		int r;
 		SSL_CERT_PKEY *certpkey;
+		size_t idx;
 		certpkey = ssl_get_server_send_pkey(s);
 		/* If no certificate can't return certificate status */
 		if (certpkey == NULL) {
@@ -782,7 +794,13 @@ ssl_check_clienthello_tlsext_late(SSL *s)
 		/* Set current certificate to one we will use so
 		 * SSL_get_certificate et al can pick it up.
 		 */
-		s->cert->key = certpkey;
+		idx = certpkey - s->cert->pkeys;
+		if (!ssl_cert_own(&s->cert)) {
+			ret = SSL_TLSEXT_ERR_ALERT_FATAL;
+			al = SSL_AD_INTERNAL_ERROR;
+			goto err;
+		}
+		s->cert->key = &s->cert->pkeys[idx];
 		r = s->ctx->tlsext_status_cb(s,
 		    s->ctx->tlsext_status_arg);
 		switch (r) {
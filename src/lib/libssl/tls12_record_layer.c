@@ -15,6 +15,8 @@
  * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  */
 
+#include <sys/uio.h>
+
 #include <limits.h>
 #include <stdlib.h>
 
@@ -883,6 +885,7 @@ tls12_record_layer_open_record_protected_aead(struct tls12_record_layer *rl,
 	uint8_t *content = NULL;
 	size_t content_len = 0;
 	size_t out_len = 0;
+	struct iovec iov[1];
 	CBS var_nonce;
 	int ret = 0;
 
@@ -920,9 +923,12 @@ tls12_record_layer_open_record_protected_aead(struct tls12_record_layer *rl,
 	    seq_num, &header, &header_len))
 		goto err;
 
-	if (!EVP_AEAD_CTX_open(rp->aead_ctx, content, &out_len, content_len,
-	    rp->aead_nonce, rp->aead_nonce_len, CBS_data(fragment),
-	    CBS_len(fragment), header, header_len)) {
+	iov[0].iov_base = (void *)CBS_data(fragment);
+	iov[0].iov_len = CBS_len(fragment);
+
+	if (!EVP_AEAD_CTX_open_iov(rp->aead_ctx, content, &out_len,
+	    content_len, rp->aead_nonce, rp->aead_nonce_len, iov, 1, header,
+	    header_len)) {
 		rl->alert_desc = SSL_AD_BAD_RECORD_MAC;
 		goto err;
 	}
@@ -1151,6 +1157,7 @@ tls12_record_layer_seal_record_protected_aead(struct tls12_record_layer *rl,
 	uint8_t *header = NULL;
 	size_t header_len = 0;
 	size_t enc_record_len, out_len;
+	struct iovec iov[1];
 	uint8_t *enc_data;
 	int ret = 0;
 
@@ -1181,8 +1188,11 @@ tls12_record_layer_seal_record_protected_aead(struct tls12_record_layer *rl,
 	if (!CBB_add_space(out, &enc_data, enc_record_len))
 		goto err;
 
-	if (!EVP_AEAD_CTX_seal(rp->aead_ctx, enc_data, &out_len, enc_record_len,
-	    rp->aead_nonce, rp->aead_nonce_len, content, content_len, header,
+	iov[0].iov_base = (void *)content;
+	iov[0].iov_len = content_len;
+
+	if (!EVP_AEAD_CTX_seal_iov(rp->aead_ctx, enc_data, &out_len,
+	    enc_record_len, rp->aead_nonce, rp->aead_nonce_len, iov, 1, header,
 	    header_len))
 		goto err;
 
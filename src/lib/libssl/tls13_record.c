@@ -24,6 +24,7 @@ struct tls13_record {
 	size_t rec_len;
 	uint8_t *data;
 	size_t data_len;
+	size_t data_capacity;
 	CBS cbs;
 
 	struct tls_buffer *buf;
@@ -35,16 +36,9 @@ tls13_record_new(void)
 	struct tls13_record *rec = NULL;
 
 	if ((rec = calloc(1, sizeof(struct tls13_record))) == NULL)
-		goto err;
-	if ((rec->buf = tls_buffer_new(TLS13_RECORD_MAX_LEN)) == NULL)
-		goto err;
+		return NULL;
 
 	return rec;
-
- err:
-	tls13_record_free(rec);
-
-	return NULL;
 }
 
 void
@@ -55,7 +49,7 @@ tls13_record_free(struct tls13_record *rec)
 
 	tls_buffer_free(rec->buf);
 
-	freezero(rec->data, rec->data_len);
+	freezero(rec->data, rec->data_capacity);
 	freezero(rec, sizeof(struct tls13_record));
 }
 
@@ -109,14 +103,62 @@ tls13_record_set_data(struct tls13_record *rec, uint8_t *data, size_t data_len)
 	if (data_len > TLS13_RECORD_MAX_LEN)
 		return 0;
 
-	freezero(rec->data, rec->data_len);
+	freezero(rec->data, rec->data_capacity);
 	rec->data = data;
 	rec->data_len = data_len;
+	rec->data_capacity = data_len;
 	CBS_init(&rec->cbs, rec->data, rec->data_len);
 
 	return 1;
 }
 
+/*
+ * Reserve data_len bytes of record data, so that the caller can build and
+ * seal the record in place. The buffer is allocated at its maximum size on
+ * first use and is retained until the record is freed, hence a record that
+ * is reset and reused does not allocate again.
+ */
+int
+tls13_record_reserve(struct tls13_record *rec, size_t data_len,
+    uint8_t **out_data)
+{
+	uint8_t *data;
+
+	if (data_len > TLS13_RECORD_MAX_LEN)
+		return 0;
+
+	if (rec->data_capacity < TLS13_RECORD_MAX_LEN) {
+		if ((data = malloc(TLS13_RECORD_MAX_LEN)) == NULL)
+			return 0;
+		freezero(rec->data, rec->data_capacity);
+		rec->data = data;
+		rec->data_capacity = TLS13_RECORD_MAX_LEN;
+	}
+
+	rec->data_len = data_len;
+	CBS_init(&rec->cbs, rec->data, rec->data_len);
+
+	*out_data = rec->data;
+
+	return 1;
+}
+
+/*
+ * Mark the record as empty, while retaining any reserved buffer for reuse.
+ */
+void
+tls13_record_reset(struct tls13_record *rec)
+{
+	rec->data_len = 0;
+	CBS_init(&rec->cbs, rec->data, 0);
+}
+
+int
+tls13_record_pending(struct tls13_record *rec)
+{
+	return rec->data_len > 0;
+}
+
 ssize_t
 tls13_record_recv(struct tls13_record *rec, tls_read_cb wire_read,
     void *wire_arg)
@@ -129,6 +171,11 @@ tls13_record_recv(struct tls13_record *rec, tls_read_cb wire_read,
 	if (rec->data != NULL)
 		return TLS13_IO_FAILURE;
 
+	if (rec->buf == NULL) {
+		if ((rec->buf = tls_buffer_new(TLS13_RECORD_MAX_LEN)) == NULL)
+			return TLS13_IO_FAILURE;
+	}
+
 	if (rec->content_type == 0) {
 		if ((ret = tls_buffer_extend(rec->buf,
 		    TLS13_RECORD_HEADER_LEN, wire_read, wire_arg)) <= 0)
@@ -160,6 +207,7 @@ tls13_record_recv(struct tls13_record *rec, tls_read_cb wire_read,
 
 	if (!tls_buffer_finish(rec->buf, &rec->data, &rec->data_len))
 		return TLS13_IO_FAILURE;
+	rec->data_capacity = rec->data_len;
 
 	return rec->data_len;
 }
@@ -170,7 +218,7 @@ tls13_record_send(struct tls13_record *rec, tls_write_cb wire_write,
 {
 	ssize_t ret;
 
-	if (rec->data == NULL)
+	if (rec->data == NULL || rec->data_len == 0)
 		return TLS13_IO_FAILURE;
 
 	while (CBS_len(&rec->cbs) > 0) {
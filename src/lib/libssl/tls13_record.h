@@ -56,6 +56,10 @@ int tls13_record_content(struct tls13_record *_rec, CBS *_cbs);
 void tls13_record_data(struct tls13_record *_rec, CBS *_cbs);
 int tls13_record_set_data(struct tls13_record *_rec, uint8_t *_data,
     size_t _data_len);
+int tls13_record_reserve(struct tls13_record *_rec, size_t _data_len,
+    uint8_t **_out_data);
+void tls13_record_reset(struct tls13_record *_rec);
+int tls13_record_pending(struct tls13_record *_rec);
 ssize_t tls13_record_recv(struct tls13_record *_rec, tls_read_cb _wire_read,
     void *_wire_arg);
 ssize_t tls13_record_send(struct tls13_record *_rec, tls_write_cb _wire_write,
@@ -15,6 +15,8 @@
  * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  */
 
+#include <sys/uio.h>
+
 #include "tls13_internal.h"
 #include "tls13_record.h"
 #include "tls_content.h"
@@ -122,10 +124,9 @@ tls13_record_layer_rrec_free(struct tls13_record_layer *rl)
 }
 
 static void
-tls13_record_layer_wrec_free(struct tls13_record_layer *rl)
+tls13_record_layer_wrec_reset(struct tls13_record_layer *rl)
 {
-	tls13_record_free(rl->wrec);
-	rl->wrec = NULL;
+	tls13_record_reset(rl->wrec);
 }
 
 struct tls13_record_layer *
@@ -140,6 +141,9 @@ tls13_record_layer_new(const struct tls13_record_layer_callbacks *callbacks,
 	if ((rl->rcontent = tls_content_new()) == NULL)
 		goto err;
 
+	if ((rl->wrec = tls13_record_new()) == NULL)
+		goto err;
+
 	if ((rl->read = tls13_record_protection_new()) == NULL)
 		goto err;
 	if ((rl->write = tls13_record_protection_new()) == NULL)
@@ -164,7 +168,7 @@ tls13_record_layer_free(struct tls13_record_layer *rl)
 		return;
 
 	tls13_record_layer_rrec_free(rl);
-	tls13_record_layer_wrec_free(rl);
+	tls13_record_free(rl->wrec);
 
 	freezero(rl->alert_data, rl->alert_len);
 	freezero(rl->phh_data, rl->phh_len);
@@ -551,6 +555,7 @@ tls13_record_layer_open_record_protected(struct tls13_record_layer *rl)
 	uint8_t *content = NULL;
 	size_t content_len = 0;
 	uint8_t content_type;
+	struct iovec iov[1];
 	size_t out_len;
 
 	if (rl->aead == NULL)
@@ -570,10 +575,12 @@ tls13_record_layer_open_record_protected(struct tls13_record_layer *rl)
 	    rl->read->seq_num))
 		goto err;
 
-	if (!EVP_AEAD_CTX_open(rl->read->aead_ctx,
+	iov[0].iov_base = (void *)CBS_data(&enc_record);
+	iov[0].iov_len = CBS_len(&enc_record);
+
+	if (!EVP_AEAD_CTX_open_iov(rl->read->aead_ctx,
 	    content, &out_len, content_len,
-	    rl->read->nonce.data, rl->read->nonce.len,
-	    CBS_data(&enc_record), CBS_len(&enc_record),
+	    rl->read->nonce.data, rl->read->nonce.len, iov, 1,
 	    CBS_data(&header), CBS_len(&header)))
 		goto err;
 
@@ -633,9 +640,11 @@ static int
 tls13_record_layer_seal_record_plaintext(struct tls13_record_layer *rl,
     uint8_t content_type, const uint8_t *content, size_t content_len)
 {
-	uint8_t *data = NULL;
-	size_t data_len = 0;
-	CBB cbb, body;
+	uint8_t *data;
+	size_t data_len;
+	CBB cbb;
+
+	memset(&cbb, 0, sizeof(cbb));
 
 	/*
 	 * Allow dummy CCS messages to be sent in plaintext even when
@@ -651,22 +660,22 @@ tls13_record_layer_seal_record_plaintext(struct tls13_record_layer *rl,
 	 * We're still operating in plaintext mode, so just copy the
 	 * content into the record.
 	 */
-	if (!CBB_init(&cbb, TLS13_RECORD_HEADER_LEN + content_len))
+	data_len = TLS13_RECORD_HEADER_LEN + content_len;
+	if (!tls13_record_reserve(rl->wrec, data_len, &data))
+		goto err;
+	if (!CBB_init_fixed(&cbb, data, data_len))
 		goto err;
 
 	if (!CBB_add_u8(&cbb, content_type))
 		goto err;
 	if (!CBB_add_u16(&cbb, rl->legacy_version))
 		goto err;
-	if (!CBB_add_u16_length_prefixed(&cbb, &body))
-		goto err;
-	if (!CBB_add_bytes(&body, content, content_len))
+	if (!CBB_add_u16(&cbb, content_len))
 		goto err;
-
-	if (!CBB_finish(&cbb, &data, &data_len))
+	if (!CBB_add_bytes(&cbb, content, content_len))
 		goto err;
 
-	if (!tls13_record_set_data(rl->wrec, data, data_len))
+	if (!CBB_finish(&cbb, NULL, NULL))
 		goto err;
 
 	rl->wrec_content_len = content_len;
@@ -676,20 +685,24 @@ tls13_record_layer_seal_record_plaintext(struct tls13_record_layer *rl,
 
  err:
 	CBB_cleanup(&cbb);
-	freezero(data, data_len);
+	tls13_record_reset(rl->wrec);
 
 	return 0;
 }
 
+/*
+ * Seal a protected record directly into the persistent write record buffer -
+ * the inner plaintext is passed to the AEAD as separate content and content
+ * type segments, which avoids allocating and copying intermediate buffers for
+ * every record.
+ */
 static int
 tls13_record_layer_seal_record_protected(struct tls13_record_layer *rl,
     uint8_t content_type, const uint8_t *content, size_t content_len)
 {
-	uint8_t *data = NULL, *header = NULL, *inner = NULL;
-	size_t data_len = 0, header_len = 0, inner_len = 0;
-	uint8_t *enc_record;
-	size_t enc_record_len;
-	ssize_t ret = 0;
+	uint8_t *data, *enc_record;
+	size_t data_len, enc_record_len, inner_len;
+	struct iovec iov[2];
 	size_t out_len;
 	CBB cbb;
 
@@ -698,17 +711,8 @@ tls13_record_layer_seal_record_protected(struct tls13_record_layer *rl,
 
 	memset(&cbb, 0, sizeof(cbb));
 
-	/* Build inner plaintext. */
-	if (!CBB_init(&cbb, content_len + 1))
-		goto err;
-	if (!CBB_add_bytes(&cbb, content, content_len))
-		goto err;
-	if (!CBB_add_u8(&cbb, content_type))
-		goto err;
 	/* XXX - padding? */
-	if (!CBB_finish(&cbb, &inner, &inner_len))
-		goto err;
-
+	inner_len = content_len + 1;
 	if (inner_len > TLS13_RECORD_MAX_INNER_PLAINTEXT_LEN)
 		goto err;
 
@@ -717,8 +721,15 @@ tls13_record_layer_seal_record_protected(struct tls13_record_layer *rl,
 	if (enc_record_len > TLS13_RECORD_MAX_CIPHERTEXT_LEN)
 		goto err;
 
-	/* Build the record header. */
-	if (!CBB_init(&cbb, TLS13_RECORD_HEADER_LEN))
+	if (!tls13_record_layer_update_nonce(&rl->write->nonce,
+	    &rl->write->iv, rl->write->seq_num))
+		goto err;
+
+	/* Build the record header, followed by space for the content. */
+	data_len = TLS13_RECORD_HEADER_LEN + enc_record_len;
+	if (!tls13_record_reserve(rl->wrec, data_len, &data))
+		goto err;
+	if (!CBB_init_fixed(&cbb, data, data_len))
 		goto err;
 	if (!CBB_add_u8(&cbb, SSL3_RT_APPLICATION_DATA))
 		goto err;
@@ -726,32 +737,21 @@ tls13_record_layer_seal_record_protected(struct tls13_record_layer *rl,
 		goto err;
 	if (!CBB_add_u16(&cbb, enc_record_len))
 		goto err;
-	if (!CBB_finish(&cbb, &header, &header_len))
-		goto err;
-
-	/* Build the actual record. */
-	if (!CBB_init(&cbb, TLS13_RECORD_HEADER_LEN + enc_record_len))
-		goto err;
-	if (!CBB_add_bytes(&cbb, header, header_len))
-		goto err;
 	if (!CBB_add_space(&cbb, &enc_record, enc_record_len))
 		goto err;
-	if (!CBB_finish(&cbb, &data, &data_len))
+	if (!CBB_finish(&cbb, NULL, NULL))
 		goto err;
 
-	if (!tls13_record_layer_update_nonce(&rl->write->nonce,
-	    &rl->write->iv, rl->write->seq_num))
-		goto err;
+	/* The inner plaintext is the content followed by the content type. */
+	iov[0].iov_base = (void *)content;
+	iov[0].iov_len = content_len;
+	iov[1].iov_base = &content_type;
+	iov[1].iov_len = 1;
 
-	/*
-	 * XXX - consider a EVP_AEAD_CTX_seal_iov() that takes an iovec...
-	 * this would avoid a copy since the inner would be passed as two
-	 * separate pieces.
-	 */
-	if (!EVP_AEAD_CTX_seal(rl->write->aead_ctx,
+	if (!EVP_AEAD_CTX_seal_iov(rl->write->aead_ctx,
 	    enc_record, &out_len, enc_record_len,
-	    rl->write->nonce.data, rl->write->nonce.len,
-	    inner, inner_len, header, header_len))
+	    rl->write->nonce.data, rl->write->nonce.len, iov, 2,
+	    data, TLS13_RECORD_HEADER_LEN))
 		goto err;
 
 	if (out_len != enc_record_len)
@@ -760,25 +760,16 @@ tls13_record_layer_seal_record_protected(struct tls13_record_layer *rl,
 	if (!tls13_record_layer_inc_seq_num(rl->write->seq_num))
 		goto err;
 
-	if (!tls13_record_set_data(rl->wrec, data, data_len))
-		goto err;
-
 	rl->wrec_content_len = content_len;
 	rl->wrec_content_type = content_type;
 
-	data = NULL;
-	data_len = 0;
-
-	ret = 1;
+	return 1;
 
  err:
 	CBB_cleanup(&cbb);
+	tls13_record_reset(rl->wrec);
 
-	freezero(data, data_len);
-	freezero(header, header_len);
-	freezero(inner, inner_len);
-
-	return ret;
+	return 0;
 }
 
 static int
@@ -788,9 +779,7 @@ tls13_record_layer_seal_record(struct tls13_record_layer *rl,
 	if (rl->handshake_completed && rl->aead == NULL)
 		return 0;
 
-	tls13_record_layer_wrec_free(rl);
-
-	if ((rl->wrec = tls13_record_new()) == NULL)
+	if (tls13_record_pending(rl->wrec))
 		return 0;
 
 	if (rl->aead == NULL || content_type == SSL3_RT_CHANGE_CIPHER_SPEC)
@@ -1051,11 +1040,11 @@ tls13_record_layer_write_record(struct tls13_record_layer *rl,
 	}
 
 	/* See if there is an existing record and attempt to push it out... */
-	if (rl->wrec != NULL) {
+	if (tls13_record_pending(rl->wrec)) {
 		if ((ret = tls13_record_send(rl->wrec, rl->cb.wire_write,
 		    rl->cb_arg)) <= 0)
 			return ret;
-		tls13_record_layer_wrec_free(rl);
+		tls13_record_layer_wrec_reset(rl);
 
 		if (rl->wrec_content_type == content_type) {
 			ret = rl->wrec_content_len;
@@ -1082,7 +1071,7 @@ tls13_record_layer_write_record(struct tls13_record_layer *rl,
 	if ((ret = tls13_record_send(rl->wrec, rl->cb.wire_write, rl->cb_arg)) <= 0)
 		return ret;
 
-	tls13_record_layer_wrec_free(rl);
+	tls13_record_layer_wrec_reset(rl);
 
 	return content_len;
 
@@ -500,6 +500,8 @@ tls_configure_ssl_keypair(struct tls *ctx, SSL_CTX *ssl_ctx,
 int
 tls_configure_ssl(struct tls *ctx, SSL_CTX *ssl_ctx)
 {
+	X509_VERIFY_PARAM *vpm;
+
 	SSL_CTX_clear_mode(ssl_ctx, SSL_MODE_AUTO_RETRY);
 
 	SSL_CTX_set_mode(ssl_ctx, SSL_MODE_ENABLE_PARTIAL_WRITE);
@@ -539,8 +541,11 @@ tls_configure_ssl(struct tls *ctx, SSL_CTX *ssl_ctx)
 	}
 
 	if (ctx->config->verify_time == 0) {
-		X509_VERIFY_PARAM_set_flags(SSL_CTX_get0_param(ssl_ctx),
-		    X509_V_FLAG_NO_CHECK_TIME);
+		if ((vpm = SSL_CTX_get0_param(ssl_ctx)) == NULL) {
+			tls_set_errorx(ctx, "failed to get verify parameters");
+			goto err;
+		}
+		X509_VERIFY_PARAM_set_flags(vpm, X509_V_FLAG_NO_CHECK_TIME);
 	}
 
 	/* Disable any form of session caching by default */
@@ -714,6 +719,9 @@ tls_reset(struct tls *ctx)
 	}
 	ctx->sni_ctx = NULL;
 
+	tls_sni_index_free(ctx->sni_index);
+	ctx->sni_index = NULL;
+
 	ctx->read_cb = NULL;
 	ctx->write_cb = NULL;
 	ctx->cb_arg = NULL;
@@ -194,6 +194,7 @@ struct tls {
 	SSL_CTX *ssl_ctx;
 
 	struct tls_sni_ctx *sni_ctx;
+	struct tls_sni_index *sni_index;
 
 	X509 *ssl_peer_cert;
 	STACK_OF(X509) *ssl_peer_chain;
@@ -232,6 +233,13 @@ int tls_keypair_load_cert(struct tls_keypair *_keypair,
 struct tls_sni_ctx *tls_sni_ctx_new(void);
 void tls_sni_ctx_free(struct tls_sni_ctx *sni_ctx);
 
+struct tls_sni_index *tls_sni_index_new(void);
+void tls_sni_index_free(struct tls_sni_index *index);
+int tls_sni_index_add(struct tls *ctx, struct tls_sni_index *index,
+    struct tls_sni_ctx *sni_ctx);
+struct tls_sni_ctx *tls_sni_index_lookup(struct tls_sni_index *index,
+    const char *name);
+
 struct tls_config *tls_config_new_internal(void);
 
 struct tls *tls_new(void);
@@ -239,6 +247,10 @@ struct tls *tls_server_conn(struct tls *ctx);
 
 int tls_check_name(struct tls *ctx, X509 *cert, const char *servername,
     int *match);
+int tls_cert_dns_names(struct tls *ctx, X509 *cert,
+    int (*cb)(const char *name, void *arg), void *arg);
+const char *tls_wildcard_cert_domain(const char *cert_name);
+const char *tls_wildcard_name_domain(const char *name);
 int tls_configure_server(struct tls *ctx);
 
 int tls_configure_ssl(struct tls *ctx, SSL_CTX *ssl_ctx);
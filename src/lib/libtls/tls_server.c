@@ -84,7 +84,6 @@ tls_servername_cb(SSL *ssl, int *al, void *arg)
 	union tls_addr addrbuf;
 	struct tls *conn_ctx;
 	const char *name;
-	int match;
 
 	if ((conn_ctx = SSL_get_app_data(ssl)) == NULL)
 		goto err;
@@ -114,15 +113,11 @@ tls_servername_cb(SSL *ssl, int *al, void *arg)
 		goto err;
 
 	/* Find appropriate SSL context for requested servername. */
-	for (sni_ctx = ctx->sni_ctx; sni_ctx != NULL; sni_ctx = sni_ctx->next) {
-		if (tls_check_name(ctx, sni_ctx->ssl_cert, name,
-		    &match) == -1)
-			goto err;
-		if (match) {
-			conn_ctx->keypair = sni_ctx->keypair;
-			SSL_set_SSL_CTX(conn_ctx->ssl_conn, sni_ctx->ssl_ctx);
-			return (SSL_TLSEXT_ERR_OK);
-		}
+	if (ctx->sni_index != NULL &&
+	    (sni_ctx = tls_sni_index_lookup(ctx->sni_index, name)) != NULL) {
+		conn_ctx->keypair = sni_ctx->keypair;
+		SSL_set_SSL_CTX(conn_ctx->ssl_conn, sni_ctx->ssl_ctx);
+		return (SSL_TLSEXT_ERR_OK);
 	}
 
 	/* No match, use the existing context/certificate. */
@@ -317,7 +312,16 @@ tls_configure_server_sni(struct tls *ctx)
 	if (ctx->config->keypair->next == NULL)
 		return (0);
 
-	/* Set up additional SSL contexts for SNI. */
+	if ((ctx->sni_index = tls_sni_index_new()) == NULL) {
+		tls_set_errorx(ctx, "out of memory");
+		goto err;
+	}
+
+	/*
+	 * Set up additional SSL contexts for SNI and index the names in their
+	 * certificates, so that servername lookups do not need to check each
+	 * certificate in turn.
+	 */
 	sni_ctx = &ctx->sni_ctx;
 	for (kp = ctx->config->keypair->next; kp != NULL; kp = kp->next) {
 		if ((*sni_ctx = tls_sni_ctx_new()) == NULL) {
@@ -330,6 +334,8 @@ tls_configure_server_sni(struct tls *ctx)
 		if (tls_keypair_load_cert(kp, &ctx->error,
 		    &(*sni_ctx)->ssl_cert) == -1)
 			goto err;
+		if (tls_sni_index_add(ctx, ctx->sni_index, *sni_ctx) == -1)
+			goto err;
 		sni_ctx = &(*sni_ctx)->next;
 	}
 
@@ -0,0 +1,250 @@
+/* $OpenBSD$ */
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <ctype.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <tls.h>
+#include "tls_internal.h"
+
+/*
+ * Index of the names in the SNI certificates, so that a servername can be
+ * mapped to an SNI context without checking every certificate in turn.
+ * Exact names are hashed as is, while wildcard names are hashed on their
+ * domain part (".domain.tld"). Each name records the position of its SNI
+ * context in the list, so that the first matching context wins, as it
+ * would with a linear search.
+ */
+
+#define TLS_SNI_INDEX_MIN_BUCKETS	16
+
+struct tls_sni_name {
+	struct tls_sni_name *next;
+	struct tls_sni_ctx *sni_ctx;
+	size_t position;
+	uint32_t hash;
+	char *name;
+};
+
+struct tls_sni_table {
+	struct tls_sni_name **buckets;
+	size_t num_buckets;
+	size_t num_names;
+};
+
+struct tls_sni_index {
+	struct tls_sni_table exact;
+	struct tls_sni_table wildcard;
+	size_t num_ctx;
+};
+
+struct tls_sni_index_add_arg {
+	struct tls_sni_index *index;
+	struct tls_sni_ctx *sni_ctx;
+	size_t position;
+};
+
+/* Case insensitive FNV-1a, since names are compared with strcasecmp(). */
+static uint32_t
+tls_sni_name_hash(const char *name)
+{
+	uint32_t h = 2166136261U;
+
+	for (; *name != '\0'; name++)
+		h = (h ^ (uint8_t)tolower((unsigned char)*name)) * 16777619U;
+
+	return h;
+}
+
+static void
+tls_sni_table_free(struct tls_sni_table *table)
+{
+	struct tls_sni_name *n, *nn;
+	size_t i;
+
+	for (i = 0; i < table->num_buckets; i++) {
+		for (n = table->buckets[i]; n != NULL; n = nn) {
+			nn = n->next;
+			free(n->name);
+			free(n);
+		}
+	}
+	free(table->buckets);
+
+	memset(table, 0, sizeof(*table));
+}
+
+static struct tls_sni_name *
+tls_sni_table_find(struct tls_sni_table *table, const char *name,
+    uint32_t hash)
+{
+	struct tls_sni_name *n;
+
+	if (table->num_buckets == 0)
+		return NULL;
+
+	for (n = table->buckets[hash & (table->num_buckets - 1)]; n != NULL;
+	    n = n->next) {
+		if (n->hash == hash && strcasecmp(n->name, name) == 0)
+			return n;
+	}
+
+	return NULL;
+}
+
+static int
+tls_sni_table_grow(struct tls_sni_table *table)
+{
+	struct tls_sni_name **buckets, *n, *nn;
+	size_t num_buckets, i;
+
+	if ((num_buckets = table->num_buckets * 2) == 0)
+		num_buckets = TLS_SNI_INDEX_MIN_BUCKETS;
+
+	if ((buckets = calloc(num_buckets, sizeof(*buckets))) == NULL)
+		return -1;
+
+	for (i = 0; i < table->num_buckets; i++) {
+		for (n = table->buckets[i]; n != NULL; n = nn) {
+			nn = n->next;
+			n->next = buckets[n->hash & (num_buckets - 1)];
+			buckets[n->hash & (num_buckets - 1)] = n;
+		}
+	}
+	free(table->buckets);
+
+	table->buckets = buckets;
+	table->num_buckets = num_buckets;
+
+	return 0;
+}
+
+static int
+tls_sni_table_add(struct tls_sni_table *table, const char *name,
+    struct tls_sni_ctx *sni_ctx, size_t position)
+{
+	struct tls_sni_name *n;
+	uint32_t hash;
+	size_t bucket;
+
+	hash = tls_sni_name_hash(name);
+
+	/* An earlier SNI context already claims this name. */
+	if (tls_sni_table_find(table, name, hash) != NULL)
+		return 0;
+
+	if (table->num_names >= table->num_buckets) {
+		if (tls_sni_table_grow(table) == -1)
+			return -1;
+	}
+
+	if ((n = calloc(1, sizeof(*n))) == NULL)
+		return -1;
+	if ((n->name = strdup(name)) == NULL) {
+		free(n);
+		return -1;
+	}
+	n->sni_ctx = sni_ctx;
+	n->position = position;
+	n->hash = hash;
+
+	bucket = hash & (table->num_buckets - 1);
+	n->next = table->buckets[bucket];
+	table->buckets[bucket] = n;
+	table->num_names++;
+
+	return 0;
+}
+
+struct tls_sni_index *
+tls_sni_index_new(void)
+{
+	return calloc(1, sizeof(struct tls_sni_index));
+}
+
+void
+tls_sni_index_free(struct tls_sni_index *index)
+{
+	if (index == NULL)
+		return;
+
+	tls_sni_table_free(&index->exact);
+	tls_sni_table_free(&index->wildcard);
+
+	free(index);
+}
+
+static int
+tls_sni_index_add_name(const char *name, void *arg)
+{
+	struct tls_sni_index_add_arg *aa = arg;
+	const char *domain;
+
+	/* A wildcard name also matches itself, as with tls_match_name(). */
+	if (tls_sni_table_add(&aa->index->exact, name, aa->sni_ctx,
+	    aa->position) == -1)
+		return -1;
+
+	if ((domain = tls_wildcard_cert_domain(name)) == NULL)
+		return 0;
+
+	return tls_sni_table_add(&aa->index->wildcard, domain, aa->sni_ctx,
+	    aa->position);
+}
+
+/*
+ * Add the names of the certificate of an SNI context to the index. SNI
+ * contexts must be added in the order that they are to be matched.
+ */
+int
+tls_sni_index_add(struct tls *ctx, struct tls_sni_index *index,
+    struct tls_sni_ctx *sni_ctx)
+{
+	struct tls_sni_index_add_arg aa;
+
+	aa.index = index;
+	aa.sni_ctx = sni_ctx;
+	aa.position = index->num_ctx++;
+
+	return tls_cert_dns_names(ctx, sni_ctx->ssl_cert,
+	    tls_sni_index_add_name, &aa);
+}
+
+struct tls_sni_ctx *
+tls_sni_index_lookup(struct tls_sni_index *index, const char *name)
+{
+	struct tls_sni_name *exact, *wildcard = NULL;
+	const char *domain;
+
+	exact = tls_sni_table_find(&index->exact, name,
+	    tls_sni_name_hash(name));
+
+	if ((domain = tls_wildcard_name_domain(name)) != NULL)
+		wildcard = tls_sni_table_find(&index->wildcard, domain,
+		    tls_sni_name_hash(domain));
+
+	if (exact == NULL && wildcard == NULL)
+		return NULL;
+	if (exact == NULL)
+		return wildcard->sni_ctx;
+	if (wildcard == NULL || exact->position < wildcard->position)
+		return exact->sni_ctx;
+
+	return wildcard->sni_ctx;
+}
@@ -27,51 +27,80 @@
 #include <tls.h>
 #include "tls_internal.h"
 
+/*
+ * Return the domain part (including the leading dot) of a valid wildcard
+ * certificate name, or NULL if cert_name is not a valid wildcard.
+ */
+const char *
+tls_wildcard_cert_domain(const char *cert_name)
+{
+	const char *cert_domain, *next_dot;
+
+	if (cert_name[0] != '*')
+		return NULL;
+
+	/*
+	 * Valid wildcards:
+	 * - "*.domain.tld"
+	 * - "*.sub.domain.tld"
+	 * - etc.
+	 * Reject "*.tld".
+	 * No attempt to prevent the use of eg. "*.co.uk".
+	 */
+	cert_domain = &cert_name[1];
+	/* Disallow "*"  */
+	if (cert_domain[0] == '\0')
+		return NULL;
+	/* Disallow "*foo" */
+	if (cert_domain[0] != '.')
+		return NULL;
+	/* Disallow "*.." */
+	if (cert_domain[1] == '.')
+		return NULL;
+	next_dot = strchr(&cert_domain[1], '.');
+	/* Disallow "*.bar" */
+	if (next_dot == NULL)
+		return NULL;
+	/* Disallow "*.bar.." */
+	if (next_dot[1] == '.')
+		return NULL;
+
+	return cert_domain;
+}
+
+/*
+ * Return the domain part (including the leading dot) of a name that may be
+ * matched against a wildcard, or NULL if it cannot match any wildcard.
+ */
+const char *
+tls_wildcard_name_domain(const char *name)
+{
+	const char *domain;
+
+	domain = strchr(name, '.');
+
+	/* No wildcard match against a name with no host part. */
+	if (name[0] == '.')
+		return NULL;
+	/* No wildcard match against a name with no domain part. */
+	if (domain == NULL || strlen(domain) == 1)
+		return NULL;
+
+	return domain;
+}
+
 static int
 tls_match_name(const char *cert_name, const char *name)
 {
-	const char *cert_domain, *domain, *next_dot;
+	const char *cert_domain, *domain;
 
 	if (strcasecmp(cert_name, name) == 0)
 		return 0;
 
 	/* Wildcard match? */
-	if (cert_name[0] == '*') {
-		/*
-		 * Valid wildcards:
-		 * - "*.domain.tld"
-		 * - "*.sub.domain.tld"
-		 * - etc.
-		 * Reject "*.tld".
-		 * No attempt to prevent the use of eg. "*.co.uk".
-		 */
-		cert_domain = &cert_name[1];
-		/* Disallow "*"  */
-		if (cert_domain[0] == '\0')
-			return -1;
-		/* Disallow "*foo" */
-		if (cert_domain[0] != '.')
-			return -1;
-		/* Disallow "*.." */
-		if (cert_domain[1] == '.')
-			return -1;
-		next_dot = strchr(&cert_domain[1], '.');
-		/* Disallow "*.bar" */
-		if (next_dot == NULL)
-			return -1;
-		/* Disallow "*.bar.." */
-		if (next_dot[1] == '.')
+	if ((cert_domain = tls_wildcard_cert_domain(cert_name)) != NULL) {
+		if ((domain = tls_wildcard_name_domain(name)) == NULL)
 			return -1;
-
-		domain = strchr(name, '.');
-
-		/* No wildcard match against a name with no host part. */
-		if (name[0] == '.')
-			return -1;
-		/* No wildcard match against a name with no domain part. */
-		if (domain == NULL || strlen(domain) == 1)
-			return -1;
-
 		if (strcasecmp(cert_domain, domain) == 0)
 			return 0;
 	}
@@ -278,3 +307,102 @@ tls_check_name(struct tls *ctx, X509 *cert, const char *name, int *match)
 
 	return tls_check_common_name(ctx, cert, name, match);
 }
+
+/*
+ * Call cb for each name that tls_check_name() would match a DNS name
+ * against - that is the dNSName entries of the subjectAltName or, if the
+ * certificate has no DNS or IP address alternate names, the Common Name.
+ */
+int
+tls_cert_dns_names(struct tls *ctx, X509 *cert,
+    int (*cb)(const char *name, void *arg), void *arg)
+{
+	STACK_OF(GENERAL_NAME) *altname_stack = NULL;
+	X509_NAME *subject_name;
+	char *common_name = NULL;
+	int common_name_len;
+	int alt_exists = 0;
+	int count, i;
+	int rv = -1;
+
+	altname_stack = X509_get_ext_d2i(cert, NID_subject_alt_name,
+	    NULL, NULL);
+
+	count = sk_GENERAL_NAME_num(altname_stack);
+	for (i = 0; i < count; i++) {
+		GENERAL_NAME *altname;
+		unsigned char *data;
+		int len;
+
+		altname = sk_GENERAL_NAME_value(altname_stack, i);
+
+		if (altname->type == GEN_DNS || altname->type == GEN_IPADD)
+			alt_exists = 1;
+
+		if (altname->type != GEN_DNS)
+			continue;
+		if (ASN1_STRING_type(altname->d.dNSName) != V_ASN1_IA5STRING)
+			continue;
+
+		data = ASN1_STRING_data(altname->d.dNSName);
+		len = ASN1_STRING_length(altname->d.dNSName);
+
+		if (len < 0 || (size_t)len != strlen(data)) {
+			tls_set_errorx(ctx, "error loading certificate names: "
+			    "NUL byte in subjectAltName, "
+			    "probably a malicious certificate");
+			goto err;
+		}
+		if (strcmp(data, " ") == 0) {
+			tls_set_errorx(ctx, "error loading certificate names: "
+			    "a dNSName of \" \" must not be used");
+			goto err;
+		}
+
+		if (cb(data, arg) == -1) {
+			tls_set_errorx(ctx, "out of memory");
+			goto err;
+		}
+	}
+
+	if (alt_exists)
+		goto done;
+
+	if ((subject_name = X509_get_subject_name(cert)) == NULL)
+		goto done;
+
+	common_name_len = X509_NAME_get_text_by_NID(subject_name,
+	    NID_commonName, NULL, 0);
+	if (common_name_len < 0)
+		goto done;
+
+	if ((common_name = calloc(common_name_len + 1, 1)) == NULL) {
+		tls_set_errorx(ctx, "out of memory");
+		goto err;
+	}
+
+	X509_NAME_get_text_by_NID(subject_name, NID_commonName, common_name,
+	    common_name_len + 1);
+
+	/* NUL bytes in CN? */
+	if ((size_t)common_name_len != strlen(common_name)) {
+		tls_set_errorx(ctx, "error loading certificate names: "
+		    "NUL byte in Common Name field, "
+		    "probably a malicious certificate");
+		goto err;
+	}
+
+	if (cb(common_name, arg) == -1) {
+		tls_set_errorx(ctx, "out of memory");
+		goto err;
+	}
+
+ done:
+	rv = 0;
+
+ err:
+	sk_GENERAL_NAME_pop_free(altname_stack, GENERAL_NAME_free);
+	free(common_name);
+
+	return rv;
+}
@@ -16,11 +16,15 @@
  * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  */
 
+#include <sys/time.h>
+#include <sys/uio.h>
+
 #include <ctype.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <unistd.h>
 
 #include <openssl/err.h>
@@ -187,6 +191,154 @@ run_aead_test(const EVP_AEAD *aead, unsigned char bufs[NUM_TYPES][BUF_MAX],
 	return ret;
 }
 
+/*
+ * Split buf into up to three segments, with the first two segments having
+ * the given lengths (clamped to the available data).
+ */
+static int
+split_iov(struct iovec iov[3], unsigned char *buf, size_t len, size_t first,
+    size_t second)
+{
+	int iovcnt = 0;
+
+	if (first > len)
+		first = len;
+	if (second > len - first)
+		second = len - first;
+
+	iov[iovcnt].iov_base = buf;
+	iov[iovcnt++].iov_len = first;
+	iov[iovcnt].iov_base = buf + first;
+	iov[iovcnt++].iov_len = second;
+	iov[iovcnt].iov_base = buf + first + second;
+	iov[iovcnt++].iov_len = len - first - second;
+
+	return iovcnt;
+}
+
+static const size_t iov_splits[][2] = {
+	{0, 0},
+	{1, 0},
+	{1, 1},
+	{7, 9},
+	{15, 17},
+	{16, 16},
+	{63, 1},
+	{64, 64},
+	{100, 3},
+	{SIZE_MAX, 0},
+};
+
+#define N_IOV_SPLITS (sizeof(iov_splits) / sizeof(iov_splits[0]))
+
+static int
+run_aead_iov_test(const EVP_AEAD *aead, unsigned char bufs[NUM_TYPES][BUF_MAX],
+    const unsigned int lengths[NUM_TYPES], unsigned int line_no)
+{
+	unsigned char in[BUF_MAX + EVP_AEAD_MAX_TAG_LENGTH];
+	unsigned char out[BUF_MAX + EVP_AEAD_MAX_TAG_LENGTH], out2[BUF_MAX];
+	size_t first, second, out_len, out_len2;
+	struct iovec iov[3];
+	EVP_AEAD_CTX *ctx;
+	int iovcnt;
+	size_t i;
+	int ret = 0;
+
+	if ((ctx = EVP_AEAD_CTX_new()) == NULL) {
+		fprintf(stderr, "Failed to allocate AEAD context on line %u\n",
+		    line_no);
+		goto err;
+	}
+
+	if (!EVP_AEAD_CTX_init(ctx, aead, bufs[KEY], lengths[KEY],
+	    lengths[TAG], NULL)) {
+		fprintf(stderr, "Failed to init AEAD on line %u\n", line_no);
+		goto err;
+	}
+
+	for (i = 0; i < N_IOV_SPLITS; i++) {
+		first = iov_splits[i][0];
+		second = iov_splits[i][1];
+
+		memcpy(in, bufs[IN], lengths[IN]);
+		iovcnt = split_iov(iov, in, lengths[IN], first, second);
+
+		if (!EVP_AEAD_CTX_seal_iov(ctx, out, &out_len, sizeof(out),
+		    bufs[NONCE], lengths[NONCE], iov, iovcnt, bufs[AD],
+		    lengths[AD])) {
+			fprintf(stderr, "Failed to run AEAD (iov %zu/%zu) on "
+			    "line %u\n", first, second, line_no);
+			goto err;
+		}
+		if (out_len != lengths[CT] + lengths[TAG]) {
+			fprintf(stderr, "Bad output length (iov %zu/%zu) on "
+			    "line %u: %zu\n", first, second, line_no, out_len);
+			goto err;
+		}
+		if (memcmp(out, bufs[CT], lengths[CT]) != 0) {
+			fprintf(stderr, "Bad output (iov %zu/%zu) on line %u\n",
+			    first, second, line_no);
+			goto err;
+		}
+		if (memcmp(out + lengths[CT], bufs[TAG], lengths[TAG]) != 0) {
+			fprintf(stderr, "Bad tag (iov %zu/%zu) on line %u\n",
+			    first, second, line_no);
+			goto err;
+		}
+
+		/* Split the ciphertext and tag, which may split the tag. */
+		memcpy(in, out, out_len);
+		iovcnt = split_iov(iov, in, out_len, first, second);
+
+		if (!EVP_AEAD_CTX_open_iov(ctx, out2, &out_len2, lengths[IN],
+		    bufs[NONCE], lengths[NONCE], iov, iovcnt, bufs[AD],
+		    lengths[AD])) {
+			fprintf(stderr, "Failed to decrypt (iov %zu/%zu) on "
+			    "line %u\n", first, second, line_no);
+			goto err;
+		}
+		if (out_len2 != lengths[IN] ||
+		    memcmp(out2, bufs[IN], out_len2) != 0) {
+			fprintf(stderr, "Plaintext mismatch (iov %zu/%zu) on "
+			    "line %u\n", first, second, line_no);
+			goto err;
+		}
+
+		/* Decrypt in place, with the output aliasing the input. */
+		if (!EVP_AEAD_CTX_open_iov(ctx, in, &out_len2, lengths[IN],
+		    bufs[NONCE], lengths[NONCE], iov, iovcnt, bufs[AD],
+		    lengths[AD])) {
+			fprintf(stderr, "Failed to decrypt in place (iov "
+			    "%zu/%zu) on line %u\n", first, second, line_no);
+			goto err;
+		}
+		if (out_len2 != lengths[IN] ||
+		    memcmp(in, bufs[IN], out_len2) != 0) {
+			fprintf(stderr, "Plaintext mismatch in place (iov "
+			    "%zu/%zu) on line %u\n", first, second, line_no);
+			goto err;
+		}
+
+		/* Corrupt the last byte of the tag. */
+		memcpy(in, out, out_len);
+		in[out_len - 1] ^= 0x80;
+		if (EVP_AEAD_CTX_open_iov(ctx, out2, &out_len2, lengths[IN],
+		    bufs[NONCE], lengths[NONCE], iov, iovcnt, bufs[AD],
+		    lengths[AD])) {
+			fprintf(stderr, "Decrypted bad data (iov %zu/%zu) on "
+			    "line %u\n", first, second, line_no);
+			goto err;
+		}
+	}
+
+	ret = 1;
+
+ err:
+	EVP_AEAD_CTX_free(ctx);
+
+	return ret;
+}
+
 static int
 run_cipher_aead_encrypt_test(const EVP_CIPHER *cipher,
     unsigned char bufs[NUM_TYPES][BUF_MAX],
@@ -387,6 +539,284 @@ run_cipher_aead_test(const EVP_CIPHER *cipher,
 	return 1;
 }
 
+static const size_t long_lengths[] = {
+	0, 1, 255, 256, 4095, 4096, 4097, 8191, 16384, 16385, 40000,
+};
+
+#define N_LONG_LENGTHS (sizeof(long_lengths) / sizeof(long_lengths[0]))
+#define LONG_MAX_LEN 40000
+
+static int
+cipher_aead_seal(const EVP_CIPHER *cipher, const unsigned char *key,
+    const unsigned char *nonce, size_t nonce_len, const unsigned char *in,
+    size_t in_len, const unsigned char *ad, size_t ad_len, unsigned char *out,
+    size_t tag_len)
+{
+	EVP_CIPHER_CTX *ctx;
+	int len;
+	int ret = 0;
+
+	if ((ctx = EVP_CIPHER_CTX_new()) == NULL)
+		goto err;
+	if (!EVP_EncryptInit_ex(ctx, cipher, NULL, NULL, NULL))
+		goto err;
+	if (!EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_IVLEN, nonce_len, NULL))
+		goto err;
+	if (!EVP_EncryptInit_ex(ctx, NULL, NULL, key, nonce))
+		goto err;
+	if (!EVP_EncryptUpdate(ctx, NULL, &len, ad, ad_len))
+		goto err;
+	if (!EVP_EncryptUpdate(ctx, out, &len, in, in_len))
+		goto err;
+	if (!EVP_EncryptFinal_ex(ctx, out + len, &len))
+		goto err;
+	if (!EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_GET_TAG, tag_len,
+	    out + in_len))
+		goto err;
+
+	ret = 1;
+
+ err:
+	EVP_CIPHER_CTX_free(ctx);
+
+	return ret;
+}
+
+/*
+ * Compare records that span several of the chunks an AEAD may process at
+ * a time against the EVP_CIPHER implementation of the same algorithm.
+ */
+static int
+run_aead_long_test(const char *name)
+{
+	const EVP_AEAD *aead;
+	const EVP_CIPHER *cipher;
+	unsigned char key[32], nonce[12], ad[13];
+	unsigned char *in, *out, *out2, *want;
+	size_t key_len, nonce_len, tag_len, len, out_len, out_len2;
+	struct iovec iov[3];
+	EVP_AEAD_CTX *ctx = NULL;
+	int iovcnt;
+	size_t i;
+	int ret = 0;
+
+	if (!aead_from_name(&aead, &cipher, name))
+		return 0;
+
+	key_len = EVP_AEAD_key_length(aead);
+	nonce_len = EVP_AEAD_nonce_length(aead);
+	tag_len = EVP_AEAD_max_tag_len(aead);
+
+	if ((in = malloc(LONG_MAX_LEN + tag_len)) == NULL ||
+	    (out = malloc(LONG_MAX_LEN + tag_len)) == NULL ||
+	    (out2 = malloc(LONG_MAX_LEN + tag_len)) == NULL ||
+	    (want = malloc(LONG_MAX_LEN + tag_len)) == NULL) {
+		fprintf(stderr, "FAIL: malloc\n");
+		exit(1);
+	}
+
+	for (i = 0; i < sizeof(key); i++)
+		key[i] = i + 1;
+	for (i = 0; i < sizeof(nonce); i++)
+		nonce[i] = 0x80 + i;
+	for (i = 0; i < sizeof(ad); i++)
+		ad[i] = 0x40 + i;
+
+	if ((ctx = EVP_AEAD_CTX_new()) == NULL) {
+		fprintf(stderr, "FAIL: EVP_AEAD_CTX_new\n");
+		goto err;
+	}
+	if (!EVP_AEAD_CTX_init(ctx, aead, key, key_len, tag_len, NULL)) {
+		fprintf(stderr, "FAIL: EVP_AEAD_CTX_init for %s\n", name);
+		goto err;
+	}
+
+	for (i = 0; i < N_LONG_LENGTHS; i++) {
+		len = long_lengths[i];
+		arc4random_buf(in, len);
+
+		if (!cipher_aead_seal(cipher, key, nonce, nonce_len, in, len,
+		    ad, sizeof(ad), want, tag_len)) {
+			fprintf(stderr, "FAIL: EVP_CIPHER seal for %s with "
+			    "length %zu\n", name, len);
+			goto err;
+		}
+
+		if (!EVP_AEAD_CTX_seal(ctx, out, &out_len, len + tag_len,
+		    nonce, nonce_len, in, len, ad, sizeof(ad))) {
+			fprintf(stderr, "FAIL: seal for %s with length %zu\n",
+			    name, len);
+			goto err;
+		}
+		if (out_len != len + tag_len ||
+		    memcmp(out, want, out_len) != 0) {
+			fprintf(stderr, "FAIL: bad output for %s with length "
+			    "%zu\n", name, len);
+			goto err;
+		}
+
+		/* Segments that do not line up with blocks or chunks. */
+		iovcnt = split_iov(iov, in, len, len / 3 + 1, len / 3 + 7);
+		if (!EVP_AEAD_CTX_seal_iov(ctx, out2, &out_len2,
+		    len + tag_len, nonce, nonce_len, iov, iovcnt, ad,
+		    sizeof(ad)) || out_len2 != out_len ||
+		    memcmp(out2, want, out_len2) != 0) {
+			fprintf(stderr, "FAIL: bad iov output for %s with "
+			    "length %zu\n", name, len);
+			goto err;
+		}
+
+		if (!EVP_AEAD_CTX_open(ctx, out2, &out_len2, len, nonce,
+		    nonce_len, out, out_len, ad, sizeof(ad)) ||
+		    out_len2 != len || memcmp(out2, in, len) != 0) {
+			fprintf(stderr, "FAIL: open for %s with length %zu\n",
+			    name, len);
+			goto err;
+		}
+
+		/* Decrypt in place. */
+		memcpy(out2, out, out_len);
+		if (!EVP_AEAD_CTX_open(ctx, out2, &out_len2, len, nonce,
+		    nonce_len, out2, out_len, ad, sizeof(ad)) ||
+		    out_len2 != len || memcmp(out2, in, len) != 0) {
+			fprintf(stderr, "FAIL: open in place for %s with length "
+			    "%zu\n", name, len);
+			goto err;
+		}
+
+		out[out_len - 1] ^= 0x01;
+		if (EVP_AEAD_CTX_open(ctx, out2, &out_len2, len, nonce,
+		    nonce_len, out, out_len, ad, sizeof(ad))) {
+			fprintf(stderr, "FAIL: opened bad tag for %s with "
+			    "length %zu\n", name, len);
+			goto err;
+		}
+		ERR_clear_error();
+	}
+
+	ret = 1;
+
+ err:
+	EVP_AEAD_CTX_free(ctx);
+	free(in);
+	free(out);
+	free(out2);
+	free(want);
+
+	return ret;
+}
+
+static const char *long_test_aeads[] = {
+	"aes-128-gcm",
+	"aes-256-gcm",
+	"chacha20-poly1305",
+};
+
+#define N_LONG_TEST_AEADS (sizeof(long_test_aeads) / sizeof(long_test_aeads[0]))
+
+static int
+run_aead_long_tests(void)
+{
+	size_t i;
+	int ret = 1;
+
+	for (i = 0; i < N_LONG_TEST_AEADS; i++)
+		ret &= run_aead_long_test(long_test_aeads[i]);
+
+	return ret;
+}
+
+#define BENCHMARK_BYTES		(64 * 1024 * 1024)
+
+static const char *benchmark_aeads[] = {
+	"aes-128-gcm",
+	"aes-256-gcm",
+	"chacha20-poly1305",
+	"xchacha20-poly1305",
+};
+
+static const size_t benchmark_lengths[] = {
+	16, 256, 1350, 8192, 16384,
+};
+
+static void
+benchmark_aead(const char *name, size_t len, int open)
+{
+	const EVP_AEAD *aead;
+	const EVP_CIPHER *cipher;
+	struct timespec start, end, duration;
+	unsigned char key[32] = { 0 }, nonce[24] = { 0 };
+	unsigned char *in, *out;
+	size_t count, i, out_len, sealed_len;
+	EVP_AEAD_CTX *ctx;
+	double secs;
+
+	if (!aead_from_name(&aead, &cipher, name))
+		exit(1);
+
+	if ((in = calloc(1, len + EVP_AEAD_MAX_TAG_LENGTH)) == NULL ||
+	    (out = calloc(1, len + EVP_AEAD_MAX_TAG_LENGTH)) == NULL) {
+		fprintf(stderr, "FAIL: calloc\n");
+		exit(1);
+	}
+	if ((ctx = EVP_AEAD_CTX_new()) == NULL)
+		exit(1);
+	if (!EVP_AEAD_CTX_init(ctx, aead, key, EVP_AEAD_key_length(aead),
+	    EVP_AEAD_DEFAULT_TAG_LENGTH, NULL))
+		exit(1);
+
+	if (!EVP_AEAD_CTX_seal(ctx, in, &sealed_len,
+	    len + EVP_AEAD_MAX_TAG_LENGTH, nonce, EVP_AEAD_nonce_length(aead),
+	    out, len, NULL, 0))
+		exit(1);
+
+	count = BENCHMARK_BYTES / len;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < count; i++) {
+		if (open) {
+			if (!EVP_AEAD_CTX_open(ctx, out, &out_len, len, nonce,
+			    EVP_AEAD_nonce_length(aead), in, sealed_len,
+			    NULL, 0))
+				exit(1);
+		} else {
+			if (!EVP_AEAD_CTX_seal(ctx, out, &out_len,
+			    len + EVP_AEAD_MAX_TAG_LENGTH, nonce,
+			    EVP_AEAD_nonce_length(aead), in, len, NULL, 0))
+				exit(1);
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	timespecsub(&end, &start, &duration);
+	secs = duration.tv_sec + duration.tv_nsec / 1000000000.0;
+
+	fprintf(stderr, "%-18s %s %5zu bytes: %zu records in %f seconds, "
+	    "%.1f MB/s\n", name, open ? "open" : "seal", len, count, secs,
+	    count * len / secs / 1000000);
+
+	EVP_AEAD_CTX_free(ctx);
+	free(in);
+	free(out);
+}
+
+static void
+benchmark(void)
+{
+	size_t i, j;
+
+	for (i = 0; i < sizeof(benchmark_aeads) / sizeof(benchmark_aeads[0]);
+	    i++) {
+		for (j = 0; j < sizeof(benchmark_lengths) /
+		    sizeof(benchmark_lengths[0]); j++) {
+			benchmark_aead(benchmark_aeads[i],
+			    benchmark_lengths[j], 0);
+			benchmark_aead(benchmark_aeads[i],
+			    benchmark_lengths[j], 1);
+		}
+	}
+}
+
 int
 main(int argc, char **argv)
 {
@@ -398,8 +828,19 @@ main(int argc, char **argv)
 	unsigned int lengths[NUM_TYPES];
 	const char *aeadname;
 
+	if (argc == 2 && strcmp(argv[1], "--long") == 0)
+		return run_aead_long_tests() ? 0 : 1;
+
+	if (argc == 2 && strcmp(argv[1], "--benchmark") == 0) {
+		if (!run_aead_long_tests())
+			return 1;
+		benchmark();
+		return 0;
+	}
+
 	if (argc != 3) {
 		fprintf(stderr, "%s <aead> <test file.txt>\n", argv[0]);
+		fprintf(stderr, "%s --long | --benchmark\n", argv[0]);
 		return 1;
 	}
 
@@ -451,6 +892,9 @@ main(int argc, char **argv)
 				if (!run_aead_test(aead, bufs, lengths,
 				    line_no))
 					return 4;
+				if (!run_aead_iov_test(aead, bufs, lengths,
+				    line_no))
+					return 4;
 			}
 			if (cipher != NULL) {
 				if (!run_cipher_aead_test(cipher, bufs, lengths,
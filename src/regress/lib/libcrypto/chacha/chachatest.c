@@ -15,10 +15,14 @@
  * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  */
 
+#include <sys/time.h>
+
 #include <err.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 #include <openssl/chacha.h>
 
@@ -456,13 +460,164 @@ crypto_xchacha_20_test(void)
 	return (failed);
 }
 
+#define LENGTHS_MAX	2112
+
+/*
+ * Compare CRYPTO_chacha_20 and ChaCha for all lengths up to LENGTHS_MAX
+ * against a keystream produced one byte at a time, which exercises both
+ * the multi-block and the single block code, including counters that
+ * wrap the low 32 bits.
+ */
+static int
+crypto_chacha_20_lengths_test(void)
+{
+	static const uint64_t counters[] = {
+		0, 1, 0xfffffff0, 0xfffffffd, 0x1ffffffff,
+	};
+	unsigned char key[32], iv[8], ctr[8];
+	unsigned char *in, *out, *want;
+	ChaCha_ctx ctx;
+	uint64_t counter;
+	size_t i, j, len;
+	int failed = 0;
+
+	if ((in = malloc(LENGTHS_MAX)) == NULL)
+		errx(1, "malloc in");
+	if ((out = malloc(LENGTHS_MAX)) == NULL)
+		errx(1, "malloc out");
+	if ((want = malloc(LENGTHS_MAX)) == NULL)
+		errx(1, "malloc want");
+
+	for (i = 0; i < sizeof(key); i++)
+		key[i] = i;
+	for (i = 0; i < sizeof(iv); i++)
+		iv[i] = 0xf0 + i;
+	for (i = 0; i < LENGTHS_MAX; i++)
+		in[i] = i * 7;
+
+	for (i = 0; i < sizeof(counters) / sizeof(counters[0]); i++) {
+		counter = counters[i];
+		for (j = 0; j < sizeof(ctr); j++)
+			ctr[j] = counter >> (8 * j);
+
+		ChaCha_set_key(&ctx, key, 256);
+		ChaCha_set_iv(&ctx, iv, ctr);
+		for (j = 0; j < LENGTHS_MAX; j++)
+			ChaCha(&ctx, want + j, in + j, 1);
+
+		for (len = 0; len <= LENGTHS_MAX; len++) {
+			memset(out, 0, LENGTHS_MAX);
+			CRYPTO_chacha_20(out, in, len, key, iv, counter);
+			if (memcmp(out, want, len) != 0) {
+				printf("CRYPTO_chacha_20 failed with counter "
+				    "%llx and length %zu\n",
+				    (unsigned long long)counter, len);
+				failed = 1;
+				break;
+			}
+
+			/* Start at an offset within a block. */
+			memset(out, 0, LENGTHS_MAX);
+			ChaCha_set_key(&ctx, key, 256);
+			ChaCha_set_iv(&ctx, iv, ctr);
+			j = len < 3 ? len : 3;
+			ChaCha(&ctx, out, in, j);
+			ChaCha(&ctx, out + j, in + j, len - j);
+			if (memcmp(out, want, len) != 0) {
+				printf("ChaCha failed with counter %llx and "
+				    "length %zu\n", (unsigned long long)counter,
+				    len);
+				failed = 1;
+				break;
+			}
+		}
+	}
+
+	free(in);
+	free(out);
+	free(want);
+
+	return failed;
+}
+
+#define OVERLAP_LEN	4000
+
+/* Output may overlap the input, as long as it does not start after it. */
+static int
+crypto_chacha_20_overlap_test(void)
+{
+	unsigned char key[32] = { 1 }, iv[8] = { 2 };
+	unsigned char *buf, *want;
+	size_t i, off;
+	int failed = 0;
+
+	if ((buf = malloc(OVERLAP_LEN + 64)) == NULL)
+		errx(1, "malloc buf");
+	if ((want = malloc(OVERLAP_LEN)) == NULL)
+		errx(1, "malloc want");
+
+	for (off = 0; off < 64; off++) {
+		for (i = 0; i < OVERLAP_LEN + 64; i++)
+			buf[i] = i * 7;
+		CRYPTO_chacha_20(want, buf + off, OVERLAP_LEN, key, iv, 0);
+		CRYPTO_chacha_20(buf, buf + off, OVERLAP_LEN, key, iv, 0);
+		if (memcmp(buf, want, OVERLAP_LEN) != 0) {
+			printf("CRYPTO_chacha_20 failed with output %zu bytes "
+			    "before input\n", off);
+			failed = 1;
+		}
+	}
+
+	free(buf);
+	free(want);
+
+	return failed;
+}
+
+#define BENCHMARK_BYTES		(64 * 1024 * 1024)
+
+static void
+benchmark(void)
+{
+	static const size_t sizes[] = { 64, 256, 1024, 8192, 16384 };
+	struct timespec start, end, duration;
+	unsigned char key[32] = { 0 }, iv[8] = { 0 };
+	unsigned char *buf;
+	size_t i, n, count;
+	double secs;
+
+	if ((buf = calloc(1, sizes[4])) == NULL)
+		errx(1, "calloc");
+
+	for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+		count = BENCHMARK_BYTES / sizes[i];
+
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		for (n = 0; n < count; n++)
+			CRYPTO_chacha_20(buf, buf, sizes[i], key, iv, n);
+		clock_gettime(CLOCK_MONOTONIC, &end);
+
+		timespecsub(&end, &start, &duration);
+		secs = duration.tv_sec + duration.tv_nsec / 1000000000.0;
+
+		fprintf(stderr, "chacha20 %5zu bytes: %zu operations in %f "
+		    "seconds, %.1f MB/s\n", sizes[i], count, secs,
+		    count * sizes[i] / secs / 1000000);
+	}
+
+	free(buf);
+}
+
 int
 main(int argc, char **argv)
 {
 	struct chacha_tv *tv;
 	unsigned char *in, *out;
 	size_t i, j, k;
-	int failed = 0;
+	int benchmark_mode = 0, failed = 0;
+
+	if (argc == 2 && strcmp(argv[1], "--benchmark") == 0)
+		benchmark_mode = 1;
 
 	for (i = 0; i < N_VECTORS; i++) {
 		tv = &chacha_test_vectors[i];
@@ -505,5 +660,14 @@ main(int argc, char **argv)
 	if (crypto_xchacha_20_test() != 0)
 		failed = 1;
 
+	if (crypto_chacha_20_lengths_test() != 0)
+		failed = 1;
+
+	if (crypto_chacha_20_overlap_test() != 0)
+		failed = 1;
+
+	if (benchmark_mode && !failed)
+		benchmark();
+
 	return failed;
 }
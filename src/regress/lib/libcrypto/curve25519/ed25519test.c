@@ -15,10 +15,13 @@
  * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  */
 
+#include <sys/time.h>
+
 #include <err.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 #include <openssl/curve25519.h>
 
@@ -461,6 +464,336 @@ test_ED25519_signature_malleability(void)
 	return failed;
 }
 
+#define BATCH_TEST_NUM	150
+
+struct batch {
+	uint8_t (*public_keys)[ED25519_PUBLIC_KEY_LENGTH];
+	uint8_t (*signatures)[ED25519_SIGNATURE_LENGTH];
+	uint8_t (*messages)[32];
+	const uint8_t **public_key_ptrs;
+	const uint8_t **signature_ptrs;
+	const uint8_t **message_ptrs;
+	size_t *message_lens;
+	int *valid;
+	size_t num;
+};
+
+static void
+batch_init(struct batch *b, size_t num)
+{
+	uint8_t private_key[ED25519_PRIVATE_KEY_LENGTH];
+	size_t i;
+
+	memset(b, 0, sizeof(*b));
+	b->num = num;
+
+	if ((b->public_keys = calloc(num, sizeof(*b->public_keys))) == NULL ||
+	    (b->signatures = calloc(num, sizeof(*b->signatures))) == NULL ||
+	    (b->messages = calloc(num, sizeof(*b->messages))) == NULL ||
+	    (b->public_key_ptrs = calloc(num, sizeof(uint8_t *))) == NULL ||
+	    (b->signature_ptrs = calloc(num, sizeof(uint8_t *))) == NULL ||
+	    (b->message_ptrs = calloc(num, sizeof(uint8_t *))) == NULL ||
+	    (b->message_lens = calloc(num, sizeof(size_t))) == NULL ||
+	    (b->valid = calloc(num, sizeof(int))) == NULL)
+		err(1, NULL);
+
+	for (i = 0; i < num; i++) {
+		ED25519_keypair(b->public_keys[i], private_key);
+		arc4random_buf(b->messages[i], sizeof(b->messages[i]));
+		b->message_lens[i] = i % (sizeof(b->messages[i]) + 1);
+		if (!ED25519_sign(b->signatures[i], b->messages[i],
+		    b->message_lens[i], b->public_keys[i], private_key))
+			errx(1, "ED25519_sign");
+		b->public_key_ptrs[i] = b->public_keys[i];
+		b->signature_ptrs[i] = b->signatures[i];
+		b->message_ptrs[i] = b->messages[i];
+	}
+}
+
+static void
+batch_free(struct batch *b)
+{
+	free(b->public_keys);
+	free(b->signatures);
+	free(b->messages);
+	free(b->public_key_ptrs);
+	free(b->signature_ptrs);
+	free(b->message_ptrs);
+	free(b->message_lens);
+	free(b->valid);
+}
+
+/* Check the batch result against ED25519_verify for every signature. */
+static int
+check_batch(struct batch *b, const char *desc)
+{
+	size_t i;
+	int all_valid = 1, ret, valid;
+	int failed = 0;
+
+	memset(b->valid, 0xff, b->num * sizeof(int));
+
+	ret = ED25519_verify_batch(b->message_ptrs, b->message_lens,
+	    b->signature_ptrs, b->public_key_ptrs, b->num, b->valid);
+
+	for (i = 0; i < b->num; i++) {
+		valid = ED25519_verify(b->message_ptrs[i], b->message_lens[i],
+		    b->signature_ptrs[i], b->public_key_ptrs[i]);
+		if (b->valid[i] != valid) {
+			fprintf(stderr, "FAIL: %s: signature %zu is %d, "
+			    "want %d\n", desc, i, b->valid[i], valid);
+			failed = 1;
+		}
+		all_valid &= valid;
+	}
+	if (ret != all_valid) {
+		fprintf(stderr, "FAIL: %s: returned %d, want %d\n", desc, ret,
+		    all_valid);
+		failed = 1;
+	}
+	if (ED25519_verify_batch(b->message_ptrs, b->message_lens,
+	    b->signature_ptrs, b->public_key_ptrs, b->num, NULL) != all_valid) {
+		fprintf(stderr, "FAIL: %s: result differs without out_valid\n",
+		    desc);
+		failed = 1;
+	}
+
+	return failed;
+}
+
+static int
+test_ED25519_verify_batch(void)
+{
+	struct batch b;
+	size_t i;
+	int failed = 0;
+
+	batch_init(&b, BATCH_TEST_NUM);
+
+	failed |= check_batch(&b, "valid");
+
+	b.num = 0;
+	if (ED25519_verify_batch(NULL, NULL, NULL, NULL, 0, NULL) != 1) {
+		fprintf(stderr, "FAIL: empty batch\n");
+		failed = 1;
+	}
+	b.num = 1;
+	failed |= check_batch(&b, "single");
+	b.num = BATCH_TEST_NUM;
+
+	/* Invalid signatures in different chunks and positions. */
+	b.messages[3][0] ^= 1;
+	if (b.message_lens[3] == 0)
+		b.message_lens[3] = 1;
+	modify_signature(b.signatures[64]);
+	b.signatures[65][0] ^= 0x40;
+	b.signatures[66][40] ^= 0x01;
+	b.public_key_ptrs[127] = b.public_keys[128];
+	b.signatures[149][63] |= 0x80;
+	failed |= check_batch(&b, "invalid");
+
+	/* All signatures in a chunk invalid. */
+	for (i = 0; i < BATCH_TEST_NUM; i++)
+		b.signatures[i][10] ^= 0x20;
+	failed |= check_batch(&b, "all invalid");
+
+	batch_free(&b);
+
+	/* The RFC 8032 test vectors as a single batch. */
+	batch_init(&b, num_testvectors);
+	for (i = 0; i < num_testvectors; i++) {
+		b.public_key_ptrs[i] = testvectors[i].pub_key;
+		b.signature_ptrs[i] = testvectors[i].signature;
+		b.message_ptrs[i] = testvectors[i].message;
+		b.message_lens[i] = testvectors[i].message_len;
+	}
+	failed |= check_batch(&b, "test vectors");
+	batch_free(&b);
+
+	return failed;
+}
+
+/*
+ * Signatures that only pass the cofactored verification equation, since
+ * R = r * B + T or A = a * B + T for a point T of order 8.
+ */
+static const struct torsion_testvector {
+	const char *desc;
+	const uint8_t pub_key[ED25519_PUBLIC_KEY_LENGTH];
+	const uint8_t message[32];
+	const uint8_t signature[ED25519_SIGNATURE_LENGTH];
+} torsion_testvectors[] = {
+	{
+		.desc = "R with a point of order 8 added",
+		.pub_key = {
+			0x88, 0xe6, 0xe1, 0x6b, 0xb7, 0x2f, 0x09, 0xb7,
+			0x86, 0x8e, 0xab, 0xd3, 0xd1, 0xcf, 0x23, 0xaf,
+			0x48, 0xd8, 0x92, 0x33, 0x56, 0xd4, 0xc2, 0xb2,
+			0x68, 0x1f, 0x90, 0x39, 0x61, 0xcd, 0x76, 0x8d,
+		},
+		.message = {
+			0x06, 0x08, 0xad, 0xe3, 0x35, 0x9a, 0xeb, 0x42,
+			0x4a, 0xa7, 0x24, 0x1a, 0x81, 0xc2, 0x1d, 0x61,
+			0xe4, 0x9c, 0x88, 0xde, 0xbe, 0xaf, 0xbf, 0x81,
+			0xae, 0x4c, 0xf1, 0x32, 0x97, 0x6a, 0xe7, 0x80,
+		},
+		.signature = {
+			0xb8, 0x0d, 0xa8, 0x54, 0xd5, 0x10, 0xc5, 0xf5,
+			0x0e, 0x49, 0x69, 0x4f, 0x43, 0x3b, 0x8d, 0x0f,
+			0x67, 0xc9, 0x72, 0xdb, 0x67, 0xbe, 0x10, 0xe7,
+			0xde, 0xbc, 0x63, 0x84, 0x9e, 0x75, 0xde, 0x11,
+			0x76, 0x94, 0x21, 0xad, 0xcd, 0xc0, 0xe4, 0x0c,
+			0xb6, 0x05, 0x49, 0xe7, 0x91, 0xe6, 0x2a, 0x25,
+			0x59, 0xe9, 0xbd, 0x09, 0x3a, 0x94, 0x32, 0xad,
+			0x8a, 0xeb, 0x68, 0xfc, 0xdc, 0xda, 0x81, 0x01,
+		},
+	},
+	{
+		.desc = "public key with a point of order 8 added",
+		.pub_key = {
+			0xa5, 0x27, 0xf4, 0xbb, 0x4e, 0xed, 0x47, 0xf9,
+			0x4c, 0x26, 0x86, 0x81, 0xb2, 0x6b, 0xa4, 0xa6,
+			0x50, 0x01, 0x7a, 0x03, 0xd6, 0xdc, 0x2e, 0xdf,
+			0x39, 0x95, 0x88, 0x50, 0x51, 0xf1, 0x81, 0xe8,
+		},
+		.message = {
+			0xf9, 0x4d, 0xf5, 0x19, 0xf7, 0x75, 0x97, 0x06,
+			0xc4, 0x79, 0xa9, 0xcf, 0x18, 0xd8, 0xa0, 0x22,
+			0x42, 0xdd, 0xdd, 0xe8, 0x19, 0x20, 0x75, 0x35,
+			0xe9, 0x96, 0x6a, 0x8b, 0x50, 0x26, 0x09, 0x45,
+		},
+		.signature = {
+			0x63, 0xd1, 0xf0, 0xee, 0xdf, 0x6c, 0xd9, 0x97,
+			0x7c, 0xb3, 0x25, 0x3c, 0x0f, 0x20, 0xda, 0xe5,
+			0xf3, 0xd1, 0xdf, 0xce, 0x3d, 0xcd, 0x79, 0x27,
+			0x1e, 0xfd, 0x1c, 0xd9, 0x66, 0x51, 0x4f, 0x80,
+			0x62, 0x97, 0xa2, 0x3c, 0x50, 0x8d, 0xe4, 0x17,
+			0xfb, 0x34, 0x5c, 0x6a, 0x0b, 0x96, 0x3a, 0xc8,
+			0x53, 0x0a, 0x1f, 0xf0, 0x07, 0x0a, 0xb3, 0x9c,
+			0x8b, 0xdc, 0xa9, 0x3a, 0x44, 0xd1, 0x0c, 0x03,
+		},
+	},
+};
+
+#define N_TORSION_TESTVECTORS \
+    (sizeof(torsion_testvectors) / sizeof(torsion_testvectors[0]))
+
+static int
+check_batch_torsion(struct batch *b, size_t idx, int want, const char *desc,
+    const char *batch_desc)
+{
+	int failed = 0;
+	int ret;
+
+	memset(b->valid, 0xff, b->num * sizeof(int));
+
+	ret = ED25519_verify_batch(b->message_ptrs, b->message_lens,
+	    b->signature_ptrs, b->public_key_ptrs, b->num, b->valid);
+
+	if (b->valid[idx] != 1) {
+		fprintf(stderr, "FAIL: %s %s: signature is %d, want 1\n",
+		    desc, batch_desc, b->valid[idx]);
+		failed = 1;
+	}
+	if (ret != want) {
+		fprintf(stderr, "FAIL: %s %s: returned %d, want %d\n",
+		    desc, batch_desc, ret, want);
+		failed = 1;
+	}
+
+	return failed;
+}
+
+/*
+ * ED25519_verify rejects these signatures, but the batch accepts them no
+ * matter which other signatures are part of the batch.
+ */
+static int
+test_ED25519_verify_batch_torsion(void)
+{
+	const struct torsion_testvector *tv;
+	struct batch b;
+	size_t i, idx = 5;
+	int failed = 0;
+
+	for (i = 0; i < N_TORSION_TESTVECTORS; i++) {
+		tv = &torsion_testvectors[i];
+
+		if (ED25519_verify(tv->message, sizeof(tv->message),
+		    tv->signature, tv->pub_key)) {
+			fprintf(stderr, "FAIL: %s: ED25519_verify succeeded\n",
+			    tv->desc);
+			failed = 1;
+		}
+
+		batch_init(&b, 10);
+		b.public_key_ptrs[idx] = tv->pub_key;
+		b.signature_ptrs[idx] = tv->signature;
+		b.message_ptrs[idx] = tv->message;
+		b.message_lens[idx] = sizeof(tv->message);
+
+		b.public_key_ptrs[0] = tv->pub_key;
+		b.signature_ptrs[0] = tv->signature;
+		b.message_ptrs[0] = tv->message;
+		b.message_lens[0] = sizeof(tv->message);
+		b.num = 1;
+		failed |= check_batch_torsion(&b, 0, 1, tv->desc, "alone");
+		b.num = 10;
+
+		b.public_key_ptrs[0] = b.public_keys[0];
+		b.signature_ptrs[0] = b.signatures[0];
+		b.message_ptrs[0] = b.messages[0];
+		b.message_lens[0] = 0;
+		failed |= check_batch_torsion(&b, idx, 1, tv->desc,
+		    "with valid signatures");
+
+		b.signatures[2][40] ^= 0x01;
+		failed |= check_batch_torsion(&b, idx, 0, tv->desc,
+		    "with an invalid signature");
+
+		batch_free(&b);
+	}
+
+	return failed;
+}
+
+#define BENCHMARK_NUM	1000
+
+static void
+benchmark(void)
+{
+	struct timespec start, end, duration;
+	struct batch b;
+	double secs;
+	size_t i;
+
+	batch_init(&b, BENCHMARK_NUM);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < b.num; i++) {
+		if (!ED25519_verify(b.message_ptrs[i], b.message_lens[i],
+		    b.signature_ptrs[i], b.public_key_ptrs[i]))
+			errx(1, "ED25519_verify");
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	timespecsub(&end, &start, &duration);
+	secs = duration.tv_sec + duration.tv_nsec / 1000000000.0;
+	fprintf(stderr, "ED25519_verify:       %zu in %f seconds, %.0f/s\n",
+	    b.num, secs, b.num / secs);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	if (!ED25519_verify_batch(b.message_ptrs, b.message_lens,
+	    b.signature_ptrs, b.public_key_ptrs, b.num, b.valid))
+		errx(1, "ED25519_verify_batch");
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	timespecsub(&end, &start, &duration);
+	secs = duration.tv_sec + duration.tv_nsec / 1000000000.0;
+	fprintf(stderr, "ED25519_verify_batch: %zu in %f seconds, %.0f/s\n",
+	    b.num, secs, b.num / secs);
+
+	batch_free(&b);
+}
+
 int
 main(int argc, char *argv[])
 {
@@ -469,6 +802,11 @@ main(int argc, char *argv[])
 	failed |= test_ED25519_verify();
 	failed |= test_ED25519_sign();
 	failed |= test_ED25519_signature_malleability();
+	failed |= test_ED25519_verify_batch();
+	failed |= test_ED25519_verify_batch_torsion();
+
+	if (argc == 2 && strcmp(argv[1], "--benchmark") == 0 && !failed)
+		benchmark();
 
 	return failed;
 }
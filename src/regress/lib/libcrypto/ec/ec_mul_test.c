@@ -0,0 +1,551 @@
+/* $OpenBSD$ */
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <sys/time.h>
+
+#include <err.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include <openssl/ecdsa.h>
+#include <openssl/objects.h>
+
+#define N_RANDOM_SCALARS	20
+
+static const int test_nids[] = {
+	NID_X9_62_prime256v1,
+	NID_secp384r1,
+};
+
+#define N_TEST_NIDS (sizeof(test_nids) / sizeof(test_nids[0]))
+
+/*
+ * Compare scalar * generator computed by EC_POINT_mul() with the generator
+ * passed in as a generic point, which never uses precomputed tables.
+ */
+static int
+check_mul_generator(const EC_GROUP *group, const BIGNUM *scalar,
+    const char *name, BN_CTX *ctx)
+{
+	const EC_POINT *generator;
+	EC_POINT *p = NULL, *q = NULL;
+	int failed = 1;
+
+	if ((generator = EC_GROUP_get0_generator(group)) == NULL)
+		errx(1, "EC_GROUP_get0_generator");
+	if ((p = EC_POINT_new(group)) == NULL)
+		errx(1, "EC_POINT_new");
+	if ((q = EC_POINT_new(group)) == NULL)
+		errx(1, "EC_POINT_new");
+
+	if (!EC_POINT_mul(group, p, scalar, NULL, NULL, ctx)) {
+		fprintf(stderr, "FAIL: %s: EC_POINT_mul generator\n", name);
+		goto failure;
+	}
+	if (!EC_POINT_mul(group, q, NULL, generator, scalar, ctx)) {
+		fprintf(stderr, "FAIL: %s: EC_POINT_mul point\n", name);
+		goto failure;
+	}
+	if (EC_POINT_cmp(group, p, q, ctx) != 0) {
+		fprintf(stderr, "FAIL: %s: scalar ", name);
+		BN_print_fp(stderr, scalar);
+		fprintf(stderr, " gives different points\n");
+		goto failure;
+	}
+	if (!EC_POINT_is_at_infinity(group, p) &&
+	    EC_POINT_is_on_curve(group, p, ctx) <= 0) {
+		fprintf(stderr, "FAIL: %s: result not on curve\n", name);
+		goto failure;
+	}
+
+	failed = 0;
+
+ failure:
+	EC_POINT_free(p);
+	EC_POINT_free(q);
+
+	return failed;
+}
+
+static int
+test_mul_generator_group(const EC_GROUP *group, const char *name,
+    BN_CTX *ctx)
+{
+	BIGNUM *k, *order;
+	int bits, i;
+	int failed = 0;
+
+	if ((k = BN_new()) == NULL)
+		errx(1, "BN_new");
+	if ((order = BN_new()) == NULL)
+		errx(1, "BN_new");
+	if (!EC_GROUP_get_order(group, order, ctx))
+		errx(1, "EC_GROUP_get_order");
+	bits = BN_num_bits(order);
+
+	/* Small scalars. */
+	for (i = 0; i < 64; i++) {
+		if (!BN_set_word(k, i))
+			errx(1, "BN_set_word");
+		failed |= check_mul_generator(group, k, name, ctx);
+	}
+
+	/* Powers of two and their neighbours up to twice the order. */
+	for (i = 0; i <= bits + 1; i++) {
+		BN_zero(k);
+		if (!BN_set_bit(k, i))
+			errx(1, "BN_set_bit");
+		failed |= check_mul_generator(group, k, name, ctx);
+		if (!BN_sub_word(k, 1))
+			errx(1, "BN_sub_word");
+		failed |= check_mul_generator(group, k, name, ctx);
+	}
+
+	/* Scalars around the order, negative and oversized scalars. */
+	for (i = -3; i <= 3; i++) {
+		if (!BN_copy(k, order))
+			errx(1, "BN_copy");
+		if (i < 0 && !BN_sub_word(k, -i))
+			errx(1, "BN_sub_word");
+		if (i > 0 && !BN_add_word(k, i))
+			errx(1, "BN_add_word");
+		failed |= check_mul_generator(group, k, name, ctx);
+		BN_set_negative(k, 1);
+		failed |= check_mul_generator(group, k, name, ctx);
+	}
+	if (!BN_rand(k, 2 * bits, BN_RAND_TOP_ANY, BN_RAND_BOTTOM_ANY))
+		errx(1, "BN_rand");
+	failed |= check_mul_generator(group, k, name, ctx);
+
+	/* Random scalars with bits set in every column. */
+	for (i = 0; i < N_RANDOM_SCALARS; i++) {
+		if (!BN_rand_range(k, order))
+			errx(1, "BN_rand_range");
+		failed |= check_mul_generator(group, k, name, ctx);
+	}
+
+	BN_free(k);
+	BN_free(order);
+
+	return failed;
+}
+
+static int
+test_mul_generator(void)
+{
+	EC_GROUP *group = NULL, *dup = NULL, *explicit = NULL;
+	EC_POINT *generator = NULL;
+	BIGNUM *p, *a, *b, *k, *order, *cofactor;
+	BN_CTX *ctx;
+	const char *name;
+	size_t i;
+	int failed = 0;
+
+	if ((ctx = BN_CTX_new()) == NULL)
+		errx(1, "BN_CTX_new");
+	if ((p = BN_new()) == NULL || (a = BN_new()) == NULL ||
+	    (b = BN_new()) == NULL || (k = BN_new()) == NULL ||
+	    (order = BN_new()) == NULL || (cofactor = BN_new()) == NULL)
+		errx(1, "BN_new");
+
+	for (i = 0; i < N_TEST_NIDS; i++) {
+		name = OBJ_nid2sn(test_nids[i]);
+
+		if ((group = EC_GROUP_new_by_curve_name(test_nids[i])) == NULL)
+			errx(1, "EC_GROUP_new_by_curve_name");
+		failed |= test_mul_generator_group(group, name, ctx);
+
+		if (!EC_GROUP_get_order(group, order, ctx))
+			errx(1, "EC_GROUP_get_order");
+		if (!EC_GROUP_get_cofactor(group, cofactor, ctx))
+			errx(1, "EC_GROUP_get_cofactor");
+
+		if ((dup = EC_GROUP_dup(group)) == NULL)
+			errx(1, "EC_GROUP_dup");
+		failed |= test_mul_generator_group(dup, name, ctx);
+		EC_GROUP_free(dup);
+		dup = NULL;
+
+		/* The same curve from explicit parameters. */
+		if (!EC_GROUP_get_curve(group, p, a, b, ctx))
+			errx(1, "EC_GROUP_get_curve");
+		if ((explicit = EC_GROUP_new_curve_GFp(p, a, b, ctx)) == NULL)
+			errx(1, "EC_GROUP_new_curve_GFp");
+		if (!EC_GROUP_set_generator(explicit,
+		    EC_GROUP_get0_generator(group), order, cofactor))
+			errx(1, "EC_GROUP_set_generator");
+		failed |= test_mul_generator_group(explicit, name, ctx);
+
+		/* A different generator on a named group. */
+		if ((generator = EC_POINT_new(group)) == NULL)
+			errx(1, "EC_POINT_new");
+		if (!BN_set_word(k, 3))
+			errx(1, "BN_set_word");
+		if (!EC_POINT_mul(group, generator, k, NULL, NULL, ctx))
+			errx(1, "EC_POINT_mul");
+		if (!EC_GROUP_set_generator(group, generator, order, cofactor))
+			errx(1, "EC_GROUP_set_generator");
+		failed |= test_mul_generator_group(group, name, ctx);
+
+		EC_POINT_free(generator);
+		generator = NULL;
+		EC_GROUP_free(explicit);
+		explicit = NULL;
+		EC_GROUP_free(group);
+		group = NULL;
+	}
+
+	BN_free(p);
+	BN_free(a);
+	BN_free(b);
+	BN_free(k);
+	BN_free(order);
+	BN_free(cofactor);
+	BN_CTX_free(ctx);
+
+	return failed;
+}
+
+/*
+ * Compare two points from groups with different methods, which
+ * EC_POINT_cmp() does not support, by their affine coordinates.
+ */
+static int
+check_points_equal(const EC_GROUP *group_a, const EC_POINT *a,
+    const EC_GROUP *group_b, const EC_POINT *b, const char *desc, BN_CTX *ctx)
+{
+	BIGNUM *ax, *ay, *bx, *by;
+	int a_inf, b_inf;
+	int failed = 1;
+
+	BN_CTX_start(ctx);
+	if ((ax = BN_CTX_get(ctx)) == NULL || (ay = BN_CTX_get(ctx)) == NULL ||
+	    (bx = BN_CTX_get(ctx)) == NULL || (by = BN_CTX_get(ctx)) == NULL)
+		errx(1, "BN_CTX_get");
+
+	a_inf = EC_POINT_is_at_infinity(group_a, a);
+	b_inf = EC_POINT_is_at_infinity(group_b, b);
+	if (a_inf || b_inf) {
+		if (a_inf != b_inf) {
+			fprintf(stderr, "FAIL: %s: only one point is at "
+			    "infinity\n", desc);
+			goto failure;
+		}
+		failed = 0;
+		goto failure;
+	}
+
+	if (!EC_POINT_get_affine_coordinates(group_a, a, ax, ay, ctx))
+		errx(1, "EC_POINT_get_affine_coordinates");
+	if (!EC_POINT_get_affine_coordinates(group_b, b, bx, by, ctx))
+		errx(1, "EC_POINT_get_affine_coordinates");
+	if (BN_cmp(ax, bx) != 0 || BN_cmp(ay, by) != 0) {
+		fprintf(stderr, "FAIL: %s: points differ\n", desc);
+		goto failure;
+	}
+	if (EC_POINT_is_on_curve(group_a, a, ctx) <= 0) {
+		fprintf(stderr, "FAIL: %s: result not on curve\n", desc);
+		goto failure;
+	}
+
+	failed = 0;
+
+ failure:
+	BN_CTX_end(ctx);
+
+	return failed;
+}
+
+/*
+ * Check generator, single point and double point multiplication of the
+ * dedicated P-256 method against the same curve using the Montgomery method.
+ */
+static int
+check_p256_mul(const EC_GROUP *group, const EC_GROUP *mont,
+    const BIGNUM *g_scalar, const BIGNUM *p_scalar, const BIGNUM *p_log,
+    BN_CTX *ctx)
+{
+	EC_POINT *point = NULL, *mont_point = NULL, *r = NULL, *mont_r = NULL;
+	int failed = 0;
+
+	if ((point = EC_POINT_new(group)) == NULL ||
+	    (mont_point = EC_POINT_new(mont)) == NULL ||
+	    (r = EC_POINT_new(group)) == NULL ||
+	    (mont_r = EC_POINT_new(mont)) == NULL)
+		errx(1, "EC_POINT_new");
+
+	/* The point is p_log * generator, computed with the other method. */
+	if (!EC_POINT_mul(mont, mont_point, p_log, NULL, NULL, ctx))
+		errx(1, "EC_POINT_mul");
+	if (!EC_POINT_mul(group, point, p_log, NULL, NULL, ctx))
+		errx(1, "EC_POINT_mul");
+	failed |= check_points_equal(group, point, mont, mont_point,
+	    "p256 generator", ctx);
+
+	if (!EC_POINT_mul(group, r, NULL, point, p_scalar, ctx))
+		errx(1, "EC_POINT_mul");
+	if (!EC_POINT_mul(mont, mont_r, NULL, mont_point, p_scalar, ctx))
+		errx(1, "EC_POINT_mul");
+	failed |= check_points_equal(group, r, mont, mont_r, "p256 point", ctx);
+
+	if (!EC_POINT_mul(group, r, g_scalar, point, p_scalar, ctx))
+		errx(1, "EC_POINT_mul");
+	if (!EC_POINT_mul(mont, mont_r, g_scalar, mont_point, p_scalar, ctx))
+		errx(1, "EC_POINT_mul");
+	failed |= check_points_equal(group, r, mont, mont_r, "p256 double",
+	    ctx);
+
+	EC_POINT_free(point);
+	EC_POINT_free(mont_point);
+	EC_POINT_free(r);
+	EC_POINT_free(mont_r);
+
+	return failed;
+}
+
+static int
+test_p256_method(void)
+{
+	EC_GROUP *group = NULL, *mont = NULL;
+	EC_POINT *generator = NULL;
+	BIGNUM *p, *a, *b, *order, *cofactor, *g_scalar, *p_scalar, *p_log;
+	BN_CTX *ctx;
+	int i;
+	int failed = 0;
+
+	if ((ctx = BN_CTX_new()) == NULL)
+		errx(1, "BN_CTX_new");
+	if ((p = BN_new()) == NULL || (a = BN_new()) == NULL ||
+	    (b = BN_new()) == NULL || (order = BN_new()) == NULL ||
+	    (cofactor = BN_new()) == NULL || (g_scalar = BN_new()) == NULL ||
+	    (p_scalar = BN_new()) == NULL || (p_log = BN_new()) == NULL)
+		errx(1, "BN_new");
+
+	if ((group = EC_GROUP_new_by_curve_name(NID_X9_62_prime256v1)) == NULL)
+		errx(1, "EC_GROUP_new_by_curve_name");
+	if (!EC_GROUP_get_curve(group, p, a, b, ctx))
+		errx(1, "EC_GROUP_get_curve");
+	if (!EC_GROUP_get_order(group, order, ctx))
+		errx(1, "EC_GROUP_get_order");
+	if (!EC_GROUP_get_cofactor(group, cofactor, ctx))
+		errx(1, "EC_GROUP_get_cofactor");
+
+	if ((mont = EC_GROUP_new(EC_GFp_mont_method())) == NULL)
+		errx(1, "EC_GROUP_new");
+	if (!EC_GROUP_set_curve(mont, p, a, b, ctx))
+		errx(1, "EC_GROUP_set_curve");
+	if ((generator = EC_POINT_new(mont)) == NULL)
+		errx(1, "EC_POINT_new");
+	if (!EC_POINT_get_affine_coordinates(group,
+	    EC_GROUP_get0_generator(group), p, a, ctx))
+		errx(1, "EC_POINT_get_affine_coordinates");
+	if (!EC_POINT_set_affine_coordinates(mont, generator, p, a, ctx))
+		errx(1, "EC_POINT_set_affine_coordinates");
+	if (!EC_GROUP_set_generator(mont, generator, order, cofactor))
+		errx(1, "EC_GROUP_set_generator");
+
+	for (i = 0; i < N_RANDOM_SCALARS; i++) {
+		if (!BN_rand_range(g_scalar, order) ||
+		    !BN_rand_range(p_scalar, order) ||
+		    !BN_rand_range(p_log, order))
+			errx(1, "BN_rand_range");
+		failed |= check_p256_mul(group, mont, g_scalar, p_scalar,
+		    p_log, ctx);
+	}
+
+	/* Both halves of a double multiplication are the same point. */
+	if (!BN_set_word(p_log, 1))
+		errx(1, "BN_set_word");
+	failed |= check_p256_mul(group, mont, g_scalar, g_scalar, p_log, ctx);
+
+	/* The two halves cancel out. */
+	if (!BN_sub(p_scalar, order, g_scalar))
+		errx(1, "BN_sub");
+	failed |= check_p256_mul(group, mont, g_scalar, p_scalar, p_log, ctx);
+
+	/* Zero scalars. */
+	BN_zero(g_scalar);
+	failed |= check_p256_mul(group, mont, g_scalar, p_scalar, p_log, ctx);
+	failed |= check_p256_mul(group, mont, p_scalar, g_scalar, p_log, ctx);
+
+	EC_POINT_free(generator);
+	EC_GROUP_free(group);
+	EC_GROUP_free(mont);
+	BN_free(p);
+	BN_free(a);
+	BN_free(b);
+	BN_free(order);
+	BN_free(cofactor);
+	BN_free(g_scalar);
+	BN_free(p_scalar);
+	BN_free(p_log);
+	BN_CTX_free(ctx);
+
+	return failed;
+}
+
+#define BENCHMARK_ITERATIONS	1000
+
+static void
+benchmark_mul_generator(int nid)
+{
+	struct timespec start, end, duration;
+	const EC_POINT *generator;
+	EC_GROUP *group;
+	EC_POINT *r;
+	BIGNUM *k, *order;
+	BN_CTX *ctx;
+	double secs;
+	int i;
+
+	if ((ctx = BN_CTX_new()) == NULL)
+		errx(1, "BN_CTX_new");
+	if ((group = EC_GROUP_new_by_curve_name(nid)) == NULL)
+		errx(1, "EC_GROUP_new_by_curve_name");
+	if ((generator = EC_GROUP_get0_generator(group)) == NULL)
+		errx(1, "EC_GROUP_get0_generator");
+	if ((r = EC_POINT_new(group)) == NULL)
+		errx(1, "EC_POINT_new");
+	if ((k = BN_new()) == NULL)
+		errx(1, "BN_new");
+	if ((order = BN_new()) == NULL)
+		errx(1, "BN_new");
+	if (!EC_GROUP_get_order(group, order, ctx))
+		errx(1, "EC_GROUP_get_order");
+	if (!BN_rand_range(k, order))
+		errx(1, "BN_rand_range");
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < BENCHMARK_ITERATIONS; i++) {
+		if (!EC_POINT_mul(group, r, k, NULL, NULL, ctx))
+			errx(1, "EC_POINT_mul");
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	timespecsub(&end, &start, &duration);
+	secs = duration.tv_sec + duration.tv_nsec / 1000000000.0;
+	fprintf(stderr, "%s generator: %d in %f seconds, %.0f/s\n",
+	    OBJ_nid2sn(nid), BENCHMARK_ITERATIONS, secs,
+	    BENCHMARK_ITERATIONS / secs);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < BENCHMARK_ITERATIONS; i++) {
+		if (!EC_POINT_mul(group, r, NULL, generator, k, ctx))
+			errx(1, "EC_POINT_mul");
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	timespecsub(&end, &start, &duration);
+	secs = duration.tv_sec + duration.tv_nsec / 1000000000.0;
+	fprintf(stderr, "%s point:     %d in %f seconds, %.0f/s\n",
+	    OBJ_nid2sn(nid), BENCHMARK_ITERATIONS, secs,
+	    BENCHMARK_ITERATIONS / secs);
+
+	BN_free(k);
+	BN_free(order);
+	EC_POINT_free(r);
+	EC_GROUP_free(group);
+	BN_CTX_free(ctx);
+}
+
+static void
+benchmark_ecdsa_sign(int nid)
+{
+	struct timespec start, end, duration;
+	unsigned char digest[32] = { 0 };
+	unsigned char sig[256];
+	unsigned int sig_len;
+	EC_KEY *key;
+	double secs;
+	int i;
+
+	if ((key = EC_KEY_new_by_curve_name(nid)) == NULL)
+		errx(1, "EC_KEY_new_by_curve_name");
+	if (!EC_KEY_generate_key(key))
+		errx(1, "EC_KEY_generate_key");
+	if ((size_t)ECDSA_size(key) > sizeof(sig))
+		errx(1, "ECDSA_size");
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < BENCHMARK_ITERATIONS; i++) {
+		if (!ECDSA_sign(0, digest, sizeof(digest), sig, &sig_len, key))
+			errx(1, "ECDSA_sign");
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	timespecsub(&end, &start, &duration);
+	secs = duration.tv_sec + duration.tv_nsec / 1000000000.0;
+	fprintf(stderr, "%s ecdsa sign: %d in %f seconds, %.0f/s\n",
+	    OBJ_nid2sn(nid), BENCHMARK_ITERATIONS, secs,
+	    BENCHMARK_ITERATIONS / secs);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < BENCHMARK_ITERATIONS; i++) {
+		if (ECDSA_verify(0, digest, sizeof(digest), sig, sig_len,
+		    key) != 1)
+			errx(1, "ECDSA_verify");
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	timespecsub(&end, &start, &duration);
+	secs = duration.tv_sec + duration.tv_nsec / 1000000000.0;
+	fprintf(stderr, "%s ecdsa verify: %d in %f seconds, %.0f/s\n",
+	    OBJ_nid2sn(nid), BENCHMARK_ITERATIONS, secs,
+	    BENCHMARK_ITERATIONS / secs);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < BENCHMARK_ITERATIONS; i++) {
+		if (!EC_KEY_generate_key(key))
+			errx(1, "EC_KEY_generate_key");
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	timespecsub(&end, &start, &duration);
+	secs = duration.tv_sec + duration.tv_nsec / 1000000000.0;
+	fprintf(stderr, "%s keygen:     %d in %f seconds, %.0f/s\n",
+	    OBJ_nid2sn(nid), BENCHMARK_ITERATIONS, secs,
+	    BENCHMARK_ITERATIONS / secs);
+
+	EC_KEY_free(key);
+}
+
+static void
+benchmark(void)
+{
+	size_t i;
+
+	for (i = 0; i < N_TEST_NIDS; i++) {
+		benchmark_mul_generator(test_nids[i]);
+		benchmark_ecdsa_sign(test_nids[i]);
+	}
+}
+
+int
+main(int argc, char **argv)
+{
+	int benchmark_mode = 0, failed = 0;
+
+	if (argc == 2 && strcmp(argv[1], "--benchmark") == 0)
+		benchmark_mode = 1;
+
+	failed |= test_mul_generator();
+	failed |= test_p256_method();
+
+	if (benchmark_mode && !failed)
+		benchmark();
+
+	return failed;
+}
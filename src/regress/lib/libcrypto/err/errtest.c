@@ -0,0 +1,212 @@
+/* $OpenBSD$ */
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <sys/time.h>
+
+#include <err.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <openssl/err.h>
+
+static int
+test_err_queue(void)
+{
+	unsigned long e;
+	const char *file;
+	int line;
+	int i;
+	int failed = 1;
+
+	ERR_clear_error();
+
+	for (i = 1; i <= 3; i++)
+		ERR_put_error(ERR_LIB_USER, 0, i, __FILE__, i);
+
+	if ((e = ERR_peek_last_error()) != ERR_PACK(ERR_LIB_USER, 0, 3)) {
+		fprintf(stderr, "FAIL: last error is %lx, want %lx\n", e,
+		    ERR_PACK(ERR_LIB_USER, 0, 3));
+		goto failure;
+	}
+	for (i = 1; i <= 3; i++) {
+		e = ERR_get_error_line(&file, &line);
+		if (e != ERR_PACK(ERR_LIB_USER, 0, i) || line != i ||
+		    strcmp(file, __FILE__) != 0) {
+			fprintf(stderr, "FAIL: error %d is %lx at %s:%d\n",
+			    i, e, file, line);
+			goto failure;
+		}
+	}
+	if ((e = ERR_get_error()) != 0) {
+		fprintf(stderr, "FAIL: queue not empty, got %lx\n", e);
+		goto failure;
+	}
+
+	/* The queue holds ERR_NUM_ERRORS - 1 entries, the oldest are lost. */
+	for (i = 1; i <= ERR_NUM_ERRORS * 2; i++)
+		ERR_put_error(ERR_LIB_USER, 0, i, __FILE__, __LINE__);
+	if ((e = ERR_peek_error()) !=
+	    ERR_PACK(ERR_LIB_USER, 0, ERR_NUM_ERRORS + 2)) {
+		fprintf(stderr, "FAIL: oldest error is %lx, want %lx\n", e,
+		    ERR_PACK(ERR_LIB_USER, 0, ERR_NUM_ERRORS + 2));
+		goto failure;
+	}
+
+	ERR_clear_error();
+	if ((e = ERR_peek_error()) != 0) {
+		fprintf(stderr, "FAIL: queue not cleared, got %lx\n", e);
+		goto failure;
+	}
+
+	ERR_put_error(ERR_LIB_USER, 0, 1, __FILE__, __LINE__);
+	ERR_remove_thread_state(NULL);
+	if ((e = ERR_peek_error()) != 0) {
+		fprintf(stderr, "FAIL: queue not removed, got %lx\n", e);
+		goto failure;
+	}
+
+	failed = 0;
+
+ failure:
+	ERR_clear_error();
+
+	return failed;
+}
+
+static void *
+err_thread_queue(void *arg)
+{
+	int *failed = arg;
+	unsigned long e;
+
+	/* A new thread starts with an empty queue. */
+	if ((e = ERR_peek_error()) != 0) {
+		fprintf(stderr, "FAIL: new thread has error %lx\n", e);
+		*failed = 1;
+	}
+
+	ERR_put_error(ERR_LIB_USER, 0, 2, __FILE__, __LINE__);
+
+	/* Exit with an error on the queue, to be freed on thread exit. */
+	if ((e = ERR_peek_error()) != ERR_PACK(ERR_LIB_USER, 0, 2)) {
+		fprintf(stderr, "FAIL: thread error is %lx, want %lx\n", e,
+		    ERR_PACK(ERR_LIB_USER, 0, 2));
+		*failed = 1;
+	}
+
+	return NULL;
+}
+
+static int
+test_err_thread_queue(void)
+{
+	pthread_t thread;
+	unsigned long e;
+	int failed = 0;
+
+	ERR_clear_error();
+	ERR_put_error(ERR_LIB_USER, 0, 1, __FILE__, __LINE__);
+
+	if (pthread_create(&thread, NULL, err_thread_queue, &failed) != 0)
+		errx(1, "pthread_create");
+	if (pthread_join(thread, NULL) != 0)
+		errx(1, "pthread_join");
+
+	/* The errors of the other thread must not show up here. */
+	if ((e = ERR_get_error()) != ERR_PACK(ERR_LIB_USER, 0, 1)) {
+		fprintf(stderr, "FAIL: main thread error is %lx, want %lx\n",
+		    e, ERR_PACK(ERR_LIB_USER, 0, 1));
+		failed = 1;
+	}
+	if ((e = ERR_get_error()) != 0) {
+		fprintf(stderr, "FAIL: main thread has extra error %lx\n", e);
+		failed = 1;
+	}
+
+	return failed;
+}
+
+#define BENCHMARK_ERRORS	4000000
+#define BENCHMARK_MAX_THREADS	16
+
+static void *
+benchmark_thread(void *arg)
+{
+	size_t *count = arg;
+	size_t i;
+
+	for (i = 0; i < *count; i++) {
+		ERR_put_error(ERR_LIB_USER, 0, 1, __FILE__, __LINE__);
+		/* Drain the queue every so often, like a failed handshake. */
+		if ((i & 0x7) == 0x7)
+			ERR_clear_error();
+	}
+
+	return NULL;
+}
+
+static void
+benchmark_err_put_error(int nthreads)
+{
+	pthread_t threads[BENCHMARK_MAX_THREADS];
+	struct timespec start, end, duration;
+	size_t count;
+	double secs;
+	int i;
+
+	count = BENCHMARK_ERRORS / nthreads;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < nthreads; i++) {
+		if (pthread_create(&threads[i], NULL, benchmark_thread,
+		    &count) != 0)
+			errx(1, "pthread_create");
+	}
+	for (i = 0; i < nthreads; i++)
+		pthread_join(threads[i], NULL);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	timespecsub(&end, &start, &duration);
+	secs = duration.tv_sec + duration.tv_nsec / 1000000000.0;
+
+	fprintf(stderr, "%2d threads: %zu errors in %f seconds, "
+	    "%.0f errors/s\n", nthreads, count * nthreads, secs,
+	    count * nthreads / secs);
+}
+
+int
+main(int argc, char **argv)
+{
+	int benchmark = 0, failed = 0;
+	int nthreads;
+
+	if (argc == 2 && strcmp(argv[1], "--benchmark") == 0)
+		benchmark = 1;
+
+	failed |= test_err_queue();
+	failed |= test_err_thread_queue();
+
+	if (benchmark && !failed) {
+		for (nthreads = 1; nthreads <= BENCHMARK_MAX_THREADS;
+		    nthreads *= 2)
+			benchmark_err_put_error(nthreads);
+	}
+
+	return failed;
+}
@@ -55,6 +55,7 @@
 #include <string.h>
 
 #include <openssl/aes.h>
+#include <openssl/evp.h>
 #include <openssl/modes.h>
 
 /* XXX - something like this should be in the public headers. */
@@ -913,6 +914,104 @@ fail:
 	return (ret);
 }
 
+#define LONG_TEST_MAX	2100
+
+/*
+ * Compare the EVP AES-GCM cipher, which uses the bulk GHASH and stitched
+ * AES-GCM code where available, with CRYPTO_gcm128_encrypt() fed one byte
+ * at a time, which only multiplies single blocks.
+ */
+static int
+do_gcm128_long_test(size_t key_bits)
+{
+	GCM128_CONTEXT ctx;
+	EVP_CIPHER_CTX *cctx;
+	const EVP_CIPHER *cipher;
+	AES_KEY key;
+	uint8_t K[32], IV[12], A[40];
+	uint8_t *P, *C, *out;
+	uint8_t T[16], tag[16];
+	size_t len, i, split;
+	int outl;
+	int ret = 1;
+
+	if (key_bits == 128)
+		cipher = EVP_aes_128_gcm();
+	else
+		cipher = EVP_aes_256_gcm();
+
+	if ((P = malloc(LONG_TEST_MAX)) == NULL ||
+	    (C = malloc(LONG_TEST_MAX)) == NULL ||
+	    (out = malloc(LONG_TEST_MAX)) == NULL)
+		err(1, "malloc");
+	if ((cctx = EVP_CIPHER_CTX_new()) == NULL)
+		errx(1, "EVP_CIPHER_CTX_new");
+
+	for (len = 0; len < LONG_TEST_MAX; len += 1 + len / 16) {
+		arc4random_buf(K, sizeof(K));
+		arc4random_buf(IV, sizeof(IV));
+		arc4random_buf(A, sizeof(A));
+		arc4random_buf(P, len);
+
+		AES_set_encrypt_key(K, key_bits, &key);
+		CRYPTO_gcm128_init(&ctx, &key, (block128_f)AES_encrypt);
+		CRYPTO_gcm128_setiv(&ctx, IV, sizeof(IV));
+		CRYPTO_gcm128_aad(&ctx, A, sizeof(A));
+		for (i = 0; i < len; i++)
+			CRYPTO_gcm128_encrypt(&ctx, &P[i], &C[i], 1);
+		CRYPTO_gcm128_tag(&ctx, T, sizeof(T));
+
+		/* Leave a partial block before the bulk of the data. */
+		split = len % 7;
+
+		if (!EVP_EncryptInit_ex(cctx, cipher, NULL, K, IV) ||
+		    !EVP_EncryptUpdate(cctx, NULL, &outl, A, sizeof(A)) ||
+		    !EVP_EncryptUpdate(cctx, out, &outl, P, split) ||
+		    !EVP_EncryptUpdate(cctx, out + split, &outl, P + split,
+		    len - split) ||
+		    !EVP_EncryptFinal_ex(cctx, out, &outl) ||
+		    !EVP_CIPHER_CTX_ctrl(cctx, EVP_CTRL_GCM_GET_TAG,
+		    sizeof(tag), tag)) {
+			fprintf(stderr, "FAIL: %zu bit, %zu bytes: encrypt "
+			    "failed\n", key_bits, len);
+			goto fail;
+		}
+		if (memcmp(out, C, len) != 0 || memcmp(tag, T, 16) != 0) {
+			fprintf(stderr, "FAIL: %zu bit, %zu bytes: encrypt "
+			    "mismatch\n", key_bits, len);
+			goto fail;
+		}
+
+		if (!EVP_DecryptInit_ex(cctx, cipher, NULL, K, IV) ||
+		    !EVP_DecryptUpdate(cctx, NULL, &outl, A, sizeof(A)) ||
+		    !EVP_DecryptUpdate(cctx, out, &outl, C, split) ||
+		    !EVP_DecryptUpdate(cctx, out + split, &outl, C + split,
+		    len - split) ||
+		    !EVP_CIPHER_CTX_ctrl(cctx, EVP_CTRL_GCM_SET_TAG,
+		    sizeof(T), T) ||
+		    EVP_DecryptFinal_ex(cctx, out, &outl) != 1) {
+			fprintf(stderr, "FAIL: %zu bit, %zu bytes: decrypt "
+			    "failed\n", key_bits, len);
+			goto fail;
+		}
+		if (memcmp(out, P, len) != 0) {
+			fprintf(stderr, "FAIL: %zu bit, %zu bytes: decrypt "
+			    "mismatch\n", key_bits, len);
+			goto fail;
+		}
+	}
+
+	ret = 0;
+
+ fail:
+	EVP_CIPHER_CTX_free(cctx);
+	free(P);
+	free(C);
+	free(out);
+
+	return ret;
+}
+
 int
 main(int argc, char **argv)
 {
@@ -922,5 +1021,8 @@ main(int argc, char **argv)
 	for (i = 0; i < N_TESTS; i++)
 		ret |= do_gcm128_test(i + 1, &gcm128_tests[i]);
 
+	ret |= do_gcm128_long_test(128);
+	ret |= do_gcm128_long_test(256);
+
 	return ret;
 }
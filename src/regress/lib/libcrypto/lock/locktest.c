@@ -0,0 +1,271 @@
+/* $OpenBSD$ */
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <sys/time.h>
+
+#include <err.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+
+#define TEST_THREADS		8
+#define TEST_ADDS		100000
+
+static int test_counter;
+
+static void *
+add_thread(void *arg)
+{
+	int i;
+
+	for (i = 0; i < TEST_ADDS; i++) {
+		CRYPTO_add(&test_counter, 2, CRYPTO_LOCK_X509);
+		CRYPTO_add(&test_counter, -1, CRYPTO_LOCK_X509);
+	}
+
+	return NULL;
+}
+
+static int
+test_crypto_add(void)
+{
+	pthread_t threads[TEST_THREADS];
+	int i;
+
+	test_counter = 0;
+
+	for (i = 0; i < TEST_THREADS; i++) {
+		if (pthread_create(&threads[i], NULL, add_thread, NULL) != 0)
+			errx(1, "pthread_create");
+	}
+	for (i = 0; i < TEST_THREADS; i++)
+		pthread_join(threads[i], NULL);
+
+	if (test_counter != TEST_THREADS * TEST_ADDS) {
+		fprintf(stderr, "FAIL: counter is %d, want %d\n",
+		    test_counter, TEST_THREADS * TEST_ADDS);
+		return 1;
+	}
+
+	if (CRYPTO_add(&test_counter, -TEST_THREADS * TEST_ADDS,
+	    CRYPTO_LOCK_X509) != 0) {
+		fprintf(stderr, "FAIL: CRYPTO_add did not return new value\n");
+		return 1;
+	}
+
+	return 0;
+}
+
+static pthread_mutex_t reader_mtx = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t reader_cond = PTHREAD_COND_INITIALIZER;
+static int reader_locked;
+
+static void *
+reader_thread(void *arg)
+{
+	CRYPTO_r_lock(CRYPTO_LOCK_X509_STORE);
+
+	pthread_mutex_lock(&reader_mtx);
+	reader_locked = 1;
+	pthread_cond_signal(&reader_cond);
+	pthread_mutex_unlock(&reader_mtx);
+
+	CRYPTO_r_unlock(CRYPTO_LOCK_X509_STORE);
+
+	return NULL;
+}
+
+/*
+ * A second reader must be able to take a read lock while the first one
+ * still holds it.
+ */
+static int
+test_crypto_r_lock_shared(void)
+{
+	struct timespec deadline;
+	pthread_t thread;
+	int failed = 0;
+	int rv = 0;
+
+	reader_locked = 0;
+
+	CRYPTO_r_lock(CRYPTO_LOCK_X509_STORE);
+
+	if (pthread_create(&thread, NULL, reader_thread, NULL) != 0)
+		errx(1, "pthread_create");
+
+	clock_gettime(CLOCK_REALTIME, &deadline);
+	deadline.tv_sec += 10;
+
+	pthread_mutex_lock(&reader_mtx);
+	while (!reader_locked && rv != ETIMEDOUT)
+		rv = pthread_cond_timedwait(&reader_cond, &reader_mtx,
+		    &deadline);
+	if (!reader_locked) {
+		fprintf(stderr, "FAIL: second reader blocked on read lock\n");
+		failed = 1;
+	}
+	pthread_mutex_unlock(&reader_mtx);
+
+	CRYPTO_r_unlock(CRYPTO_LOCK_X509_STORE);
+
+	pthread_join(thread, NULL);
+
+	return failed;
+}
+
+#define BENCHMARK_OPS		4000000
+#define BENCHMARK_MAX_THREADS	16
+
+struct benchmark {
+	const char *name;
+	void (*op)(void);
+};
+
+static EVP_PKEY *benchmark_pkey;
+static volatile int benchmark_data;
+
+static void
+benchmark_read_lock(void)
+{
+	int data;
+
+	CRYPTO_r_lock(CRYPTO_LOCK_X509_STORE);
+	data = benchmark_data;
+	CRYPTO_r_unlock(CRYPTO_LOCK_X509_STORE);
+
+	(void)data;
+}
+
+static void
+benchmark_write_lock(void)
+{
+	CRYPTO_w_lock(CRYPTO_LOCK_X509_STORE);
+	benchmark_data++;
+	CRYPTO_w_unlock(CRYPTO_LOCK_X509_STORE);
+}
+
+static void
+benchmark_refcount(void)
+{
+	EVP_PKEY_up_ref(benchmark_pkey);
+	EVP_PKEY_free(benchmark_pkey);
+}
+
+static const struct benchmark benchmarks[] = {
+	{
+		.name = "read lock",
+		.op = benchmark_read_lock,
+	},
+	{
+		.name = "write lock",
+		.op = benchmark_write_lock,
+	},
+	{
+		.name = "refcount",
+		.op = benchmark_refcount,
+	},
+};
+
+#define N_BENCHMARKS (sizeof(benchmarks) / sizeof(benchmarks[0]))
+
+struct benchmark_arg {
+	const struct benchmark *bm;
+	size_t ops;
+};
+
+static void *
+benchmark_thread(void *arg)
+{
+	struct benchmark_arg *ba = arg;
+	size_t i;
+
+	for (i = 0; i < ba->ops; i++)
+		ba->bm->op();
+
+	return NULL;
+}
+
+static void
+benchmark_run(const struct benchmark *bm, int nthreads)
+{
+	pthread_t threads[BENCHMARK_MAX_THREADS];
+	struct timespec start, end, duration;
+	struct benchmark_arg ba;
+	double secs;
+	int i;
+
+	ba.bm = bm;
+	ba.ops = BENCHMARK_OPS / nthreads;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < nthreads; i++) {
+		if (pthread_create(&threads[i], NULL, benchmark_thread,
+		    &ba) != 0)
+			errx(1, "pthread_create");
+	}
+	for (i = 0; i < nthreads; i++)
+		pthread_join(threads[i], NULL);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	timespecsub(&end, &start, &duration);
+	secs = duration.tv_sec + duration.tv_nsec / 1000000000.0;
+
+	fprintf(stderr, "%-10s %2d threads: %zu ops in %f seconds, "
+	    "%.0f ops/s\n", bm->name, nthreads, ba.ops * nthreads, secs,
+	    ba.ops * nthreads / secs);
+}
+
+static void
+benchmark_locks(void)
+{
+	size_t i;
+	int nthreads;
+
+	if ((benchmark_pkey = EVP_PKEY_new()) == NULL)
+		errx(1, "EVP_PKEY_new");
+
+	for (i = 0; i < N_BENCHMARKS; i++) {
+		for (nthreads = 1; nthreads <= BENCHMARK_MAX_THREADS;
+		    nthreads *= 2)
+			benchmark_run(&benchmarks[i], nthreads);
+	}
+
+	EVP_PKEY_free(benchmark_pkey);
+}
+
+int
+main(int argc, char **argv)
+{
+	int benchmark = 0, failed = 0;
+
+	if (argc == 2 && strcmp(argv[1], "--benchmark") == 0)
+		benchmark = 1;
+
+	failed |= test_crypto_add();
+	failed |= test_crypto_r_lock_shared();
+
+	if (benchmark && !failed)
+		benchmark_locks();
+
+	return failed;
+}
@@ -5,7 +5,12 @@
  *   https://github.com/floodyberry/poly1305-donna
  */
 
+#include <sys/time.h>
+
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
 
 #include <openssl/poly1305.h>
 
@@ -157,13 +162,113 @@ poly1305_power_on_self_test(void)
 	return result;
 }
 
+#define LONG_TEST_MAX	2048
+
+/*
+ * Long inputs may be processed several blocks at a time, compare these
+ * against the same input fed one block at a time.
+ */
+static int
+poly1305_long_test(void)
+{
+	static unsigned char msg[LONG_TEST_MAX];
+	unsigned char key[32], mac[16], want[16];
+	poly1305_context ctx;
+	size_t i, len;
+	int result = 1;
+
+	for (i = 0; i < sizeof(key); i++)
+		key[i] = 0xff - i;
+
+	for (len = 0; len <= LONG_TEST_MAX; len += 13) {
+		for (i = 0; i < len; i++)
+			msg[i] = (i * 31 + len) & 0xff;
+
+		CRYPTO_poly1305_init(&ctx, key);
+		for (i = 0; i < len; i += 16)
+			CRYPTO_poly1305_update(&ctx, msg + i,
+			    len - i < 16 ? len - i : 16);
+		CRYPTO_poly1305_finish(&ctx, want);
+
+		poly1305_auth(mac, msg, len, key);
+		if (!poly1305_verify(want, mac)) {
+			fprintf(stderr, "Poly1305 failed for length %zu\n",
+			    len);
+			result = 0;
+		}
+
+		/* Start within a block. */
+		CRYPTO_poly1305_init(&ctx, key);
+		CRYPTO_poly1305_update(&ctx, msg, len < 5 ? len : 5);
+		if (len > 5)
+			CRYPTO_poly1305_update(&ctx, msg + 5, len - 5);
+		CRYPTO_poly1305_finish(&ctx, mac);
+		if (!poly1305_verify(want, mac)) {
+			fprintf(stderr, "Poly1305 failed for length %zu with "
+			    "split update\n", len);
+			result = 0;
+		}
+	}
+
+	return result;
+}
+
+#define BENCHMARK_BYTES		(64 * 1024 * 1024)
+
+static void
+benchmark(void)
+{
+	static const size_t sizes[] = { 64, 256, 1024, 8192, 16384 };
+	struct timespec start, end, duration;
+	unsigned char key[32] = { 1 }, mac[16];
+	unsigned char *buf;
+	size_t i, n, count;
+	double secs;
+
+	if ((buf = calloc(1, sizes[4])) == NULL) {
+		fprintf(stderr, "calloc failed\n");
+		exit(1);
+	}
+
+	for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+		count = BENCHMARK_BYTES / sizes[i];
+
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		for (n = 0; n < count; n++)
+			poly1305_auth(mac, buf, sizes[i], key);
+		clock_gettime(CLOCK_MONOTONIC, &end);
+
+		timespecsub(&end, &start, &duration);
+		secs = duration.tv_sec + duration.tv_nsec / 1000000000.0;
+
+		fprintf(stderr, "poly1305 %5zu bytes: %zu operations in %f "
+		    "seconds, %.1f MB/s\n", sizes[i], count, secs,
+		    count * sizes[i] / secs / 1000000);
+	}
+
+	free(buf);
+}
+
 int
 main(int argc, char **argv)
 {
+	int benchmark_mode = 0;
+
+	if (argc == 2 && strcmp(argv[1], "--benchmark") == 0)
+		benchmark_mode = 1;
+
 	if (!poly1305_power_on_self_test()) {
 		fprintf(stderr, "One or more self tests failed!\n");
 		return 1;
 	}
 
+	if (!poly1305_long_test()) {
+		fprintf(stderr, "Long input tests failed!\n");
+		return 1;
+	}
+
+	if (benchmark_mode)
+		benchmark();
+
 	return 0;
 }
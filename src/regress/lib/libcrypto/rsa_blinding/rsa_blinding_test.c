@@ -0,0 +1,203 @@
+/* $OpenBSD$ */
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <err.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <openssl/bn.h>
+#include <openssl/objects.h>
+#include <openssl/rsa.h>
+
+#define TEST_THREADS		8
+#define TEST_SIGNATURES		50
+#define TEST_KEYS		10
+
+static const unsigned char test_digest[32] = {
+	0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+	0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10,
+	0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18,
+	0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20,
+};
+
+static RSA *
+generate_key(int bits)
+{
+	BIGNUM *e;
+	RSA *rsa;
+
+	if ((e = BN_new()) == NULL)
+		errx(1, "BN_new");
+	if (!BN_set_word(e, RSA_F4))
+		errx(1, "BN_set_word");
+	if ((rsa = RSA_new()) == NULL)
+		errx(1, "RSA_new");
+	if (!RSA_generate_key_ex(rsa, bits, e, NULL))
+		errx(1, "RSA_generate_key_ex");
+	BN_free(e);
+
+	return rsa;
+}
+
+/* Sign with rsa and verify the signature with the public key of pub. */
+static int
+sign_and_verify(RSA *rsa, RSA *pub)
+{
+	unsigned char sig[1024];
+	unsigned int sig_len;
+
+	if ((size_t)RSA_size(rsa) > sizeof(sig))
+		errx(1, "RSA key too large");
+
+	if (!RSA_sign(NID_sha256, test_digest, sizeof(test_digest), sig,
+	    &sig_len, rsa))
+		return 0;
+
+	return RSA_verify(NID_sha256, test_digest, sizeof(test_digest), sig,
+	    sig_len, pub);
+}
+
+static void *
+sign_thread(void *arg)
+{
+	RSA *rsa = arg;
+	long failed = 0;
+	int i;
+
+	for (i = 0; i < TEST_SIGNATURES; i++) {
+		if (!sign_and_verify(rsa, rsa))
+			failed = 1;
+	}
+
+	return (void *)failed;
+}
+
+/* Many threads signing with one key must all produce valid signatures. */
+static int
+test_rsa_blinding_threads(RSA *rsa)
+{
+	pthread_t threads[TEST_THREADS];
+	void *thread_failed;
+	int failed = 0;
+	int i;
+
+	for (i = 0; i < TEST_THREADS; i++) {
+		if (pthread_create(&threads[i], NULL, sign_thread, rsa) != 0)
+			errx(1, "pthread_create");
+	}
+	for (i = 0; i < TEST_THREADS; i++) {
+		pthread_join(threads[i], &thread_failed);
+		if (thread_failed != NULL) {
+			fprintf(stderr, "FAIL: invalid signature from thread "
+			    "%d\n", i);
+			failed = 1;
+		}
+	}
+
+	return failed;
+}
+
+/*
+ * Blinding parameters cached for a key must not be used after the key
+ * was replaced.
+ */
+static int
+test_rsa_blinding_set0_key(void)
+{
+	RSA *rsa, *other;
+	const BIGNUM *n, *e, *d, *p, *q, *dmp1, *dmq1, *iqmp;
+	int failed = 1;
+
+	rsa = generate_key(1024);
+	other = generate_key(1024);
+
+	/* Montgomery contexts cached in the key would outlive its modulus. */
+	RSA_clear_flags(rsa, RSA_FLAG_CACHE_PUBLIC | RSA_FLAG_CACHE_PRIVATE);
+
+	if (!sign_and_verify(rsa, rsa)) {
+		fprintf(stderr, "FAIL: invalid signature before RSA_set0_key\n");
+		goto failure;
+	}
+
+	RSA_get0_key(other, &n, &e, &d);
+	RSA_get0_factors(other, &p, &q);
+	RSA_get0_crt_params(other, &dmp1, &dmq1, &iqmp);
+	if (!RSA_set0_key(rsa, BN_dup(n), BN_dup(e), BN_dup(d)))
+		errx(1, "RSA_set0_key");
+	if (!RSA_set0_factors(rsa, BN_dup(p), BN_dup(q)))
+		errx(1, "RSA_set0_factors");
+	if (!RSA_set0_crt_params(rsa, BN_dup(dmp1), BN_dup(dmq1),
+	    BN_dup(iqmp)))
+		errx(1, "RSA_set0_crt_params");
+
+	if (!sign_and_verify(rsa, other)) {
+		fprintf(stderr, "FAIL: invalid signature after RSA_set0_key\n");
+		goto failure;
+	}
+
+	failed = 0;
+
+ failure:
+	RSA_free(rsa);
+	RSA_free(other);
+
+	return failed;
+}
+
+/* Keys must remain usable after they were evicted from the cache. */
+static int
+test_rsa_blinding_many_keys(void)
+{
+	RSA *keys[TEST_KEYS];
+	int failed = 0;
+	int i, round;
+
+	for (i = 0; i < TEST_KEYS; i++)
+		keys[i] = generate_key(512);
+
+	for (round = 0; round < 2; round++) {
+		for (i = 0; i < TEST_KEYS; i++) {
+			if (!sign_and_verify(keys[i], keys[i])) {
+				fprintf(stderr, "FAIL: invalid signature with "
+				    "key %d in round %d\n", i, round);
+				failed = 1;
+			}
+		}
+	}
+
+	for (i = 0; i < TEST_KEYS; i++)
+		RSA_free(keys[i]);
+
+	return failed;
+}
+
+int
+main(int argc, char **argv)
+{
+	RSA *rsa;
+	int failed = 0;
+
+	rsa = generate_key(1024);
+	failed |= test_rsa_blinding_threads(rsa);
+	RSA_free(rsa);
+
+	failed |= test_rsa_blinding_set0_key();
+	failed |= test_rsa_blinding_many_keys();
+
+	return failed;
+}
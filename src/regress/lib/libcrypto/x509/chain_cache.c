@@ -0,0 +1,350 @@
+/* $OpenBSD$ */
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <sys/time.h>
+
+#include <err.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/x509.h>
+#include <openssl/x509v3.h>
+
+#include "x509_fixtures.h"
+
+#define LEAF_HOST	"leaf.example.com"
+
+struct certs {
+	X509 *root;
+	X509 *intermediate;
+	X509 *leaf;
+	X509 *other_root;
+	STACK_OF(X509) *untrusted;
+	time_t now;
+};
+
+/* Counts how often the store looks for an issuer, i.e. builds a chain. */
+static int check_issued_calls;
+
+static int
+counting_check_issued(X509_STORE_CTX *ctx, X509 *subject, X509 *issuer)
+{
+	check_issued_calls++;
+
+	return X509_check_issued(issuer, subject) == X509_V_OK;
+}
+
+static int
+verify_cb(int ok, X509_STORE_CTX *ctx)
+{
+	return ok;
+}
+
+static X509 *
+make_cert(const char *subject, const char *issuer, EVP_PKEY *pkey,
+    EVP_PKEY *issuer_key, long not_before, int is_ca)
+{
+	struct fixture_cert fc;
+
+	memset(&fc, 0, sizeof(fc));
+	fc.subject = subject;
+	fc.issuer = issuer;
+	fc.key = pkey;
+	fc.issuer_key = issuer_key;
+	fc.not_before = not_before;
+	fc.ca = is_ca;
+	if (!is_ca)
+		fc.dns_name = LEAF_HOST;
+
+	return fixture_cert_new(&fc);
+}
+
+static void
+certs_init(struct certs *c)
+{
+	EVP_PKEY *root_key, *int_key, *leaf_key;
+
+	memset(c, 0, sizeof(*c));
+
+	c->now = time(NULL);
+
+	root_key = fixture_key_new();
+	int_key = fixture_key_new();
+	leaf_key = fixture_key_new();
+
+	c->root = make_cert("Cache Root", "Cache Root", root_key, root_key,
+	    -3600, 1);
+	c->intermediate = make_cert("Cache Intermediate", "Cache Root",
+	    int_key, root_key, -3600, 1);
+	/* The leaf becomes valid last and its notBefore bounds the chain. */
+	c->leaf = make_cert("Cache Leaf", "Cache Intermediate", leaf_key,
+	    int_key, -60, 0);
+	c->other_root = make_cert("Other Root", "Other Root", root_key,
+	    root_key, -3600, 1);
+
+	if ((c->untrusted = sk_X509_new_null()) == NULL)
+		errx(1, "sk_X509_new_null");
+	if (!sk_X509_push(c->untrusted, c->intermediate))
+		errx(1, "sk_X509_push");
+	if (!X509_up_ref(c->intermediate))
+		errx(1, "X509_up_ref");
+
+	EVP_PKEY_free(root_key);
+	EVP_PKEY_free(int_key);
+	EVP_PKEY_free(leaf_key);
+}
+
+static void
+certs_free(struct certs *c)
+{
+	X509_free(c->root);
+	X509_free(c->intermediate);
+	X509_free(c->leaf);
+	X509_free(c->other_root);
+	sk_X509_pop_free(c->untrusted, X509_free);
+}
+
+static X509_STORE *
+store_new(struct certs *c, size_t cache_max)
+{
+	X509_STORE *store;
+
+	store = fixture_store_new(&c->root, 1);
+	X509_STORE_set_check_issued(store, counting_check_issued);
+	if (!X509_STORE_set_chain_cache_max(store, cache_max))
+		errx(1, "X509_STORE_set_chain_cache_max");
+
+	return store;
+}
+
+struct verify_opts {
+	STACK_OF(X509) *untrusted;
+	const char *host;
+	time_t check_time;
+	int use_verify_cb;
+};
+
+/*
+ * Verify the leaf and return the result. The number of chain building
+ * steps is returned in out_calls and the chain length in out_chain_len.
+ */
+static int
+verify(X509_STORE *store, struct certs *c, const struct verify_opts *opts,
+    int *out_calls, int *out_chain_len, char **out_peername)
+{
+	X509_STORE_CTX *xsc;
+	X509_VERIFY_PARAM *param;
+	char *peername;
+	int ret;
+
+	if ((xsc = X509_STORE_CTX_new()) == NULL)
+		errx(1, "X509_STORE_CTX_new");
+	if (!X509_STORE_CTX_init(xsc, store, c->leaf, opts->untrusted))
+		errx(1, "X509_STORE_CTX_init");
+	param = X509_STORE_CTX_get0_param(xsc);
+	if (opts->host != NULL &&
+	    !X509_VERIFY_PARAM_set1_host(param, opts->host, 0))
+		errx(1, "X509_VERIFY_PARAM_set1_host");
+	if (opts->check_time != 0)
+		X509_VERIFY_PARAM_set_time(param, opts->check_time);
+	if (opts->use_verify_cb)
+		X509_STORE_CTX_set_verify_cb(xsc, verify_cb);
+
+	check_issued_calls = 0;
+	ret = X509_verify_cert(xsc);
+	*out_calls = check_issued_calls;
+	*out_chain_len = sk_X509_num(X509_STORE_CTX_get0_chain(xsc));
+
+	if (out_peername != NULL) {
+		free(*out_peername);
+		*out_peername = NULL;
+		if ((peername = X509_VERIFY_PARAM_get0_peername(param)) !=
+		    NULL) {
+			if ((*out_peername = strdup(peername)) == NULL)
+				err(1, NULL);
+		}
+	}
+
+	X509_STORE_CTX_free(xsc);
+
+	return ret;
+}
+
+static int
+check_verify(const char *desc, X509_STORE *store, struct certs *c,
+    const struct verify_opts *opts, int want_ret, int want_cached)
+{
+	int calls, chain_len, ret;
+
+	ret = verify(store, c, opts, &calls, &chain_len, NULL);
+	if (ret != want_ret) {
+		fprintf(stderr, "FAIL: %s: X509_verify_cert() returned %d, "
+		    "want %d\n", desc, ret, want_ret);
+		return 1;
+	}
+	if (want_ret == 1 && chain_len != 3) {
+		fprintf(stderr, "FAIL: %s: got chain of %d certificates, "
+		    "want 3\n", desc, chain_len);
+		return 1;
+	}
+	if (want_ret != 1)
+		return 0;
+	if (want_cached && calls != 0) {
+		fprintf(stderr, "FAIL: %s: chain was built, want cached\n",
+		    desc);
+		return 1;
+	}
+	if (!want_cached && calls == 0) {
+		fprintf(stderr, "FAIL: %s: chain was cached, want built\n",
+		    desc);
+		return 1;
+	}
+
+	return 0;
+}
+
+static int
+test_chain_cache(struct certs *c)
+{
+	struct verify_opts opts = { .untrusted = c->untrusted };
+	X509_STORE *store;
+	char *peername = NULL;
+	int calls, chain_len;
+	int failed = 0;
+
+	/* Without a cache every verification builds the chain. */
+	store = store_new(c, 0);
+	failed |= check_verify("no cache", store, c, &opts, 1, 0);
+	failed |= check_verify("no cache again", store, c, &opts, 1, 0);
+	X509_STORE_free(store);
+
+	store = store_new(c, 4);
+	failed |= check_verify("first", store, c, &opts, 1, 0);
+	failed |= check_verify("second", store, c, &opts, 1, 1);
+
+	/* Different untrusted certificates are a different key. */
+	opts.untrusted = NULL;
+	failed |= check_verify("no intermediates", store, c, &opts, 0, 0);
+	failed |= check_verify("no intermediates again", store, c, &opts,
+	    0, 0);
+	opts.untrusted = c->untrusted;
+
+	/* The verify callback could change the result. */
+	opts.use_verify_cb = 1;
+	failed |= check_verify("verify callback", store, c, &opts, 1, 0);
+	opts.use_verify_cb = 0;
+
+	/* The matched host name is restored from the cache. */
+	opts.host = LEAF_HOST;
+	if (verify(store, c, &opts, &calls, &chain_len, &peername) != 1 ||
+	    calls == 0 || peername == NULL || strcmp(peername, LEAF_HOST)) {
+		fprintf(stderr, "FAIL: host name verification\n");
+		failed = 1;
+	}
+	if (verify(store, c, &opts, &calls, &chain_len, &peername) != 1 ||
+	    calls != 0 || peername == NULL || strcmp(peername, LEAF_HOST)) {
+		fprintf(stderr, "FAIL: cached host name verification\n");
+		failed = 1;
+	}
+	opts.host = "other.example.com";
+	failed |= check_verify("wrong host", store, c, &opts, 0, 0);
+	opts.host = NULL;
+
+	/* Entries are only used within the validity of the whole chain. */
+	opts.check_time = c->now;
+	failed |= check_verify("check time", store, c, &opts, 1, 0);
+	failed |= check_verify("check time again", store, c, &opts, 1, 1);
+	opts.check_time = c->now - 600;
+	failed |= check_verify("before notBefore", store, c, &opts, 0, 0);
+	opts.check_time = c->now + 2 * FIXTURE_VALIDITY;
+	failed |= check_verify("after notAfter", store, c, &opts, 0, 0);
+	opts.check_time = c->now;
+	failed |= check_verify("check time expired", store, c, &opts, 1, 0);
+	opts.check_time = 0;
+
+	/* Adding to the store flushes the cache. */
+	failed |= check_verify("before add", store, c, &opts, 1, 1);
+	if (!X509_STORE_add_cert(store, c->other_root))
+		errx(1, "X509_STORE_add_cert");
+	failed |= check_verify("after add", store, c, &opts, 1, 0);
+	failed |= check_verify("after add again", store, c, &opts, 1, 1);
+
+	/* A maximum of 0 disables the cache. */
+	if (!X509_STORE_set_chain_cache_max(store, 0))
+		errx(1, "X509_STORE_set_chain_cache_max");
+	failed |= check_verify("disabled", store, c, &opts, 1, 0);
+	failed |= check_verify("disabled again", store, c, &opts, 1, 0);
+
+	X509_STORE_free(store);
+	free(peername);
+
+	return failed;
+}
+
+#define BENCHMARK_ITERATIONS	10000
+
+static void
+benchmark_store(struct certs *c, size_t cache_max)
+{
+	struct verify_opts opts = { .untrusted = c->untrusted };
+	struct timespec start, end, duration;
+	X509_STORE *store;
+	int calls, chain_len;
+	double secs;
+	int i;
+
+	store = store_new(c, cache_max);
+	X509_STORE_set_check_issued(store, NULL);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < BENCHMARK_ITERATIONS; i++) {
+		if (verify(store, c, &opts, &calls, &chain_len, NULL) != 1)
+			errx(1, "verify");
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	timespecsub(&end, &start, &duration);
+	secs = duration.tv_sec + duration.tv_nsec / 1000000000.0;
+	fprintf(stderr, "X509_verify_cert, chain cache %s: "
+	    "%d in %f seconds, %.0f/s\n", cache_max > 0 ? "on" : "off",
+	    BENCHMARK_ITERATIONS, secs, BENCHMARK_ITERATIONS / secs);
+
+	X509_STORE_free(store);
+}
+
+int
+main(int argc, char **argv)
+{
+	struct certs c;
+	int failed = 0;
+
+	certs_init(&c);
+
+	failed |= test_chain_cache(&c);
+
+	if (argc == 2 && strcmp(argv[1], "--benchmark") == 0) {
+		benchmark_store(&c, 0);
+		benchmark_store(&c, 1024);
+	}
+
+	certs_free(&c);
+
+	return failed;
+}
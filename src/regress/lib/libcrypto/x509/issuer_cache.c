@@ -0,0 +1,331 @@
+/* $OpenBSD$ */
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <sys/time.h>
+
+#include <err.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "x509_issuer_cache.h"
+
+#define NUM_PAIRS	1024
+#define NUM_THREADS	8
+#define NUM_LOOKUPS	200000
+
+struct pair {
+	unsigned char parent_md[EVP_MAX_MD_SIZE];
+	unsigned char child_md[EVP_MAX_MD_SIZE];
+};
+
+static struct pair pairs[NUM_PAIRS];
+
+static void
+pairs_init(void)
+{
+	arc4random_buf(pairs, sizeof(pairs));
+}
+
+static int
+issuer_cache_basic_test(void)
+{
+	struct x509_issuer_cache_stats before, after;
+	int ret, failed = 1;
+
+	x509_issuer_cache_free();
+	if (!x509_issuer_cache_set_max(X509_ISSUER_CACHE_MAX)) {
+		fprintf(stderr, "FAIL: set_max\n");
+		goto failure;
+	}
+	x509_issuer_cache_stats(&before);
+
+	if ((ret = x509_issuer_cache_find(pairs[0].parent_md,
+	    pairs[0].child_md)) != -1) {
+		fprintf(stderr, "FAIL: empty cache found %d\n", ret);
+		goto failure;
+	}
+
+	x509_issuer_cache_add(pairs[0].parent_md, pairs[0].child_md, 1);
+	x509_issuer_cache_add(pairs[1].parent_md, pairs[1].child_md, 0);
+	x509_issuer_cache_add(pairs[0].parent_md, pairs[0].child_md, 0);
+	x509_issuer_cache_add(pairs[2].parent_md, pairs[2].child_md, 2);
+
+	if ((ret = x509_issuer_cache_find(pairs[0].parent_md,
+	    pairs[0].child_md)) != 1) {
+		fprintf(stderr, "FAIL: valid entry found %d, want 1\n", ret);
+		goto failure;
+	}
+	if ((ret = x509_issuer_cache_find(pairs[1].parent_md,
+	    pairs[1].child_md)) != 0) {
+		fprintf(stderr, "FAIL: invalid entry found %d, want 0\n", ret);
+		goto failure;
+	}
+	if ((ret = x509_issuer_cache_find(pairs[2].parent_md,
+	    pairs[2].child_md)) != -1) {
+		fprintf(stderr, "FAIL: bogus entry found %d, want -1\n", ret);
+		goto failure;
+	}
+	/* Same digests, swapped roles. */
+	if ((ret = x509_issuer_cache_find(pairs[0].child_md,
+	    pairs[0].parent_md)) != -1) {
+		fprintf(stderr, "FAIL: swapped entry found %d, want -1\n", ret);
+		goto failure;
+	}
+
+	x509_issuer_cache_stats(&after);
+	if (after.entries != 2) {
+		fprintf(stderr, "FAIL: got %zu entries, want 2\n",
+		    after.entries);
+		goto failure;
+	}
+	if (after.hits - before.hits != 2 ||
+	    after.misses - before.misses != 3) {
+		fprintf(stderr, "FAIL: got %llu hits and %llu misses, "
+		    "want 2 and 3\n",
+		    (unsigned long long)(after.hits - before.hits),
+		    (unsigned long long)(after.misses - before.misses));
+		goto failure;
+	}
+
+	x509_issuer_cache_free();
+	x509_issuer_cache_stats(&after);
+	if (after.entries != 0) {
+		fprintf(stderr, "FAIL: %zu entries after free\n",
+		    after.entries);
+		goto failure;
+	}
+
+	failed = 0;
+
+ failure:
+	return failed;
+}
+
+static int
+issuer_cache_max_test(void)
+{
+	struct x509_issuer_cache_stats stats;
+	size_t max = 4 * X509_ISSUER_CACHE_SHARDS;
+	size_t i;
+	int ret, failed = 1;
+
+	x509_issuer_cache_free();
+
+	if (!x509_issuer_cache_set_max(0)) {
+		fprintf(stderr, "FAIL: set_max 0\n");
+		goto failure;
+	}
+	x509_issuer_cache_add(pairs[0].parent_md, pairs[0].child_md, 1);
+	if ((ret = x509_issuer_cache_find(pairs[0].parent_md,
+	    pairs[0].child_md)) != -1) {
+		fprintf(stderr, "FAIL: disabled cache found %d\n", ret);
+		goto failure;
+	}
+
+	if (!x509_issuer_cache_set_max(max)) {
+		fprintf(stderr, "FAIL: set_max %zu\n", max);
+		goto failure;
+	}
+	for (i = 0; i < NUM_PAIRS; i++)
+		x509_issuer_cache_add(pairs[i].parent_md, pairs[i].child_md, 1);
+	x509_issuer_cache_stats(&stats);
+	if (stats.entries == 0 || stats.entries > max) {
+		fprintf(stderr, "FAIL: got %zu entries with max %zu\n",
+		    stats.entries, max);
+		goto failure;
+	}
+
+	/* The most recently added entry is never the one evicted. */
+	i = NUM_PAIRS - 1;
+	if ((ret = x509_issuer_cache_find(pairs[i].parent_md,
+	    pairs[i].child_md)) != 1) {
+		fprintf(stderr, "FAIL: newest entry found %d, want 1\n", ret);
+		goto failure;
+	}
+
+	/* A maximum smaller than the number of shards still caches. */
+	x509_issuer_cache_free();
+	if (!x509_issuer_cache_set_max(1)) {
+		fprintf(stderr, "FAIL: set_max 1\n");
+		goto failure;
+	}
+	x509_issuer_cache_add(pairs[0].parent_md, pairs[0].child_md, 1);
+	if ((ret = x509_issuer_cache_find(pairs[0].parent_md,
+	    pairs[0].child_md)) != 1) {
+		fprintf(stderr, "FAIL: max 1 found %d, want 1\n", ret);
+		goto failure;
+	}
+
+	failed = 0;
+
+ failure:
+	x509_issuer_cache_free();
+	x509_issuer_cache_set_max(X509_ISSUER_CACHE_MAX);
+
+	return failed;
+}
+
+struct worker {
+	pthread_t thread;
+	uint32_t seed;
+	size_t lookups;
+	int add;
+	int failed;
+};
+
+static void *
+worker_run(void *arg)
+{
+	struct worker *w = arg;
+	size_t i, n;
+	int ret;
+
+	for (i = 0; i < w->lookups; i++) {
+		n = (w->seed + i * 7919) % NUM_PAIRS;
+		ret = x509_issuer_cache_find(pairs[n].parent_md,
+		    pairs[n].child_md);
+		if (ret == -1 && w->add)
+			x509_issuer_cache_add(pairs[n].parent_md,
+			    pairs[n].child_md, n & 1);
+		else if (ret != -1 && ret != (int)(n & 1))
+			w->failed = 1;
+	}
+
+	return NULL;
+}
+
+static int
+run_workers(int num_threads, size_t lookups, int add)
+{
+	struct worker workers[NUM_THREADS];
+	int i, failed = 0;
+
+	for (i = 0; i < num_threads; i++) {
+		workers[i].seed = arc4random();
+		workers[i].lookups = lookups;
+		workers[i].add = add;
+		workers[i].failed = 0;
+		if (pthread_create(&workers[i].thread, NULL, worker_run,
+		    &workers[i]) != 0)
+			errx(1, "pthread_create");
+	}
+	for (i = 0; i < num_threads; i++) {
+		if (pthread_join(workers[i].thread, NULL) != 0)
+			errx(1, "pthread_join");
+		failed |= workers[i].failed;
+	}
+
+	return failed;
+}
+
+static int
+issuer_cache_threads_test(void)
+{
+	struct x509_issuer_cache_stats before, after;
+	uint64_t lookups;
+	int failed = 1;
+
+	x509_issuer_cache_free();
+	x509_issuer_cache_stats(&before);
+
+	if (run_workers(NUM_THREADS, NUM_LOOKUPS / NUM_THREADS, 1)) {
+		fprintf(stderr, "FAIL: threads found a wrong result\n");
+		goto failure;
+	}
+
+	x509_issuer_cache_stats(&after);
+	lookups = (after.hits - before.hits) + (after.misses - before.misses);
+	if (lookups != NUM_LOOKUPS / NUM_THREADS * NUM_THREADS) {
+		fprintf(stderr, "FAIL: counted %llu lookups, want %d\n",
+		    (unsigned long long)lookups,
+		    NUM_LOOKUPS / NUM_THREADS * NUM_THREADS);
+		goto failure;
+	}
+	if (after.entries != NUM_PAIRS) {
+		fprintf(stderr, "FAIL: got %zu entries, want %d\n",
+		    after.entries, NUM_PAIRS);
+		goto failure;
+	}
+
+	failed = 0;
+
+ failure:
+	x509_issuer_cache_free();
+
+	return failed;
+}
+
+static void
+benchmark_threads(int num_threads)
+{
+	struct timespec start, end;
+	double seconds;
+	size_t lookups = 2000000 / num_threads;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	run_workers(num_threads, lookups, 0);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	seconds = (end.tv_sec - start.tv_sec) +
+	    (end.tv_nsec - start.tv_nsec) / 1e9;
+	printf("%d thread%s: %.0f lookups/s\n", num_threads,
+	    num_threads == 1 ? "" : "s", lookups * num_threads / seconds);
+}
+
+static void
+benchmark(void)
+{
+	struct x509_issuer_cache_stats stats;
+	int num_threads;
+	size_t i;
+
+	x509_issuer_cache_free();
+	for (i = 0; i < NUM_PAIRS; i++)
+		x509_issuer_cache_add(pairs[i].parent_md, pairs[i].child_md,
+		    i & 1);
+
+	for (num_threads = 1; num_threads <= NUM_THREADS; num_threads *= 2)
+		benchmark_threads(num_threads);
+
+	x509_issuer_cache_stats(&stats);
+	printf("%zu entries, %llu hits, %llu misses\n", stats.entries,
+	    (unsigned long long)stats.hits, (unsigned long long)stats.misses);
+
+	x509_issuer_cache_free();
+}
+
+int
+main(int argc, char **argv)
+{
+	int failed = 0;
+
+	pairs_init();
+
+	if (argc == 2 && strcmp(argv[1], "--benchmark") == 0) {
+		benchmark();
+		return 0;
+	}
+
+	failed |= issuer_cache_basic_test();
+	failed |= issuer_cache_max_test();
+	failed |= issuer_cache_threads_test();
+
+	return failed;
+}
@@ -0,0 +1,338 @@
+/* $OpenBSD$ */
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <sys/time.h>
+
+#include <err.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/x509.h>
+
+#include "x509_fixtures.h"
+
+#define TEST_CERTS	1000
+#define BENCHMARK_CERTS	10000
+#define BENCHMARK_LOOKUPS	100000
+
+/*
+ * Certificate i has the subject "Store Cert i/2", so that every subject
+ * name is shared by two certificates, and is issued by "Store CA".
+ */
+static void
+certs_init(struct fixture_certs *c, int num_certs)
+{
+	fixture_certs_init(c, "Store CA", "Store Cert %d", num_certs, 2);
+	c->crl = fixture_crl_new("Store CA", c->key, NULL, 0);
+}
+
+static int
+test_store_certs(struct fixture_certs *c)
+{
+	X509_STORE *store;
+	X509_STORE_CTX *ctx = NULL;
+	STACK_OF(X509) *certs = NULL;
+	X509_OBJECT *obj = NULL;
+	X509_NAME *name = NULL;
+	X509 *issuer = NULL;
+	int i, failed = 1;
+
+	store = fixture_store_new(c->certs, c->num_certs);
+
+	/* Adding a certificate that is already present is not an error. */
+	if (!X509_STORE_add_cert(store, c->certs[0])) {
+		fprintf(stderr, "FAIL: adding a duplicate failed\n");
+		goto failure;
+	}
+	if (sk_X509_OBJECT_num(X509_STORE_get0_objects(store)) !=
+	    c->num_certs) {
+		fprintf(stderr, "FAIL: store has %d objects, want %d\n",
+		    sk_X509_OBJECT_num(X509_STORE_get0_objects(store)),
+		    c->num_certs);
+		goto failure;
+	}
+
+	if ((ctx = X509_STORE_CTX_new()) == NULL)
+		errx(1, "X509_STORE_CTX_new");
+	if (!X509_STORE_CTX_init(ctx, store, c->ca, NULL))
+		errx(1, "X509_STORE_CTX_init");
+
+	/* Both certificates with a subject are found, in the order added. */
+	for (i = 0; i < c->num_certs; i += 2) {
+		name = X509_get_subject_name(c->certs[i]);
+		if ((certs = X509_STORE_get1_certs(ctx, name)) == NULL) {
+			fprintf(stderr, "FAIL: no certs for cert %d\n", i);
+			goto failure;
+		}
+		if (sk_X509_num(certs) != 2 ||
+		    X509_cmp(sk_X509_value(certs, 0), c->certs[i]) != 0 ||
+		    X509_cmp(sk_X509_value(certs, 1), c->certs[i + 1]) != 0) {
+			fprintf(stderr, "FAIL: wrong certs for cert %d\n", i);
+			goto failure;
+		}
+		sk_X509_pop_free(certs, X509_free);
+		certs = NULL;
+	}
+
+	name = X509_get_subject_name(c->certs[c->num_certs / 2]);
+	if ((obj = X509_STORE_CTX_get_obj_by_subject(ctx, X509_LU_X509,
+	    name)) == NULL) {
+		fprintf(stderr, "FAIL: get_obj_by_subject found nothing\n");
+		goto failure;
+	}
+	if (X509_NAME_cmp(X509_get_subject_name(X509_OBJECT_get0_X509(obj)),
+	    name) != 0) {
+		fprintf(stderr, "FAIL: get_obj_by_subject found wrong cert\n");
+		goto failure;
+	}
+	X509_OBJECT_free(obj);
+	obj = NULL;
+
+	/* The CA is not in the store, nor is any CRL. */
+	name = X509_get_subject_name(c->ca);
+	if ((obj = X509_STORE_CTX_get_obj_by_subject(ctx, X509_LU_X509,
+	    name)) != NULL) {
+		fprintf(stderr, "FAIL: found a cert that was not added\n");
+		goto failure;
+	}
+	if ((obj = X509_STORE_CTX_get_obj_by_subject(ctx, X509_LU_CRL,
+	    name)) != NULL) {
+		fprintf(stderr, "FAIL: found a CRL that was not added\n");
+		goto failure;
+	}
+
+	/* Every certificate is issued by "Store CA". */
+	if (!X509_STORE_add_cert(store, c->ca))
+		errx(1, "X509_STORE_add_cert");
+	if (X509_STORE_CTX_get1_issuer(&issuer, ctx, c->certs[0]) != 1) {
+		fprintf(stderr, "FAIL: get1_issuer found nothing\n");
+		goto failure;
+	}
+	if (X509_cmp(issuer, c->ca) != 0) {
+		fprintf(stderr, "FAIL: get1_issuer found the wrong issuer\n");
+		goto failure;
+	}
+
+	/* The stack handed out is sorted and can be searched by subject. */
+	name = X509_get_subject_name(c->certs[1]);
+	if ((obj = X509_OBJECT_retrieve_by_subject(
+	    X509_STORE_get0_objects(store), X509_LU_X509, name)) == NULL) {
+		fprintf(stderr, "FAIL: retrieve_by_subject found nothing\n");
+		goto failure;
+	}
+	obj = NULL;
+
+	failed = 0;
+
+ failure:
+	X509_OBJECT_free(obj);
+	sk_X509_pop_free(certs, X509_free);
+	X509_free(issuer);
+	X509_STORE_CTX_free(ctx);
+	X509_STORE_free(store);
+
+	return failed;
+}
+
+static int
+test_store_crls(struct fixture_certs *c)
+{
+	X509_STORE *store;
+	X509_STORE_CTX *ctx = NULL;
+	STACK_OF(X509_CRL) *crls = NULL;
+	int failed = 1;
+
+	store = fixture_store_new(c->certs, c->num_certs);
+	if (!X509_STORE_add_crl(store, c->crl))
+		errx(1, "X509_STORE_add_crl");
+	if (!X509_STORE_add_crl(store, c->crl))
+		errx(1, "X509_STORE_add_crl");
+
+	if ((ctx = X509_STORE_CTX_new()) == NULL)
+		errx(1, "X509_STORE_CTX_new");
+	if (!X509_STORE_CTX_init(ctx, store, c->ca, NULL))
+		errx(1, "X509_STORE_CTX_init");
+
+	if ((crls = X509_STORE_get1_crls(ctx,
+	    X509_get_subject_name(c->ca))) == NULL) {
+		fprintf(stderr, "FAIL: no CRLs for the CA\n");
+		goto failure;
+	}
+	if (sk_X509_CRL_num(crls) != 1) {
+		fprintf(stderr, "FAIL: got %d CRLs, want 1\n",
+		    sk_X509_CRL_num(crls));
+		goto failure;
+	}
+	sk_X509_CRL_pop_free(crls, X509_CRL_free);
+
+	/* A certificate subject is not a CRL issuer. */
+	if ((crls = X509_STORE_get1_crls(ctx,
+	    X509_get_subject_name(c->certs[0]))) != NULL) {
+		fprintf(stderr, "FAIL: got CRLs for a cert subject\n");
+		goto failure;
+	}
+
+	failed = 0;
+
+ failure:
+	sk_X509_CRL_pop_free(crls, X509_CRL_free);
+	X509_STORE_CTX_free(ctx);
+	X509_STORE_free(store);
+
+	return failed;
+}
+
+static double
+elapsed(const struct timespec *start)
+{
+	struct timespec end, duration;
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	timespecsub(&end, start, &duration);
+
+	return duration.tv_sec + duration.tv_nsec / 1000000000.0;
+}
+
+static void
+benchmark_load_bundle(struct fixture_certs *c)
+{
+	struct timespec start;
+	char path[] = "/tmp/store_objects.XXXXXXXXXX";
+	X509_STORE *store;
+	FILE *fp;
+	int fd, i;
+
+	if ((fd = mkstemp(path)) == -1)
+		err(1, "mkstemp");
+	if ((fp = fdopen(fd, "w")) == NULL)
+		err(1, "fdopen");
+	for (i = 0; i < c->num_certs; i++) {
+		if (!PEM_write_X509(fp, c->certs[i]))
+			errx(1, "PEM_write_X509");
+	}
+	if (fclose(fp) != 0)
+		err(1, "fclose");
+
+	if ((store = X509_STORE_new()) == NULL)
+		errx(1, "X509_STORE_new");
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	if (!X509_STORE_load_locations(store, path, NULL))
+		errx(1, "X509_STORE_load_locations");
+	fprintf(stderr, "load %d cert bundle: %f seconds\n", c->num_certs,
+	    elapsed(&start));
+
+	X509_STORE_free(store);
+	unlink(path);
+}
+
+static void
+benchmark_interleaved(struct fixture_certs *c)
+{
+	struct timespec start;
+	X509_STORE *store;
+	X509_STORE_CTX *ctx;
+	X509_OBJECT *obj;
+	int i;
+
+	if ((store = X509_STORE_new()) == NULL)
+		errx(1, "X509_STORE_new");
+	if ((ctx = X509_STORE_CTX_new()) == NULL)
+		errx(1, "X509_STORE_CTX_new");
+	if (!X509_STORE_CTX_init(ctx, store, c->ca, NULL))
+		errx(1, "X509_STORE_CTX_init");
+
+	/* Look up a certificate after every ten additions. */
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < c->num_certs; i++) {
+		if (!X509_STORE_add_cert(store, c->certs[i]))
+			errx(1, "X509_STORE_add_cert");
+		if (i % 10 != 9)
+			continue;
+		if ((obj = X509_STORE_CTX_get_obj_by_subject(ctx, X509_LU_X509,
+		    X509_get_subject_name(c->certs[i / 2]))) == NULL)
+			errx(1, "X509_STORE_CTX_get_obj_by_subject");
+		X509_OBJECT_free(obj);
+	}
+	fprintf(stderr, "add %d certs, looking up every 10th: %f seconds\n",
+	    c->num_certs, elapsed(&start));
+
+	X509_STORE_CTX_free(ctx);
+	X509_STORE_free(store);
+}
+
+static void
+benchmark_lookups(struct fixture_certs *c)
+{
+	struct timespec start;
+	X509_STORE *store;
+	X509_STORE_CTX *ctx;
+	STACK_OF(X509) *certs;
+	double secs;
+	int i;
+
+	store = fixture_store_new(c->certs, c->num_certs);
+	if ((ctx = X509_STORE_CTX_new()) == NULL)
+		errx(1, "X509_STORE_CTX_new");
+	if (!X509_STORE_CTX_init(ctx, store, c->ca, NULL))
+		errx(1, "X509_STORE_CTX_init");
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < BENCHMARK_LOOKUPS; i++) {
+		if ((certs = X509_STORE_get1_certs(ctx,
+		    X509_get_subject_name(c->certs[i % c->num_certs]))) == NULL)
+			errx(1, "X509_STORE_get1_certs");
+		sk_X509_pop_free(certs, X509_free);
+	}
+	secs = elapsed(&start);
+	fprintf(stderr, "X509_STORE_get1_certs with %d certs: "
+	    "%d in %f seconds, %.0f/s\n", c->num_certs, BENCHMARK_LOOKUPS,
+	    secs, BENCHMARK_LOOKUPS / secs);
+
+	X509_STORE_CTX_free(ctx);
+	X509_STORE_free(store);
+}
+
+int
+main(int argc, char **argv)
+{
+	struct fixture_certs c;
+	int failed = 0;
+
+	if (argc == 2 && strcmp(argv[1], "--benchmark") == 0) {
+		certs_init(&c, BENCHMARK_CERTS);
+		benchmark_load_bundle(&c);
+		benchmark_interleaved(&c);
+		benchmark_lookups(&c);
+		fixture_certs_free(&c);
+		return 0;
+	}
+
+	certs_init(&c, TEST_CERTS);
+
+	failed |= test_store_certs(&c);
+	failed |= test_store_crls(&c);
+
+	fixture_certs_free(&c);
+
+	return failed;
+}
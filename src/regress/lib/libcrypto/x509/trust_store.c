@@ -0,0 +1,616 @@
+/* $OpenBSD$ */
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <sys/time.h>
+
+#include <err.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/x509.h>
+
+#include "bytestring.h"
+#include "x509_fixtures.h"
+
+#define TEST_LEAVES		100
+#define BENCHMARK_ROOTS		150
+#define BENCHMARK_ROUNDS	100
+
+struct store_object {
+	int type;
+	uint32_t hash;
+	unsigned char *der;
+	int der_len;
+};
+
+/*
+ * A CA named "Trust CA" issues leaf i with the subject "Trust Leaf i" and
+ * a CRL that revokes every odd leaf.
+ */
+static void
+certs_init(struct fixture_certs *c, int num_leaves)
+{
+	X509 **revoked;
+	int i, num_revoked = 0;
+
+	fixture_certs_init(c, "Trust CA", "Trust Leaf %d", num_leaves, 1);
+
+	if ((revoked = calloc(num_leaves, sizeof(*revoked))) == NULL)
+		err(1, NULL);
+	for (i = 1; i < num_leaves; i += 2)
+		revoked[num_revoked++] = c->certs[i];
+	c->crl = fixture_crl_new("Trust CA", c->key, revoked, num_revoked);
+	free(revoked);
+}
+
+static void
+store_object_cert(struct store_object *obj, X509 *cert)
+{
+	obj->type = X509_LU_X509;
+	obj->hash = X509_subject_name_hash(cert);
+	obj->der = NULL;
+	if ((obj->der_len = i2d_X509(cert, &obj->der)) <= 0)
+		errx(1, "i2d_X509");
+}
+
+static void
+store_object_crl(struct store_object *obj, X509_CRL *crl)
+{
+	obj->type = X509_LU_CRL;
+	obj->hash = X509_NAME_hash(X509_CRL_get_issuer(crl));
+	obj->der = NULL;
+	if ((obj->der_len = i2d_X509_CRL(crl, &obj->der)) <= 0)
+		errx(1, "i2d_X509_CRL");
+}
+
+static int
+store_object_cmp(const void *a, const void *b)
+{
+	const struct store_object *oa = a, *ob = b;
+
+	if (oa->type != ob->type)
+		return oa->type < ob->type ? -1 : 1;
+	if (oa->hash != ob->hash)
+		return oa->hash < ob->hash ? -1 : 1;
+	return 0;
+}
+
+/* A minimal version of what openssl certstore writes. */
+static void
+store_build(struct store_object *objs, size_t num_objs, uint8_t **out,
+    size_t *out_len)
+{
+	uint32_t offset;
+	size_t i;
+	CBB cbb;
+
+	if (num_objs > 0)
+		qsort(objs, num_objs, sizeof(*objs), store_object_cmp);
+
+	if (!CBB_init(&cbb, 0))
+		errx(1, "CBB_init");
+	if (!CBB_add_bytes(&cbb, X509_TRUST_STORE_MAGIC,
+	    X509_TRUST_STORE_MAGIC_LEN))
+		errx(1, "CBB_add_bytes");
+	if (!CBB_add_u32(&cbb, num_objs))
+		errx(1, "CBB_add_u32");
+
+	offset = X509_TRUST_STORE_MAGIC_LEN + 4 +
+	    num_objs * X509_TRUST_STORE_ENTRY_LEN;
+	for (i = 0; i < num_objs; i++) {
+		if (!CBB_add_u32(&cbb, objs[i].type) ||
+		    !CBB_add_u32(&cbb, objs[i].hash) ||
+		    !CBB_add_u32(&cbb, offset) ||
+		    !CBB_add_u32(&cbb, objs[i].der_len))
+			errx(1, "CBB_add_u32");
+		offset += objs[i].der_len;
+	}
+	for (i = 0; i < num_objs; i++) {
+		if (!CBB_add_bytes(&cbb, objs[i].der, objs[i].der_len))
+			errx(1, "CBB_add_bytes");
+	}
+
+	*out = NULL;
+	if (!CBB_finish(&cbb, out, out_len))
+		errx(1, "CBB_finish");
+}
+
+static void
+store_build_certs(struct fixture_certs *c, int leaves, uint8_t **out,
+    size_t *out_len)
+{
+	struct store_object *objs;
+	size_t i, num_objs;
+
+	num_objs = 2;
+	if (leaves)
+		num_objs += c->num_certs;
+	if ((objs = calloc(num_objs, sizeof(*objs))) == NULL)
+		err(1, NULL);
+	store_object_cert(&objs[0], c->ca);
+	store_object_crl(&objs[1], c->crl);
+	for (i = 2; i < num_objs; i++)
+		store_object_cert(&objs[i], c->certs[i - 2]);
+
+	store_build(objs, num_objs, out, out_len);
+
+	for (i = 0; i < num_objs; i++)
+		free(objs[i].der);
+	free(objs);
+}
+
+static void
+write_file(const char *path, const uint8_t *data, size_t data_len)
+{
+	FILE *fp;
+
+	if ((fp = fopen(path, "w")) == NULL)
+		err(1, "fopen %s", path);
+	if (data_len > 0 && fwrite(data, data_len, 1, fp) != 1)
+		err(1, "fwrite %s", path);
+	if (fclose(fp) != 0)
+		err(1, "fclose %s", path);
+}
+
+static void
+tmp_path(char *path, size_t path_len)
+{
+	int fd;
+
+	strlcpy(path, "/tmp/trust_store.XXXXXXXXXX", path_len);
+	if ((fd = mkstemp(path)) == -1)
+		err(1, "mkstemp");
+	close(fd);
+}
+
+static X509_STORE *
+store_new_mmap(const char *path)
+{
+	X509_STORE *store;
+	X509_LOOKUP *lookup;
+
+	if ((store = X509_STORE_new()) == NULL)
+		errx(1, "X509_STORE_new");
+	if ((lookup = X509_STORE_add_lookup(store, X509_LOOKUP_mmap())) == NULL)
+		errx(1, "X509_STORE_add_lookup");
+	if (!X509_LOOKUP_load_mmap(lookup, path))
+		errx(1, "X509_LOOKUP_load_mmap %s", path);
+
+	return store;
+}
+
+static int
+test_lazy_load(struct fixture_certs *c, const char *path)
+{
+	X509_STORE *store;
+	X509_STORE_CTX *ctx = NULL;
+	X509_OBJECT *obj = NULL;
+	X509_NAME *name;
+	int num, failed = 1;
+
+	store = store_new_mmap(path);
+
+	if ((num = sk_X509_OBJECT_num(X509_STORE_get0_objects(store))) != 0) {
+		fprintf(stderr, "FAIL: %d objects parsed on load\n", num);
+		goto failure;
+	}
+
+	if ((ctx = X509_STORE_CTX_new()) == NULL)
+		errx(1, "X509_STORE_CTX_new");
+	if (!X509_STORE_CTX_init(ctx, store, c->ca, NULL))
+		errx(1, "X509_STORE_CTX_init");
+
+	name = X509_get_subject_name(c->certs[10]);
+	if ((obj = X509_STORE_CTX_get_obj_by_subject(ctx, X509_LU_X509,
+	    name)) == NULL) {
+		fprintf(stderr, "FAIL: leaf not found\n");
+		goto failure;
+	}
+	if (X509_cmp(X509_OBJECT_get0_X509(obj), c->certs[10]) != 0) {
+		fprintf(stderr, "FAIL: found the wrong leaf\n");
+		goto failure;
+	}
+	X509_OBJECT_free(obj);
+	obj = NULL;
+
+	/* Only the objects with the hash that was looked up are parsed. */
+	if ((num = sk_X509_OBJECT_num(X509_STORE_get0_objects(store))) != 1) {
+		fprintf(stderr, "FAIL: %d objects parsed after one lookup\n",
+		    num);
+		goto failure;
+	}
+
+	/* Looking it up again is served by the store. */
+	if ((obj = X509_STORE_CTX_get_obj_by_subject(ctx, X509_LU_X509,
+	    name)) == NULL) {
+		fprintf(stderr, "FAIL: leaf not found again\n");
+		goto failure;
+	}
+	X509_OBJECT_free(obj);
+	obj = NULL;
+	if ((num = sk_X509_OBJECT_num(X509_STORE_get0_objects(store))) != 1) {
+		fprintf(stderr, "FAIL: %d objects after a second lookup\n",
+		    num);
+		goto failure;
+	}
+
+	/* No leaf is a CRL issuer, and the CA is no leaf. */
+	if ((obj = X509_STORE_CTX_get_obj_by_subject(ctx, X509_LU_CRL,
+	    name)) != NULL) {
+		fprintf(stderr, "FAIL: found a CRL issued by a leaf\n");
+		goto failure;
+	}
+	name = fixture_name_new("Trust Leaf 1000");
+	obj = X509_STORE_CTX_get_obj_by_subject(ctx, X509_LU_X509, name);
+	X509_NAME_free(name);
+	if (obj != NULL) {
+		fprintf(stderr, "FAIL: found a leaf that was not added\n");
+		goto failure;
+	}
+
+	failed = 0;
+
+ failure:
+	X509_OBJECT_free(obj);
+	X509_STORE_CTX_free(ctx);
+	X509_STORE_free(store);
+
+	return failed;
+}
+
+static int
+verify_leaf(X509_STORE *store, X509 *leaf, int want)
+{
+	X509_STORE_CTX *ctx;
+	int error, failed = 1;
+
+	if ((ctx = X509_STORE_CTX_new()) == NULL)
+		errx(1, "X509_STORE_CTX_new");
+	if (!X509_STORE_CTX_init(ctx, store, leaf, NULL))
+		errx(1, "X509_STORE_CTX_init");
+	X509_STORE_CTX_set_flags(ctx, X509_V_FLAG_CRL_CHECK);
+
+	X509_verify_cert(ctx);
+	if ((error = X509_STORE_CTX_get_error(ctx)) != want) {
+		fprintf(stderr, "FAIL: verify error %d (%s), want %d (%s)\n",
+		    error, X509_verify_cert_error_string(error), want,
+		    X509_verify_cert_error_string(want));
+		goto failure;
+	}
+
+	failed = 0;
+
+ failure:
+	X509_STORE_CTX_free(ctx);
+
+	return failed;
+}
+
+static int
+test_verify(struct fixture_certs *c, const char *path)
+{
+	X509_STORE *store;
+	uint8_t *data;
+	size_t data_len;
+	int failed = 0;
+
+	/* Only the root and the CRL, a leaf in the store would be trusted. */
+	store_build_certs(c, 0, &data, &data_len);
+	write_file(path, data, data_len);
+	free(data);
+
+	store = store_new_mmap(path);
+
+	failed |= verify_leaf(store, c->certs[0], X509_V_OK);
+	failed |= verify_leaf(store, c->certs[1], X509_V_ERR_CERT_REVOKED);
+	failed |= verify_leaf(store, c->certs[2], X509_V_OK);
+
+	X509_STORE_free(store);
+
+	return failed;
+}
+
+static void
+put_u32(uint8_t *p, uint32_t v)
+{
+	p[0] = v >> 24;
+	p[1] = v >> 16;
+	p[2] = v >> 8;
+	p[3] = v;
+}
+
+static uint32_t
+get_u32(const uint8_t *p)
+{
+	return (uint32_t)p[0] << 24 | p[1] << 16 | p[2] << 8 | p[3];
+}
+
+static int
+load_fails(const char *desc, const char *path, const uint8_t *data,
+    size_t data_len)
+{
+	X509_STORE *store;
+	X509_LOOKUP *lookup;
+	int failed = 0;
+
+	write_file(path, data, data_len);
+
+	if ((store = X509_STORE_new()) == NULL)
+		errx(1, "X509_STORE_new");
+	if ((lookup = X509_STORE_add_lookup(store, X509_LOOKUP_mmap())) == NULL)
+		errx(1, "X509_STORE_add_lookup");
+	if (X509_LOOKUP_load_mmap(lookup, path)) {
+		fprintf(stderr, "FAIL: loaded a store with %s\n", desc);
+		failed = 1;
+	}
+	ERR_clear_error();
+	X509_STORE_free(store);
+
+	return failed;
+}
+
+static int
+test_bad_files(const uint8_t *data, size_t data_len, const char *path)
+{
+	const size_t index_start = X509_TRUST_STORE_MAGIC_LEN + 4;
+	const size_t entry_len = X509_TRUST_STORE_ENTRY_LEN;
+	uint8_t *bad, tmp[X509_TRUST_STORE_ENTRY_LEN];
+	size_t last;
+	int failed = 0;
+
+	if ((bad = malloc(data_len)) == NULL)
+		err(1, NULL);
+
+	memcpy(bad, data, data_len);
+	bad[0] ^= 1;
+	failed |= load_fails("a bad magic", path, bad, data_len);
+
+	failed |= load_fails("no data", path, data, 0);
+	failed |= load_fails("a truncated header", path, data,
+	    index_start - 1);
+	failed |= load_fails("a truncated index", path, data,
+	    index_start + entry_len);
+
+	memcpy(bad, data, data_len);
+	put_u32(bad + index_start + 8, data_len);
+	failed |= load_fails("an offset past the end", path, bad, data_len);
+
+	memcpy(bad, data, data_len);
+	put_u32(bad + index_start + 8, 0);
+	failed |= load_fails("an offset into the header", path, bad, data_len);
+
+	memcpy(bad, data, data_len);
+	put_u32(bad + index_start + 12, data_len);
+	failed |= load_fails("a length past the end", path, bad, data_len);
+
+	memcpy(bad, data, data_len);
+	put_u32(bad + index_start, 3);
+	failed |= load_fails("an unknown type", path, bad, data_len);
+
+	/* The last entry is the CRL, which sorts after all certificates. */
+	memcpy(bad, data, data_len);
+	last = get_u32(bad + X509_TRUST_STORE_MAGIC_LEN) - 1;
+	memcpy(tmp, bad + index_start, entry_len);
+	memcpy(bad + index_start, bad + index_start + last * entry_len,
+	    entry_len);
+	memcpy(bad + index_start + last * entry_len, tmp, entry_len);
+	failed |= load_fails("an unsorted index", path, bad, data_len);
+
+	free(bad);
+
+	return failed;
+}
+
+/*
+ * The index is copied when the store is loaded, so rewriting it in the
+ * mapped file afterwards cannot make lookups read outside of the file.
+ */
+static int
+test_index_rewritten(struct fixture_certs *c, const uint8_t *data,
+    size_t data_len, const char *path)
+{
+	const size_t index_start = X509_TRUST_STORE_MAGIC_LEN + 4;
+	X509_STORE *store;
+	X509_STORE_CTX *ctx = NULL;
+	X509_OBJECT *obj = NULL;
+	uint8_t *bad;
+	size_t i, count;
+	int failed = 1;
+
+	write_file(path, data, data_len);
+	store = store_new_mmap(path);
+
+	if ((bad = malloc(data_len)) == NULL)
+		err(1, NULL);
+	memcpy(bad, data, data_len);
+	count = get_u32(bad + X509_TRUST_STORE_MAGIC_LEN);
+	for (i = 0; i < count; i++) {
+		put_u32(bad + index_start + i * X509_TRUST_STORE_ENTRY_LEN + 8,
+		    data_len - 1);
+		put_u32(bad + index_start + i * X509_TRUST_STORE_ENTRY_LEN + 12,
+		    data_len);
+	}
+	write_file(path, bad, data_len);
+
+	if ((ctx = X509_STORE_CTX_new()) == NULL)
+		errx(1, "X509_STORE_CTX_new");
+	if (!X509_STORE_CTX_init(ctx, store, c->ca, NULL))
+		errx(1, "X509_STORE_CTX_init");
+
+	if ((obj = X509_STORE_CTX_get_obj_by_subject(ctx, X509_LU_X509,
+	    X509_get_subject_name(c->certs[0]))) == NULL) {
+		fprintf(stderr, "FAIL: leaf not found after index rewrite\n");
+		goto failure;
+	}
+
+	failed = 0;
+
+ failure:
+	X509_OBJECT_free(obj);
+	X509_STORE_CTX_free(ctx);
+	X509_STORE_free(store);
+	free(bad);
+
+	return failed;
+}
+
+static int
+test_empty_store(const char *path)
+{
+	X509_STORE *store;
+	uint8_t *data;
+	size_t data_len;
+
+	store_build(NULL, 0, &data, &data_len);
+	write_file(path, data, data_len);
+	free(data);
+
+	/* An empty store is valid, it exits if loading fails. */
+	store = store_new_mmap(path);
+	X509_STORE_free(store);
+
+	return 0;
+}
+
+static double
+elapsed(const struct timespec *start)
+{
+	struct timespec end, duration;
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	timespecsub(&end, start, &duration);
+
+	return duration.tv_sec + duration.tv_nsec / 1000000000.0;
+}
+
+static void
+benchmark(void)
+{
+	struct store_object objs[BENCHMARK_ROOTS];
+	char bundle_path[64], store_path[64], subject[64];
+	struct fixture_cert fc;
+	struct timespec start;
+	X509 *roots[BENCHMARK_ROOTS];
+	X509_STORE *store;
+	X509_STORE_CTX *ctx;
+	X509_OBJECT *obj;
+	EVP_PKEY *key;
+	uint8_t *data;
+	size_t data_len;
+	FILE *fp;
+	int i;
+
+	tmp_path(bundle_path, sizeof(bundle_path));
+	tmp_path(store_path, sizeof(store_path));
+
+	if ((fp = fopen(bundle_path, "w")) == NULL)
+		err(1, "fopen");
+	for (i = 0; i < BENCHMARK_ROOTS; i++) {
+		snprintf(subject, sizeof(subject), "Trust Root %d", i);
+		key = fixture_key_new();
+		memset(&fc, 0, sizeof(fc));
+		fc.subject = subject;
+		fc.key = key;
+		fc.ca = 1;
+		roots[i] = fixture_cert_new(&fc);
+		EVP_PKEY_free(key);
+		if (!PEM_write_X509(fp, roots[i]))
+			errx(1, "PEM_write_X509");
+		store_object_cert(&objs[i], roots[i]);
+	}
+	if (fclose(fp) != 0)
+		err(1, "fclose");
+
+	store_build(objs, BENCHMARK_ROOTS, &data, &data_len);
+	write_file(store_path, data, data_len);
+	free(data);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < BENCHMARK_ROUNDS; i++) {
+		if ((store = X509_STORE_new()) == NULL)
+			errx(1, "X509_STORE_new");
+		if (!X509_STORE_load_locations(store, bundle_path, NULL))
+			errx(1, "X509_STORE_load_locations");
+		X509_STORE_free(store);
+	}
+	fprintf(stderr, "load %d root PEM bundle: %f ms\n", BENCHMARK_ROOTS,
+	    elapsed(&start) * 1000 / BENCHMARK_ROUNDS);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < BENCHMARK_ROUNDS; i++) {
+		store = store_new_mmap(store_path);
+		if ((ctx = X509_STORE_CTX_new()) == NULL)
+			errx(1, "X509_STORE_CTX_new");
+		if (!X509_STORE_CTX_init(ctx, store, NULL, NULL))
+			errx(1, "X509_STORE_CTX_init");
+		if ((obj = X509_STORE_CTX_get_obj_by_subject(ctx, X509_LU_X509,
+		    X509_get_subject_name(roots[i % BENCHMARK_ROOTS]))) == NULL)
+			errx(1, "X509_STORE_CTX_get_obj_by_subject");
+		X509_OBJECT_free(obj);
+		X509_STORE_CTX_free(ctx);
+		X509_STORE_free(store);
+	}
+	fprintf(stderr, "map %d root trust store and look up a root: %f ms\n",
+	    BENCHMARK_ROOTS, elapsed(&start) * 1000 / BENCHMARK_ROUNDS);
+
+	for (i = 0; i < BENCHMARK_ROOTS; i++) {
+		X509_free(roots[i]);
+		free(objs[i].der);
+	}
+	unlink(bundle_path);
+	unlink(store_path);
+}
+
+int
+main(int argc, char **argv)
+{
+	struct fixture_certs c;
+	char path[64];
+	uint8_t *data;
+	size_t data_len;
+	int failed = 0;
+
+	if (argc == 2 && strcmp(argv[1], "--benchmark") == 0) {
+		benchmark();
+		return 0;
+	}
+
+	certs_init(&c, TEST_LEAVES);
+	store_build_certs(&c, 1, &data, &data_len);
+
+	tmp_path(path, sizeof(path));
+	write_file(path, data, data_len);
+
+	failed |= test_lazy_load(&c, path);
+	failed |= test_bad_files(data, data_len, path);
+	failed |= test_verify(&c, path);
+	failed |= test_index_rewritten(&c, data, data_len, path);
+	failed |= test_empty_store(path);
+
+	unlink(path);
+	free(data);
+	fixture_certs_free(&c);
+
+	return failed;
+}
@@ -0,0 +1,317 @@
+/* $OpenBSD$ */
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * Verify chains against a large synthetic trust store, so that finding the
+ * issuer of a certificate among many roots and intermediates is exercised.
+ */
+
+#include <sys/time.h>
+
+#include <err.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/x509.h>
+
+#include "x509_fixtures.h"
+#include "x509_verify.h"
+
+#define NUM_ROOTS		1000
+#define NUM_INTERMEDIATES	200
+
+struct trust_store {
+	STACK_OF(X509) *roots;
+	STACK_OF(X509) *intermediates;
+	X509 *leaf;		/* Issued by the intermediate "Intermediate 0" */
+	X509 *orphan;		/* Issued by an unknown intermediate */
+	X509 *root;		/* The root that issued "Intermediate 0" */
+	EVP_PKEY *root_key;
+};
+
+/*
+ * Create a certificate for pkey with the given subject, issued by issuer
+ * with issuer_key. A NULL issuer creates a self-signed certificate.
+ */
+static X509 *
+make_cert(const char *subject, EVP_PKEY *pkey, const char *issuer_name,
+    X509 *issuer, EVP_PKEY *issuer_key, int is_ca)
+{
+	struct fixture_cert fc;
+
+	memset(&fc, 0, sizeof(fc));
+	fc.subject = subject;
+	fc.issuer = issuer_name;
+	fc.key = pkey;
+	fc.issuer_key = issuer_key;
+	fc.issuer_cert = issuer;
+	fc.ca = is_ca;
+	fc.key_id = 1;
+
+	return fixture_cert_new(&fc);
+}
+
+/*
+ * Build NUM_ROOTS roots and NUM_INTERMEDIATES intermediates. Two of the
+ * roots share the subject of the real root but have a different key, so
+ * that several candidates with the same name have to be considered.
+ */
+static void
+trust_store_init(struct trust_store *ts)
+{
+	EVP_PKEY *pkey, *int_key, *unknown_key;
+	X509 *cert, *intermediate;
+	char name[64];
+	size_t i;
+
+	memset(ts, 0, sizeof(*ts));
+
+	if ((ts->roots = sk_X509_new_null()) == NULL)
+		errx(1, "sk_X509_new_null");
+	if ((ts->intermediates = sk_X509_new_null()) == NULL)
+		errx(1, "sk_X509_new_null");
+
+	/* One key is shared by the unrelated roots to keep this fast. */
+	pkey = fixture_key_new();
+	ts->root_key = fixture_key_new();
+
+	for (i = 0; i < NUM_ROOTS; i++) {
+		snprintf(name, sizeof(name), "Test Root CA %zu", i);
+		if (i == NUM_ROOTS / 2 || i == NUM_ROOTS / 2 + 2)
+			snprintf(name, sizeof(name), "Test Root CA");
+		if (i == NUM_ROOTS / 2 + 1) {
+			cert = make_cert("Test Root CA", ts->root_key, NULL,
+			    NULL, NULL, 1);
+			ts->root = cert;
+		} else
+			cert = make_cert(name, pkey, NULL, NULL, NULL, 1);
+		if (!sk_X509_push(ts->roots, cert))
+			errx(1, "sk_X509_push");
+	}
+
+	int_key = fixture_key_new();
+	for (i = 0; i < NUM_INTERMEDIATES; i++) {
+		snprintf(name, sizeof(name), "Test Intermediate %zu",
+		    NUM_INTERMEDIATES - 1 - i);
+		if (i == NUM_INTERMEDIATES - 1)
+			cert = make_cert(name, int_key, "Test Root CA",
+			    ts->root, ts->root_key, 1);
+		else
+			cert = make_cert(name, pkey, "Test Root CA 0",
+			    NULL, pkey, 1);
+		if (!sk_X509_push(ts->intermediates, cert))
+			errx(1, "sk_X509_push");
+	}
+	intermediate = sk_X509_value(ts->intermediates, NUM_INTERMEDIATES - 1);
+
+	ts->leaf = make_cert("Test Leaf", pkey, "Test Intermediate 0",
+	    intermediate, int_key, 0);
+
+	unknown_key = fixture_key_new();
+	ts->orphan = make_cert("Test Orphan", pkey, "Test Unknown Intermediate",
+	    NULL, unknown_key, 0);
+
+	EVP_PKEY_free(pkey);
+	EVP_PKEY_free(int_key);
+	EVP_PKEY_free(unknown_key);
+}
+
+static void
+trust_store_free(struct trust_store *ts)
+{
+	sk_X509_pop_free(ts->roots, X509_free);
+	sk_X509_pop_free(ts->intermediates, X509_free);
+	X509_free(ts->leaf);
+	X509_free(ts->orphan);
+	EVP_PKEY_free(ts->root_key);
+}
+
+static int
+verify_modern(struct trust_store *ts, X509 *leaf, size_t *out_depth,
+    const char **out_error)
+{
+	struct x509_verify_ctx *ctx;
+	size_t chains;
+
+	if ((ctx = x509_verify_ctx_new(ts->roots)) == NULL)
+		errx(1, "x509_verify_ctx_new");
+	if (!x509_verify_ctx_set_intermediates(ctx, ts->intermediates))
+		errx(1, "x509_verify_ctx_set_intermediates");
+
+	chains = x509_verify(ctx, leaf, NULL);
+	*out_depth = x509_verify_ctx_error_depth(ctx);
+	*out_error = x509_verify_ctx_error_string(ctx);
+
+	x509_verify_ctx_free(ctx);
+
+	return chains;
+}
+
+static int
+verify_legacy(X509_STORE *store, struct trust_store *ts, X509 *leaf,
+    int *out_error)
+{
+	X509_STORE_CTX *xsc;
+	int ret;
+
+	if ((xsc = X509_STORE_CTX_new()) == NULL)
+		errx(1, "X509_STORE_CTX_new");
+	if (!X509_STORE_CTX_init(xsc, store, leaf, ts->intermediates))
+		errx(1, "X509_STORE_CTX_init");
+
+	ret = X509_verify_cert(xsc);
+	*out_error = X509_STORE_CTX_get_error(xsc);
+
+	X509_STORE_CTX_free(xsc);
+
+	return ret;
+}
+
+static X509_STORE *
+store_from_roots(STACK_OF(X509) *roots)
+{
+	X509_STORE *store;
+	int i;
+
+	if ((store = X509_STORE_new()) == NULL)
+		errx(1, "X509_STORE_new");
+	for (i = 0; i < sk_X509_num(roots); i++) {
+		if (!X509_STORE_add_cert(store, sk_X509_value(roots, i)))
+			errx(1, "X509_STORE_add_cert");
+	}
+
+	return store;
+}
+
+static int
+test_verify_index(struct trust_store *ts)
+{
+	const char *want_error, *modern_error;
+	X509_STORE *store;
+	size_t chains, depth;
+	int error, ret;
+	int failed = 1;
+
+	want_error = X509_verify_cert_error_string(
+	    X509_V_ERR_UNABLE_TO_GET_ISSUER_CERT_LOCALLY);
+
+	store = store_from_roots(ts->roots);
+
+	if ((chains = verify_modern(ts, ts->leaf, &depth,
+	    &modern_error)) != 1) {
+		fprintf(stderr, "FAIL: leaf got %zu chains, want 1 "
+		    "(%s at depth %zu)\n", chains, modern_error, depth);
+		goto failure;
+	}
+	if ((ret = verify_legacy(store, ts, ts->leaf, &error)) != 1) {
+		fprintf(stderr, "FAIL: legacy leaf verification returned %d, "
+		    "error %d\n", ret, error);
+		goto failure;
+	}
+
+	if ((chains = verify_modern(ts, ts->orphan, &depth,
+	    &modern_error)) != 0) {
+		fprintf(stderr, "FAIL: orphan got %zu chains, want 0\n",
+		    chains);
+		goto failure;
+	}
+	if (strcmp(modern_error, want_error) != 0 || depth != 0) {
+		fprintf(stderr, "FAIL: orphan got '%s' at depth %zu, "
+		    "want '%s' at depth 0\n", modern_error, depth, want_error);
+		goto failure;
+	}
+	if ((ret = verify_legacy(store, ts, ts->orphan, &error)) != 0) {
+		fprintf(stderr, "FAIL: legacy orphan verification returned "
+		    "%d\n", ret);
+		goto failure;
+	}
+	if (error != X509_V_ERR_UNABLE_TO_GET_ISSUER_CERT_LOCALLY) {
+		fprintf(stderr, "FAIL: legacy orphan got error %d, want %d\n",
+		    error, X509_V_ERR_UNABLE_TO_GET_ISSUER_CERT_LOCALLY);
+		goto failure;
+	}
+
+	failed = 0;
+
+ failure:
+	X509_STORE_free(store);
+
+	return failed;
+}
+
+#define BENCHMARK_ITERATIONS	1000
+
+static void
+benchmark_verify(struct trust_store *ts)
+{
+	struct timespec start, end, duration;
+	const char *modern_error;
+	X509_STORE *store;
+	size_t depth;
+	double secs;
+	int error;
+	int i;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < BENCHMARK_ITERATIONS; i++) {
+		if (verify_modern(ts, ts->leaf, &depth, &modern_error) != 1)
+			errx(1, "verify_modern");
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	timespecsub(&end, &start, &duration);
+	secs = duration.tv_sec + duration.tv_nsec / 1000000000.0;
+	fprintf(stderr, "x509_verify, %d roots, %d intermediates: "
+	    "%d in %f seconds, %.0f/s\n", NUM_ROOTS, NUM_INTERMEDIATES,
+	    BENCHMARK_ITERATIONS, secs, BENCHMARK_ITERATIONS / secs);
+
+	store = store_from_roots(ts->roots);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < BENCHMARK_ITERATIONS; i++) {
+		if (verify_legacy(store, ts, ts->leaf, &error) != 1)
+			errx(1, "verify_legacy");
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	timespecsub(&end, &start, &duration);
+	secs = duration.tv_sec + duration.tv_nsec / 1000000000.0;
+	fprintf(stderr, "X509_verify_cert, %d roots, %d intermediates: "
+	    "%d in %f seconds, %.0f/s\n", NUM_ROOTS, NUM_INTERMEDIATES,
+	    BENCHMARK_ITERATIONS, secs, BENCHMARK_ITERATIONS / secs);
+
+	X509_STORE_free(store);
+}
+
+int
+main(int argc, char **argv)
+{
+	struct trust_store ts;
+	int failed = 0;
+
+	trust_store_init(&ts);
+
+	failed |= test_verify_index(&ts);
+
+	if (argc == 2 && strcmp(argv[1], "--benchmark") == 0)
+		benchmark_verify(&ts);
+
+	trust_store_free(&ts);
+
+	return failed;
+}
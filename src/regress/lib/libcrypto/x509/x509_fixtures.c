@@ -0,0 +1,247 @@
+/* $OpenBSD$ */
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * Keys, certificates, CRLs and stores generated on the fly for the x509
+ * regress tests that need more of them than ../certs provides.
+ */
+
+#include <err.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <openssl/ec.h>
+#include <openssl/objects.h>
+#include <openssl/x509v3.h>
+
+#include "x509_fixtures.h"
+
+EVP_PKEY *
+fixture_key_new(void)
+{
+	EVP_PKEY *pkey;
+	EC_KEY *eckey;
+
+	if ((eckey = EC_KEY_new_by_curve_name(NID_X9_62_prime256v1)) == NULL)
+		errx(1, "EC_KEY_new_by_curve_name");
+	if (!EC_KEY_generate_key(eckey))
+		errx(1, "EC_KEY_generate_key");
+	if ((pkey = EVP_PKEY_new()) == NULL)
+		errx(1, "EVP_PKEY_new");
+	if (!EVP_PKEY_assign_EC_KEY(pkey, eckey))
+		errx(1, "EVP_PKEY_assign_EC_KEY");
+
+	return pkey;
+}
+
+X509_NAME *
+fixture_name_new(const char *cn)
+{
+	X509_NAME *name;
+
+	if ((name = X509_NAME_new()) == NULL)
+		errx(1, "X509_NAME_new");
+	if (!X509_NAME_add_entry_by_txt(name, "O", MBSTRING_ASC,
+	    "LibreSSL Regress", -1, -1, 0))
+		errx(1, "X509_NAME_add_entry_by_txt");
+	if (!X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC,
+	    cn, -1, -1, 0))
+		errx(1, "X509_NAME_add_entry_by_txt");
+
+	return name;
+}
+
+static void
+fixture_add_ext(X509 *cert, X509 *issuer, int nid, const char *value)
+{
+	X509V3_CTX v3ctx;
+	X509_EXTENSION *ext;
+
+	X509V3_set_ctx(&v3ctx, issuer, cert, NULL, NULL, 0);
+	if ((ext = X509V3_EXT_conf_nid(NULL, &v3ctx, nid, value)) == NULL)
+		errx(1, "X509V3_EXT_conf_nid");
+	if (!X509_add_ext(cert, ext, -1))
+		errx(1, "X509_add_ext");
+	X509_EXTENSION_free(ext);
+}
+
+X509 *
+fixture_cert_new(const struct fixture_cert *fc)
+{
+	static long serial = 1;
+	X509_NAME *name;
+	X509 *cert;
+	char san[256];
+	long not_before;
+
+	not_before = fc->not_before != 0 ? fc->not_before : -3600;
+
+	if ((cert = X509_new()) == NULL)
+		errx(1, "X509_new");
+	if (!X509_set_version(cert, 2))
+		errx(1, "X509_set_version");
+	if (!ASN1_INTEGER_set(X509_get_serialNumber(cert), serial++))
+		errx(1, "ASN1_INTEGER_set");
+	if (X509_gmtime_adj(X509_get_notBefore(cert), not_before) == NULL)
+		errx(1, "X509_gmtime_adj");
+	if (X509_gmtime_adj(X509_get_notAfter(cert), FIXTURE_VALIDITY) == NULL)
+		errx(1, "X509_gmtime_adj");
+
+	name = fixture_name_new(fc->subject);
+	if (!X509_set_subject_name(cert, name))
+		errx(1, "X509_set_subject_name");
+	X509_NAME_free(name);
+
+	name = fixture_name_new(fc->issuer != NULL ? fc->issuer : fc->subject);
+	if (!X509_set_issuer_name(cert, name))
+		errx(1, "X509_set_issuer_name");
+	X509_NAME_free(name);
+
+	if (!X509_set_pubkey(cert, fc->key))
+		errx(1, "X509_set_pubkey");
+
+	if (fc->key_id)
+		fixture_add_ext(cert, NULL, NID_subject_key_identifier, "hash");
+	if (fc->issuer_cert != NULL)
+		fixture_add_ext(cert, fc->issuer_cert,
+		    NID_authority_key_identifier, "keyid");
+	if (fc->ca) {
+		fixture_add_ext(cert, NULL, NID_basic_constraints,
+		    "critical,CA:TRUE");
+		fixture_add_ext(cert, NULL, NID_key_usage,
+		    "critical,keyCertSign,cRLSign");
+	}
+	if (fc->dns_name != NULL) {
+		snprintf(san, sizeof(san), "DNS:%s", fc->dns_name);
+		fixture_add_ext(cert, NULL, NID_subject_alt_name, san);
+	}
+
+	if (!X509_sign(cert, fc->issuer_key != NULL ? fc->issuer_key : fc->key,
+	    EVP_sha256()))
+		errx(1, "X509_sign");
+
+	return cert;
+}
+
+/* A CRL issued an hour ago that revokes the given certificates. */
+X509_CRL *
+fixture_crl_new(const char *issuer, EVP_PKEY *issuer_key, X509 **revoked,
+    int num_revoked)
+{
+	X509_REVOKED *rev;
+	X509_NAME *name;
+	X509_CRL *crl;
+	ASN1_TIME *t;
+	int i;
+
+	if ((crl = X509_CRL_new()) == NULL)
+		errx(1, "X509_CRL_new");
+	name = fixture_name_new(issuer);
+	if (!X509_CRL_set_issuer_name(crl, name))
+		errx(1, "X509_CRL_set_issuer_name");
+	X509_NAME_free(name);
+	if ((t = X509_gmtime_adj(NULL, -3600)) == NULL)
+		errx(1, "X509_gmtime_adj");
+	if (!X509_CRL_set1_lastUpdate(crl, t))
+		errx(1, "X509_CRL_set1_lastUpdate");
+
+	for (i = 0; i < num_revoked; i++) {
+		if ((rev = X509_REVOKED_new()) == NULL)
+			errx(1, "X509_REVOKED_new");
+		if (!X509_REVOKED_set_serialNumber(rev,
+		    X509_get_serialNumber(revoked[i])))
+			errx(1, "X509_REVOKED_set_serialNumber");
+		if (!X509_REVOKED_set_revocationDate(rev, t))
+			errx(1, "X509_REVOKED_set_revocationDate");
+		if (!X509_CRL_add0_revoked(crl, rev))
+			errx(1, "X509_CRL_add0_revoked");
+	}
+	ASN1_TIME_free(t);
+
+	if (!X509_CRL_sort(crl))
+		errx(1, "X509_CRL_sort");
+	if (!X509_CRL_sign(crl, issuer_key, EVP_sha256()))
+		errx(1, "X509_CRL_sign");
+
+	return crl;
+}
+
+X509_STORE *
+fixture_store_new(X509 **certs, int num_certs)
+{
+	X509_STORE *store;
+	int i;
+
+	if ((store = X509_STORE_new()) == NULL)
+		errx(1, "X509_STORE_new");
+	for (i = 0; i < num_certs; i++) {
+		if (!X509_STORE_add_cert(store, certs[i]))
+			errx(1, "X509_STORE_add_cert");
+	}
+
+	return store;
+}
+
+/*
+ * Certificate i has the subject cert_fmt formatted with
+ * i / certs_per_subject, so that names can be shared between certificates.
+ */
+void
+fixture_certs_init(struct fixture_certs *c, const char *ca_name,
+    const char *cert_fmt, int num_certs, int certs_per_subject)
+{
+	struct fixture_cert fc;
+	char subject[64];
+	int i;
+
+	memset(c, 0, sizeof(*c));
+
+	c->key = fixture_key_new();
+
+	memset(&fc, 0, sizeof(fc));
+	fc.subject = ca_name;
+	fc.key = c->key;
+	fc.ca = 1;
+	c->ca = fixture_cert_new(&fc);
+
+	if ((c->certs = calloc(num_certs, sizeof(*c->certs))) == NULL)
+		err(1, NULL);
+	for (i = 0; i < num_certs; i++) {
+		snprintf(subject, sizeof(subject), cert_fmt,
+		    i / certs_per_subject);
+		memset(&fc, 0, sizeof(fc));
+		fc.subject = subject;
+		fc.issuer = ca_name;
+		fc.key = c->key;
+		c->certs[i] = fixture_cert_new(&fc);
+	}
+	c->num_certs = num_certs;
+}
+
+void
+fixture_certs_free(struct fixture_certs *c)
+{
+	int i;
+
+	for (i = 0; i < c->num_certs; i++)
+		X509_free(c->certs[i]);
+	free(c->certs);
+	X509_free(c->ca);
+	X509_CRL_free(c->crl);
+	EVP_PKEY_free(c->key);
+}
@@ -0,0 +1,66 @@
+/* $OpenBSD$ */
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef HEADER_X509_FIXTURES_H
+#define HEADER_X509_FIXTURES_H
+
+#include <openssl/evp.h>
+#include <openssl/x509.h>
+
+/* Certificates are valid from not_before until a day from now. */
+#define FIXTURE_VALIDITY	86400
+
+/*
+ * Describes a certificate for fixture_cert_new(). Names have the form
+ * "O=LibreSSL Regress, CN=<name>". A NULL issuer or issuer_key makes the
+ * certificate self-issued or self-signed.
+ */
+struct fixture_cert {
+	const char *subject;
+	const char *issuer;
+	EVP_PKEY *key;
+	EVP_PKEY *issuer_key;
+	X509 *issuer_cert;	/* Adds an authority key identifier. */
+	long not_before;	/* Relative to now, -3600 if zero. */
+	int ca;			/* Basic constraints and key usage. */
+	int key_id;		/* Adds a subject key identifier. */
+	const char *dns_name;	/* Adds a subjectAltName. */
+};
+
+/*
+ * A self-signed CA and num_certs certificates issued by it, all with the
+ * same key. The caller may set crl, which is freed along with the rest.
+ */
+struct fixture_certs {
+	EVP_PKEY *key;
+	X509 *ca;
+	X509_CRL *crl;
+	X509 **certs;
+	int num_certs;
+};
+
+EVP_PKEY *fixture_key_new(void);
+X509_NAME *fixture_name_new(const char *cn);
+X509 *fixture_cert_new(const struct fixture_cert *fc);
+X509_CRL *fixture_crl_new(const char *issuer, EVP_PKEY *issuer_key,
+    X509 **revoked, int num_revoked);
+X509_STORE *fixture_store_new(X509 **certs, int num_certs);
+void fixture_certs_init(struct fixture_certs *c, const char *ca_name,
+    const char *cert_fmt, int num_certs, int certs_per_subject);
+void fixture_certs_free(struct fixture_certs *c);
+
+#endif /* HEADER_X509_FIXTURES_H */
@@ -0,0 +1,255 @@
+/* $OpenBSD$ */
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <err.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <openssl/ssl.h>
+
+#include "ssl_local.h"
+
+static int
+buffer_is_zero(const uint8_t *buf)
+{
+	size_t i;
+
+	for (i = 0; i < SSL_BUFFER_POOL_LEN; i++) {
+		if (buf[i] != 0)
+			return 0;
+	}
+
+	return 1;
+}
+
+static int
+test_buffer_pool(void)
+{
+	SSL_CTX *ctx;
+	uint8_t *buf1, *buf2;
+	int failed = 1;
+
+	if ((ctx = SSL_CTX_new(TLS_method())) == NULL)
+		errx(1, "SSL_CTX_new");
+
+	if (SSL_CTX_get_buffer_pool_size(ctx) != SSL_BUFFER_POOL_SIZE_DEFAULT) {
+		fprintf(stderr, "FAIL: pool size is %ld, want %d\n",
+		    SSL_CTX_get_buffer_pool_size(ctx),
+		    SSL_BUFFER_POOL_SIZE_DEFAULT);
+		goto failure;
+	}
+
+	if ((buf1 = ssl_buffer_pool_get(ctx->buffer_pool)) == NULL)
+		errx(1, "ssl_buffer_pool_get");
+	if (SSL_CTX_buffer_pool_hits(ctx) != 0 ||
+	    SSL_CTX_buffer_pool_misses(ctx) != 1) {
+		fprintf(stderr, "FAIL: empty pool did not miss\n");
+		goto failure;
+	}
+	memset(buf1, 0xa5, SSL_BUFFER_POOL_LEN);
+	ssl_buffer_pool_put(ctx->buffer_pool, buf1);
+
+	if ((buf2 = ssl_buffer_pool_get(ctx->buffer_pool)) == NULL)
+		errx(1, "ssl_buffer_pool_get");
+	if (buf2 != buf1 || SSL_CTX_buffer_pool_hits(ctx) != 1) {
+		fprintf(stderr, "FAIL: free buffer was not reused\n");
+		goto failure;
+	}
+	if (!buffer_is_zero(buf2)) {
+		fprintf(stderr, "FAIL: reused buffer was not cleared\n");
+		goto failure;
+	}
+	ssl_buffer_pool_put(ctx->buffer_pool, buf2);
+
+	/* A pool of size zero keeps nothing. */
+	if (SSL_CTX_set_buffer_pool_size(ctx, 0) !=
+	    SSL_BUFFER_POOL_SIZE_DEFAULT) {
+		fprintf(stderr, "FAIL: setting pool size\n");
+		goto failure;
+	}
+	if ((buf1 = ssl_buffer_pool_get(ctx->buffer_pool)) == NULL)
+		errx(1, "ssl_buffer_pool_get");
+	ssl_buffer_pool_put(ctx->buffer_pool, buf1);
+	if ((buf1 = ssl_buffer_pool_get(ctx->buffer_pool)) == NULL)
+		errx(1, "ssl_buffer_pool_get");
+	ssl_buffer_pool_put(ctx->buffer_pool, buf1);
+	if (SSL_CTX_buffer_pool_misses(ctx) != 2) {
+		fprintf(stderr, "FAIL: disabled pool misses are %ld, want 2\n",
+		    SSL_CTX_buffer_pool_misses(ctx));
+		goto failure;
+	}
+
+	failed = 0;
+
+ failure:
+	SSL_CTX_free(ctx);
+
+	return failed;
+}
+
+static int
+test_buffer_pool_ssl(void)
+{
+	SSL_CTX *ctx;
+	SSL *ssl1, *ssl2;
+	uint8_t *rbuf, *wbuf;
+	int failed = 1;
+
+	if ((ctx = SSL_CTX_new(TLS_method())) == NULL)
+		errx(1, "SSL_CTX_new");
+	if ((ssl1 = SSL_new(ctx)) == NULL)
+		errx(1, "SSL_new");
+	if ((ssl2 = SSL_new(ctx)) == NULL)
+		errx(1, "SSL_new");
+
+	if (!ssl3_setup_buffers(ssl1))
+		errx(1, "ssl3_setup_buffers");
+	rbuf = ssl1->s3->rbuf.buf;
+	wbuf = ssl1->s3->wbuf.buf;
+	if (ssl1->s3->rbuf.len != SSL_BUFFER_POOL_LEN ||
+	    ssl1->s3->wbuf.len != SSL_BUFFER_POOL_LEN) {
+		fprintf(stderr, "FAIL: record buffers not from pool\n");
+		goto failure;
+	}
+
+	/* An idle connection hands its buffers to the next one. */
+	ssl3_release_read_buffer(ssl1);
+	ssl3_release_write_buffer(ssl1);
+	if (!ssl3_setup_buffers(ssl2))
+		errx(1, "ssl3_setup_buffers");
+	if ((ssl2->s3->rbuf.buf != rbuf && ssl2->s3->rbuf.buf != wbuf) ||
+	    (ssl2->s3->wbuf.buf != rbuf && ssl2->s3->wbuf.buf != wbuf)) {
+		fprintf(stderr, "FAIL: released buffers were not reused\n");
+		goto failure;
+	}
+	if (SSL_CTX_buffer_pool_hits(ctx) != 2 ||
+	    SSL_CTX_buffer_pool_misses(ctx) != 2) {
+		fprintf(stderr, "FAIL: pool hits %ld misses %ld, want 2 2\n",
+		    SSL_CTX_buffer_pool_hits(ctx),
+		    SSL_CTX_buffer_pool_misses(ctx));
+		goto failure;
+	}
+
+	failed = 0;
+
+ failure:
+	SSL_free(ssl1);
+	SSL_free(ssl2);
+	SSL_CTX_free(ctx);
+
+	return failed;
+}
+
+#define TEST_THREADS		8
+#define TEST_ROUNDS		1000
+
+static void *
+pool_thread(void *arg)
+{
+	SSL_CTX *ctx = arg;
+	uint8_t *bufs[8];
+	size_t i, j;
+
+	for (i = 0; i < TEST_ROUNDS; i++) {
+		for (j = 0; j < 8; j++) {
+			if ((bufs[j] = ssl_buffer_pool_get(
+			    ctx->buffer_pool)) == NULL)
+				errx(1, "ssl_buffer_pool_get");
+			bufs[j][j] = j;
+		}
+		for (j = 0; j < 8; j++)
+			ssl_buffer_pool_put(ctx->buffer_pool, bufs[j]);
+	}
+
+	return NULL;
+}
+
+static int
+test_buffer_pool_threads(void)
+{
+	pthread_t threads[TEST_THREADS];
+	SSL_CTX *ctx, *ctx2;
+	uint8_t *buf;
+	long hits, misses;
+	int failed = 0;
+	int i;
+
+	if ((ctx = SSL_CTX_new(TLS_method())) == NULL)
+		errx(1, "SSL_CTX_new");
+
+	for (i = 0; i < TEST_THREADS; i++) {
+		if (pthread_create(&threads[i], NULL, pool_thread, ctx) != 0)
+			errx(1, "pthread_create");
+	}
+	for (i = 0; i < TEST_THREADS; i++)
+		pthread_join(threads[i], NULL);
+
+	hits = SSL_CTX_buffer_pool_hits(ctx);
+	misses = SSL_CTX_buffer_pool_misses(ctx);
+	if (hits + misses != TEST_THREADS * TEST_ROUNDS * 8) {
+		fprintf(stderr, "FAIL: %ld hits and %ld misses, want %d\n",
+		    hits, misses, TEST_THREADS * TEST_ROUNDS * 8);
+		failed = 1;
+	}
+	if (misses > TEST_THREADS * 8) {
+		fprintf(stderr, "FAIL: %ld misses, want at most %d\n",
+		    misses, TEST_THREADS * 8);
+		failed = 1;
+	}
+
+	/* Exited threads left their free buffers in the shared list. */
+	if ((buf = ssl_buffer_pool_get(ctx->buffer_pool)) == NULL)
+		errx(1, "ssl_buffer_pool_get");
+	if (SSL_CTX_buffer_pool_hits(ctx) != hits + 1) {
+		fprintf(stderr, "FAIL: buffers of exited threads were lost\n");
+		failed = 1;
+	}
+
+	/*
+	 * Keep a free buffer for this thread while the SSL_CTX goes away,
+	 * then use another pool.
+	 */
+	ssl_buffer_pool_put(ctx->buffer_pool, buf);
+	SSL_CTX_free(ctx);
+
+	if ((ctx2 = SSL_CTX_new(TLS_method())) == NULL)
+		errx(1, "SSL_CTX_new");
+	if ((buf = ssl_buffer_pool_get(ctx2->buffer_pool)) == NULL)
+		errx(1, "ssl_buffer_pool_get");
+	if (SSL_CTX_buffer_pool_misses(ctx2) != 1) {
+		fprintf(stderr, "FAIL: buffer came from the wrong pool\n");
+		failed = 1;
+	}
+	ssl_buffer_pool_put(ctx2->buffer_pool, buf);
+	SSL_CTX_free(ctx2);
+
+	return failed;
+}
+
+int
+main(int argc, char **argv)
+{
+	int failed = 0;
+
+	failed |= test_buffer_pool();
+	failed |= test_buffer_pool_ssl();
+	failed |= test_buffer_pool_threads();
+
+	return failed;
+}
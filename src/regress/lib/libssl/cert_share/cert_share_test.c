@@ -0,0 +1,385 @@
+/* $OpenBSD$ */
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <err.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <openssl/ssl.h>
+#include <openssl/x509v3.h>
+
+#include "ssl_local.h"
+
+static SSL_CTX *
+ctx_new(const char *name)
+{
+	char *file;
+	SSL_CTX *ctx;
+
+	if ((ctx = SSL_CTX_new(TLS_server_method())) == NULL)
+		errx(1, "SSL_CTX_new");
+
+	if (asprintf(&file, "%s/%s", CERTSDIR, name) == -1)
+		errx(1, "asprintf");
+	if (SSL_CTX_use_certificate_file(ctx, file, SSL_FILETYPE_PEM) != 1)
+		errx(1, "failed to load certificate from %s", file);
+	if (SSL_CTX_use_PrivateKey_file(ctx, file, SSL_FILETYPE_PEM) != 1)
+		errx(1, "failed to load private key from %s", file);
+	free(file);
+
+	return ctx;
+}
+
+static int
+ssl_use_cert(SSL *ssl, const char *name)
+{
+	char *file;
+	int ret;
+
+	if (asprintf(&file, "%s/%s", CERTSDIR, name) == -1)
+		errx(1, "asprintf");
+	ret = SSL_use_certificate_file(ssl, file, SSL_FILETYPE_PEM) == 1 &&
+	    SSL_use_PrivateKey_file(ssl, file, SSL_FILETYPE_PEM) == 1;
+	free(file);
+
+	return ret;
+}
+
+static int
+test_cert_share(void)
+{
+	SSL_CTX *ctx = NULL, *ctx2 = NULL;
+	SSL *ssl1 = NULL, *ssl2 = NULL, *ssl3 = NULL;
+	X509 *ctx_x509;
+	int failed = 1;
+
+	ctx = ctx_new("server1-rsa.pem");
+	ctx2 = ctx_new("server2-ecdsa.pem");
+	ctx_x509 = SSL_CTX_get0_certificate(ctx);
+
+	if ((ssl1 = SSL_new(ctx)) == NULL)
+		errx(1, "SSL_new");
+	if ((ssl2 = SSL_new(ctx)) == NULL)
+		errx(1, "SSL_new");
+
+	if (ssl1->cert != ctx->cert || ssl2->cert != ctx->cert) {
+		fprintf(stderr, "FAIL: SSL_new copied the certificate\n");
+		goto failure;
+	}
+	if (SSL_get_certificate(ssl1) != ctx_x509) {
+		fprintf(stderr, "FAIL: SSL does not use SSL_CTX certificate\n");
+		goto failure;
+	}
+
+	/* Changing the certificate of an SSL must leave the others alone. */
+	if (!ssl_use_cert(ssl1, "server2-rsa.pem")) {
+		fprintf(stderr, "FAIL: failed to set SSL certificate\n");
+		goto failure;
+	}
+	if (ssl1->cert == ctx->cert) {
+		fprintf(stderr, "FAIL: SSL certificate not copied on write\n");
+		goto failure;
+	}
+	if (SSL_get_certificate(ssl1) == ctx_x509) {
+		fprintf(stderr, "FAIL: SSL certificate was not changed\n");
+		goto failure;
+	}
+	if (SSL_CTX_get0_certificate(ctx) != ctx_x509 ||
+	    SSL_get_certificate(ssl2) != ctx_x509) {
+		fprintf(stderr, "FAIL: shared certificate was changed\n");
+		goto failure;
+	}
+	if (SSL_check_private_key(ssl1) != 1) {
+		fprintf(stderr, "FAIL: SSL private key does not match\n");
+		goto failure;
+	}
+
+	/* Existing SSLs keep the certificate they were created with. */
+	if (!SSL_CTX_use_certificate_chain_file(ctx,
+	    CERTSDIR "/server3-rsa.pem")) {
+		fprintf(stderr, "FAIL: failed to set SSL_CTX certificate\n");
+		goto failure;
+	}
+	if (SSL_get_certificate(ssl2) != ctx_x509) {
+		fprintf(stderr, "FAIL: SSL_CTX change leaked into SSL\n");
+		goto failure;
+	}
+	if ((ssl3 = SSL_new(ctx)) == NULL)
+		errx(1, "SSL_new");
+	if (SSL_get_certificate(ssl3) != SSL_CTX_get0_certificate(ctx) ||
+	    SSL_get_certificate(ssl3) == ctx_x509) {
+		fprintf(stderr, "FAIL: new SSL does not use new certificate\n");
+		goto failure;
+	}
+
+	SSL_set_security_level(ssl3, 0);
+	if (SSL_CTX_get_security_level(ctx) == 0 ||
+	    ssl3->cert == ctx->cert) {
+		fprintf(stderr, "FAIL: security level set on shared cert\n");
+		goto failure;
+	}
+
+	/* SNI style context switches share the new certificate. */
+	if (SSL_set_SSL_CTX(ssl2, ctx2) != ctx2) {
+		fprintf(stderr, "FAIL: SSL_set_SSL_CTX\n");
+		goto failure;
+	}
+	if (ssl2->cert != ctx2->cert ||
+	    SSL_get_certificate(ssl2) != SSL_CTX_get0_certificate(ctx2)) {
+		fprintf(stderr, "FAIL: SSL_set_SSL_CTX did not share cert\n");
+		goto failure;
+	}
+	if (SSL_set_SSL_CTX(ssl2, NULL) != ctx ||
+	    ssl2->cert != ctx->cert) {
+		fprintf(stderr, "FAIL: SSL_set_SSL_CTX back to initial\n");
+		goto failure;
+	}
+
+	failed = 0;
+
+ failure:
+	SSL_free(ssl1);
+	SSL_free(ssl2);
+	SSL_free(ssl3);
+	SSL_CTX_free(ctx);
+	SSL_CTX_free(ctx2);
+
+	return failed;
+}
+
+static int
+test_param_share(void)
+{
+	SSL_CTX *ctx;
+	SSL *ssl1 = NULL, *ssl2 = NULL;
+	int failed = 1;
+
+	if ((ctx = SSL_CTX_new(TLS_method())) == NULL)
+		errx(1, "SSL_CTX_new");
+	SSL_CTX_set_verify_depth(ctx, 5);
+
+	if ((ssl1 = SSL_new(ctx)) == NULL)
+		errx(1, "SSL_new");
+	if ((ssl2 = SSL_new(ctx)) == NULL)
+		errx(1, "SSL_new");
+
+	if (ssl1->param != NULL) {
+		fprintf(stderr, "FAIL: SSL_new allocated verify params\n");
+		goto failure;
+	}
+	if (SSL_get_verify_depth(ssl1) != 5) {
+		fprintf(stderr, "FAIL: verify depth is %d, want 5\n",
+		    SSL_get_verify_depth(ssl1));
+		goto failure;
+	}
+
+	SSL_set_verify_depth(ssl1, 2);
+	if (SSL_get_verify_depth(ssl1) != 2 ||
+	    SSL_get_verify_depth(ssl2) != 5 ||
+	    SSL_CTX_get_verify_depth(ctx) != 5) {
+		fprintf(stderr, "FAIL: verify depth not set on SSL only\n");
+		goto failure;
+	}
+	if (SSL_set1_host(ssl1, "www.example.com") != 1) {
+		fprintf(stderr, "FAIL: SSL_set1_host\n");
+		goto failure;
+	}
+	if (ssl2->param != NULL) {
+		fprintf(stderr, "FAIL: verify params changed on other SSL\n");
+		goto failure;
+	}
+
+	/* Existing SSLs keep the SSL_CTX parameters they started with. */
+	SSL_CTX_set_verify_depth(ctx, 7);
+	if (SSL_CTX_set_purpose(ctx, X509_PURPOSE_SSL_CLIENT) != 1)
+		errx(1, "SSL_CTX_set_purpose");
+	if (SSL_CTX_get_verify_depth(ctx) != 7 ||
+	    SSL_get_verify_depth(ssl2) != 5 ||
+	    ssl_get0_param(ssl2) == SSL_CTX_get0_param(ctx)) {
+		fprintf(stderr, "FAIL: SSL_CTX verify params changed on SSL\n");
+		goto failure;
+	}
+	if (SSL_get_verify_depth(ssl1) != 2) {
+		fprintf(stderr, "FAIL: SSL verify params changed by SSL_CTX\n");
+		goto failure;
+	}
+
+	/* SSL_get0_param() hands out parameters that may be modified. */
+	if (SSL_get0_param(ssl2) == NULL ||
+	    SSL_get0_param(ssl2) == SSL_CTX_get0_param(ctx)) {
+		fprintf(stderr, "FAIL: SSL_get0_param returned shared params\n");
+		goto failure;
+	}
+
+	failed = 0;
+
+ failure:
+	SSL_free(ssl1);
+	SSL_free(ssl2);
+	SSL_CTX_free(ctx);
+
+	return failed;
+}
+
+static int
+test_groups_share(void)
+{
+	SSL_CTX *ctx;
+	SSL *ssl = NULL;
+	const uint16_t *groups;
+	size_t groups_len;
+	int failed = 1;
+
+	if ((ctx = SSL_CTX_new(TLS_method())) == NULL)
+		errx(1, "SSL_CTX_new");
+	if (SSL_CTX_set1_groups_list(ctx, "P-384:P-256") != 1)
+		errx(1, "SSL_CTX_set1_groups_list");
+
+	if ((ssl = SSL_new(ctx)) == NULL)
+		errx(1, "SSL_new");
+
+	if (ssl->tlsext_supportedgroups != NULL) {
+		fprintf(stderr, "FAIL: SSL_new copied the group list\n");
+		goto failure;
+	}
+	tls1_get_group_list(ssl, 0, &groups, &groups_len);
+	if (groups_len != 2 || groups[0] != 24 || groups[1] != 23) {
+		fprintf(stderr, "FAIL: SSL does not use SSL_CTX group list\n");
+		goto failure;
+	}
+
+	/* An existing SSL keeps the SSL_CTX group list it started with. */
+	if (SSL_CTX_set1_groups_list(ctx, "P-521") != 1)
+		errx(1, "SSL_CTX_set1_groups_list");
+	tls1_get_group_list(ssl, 0, &groups, &groups_len);
+	if (groups_len != 2 || groups[0] != 24 || groups[1] != 23) {
+		fprintf(stderr, "FAIL: SSL_CTX group list changed on SSL\n");
+		goto failure;
+	}
+
+	if (SSL_set1_groups_list(ssl, "X25519") != 1)
+		errx(1, "SSL_set1_groups_list");
+	tls1_get_group_list(ssl, 0, &groups, &groups_len);
+	if (groups_len != 1 || groups[0] != 29) {
+		fprintf(stderr, "FAIL: SSL does not use its own group list\n");
+		goto failure;
+	}
+	if (ctx->params->tlsext_supportedgroups_length != 1 ||
+	    ctx->params->tlsext_supportedgroups[0] != 25) {
+		fprintf(stderr, "FAIL: SSL_CTX group list was changed\n");
+		goto failure;
+	}
+
+	failed = 0;
+
+ failure:
+	SSL_free(ssl);
+	SSL_CTX_free(ctx);
+
+	return failed;
+}
+
+static int
+check_security_levels(SSL_CTX *ctx, SSL *ssl1, SSL *ssl2, int want_ctx,
+    int want_ssl1, int want_ssl2)
+{
+	if (SSL_CTX_get_security_level(ctx) != want_ctx) {
+		fprintf(stderr, "FAIL: SSL_CTX security level %d, want %d\n",
+		    SSL_CTX_get_security_level(ctx), want_ctx);
+		return 1;
+	}
+	if (SSL_get_security_level(ssl1) != want_ssl1) {
+		fprintf(stderr, "FAIL: first SSL security level %d, want %d\n",
+		    SSL_get_security_level(ssl1), want_ssl1);
+		return 1;
+	}
+	if (SSL_get_security_level(ssl2) != want_ssl2) {
+		fprintf(stderr, "FAIL: second SSL security level %d, want %d\n",
+		    SSL_get_security_level(ssl2), want_ssl2);
+		return 1;
+	}
+
+	return 0;
+}
+
+static int
+test_seclevel_share(void)
+{
+	SSL_CTX *ctx;
+	SSL *ssl1 = NULL, *ssl2 = NULL;
+	int failed = 1;
+
+	ctx = ctx_new("server1-rsa.pem");
+	SSL_CTX_set_security_level(ctx, 1);
+
+	if ((ssl1 = SSL_new(ctx)) == NULL)
+		errx(1, "SSL_new");
+	if ((ssl2 = SSL_new(ctx)) == NULL)
+		errx(1, "SSL_new");
+
+	/* @SECLEVEL on one SSL must not change the SSL_CTX or its siblings. */
+	if (SSL_set_cipher_list(ssl1, "ALL:@SECLEVEL=3") != 1)
+		errx(1, "SSL_set_cipher_list");
+	if (check_security_levels(ctx, ssl1, ssl2, 1, 3, 1))
+		goto failure;
+	if (ssl1->cert == ctx->cert) {
+		fprintf(stderr, "FAIL: SSL still shares the SSL_CTX cert\n");
+		goto failure;
+	}
+
+	/* Nor on the SSL_CTX for the SSLs that already exist. */
+	if (SSL_CTX_set_cipher_list(ctx, "ALL:@SECLEVEL=2") != 1)
+		errx(1, "SSL_CTX_set_cipher_list");
+	if (check_security_levels(ctx, ssl1, ssl2, 2, 3, 1))
+		goto failure;
+
+	/* Without @SECLEVEL the cert stays shared. */
+	SSL_free(ssl2);
+	if ((ssl2 = SSL_new(ctx)) == NULL)
+		errx(1, "SSL_new");
+	if (SSL_set_cipher_list(ssl2, "ALL") != 1)
+		errx(1, "SSL_set_cipher_list");
+	if (ssl2->cert != ctx->cert) {
+		fprintf(stderr, "FAIL: cipher list without @SECLEVEL "
+		    "unshared the cert\n");
+		goto failure;
+	}
+	if (check_security_levels(ctx, ssl1, ssl2, 2, 3, 2))
+		goto failure;
+
+	failed = 0;
+
+ failure:
+	SSL_free(ssl1);
+	SSL_free(ssl2);
+	SSL_CTX_free(ctx);
+
+	return failed;
+}
+
+int
+main(int argc, char **argv)
+{
+	int failed = 0;
+
+	failed |= test_cert_share();
+	failed |= test_param_share();
+	failed |= test_groups_share();
+	failed |= test_seclevel_share();
+
+	return failed;
+}
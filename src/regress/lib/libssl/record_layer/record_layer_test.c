@@ -15,8 +15,13 @@
  * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  */
 
+#include <sys/time.h>
+
 #include <err.h>
+#include <signal.h>
 #include <string.h>
+#include <time.h>
+#include <unistd.h>
 
 #include "ssl_local.h"
 #include "tls13_internal.h"
@@ -26,6 +31,53 @@ int tls12_record_layer_inc_seq_num(struct tls12_record_layer *rl,
     uint8_t *seq_num);
 int tls13_record_layer_inc_seq_num(uint8_t *seq_num);
 
+/*
+ * Allocation counting - the Makefile links this test with the allocator
+ * functions wrapped, so that allocations made by libssl can be counted.
+ */
+static size_t alloc_count;
+
+void *__real_malloc(size_t);
+void *__real_calloc(size_t, size_t);
+void *__real_realloc(void *, size_t);
+void *__real_reallocarray(void *, size_t, size_t);
+void *__real_recallocarray(void *, size_t, size_t, size_t);
+
+void *
+__wrap_malloc(size_t size)
+{
+	alloc_count++;
+	return __real_malloc(size);
+}
+
+void *
+__wrap_calloc(size_t nmemb, size_t size)
+{
+	alloc_count++;
+	return __real_calloc(nmemb, size);
+}
+
+void *
+__wrap_realloc(void *ptr, size_t size)
+{
+	alloc_count++;
+	return __real_realloc(ptr, size);
+}
+
+void *
+__wrap_reallocarray(void *ptr, size_t nmemb, size_t size)
+{
+	alloc_count++;
+	return __real_reallocarray(ptr, nmemb, size);
+}
+
+void *
+__wrap_recallocarray(void *ptr, size_t oldnmemb, size_t nmemb, size_t size)
+{
+	alloc_count++;
+	return __real_recallocarray(ptr, oldnmemb, nmemb, size);
+}
+
 static void
 hexdump(const unsigned char *buf, size_t len)
 {
@@ -294,13 +346,287 @@ test_seq_num_tls13(void)
 	return failed;
 }
 
+#define WIRE_BUF_LEN (4 * TLS13_RECORD_MAX_LEN)
+
+struct wire_buf {
+	uint8_t data[WIRE_BUF_LEN];
+	size_t len;
+	size_t offset;
+	int discard;
+};
+
+static ssize_t
+wire_read(void *buf, size_t n, void *arg)
+{
+	struct wire_buf *wb = arg;
+
+	if (wb->offset == wb->len)
+		return TLS13_IO_WANT_POLLIN;
+	if (n > wb->len - wb->offset)
+		n = wb->len - wb->offset;
+
+	memcpy(buf, &wb->data[wb->offset], n);
+	wb->offset += n;
+
+	return n;
+}
+
+static ssize_t
+wire_write(const void *buf, size_t n, void *arg)
+{
+	struct wire_buf *wb = arg;
+
+	if (wb->discard)
+		return n;
+	if (n > sizeof(wb->data) - wb->len)
+		return TLS13_IO_WANT_POLLOUT;
+
+	memcpy(&wb->data[wb->len], buf, n);
+	wb->len += n;
+
+	return n;
+}
+
+static ssize_t
+wire_flush(void *arg)
+{
+	return TLS13_IO_SUCCESS;
+}
+
+static const struct tls13_record_layer_callbacks tls13_test_callbacks = {
+	.wire_read = wire_read,
+	.wire_write = wire_write,
+	.wire_flush = wire_flush,
+};
+
+static uint8_t tls13_test_traffic_secret[32] = {
+	0x3f, 0xce, 0x51, 0x60, 0x09, 0xc2, 0x17, 0x27,
+	0xd0, 0xf2, 0xe4, 0xe8, 0x6e, 0xe4, 0x03, 0xbc,
+	0x5d, 0x34, 0x3b, 0x47, 0x54, 0x97, 0xed, 0x4b,
+	0x17, 0xf4, 0x6d, 0x96, 0x10, 0x57, 0x84, 0xe3,
+};
+
+static struct tls13_record_layer *
+tls13_test_record_layer(const EVP_AEAD *aead, struct wire_buf *wb, int write)
+{
+	struct tls13_secret secret = {
+		.data = tls13_test_traffic_secret,
+		.len = sizeof(tls13_test_traffic_secret),
+	};
+	struct tls13_record_layer *rl;
+
+	if ((rl = tls13_record_layer_new(&tls13_test_callbacks, wb)) == NULL)
+		errx(1, "tls13_record_layer_new");
+
+	tls13_record_layer_set_aead(rl, aead);
+	tls13_record_layer_set_hash(rl, EVP_sha256());
+
+	if (write) {
+		if (!tls13_record_layer_set_write_traffic_key(rl, &secret,
+		    ssl_encryption_application))
+			errx(1, "tls13_record_layer_set_write_traffic_key");
+	} else {
+		if (!tls13_record_layer_set_read_traffic_key(rl, &secret,
+		    ssl_encryption_application))
+			errx(1, "tls13_record_layer_set_read_traffic_key");
+	}
+
+	tls13_record_layer_handshake_completed(rl);
+
+	return rl;
+}
+
+static const size_t tls13_seal_test_lens[] = {
+	1, 15, 16, 17, 255, 1024, 4096, 16383, 16384, 16385, 40000,
+};
+
+#define N_TLS13_SEAL_TEST_LENS \
+    (sizeof(tls13_seal_test_lens) / sizeof(tls13_seal_test_lens[0]))
+
+static int
+do_seal_test_tls13(const EVP_AEAD *aead, const char *name, size_t len)
+{
+	struct tls13_record_layer *rrl = NULL, *wrl = NULL;
+	struct wire_buf *wb = NULL;
+	uint8_t *in = NULL, *out = NULL;
+	size_t rec_len, total;
+	ssize_t ret;
+	int failed = 1;
+
+	if ((wb = calloc(1, sizeof(*wb))) == NULL)
+		errx(1, "calloc");
+	if ((in = malloc(len + 1)) == NULL)
+		errx(1, "malloc");
+	if ((out = calloc(1, len + 1)) == NULL)
+		errx(1, "calloc");
+	arc4random_buf(in, len + 1);
+
+	wrl = tls13_test_record_layer(aead, wb, 1);
+	rrl = tls13_test_record_layer(aead, wb, 0);
+
+	for (total = 0; total < len; total += ret) {
+		if ((ret = tls13_write_application_data(wrl, &in[total],
+		    len - total)) <= 0) {
+			fprintf(stderr, "FAIL: %s %zu - write returned %zd\n",
+			    name, len, ret);
+			goto failure;
+		}
+	}
+
+	/* Each record carries at most 2^14 bytes of content. */
+	rec_len = (len / TLS13_RECORD_MAX_PLAINTEXT_LEN) *
+	    (TLS13_RECORD_MAX_PLAINTEXT_LEN + 1 + EVP_AEAD_max_tag_len(aead) +
+	    TLS13_RECORD_HEADER_LEN);
+	if (len % TLS13_RECORD_MAX_PLAINTEXT_LEN != 0)
+		rec_len += (len % TLS13_RECORD_MAX_PLAINTEXT_LEN) + 1 +
+		    EVP_AEAD_max_tag_len(aead) + TLS13_RECORD_HEADER_LEN;
+	if (wb->len != rec_len) {
+		fprintf(stderr, "FAIL: %s %zu - got %zu bytes on the wire, "
+		    "want %zu\n", name, len, wb->len, rec_len);
+		goto failure;
+	}
+	if (wb->data[0] != SSL3_RT_APPLICATION_DATA ||
+	    wb->data[1] != 0x03 || wb->data[2] != 0x03) {
+		fprintf(stderr, "FAIL: %s %zu - bad record header:\n",
+		    name, len);
+		hexdump(wb->data, TLS13_RECORD_HEADER_LEN);
+		goto failure;
+	}
+
+	for (total = 0; total < len; total += ret) {
+		if ((ret = tls13_read_application_data(rrl, &out[total],
+		    len + 1 - total)) <= 0) {
+			fprintf(stderr, "FAIL: %s %zu - read returned %zd\n",
+			    name, len, ret);
+			goto failure;
+		}
+	}
+	if (total != len) {
+		fprintf(stderr, "FAIL: %s %zu - read %zu bytes\n",
+		    name, len, total);
+		goto failure;
+	}
+	if (memcmp(in, out, len) != 0) {
+		fprintf(stderr, "FAIL: %s %zu - content differs\n", name, len);
+		goto failure;
+	}
+
+	failed = 0;
+
+ failure:
+	tls13_record_layer_free(rrl);
+	tls13_record_layer_free(wrl);
+	free(wb);
+	free(in);
+	free(out);
+
+	return failed;
+}
+
+static int
+test_seal_tls13(void)
+{
+	int failed = 0;
+	size_t i;
+
+	fprintf(stderr, "Running TLSv1.3 record sealing tests...\n");
+
+	for (i = 0; i < N_TLS13_SEAL_TEST_LENS; i++) {
+		failed |= do_seal_test_tls13(EVP_aead_aes_128_gcm(),
+		    "AES-128-GCM", tls13_seal_test_lens[i]);
+		failed |= do_seal_test_tls13(EVP_aead_aes_256_gcm(),
+		    "AES-256-GCM", tls13_seal_test_lens[i]);
+		failed |= do_seal_test_tls13(EVP_aead_chacha20_poly1305(),
+		    "ChaCha20-Poly1305", tls13_seal_test_lens[i]);
+	}
+
+	return failed;
+}
+
+static volatile sig_atomic_t benchmark_stop;
+
+static void
+benchmark_sig_alarm(int sig)
+{
+	benchmark_stop = 1;
+}
+
+static void
+benchmark_seal_tls13(const EVP_AEAD *aead, const char *name, size_t len,
+    int seconds)
+{
+	struct timespec start, end, duration;
+	struct tls13_record_layer *rl;
+	struct wire_buf *wb;
+	uint8_t *buf;
+	size_t allocs, records;
+	double secs;
+
+	if ((wb = calloc(1, sizeof(*wb))) == NULL)
+		errx(1, "calloc");
+	if ((buf = calloc(1, len)) == NULL)
+		errx(1, "calloc");
+	wb->discard = 1;
+
+	rl = tls13_test_record_layer(aead, wb, 1);
+
+	signal(SIGALRM, benchmark_sig_alarm);
+
+	benchmark_stop = 0;
+	records = 0;
+	alloc_count = 0;
+	alarm(seconds);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	fprintf(stderr, "Benchmarking TLSv1.3 %s %zu byte records for %ds: ",
+	    name, len, seconds);
+	while (!benchmark_stop) {
+		if (tls13_write_application_data(rl, buf, len) != len)
+			errx(1, "tls13_write_application_data");
+		records++;
+	}
+	allocs = alloc_count;
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	timespecsub(&end, &start, &duration);
+	secs = duration.tv_sec + duration.tv_nsec / 1000000000.0;
+
+	fprintf(stderr, "%zu records in %f seconds, %.2f MB/s, "
+	    "%.2f allocations/record\n", records, secs,
+	    records * len / secs / (1024 * 1024), (double)allocs / records);
+
+	tls13_record_layer_free(rl);
+	free(wb);
+	free(buf);
+}
+
+static void
+benchmark_record_layer(void)
+{
+	benchmark_seal_tls13(EVP_aead_aes_128_gcm(), "AES-128-GCM", 1024, 5);
+	benchmark_seal_tls13(EVP_aead_aes_128_gcm(), "AES-128-GCM",
+	    TLS13_RECORD_MAX_PLAINTEXT_LEN, 5);
+	benchmark_seal_tls13(EVP_aead_chacha20_poly1305(), "ChaCha20-Poly1305",
+	    1024, 5);
+	benchmark_seal_tls13(EVP_aead_chacha20_poly1305(), "ChaCha20-Poly1305",
+	    TLS13_RECORD_MAX_PLAINTEXT_LEN, 5);
+}
+
 int
 main(int argc, char **argv)
 {
-	int failed = 0;
+	int benchmark = 0, failed = 0;
+
+	if (argc == 2 && strcmp(argv[1], "--benchmark") == 0)
+		benchmark = 1;
 
 	failed |= test_seq_num_tls12();
 	failed |= test_seq_num_tls13();
+	failed |= test_seal_tls13();
+
+	if (benchmark && !failed)
+		benchmark_record_layer();
 
 	return failed;
 }
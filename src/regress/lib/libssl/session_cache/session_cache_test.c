@@ -0,0 +1,581 @@
+/* $OpenBSD$ */
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <err.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <openssl/ssl.h>
+
+#include "ssl_local.h"
+
+#define TEST_NUM_SESSIONS	1000
+
+static int remove_cb_count;
+
+static void
+remove_cb(SSL_CTX *ctx, SSL_SESSION *sess)
+{
+	remove_cb_count++;
+}
+
+static SSL_SESSION *
+session_new(time_t t, long timeout)
+{
+	unsigned char id[SSL3_SSL_SESSION_ID_LENGTH];
+	SSL_SESSION *sess;
+
+	if ((sess = SSL_SESSION_new()) == NULL)
+		errx(1, "SSL_SESSION_new");
+
+	arc4random_buf(id, sizeof(id));
+	if (!SSL_SESSION_set1_id(sess, id, sizeof(id)))
+		errx(1, "SSL_SESSION_set1_id");
+
+	sess->ssl_version = TLS1_2_VERSION;
+	sess->time = t;
+	sess->timeout = timeout;
+
+	return sess;
+}
+
+static int
+session_in_cache(SSL *ssl, SSL_SESSION *sess)
+{
+	return SSL_has_matching_session_id(ssl, sess->session_id,
+	    sess->session_id_length);
+}
+
+static int
+test_session_cache_add_remove(void)
+{
+	SSL_SESSION *sessions[TEST_NUM_SESSIONS];
+	SSL_CTX *ctx = NULL;
+	SSL *ssl = NULL;
+	size_t i;
+	int failed = 1;
+
+	memset(sessions, 0, sizeof(sessions));
+
+	if ((ctx = SSL_CTX_new(TLS_server_method())) == NULL)
+		errx(1, "SSL_CTX_new");
+	if ((ssl = SSL_new(ctx)) == NULL)
+		errx(1, "SSL_new");
+	ssl->version = TLS1_2_VERSION;
+
+	for (i = 0; i < TEST_NUM_SESSIONS; i++) {
+		sessions[i] = session_new(time(NULL), 300);
+		if (SSL_CTX_add_session(ctx, sessions[i]) != 1) {
+			fprintf(stderr, "FAIL: failed to add session %zu\n", i);
+			goto failure;
+		}
+	}
+
+	/* Adding a session that is already cached is a no-op. */
+	if (SSL_CTX_add_session(ctx, sessions[0]) != 0) {
+		fprintf(stderr, "FAIL: re-adding a session succeeded\n");
+		goto failure;
+	}
+	if (SSL_CTX_sess_number(ctx) != TEST_NUM_SESSIONS) {
+		fprintf(stderr, "FAIL: got %ld sessions, want %d\n",
+		    SSL_CTX_sess_number(ctx), TEST_NUM_SESSIONS);
+		goto failure;
+	}
+
+	for (i = 0; i < SSL_SESSION_CACHE_SHARDS; i++) {
+		if (lh_SSL_SESSION_num_items(ctx->session_cache[i].sessions) ==
+		    0) {
+			fprintf(stderr, "FAIL: session cache shard %zu is "
+			    "empty\n", i);
+			goto failure;
+		}
+	}
+
+	for (i = 0; i < TEST_NUM_SESSIONS; i++) {
+		if (!session_in_cache(ssl, sessions[i])) {
+			fprintf(stderr, "FAIL: session %zu not found\n", i);
+			goto failure;
+		}
+	}
+
+	for (i = 0; i < TEST_NUM_SESSIONS; i += 2) {
+		if (!SSL_CTX_remove_session(ctx, sessions[i])) {
+			fprintf(stderr, "FAIL: failed to remove session %zu\n",
+			    i);
+			goto failure;
+		}
+	}
+	if (SSL_CTX_sess_number(ctx) != TEST_NUM_SESSIONS / 2) {
+		fprintf(stderr, "FAIL: got %ld sessions after removal, "
+		    "want %d\n", SSL_CTX_sess_number(ctx),
+		    TEST_NUM_SESSIONS / 2);
+		goto failure;
+	}
+	for (i = 0; i < TEST_NUM_SESSIONS; i++) {
+		if (session_in_cache(ssl, sessions[i]) != (i & 1)) {
+			fprintf(stderr, "FAIL: session %zu lookup mismatch\n",
+			    i);
+			goto failure;
+		}
+	}
+
+	failed = 0;
+
+ failure:
+	for (i = 0; i < TEST_NUM_SESSIONS; i++)
+		SSL_SESSION_free(sessions[i]);
+	SSL_free(ssl);
+	SSL_CTX_free(ctx);
+
+	return failed;
+}
+
+/* SSL_CTX_sessions() returns every cached session, across all shards. */
+static int
+test_session_cache_sessions(void)
+{
+	SSL_SESSION *sessions[TEST_NUM_SESSIONS];
+	LHASH_OF(SSL_SESSION) *lh = NULL;
+	SSL_CTX *ctx = NULL;
+	size_t i, num;
+	int cached, failed = 1;
+
+	memset(sessions, 0, sizeof(sessions));
+
+	if ((ctx = SSL_CTX_new(TLS_server_method())) == NULL)
+		errx(1, "SSL_CTX_new");
+
+	/* Sessions added before and after the first call are both found. */
+	for (i = 0; i < TEST_NUM_SESSIONS; i++) {
+		if (i == TEST_NUM_SESSIONS / 2) {
+			if ((lh = SSL_CTX_sessions(ctx)) == NULL) {
+				fprintf(stderr, "FAIL: SSL_CTX_sessions\n");
+				goto failure;
+			}
+			if (lh_SSL_SESSION_num_items(lh) != i) {
+				fprintf(stderr, "FAIL: got %lu sessions, "
+				    "want %zu\n", lh_SSL_SESSION_num_items(lh),
+				    i);
+				goto failure;
+			}
+		}
+		sessions[i] = session_new(time(NULL), 300);
+		if (SSL_CTX_add_session(ctx, sessions[i]) != 1) {
+			fprintf(stderr, "FAIL: failed to add session %zu\n", i);
+			goto failure;
+		}
+	}
+
+	for (i = 0; i < TEST_NUM_SESSIONS; i += 3) {
+		if (!SSL_CTX_remove_session(ctx, sessions[i])) {
+			fprintf(stderr, "FAIL: failed to remove session %zu\n",
+			    i);
+			goto failure;
+		}
+	}
+
+	if (SSL_CTX_sessions(ctx) != lh) {
+		fprintf(stderr, "FAIL: SSL_CTX_sessions changed\n");
+		goto failure;
+	}
+	num = TEST_NUM_SESSIONS - (TEST_NUM_SESSIONS + 2) / 3;
+	if (lh_SSL_SESSION_num_items(lh) != num) {
+		fprintf(stderr, "FAIL: got %lu sessions after removal, "
+		    "want %zu\n", lh_SSL_SESSION_num_items(lh), num);
+		goto failure;
+	}
+	for (i = 0; i < TEST_NUM_SESSIONS; i++) {
+		cached = lh_SSL_SESSION_retrieve(lh, sessions[i]) ==
+		    sessions[i];
+		if (cached != (i % 3 != 0)) {
+			fprintf(stderr, "FAIL: session %zu lookup mismatch\n",
+			    i);
+			goto failure;
+		}
+	}
+
+	SSL_CTX_flush_sessions(ctx, 0);
+	if (lh_SSL_SESSION_num_items(lh) != 0) {
+		fprintf(stderr, "FAIL: got %lu sessions after flush\n",
+		    lh_SSL_SESSION_num_items(lh));
+		goto failure;
+	}
+
+	failed = 0;
+
+ failure:
+	for (i = 0; i < TEST_NUM_SESSIONS; i++)
+		SSL_SESSION_free(sessions[i]);
+	SSL_CTX_free(ctx);
+
+	return failed;
+}
+
+static int
+test_session_cache_size(void)
+{
+	SSL_SESSION *sess;
+	SSL_CTX *ctx = NULL;
+	long cache_size = 64;
+	size_t i;
+	int failed = 1;
+
+	if ((ctx = SSL_CTX_new(TLS_server_method())) == NULL)
+		errx(1, "SSL_CTX_new");
+
+	SSL_CTX_sess_set_cache_size(ctx, cache_size);
+
+	for (i = 0; i < TEST_NUM_SESSIONS; i++) {
+		sess = session_new(time(NULL), 300);
+		if (SSL_CTX_add_session(ctx, sess) != 1) {
+			fprintf(stderr, "FAIL: failed to add session %zu\n", i);
+			SSL_SESSION_free(sess);
+			goto failure;
+		}
+		SSL_SESSION_free(sess);
+	}
+
+	/* The limit is enforced per shard, so allow for rounding. */
+	if (SSL_CTX_sess_number(ctx) > cache_size +
+	    SSL_SESSION_CACHE_SHARDS - 1) {
+		fprintf(stderr, "FAIL: cache has %ld sessions, limit is %ld\n",
+		    SSL_CTX_sess_number(ctx), cache_size);
+		goto failure;
+	}
+	if (SSL_CTX_sess_cache_full(ctx) !=
+	    TEST_NUM_SESSIONS - SSL_CTX_sess_number(ctx)) {
+		fprintf(stderr, "FAIL: got %ld cache full evictions, "
+		    "want %ld\n", SSL_CTX_sess_cache_full(ctx),
+		    TEST_NUM_SESSIONS - SSL_CTX_sess_number(ctx));
+		goto failure;
+	}
+
+	failed = 0;
+
+ failure:
+	SSL_CTX_free(ctx);
+
+	return failed;
+}
+
+static int
+test_session_cache_expiry(void)
+{
+	SSL_SESSION *sess;
+	SSL_CTX *ctx = NULL;
+	time_t now = time(NULL);
+	size_t i;
+	int failed = 1;
+
+	if ((ctx = SSL_CTX_new(TLS_server_method())) == NULL)
+		errx(1, "SSL_CTX_new");
+
+	SSL_CTX_sess_set_remove_cb(ctx, remove_cb);
+	remove_cb_count = 0;
+
+	/* Half of the sessions have already expired. */
+	for (i = 0; i < TEST_NUM_SESSIONS; i++) {
+		if ((i & 1) == 0)
+			sess = session_new(now - 600, 300);
+		else
+			sess = session_new(now, 300);
+		if (SSL_CTX_add_session(ctx, sess) != 1) {
+			fprintf(stderr, "FAIL: failed to add session %zu\n", i);
+			SSL_SESSION_free(sess);
+			goto failure;
+		}
+		SSL_SESSION_free(sess);
+	}
+
+	/* Some of the expired sessions may have been removed on insert. */
+	if (SSL_CTX_sess_number(ctx) + remove_cb_count != TEST_NUM_SESSIONS) {
+		fprintf(stderr, "FAIL: %ld sessions cached and %d removed, "
+		    "want %d total\n", SSL_CTX_sess_number(ctx),
+		    remove_cb_count, TEST_NUM_SESSIONS);
+		goto failure;
+	}
+
+	SSL_CTX_flush_sessions(ctx, now);
+
+	if (SSL_CTX_sess_number(ctx) != TEST_NUM_SESSIONS / 2) {
+		fprintf(stderr, "FAIL: got %ld sessions after flush, want %d\n",
+		    SSL_CTX_sess_number(ctx), TEST_NUM_SESSIONS / 2);
+		goto failure;
+	}
+	if (remove_cb_count != TEST_NUM_SESSIONS / 2) {
+		fprintf(stderr, "FAIL: remove callback called %d times, "
+		    "want %d\n", remove_cb_count, TEST_NUM_SESSIONS / 2);
+		goto failure;
+	}
+
+	SSL_CTX_flush_sessions(ctx, 0);
+
+	if (SSL_CTX_sess_number(ctx) != 0) {
+		fprintf(stderr, "FAIL: got %ld sessions after full flush\n",
+		    SSL_CTX_sess_number(ctx));
+		goto failure;
+	}
+
+	failed = 0;
+
+ failure:
+	SSL_CTX_free(ctx);
+
+	return failed;
+}
+
+static int
+test_session_cache_timer_expiry(void)
+{
+	SSL_SESSION *sess;
+	SSL_CTX *ctx = NULL;
+	time_t now = time(NULL);
+	size_t i, expired;
+	int passes;
+	int failed = 1;
+
+	if ((ctx = SSL_CTX_new(TLS_server_method())) == NULL)
+		errx(1, "SSL_CTX_new");
+
+	SSL_CTX_sess_set_remove_cb(ctx, remove_cb);
+	remove_cb_count = 0;
+
+	expired = SSL_SESSION_CACHE_SHARDS * SSL_SESSION_CACHE_EXPIRE_BATCH * 4;
+
+	for (i = 0; i < expired; i++) {
+		sess = session_new(now - 600, 300);
+		if (SSL_CTX_add_session(ctx, sess) != 1)
+			errx(1, "failed to add session");
+		SSL_SESSION_free(sess);
+	}
+	for (i = 0; i < TEST_NUM_SESSIONS; i++) {
+		sess = session_new(now, 300);
+		if (SSL_CTX_add_session(ctx, sess) != 1)
+			errx(1, "failed to add session");
+		SSL_SESSION_free(sess);
+	}
+
+	/* Each pass expires a bounded number of sessions from each shard. */
+	for (passes = 0; passes < 100; passes++) {
+		if (SSL_CTX_sess_number(ctx) == TEST_NUM_SESSIONS)
+			break;
+		ssl_session_cache_expire(ctx, now + 1);
+	}
+
+	if (SSL_CTX_sess_number(ctx) != TEST_NUM_SESSIONS) {
+		fprintf(stderr, "FAIL: got %ld sessions, want %d\n",
+		    SSL_CTX_sess_number(ctx), TEST_NUM_SESSIONS);
+		goto failure;
+	}
+	if (passes < 2) {
+		fprintf(stderr, "FAIL: expired %zu sessions in %d passes\n",
+		    expired, passes);
+		goto failure;
+	}
+	if (SSL_CTX_sess_expired(ctx) != expired ||
+	    remove_cb_count != expired) {
+		fprintf(stderr, "FAIL: got %ld expired and %d removed, "
+		    "want %zu\n", SSL_CTX_sess_expired(ctx), remove_cb_count,
+		    expired);
+		goto failure;
+	}
+	if (SSL_CTX_sess_expire_deferred(ctx) == 0) {
+		fprintf(stderr, "FAIL: expiry was never deferred\n");
+		goto failure;
+	}
+
+	/* The fresh sessions expire once their timeout has passed. */
+	ssl_session_cache_expire(ctx, now + 300);
+	if (SSL_CTX_sess_number(ctx) != TEST_NUM_SESSIONS) {
+		fprintf(stderr, "FAIL: sessions expired early\n");
+		goto failure;
+	}
+	for (passes = 0; passes < 100; passes++) {
+		if (SSL_CTX_sess_number(ctx) == 0)
+			break;
+		ssl_session_cache_expire(ctx, now + 301);
+	}
+	if (SSL_CTX_sess_number(ctx) != 0) {
+		fprintf(stderr, "FAIL: got %ld sessions after expiry\n",
+		    SSL_CTX_sess_number(ctx));
+		goto failure;
+	}
+
+	failed = 0;
+
+ failure:
+	SSL_CTX_free(ctx);
+
+	return failed;
+}
+
+static int
+test_session_cache_timer_reschedule(void)
+{
+	SSL_SESSION *extended = NULL, *distant = NULL;
+	SSL_CTX *ctx = NULL;
+	SSL *ssl = NULL;
+	time_t now = time(NULL);
+	long day = 24 * 60 * 60;
+	int failed = 1;
+
+	if ((ctx = SSL_CTX_new(TLS_server_method())) == NULL)
+		errx(1, "SSL_CTX_new");
+	if ((ssl = SSL_new(ctx)) == NULL)
+		errx(1, "SSL_new");
+	ssl->version = TLS1_2_VERSION;
+
+	/* A session whose timeout is extended while it is in the cache. */
+	extended = session_new(now, 10);
+	if (SSL_CTX_add_session(ctx, extended) != 1)
+		errx(1, "failed to add session");
+	SSL_SESSION_set_timeout(extended, 300);
+
+	/* A session that expires beyond the span of the timer wheel. */
+	distant = session_new(now, 10 * day);
+	if (SSL_CTX_add_session(ctx, distant) != 1)
+		errx(1, "failed to add session");
+
+	ssl_session_cache_expire(ctx, now + 60);
+
+	if (!session_in_cache(ssl, extended)) {
+		fprintf(stderr, "FAIL: extended session was expired\n");
+		goto failure;
+	}
+	if (SSL_CTX_sess_expire_rescheduled(ctx) != 1) {
+		fprintf(stderr, "FAIL: got %ld rescheduled timers, want 1\n",
+		    SSL_CTX_sess_expire_rescheduled(ctx));
+		goto failure;
+	}
+
+	ssl_session_cache_expire(ctx, now + 301);
+
+	if (session_in_cache(ssl, extended)) {
+		fprintf(stderr, "FAIL: extended session was not expired\n");
+		goto failure;
+	}
+
+	ssl_session_cache_expire(ctx, now + 5 * day);
+
+	if (!session_in_cache(ssl, distant)) {
+		fprintf(stderr, "FAIL: distant session was expired\n");
+		goto failure;
+	}
+
+	ssl_session_cache_expire(ctx, now + 10 * day + 1);
+
+	if (session_in_cache(ssl, distant)) {
+		fprintf(stderr, "FAIL: distant session was not expired\n");
+		goto failure;
+	}
+	if (SSL_CTX_sess_expired(ctx) != 2) {
+		fprintf(stderr, "FAIL: got %ld expired sessions, want 2\n",
+		    SSL_CTX_sess_expired(ctx));
+		goto failure;
+	}
+
+	failed = 0;
+
+ failure:
+	SSL_SESSION_free(extended);
+	SSL_SESSION_free(distant);
+	SSL_free(ssl);
+	SSL_CTX_free(ctx);
+
+	return failed;
+}
+
+/*
+ * A clock step far beyond the span of the timer wheel expires the sessions
+ * that are due without visiting every elapsed second.
+ */
+static int
+test_session_cache_timer_clock_step(void)
+{
+	SSL_SESSION *distant = NULL, *sess;
+	SSL_CTX *ctx = NULL;
+	SSL *ssl = NULL;
+	time_t now = time(NULL);
+	long year = 365 * 24 * 60 * 60;
+	size_t i;
+	int passes;
+	int failed = 1;
+
+	if ((ctx = SSL_CTX_new(TLS_server_method())) == NULL)
+		errx(1, "SSL_CTX_new");
+	if ((ssl = SSL_new(ctx)) == NULL)
+		errx(1, "SSL_new");
+	ssl->version = TLS1_2_VERSION;
+
+	for (i = 0; i < TEST_NUM_SESSIONS; i++) {
+		sess = session_new(now, 300);
+		if (SSL_CTX_add_session(ctx, sess) != 1)
+			errx(1, "failed to add session");
+		SSL_SESSION_free(sess);
+	}
+	distant = session_new(now, 40 * year);
+	if (SSL_CTX_add_session(ctx, distant) != 1)
+		errx(1, "failed to add session");
+
+	for (passes = 0; passes < 100; passes++) {
+		if (SSL_CTX_sess_number(ctx) == 1)
+			break;
+		ssl_session_cache_expire(ctx, now + 30 * year);
+	}
+	if (SSL_CTX_sess_number(ctx) != 1) {
+		fprintf(stderr, "FAIL: got %ld sessions after a clock step, "
+		    "want 1\n", SSL_CTX_sess_number(ctx));
+		goto failure;
+	}
+	if (!session_in_cache(ssl, distant)) {
+		fprintf(stderr, "FAIL: distant session was expired\n");
+		goto failure;
+	}
+
+	ssl_session_cache_expire(ctx, now + 41 * year);
+	if (session_in_cache(ssl, distant)) {
+		fprintf(stderr, "FAIL: distant session was not expired\n");
+		goto failure;
+	}
+
+	failed = 0;
+
+ failure:
+	SSL_SESSION_free(distant);
+	SSL_free(ssl);
+	SSL_CTX_free(ctx);
+
+	return failed;
+}
+
+int
+main(int argc, char **argv)
+{
+	int failed = 0;
+
+	failed |= test_session_cache_add_remove();
+	failed |= test_session_cache_sessions();
+	failed |= test_session_cache_size();
+	failed |= test_session_cache_expiry();
+	failed |= test_session_cache_timer_expiry();
+	failed |= test_session_cache_timer_reschedule();
+	failed |= test_session_cache_timer_clock_step();
+
+	return failed;
+}
@@ -15,15 +15,19 @@
  * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  */
 
+#include <sys/socket.h>
+
+#include <arpa/inet.h>
+
 #include <err.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <openssl/x509v3.h>
 #include <tls.h>
 
-extern int tls_check_name(struct tls *ctx, X509 *cert, const char *name,
-    int *match);
+#include "tls_internal.h"
 
 struct alt_name {
 	const char name[128];
@@ -457,16 +461,12 @@ cert_add_alt_names(X509 *cert, struct verify_test *vt)
 	sk_GENERAL_NAME_pop_free(alt_name_stack, GENERAL_NAME_free);
 }
 
-static int
-do_verify_test(int test_no, struct verify_test *vt)
+static X509 *
+verify_test_cert(struct verify_test *vt)
 {
-	struct tls *tls;
 	X509_NAME *name;
 	X509 *cert;
-	int failed = 1;
-	int match;
 
-	/* Build certificate structure. */
 	if ((cert = X509_new()) == NULL)
 		errx(1, "failed to malloc X509");
 
@@ -482,11 +482,25 @@ do_verify_test(int test_no, struct verify_test *vt)
 		X509_NAME_free(name);
 	}
 
+	cert_add_alt_names(cert, vt);
+
+	return cert;
+}
+
+static int
+do_verify_test(int test_no, struct verify_test *vt)
+{
+	struct tls *tls;
+	X509 *cert;
+	int failed = 1;
+	int match;
+
+	/* Build certificate structure. */
+	cert = verify_test_cert(vt);
+
 	if ((tls = tls_client()) == NULL)
 		errx(1, "failed to malloc tls_client");
 
-	cert_add_alt_names(cert, vt);
-
 	match = 1;
 
 	if (tls_check_name(tls, cert, vt->name, &match) != vt->want_return) {
@@ -509,6 +523,123 @@ do_verify_test(int test_no, struct verify_test *vt)
 	return (failed);
 }
 
+static int
+do_sni_index_test(int test_no, struct verify_test *vt)
+{
+	struct tls_sni_index *index = NULL;
+	struct tls_sni_ctx *sni_ctx = NULL;
+	union tls_addr addrbuf;
+	struct tls *tls;
+	int failed = 1;
+	int ret;
+
+	/* The SNI index is never consulted for IP addresses. */
+	if (inet_pton(AF_INET, vt->name, &addrbuf) == 1 ||
+	    inet_pton(AF_INET6, vt->name, &addrbuf) == 1)
+		return (0);
+
+	if ((tls = tls_server()) == NULL)
+		errx(1, "failed to malloc tls_server");
+	if ((index = tls_sni_index_new()) == NULL)
+		errx(1, "failed to malloc SNI index");
+	if ((sni_ctx = tls_sni_ctx_new()) == NULL)
+		errx(1, "failed to malloc SNI context");
+
+	sni_ctx->ssl_cert = verify_test_cert(vt);
+
+	if ((ret = tls_sni_index_add(tls, index, sni_ctx)) != vt->want_return) {
+		fprintf(stderr, "FAIL: test %i failed to index names: %s\n",
+		    test_no, tls_error(tls));
+		goto done;
+	}
+	if (ret == -1) {
+		failed = 0;
+		goto done;
+	}
+
+	if ((tls_sni_index_lookup(index, vt->name) != NULL) !=
+	    vt->want_match) {
+		fprintf(stderr, "FAIL: test %i failed to look up name '%s'\n",
+		    test_no, vt->name);
+		goto done;
+	}
+
+	failed = 0;
+
+ done:
+	tls_sni_ctx_free(sni_ctx);
+	tls_sni_index_free(index);
+	tls_free(tls);
+
+	return (failed);
+}
+
+/*
+ * Index the certificates of all tests that index cleanly and check that
+ * each name maps to the first certificate that tls_check_name() matches.
+ */
+static int
+do_sni_index_order_test(void)
+{
+	struct tls_sni_ctx *sni_ctx[N_VERIFY_TESTS], *want;
+	struct tls_sni_index *index;
+	union tls_addr addrbuf;
+	struct tls *tls;
+	size_t i, j, n = 0;
+	int failed = 1;
+	int match;
+
+	if ((tls = tls_server()) == NULL)
+		errx(1, "failed to malloc tls_server");
+	if ((index = tls_sni_index_new()) == NULL)
+		errx(1, "failed to malloc SNI index");
+
+	for (i = 0; i < N_VERIFY_TESTS; i++) {
+		if (verify_tests[i].want_return != 0)
+			continue;
+		if ((sni_ctx[n] = tls_sni_ctx_new()) == NULL)
+			errx(1, "failed to malloc SNI context");
+		sni_ctx[n]->ssl_cert = verify_test_cert(&verify_tests[i]);
+		if (tls_sni_index_add(tls, index, sni_ctx[n]) == -1)
+			errx(1, "failed to index names: %s", tls_error(tls));
+		n++;
+	}
+
+	for (i = 0; i < N_VERIFY_TESTS; i++) {
+		const char *name = verify_tests[i].name;
+
+		if (inet_pton(AF_INET, name, &addrbuf) == 1 ||
+		    inet_pton(AF_INET6, name, &addrbuf) == 1)
+			continue;
+
+		want = NULL;
+		for (j = 0; j < n; j++) {
+			if (tls_check_name(tls, sni_ctx[j]->ssl_cert, name,
+			    &match) == -1)
+				errx(1, "failed to check name");
+			if (match) {
+				want = sni_ctx[j];
+				break;
+			}
+		}
+		if (tls_sni_index_lookup(index, name) != want) {
+			fprintf(stderr, "FAIL: SNI index lookup for '%s' does "
+			    "not match linear search\n", name);
+			goto done;
+		}
+	}
+
+	failed = 0;
+
+ done:
+	for (i = 0; i < n; i++)
+		tls_sni_ctx_free(sni_ctx[i]);
+	tls_sni_index_free(index);
+	tls_free(tls);
+
+	return (failed);
+}
+
 int
 main(int argc, char **argv)
 {
@@ -519,6 +650,9 @@ main(int argc, char **argv)
 
 	for (i = 0; i < N_VERIFY_TESTS; i++)
 		failed += do_verify_test(i, &verify_tests[i]);
+	for (i = 0; i < N_VERIFY_TESTS; i++)
+		failed += do_sni_index_test(i, &verify_tests[i]);
+	failed += do_sni_index_order_test();
 
 	return (failed);
 }
@@ -0,0 +1,300 @@
+/* $OpenBSD$ */
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * Check a trust store written by "openssl certstore" against the PEM files
+ * it was built from: every distinct certificate is indexed exactly once,
+ * the index is sorted by type and name hash, and X509_LOOKUP_load_mmap()
+ * finds every certificate by its subject.
+ */
+
+#include <err.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <openssl/bio.h>
+#include <openssl/err.h>
+#include <openssl/pem.h>
+#include <openssl/x509.h>
+#include <openssl/x509_vfy.h>
+
+static int
+certs_find(STACK_OF(X509) *certs, X509 *cert)
+{
+	int i;
+
+	for (i = 0; i < sk_X509_num(certs); i++) {
+		if (X509_cmp(sk_X509_value(certs, i), cert) == 0)
+			return i;
+	}
+
+	return -1;
+}
+
+static STACK_OF(X509) *
+certs_read(char **files, int num_files)
+{
+	STACK_OF(X509_INFO) *infos;
+	STACK_OF(X509) *certs;
+	X509_INFO *info;
+	BIO *bio;
+	int i, j;
+
+	if ((certs = sk_X509_new_null()) == NULL)
+		errx(1, "sk_X509_new_null");
+
+	for (i = 0; i < num_files; i++) {
+		if ((bio = BIO_new_file(files[i], "r")) == NULL)
+			errx(1, "BIO_new_file %s", files[i]);
+		if ((infos = PEM_X509_INFO_read_bio(bio, NULL, NULL,
+		    NULL)) == NULL)
+			errx(1, "PEM_X509_INFO_read_bio %s", files[i]);
+		for (j = 0; j < sk_X509_INFO_num(infos); j++) {
+			info = sk_X509_INFO_value(infos, j);
+			if (info->x509 == NULL)
+				continue;
+			if (certs_find(certs, info->x509) != -1)
+				continue;
+			if (!X509_up_ref(info->x509))
+				errx(1, "X509_up_ref");
+			if (!sk_X509_push(certs, info->x509))
+				errx(1, "sk_X509_push");
+		}
+		sk_X509_INFO_pop_free(infos, X509_INFO_free);
+		BIO_free(bio);
+	}
+
+	return certs;
+}
+
+static uint8_t *
+file_read(const char *path, size_t *out_len)
+{
+	uint8_t *data;
+	long len;
+	FILE *fp;
+
+	if ((fp = fopen(path, "r")) == NULL)
+		err(1, "fopen %s", path);
+	if (fseek(fp, 0, SEEK_END) == -1 || (len = ftell(fp)) == -1)
+		err(1, "%s", path);
+	rewind(fp);
+	if ((data = malloc(len)) == NULL)
+		err(1, NULL);
+	if (fread(data, 1, len, fp) != (size_t)len)
+		errx(1, "short read from %s", path);
+	fclose(fp);
+
+	*out_len = len;
+
+	return data;
+}
+
+static uint32_t
+get_u32(const uint8_t *p)
+{
+	return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 |
+	    (uint32_t)p[2] << 8 | (uint32_t)p[3];
+}
+
+/*
+ * Walk the index directly, so that a store which is only accepted by the
+ * lookup, but not deduplicated or sorted the way certstore promises, fails.
+ */
+static int
+test_store_index(const char *path, STACK_OF(X509) *certs)
+{
+	const uint8_t *entry, *p;
+	uint32_t count, type, hash, offset, length;
+	uint32_t last_type = 0, last_hash = 0;
+	uint8_t *data, *seen = NULL;
+	size_t data_len, i;
+	X509 *cert = NULL;
+	int idx;
+	int failed = 1;
+
+	data = file_read(path, &data_len);
+
+	if (data_len < X509_TRUST_STORE_MAGIC_LEN + 4 ||
+	    memcmp(data, X509_TRUST_STORE_MAGIC,
+	    X509_TRUST_STORE_MAGIC_LEN) != 0) {
+		fprintf(stderr, "FAIL: %s has no trust store header\n", path);
+		goto failure;
+	}
+	count = get_u32(data + X509_TRUST_STORE_MAGIC_LEN);
+	if (count != (uint32_t)sk_X509_num(certs)) {
+		fprintf(stderr, "FAIL: %s indexes %u objects, want %d\n",
+		    path, count, sk_X509_num(certs));
+		goto failure;
+	}
+	if (count > (data_len - X509_TRUST_STORE_MAGIC_LEN - 4) /
+	    X509_TRUST_STORE_ENTRY_LEN) {
+		fprintf(stderr, "FAIL: %s has a truncated index\n", path);
+		goto failure;
+	}
+
+	if ((seen = calloc(count, 1)) == NULL)
+		err(1, NULL);
+
+	entry = data + X509_TRUST_STORE_MAGIC_LEN + 4;
+	for (i = 0; i < count; i++, entry += X509_TRUST_STORE_ENTRY_LEN) {
+		type = get_u32(entry);
+		hash = get_u32(entry + 4);
+		offset = get_u32(entry + 8);
+		length = get_u32(entry + 12);
+
+		if (type != X509_LU_X509) {
+			fprintf(stderr, "FAIL: entry %zu has type %u\n",
+			    i, type);
+			goto failure;
+		}
+		if (type < last_type ||
+		    (type == last_type && hash < last_hash)) {
+			fprintf(stderr, "FAIL: entry %zu is out of order\n", i);
+			goto failure;
+		}
+		last_type = type;
+		last_hash = hash;
+
+		if (offset > data_len || length > data_len - offset) {
+			fprintf(stderr, "FAIL: entry %zu is out of bounds\n",
+			    i);
+			goto failure;
+		}
+		p = data + offset;
+		if ((cert = d2i_X509(NULL, &p, length)) == NULL ||
+		    p != data + offset + length) {
+			fprintf(stderr, "FAIL: entry %zu is not a "
+			    "certificate\n", i);
+			goto failure;
+		}
+		if (hash != (uint32_t)X509_subject_name_hash(cert)) {
+			fprintf(stderr, "FAIL: entry %zu has the wrong hash\n",
+			    i);
+			goto failure;
+		}
+		if ((idx = certs_find(certs, cert)) == -1) {
+			fprintf(stderr, "FAIL: entry %zu was not in the "
+			    "input\n", i);
+			goto failure;
+		}
+		if (seen[idx]) {
+			fprintf(stderr, "FAIL: entry %zu is a duplicate\n", i);
+			goto failure;
+		}
+		seen[idx] = 1;
+
+		X509_free(cert);
+		cert = NULL;
+	}
+
+	failed = 0;
+
+ failure:
+	X509_free(cert);
+	free(seen);
+	free(data);
+
+	return failed;
+}
+
+static int
+test_store_lookup(const char *path, STACK_OF(X509) *certs)
+{
+	STACK_OF(X509) *found = NULL;
+	X509_STORE_CTX *ctx = NULL;
+	X509_STORE *store;
+	X509_LOOKUP *lookup;
+	X509 *cert;
+	int i, num_objects;
+	int failed = 1;
+
+	if ((store = X509_STORE_new()) == NULL)
+		errx(1, "X509_STORE_new");
+	if ((lookup = X509_STORE_add_lookup(store, X509_LOOKUP_mmap())) == NULL)
+		errx(1, "X509_STORE_add_lookup");
+	if (!X509_LOOKUP_load_mmap(lookup, path)) {
+		fprintf(stderr, "FAIL: X509_LOOKUP_load_mmap %s\n", path);
+		ERR_print_errors_fp(stderr);
+		goto failure;
+	}
+	if ((ctx = X509_STORE_CTX_new()) == NULL)
+		errx(1, "X509_STORE_CTX_new");
+	if (!X509_STORE_CTX_init(ctx, store, NULL, NULL))
+		errx(1, "X509_STORE_CTX_init");
+
+	/* Nothing is parsed before it is looked up. */
+	if ((num_objects = sk_X509_OBJECT_num(
+	    X509_STORE_get0_objects(store))) != 0) {
+		fprintf(stderr, "FAIL: %d objects loaded before a lookup\n",
+		    num_objects);
+		goto failure;
+	}
+
+	for (i = 0; i < sk_X509_num(certs); i++) {
+		cert = sk_X509_value(certs, i);
+		if ((found = X509_STORE_get1_certs(ctx,
+		    X509_get_subject_name(cert))) == NULL ||
+		    certs_find(found, cert) == -1) {
+			fprintf(stderr, "FAIL: certificate %d not found\n", i);
+			goto failure;
+		}
+		sk_X509_pop_free(found, X509_free);
+		found = NULL;
+	}
+
+	if ((num_objects = sk_X509_OBJECT_num(
+	    X509_STORE_get0_objects(store))) != sk_X509_num(certs)) {
+		fprintf(stderr, "FAIL: %d objects loaded, want %d\n",
+		    num_objects, sk_X509_num(certs));
+		goto failure;
+	}
+
+	failed = 0;
+
+ failure:
+	sk_X509_pop_free(found, X509_free);
+	X509_STORE_CTX_free(ctx);
+	X509_STORE_free(store);
+
+	return failed;
+}
+
+int
+main(int argc, char **argv)
+{
+	STACK_OF(X509) *certs;
+	int failed = 0;
+
+	if (argc < 3) {
+		fprintf(stderr, "usage: certstoretest store file.pem ...\n");
+		exit(1);
+	}
+
+	certs = certs_read(argv + 2, argc - 2);
+	if (sk_X509_num(certs) == 0)
+		errx(1, "no certificates in the input");
+
+	failed |= test_store_index(argv[1], certs);
+	failed |= test_store_lookup(argv[1], certs);
+
+	sk_X509_pop_free(certs, X509_free);
+
+	return failed;
+}
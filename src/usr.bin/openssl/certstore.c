@@ -0,0 +1,475 @@
+/*	$OpenBSD$ */
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <dirent.h>
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <openssl/bio.h>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/x509.h>
+
+#include "apps.h"
+
+static struct {
+	char *outfile;
+	int verbose;
+} cfg;
+
+static const struct option certstore_options[] = {
+	{
+		.name = "out",
+		.argname = "file",
+		.desc = "Trust store file to write",
+		.type = OPTION_ARG,
+		.opt.arg = &cfg.outfile,
+	},
+	{
+		.name = "v",
+		.desc = "Verbose",
+		.type = OPTION_FLAG,
+		.opt.flag = &cfg.verbose,
+	},
+	{ NULL },
+};
+
+struct storeentry {
+	char *filename;
+	uint32_t type;
+	uint32_t hash;
+	unsigned char fingerprint[EVP_MAX_MD_SIZE];
+	unsigned char *der;
+	int der_len;
+	int is_dup;
+};
+
+struct storeentries {
+	struct storeentry *entries;
+	size_t len;
+	size_t cap;
+};
+
+static void
+storeentries_free(struct storeentries *se)
+{
+	size_t i;
+
+	for (i = 0; i < se->len; i++) {
+		free(se->entries[i].filename);
+		free(se->entries[i].der);
+	}
+	free(se->entries);
+}
+
+static struct storeentry *
+storeentries_add(struct storeentries *se, const char *filename)
+{
+	struct storeentry *entries, *entry;
+	size_t cap;
+
+	if (se->len == se->cap) {
+		cap = se->cap == 0 ? 64 : se->cap * 2;
+		if ((entries = recallocarray(se->entries, se->cap, cap,
+		    sizeof(*entries))) == NULL)
+			return (NULL);
+		se->entries = entries;
+		se->cap = cap;
+	}
+	entry = &se->entries[se->len];
+	if ((entry->filename = strdup(filename)) == NULL)
+		return (NULL);
+	se->len++;
+
+	return (entry);
+}
+
+static int
+certstore_cert(struct storeentries *se, X509 *cert, const char *filename)
+{
+	struct storeentry *entry;
+	unsigned int len;
+
+	if ((entry = storeentries_add(se, filename)) == NULL)
+		goto err;
+
+	entry->type = X509_LU_X509;
+	entry->hash = (uint32_t)X509_subject_name_hash(cert);
+	if (X509_digest(cert, EVP_sha256(), entry->fingerprint, &len) != 1)
+		goto err;
+	if ((entry->der_len = i2d_X509(cert, &entry->der)) <= 0)
+		goto err;
+
+	return (0);
+
+ err:
+	fprintf(stderr, "failed to add certificate from %s\n", filename);
+	return (-1);
+}
+
+static int
+certstore_crl(struct storeentries *se, X509_CRL *crl, const char *filename)
+{
+	struct storeentry *entry;
+	unsigned int len;
+
+	if ((entry = storeentries_add(se, filename)) == NULL)
+		goto err;
+
+	entry->type = X509_LU_CRL;
+	entry->hash = (uint32_t)X509_NAME_hash(X509_CRL_get_issuer(crl));
+	if (X509_CRL_digest(crl, EVP_sha256(), entry->fingerprint, &len) != 1)
+		goto err;
+	if ((entry->der_len = i2d_X509_CRL(crl, &entry->der)) <= 0)
+		goto err;
+
+	return (0);
+
+ err:
+	fprintf(stderr, "failed to add CRL from %s\n", filename);
+	return (-1);
+}
+
+static int
+certstore_file(struct storeentries *se, const char *filename)
+{
+	STACK_OF(X509_INFO) *infos = NULL;
+	X509_INFO *info;
+	BIO *bio = NULL;
+	size_t count = 0;
+	int i, ret = -1;
+
+	if ((bio = BIO_new_file(filename, "r")) == NULL) {
+		fprintf(stderr, "failed to open %s\n", filename);
+		goto err;
+	}
+	if ((infos = PEM_X509_INFO_read_bio(bio, NULL, NULL, NULL)) == NULL) {
+		fprintf(stderr, "failed to read PEM file %s\n", filename);
+		goto err;
+	}
+
+	for (i = 0; i < sk_X509_INFO_num(infos); i++) {
+		info = sk_X509_INFO_value(infos, i);
+		if (info->x509 != NULL) {
+			if (certstore_cert(se, info->x509, filename) == -1)
+				goto err;
+			count++;
+		}
+		if (info->crl != NULL) {
+			if (certstore_crl(se, info->crl, filename) == -1)
+				goto err;
+			count++;
+		}
+	}
+
+	if (count == 0)
+		fprintf(stderr, "PEM file %s does not contain a certificate "
+		    "or CRL, ignoring...\n", filename);
+	else if (cfg.verbose)
+		fprintf(stdout, "read %zu objects from %s\n", count, filename);
+
+	ret = 0;
+
+ err:
+	sk_X509_INFO_pop_free(infos, X509_INFO_free);
+	BIO_free(bio);
+
+	return (ret);
+}
+
+static int
+filename_is_pem(const char *filename)
+{
+	size_t len;
+
+	if ((len = strlen(filename)) < 4)
+		return (0);
+
+	return (strcmp(filename + len - 4, ".pem") == 0);
+}
+
+static int
+certstore_directory(struct storeentries *se, const char *path)
+{
+	struct dirent *dep;
+	DIR *dip;
+	char *filename;
+	int ret = 0;
+
+	if ((dip = opendir(path)) == NULL) {
+		fprintf(stderr, "failed to open directory %s\n", path);
+		return (-1);
+	}
+
+	if (cfg.verbose)
+		fprintf(stdout, "scanning directory %s\n", path);
+
+	while ((dep = readdir(dip)) != NULL) {
+		if (!filename_is_pem(dep->d_name))
+			continue;
+		if (asprintf(&filename, "%s/%s", path, dep->d_name) == -1) {
+			fprintf(stderr, "out of memory\n");
+			ret = -1;
+			break;
+		}
+		ret = certstore_file(se, filename);
+		free(filename);
+		if (ret == -1)
+			break;
+	}
+	closedir(dip);
+
+	return (ret);
+}
+
+static int
+storeentry_compare(const void *a, const void *b)
+{
+	const struct storeentry *sea = a;
+	const struct storeentry *seb = b;
+	int rv;
+
+	/* The order of the index, then a stable order within a hash. */
+	rv = sea->type < seb->type ? -1 : sea->type > seb->type;
+	if (rv != 0)
+		return (rv);
+	rv = sea->hash < seb->hash ? -1 : sea->hash > seb->hash;
+	if (rv != 0)
+		return (rv);
+	rv = memcmp(sea->fingerprint, seb->fingerprint,
+	    sizeof(sea->fingerprint));
+	if (rv != 0)
+		return (rv);
+	return (strcmp(sea->filename, seb->filename));
+}
+
+static size_t
+certstore_dedup(struct storeentries *se)
+{
+	struct storeentry *entry, *last = NULL;
+	size_t i, count = 0;
+
+	for (i = 0; i < se->len; i++) {
+		entry = &se->entries[i];
+		if (last != NULL && entry->type == last->type &&
+		    memcmp(entry->fingerprint, last->fingerprint,
+		    sizeof(entry->fingerprint)) == 0) {
+			fprintf(stderr, "WARNING: duplicate %s in %s (using %s), "
+			    "ignoring...\n", entry->type == X509_LU_CRL ?
+			    "CRL" : "certificate", entry->filename,
+			    last->filename);
+			entry->is_dup = 1;
+			continue;
+		}
+		last = entry;
+		count++;
+	}
+
+	return (count);
+}
+
+static int
+write_u32(FILE *f, uint32_t v)
+{
+	unsigned char buf[4];
+
+	buf[0] = v >> 24;
+	buf[1] = v >> 16;
+	buf[2] = v >> 8;
+	buf[3] = v;
+
+	return (fwrite(buf, sizeof(buf), 1, f) == 1 ? 0 : -1);
+}
+
+static int
+certstore_write_entries(FILE *f, struct storeentries *se, size_t count)
+{
+	struct storeentry *entry;
+	uint64_t offset;
+	size_t i;
+
+	if (fwrite(X509_TRUST_STORE_MAGIC, X509_TRUST_STORE_MAGIC_LEN, 1,
+	    f) != 1)
+		return (-1);
+	if (count > UINT32_MAX || write_u32(f, count) == -1)
+		return (-1);
+
+	offset = X509_TRUST_STORE_MAGIC_LEN + 4 +
+	    (uint64_t)count * X509_TRUST_STORE_ENTRY_LEN;
+	for (i = 0; i < se->len; i++) {
+		entry = &se->entries[i];
+		if (entry->is_dup)
+			continue;
+		if (offset + entry->der_len > UINT32_MAX) {
+			fprintf(stderr, "trust store is too large\n");
+			return (-1);
+		}
+		if (write_u32(f, entry->type) == -1 ||
+		    write_u32(f, entry->hash) == -1 ||
+		    write_u32(f, offset) == -1 ||
+		    write_u32(f, entry->der_len) == -1)
+			return (-1);
+		offset += entry->der_len;
+	}
+
+	for (i = 0; i < se->len; i++) {
+		entry = &se->entries[i];
+		if (entry->is_dup)
+			continue;
+		if (fwrite(entry->der, entry->der_len, 1, f) != 1)
+			return (-1);
+	}
+
+	return (0);
+}
+
+/*
+ * Write the trust store to a temporary file and rename it into place, so
+ * that processes that map the file never see a partially written one.
+ */
+static int
+certstore_write(struct storeentries *se, const char *path)
+{
+	char *tmp = NULL;
+	FILE *f = NULL;
+	size_t count;
+	int fd = -1;
+	int ret = -1;
+
+	if (se->len > 0)
+		qsort(se->entries, se->len, sizeof(*se->entries),
+		    storeentry_compare);
+	count = certstore_dedup(se);
+
+	if (asprintf(&tmp, "%s.XXXXXXXXXX", path) == -1) {
+		fprintf(stderr, "out of memory\n");
+		tmp = NULL;
+		goto err;
+	}
+	if ((fd = mkstemp(tmp)) == -1) {
+		fprintf(stderr, "failed to create %s: %s\n", tmp,
+		    strerror(errno));
+		free(tmp);
+		tmp = NULL;
+		goto err;
+	}
+	if (fchmod(fd, 0644) == -1) {
+		fprintf(stderr, "failed to chmod %s: %s\n", tmp,
+		    strerror(errno));
+		goto err;
+	}
+	if ((f = fdopen(fd, "w")) == NULL) {
+		fprintf(stderr, "failed to fdopen %s\n", tmp);
+		goto err;
+	}
+	fd = -1;
+
+	if (certstore_write_entries(f, se, count) == -1) {
+		fprintf(stderr, "failed to write %s\n", tmp);
+		goto err;
+	}
+	if (fclose(f) != 0) {
+		f = NULL;
+		fprintf(stderr, "failed to write %s\n", tmp);
+		goto err;
+	}
+	f = NULL;
+
+	if (rename(tmp, path) == -1) {
+		fprintf(stderr, "failed to rename %s to %s: %s\n", tmp, path,
+		    strerror(errno));
+		goto err;
+	}
+
+	if (cfg.verbose)
+		fprintf(stdout, "wrote %zu objects to %s\n", count, path);
+
+	ret = 0;
+
+ err:
+	if (f != NULL)
+		fclose(f);
+	if (fd != -1)
+		close(fd);
+	if (ret != 0 && tmp != NULL)
+		unlink(tmp);
+	free(tmp);
+
+	return (ret);
+}
+
+static void
+certstore_usage(void)
+{
+	fprintf(stderr, "usage: certstore [-v] -out file file|dir ...\n");
+	options_usage(certstore_options);
+}
+
+int
+certstore_main(int argc, char **argv)
+{
+	struct storeentries se;
+	struct stat sb;
+	int argsused;
+	int i, ret = 0;
+
+	if (pledge("stdio cpath wpath rpath fattr", NULL) == -1) {
+		perror("pledge");
+		exit(1);
+	}
+
+	memset(&cfg, 0, sizeof(cfg));
+	memset(&se, 0, sizeof(se));
+
+	if (options_parse(argc, argv, certstore_options, NULL,
+	    &argsused) != 0 || cfg.outfile == NULL || argsused == argc) {
+		certstore_usage();
+		return (1);
+	}
+
+	for (i = argsused; i < argc; i++) {
+		if (stat(argv[i], &sb) == -1) {
+			fprintf(stderr, "failed to stat %s: %s\n", argv[i],
+			    strerror(errno));
+			ret = 1;
+			goto done;
+		}
+		if (S_ISDIR(sb.st_mode))
+			ret = certstore_directory(&se, argv[i]);
+		else
+			ret = certstore_file(&se, argv[i]);
+		if (ret == -1) {
+			ret = 1;
+			goto done;
+		}
+	}
+
+	if (certstore_write(&se, cfg.outfile) == -1)
+		ret = 1;
+
+ done:
+	storeentries_free(&se);
+
+	return (ret);
+}
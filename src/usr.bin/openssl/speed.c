@@ -78,8 +78,10 @@
 #define DSA_SECONDS	10
 #define ECDSA_SECONDS   10
 #define ECDH_SECONDS    10
+#define HANDSHAKE_SECONDS	3
 
 #include <math.h>
+#include <pthread.h>
 #include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -91,6 +93,7 @@
 
 #include <openssl/bn.h>
 #include <openssl/crypto.h>
+#include <openssl/curve25519.h>
 #include <openssl/err.h>
 #include <openssl/evp.h>
 #include <openssl/modes.h>
@@ -134,6 +137,7 @@
 #include <openssl/rc4.h>
 #endif
 #include <openssl/rsa.h>
+#include <openssl/ssl.h>
 #ifndef OPENSSL_NO_RIPEMD
 #include <openssl/ripemd.h>
 #endif
@@ -185,6 +189,70 @@ static double rsa_results[RSA_NUM][2];
 static double dsa_results[DSA_NUM][2];
 static double ecdsa_results[EC_NUM][2];
 static double ecdh_results[EC_NUM][1];
+static double x25519_results[1];
+static double ed25519_results[2];
+
+struct handshake_test {
+	const char *name;
+	uint16_t version;
+	const char *cipher;
+	const char *group;
+	int resume;
+};
+
+/*
+ * Full handshakes for each cipher suite and key exchange group, plus
+ * abbreviated handshakes resuming a TLSv1.2 session. The key exchange is
+ * not repeated on resumption, so the group does not matter there.
+ */
+static const struct handshake_test handshake_tests[] = {
+	{ "tls1.3 TLS_AES_128_GCM_SHA256 X25519", TLS1_3_VERSION,
+	    "TLS_AES_128_GCM_SHA256", "X25519", 0 },
+	{ "tls1.3 TLS_AES_128_GCM_SHA256 P-256", TLS1_3_VERSION,
+	    "TLS_AES_128_GCM_SHA256", "P-256", 0 },
+	{ "tls1.3 TLS_AES_128_GCM_SHA256 P-384", TLS1_3_VERSION,
+	    "TLS_AES_128_GCM_SHA256", "P-384", 0 },
+	{ "tls1.3 TLS_AES_256_GCM_SHA384 X25519", TLS1_3_VERSION,
+	    "TLS_AES_256_GCM_SHA384", "X25519", 0 },
+	{ "tls1.3 TLS_AES_256_GCM_SHA384 P-256", TLS1_3_VERSION,
+	    "TLS_AES_256_GCM_SHA384", "P-256", 0 },
+	{ "tls1.3 TLS_AES_256_GCM_SHA384 P-384", TLS1_3_VERSION,
+	    "TLS_AES_256_GCM_SHA384", "P-384", 0 },
+	{ "tls1.3 TLS_CHACHA20_POLY1305_SHA256 X25519", TLS1_3_VERSION,
+	    "TLS_CHACHA20_POLY1305_SHA256", "X25519", 0 },
+	{ "tls1.3 TLS_CHACHA20_POLY1305_SHA256 P-256", TLS1_3_VERSION,
+	    "TLS_CHACHA20_POLY1305_SHA256", "P-256", 0 },
+	{ "tls1.3 TLS_CHACHA20_POLY1305_SHA256 P-384", TLS1_3_VERSION,
+	    "TLS_CHACHA20_POLY1305_SHA256", "P-384", 0 },
+	{ "tls1.2 ECDHE-RSA-AES128-GCM-SHA256 X25519", TLS1_2_VERSION,
+	    "ECDHE-RSA-AES128-GCM-SHA256", "X25519", 0 },
+	{ "tls1.2 ECDHE-RSA-AES128-GCM-SHA256 P-256", TLS1_2_VERSION,
+	    "ECDHE-RSA-AES128-GCM-SHA256", "P-256", 0 },
+	{ "tls1.2 ECDHE-RSA-AES128-GCM-SHA256 P-384", TLS1_2_VERSION,
+	    "ECDHE-RSA-AES128-GCM-SHA256", "P-384", 0 },
+	{ "tls1.2 ECDHE-RSA-AES256-GCM-SHA384 X25519", TLS1_2_VERSION,
+	    "ECDHE-RSA-AES256-GCM-SHA384", "X25519", 0 },
+	{ "tls1.2 ECDHE-RSA-AES256-GCM-SHA384 P-256", TLS1_2_VERSION,
+	    "ECDHE-RSA-AES256-GCM-SHA384", "P-256", 0 },
+	{ "tls1.2 ECDHE-RSA-AES256-GCM-SHA384 P-384", TLS1_2_VERSION,
+	    "ECDHE-RSA-AES256-GCM-SHA384", "P-384", 0 },
+	{ "tls1.2 ECDHE-RSA-CHACHA20-POLY1305 X25519", TLS1_2_VERSION,
+	    "ECDHE-RSA-CHACHA20-POLY1305", "X25519", 0 },
+	{ "tls1.2 ECDHE-RSA-CHACHA20-POLY1305 P-256", TLS1_2_VERSION,
+	    "ECDHE-RSA-CHACHA20-POLY1305", "P-256", 0 },
+	{ "tls1.2 ECDHE-RSA-CHACHA20-POLY1305 P-384", TLS1_2_VERSION,
+	    "ECDHE-RSA-CHACHA20-POLY1305", "P-384", 0 },
+	{ "tls1.2 ECDHE-RSA-AES128-GCM-SHA256 resumed", TLS1_2_VERSION,
+	    "ECDHE-RSA-AES128-GCM-SHA256", "X25519", 1 },
+	{ "tls1.2 ECDHE-RSA-AES256-GCM-SHA384 resumed", TLS1_2_VERSION,
+	    "ECDHE-RSA-AES256-GCM-SHA384", "X25519", 1 },
+	{ "tls1.2 ECDHE-RSA-CHACHA20-POLY1305 resumed", TLS1_2_VERSION,
+	    "ECDHE-RSA-CHACHA20-POLY1305", "X25519", 1 },
+};
+
+#define HANDSHAKE_NUM (sizeof(handshake_tests) / sizeof(handshake_tests[0]))
+
+static double handshake_results[HANDSHAKE_NUM];
 
 static void sig_done(int sig);
 
@@ -224,6 +292,492 @@ KDF1_SHA1(const void *in, size_t inlen, void *out, size_t * outlen)
 #endif				/* OPENSSL_NO_SHA */
 }
 
+/* Create a self-signed certificate for the handshake server. */
+static X509 *
+handshake_cert_new(EVP_PKEY *pkey)
+{
+	X509 *x509;
+	X509_NAME *name;
+
+	if ((x509 = X509_new()) == NULL)
+		goto err;
+	if (!X509_set_version(x509, 2))
+		goto err;
+	if (!ASN1_INTEGER_set(X509_get_serialNumber(x509), 1))
+		goto err;
+	if (X509_gmtime_adj(X509_get_notBefore(x509), 0) == NULL)
+		goto err;
+	if (X509_gmtime_adj(X509_get_notAfter(x509), 86400) == NULL)
+		goto err;
+	if (!X509_set_pubkey(x509, pkey))
+		goto err;
+	name = X509_get_subject_name(x509);
+	if (!X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC,
+	    (const unsigned char *)"speed", -1, -1, 0))
+		goto err;
+	if (!X509_set_issuer_name(x509, name))
+		goto err;
+	if (!X509_sign(x509, pkey, EVP_sha256()))
+		goto err;
+
+	return x509;
+
+ err:
+	X509_free(x509);
+	return NULL;
+}
+
+/*
+ * Set up a client and server context for a handshake test. The client
+ * verifies the server certificate against a store holding just that
+ * certificate, as a real client would against its trust store.
+ */
+static int
+handshake_ctx_new(const struct handshake_test *ht, EVP_PKEY *pkey, X509 *x509,
+    SSL_CTX **client_ctx, SSL_CTX **server_ctx)
+{
+	SSL_CTX *ctx[2] = { NULL, NULL };
+	int i;
+
+	if ((ctx[0] = SSL_CTX_new(TLS_client_method())) == NULL)
+		goto err;
+	if ((ctx[1] = SSL_CTX_new(TLS_server_method())) == NULL)
+		goto err;
+
+	for (i = 0; i < 2; i++) {
+		if (!SSL_CTX_set_min_proto_version(ctx[i], ht->version))
+			goto err;
+		if (!SSL_CTX_set_max_proto_version(ctx[i], ht->version))
+			goto err;
+		if (ht->version == TLS1_3_VERSION) {
+			if (!SSL_CTX_set_ciphersuites(ctx[i], ht->cipher))
+				goto err;
+		} else {
+			if (!SSL_CTX_set_cipher_list(ctx[i], ht->cipher))
+				goto err;
+		}
+		if (!SSL_CTX_set1_groups_list(ctx[i], ht->group))
+			goto err;
+	}
+
+	if (!X509_STORE_add_cert(SSL_CTX_get_cert_store(ctx[0]), x509))
+		goto err;
+	SSL_CTX_set_verify(ctx[0], SSL_VERIFY_PEER, NULL);
+
+	if (!SSL_CTX_use_certificate(ctx[1], x509))
+		goto err;
+	if (!SSL_CTX_use_PrivateKey(ctx[1], pkey))
+		goto err;
+
+	*client_ctx = ctx[0];
+	*server_ctx = ctx[1];
+
+	return 1;
+
+ err:
+	SSL_CTX_free(ctx[0]);
+	SSL_CTX_free(ctx[1]);
+
+	return 0;
+}
+
+static int
+handshake_want_retry(SSL *ssl, int ret)
+{
+	int err;
+
+	err = SSL_get_error(ssl, ret);
+
+	return err == SSL_ERROR_WANT_READ || err == SSL_ERROR_WANT_WRITE;
+}
+
+/*
+ * Perform a complete handshake between a client and a server, connected by
+ * a BIO pair. If session is not NULL, the client resumes the session
+ * stored there, or stores its session there if there is none yet.
+ */
+static int
+handshake_run(SSL_CTX *client_ctx, SSL_CTX *server_ctx, SSL_SESSION **session)
+{
+	SSL *client = NULL, *server = NULL;
+	BIO *client_bio = NULL, *server_bio = NULL;
+	int client_done = 0, server_done = 0;
+	int ret = 0;
+	int i, rv;
+
+	if (!BIO_new_bio_pair(&client_bio, 0, &server_bio, 0))
+		goto err;
+	if ((client = SSL_new(client_ctx)) == NULL)
+		goto err;
+	if ((server = SSL_new(server_ctx)) == NULL)
+		goto err;
+
+	SSL_set_bio(client, client_bio, client_bio);
+	SSL_set_bio(server, server_bio, server_bio);
+	client_bio = NULL;
+	server_bio = NULL;
+
+	SSL_set_connect_state(client);
+	SSL_set_accept_state(server);
+
+	if (session != NULL && *session != NULL) {
+		if (!SSL_set_session(client, *session))
+			goto err;
+	}
+
+	for (i = 0; i < 32 && (!client_done || !server_done); i++) {
+		if (!client_done) {
+			if ((rv = SSL_do_handshake(client)) == 1)
+				client_done = 1;
+			else if (!handshake_want_retry(client, rv))
+				goto err;
+		}
+		if (!server_done) {
+			if ((rv = SSL_do_handshake(server)) == 1)
+				server_done = 1;
+			else if (!handshake_want_retry(server, rv))
+				goto err;
+		}
+	}
+	if (!client_done || !server_done)
+		goto err;
+
+	if (session != NULL) {
+		if (*session == NULL) {
+			if ((*session = SSL_get1_session(client)) == NULL)
+				goto err;
+		} else if (!SSL_session_reused(client))
+			goto err;
+	}
+
+	ret = 1;
+
+ err:
+	SSL_free(client);
+	SSL_free(server);
+	BIO_free(client_bio);
+	BIO_free(server_bio);
+
+	return ret;
+}
+
+/*
+ * With -threads, a benchmark runs its operation in several threads at once.
+ * The threads share the keys and contexts set up by speed_main, only the
+ * input and output buffers and whatever state can not be shared are
+ * per thread.
+ */
+struct speed_thread {
+	pthread_t thread;
+	int (*op)(struct speed_thread *);
+	const void *bench;
+	unsigned char *buf;
+	unsigned char *out;
+	EVP_CIPHER_CTX *cipher_ctx;
+	SSL_SESSION *session;
+	long count;
+	int failed;
+};
+
+struct speed_evp {
+	int decrypt;
+	int length;
+	const EVP_MD *md;
+};
+
+struct speed_pkey {
+	RSA *rsa;
+	DSA *dsa;
+	EC_KEY *ec_key;
+	const EC_POINT *peer;
+	void *(*kdf)(const void *, size_t, void *, size_t *);
+	int outlen;
+	const unsigned char *sig;
+	unsigned int siglen;
+	const uint8_t *public_key;
+	const uint8_t *private_key;
+};
+
+struct speed_handshake {
+	SSL_CTX *client_ctx;
+	SSL_CTX *server_ctx;
+	int resume;
+};
+
+static int threads = 0;
+static struct speed_thread *speed_thread;
+
+static int
+speed_evp_cipher_op(struct speed_thread *st)
+{
+	const struct speed_evp *se = st->bench;
+	int outl;
+
+	if (se->decrypt)
+		return EVP_DecryptUpdate(st->cipher_ctx, st->out, &outl,
+		    st->buf, se->length);
+	return EVP_EncryptUpdate(st->cipher_ctx, st->out, &outl, st->buf,
+	    se->length);
+}
+
+static int
+speed_evp_digest_op(struct speed_thread *st)
+{
+	const struct speed_evp *se = st->bench;
+
+	return EVP_Digest(st->buf, se->length, st->out, NULL, se->md, NULL);
+}
+
+static int
+speed_rsa_sign_op(struct speed_thread *st)
+{
+	const struct speed_pkey *sp = st->bench;
+	unsigned int siglen;
+
+	return RSA_sign(NID_md5_sha1, st->buf, 36, st->out, &siglen, sp->rsa);
+}
+
+static int
+speed_rsa_verify_op(struct speed_thread *st)
+{
+	const struct speed_pkey *sp = st->bench;
+
+	return RSA_verify(NID_md5_sha1, st->buf, 36, sp->sig, sp->siglen,
+	    sp->rsa) > 0;
+}
+
+static int
+speed_dsa_sign_op(struct speed_thread *st)
+{
+	const struct speed_pkey *sp = st->bench;
+	unsigned int siglen;
+
+	return DSA_sign(EVP_PKEY_DSA, st->buf, 20, st->out, &siglen, sp->dsa);
+}
+
+static int
+speed_dsa_verify_op(struct speed_thread *st)
+{
+	const struct speed_pkey *sp = st->bench;
+
+	return DSA_verify(EVP_PKEY_DSA, st->buf, 20, sp->sig, sp->siglen,
+	    sp->dsa) > 0;
+}
+
+static int
+speed_ecdsa_sign_op(struct speed_thread *st)
+{
+	const struct speed_pkey *sp = st->bench;
+	unsigned int siglen;
+
+	return ECDSA_sign(0, st->buf, 20, st->out, &siglen, sp->ec_key);
+}
+
+static int
+speed_ecdsa_verify_op(struct speed_thread *st)
+{
+	const struct speed_pkey *sp = st->bench;
+
+	return ECDSA_verify(0, st->buf, 20, sp->sig, sp->siglen,
+	    sp->ec_key) == 1;
+}
+
+static int
+speed_ecdh_op(struct speed_thread *st)
+{
+	const struct speed_pkey *sp = st->bench;
+
+	return ECDH_compute_key(st->out, sp->outlen, sp->peer, sp->ec_key,
+	    sp->kdf) > 0;
+}
+
+static int
+speed_x25519_op(struct speed_thread *st)
+{
+	const struct speed_pkey *sp = st->bench;
+
+	return X25519(st->out, sp->private_key, sp->public_key);
+}
+
+static int
+speed_ed25519_sign_op(struct speed_thread *st)
+{
+	const struct speed_pkey *sp = st->bench;
+
+	return ED25519_sign(st->out, st->buf, 20, sp->public_key,
+	    sp->private_key);
+}
+
+static int
+speed_ed25519_verify_op(struct speed_thread *st)
+{
+	const struct speed_pkey *sp = st->bench;
+
+	return ED25519_verify(st->buf, 20, sp->sig, sp->public_key);
+}
+
+static int
+speed_handshake_op(struct speed_thread *st)
+{
+	const struct speed_handshake *sh = st->bench;
+
+	return handshake_run(sh->client_ctx, sh->server_ctx,
+	    sh->resume ? &st->session : NULL);
+}
+
+static int
+speed_threads_init(void)
+{
+	int i;
+
+	if ((speed_thread = calloc(threads, sizeof(*speed_thread))) == NULL)
+		return 0;
+	for (i = 0; i < threads; i++) {
+		if ((speed_thread[i].buf = malloc(BUFSIZE)) == NULL)
+			return 0;
+		if ((speed_thread[i].out = malloc(BUFSIZE)) == NULL)
+			return 0;
+	}
+
+	return 1;
+}
+
+static void
+speed_threads_free(void)
+{
+	int i;
+
+	if (speed_thread == NULL)
+		return;
+	for (i = 0; i < threads; i++) {
+		free(speed_thread[i].buf);
+		free(speed_thread[i].out);
+		EVP_CIPHER_CTX_free(speed_thread[i].cipher_ctx);
+		SSL_SESSION_free(speed_thread[i].session);
+	}
+	free(speed_thread);
+	speed_thread = NULL;
+}
+
+/*
+ * Give every thread its own cipher context, keyed like the one used by
+ * the single threaded benchmark.
+ */
+static int
+speed_threads_cipher_init(const EVP_CIPHER *cipher, int decrypt,
+    const unsigned char *key, const unsigned char *iv)
+{
+	EVP_CIPHER_CTX *ctx;
+	int i;
+
+	for (i = 0; i < threads; i++) {
+		if ((ctx = speed_thread[i].cipher_ctx) == NULL) {
+			if ((ctx = EVP_CIPHER_CTX_new()) == NULL)
+				return 0;
+			speed_thread[i].cipher_ctx = ctx;
+		}
+		if (!EVP_CipherInit_ex(ctx, cipher, NULL, key, iv, !decrypt))
+			return 0;
+		EVP_CIPHER_CTX_set_padding(ctx, 0);
+	}
+
+	return 1;
+}
+
+/*
+ * Establish a session per thread, so that resumption does not serialise
+ * all threads on a single SSL_SESSION.
+ */
+static int
+speed_threads_sessions(SSL_CTX *client_ctx, SSL_CTX *server_ctx)
+{
+	int i;
+
+	for (i = 0; i < threads; i++) {
+		SSL_SESSION_free(speed_thread[i].session);
+		speed_thread[i].session = NULL;
+		if (!handshake_run(client_ctx, server_ctx,
+		    &speed_thread[i].session))
+			return 0;
+	}
+
+	return 1;
+}
+
+static void *
+speed_thread_main(void *arg)
+{
+	struct speed_thread *st = arg;
+
+	for (st->count = 0; run && st->count < 0x7fffffff; st->count++) {
+		if (!st->op(st)) {
+			st->failed = 1;
+			ERR_print_errors(bio_err);
+			break;
+		}
+	}
+
+	return NULL;
+}
+
+/*
+ * Run op in all threads until the alarm goes off, copying the input from
+ * buf. Returns the total number of operations, or 1 if any of the threads
+ * failed, like the single threaded loops do.
+ */
+static long
+speed_threads_run(int (*op)(struct speed_thread *), const void *bench,
+    const unsigned char *buf)
+{
+	struct speed_thread *st;
+	long count = 0;
+	int failed = 0;
+	int i;
+
+	run = 1;
+	for (i = 0; i < threads; i++) {
+		st = &speed_thread[i];
+		st->op = op;
+		st->bench = bench;
+		st->count = 0;
+		st->failed = 0;
+		memcpy(st->buf, buf, BUFSIZE);
+		if (pthread_create(&st->thread, NULL, speed_thread_main,
+		    st) != 0) {
+			BIO_printf(bio_err, "pthread_create failure\n");
+			exit(1);
+		}
+	}
+	for (i = 0; i < threads; i++) {
+		st = &speed_thread[i];
+		pthread_join(st->thread, NULL);
+		if (st->failed) {
+			BIO_printf(bio_err, "thread %d failure\n", i);
+			failed = 1;
+		}
+		count += st->count;
+	}
+
+	return failed ? 1 : count;
+}
+
+static void
+speed_threads_report(double d)
+{
+	struct speed_thread *st;
+	int i;
+
+	for (i = 0; i < threads; i++) {
+		st = &speed_thread[i];
+		if (mr)
+			BIO_printf(bio_err, "+RT:%d:%ld:%f\n", i, st->count,
+			    d);
+		else
+			BIO_printf(bio_err, "  thread %2d: %ld in %.2fs "
+			    "(%.1f/s)\n", i, st->count, d, st->count / d);
+	}
+}
+
 int
 speed_main(int argc, char **argv)
 {
@@ -457,10 +1011,28 @@ speed_main(int argc, char **argv)
 	int secret_idx = 0;
 	long ecdh_c[EC_NUM][2];
 
+	uint8_t x25519_public[X25519_KEY_LENGTH];
+	uint8_t x25519_private[X25519_KEY_LENGTH];
+	uint8_t x25519_shared[X25519_KEY_LENGTH];
+	uint8_t ed25519_public[ED25519_PUBLIC_KEY_LENGTH];
+	uint8_t ed25519_private[ED25519_PRIVATE_KEY_LENGTH];
+	uint8_t ed25519_sig[ED25519_SIGNATURE_LENGTH];
+
+	EVP_PKEY *handshake_pkey = NULL;
+	X509 *handshake_x509 = NULL;
+	SSL_CTX *handshake_client_ctx = NULL, *handshake_server_ctx = NULL;
+	SSL_SESSION *handshake_session = NULL;
+	struct speed_evp se;
+	struct speed_pkey sp;
+	struct speed_handshake sh;
+
 	int rsa_doit[RSA_NUM];
 	int dsa_doit[DSA_NUM];
 	int ecdsa_doit[EC_NUM];
 	int ecdh_doit[EC_NUM];
+	int x25519_doit = 0;
+	int ed25519_doit = 0;
+	int handshake_doit[HANDSHAKE_NUM];
 	int doit[ALGOR_NUM];
 	int pr_header = 0;
 	const EVP_CIPHER *evp_cipher = NULL;
@@ -477,6 +1049,9 @@ speed_main(int argc, char **argv)
 	usertime = -1;
 
 	memset(results, 0, sizeof(results));
+	memset(&se, 0, sizeof(se));
+	memset(&sp, 0, sizeof(sp));
+	memset(&sh, 0, sizeof(sh));
 	memset(dsa_key, 0, sizeof(dsa_key));
 	for (i = 0; i < EC_NUM; i++)
 		ecdsa[i] = NULL;
@@ -511,6 +1086,8 @@ speed_main(int argc, char **argv)
 		ecdsa_doit[i] = 0;
 	for (i = 0; i < EC_NUM; i++)
 		ecdh_doit[i] = 0;
+	for (i = 0; i < HANDSHAKE_NUM; i++)
+		handshake_doit[i] = 0;
 
 
 	j = 0;
@@ -557,6 +1134,24 @@ speed_main(int argc, char **argv)
 			j--;	/* Otherwise, -multi gets confused with an
 				 * algorithm. */
 		}
+		else if ((argc > 0) && (strcmp(*argv, "-threads") == 0)) {
+			argc--;
+			argv++;
+			if (argc == 0) {
+				BIO_printf(bio_err, "no thread count given\n");
+				goto end;
+			}
+			threads = strtonum(argv[0], 1, 1024, &errstr);
+			if (errstr) {
+				BIO_printf(bio_err, "bad thread count: %s",
+				    errstr);
+				goto end;
+			}
+			/* User time is summed over all threads. */
+			usertime = 0;
+			j--;	/* Otherwise, -threads gets confused with an
+				 * algorithm. */
+		}
 		else if (argc > 0 && !strcmp(*argv, "-mr")) {
 			mr = 1;
 			j--;	/* Otherwise, -mr gets confused with an
@@ -812,6 +1407,23 @@ speed_main(int argc, char **argv)
 		else if (strcmp(*argv, "ecdh") == 0) {
 			for (i = 0; i < EC_NUM; i++)
 				ecdh_doit[i] = 1;
+		} else if (strcmp(*argv, "x25519") == 0)
+			x25519_doit = 1;
+		else if (strcmp(*argv, "ed25519") == 0)
+			ed25519_doit = 1;
+		else if (strcmp(*argv, "tls") == 0) {
+			for (i = 0; i < HANDSHAKE_NUM; i++)
+				handshake_doit[i] = 1;
+		} else if (strcmp(*argv, "tls1.2") == 0) {
+			for (i = 0; i < HANDSHAKE_NUM; i++) {
+				if (handshake_tests[i].version == TLS1_2_VERSION)
+					handshake_doit[i] = 1;
+			}
+		} else if (strcmp(*argv, "tls1.3") == 0) {
+			for (i = 0; i < HANDSHAKE_NUM; i++) {
+				if (handshake_tests[i].version == TLS1_3_VERSION)
+					handshake_doit[i] = 1;
+			}
 		} else
 		{
 			BIO_printf(bio_err, "Error: bad option or value\n");
@@ -886,6 +1498,8 @@ speed_main(int argc, char **argv)
 			BIO_printf(bio_err, "ecdhp160  ecdhp192  ecdhp224  ecdhp256  ecdhp384  ecdhp521\n");
 			BIO_printf(bio_err, "ecdhk163  ecdhk233  ecdhk283  ecdhk409  ecdhk571\n");
 			BIO_printf(bio_err, "ecdhb163  ecdhb233  ecdhb283  ecdhb409  ecdhb571  ecdh\n");
+			BIO_printf(bio_err, "x25519    ed25519\n");
+			BIO_printf(bio_err, "tls1.2    tls1.3    tls\n");
 
 #ifndef OPENSSL_NO_IDEA
 			BIO_printf(bio_err, "idea     ");
@@ -920,6 +1534,7 @@ speed_main(int argc, char **argv)
 			BIO_printf(bio_err, "-decrypt        time decryption instead of encryption (only EVP).\n");
 			BIO_printf(bio_err, "-mr             produce machine readable output.\n");
 			BIO_printf(bio_err, "-multi n        run n benchmarks in parallel.\n");
+			BIO_printf(bio_err, "-threads n      run n benchmark threads sharing one context.\n");
 			goto end;
 		}
 		argc--;
@@ -927,6 +1542,16 @@ speed_main(int argc, char **argv)
 		j++;
 	}
 
+	if (multi && threads) {
+		BIO_printf(bio_err, "-multi and -threads are mutually "
+		    "exclusive\n");
+		goto end;
+	}
+	if (threads && !speed_threads_init()) {
+		BIO_printf(bio_err, "out of memory\n");
+		goto end;
+	}
+
 	if (multi && do_multi(multi))
 		goto show_res;
 
@@ -943,6 +1568,10 @@ speed_main(int argc, char **argv)
 			ecdsa_doit[i] = 1;
 		for (i = 0; i < EC_NUM; i++)
 			ecdh_doit[i] = 1;
+		x25519_doit = 1;
+		ed25519_doit = 1;
+		for (i = 0; i < HANDSHAKE_NUM; i++)
+			handshake_doit[i] = 1;
 	}
 	for (i = 0; i < ALGOR_NUM; i++)
 		if (doit[i])
@@ -1447,30 +2076,45 @@ speed_main(int argc, char **argv)
 				print_message(names[D_EVP], save_count,
 				    lengths[j]);
 
-				if ((ctx = EVP_CIPHER_CTX_new()) == NULL) {
-					BIO_printf(bio_err, "Failed to "
-					    "allocate cipher context.\n");
-					goto end;
-				}
-				if (decrypt)
-					EVP_DecryptInit_ex(ctx, evp_cipher, NULL, key16, iv);
-				else
-					EVP_EncryptInit_ex(ctx, evp_cipher, NULL, key16, iv);
-				EVP_CIPHER_CTX_set_padding(ctx, 0);
+				if (threads) {
+					if (!speed_threads_cipher_init(
+					    evp_cipher, decrypt, key16, iv)) {
+						BIO_printf(bio_err, "Failed to "
+						    "set up cipher contexts.\n");
+						goto end;
+					}
+					se.decrypt = decrypt;
+					se.length = lengths[j];
+					Time_F(START);
+					count = speed_threads_run(
+					    speed_evp_cipher_op, &se, buf);
+					d = Time_F(STOP);
+				} else {
+					if ((ctx = EVP_CIPHER_CTX_new()) == NULL) {
+						BIO_printf(bio_err, "Failed to "
+						    "allocate cipher context.\n");
+						goto end;
+					}
+					if (decrypt)
+						EVP_DecryptInit_ex(ctx, evp_cipher, NULL, key16, iv);
+					else
+						EVP_EncryptInit_ex(ctx, evp_cipher, NULL, key16, iv);
+					EVP_CIPHER_CTX_set_padding(ctx, 0);
 
-				Time_F(START);
-				if (decrypt)
-					for (count = 0, run = 1; COND(save_count * 4 * lengths[0] / lengths[j]); count++)
-						EVP_DecryptUpdate(ctx, buf, &outl, buf, lengths[j]);
-				else
-					for (count = 0, run = 1; COND(save_count * 4 * lengths[0] / lengths[j]); count++)
-						EVP_EncryptUpdate(ctx, buf, &outl, buf, lengths[j]);
-				if (decrypt)
-					EVP_DecryptFinal_ex(ctx, buf, &outl);
-				else
-					EVP_EncryptFinal_ex(ctx, buf, &outl);
-				d = Time_F(STOP);
-				EVP_CIPHER_CTX_free(ctx);
+					Time_F(START);
+					if (decrypt)
+						for (count = 0, run = 1; COND(save_count * 4 * lengths[0] / lengths[j]); count++)
+							EVP_DecryptUpdate(ctx, buf, &outl, buf, lengths[j]);
+					else
+						for (count = 0, run = 1; COND(save_count * 4 * lengths[0] / lengths[j]); count++)
+							EVP_EncryptUpdate(ctx, buf, &outl, buf, lengths[j]);
+					if (decrypt)
+						EVP_DecryptFinal_ex(ctx, buf, &outl);
+					else
+						EVP_EncryptFinal_ex(ctx, buf, &outl);
+					d = Time_F(STOP);
+					EVP_CIPHER_CTX_free(ctx);
+				}
 			}
 			if (evp_md) {
 				names[D_EVP] = OBJ_nid2ln(EVP_MD_type(evp_md));
@@ -1478,12 +2122,20 @@ speed_main(int argc, char **argv)
 				    lengths[j]);
 
 				Time_F(START);
-				for (count = 0, run = 1; COND(save_count * 4 * lengths[0] / lengths[j]); count++)
-					EVP_Digest(buf, lengths[j], &(md[0]), NULL, evp_md, NULL);
-
+				if (threads) {
+					se.md = evp_md;
+					se.length = lengths[j];
+					count = speed_threads_run(
+					    speed_evp_digest_op, &se, buf);
+				} else {
+					for (count = 0, run = 1; COND(save_count * 4 * lengths[0] / lengths[j]); count++)
+						EVP_Digest(buf, lengths[j], &(md[0]), NULL, evp_md, NULL);
+				}
 				d = Time_F(STOP);
 			}
 			print_result(D_EVP, j, count, d);
+			if (threads)
+				speed_threads_report(d);
 		}
 	}
 	arc4random_buf(buf, 36);
@@ -1502,15 +2154,21 @@ speed_main(int argc, char **argv)
 			    RSA_SECONDS);
 /*			RSA_blinding_on(rsa_key[j],NULL); */
 			Time_F(START);
-			for (count = 0, run = 1; COND(rsa_c[j][0]); count++) {
-				ret = RSA_sign(NID_md5_sha1, buf, 36, buf2,
-				    &rsa_num, rsa_key[j]);
-				if (ret == 0) {
-					BIO_printf(bio_err,
-					    "RSA sign failure\n");
-					ERR_print_errors(bio_err);
-					count = 1;
-					break;
+			if (threads) {
+				sp.rsa = rsa_key[j];
+				count = speed_threads_run(speed_rsa_sign_op,
+				    &sp, buf);
+			} else {
+				for (count = 0, run = 1; COND(rsa_c[j][0]); count++) {
+					ret = RSA_sign(NID_md5_sha1, buf, 36, buf2,
+					    &rsa_num, rsa_key[j]);
+					if (ret == 0) {
+						BIO_printf(bio_err,
+						    "RSA sign failure\n");
+						ERR_print_errors(bio_err);
+						count = 1;
+						break;
+					}
 				}
 			}
 			d = Time_F(STOP);
@@ -1518,6 +2176,8 @@ speed_main(int argc, char **argv)
 			    : "%ld %d bit private RSA in %.2fs\n",
 			    count, rsa_bits[j], d);
 			rsa_results[j][0] = d / (double) count;
+			if (threads)
+				speed_threads_report(d);
 			rsa_count = count;
 		}
 
@@ -1531,15 +2191,23 @@ speed_main(int argc, char **argv)
 			    rsa_c[j][1], rsa_bits[j],
 			    RSA_SECONDS);
 			Time_F(START);
-			for (count = 0, run = 1; COND(rsa_c[j][1]); count++) {
-				ret = RSA_verify(NID_md5_sha1, buf, 36, buf2,
-				    rsa_num, rsa_key[j]);
-				if (ret <= 0) {
-					BIO_printf(bio_err,
-					    "RSA verify failure\n");
-					ERR_print_errors(bio_err);
-					count = 1;
-					break;
+			if (threads) {
+				sp.rsa = rsa_key[j];
+				sp.sig = buf2;
+				sp.siglen = rsa_num;
+				count = speed_threads_run(speed_rsa_verify_op,
+				    &sp, buf);
+			} else {
+				for (count = 0, run = 1; COND(rsa_c[j][1]); count++) {
+					ret = RSA_verify(NID_md5_sha1, buf, 36, buf2,
+					    rsa_num, rsa_key[j]);
+					if (ret <= 0) {
+						BIO_printf(bio_err,
+						    "RSA verify failure\n");
+						ERR_print_errors(bio_err);
+						count = 1;
+						break;
+					}
 				}
 			}
 			d = Time_F(STOP);
@@ -1547,6 +2215,8 @@ speed_main(int argc, char **argv)
 			    : "%ld %d bit public RSA in %.2fs\n",
 			    count, rsa_bits[j], d);
 			rsa_results[j][1] = d / (double) count;
+			if (threads)
+				speed_threads_report(d);
 		}
 
 		if (rsa_count <= 1) {
@@ -1576,15 +2246,21 @@ speed_main(int argc, char **argv)
 			    dsa_c[j][0], dsa_bits[j],
 			    DSA_SECONDS);
 			Time_F(START);
-			for (count = 0, run = 1; COND(dsa_c[j][0]); count++) {
-				ret = DSA_sign(EVP_PKEY_DSA, buf, 20, buf2,
-				    &kk, dsa_key[j]);
-				if (ret == 0) {
-					BIO_printf(bio_err,
-					    "DSA sign failure\n");
-					ERR_print_errors(bio_err);
-					count = 1;
-					break;
+			if (threads) {
+				sp.dsa = dsa_key[j];
+				count = speed_threads_run(speed_dsa_sign_op,
+				    &sp, buf);
+			} else {
+				for (count = 0, run = 1; COND(dsa_c[j][0]); count++) {
+					ret = DSA_sign(EVP_PKEY_DSA, buf, 20, buf2,
+					    &kk, dsa_key[j]);
+					if (ret == 0) {
+						BIO_printf(bio_err,
+						    "DSA sign failure\n");
+						ERR_print_errors(bio_err);
+						count = 1;
+						break;
+					}
 				}
 			}
 			d = Time_F(STOP);
@@ -1592,6 +2268,8 @@ speed_main(int argc, char **argv)
 			    : "%ld %d bit DSA signs in %.2fs\n",
 			    count, dsa_bits[j], d);
 			dsa_results[j][0] = d / (double) count;
+			if (threads)
+				speed_threads_report(d);
 			rsa_count = count;
 		}
 
@@ -1606,15 +2284,23 @@ speed_main(int argc, char **argv)
 			    dsa_c[j][1], dsa_bits[j],
 			    DSA_SECONDS);
 			Time_F(START);
-			for (count = 0, run = 1; COND(dsa_c[j][1]); count++) {
-				ret = DSA_verify(EVP_PKEY_DSA, buf, 20, buf2,
-				    kk, dsa_key[j]);
-				if (ret <= 0) {
-					BIO_printf(bio_err,
-					    "DSA verify failure\n");
-					ERR_print_errors(bio_err);
-					count = 1;
-					break;
+			if (threads) {
+				sp.dsa = dsa_key[j];
+				sp.sig = buf2;
+				sp.siglen = kk;
+				count = speed_threads_run(speed_dsa_verify_op,
+				    &sp, buf);
+			} else {
+				for (count = 0, run = 1; COND(dsa_c[j][1]); count++) {
+					ret = DSA_verify(EVP_PKEY_DSA, buf, 20, buf2,
+					    kk, dsa_key[j]);
+					if (ret <= 0) {
+						BIO_printf(bio_err,
+						    "DSA verify failure\n");
+						ERR_print_errors(bio_err);
+						count = 1;
+						break;
+					}
 				}
 			}
 			d = Time_F(STOP);
@@ -1622,6 +2308,8 @@ speed_main(int argc, char **argv)
 			    : "%ld %d bit DSA verify in %.2fs\n",
 			    count, dsa_bits[j], d);
 			dsa_results[j][1] = d / (double) count;
+			if (threads)
+				speed_threads_report(d);
 		}
 
 		if (rsa_count <= 1) {
@@ -1659,16 +2347,22 @@ speed_main(int argc, char **argv)
 				    ECDSA_SECONDS);
 
 				Time_F(START);
-				for (count = 0, run = 1; COND(ecdsa_c[j][0]);
-				    count++) {
-					ret = ECDSA_sign(0, buf, 20,
-					    ecdsasig, &ecdsasiglen,
-					    ecdsa[j]);
-					if (ret == 0) {
-						BIO_printf(bio_err, "ECDSA sign failure\n");
-						ERR_print_errors(bio_err);
-						count = 1;
-						break;
+				if (threads) {
+					sp.ec_key = ecdsa[j];
+					count = speed_threads_run(speed_ecdsa_sign_op,
+					    &sp, buf);
+				} else {
+					for (count = 0, run = 1; COND(ecdsa_c[j][0]);
+					    count++) {
+						ret = ECDSA_sign(0, buf, 20,
+						    ecdsasig, &ecdsasiglen,
+						    ecdsa[j]);
+						if (ret == 0) {
+							BIO_printf(bio_err, "ECDSA sign failure\n");
+							ERR_print_errors(bio_err);
+							count = 1;
+							break;
+						}
 					}
 				}
 				d = Time_F(STOP);
@@ -1677,6 +2371,8 @@ speed_main(int argc, char **argv)
 				    "%ld %d bit ECDSA signs in %.2fs \n",
 				    count, test_curves_bits[j], d);
 				ecdsa_results[j][0] = d / (double) count;
+				if (threads)
+					speed_threads_report(d);
 				rsa_count = count;
 			}
 
@@ -1693,13 +2389,21 @@ speed_main(int argc, char **argv)
 				    test_curves_bits[j],
 				    ECDSA_SECONDS);
 				Time_F(START);
-				for (count = 0, run = 1; COND(ecdsa_c[j][1]); count++) {
-					ret = ECDSA_verify(0, buf, 20, ecdsasig, ecdsasiglen, ecdsa[j]);
-					if (ret != 1) {
-						BIO_printf(bio_err, "ECDSA verify failure\n");
-						ERR_print_errors(bio_err);
-						count = 1;
-						break;
+				if (threads) {
+					sp.ec_key = ecdsa[j];
+					sp.sig = ecdsasig;
+					sp.siglen = ecdsasiglen;
+					count = speed_threads_run(speed_ecdsa_verify_op,
+					    &sp, buf);
+				} else {
+					for (count = 0, run = 1; COND(ecdsa_c[j][1]); count++) {
+						ret = ECDSA_verify(0, buf, 20, ecdsasig, ecdsasiglen, ecdsa[j]);
+						if (ret != 1) {
+							BIO_printf(bio_err, "ECDSA verify failure\n");
+							ERR_print_errors(bio_err);
+							count = 1;
+							break;
+						}
 					}
 				}
 				d = Time_F(STOP);
@@ -1707,6 +2411,8 @@ speed_main(int argc, char **argv)
 				    : "%ld %d bit ECDSA verify in %.2fs\n",
 				    count, test_curves_bits[j], d);
 				ecdsa_results[j][1] = d / (double) count;
+				if (threads)
+					speed_threads_report(d);
 			}
 
 			if (rsa_count <= 1) {
@@ -1780,12 +2486,21 @@ speed_main(int argc, char **argv)
 					    test_curves_bits[j],
 					    ECDH_SECONDS);
 					Time_F(START);
-					for (count = 0, run = 1;
-					     COND(ecdh_c[j][0]); count++) {
-						ECDH_compute_key(secret_a,
-						    outlen,
-						    EC_KEY_get0_public_key(ecdh_b[j]),
-						    ecdh_a[j], kdf);
+					if (threads) {
+						sp.ec_key = ecdh_a[j];
+						sp.peer = EC_KEY_get0_public_key(ecdh_b[j]);
+						sp.kdf = kdf;
+						sp.outlen = outlen;
+						count = speed_threads_run(speed_ecdh_op,
+						    &sp, buf);
+					} else {
+						for (count = 0, run = 1;
+						     COND(ecdh_c[j][0]); count++) {
+							ECDH_compute_key(secret_a,
+							    outlen,
+							    EC_KEY_get0_public_key(ecdh_b[j]),
+							    ecdh_a[j], kdf);
+						}
 					}
 					d = Time_F(STOP);
 					BIO_printf(bio_err, mr
@@ -1793,6 +2508,8 @@ speed_main(int argc, char **argv)
 					    : "%ld %d-bit ECDH ops in %.2fs\n",
 					    count, test_curves_bits[j], d);
 					ecdh_results[j][0] = d / (double) count;
+					if (threads)
+						speed_threads_report(d);
 					rsa_count = count;
 				}
 			}
@@ -1805,6 +2522,175 @@ speed_main(int argc, char **argv)
 				ecdh_doit[j] = 0;
 		}
 	}
+
+	if (x25519_doit) {
+		X25519_keypair(x25519_public, x25519_private);
+
+		pkey_print_message("", "x25519", 0, 253, ECDH_SECONDS);
+		Time_F(START);
+		if (threads) {
+			sp.public_key = x25519_public;
+			sp.private_key = x25519_private;
+			count = speed_threads_run(speed_x25519_op, &sp, buf);
+		} else {
+			for (count = 0, run = 1; COND(0); count++) {
+				if (!X25519(x25519_shared, x25519_private,
+				    x25519_public)) {
+					BIO_printf(bio_err, "X25519 failure\n");
+					count = 1;
+					break;
+				}
+			}
+		}
+		d = Time_F(STOP);
+		BIO_printf(bio_err, mr ? "+R8:%ld:%d:%.2f\n"
+		    : "%ld %d-bit X25519 ops in %.2fs\n", count, 253, d);
+		x25519_results[0] = d / (double) count;
+		if (threads)
+			speed_threads_report(d);
+	}
+
+	if (ed25519_doit) {
+		ED25519_keypair(ed25519_public, ed25519_private);
+		/* The threaded sign benchmark does not produce ed25519_sig. */
+		ED25519_sign(ed25519_sig, buf, 20, ed25519_public,
+		    ed25519_private);
+
+		pkey_print_message("sign", "ed25519", 0, 253, ECDSA_SECONDS);
+		Time_F(START);
+		if (threads) {
+			sp.public_key = ed25519_public;
+			sp.private_key = ed25519_private;
+			count = speed_threads_run(speed_ed25519_sign_op,
+			    &sp, buf);
+		} else {
+			for (count = 0, run = 1; COND(0); count++) {
+				if (!ED25519_sign(ed25519_sig, buf, 20, ed25519_public,
+				    ed25519_private)) {
+					BIO_printf(bio_err, "Ed25519 sign failure\n");
+					count = 1;
+					break;
+				}
+			}
+		}
+		d = Time_F(STOP);
+		BIO_printf(bio_err, mr ? "+R9:%ld:%d:%.2f\n"
+		    : "%ld %d bit Ed25519 signs in %.2fs\n", count, 253, d);
+		ed25519_results[0] = d / (double) count;
+		if (threads)
+			speed_threads_report(d);
+
+		pkey_print_message("verify", "ed25519", 0, 253, ECDSA_SECONDS);
+		Time_F(START);
+		if (threads) {
+			sp.public_key = ed25519_public;
+			sp.sig = ed25519_sig;
+			count = speed_threads_run(speed_ed25519_verify_op,
+			    &sp, buf);
+		} else {
+			for (count = 0, run = 1; COND(0); count++) {
+				if (!ED25519_verify(buf, 20, ed25519_sig,
+				    ed25519_public)) {
+					BIO_printf(bio_err, "Ed25519 verify failure\n");
+					count = 1;
+					break;
+				}
+			}
+		}
+		d = Time_F(STOP);
+		BIO_printf(bio_err, mr ? "+R10:%ld:%d:%.2f\n"
+		    : "%ld %d bit Ed25519 verify in %.2fs\n", count, 253, d);
+		ed25519_results[1] = d / (double) count;
+		if (threads)
+			speed_threads_report(d);
+	}
+
+	for (j = 0; j < HANDSHAKE_NUM; j++) {
+		const struct handshake_test *ht = &handshake_tests[j];
+
+		if (!handshake_doit[j])
+			continue;
+
+		if (handshake_pkey == NULL) {
+			if ((handshake_pkey = EVP_PKEY_new()) == NULL ||
+			    !EVP_PKEY_set1_RSA(handshake_pkey,
+			    rsa_key[R_RSA_2048]) ||
+			    (handshake_x509 =
+			    handshake_cert_new(handshake_pkey)) == NULL) {
+				BIO_printf(bio_err, "Handshake certificate "
+				    "failure. No handshakes will be done.\n");
+				ERR_print_errors(bio_err);
+				for (; j < HANDSHAKE_NUM; j++)
+					handshake_doit[j] = 0;
+				break;
+			}
+		}
+
+		if (!handshake_ctx_new(ht, handshake_pkey, handshake_x509,
+		    &handshake_client_ctx, &handshake_server_ctx)) {
+			BIO_printf(bio_err, "Handshake setup failure for %s\n",
+			    ht->name);
+			ERR_print_errors(bio_err);
+			handshake_doit[j] = 0;
+			continue;
+		}
+
+		/* Perform a first handshake, establishing the session. */
+		if (!handshake_run(handshake_client_ctx, handshake_server_ctx,
+		    ht->resume ? &handshake_session : NULL) ||
+		    (threads && ht->resume && !speed_threads_sessions(
+		    handshake_client_ctx, handshake_server_ctx))) {
+			BIO_printf(bio_err, "Handshake failure for %s\n",
+			    ht->name);
+			ERR_print_errors(bio_err);
+			handshake_doit[j] = 0;
+		} else {
+			BIO_printf(bio_err, mr ? "+DTH:%s:%d\n"
+			    : "Doing %s handshakes for %ds: ", ht->name,
+			    HANDSHAKE_SECONDS);
+			(void) BIO_flush(bio_err);
+			alarm(HANDSHAKE_SECONDS);
+
+			Time_F(START);
+			if (threads) {
+				sh.client_ctx = handshake_client_ctx;
+				sh.server_ctx = handshake_server_ctx;
+				sh.resume = ht->resume;
+				count = speed_threads_run(speed_handshake_op,
+				    &sh, buf);
+			} else {
+				for (count = 0, run = 1; COND(0); count++) {
+					if (!handshake_run(handshake_client_ctx,
+					    handshake_server_ctx,
+					    ht->resume ? &handshake_session : NULL)) {
+						BIO_printf(bio_err,
+						    "Handshake failure\n");
+						ERR_print_errors(bio_err);
+						count = 1;
+						break;
+					}
+				}
+			}
+			d = Time_F(STOP);
+			if (mr)
+				BIO_printf(bio_err, "+R11:%ld:%d:%.2f\n",
+				    count, j, d);
+			else
+				BIO_printf(bio_err,
+				    "%ld %s handshakes in %.2fs\n",
+				    count, ht->name, d);
+			handshake_results[j] = d / (double) count;
+			if (threads)
+				speed_threads_report(d);
+		}
+
+		SSL_SESSION_free(handshake_session);
+		handshake_session = NULL;
+		SSL_CTX_free(handshake_client_ctx);
+		handshake_client_ctx = NULL;
+		SSL_CTX_free(handshake_server_ctx);
+		handshake_server_ctx = NULL;
+	}
 show_res:
 	if (!mr) {
 		fprintf(stdout, "%s\n", SSLeay_version(SSLEAY_VERSION));
@@ -1929,6 +2815,52 @@ show_res:
 			    ecdh_results[k][0], 1.0 / ecdh_results[k][0]);
 	}
 
+	if (x25519_doit) {
+		if (mr)
+			fprintf(stdout, "+F6:%u:%u:%f:%f\n",
+			    0, 253, x25519_results[0],
+			    1.0 / x25519_results[0]);
+		else {
+			printf("%30sop      op/s\n", " ");
+			fprintf(stdout, "%4u bit ecdh (%s) %8.4fs %8.1f\n",
+			    253, "X25519", x25519_results[0],
+			    1.0 / x25519_results[0]);
+		}
+	}
+
+	if (ed25519_doit) {
+		if (mr)
+			fprintf(stdout, "+F7:%u:%u:%f:%f\n",
+			    0, 253, ed25519_results[0], ed25519_results[1]);
+		else {
+			printf("%30ssign    verify    sign/s verify/s\n", " ");
+			fprintf(stdout,
+			    "%4u bit eddsa (%s) %8.4fs %8.4fs %8.1f %8.1f\n",
+			    253, "Ed25519",
+			    ed25519_results[0], ed25519_results[1],
+			    1.0 / ed25519_results[0],
+			    1.0 / ed25519_results[1]);
+		}
+	}
+
+	j = 1;
+	for (k = 0; k < HANDSHAKE_NUM; k++) {
+		if (!handshake_doit[k])
+			continue;
+		if (j && !mr) {
+			printf("%-44s handshake  handshakes/s\n", "tls");
+			j = 0;
+		}
+		if (mr)
+			fprintf(stdout, "+F8:%u:%f:%f\n",
+			    k, handshake_results[k],
+			    1.0 / handshake_results[k]);
+		else
+			fprintf(stdout, "%-44s %8.6fs %12.1f\n",
+			    handshake_tests[k].name, handshake_results[k],
+			    1.0 / handshake_results[k]);
+	}
+
 	mret = 0;
 
  end:
@@ -1952,6 +2884,10 @@ show_res:
 			EC_KEY_free(ecdh_b[i]);
 	}
 
+	EVP_PKEY_free(handshake_pkey);
+	X509_free(handshake_x509);
+	speed_threads_free();
+
 
 	return (mret);
 }
@@ -2179,6 +3115,55 @@ do_multi(int multi)
 
 			}
 
+			else if (!strncmp(buf, "+F6:", 4)) {
+				double d;
+
+				p = buf + 4;
+				sstrsep(&p, sep);
+				sstrsep(&p, sep);
+
+				d = atof(sstrsep(&p, sep));
+				if (n)
+					x25519_results[0] = 1 / (1 / x25519_results[0] + 1 / d);
+				else
+					x25519_results[0] = d;
+			}
+
+			else if (!strncmp(buf, "+F7:", 4)) {
+				double d;
+
+				p = buf + 4;
+				sstrsep(&p, sep);
+				sstrsep(&p, sep);
+
+				d = atof(sstrsep(&p, sep));
+				if (n)
+					ed25519_results[0] = 1 / (1 / ed25519_results[0] + 1 / d);
+				else
+					ed25519_results[0] = d;
+
+				d = atof(sstrsep(&p, sep));
+				if (n)
+					ed25519_results[1] = 1 / (1 / ed25519_results[1] + 1 / d);
+				else
+					ed25519_results[1] = d;
+			}
+
+			else if (!strncmp(buf, "+F8:", 4)) {
+				int k;
+				double d;
+
+				p = buf + 4;
+				k = strtonum(sstrsep(&p, sep),
+				    0, HANDSHAKE_NUM - 1, &errstr);
+
+				d = atof(sstrsep(&p, sep));
+				if (n)
+					handshake_results[k] = 1 / (1 / handshake_results[k] + 1 / d);
+				else
+					handshake_results[k] = d;
+			}
+
 			else if (!strncmp(buf, "+H:", 3)) {
 			} else
 				fprintf(stderr, "Unknown type '%s' from child %d\n", buf, n);